@@ -0,0 +1,173 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+/*
+ * Benchmark of st30 tx sessions per core, each build alone against the batch build of
+ * ST30_TX_FLAG_GROUP_BUILD. All sessions are on one scheduler, the session count doubles
+ * up to --sessions and the achieved pkt rate of each step is reported, the default ports
+ * are a pair of memif virtual ports:
+ * PerfAudioGroup --sessions 512 --audio_ptime 125us
+ */
+
+#include "../sample/sample_util.h"
+
+#define PERF_AUDIO_GROUP_SESSIONS_START (32)
+#define PERF_AUDIO_GROUP_SESSIONS_DEFAULT (512)
+#define PERF_AUDIO_GROUP_RUN_S (5)
+#define PERF_AUDIO_GROUP_FB_CNT (2)
+
+struct perf_audio_group_session {
+  int idx;
+  st30_tx_handle handle;
+  bool in_use[PERF_AUDIO_GROUP_FB_CNT];
+  uint16_t next_idx;
+};
+
+/* get/done are both from the scheduler tasklet, the frames are always ready */
+static int perf_audio_group_next_frame(void* priv, uint16_t* next_frame_idx,
+                                       struct st30_tx_frame_meta* meta) {
+  struct perf_audio_group_session* s = priv;
+  uint16_t idx = s->next_idx;
+  MTL_MAY_UNUSED(meta);
+
+  if (s->in_use[idx]) return -EBUSY;
+  s->in_use[idx] = true;
+  *next_frame_idx = idx;
+  s->next_idx = (idx + 1) % PERF_AUDIO_GROUP_FB_CNT;
+  return 0;
+}
+
+static int perf_audio_group_frame_done(void* priv, uint16_t frame_idx,
+                                       struct st30_tx_frame_meta* meta) {
+  struct perf_audio_group_session* s = priv;
+  MTL_MAY_UNUSED(meta);
+
+  s->in_use[frame_idx] = false;
+  return 0;
+}
+
+static int perf_audio_group_run(struct st_sample_context* ctx, uint32_t session_num,
+                                bool group) {
+  struct mtl_init_params* p = &ctx->param;
+  struct perf_audio_group_session* app;
+  struct st30_tx_user_stats stats;
+  uint64_t pkts = 0, epoch_drop = 0;
+  int ret = 0;
+
+  int pkt_len = st30_get_packet_size(ctx->audio_fmt, ctx->audio_ptime,
+                                     ctx->audio_sampling, ctx->audio_channel);
+  double pkt_time = st30_get_packet_time(ctx->audio_ptime);
+  if (pkt_len < 0 || pkt_time <= 0) {
+    err("%s, invalid audio format\n", __func__);
+    return -EINVAL;
+  }
+  /* 1ms frame */
+  int pkts_per_frame = pkt_time < NS_PER_MS ? NS_PER_MS / pkt_time : 1;
+
+  app = calloc(session_num, sizeof(*app));
+  if (!app) return -ENOMEM;
+
+  for (uint32_t i = 0; i < session_num; i++) {
+    struct st30_tx_ops ops;
+
+    app[i].idx = i;
+    memset(&ops, 0, sizeof(ops));
+    ops.name = "perf_audio_group";
+    ops.priv = &app[i];
+    ops.num_port = 1;
+    memcpy(ops.dip_addr[MTL_SESSION_PORT_P], mtl_r_sip_addr(p), MTL_IP_ADDR_LEN);
+    snprintf(ops.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s", p->port[MTL_PORT_P]);
+    ops.udp_port[MTL_SESSION_PORT_P] = ctx->audio_udp_port + i * 2;
+    ops.payload_type = ctx->audio_payload_type;
+    ops.type = ST30_TYPE_FRAME_LEVEL;
+    ops.fmt = ctx->audio_fmt;
+    ops.channel = ctx->audio_channel;
+    ops.sampling = ctx->audio_sampling;
+    ops.ptime = ctx->audio_ptime;
+    ops.pacing_way = ST30_TX_PACING_WAY_TSC;
+    ops.framebuff_cnt = PERF_AUDIO_GROUP_FB_CNT;
+    ops.framebuff_size = pkt_len * pkts_per_frame;
+    ops.get_next_frame = perf_audio_group_next_frame;
+    ops.notify_frame_done = perf_audio_group_frame_done;
+    if (group) ops.flags |= ST30_TX_FLAG_GROUP_BUILD;
+    app[i].handle = st30_tx_create(ctx->st, &ops);
+    if (!app[i].handle) {
+      err("%s(%d), st30_tx_create fail\n", __func__, i);
+      ret = -EIO;
+      goto exit;
+    }
+  }
+
+  /* the stats from the start point */
+  sleep(1);
+  for (uint32_t i = 0; i < session_num; i++) st30_tx_reset_session_stats(app[i].handle);
+  uint64_t start_ns = sample_get_monotonic_time();
+  sleep(PERF_AUDIO_GROUP_RUN_S);
+  for (uint32_t i = 0; i < session_num; i++) {
+    st30_tx_get_session_stats(app[i].handle, &stats);
+    pkts += stats.common.port[MTL_SESSION_PORT_P].packets;
+    epoch_drop += stats.common.stat_epoch_drop;
+  }
+  double duration_s = (double)(sample_get_monotonic_time() - start_ns) / NS_PER_S;
+
+  double expect = (double)NS_PER_S / pkt_time * session_num * duration_s;
+  info("%s, %s %u sessions, %f Mpkts/s, %.1f%% of the pacing rate, epoch drop %" PRIu64
+       "\n",
+       __func__, group ? "group" : "alone", session_num, pkts / duration_s / 1000 / 1000,
+       pkts * 100.0 / expect, epoch_drop);
+
+exit:
+  for (uint32_t i = 0; i < session_num; i++) {
+    if (app[i].handle) st30_tx_free(app[i].handle);
+  }
+  free(app);
+  return ret;
+}
+
+int main(int argc, char** argv) {
+  struct st_sample_context ctx;
+  struct mtl_init_params* p = &ctx.param;
+  int ret;
+
+  memset(&ctx, 0, sizeof(ctx));
+  ret = sample_parse_args(&ctx, argc, argv, true, true, true);
+  if (ret < 0) return ret;
+  if (ctx.sessions <= 1) ctx.sessions = PERF_AUDIO_GROUP_SESSIONS_DEFAULT;
+
+  if (p->num_ports < 2) {
+    /* no ports from user, use a memif pair on this process */
+    p->num_ports = 2;
+    snprintf(p->port[MTL_PORT_P], MTL_PORT_MAX_LEN, "%s",
+             "dpdk_memif:role=server,id=0");
+    snprintf(p->port[MTL_PORT_R], MTL_PORT_MAX_LEN, "%s",
+             "dpdk_memif:role=client,id=0");
+    for (uint8_t i = 0; i < p->num_ports; i++) {
+      p->pmd[i] = mtl_pmd_by_port_name(p->port[i]);
+      p->tx_queues_cnt[i] = 1;
+      p->rx_queues_cnt[i] = 1;
+    }
+  }
+  /* all sessions on one core */
+  p->tx_audio_sessions_max_per_sch = ctx.sessions;
+
+  ctx.param.flags |= MTL_FLAG_DEV_AUTO_START_STOP;
+  ctx.st = mtl_init(&ctx.param);
+  if (!ctx.st) {
+    err("%s: mtl_init fail\n", __func__);
+    return -EIO;
+  }
+
+  for (uint32_t n = PERF_AUDIO_GROUP_SESSIONS_START; !ctx.exit; n *= 2) {
+    if (n > ctx.sessions) n = ctx.sessions;
+    ret = perf_audio_group_run(&ctx, n, false);
+    if (ret < 0) break;
+    ret = perf_audio_group_run(&ctx, n, true);
+    if (ret < 0) break;
+    if (n >= ctx.sessions) break;
+  }
+
+  mtl_uninit(ctx.st);
+  ctx.st = NULL;
+  return ret;
+}
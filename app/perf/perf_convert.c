@@ -0,0 +1,598 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+/*
+ * Benchmark of all the built-in converters at each SIMD level the CPU supports, with
+ * warm and cold caches. The results can be saved to a json file, and compared with a
+ * baseline json of the same CPU to catch the regressions before release:
+ * PerfConvert --json /tmp/base.json
+ * PerfConvert --baseline /tmp/base.json --threshold 5 --json /tmp/new.json
+ */
+
+#include <getopt.h>
+#include <json-c/json.h>
+
+#include "../sample/sample_util.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PERF_CVT_HAS_X86
+#endif
+
+#define PERF_CVT_RES_MAX (8)
+#define PERF_CVT_LOOPS_DEFAULT (30)
+#define PERF_CVT_THRESHOLD_DEFAULT (5.0)
+
+enum perf_cvt_cache {
+  PERF_CVT_CACHE_WARM = 0,
+  PERF_CVT_CACHE_COLD,
+  PERF_CVT_CACHE_MAX,
+};
+
+static const char* perf_cvt_cache_names[PERF_CVT_CACHE_MAX] = {"warm", "cold"};
+
+struct perf_cvt_res {
+  uint32_t width;
+  uint32_t height;
+};
+
+struct perf_cvt_ctx {
+  struct perf_cvt_res res[PERF_CVT_RES_MAX];
+  int res_cnt;
+  int loops;
+  const char* filter;
+  enum mtl_simd_level max_level;
+  const char* json_path;
+  const char* baseline_path;
+  double threshold; /* percent */
+  char cpu_model[128];
+
+  int fd_cycles; /* the perf event fds, -1 if not available */
+  int fd_llc_misses;
+  double tsc_hz;
+};
+
+struct perf_cvt_result {
+  enum st_frame_fmt src_fmt;
+  enum st_frame_fmt dst_fmt;
+  enum mtl_simd_level level;
+  uint32_t width;
+  uint32_t height;
+  enum perf_cvt_cache cache;
+
+  uint64_t median_ns;
+  uint64_t best_ns;
+  double gbps;
+  double cycles_per_pixel;
+  bool cycles_from_pmu; /* false if from the tsc */
+  double llc_misses; /* per frame, < 0 if not available */
+};
+
+static const struct perf_cvt_res perf_cvt_default_res[] = {
+    {1280, 720},
+    {1920, 1080},
+    {3840, 2160},
+};
+
+static void perf_cvt_read_cpu_model(char* model, size_t sz) {
+  FILE* fp = fopen("/proc/cpuinfo", "r");
+  char line[256];
+
+  snprintf(model, sz, "unknown");
+  if (!fp) return;
+  while (fgets(line, sizeof(line), fp)) {
+    if (strncmp(line, "model name", strlen("model name"))) continue;
+    char* value = strchr(line, ':');
+    if (!value) break;
+    value++;
+    while (*value == ' ' || *value == '\t') value++;
+    value[strcspn(value, "\r\n")] = 0;
+    snprintf(model, sz, "%s", value);
+    break;
+  }
+  fclose(fp);
+}
+
+#ifdef __linux__
+static int perf_cvt_event_open(uint64_t config) {
+  struct perf_event_attr attr;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  /* this thread on any cpu */
+  return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static void perf_cvt_event_start(int fd) {
+  if (fd < 0) return;
+  ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+  ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+static uint64_t perf_cvt_event_stop(int fd) {
+  uint64_t value = 0;
+
+  if (fd < 0) return 0;
+  ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+  if (read(fd, &value, sizeof(value)) != sizeof(value)) return 0;
+  return value;
+}
+#else
+static void perf_cvt_event_start(int fd) { MTL_MAY_UNUSED(fd); }
+
+static uint64_t perf_cvt_event_stop(int fd) {
+  MTL_MAY_UNUSED(fd);
+  return 0;
+}
+#endif
+
+static uint64_t perf_cvt_tsc(void) {
+#ifdef PERF_CVT_HAS_X86
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+/* the tsc ticks of one ms sleep, only to turn the tsc to cycles without the pmu */
+static double perf_cvt_tsc_hz(void) {
+  uint64_t start_ns = sample_get_monotonic_time();
+  uint64_t start_tsc = perf_cvt_tsc();
+
+  mtl_sleep_us(10 * 1000);
+  uint64_t ns = sample_get_monotonic_time() - start_ns;
+  uint64_t tsc = perf_cvt_tsc() - start_tsc;
+  return ns ? (double)tsc * NS_PER_S / ns : 0;
+}
+
+/* flush the frame out of all the cache levels, the cold cache case */
+static void perf_cvt_flush(struct st_frame* frame) {
+#ifdef PERF_CVT_HAS_X86
+  uint8_t* addr = frame->addr[0];
+
+  /* the frames of st_frame_create_by_malloc are one buffer for all planes */
+  for (size_t i = 0; i < frame->buffer_size; i += 64) _mm_clflush(addr + i);
+  _mm_mfence();
+#else
+  MTL_MAY_UNUSED(frame);
+#endif
+}
+
+static void perf_cvt_fill(struct st_frame* frame) {
+  uint8_t* addr = frame->addr[0];
+  uint32_t seed = 0x12345678;
+
+  for (size_t i = 0; i < frame->buffer_size; i++) {
+    seed = seed * 1103515245 + 12345;
+    addr[i] = seed >> 16;
+  }
+}
+
+static int perf_cvt_u64_cmp(const void* a, const void* b) {
+  uint64_t va = *(const uint64_t*)a;
+  uint64_t vb = *(const uint64_t*)b;
+  return (va > vb) - (va < vb);
+}
+
+static int perf_cvt_run(struct perf_cvt_ctx* ctx, struct st_frame* src,
+                        struct st_frame* dst, struct perf_cvt_result* result) {
+  uint64_t* ns;
+  uint64_t cycles = 0, tsc = 0, llc_misses = 0;
+  double pixels = (double)src->width * src->height;
+  int ret;
+
+  /* warm up, also check the converter work at this level */
+  ret = st_frame_convert_simd(src, dst, result->level);
+  if (ret < 0) return ret;
+
+  ns = malloc(sizeof(*ns) * ctx->loops);
+  if (!ns) return -ENOMEM;
+  for (int i = 0; i < ctx->loops; i++) {
+    if (result->cache == PERF_CVT_CACHE_COLD) {
+      perf_cvt_flush(src);
+      perf_cvt_flush(dst);
+    }
+    perf_cvt_event_start(ctx->fd_cycles);
+    perf_cvt_event_start(ctx->fd_llc_misses);
+    uint64_t start_tsc = perf_cvt_tsc();
+    uint64_t start_ns = sample_get_monotonic_time();
+    st_frame_convert_simd(src, dst, result->level);
+    ns[i] = sample_get_monotonic_time() - start_ns;
+    tsc += perf_cvt_tsc() - start_tsc;
+    cycles += perf_cvt_event_stop(ctx->fd_cycles);
+    llc_misses += perf_cvt_event_stop(ctx->fd_llc_misses);
+  }
+
+  qsort(ns, ctx->loops, sizeof(ns[0]), perf_cvt_u64_cmp);
+  result->best_ns = ns[0];
+  result->median_ns = ns[ctx->loops / 2];
+  free(ns);
+  result->gbps = (double)(src->data_size + dst->data_size) / result->median_ns;
+  if (ctx->fd_cycles >= 0) {
+    result->cycles_from_pmu = true;
+    result->cycles_per_pixel = (double)cycles / ctx->loops / pixels;
+  } else {
+    result->cycles_from_pmu = false;
+    result->cycles_per_pixel = (double)tsc / ctx->loops / pixels;
+  }
+  result->llc_misses =
+      (ctx->fd_llc_misses >= 0) ? (double)llc_misses / ctx->loops : -1.0;
+  return 0;
+}
+
+static json_object* perf_cvt_result_json(const struct perf_cvt_result* r) {
+  json_object* obj = json_object_new_object();
+
+  json_object_object_add(obj, "src",
+                         json_object_new_string(st_frame_fmt_name(r->src_fmt)));
+  json_object_object_add(obj, "dst",
+                         json_object_new_string(st_frame_fmt_name(r->dst_fmt)));
+  json_object_object_add(obj, "level",
+                         json_object_new_string(mtl_get_simd_level_name(r->level)));
+  json_object_object_add(obj, "width", json_object_new_int(r->width));
+  json_object_object_add(obj, "height", json_object_new_int(r->height));
+  json_object_object_add(obj, "cache",
+                         json_object_new_string(perf_cvt_cache_names[r->cache]));
+  json_object_object_add(obj, "median_ns", json_object_new_int64(r->median_ns));
+  json_object_object_add(obj, "best_ns", json_object_new_int64(r->best_ns));
+  json_object_object_add(obj, "gbps", json_object_new_double(r->gbps));
+  json_object_object_add(obj, "cycles_per_pixel",
+                         json_object_new_double(r->cycles_per_pixel));
+  json_object_object_add(obj, "cycles_source",
+                         json_object_new_string(r->cycles_from_pmu ? "pmu" : "tsc"));
+  if (r->llc_misses >= 0)
+    json_object_object_add(obj, "llc_misses", json_object_new_double(r->llc_misses));
+  else
+    json_object_object_add(obj, "llc_misses", NULL);
+  return obj;
+}
+
+static const char* perf_cvt_json_str(json_object* obj, const char* key) {
+  json_object* value = NULL;
+
+  if (!json_object_object_get_ex(obj, key, &value)) return "";
+  return json_object_get_string(value);
+}
+
+static int64_t perf_cvt_json_int(json_object* obj, const char* key) {
+  json_object* value = NULL;
+
+  if (!json_object_object_get_ex(obj, key, &value)) return -1;
+  return json_object_get_int64(value);
+}
+
+/* the entry of the same converter, level, resolution and cache in the baseline */
+static json_object* perf_cvt_baseline_find(json_object* results,
+                                           const struct perf_cvt_result* r) {
+  size_t cnt = json_object_array_length(results);
+
+  for (size_t i = 0; i < cnt; i++) {
+    json_object* obj = json_object_array_get_idx(results, i);
+    if (strcmp(perf_cvt_json_str(obj, "src"), st_frame_fmt_name(r->src_fmt))) continue;
+    if (strcmp(perf_cvt_json_str(obj, "dst"), st_frame_fmt_name(r->dst_fmt))) continue;
+    if (strcmp(perf_cvt_json_str(obj, "level"), mtl_get_simd_level_name(r->level)))
+      continue;
+    if (perf_cvt_json_int(obj, "width") != r->width) continue;
+    if (perf_cvt_json_int(obj, "height") != r->height) continue;
+    if (strcmp(perf_cvt_json_str(obj, "cache"), perf_cvt_cache_names[r->cache])) continue;
+    return obj;
+  }
+  return NULL;
+}
+
+/* the regressions count of the results against the baseline */
+static int perf_cvt_compare(struct perf_cvt_ctx* ctx, json_object* baseline,
+                            struct perf_cvt_result* results, int cnt) {
+  json_object* base_results = NULL;
+  int regressions = 0, compared = 0;
+
+  if (strcmp(perf_cvt_json_str(baseline, "cpu"), ctx->cpu_model))
+    warn("%s, baseline cpu %s, this cpu %s\n", __func__,
+         perf_cvt_json_str(baseline, "cpu"), ctx->cpu_model);
+  if (!json_object_object_get_ex(baseline, "results", &base_results) ||
+      !json_object_is_type(base_results, json_type_array)) {
+    err("%s, no results in the baseline\n", __func__);
+    return -EINVAL;
+  }
+
+  info("\n%-28s %-28s %-12s %-10s %-5s %12s %12s %8s\n", "src", "dst", "level", "size",
+       "cache", "base(ns)", "now(ns)", "delta");
+  for (int i = 0; i < cnt; i++) {
+    struct perf_cvt_result* r = &results[i];
+    json_object* base = perf_cvt_baseline_find(base_results, r);
+    if (!base) continue;
+    int64_t base_ns = perf_cvt_json_int(base, "median_ns");
+    if (base_ns <= 0) continue;
+
+    double delta = ((double)r->median_ns - base_ns) * 100.0 / base_ns;
+    bool regression = delta > ctx->threshold;
+    char size[32];
+    snprintf(size, sizeof(size), "%ux%u", r->width, r->height);
+    compared++;
+    if (!regression && delta >= -ctx->threshold) continue; /* only print the changes */
+    if (regression) regressions++;
+    info("%-28s %-28s %-12s %-10s %-5s %12" PRId64 " %12" PRIu64 " %+7.1f%%%s\n",
+         st_frame_fmt_name(r->src_fmt), st_frame_fmt_name(r->dst_fmt),
+         mtl_get_simd_level_name(r->level), size, perf_cvt_cache_names[r->cache],
+         base_ns, r->median_ns, delta, regression ? " REGRESSION" : "");
+  }
+  info("%s, %d compared, %d regressions over %.1f%%\n", __func__, compared, regressions,
+       ctx->threshold);
+  return regressions;
+}
+
+static int perf_cvt_save(struct perf_cvt_ctx* ctx, struct perf_cvt_result* results,
+                         int cnt) {
+  json_object* root = json_object_new_object();
+  json_object* array = json_object_new_array();
+  int ret;
+
+  json_object_object_add(root, "cpu", json_object_new_string(ctx->cpu_model));
+  json_object_object_add(root, "loops", json_object_new_int(ctx->loops));
+  for (int i = 0; i < cnt; i++)
+    json_object_array_add(array, perf_cvt_result_json(&results[i]));
+  json_object_object_add(root, "results", array);
+  ret = json_object_to_file_ext(ctx->json_path, root, JSON_C_TO_STRING_PRETTY);
+  json_object_put(root);
+  if (ret < 0) {
+    err("%s, write %s fail\n", __func__, ctx->json_path);
+    return -EIO;
+  }
+  info("%s, %d results to %s\n", __func__, cnt, ctx->json_path);
+  return 0;
+}
+
+static bool perf_cvt_match(struct perf_cvt_ctx* ctx, enum st_frame_fmt src_fmt,
+                           enum st_frame_fmt dst_fmt) {
+  if (!ctx->filter) return true;
+  if (strstr(st_frame_fmt_name(src_fmt), ctx->filter)) return true;
+  if (strstr(st_frame_fmt_name(dst_fmt), ctx->filter)) return true;
+  return false;
+}
+
+static int perf_cvt_results_max(struct perf_cvt_ctx* ctx) {
+  enum st_frame_fmt src_fmt, dst_fmt;
+  int converters = 0;
+
+  while (!st_frame_converter_query(converters, &src_fmt, &dst_fmt)) converters++;
+  return converters * (ctx->max_level + 1) * ctx->res_cnt * PERF_CVT_CACHE_MAX;
+}
+
+static int perf_cvt_all(struct perf_cvt_ctx* ctx, struct perf_cvt_result* results) {
+  enum st_frame_fmt src_fmt, dst_fmt;
+  int cnt = 0;
+
+  info("%-28s %-28s %-12s %-10s %-5s %10s %8s %8s %10s\n", "src", "dst", "level", "size",
+       "cache", "ns", "GB/s", "cyc/px", "llc_miss");
+  for (uint32_t idx = 0; !st_frame_converter_query(idx, &src_fmt, &dst_fmt); idx++) {
+    if (!perf_cvt_match(ctx, src_fmt, dst_fmt)) continue;
+    for (int r = 0; r < ctx->res_cnt; r++) {
+      uint32_t w = ctx->res[r].width;
+      uint32_t h = ctx->res[r].height;
+      struct st_frame* src = st_frame_create_by_malloc(src_fmt, w, h, false);
+      struct st_frame* dst = st_frame_create_by_malloc(dst_fmt, w, h, false);
+      char size[32];
+
+      if (!src || !dst) {
+        err("%s, %s to %s frame create fail for %ux%u\n", __func__,
+            st_frame_fmt_name(src_fmt), st_frame_fmt_name(dst_fmt), w, h);
+        if (src) st_frame_free(src);
+        if (dst) st_frame_free(dst);
+        continue;
+      }
+      perf_cvt_fill(src);
+      snprintf(size, sizeof(size), "%ux%u", w, h);
+      for (int level = MTL_SIMD_LEVEL_NONE; level <= (int)ctx->max_level; level++) {
+        for (int cache = 0; cache < PERF_CVT_CACHE_MAX; cache++) {
+          struct perf_cvt_result* result = &results[cnt];
+
+          memset(result, 0, sizeof(*result));
+          result->src_fmt = src_fmt;
+          result->dst_fmt = dst_fmt;
+          result->level = level;
+          result->width = w;
+          result->height = h;
+          result->cache = cache;
+          if (perf_cvt_run(ctx, src, dst, result) < 0) {
+            err("%s, %s to %s fail at %s\n", __func__, st_frame_fmt_name(src_fmt),
+                st_frame_fmt_name(dst_fmt), mtl_get_simd_level_name(level));
+            continue;
+          }
+          info("%-28s %-28s %-12s %-10s %-5s %10" PRIu64 " %8.2f %8.2f %10.0f\n",
+               st_frame_fmt_name(src_fmt), st_frame_fmt_name(dst_fmt),
+               mtl_get_simd_level_name(level), size, perf_cvt_cache_names[cache],
+               result->median_ns, result->gbps, result->cycles_per_pixel,
+               result->llc_misses);
+          cnt++;
+        }
+      }
+      st_frame_free(src);
+      st_frame_free(dst);
+    }
+  }
+  return cnt;
+}
+
+enum perf_cvt_args_cmd {
+  PERF_CVT_ARG_UNKNOWN = 0,
+  PERF_CVT_ARG_RES = 0x100, /* start from end of ascii */
+  PERF_CVT_ARG_LOOPS,
+  PERF_CVT_ARG_FILTER,
+  PERF_CVT_ARG_MAX_LEVEL,
+  PERF_CVT_ARG_JSON,
+  PERF_CVT_ARG_BASELINE,
+  PERF_CVT_ARG_THRESHOLD,
+  PERF_CVT_ARG_HELP,
+};
+
+static struct option perf_cvt_args_options[] = {
+    {"res", required_argument, 0, PERF_CVT_ARG_RES},
+    {"loops", required_argument, 0, PERF_CVT_ARG_LOOPS},
+    {"filter", required_argument, 0, PERF_CVT_ARG_FILTER},
+    {"max_level", required_argument, 0, PERF_CVT_ARG_MAX_LEVEL},
+    {"json", required_argument, 0, PERF_CVT_ARG_JSON},
+    {"baseline", required_argument, 0, PERF_CVT_ARG_BASELINE},
+    {"threshold", required_argument, 0, PERF_CVT_ARG_THRESHOLD},
+    {"help", no_argument, 0, PERF_CVT_ARG_HELP},
+    {0, 0, 0, 0},
+};
+
+static void perf_cvt_print_help(void) {
+  printf("\n");
+  printf("##### Usage: #####\n\n");
+  printf(" Params:\n");
+  printf(" --res <w>x<h>        : resolution to run, repeat for more, default "
+         "720p/1080p/4k\n");
+  printf(" --loops <n>          : timed loops of each case, default %d\n",
+         PERF_CVT_LOOPS_DEFAULT);
+  printf(" --filter <name>      : only the converters with the format name substring\n");
+  printf(" --max_level <level>  : the max simd level, none/avx2/avx512/avx512_vbmi\n");
+  printf(" --json <file>        : save the results to the json file\n");
+  printf(" --baseline <file>    : compare with the json file of a previous run\n");
+  printf(" --threshold <pct>    : the slowdown percent to report as regression, default "
+         "%.1f\n",
+         PERF_CVT_THRESHOLD_DEFAULT);
+  printf("\n");
+}
+
+static int perf_cvt_parse_args(struct perf_cvt_ctx* ctx, int argc, char** argv) {
+  int cmd = -1, opt_idx = 0;
+
+  while (1) {
+    cmd = getopt_long_only(argc, argv, "hv", perf_cvt_args_options, &opt_idx);
+    if (cmd == -1) break;
+
+    switch (cmd) {
+      case PERF_CVT_ARG_RES: {
+        uint32_t w = 0, h = 0;
+        if (ctx->res_cnt >= PERF_CVT_RES_MAX) {
+          err("%s, max %d resolutions\n", __func__, PERF_CVT_RES_MAX);
+          return -EINVAL;
+        }
+        if (sscanf(optarg, "%ux%u", &w, &h) != 2 || !w || !h) {
+          err("%s, invalid res %s\n", __func__, optarg);
+          return -EINVAL;
+        }
+        ctx->res[ctx->res_cnt].width = w;
+        ctx->res[ctx->res_cnt].height = h;
+        ctx->res_cnt++;
+        break;
+      }
+      case PERF_CVT_ARG_LOOPS:
+        ctx->loops = atoi(optarg);
+        break;
+      case PERF_CVT_ARG_FILTER:
+        ctx->filter = optarg;
+        break;
+      case PERF_CVT_ARG_MAX_LEVEL: {
+        int level;
+        for (level = 0; level < MTL_SIMD_LEVEL_MAX; level++) {
+          if (!strcmp(optarg, mtl_get_simd_level_name(level))) break;
+        }
+        if (level >= MTL_SIMD_LEVEL_MAX) {
+          err("%s, invalid level %s\n", __func__, optarg);
+          return -EINVAL;
+        }
+        if (level < (int)ctx->max_level) ctx->max_level = level;
+        break;
+      }
+      case PERF_CVT_ARG_JSON:
+        ctx->json_path = optarg;
+        break;
+      case PERF_CVT_ARG_BASELINE:
+        ctx->baseline_path = optarg;
+        break;
+      case PERF_CVT_ARG_THRESHOLD:
+        ctx->threshold = atof(optarg);
+        break;
+      case PERF_CVT_ARG_HELP:
+      default:
+        perf_cvt_print_help();
+        return -EINVAL;
+    }
+  }
+
+  if (ctx->loops <= 0) {
+    err("%s, invalid loops %d\n", __func__, ctx->loops);
+    return -EINVAL;
+  }
+  if (!ctx->res_cnt) {
+    for (size_t i = 0; i < MTL_ARRAY_SIZE(perf_cvt_default_res); i++)
+      ctx->res[ctx->res_cnt++] = perf_cvt_default_res[i];
+  }
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  struct perf_cvt_ctx ctx;
+  struct perf_cvt_result* results = NULL;
+  json_object* baseline = NULL;
+  int cnt, ret;
+
+  memset(&ctx, 0, sizeof(ctx));
+  ctx.loops = PERF_CVT_LOOPS_DEFAULT;
+  ctx.threshold = PERF_CVT_THRESHOLD_DEFAULT;
+  ctx.max_level = mtl_get_simd_level();
+  ret = perf_cvt_parse_args(&ctx, argc, argv);
+  if (ret < 0) return ret;
+
+  /* load the baseline first, not to find a bad file after the long run */
+  if (ctx.baseline_path) {
+    baseline = json_object_from_file(ctx.baseline_path);
+    if (!baseline) {
+      err("%s, load baseline %s fail\n", __func__, ctx.baseline_path);
+      return -EIO;
+    }
+  }
+
+  perf_cvt_read_cpu_model(ctx.cpu_model, sizeof(ctx.cpu_model));
+#ifdef __linux__
+  ctx.fd_cycles = perf_cvt_event_open(PERF_COUNT_HW_CPU_CYCLES);
+  ctx.fd_llc_misses = perf_cvt_event_open(PERF_COUNT_HW_CACHE_MISSES);
+#else
+  ctx.fd_cycles = -1;
+  ctx.fd_llc_misses = -1;
+#endif
+  if (ctx.fd_cycles < 0)
+    warn("%s, no pmu cycles counter, cycles from tsc instead\n", __func__);
+  if (ctx.fd_llc_misses < 0) warn("%s, no pmu llc misses counter\n", __func__);
+  ctx.tsc_hz = perf_cvt_tsc_hz();
+  info("%s, cpu %s, max simd level %s, tsc %.0f MHz\n", __func__, ctx.cpu_model,
+       mtl_get_simd_level_name(ctx.max_level), ctx.tsc_hz / 1000 / 1000);
+
+  results = calloc(perf_cvt_results_max(&ctx), sizeof(*results));
+  if (!results) {
+    err("%s, results malloc fail\n", __func__);
+    ret = -ENOMEM;
+    goto exit;
+  }
+  cnt = perf_cvt_all(&ctx, results);
+
+  if (ctx.json_path) {
+    ret = perf_cvt_save(&ctx, results, cnt);
+    if (ret < 0) goto exit;
+  }
+  if (baseline) {
+    ret = perf_cvt_compare(&ctx, baseline, results, cnt);
+    if (ret > 0) ret = 1; /* fail the run if any regression */
+  }
+
+exit:
+  if (ctx.fd_cycles >= 0) close(ctx.fd_cycles);
+  if (ctx.fd_llc_misses >= 0) close(ctx.fd_llc_misses);
+  if (baseline) json_object_put(baseline);
+  free(results);
+  return ret;
+}
@@ -0,0 +1,296 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+/*
+ * End to end st20p loopback benchmark without NIC. Each session sends on the P port and
+ * receives on the R port, the default ports are a pair of memif virtual ports:
+ * --p_port dpdk_memif:role=server,id=0 --r_port dpdk_memif:role=client,id=0
+ */
+
+#include "../sample/sample_util.h"
+
+struct perf_loopback_meta {
+  int idx;         /* frame index */
+  uint64_t tx_ns;  /* ptp time when the frame put to tx */
+};
+
+struct perf_loopback_session {
+  mtl_handle st;
+  int idx;
+  st20p_tx_handle tx_handle;
+  st20p_rx_handle rx_handle;
+  size_t frame_size;
+
+  bool stop;
+  pthread_t tx_thread;
+  pthread_t rx_thread;
+
+  int fb_send;
+  struct perf_loopback_meta meta;
+
+  int fb_recv;
+  int fb_recv_incomplete;
+  int fb_recv_no_meta;
+  uint64_t latency_sum_ns;
+  uint64_t latency_min_ns;
+  uint64_t latency_max_ns;
+  uint64_t first_recv_ns;
+  uint64_t last_recv_ns;
+};
+
+static void* perf_loopback_tx_thread(void* arg) {
+  struct perf_loopback_session* s = arg;
+  st20p_tx_handle handle = s->tx_handle;
+  struct st_frame* frame;
+
+  info("%s(%d), start\n", __func__, s->idx);
+  while (!s->stop) {
+    frame = st20p_tx_get_frame(handle);
+    if (!frame) { /* no frame */
+      dbg("%s(%d), get frame time out\n", __func__, s->idx);
+      continue;
+    }
+    s->meta.idx = s->fb_send;
+    s->meta.tx_ns = mtl_ptp_read_time(s->st);
+    frame->user_meta = &s->meta;
+    frame->user_meta_size = sizeof(s->meta);
+    st20p_tx_put_frame(handle, frame);
+    s->fb_send++;
+  }
+  info("%s(%d), stop\n", __func__, s->idx);
+
+  return NULL;
+}
+
+static void* perf_loopback_rx_thread(void* arg) {
+  struct perf_loopback_session* s = arg;
+  st20p_rx_handle handle = s->rx_handle;
+  struct st_frame* frame;
+
+  info("%s(%d), start\n", __func__, s->idx);
+  while (!s->stop) {
+    frame = st20p_rx_get_frame(handle);
+    if (!frame) { /* no frame */
+      dbg("%s(%d), get frame time out\n", __func__, s->idx);
+      continue;
+    }
+    uint64_t now = mtl_ptp_read_time(s->st);
+
+    if (!st_is_frame_complete(frame->status)) s->fb_recv_incomplete++;
+    if (frame->user_meta && frame->user_meta_size == sizeof(struct perf_loopback_meta)) {
+      const struct perf_loopback_meta* meta = frame->user_meta;
+      uint64_t latency = now - meta->tx_ns;
+
+      s->latency_sum_ns += latency;
+      if (latency < s->latency_min_ns) s->latency_min_ns = latency;
+      if (latency > s->latency_max_ns) s->latency_max_ns = latency;
+    } else {
+      s->fb_recv_no_meta++;
+    }
+    if (!s->fb_recv) s->first_recv_ns = now;
+    s->last_recv_ns = now;
+    s->fb_recv++;
+    st20p_rx_put_frame(handle, frame);
+  }
+  info("%s(%d), stop\n", __func__, s->idx);
+
+  return NULL;
+}
+
+static int perf_loopback_result(struct st_sample_context* ctx,
+                                struct perf_loopback_session* s) {
+  int measured = s->fb_recv - s->fb_recv_no_meta;
+  double duration_s = (double)(s->last_recv_ns - s->first_recv_ns) / NS_PER_S;
+
+  if (s->fb_recv < 2 || duration_s <= 0) {
+    err("%s(%d), error, only %d frames received\n", __func__, s->idx, s->fb_recv);
+    return -EIO;
+  }
+
+  /* the first frame only marks the start point */
+  double fps = (s->fb_recv - 1) / duration_s;
+  double gbps = fps * s->frame_size * 8 / 1000 / 1000 / 1000;
+  info("%s(%d), %ux%u, sent %d recv %d(incomplete %d), fps %f, %f gbps\n", __func__,
+       s->idx, ctx->width, ctx->height, s->fb_send, s->fb_recv, s->fb_recv_incomplete,
+       fps, gbps);
+  if (measured > 0) {
+    info("%s(%d), latency avg %fus min %fus max %fus\n", __func__, s->idx,
+         (double)s->latency_sum_ns / measured / 1000,
+         (double)s->latency_min_ns / 1000, (double)s->latency_max_ns / 1000);
+  }
+  if (s->fb_recv_incomplete) {
+    err("%s(%d), error, %d incomplete frames\n", __func__, s->idx,
+        s->fb_recv_incomplete);
+    return -EIO;
+  }
+
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  struct st_sample_context ctx;
+  struct mtl_init_params* p = &ctx.param;
+  int ret;
+
+  memset(&ctx, 0, sizeof(ctx));
+  ret = sample_parse_args(&ctx, argc, argv, true, true, true);
+  if (ret < 0) return ret;
+
+  if (p->num_ports < 2) {
+    /* no ports from user, use a memif pair on this process */
+    p->num_ports = 2;
+    snprintf(p->port[MTL_PORT_P], MTL_PORT_MAX_LEN, "%s",
+             "dpdk_memif:role=server,id=0");
+    snprintf(p->port[MTL_PORT_R], MTL_PORT_MAX_LEN, "%s",
+             "dpdk_memif:role=client,id=0");
+    for (uint8_t i = 0; i < p->num_ports; i++) {
+      p->pmd[i] = mtl_pmd_by_port_name(p->port[i]);
+      p->tx_queues_cnt[i] = ctx.sessions;
+      p->rx_queues_cnt[i] = ctx.sessions;
+    }
+  }
+  info("%s, loopback %s -> %s, sessions %u\n", __func__, p->port[MTL_PORT_P],
+       p->port[MTL_PORT_R], ctx.sessions);
+
+  ctx.param.flags |= MTL_FLAG_DEV_AUTO_START_STOP;
+  ctx.st = mtl_init(&ctx.param);
+  if (!ctx.st) {
+    err("%s: mtl_init fail\n", __func__);
+    return -EIO;
+  }
+
+  uint32_t session_num = ctx.sessions;
+  struct perf_loopback_session* app[session_num];
+  enum st_frame_fmt frame_fmt = st_frame_fmt_from_transport(ctx.fmt);
+
+  memset(app, 0, sizeof(app));
+  for (int i = 0; i < session_num; i++) {
+    app[i] = malloc(sizeof(*app[i]));
+    if (!app[i]) {
+      err("%s(%d), app context malloc fail\n", __func__, i);
+      ret = -ENOMEM;
+      goto error;
+    }
+    memset(app[i], 0, sizeof(*app[i]));
+    app[i]->st = ctx.st;
+    app[i]->idx = i;
+    app[i]->latency_min_ns = UINT64_MAX;
+
+    /* no conversion, the transport format is used on both sides */
+    struct st20p_rx_ops ops_rx;
+    memset(&ops_rx, 0, sizeof(ops_rx));
+    ops_rx.name = "perf_loopback_rx";
+    ops_rx.priv = app[i];
+    ops_rx.port.num_port = 1;
+    memcpy(ops_rx.port.ip_addr[MTL_SESSION_PORT_P], mtl_p_sip_addr(p), MTL_IP_ADDR_LEN);
+    snprintf(ops_rx.port.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+             p->port[MTL_PORT_R]);
+    ops_rx.port.udp_port[MTL_SESSION_PORT_P] = ctx.udp_port + i * 2;
+    ops_rx.port.payload_type = ctx.payload_type;
+    ops_rx.width = ctx.width;
+    ops_rx.height = ctx.height;
+    ops_rx.fps = ctx.fps;
+    ops_rx.interlaced = ctx.interlaced;
+    ops_rx.transport_fmt = ctx.fmt;
+    ops_rx.output_fmt = frame_fmt;
+    ops_rx.device = ST_PLUGIN_DEVICE_AUTO;
+    ops_rx.framebuff_cnt = ctx.framebuff_cnt;
+    ops_rx.flags = ST20P_RX_FLAG_BLOCK_GET;
+    app[i]->rx_handle = st20p_rx_create(ctx.st, &ops_rx);
+    if (!app[i]->rx_handle) {
+      err("%s(%d), st20p_rx_create fail\n", __func__, i);
+      ret = -EIO;
+      goto error;
+    }
+
+    struct st20p_tx_ops ops_tx;
+    memset(&ops_tx, 0, sizeof(ops_tx));
+    ops_tx.name = "perf_loopback_tx";
+    ops_tx.priv = app[i];
+    ops_tx.port.num_port = 1;
+    memcpy(ops_tx.port.dip_addr[MTL_SESSION_PORT_P], mtl_r_sip_addr(p), MTL_IP_ADDR_LEN);
+    snprintf(ops_tx.port.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+             p->port[MTL_PORT_P]);
+    ops_tx.port.udp_port[MTL_SESSION_PORT_P] = ctx.udp_port + i * 2;
+    ops_tx.port.payload_type = ctx.payload_type;
+    ops_tx.width = ctx.width;
+    ops_tx.height = ctx.height;
+    ops_tx.fps = ctx.fps;
+    ops_tx.interlaced = ctx.interlaced;
+    ops_tx.input_fmt = frame_fmt;
+    ops_tx.transport_fmt = ctx.fmt;
+    ops_tx.transport_packing = ctx.packing;
+    ops_tx.device = ST_PLUGIN_DEVICE_AUTO;
+    ops_tx.framebuff_cnt = ctx.framebuff_cnt;
+    ops_tx.flags = ST20P_TX_FLAG_BLOCK_GET;
+    app[i]->tx_handle = st20p_tx_create(ctx.st, &ops_tx);
+    if (!app[i]->tx_handle) {
+      err("%s(%d), st20p_tx_create fail\n", __func__, i);
+      ret = -EIO;
+      goto error;
+    }
+    app[i]->frame_size = st20p_tx_frame_size(app[i]->tx_handle);
+
+    ret = pthread_create(&app[i]->rx_thread, NULL, perf_loopback_rx_thread, app[i]);
+    if (ret < 0) {
+      err("%s(%d), rx thread create fail %d\n", __func__, i, ret);
+      ret = -EIO;
+      goto error;
+    }
+    ret = pthread_create(&app[i]->tx_thread, NULL, perf_loopback_tx_thread, app[i]);
+    if (ret < 0) {
+      err("%s(%d), tx thread create fail %d\n", __func__, i, ret);
+      app[i]->stop = true;
+      st20p_rx_wake_block(app[i]->rx_handle);
+      pthread_join(app[i]->rx_thread, NULL);
+      ret = -EIO;
+      goto error;
+    }
+  }
+
+  /* run until all sessions got perf_frames or timeout with twice the frame time */
+  double frame_time_s = 1.0 / st_frame_rate(ctx.fps);
+  uint64_t timeout_ns = (ctx.perf_frames * frame_time_s * 2 + 10) * NS_PER_S;
+  uint64_t start_ns = sample_get_monotonic_time();
+  while (!ctx.exit) {
+    bool done = true;
+    for (int i = 0; i < session_num; i++) {
+      if (app[i]->fb_recv <= ctx.perf_frames) done = false;
+    }
+    if (done) break;
+    if ((sample_get_monotonic_time() - start_ns) > timeout_ns) {
+      err("%s, timeout, not all sessions got %d frames\n", __func__, ctx.perf_frames);
+      break;
+    }
+    usleep(10 * 1000);
+  }
+
+  for (int i = 0; i < session_num; i++) {
+    app[i]->stop = true;
+    st20p_tx_wake_block(app[i]->tx_handle);
+    pthread_join(app[i]->tx_thread, NULL);
+    st20p_rx_wake_block(app[i]->rx_handle);
+    pthread_join(app[i]->rx_thread, NULL);
+  }
+
+  ret = 0;
+  for (int i = 0; i < session_num; i++) {
+    if (perf_loopback_result(&ctx, app[i]) < 0) ret = -EIO;
+  }
+
+error:
+  for (int i = 0; i < session_num; i++) {
+    if (app[i]) {
+      if (app[i]->tx_handle) st20p_tx_free(app[i]->tx_handle);
+      if (app[i]->rx_handle) st20p_rx_free(app[i]->rx_handle);
+      free(app[i]);
+    }
+  }
+
+  if (ctx.st) {
+    mtl_uninit(ctx.st);
+    ctx.st = NULL;
+  }
+  return ret;
+}
@@ -0,0 +1,172 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+/*
+ * Rx stack benchmark without NIC. The P port replays a capture file as fast as possible
+ * in loop, the st20p rx sessions receive from the sender ip(--p_rx_ip) of the capture:
+ * --p_port pcap_replay:/tmp/cap.pcapng --p_sip 192.168.96.2 --p_rx_ip 239.168.85.20
+ */
+
+#include "../sample/sample_util.h"
+
+struct perf_pcap_replay_session {
+  int idx;
+  st20p_rx_handle handle;
+
+  bool stop;
+  pthread_t thread;
+
+  int fb_recv;
+  int fb_recv_incomplete;
+};
+
+static void* perf_pcap_replay_thread(void* arg) {
+  struct perf_pcap_replay_session* s = arg;
+  st20p_rx_handle handle = s->handle;
+  struct st_frame* frame;
+
+  info("%s(%d), start\n", __func__, s->idx);
+  while (!s->stop) {
+    frame = st20p_rx_get_frame(handle);
+    if (!frame) { /* no frame */
+      dbg("%s(%d), get frame time out\n", __func__, s->idx);
+      continue;
+    }
+    if (!st_is_frame_complete(frame->status)) s->fb_recv_incomplete++;
+    s->fb_recv++;
+    st20p_rx_put_frame(handle, frame);
+  }
+  info("%s(%d), stop\n", __func__, s->idx);
+
+  return NULL;
+}
+
+int main(int argc, char** argv) {
+  struct st_sample_context ctx;
+  struct mtl_init_params* p = &ctx.param;
+  int ret;
+
+  memset(&ctx, 0, sizeof(ctx));
+  ret = rx_sample_parse_args(&ctx, argc, argv);
+  if (ret < 0) return ret;
+
+  if (p->pmd[MTL_PORT_P] != MTL_PMD_PCAP_REPLAY) {
+    err("%s, %s is not a pcap_replay port\n", __func__, p->port[MTL_PORT_P]);
+    return -EINVAL;
+  }
+  /* replay the capture in loop as fast as possible */
+  p->port_params[MTL_PORT_P].pcap_replay_mode = MTL_PCAP_REPLAY_AFAP;
+  p->port_params[MTL_PORT_P].flags |= MTL_PORT_FLAG_PCAP_REPLAY_LOOP;
+
+  ctx.param.flags |= MTL_FLAG_DEV_AUTO_START_STOP;
+  ctx.st = mtl_init(&ctx.param);
+  if (!ctx.st) {
+    err("%s: mtl_init fail\n", __func__);
+    return -EIO;
+  }
+
+  uint32_t session_num = ctx.sessions;
+  struct perf_pcap_replay_session* app[session_num];
+
+  memset(app, 0, sizeof(app));
+  for (int i = 0; i < session_num; i++) {
+    app[i] = malloc(sizeof(*app[i]));
+    if (!app[i]) {
+      err("%s(%d), app context malloc fail\n", __func__, i);
+      ret = -ENOMEM;
+      goto error;
+    }
+    memset(app[i], 0, sizeof(*app[i]));
+    app[i]->idx = i;
+
+    struct st20p_rx_ops ops_rx;
+    memset(&ops_rx, 0, sizeof(ops_rx));
+    ops_rx.name = "perf_pcap_replay";
+    ops_rx.priv = app[i];
+    ops_rx.port.num_port = 1;
+    memcpy(ops_rx.port.ip_addr[MTL_SESSION_PORT_P], ctx.rx_ip_addr[MTL_PORT_P],
+           MTL_IP_ADDR_LEN);
+    snprintf(ops_rx.port.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+             p->port[MTL_PORT_P]);
+    ops_rx.port.udp_port[MTL_SESSION_PORT_P] = ctx.udp_port + i * 2;
+    ops_rx.port.payload_type = ctx.payload_type;
+    ops_rx.width = ctx.width;
+    ops_rx.height = ctx.height;
+    ops_rx.fps = ctx.fps;
+    ops_rx.interlaced = ctx.interlaced;
+    ops_rx.transport_fmt = ctx.fmt;
+    ops_rx.output_fmt = st_frame_fmt_from_transport(ctx.fmt);
+    ops_rx.device = ST_PLUGIN_DEVICE_AUTO;
+    ops_rx.framebuff_cnt = ctx.framebuff_cnt;
+    ops_rx.flags = ST20P_RX_FLAG_BLOCK_GET;
+    app[i]->handle = st20p_rx_create(ctx.st, &ops_rx);
+    if (!app[i]->handle) {
+      err("%s(%d), st20p_rx_create fail\n", __func__, i);
+      ret = -EIO;
+      goto error;
+    }
+
+    ret = pthread_create(&app[i]->thread, NULL, perf_pcap_replay_thread, app[i]);
+    if (ret < 0) {
+      err("%s(%d), thread create fail %d\n", __func__, i, ret);
+      ret = -EIO;
+      goto error;
+    }
+  }
+
+  mtl_reset_port_stats(ctx.st, MTL_PORT_P);
+  uint64_t start_ns = sample_get_monotonic_time();
+  /* run until all sessions got perf_frames or 60s */
+  uint64_t timeout_ns = (uint64_t)60 * NS_PER_S;
+  while (!ctx.exit) {
+    bool done = true;
+    for (int i = 0; i < session_num; i++) {
+      if (app[i]->fb_recv < ctx.perf_frames) done = false;
+    }
+    if (done) break;
+    if ((sample_get_monotonic_time() - start_ns) > timeout_ns) {
+      err("%s, timeout, not all sessions got %d frames\n", __func__, ctx.perf_frames);
+      break;
+    }
+    usleep(10 * 1000);
+  }
+  double duration_s = (double)(sample_get_monotonic_time() - start_ns) / NS_PER_S;
+
+  struct mtl_port_status stats;
+  memset(&stats, 0, sizeof(stats));
+  mtl_get_port_stats(ctx.st, MTL_PORT_P, &stats);
+
+  for (int i = 0; i < session_num; i++) {
+    app[i]->stop = true;
+    st20p_rx_wake_block(app[i]->handle);
+    pthread_join(app[i]->thread, NULL);
+  }
+
+  ret = 0;
+  info("%s, replay %" PRIu64 " pkts in %fs, %f mpps, %f gbps\n", __func__,
+       stats.rx_packets, duration_s, (double)stats.rx_packets / duration_s / 1000 / 1000,
+       (double)stats.rx_bytes * 8 / duration_s / 1000 / 1000 / 1000);
+  for (int i = 0; i < session_num; i++) {
+    info("%s(%d), recv %d(incomplete %d), fps %f\n", __func__, i, app[i]->fb_recv,
+         app[i]->fb_recv_incomplete, app[i]->fb_recv / duration_s);
+    if (!app[i]->fb_recv) {
+      err("%s(%d), error, no frame received\n", __func__, i);
+      ret = -EIO;
+    }
+  }
+
+error:
+  for (int i = 0; i < session_num; i++) {
+    if (app[i]) {
+      if (app[i]->handle) st20p_rx_free(app[i]->handle);
+      free(app[i]);
+    }
+  }
+
+  if (ctx.st) {
+    mtl_uninit(ctx.st);
+    ctx.st = NULL;
+  }
+  return ret;
+}
@@ -0,0 +1,226 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+/*
+ * Benchmark of the st30p sample format conversion, the big endian PCM of the wire to
+ * and from the S32/F32 app samples, interleaved and planar, at each SIMD level the CPU
+ * supports: PerfPcmConvert --channel 64 --samples 48
+ */
+
+#include <getopt.h>
+
+#include "../sample/sample_util.h"
+
+#define PERF_PCM_LOOPS_DEFAULT (1000)
+#define PERF_PCM_CHANNEL_DEFAULT (64)
+#define PERF_PCM_SAMPLES_DEFAULT (48) /* 1ms at 48k */
+
+struct perf_pcm_ctx {
+  uint16_t channel;
+  uint32_t samples;
+  int loops;
+  enum mtl_simd_level max_level;
+};
+
+enum perf_pcm_args_cmd {
+  PERF_PCM_ARG_UNKNOWN = 0,
+  PERF_PCM_ARG_CHANNEL = 0x100, /* start from end of ascii */
+  PERF_PCM_ARG_SAMPLES,
+  PERF_PCM_ARG_LOOPS,
+  PERF_PCM_ARG_MAX_LEVEL,
+  PERF_PCM_ARG_HELP,
+};
+
+static const enum st30_fmt perf_pcm_fmts[] = {ST30_FMT_PCM8, ST30_FMT_PCM16,
+                                              ST30_FMT_PCM24};
+static const char* perf_pcm_fmt_names[] = {"pcm8", "pcm16", "pcm24"};
+static const enum mtl_simd_level perf_pcm_levels[] = {
+    MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX512};
+
+static int perf_pcm_u64_cmp(const void* a, const void* b) {
+  uint64_t va = *(const uint64_t*)a;
+  uint64_t vb = *(const uint64_t*)b;
+  return (va > vb) - (va < vb);
+}
+
+static void perf_pcm_fill(uint8_t* buf, size_t size) {
+  uint32_t seed = 0x12345678;
+
+  for (size_t i = 0; i < size; i++) {
+    seed = seed * 1103515245 + 12345;
+    buf[i] = seed >> 16;
+  }
+}
+
+static int perf_pcm_convert(enum st30_fmt fmt, uint16_t channel, uint8_t* wire,
+                            size_t wire_size, enum st30p_sample_fmt app_fmt, bool planar,
+                            void* app, bool to_wire, enum mtl_simd_level level) {
+  if (to_wire)
+    return st30p_sample_to_wire_simd(fmt, channel, app, app_fmt, planar, wire, wire_size,
+                                     level);
+  return st30p_sample_to_app_simd(fmt, channel, wire, wire_size, app_fmt, planar, app,
+                                  level);
+}
+
+/* the median ns of one frame, 0 on fail */
+static uint64_t perf_pcm_run(struct perf_pcm_ctx* ctx, enum st30_fmt fmt,
+                             enum st30p_sample_fmt app_fmt, bool planar, bool to_wire,
+                             enum mtl_simd_level level, uint8_t* wire, void* app) {
+  size_t wire_size = (size_t)st30_get_sample_size(fmt) * ctx->channel * ctx->samples;
+  uint64_t* ns;
+  uint64_t median;
+
+  /* warm up, also check the conversion work at this level */
+  if (perf_pcm_convert(fmt, ctx->channel, wire, wire_size, app_fmt, planar, app, to_wire,
+                       level) < 0)
+    return 0;
+
+  ns = malloc(sizeof(*ns) * ctx->loops);
+  if (!ns) return 0;
+  for (int i = 0; i < ctx->loops; i++) {
+    uint64_t start_ns = sample_get_monotonic_time();
+    perf_pcm_convert(fmt, ctx->channel, wire, wire_size, app_fmt, planar, app, to_wire,
+                     level);
+    ns[i] = sample_get_monotonic_time() - start_ns;
+  }
+  qsort(ns, ctx->loops, sizeof(ns[0]), perf_pcm_u64_cmp);
+  median = ns[ctx->loops / 2];
+  free(ns);
+  return median ? median : 1;
+}
+
+static int perf_pcm_all(struct perf_pcm_ctx* ctx) {
+  size_t samples = (size_t)ctx->channel * ctx->samples;
+  uint8_t* wire = malloc(samples * 4); /* big enough for all the fmts */
+  void* app = malloc(samples * 4);
+  int ret = 0;
+
+  if (!wire || !app) {
+    err("%s, buffer malloc fail\n", __func__);
+    free(wire);
+    free(app);
+    return -ENOMEM;
+  }
+  perf_pcm_fill(wire, samples * 4);
+
+  info("%s, %u channels, %u samples per frame, %d loops\n", __func__, ctx->channel,
+       ctx->samples, ctx->loops);
+  for (size_t f = 0; f < MTL_ARRAY_SIZE(perf_pcm_fmts); f++) {
+    for (int a = ST30P_SAMPLE_FMT_S32; a <= ST30P_SAMPLE_FMT_F32; a++) {
+      for (int planar = 0; planar <= 1; planar++) {
+        for (int to_wire = 0; to_wire <= 1; to_wire++) {
+          uint64_t scalar_ns = 0;
+
+          /* the app buffer of the to wire run is the output of the to app run */
+          for (size_t l = 0; l < MTL_ARRAY_SIZE(perf_pcm_levels); l++) {
+            enum mtl_simd_level level = perf_pcm_levels[l];
+            if (level > ctx->max_level) break;
+
+            uint64_t ns = perf_pcm_run(ctx, perf_pcm_fmts[f], a, planar, to_wire, level,
+                                       wire, app);
+            if (!ns) {
+              err("%s, %s %s fail at %s\n", __func__, perf_pcm_fmt_names[f],
+                  to_wire ? "to wire" : "to app", mtl_get_simd_level_name(level));
+              ret = -EIO;
+              continue;
+            }
+            if (level == MTL_SIMD_LEVEL_NONE) scalar_ns = ns;
+            info("%s %s %s %s, %s: %" PRIu64 " ns/frame, %.1f Msamples/s, %.2fx\n",
+                 perf_pcm_fmt_names[f], to_wire ? "<-" : "->",
+                 (a == ST30P_SAMPLE_FMT_F32) ? "f32" : "s32",
+                 planar ? "planar" : "interleaved", mtl_get_simd_level_name(level), ns,
+                 (double)samples * 1000 / ns, scalar_ns ? (double)scalar_ns / ns : 0);
+          }
+        }
+      }
+    }
+  }
+
+  free(wire);
+  free(app);
+  return ret;
+}
+
+static struct option perf_pcm_args_options[] = {
+    {"channel", required_argument, 0, PERF_PCM_ARG_CHANNEL},
+    {"samples", required_argument, 0, PERF_PCM_ARG_SAMPLES},
+    {"loops", required_argument, 0, PERF_PCM_ARG_LOOPS},
+    {"max_level", required_argument, 0, PERF_PCM_ARG_MAX_LEVEL},
+    {"help", no_argument, 0, PERF_PCM_ARG_HELP},
+    {0, 0, 0, 0},
+};
+
+static void perf_pcm_print_help(void) {
+  printf("\n");
+  printf("##### Usage: #####\n\n");
+  printf(" Params:\n");
+  printf(" --channel <n>        : channels of the frame, default %d\n",
+         PERF_PCM_CHANNEL_DEFAULT);
+  printf(" --samples <n>        : samples of each channel in one frame, default %d\n",
+         PERF_PCM_SAMPLES_DEFAULT);
+  printf(" --loops <n>          : timed loops of each case, default %d\n",
+         PERF_PCM_LOOPS_DEFAULT);
+  printf(" --max_level <level>  : the max simd level, none/avx2/avx512\n");
+  printf("\n");
+}
+
+static int perf_pcm_parse_args(struct perf_pcm_ctx* ctx, int argc, char** argv) {
+  int cmd = -1, opt_idx = 0;
+
+  while (1) {
+    cmd = getopt_long_only(argc, argv, "hv", perf_pcm_args_options, &opt_idx);
+    if (cmd == -1) break;
+
+    switch (cmd) {
+      case PERF_PCM_ARG_CHANNEL:
+        ctx->channel = atoi(optarg);
+        break;
+      case PERF_PCM_ARG_SAMPLES:
+        ctx->samples = atoi(optarg);
+        break;
+      case PERF_PCM_ARG_LOOPS:
+        ctx->loops = atoi(optarg);
+        break;
+      case PERF_PCM_ARG_MAX_LEVEL: {
+        int level;
+        for (level = 0; level < MTL_SIMD_LEVEL_MAX; level++) {
+          if (!strcmp(optarg, mtl_get_simd_level_name(level))) break;
+        }
+        if (level >= MTL_SIMD_LEVEL_MAX) {
+          err("%s, invalid level %s\n", __func__, optarg);
+          return -EINVAL;
+        }
+        if (level < (int)ctx->max_level) ctx->max_level = level;
+        break;
+      }
+      case PERF_PCM_ARG_HELP:
+      default:
+        perf_pcm_print_help();
+        return -EINVAL;
+    }
+  }
+
+  if (ctx->loops <= 0 || !ctx->channel || !ctx->samples) {
+    err("%s, invalid loops %d channel %u samples %u\n", __func__, ctx->loops,
+        ctx->channel, ctx->samples);
+    return -EINVAL;
+  }
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  struct perf_pcm_ctx ctx;
+  int ret;
+
+  memset(&ctx, 0, sizeof(ctx));
+  ctx.channel = PERF_PCM_CHANNEL_DEFAULT;
+  ctx.samples = PERF_PCM_SAMPLES_DEFAULT;
+  ctx.loops = PERF_PCM_LOOPS_DEFAULT;
+  ctx.max_level = mtl_get_simd_level();
+  ret = perf_pcm_parse_args(&ctx, argc, argv);
+  if (ret < 0) return ret;
+
+  info("%s, max simd level %s\n", __func__, mtl_get_simd_level_name(ctx.max_level));
+  return perf_pcm_all(&ctx);
+}
@@ -37,4 +37,27 @@ perf_func PerfRfc4175422be12ToP12Le
 perf_func PerfRfc4175422be10ToP8
 perf_func PerfDma
 
+# all the built-in converters, no NIC needed
+echo "Start to run: PerfConvert"
+"${TEST_BIN_PATH}"/PerfConvert --loops "${TEST_FRAMES}"
+echo ""
+
+# the st30p pcm sample format conversion, no NIC needed
+echo "Start to run: PerfPcmConvert"
+"${TEST_BIN_PATH}"/PerfPcmConvert
+echo ""
+
+# NIC-less end to end loopback on a memif port pair
+echo "Start to run: PerfLoopback"
+"${TEST_BIN_PATH}"/PerfLoopback --log_level "${LOG_LEVEL}" --perf_frames "${TEST_FRAMES}"
+echo ""
+
+# NIC-less rx stack throughput, replay a st2110-20 capture given by PCAP_REPLAY_FILE
+if [ -n "${PCAP_REPLAY_FILE}" ]; then
+  echo "Start to run: PerfPcapReplay"
+  "${TEST_BIN_PATH}"/PerfPcapReplay --log_level "${LOG_LEVEL}" --perf_frames "${TEST_FRAMES}" \
+    --p_port "pcap_replay:${PCAP_REPLAY_FILE}" ${PCAP_REPLAY_ARGS}
+  echo ""
+fi
+
 echo "****** All Perf test OK ******"
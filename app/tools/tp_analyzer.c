@@ -0,0 +1,901 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+/*
+ * Offline ST2110-21 timing analyzer. The scanner thread reads the capture, splits the
+ * st2110-20 packets by flow and by frame, and the worker threads run the MTL rx timing
+ * parser on each frame in parallel. The per frame and per stream results are reported in
+ * JSON.
+ */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <mtl/st20_api.h>
+#include <pcap.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "log.h"
+
+#define TA_MAX_FLOWS (64)
+#define TA_MAX_THREADS (64)
+/* frames in flight for each worker, limit the memory for huge captures */
+#define TA_JOBS_PER_THREAD (4)
+/* the flows with less packets per frame are not st2110-20 video */
+#define TA_MIN_PKTS_PER_FRAME (16)
+#define TA_HIST_BINS (128)
+
+#define TA_ETH_HDR_LEN (14)
+#define TA_VLAN_HDR_LEN (4)
+#define TA_RTP_HDR_LEN (12)
+#define TA_NS_PER_S (1000000000ULL)
+/* the frame deltas to detect the fps, 119.88 has a 751 delta in any 4 */
+#define TA_FPS_DETECT_DELTAS (4)
+
+struct ta_fps_map {
+  enum st_fps fps;
+  const char* name;
+  /* rtp timestamp deltas of 2 consecutive frames, the fractional fps alternate */
+  uint32_t delta[2];
+};
+
+/* all the deltas match the first entry, 120 is before 119.88 as it has 750 only */
+static const struct ta_fps_map ta_fps_maps[] = {
+    {ST_FPS_P59_94, "59.94", {1501, 1502}}, {ST_FPS_P60, "60", {1500, 1500}},
+    {ST_FPS_P50, "50", {1800, 1800}},       {ST_FPS_P29_97, "29.97", {3003, 3003}},
+    {ST_FPS_P30, "30", {3000, 3000}},       {ST_FPS_P25, "25", {3600, 3600}},
+    {ST_FPS_P24, "24", {3750, 3750}},       {ST_FPS_P23_98, "23.98", {3753, 3754}},
+    {ST_FPS_P120, "120", {750, 750}},       {ST_FPS_P119_88, "119.88", {750, 751}},
+    {ST_FPS_P100, "100", {900, 900}},
+};
+
+struct ta_pkt {
+  uint64_t time; /* ns */
+  uint32_t idx;  /* packet index in the frame */
+};
+
+struct ta_job {
+  int flow;
+  uint64_t frame_idx;
+  uint32_t rtp_tmstamp;
+  uint32_t prev_rtp_tmstamp;
+
+  struct ta_pkt* pkts;
+  uint32_t pkts_cnt;
+  uint32_t pkts_max;
+
+  struct ta_job* next;
+};
+
+struct ta_hist {
+  int32_t bin_width;
+  int32_t min;
+  int32_t max;
+  uint64_t underflow;
+  uint64_t overflow;
+  uint64_t bins[TA_HIST_BINS];
+};
+
+struct ta_frame_result {
+  uint64_t frame_idx;
+  uint32_t rtp_tmstamp;
+  enum st_rx_tp_compliant compliant;
+  int32_t cinst_max;
+  int32_t vrx_max;
+  int32_t fpt;
+  int32_t latency;
+  char failed_cause[64];
+};
+
+/* the result of one flow, accumulated by each worker and merged at the end */
+struct ta_flow_result {
+  uint64_t frames;
+  uint64_t compliant[ST_RX_TP_COMPLIANT_MAX];
+  struct ta_hist cinst_max;
+  struct ta_hist vrx_max;
+  struct ta_hist fpt;
+  struct ta_hist latency;
+
+  struct ta_frame_result* frame_results;
+  uint64_t frame_results_cnt;
+  uint64_t frame_results_max;
+};
+
+struct ta_flow {
+  uint32_t src_ip;
+  uint32_t dst_ip;
+  uint16_t dst_port;
+  bool ignored;
+
+  /* set by the scanner before the first frame dispatched, read only for workers */
+  struct st20_tp_parser_ops ops;
+  bool ops_ready;
+
+  /* scanner state */
+  struct ta_job* cur;
+  bool started; /* the first frame is dropped as it may be partial */
+  uint32_t cur_rtp_tmstamp;
+  uint32_t first_seq;
+  uint32_t prev_rtp_tmstamp;
+  bool has_prev_rtp_tmstamp;
+  uint64_t frames_dispatched;
+  uint64_t pkts;
+  /* the frame deltas before the fps detected */
+  uint32_t fps_deltas[TA_FPS_DETECT_DELTAS];
+  int fps_deltas_cnt;
+};
+
+struct ta_ctx;
+
+struct ta_worker {
+  int idx;
+  struct ta_ctx* ctx;
+  pthread_t thread;
+  st20_tp_parser_handle parsers[TA_MAX_FLOWS];
+  struct ta_flow_result results[TA_MAX_FLOWS];
+};
+
+struct ta_ctx {
+  /* args */
+  const char* pcap_file;
+  const char* out_file;
+  int threads;
+  enum st_fps fps; /* ST_FPS_MAX: auto detect */
+  uint32_t height;
+  bool interlaced;
+  uint32_t pkts_per_frame; /* 0: auto detect */
+  int64_t time_offset_ns;  /* add to the capture time to get the TAI time */
+  bool frame_report;
+
+  struct ta_flow flows[TA_MAX_FLOWS];
+  int flows_cnt;
+
+  /* the job queue between the scanner and workers */
+  pthread_mutex_t lock;
+  pthread_cond_t cond_job;  /* signal to workers */
+  pthread_cond_t cond_free; /* signal to the scanner */
+  struct ta_job* queue_head;
+  struct ta_job* queue_tail;
+  struct ta_job* free_jobs;
+  int jobs_cnt;
+  int jobs_max;
+  bool scan_done;
+
+  struct ta_worker workers[TA_MAX_THREADS];
+
+  uint64_t pcap_pkts;
+  uint64_t video_pkts;
+};
+
+enum ta_args_cmd {
+  TA_ARG_UNKNOWN = 0,
+  TA_ARG_HELP = 0x100, /* start from end of ascii */
+  TA_ARG_PCAP,
+  TA_ARG_OUT,
+  TA_ARG_THREADS,
+  TA_ARG_FPS,
+  TA_ARG_HEIGHT,
+  TA_ARG_INTERLACED,
+  TA_ARG_PKTS_PER_FRAME,
+  TA_ARG_UTC_OFFSET,
+  TA_ARG_FRAMES,
+  TA_ARG_MAX,
+};
+
+static struct option ta_args_options[] = {
+    {"help", no_argument, 0, TA_ARG_HELP},
+    {"pcap", required_argument, 0, TA_ARG_PCAP},
+    {"out", required_argument, 0, TA_ARG_OUT},
+    {"threads", required_argument, 0, TA_ARG_THREADS},
+    {"fps", required_argument, 0, TA_ARG_FPS},
+    {"height", required_argument, 0, TA_ARG_HEIGHT},
+    {"interlaced", no_argument, 0, TA_ARG_INTERLACED},
+    {"pkts_per_frame", required_argument, 0, TA_ARG_PKTS_PER_FRAME},
+    {"utc_offset", required_argument, 0, TA_ARG_UTC_OFFSET},
+    {"frames", no_argument, 0, TA_ARG_FRAMES},
+    {0, 0, 0, 0},
+};
+
+static void ta_print_help() {
+  printf("\n");
+  printf("##### Usage: #####\n\n");
+
+  printf("Params:\n");
+  printf(" --help: Print the help information\n");
+  printf(" --pcap <file>: The pcap file to analyze\n");
+  printf(" --out <file>: The JSON report file, default tp_report.json\n");
+  printf(" --threads <n>: The worker threads number, default 4\n");
+  printf(" --fps <59.94|50|29.97|...>: The stream fps, default auto detect by rtp\n");
+  printf(" --height <n>: The stream height, default 1080\n");
+  printf(" --interlaced: The stream is interlaced\n");
+  printf(" --pkts_per_frame <n>: The packets per frame, default auto detect\n");
+  printf(" --utc_offset <s>: Add to the capture time if it's UTC, ex: 37\n");
+  printf(" --frames: Report the result of each frame\n");
+
+  printf("\n");
+}
+
+static int ta_parse_args(struct ta_ctx* ctx, int argc, char** argv) {
+  int cmd = -1, opt_idx = 0;
+
+  while (1) {
+    cmd = getopt_long_only(argc, argv, "hv", ta_args_options, &opt_idx);
+    if (cmd == -1) break;
+
+    switch (cmd) {
+      case TA_ARG_PCAP:
+        ctx->pcap_file = optarg;
+        break;
+      case TA_ARG_OUT:
+        ctx->out_file = optarg;
+        break;
+      case TA_ARG_THREADS:
+        ctx->threads = atoi(optarg);
+        break;
+      case TA_ARG_FPS:
+        ctx->fps = st_name_to_fps(optarg);
+        if (ctx->fps == ST_FPS_MAX) {
+          err("%s, invalid fps %s\n", __func__, optarg);
+          return -EINVAL;
+        }
+        break;
+      case TA_ARG_HEIGHT:
+        ctx->height = atoi(optarg);
+        break;
+      case TA_ARG_INTERLACED:
+        ctx->interlaced = true;
+        break;
+      case TA_ARG_PKTS_PER_FRAME:
+        ctx->pkts_per_frame = atoi(optarg);
+        break;
+      case TA_ARG_UTC_OFFSET:
+        ctx->time_offset_ns = (int64_t)atoi(optarg) * TA_NS_PER_S;
+        break;
+      case TA_ARG_FRAMES:
+        ctx->frame_report = true;
+        break;
+      case TA_ARG_HELP:
+      default:
+        ta_print_help();
+        return -EIO;
+    }
+  }
+
+  if (!ctx->pcap_file) {
+    err("%s, no pcap file\n", __func__);
+    ta_print_help();
+    return -EINVAL;
+  }
+  if (ctx->threads < 1 || ctx->threads > TA_MAX_THREADS) {
+    err("%s, invalid threads %d\n", __func__, ctx->threads);
+    return -EINVAL;
+  }
+  return 0;
+}
+
+static const char* ta_fps_name(enum st_fps fps) {
+  for (size_t i = 0; i < sizeof(ta_fps_maps) / sizeof(ta_fps_maps[0]); i++) {
+    if (ta_fps_maps[i].fps == fps) return ta_fps_maps[i].name;
+  }
+  return "unknown";
+}
+
+static enum st_fps ta_fps_detect(const uint32_t* deltas, int cnt) {
+  for (size_t i = 0; i < sizeof(ta_fps_maps) / sizeof(ta_fps_maps[0]); i++) {
+    const struct ta_fps_map* map = &ta_fps_maps[i];
+    int match = 0;
+
+    for (int d = 0; d < cnt; d++) {
+      if (deltas[d] == map->delta[0] || deltas[d] == map->delta[1]) match++;
+    }
+    if (match == cnt) return map->fps;
+  }
+  return ST_FPS_MAX;
+}
+
+static const char* ta_compliant_name(enum st_rx_tp_compliant compliant) {
+  switch (compliant) {
+    case ST_RX_TP_COMPLIANT_NARROW:
+      return "narrow";
+    case ST_RX_TP_COMPLIANT_WIDE:
+      return "wide";
+    default:
+      return "failed";
+  }
+}
+
+static void ta_hist_init(struct ta_hist* hist, int32_t bin_width) {
+  memset(hist, 0, sizeof(*hist));
+  hist->bin_width = bin_width;
+  hist->min = INT32_MAX;
+  hist->max = INT32_MIN;
+}
+
+static void ta_hist_add(struct ta_hist* hist, int32_t value) {
+  if (value < hist->min) hist->min = value;
+  if (value > hist->max) hist->max = value;
+  if (value < 0) {
+    hist->underflow++;
+    return;
+  }
+  int32_t bin = value / hist->bin_width;
+  if (bin >= TA_HIST_BINS)
+    hist->overflow++;
+  else
+    hist->bins[bin]++;
+}
+
+static void ta_hist_merge(struct ta_hist* dst, struct ta_hist* src) {
+  if (src->min < dst->min) dst->min = src->min;
+  if (src->max > dst->max) dst->max = src->max;
+  dst->underflow += src->underflow;
+  dst->overflow += src->overflow;
+  for (int i = 0; i < TA_HIST_BINS; i++) dst->bins[i] += src->bins[i];
+}
+
+static void ta_flow_result_init(struct ta_flow_result* result) {
+  memset(result, 0, sizeof(*result));
+  ta_hist_init(&result->cinst_max, 1);
+  ta_hist_init(&result->vrx_max, 8);
+  ta_hist_init(&result->fpt, 10 * 1000);     /* 10us */
+  ta_hist_init(&result->latency, 10 * 1000); /* 10us */
+}
+
+static int ta_flow_result_add_frame(struct ta_flow_result* result,
+                                    struct ta_frame_result* frame) {
+  if (result->frame_results_cnt >= result->frame_results_max) {
+    uint64_t max = result->frame_results_max ? result->frame_results_max * 2 : 1024;
+    struct ta_frame_result* frames =
+        realloc(result->frame_results, max * sizeof(*result->frame_results));
+    if (!frames) return -ENOMEM;
+    result->frame_results = frames;
+    result->frame_results_max = max;
+  }
+  result->frame_results[result->frame_results_cnt++] = *frame;
+  return 0;
+}
+
+static struct ta_job* ta_job_get(struct ta_ctx* ctx) {
+  struct ta_job* job = NULL;
+
+  pthread_mutex_lock(&ctx->lock);
+  while (!ctx->free_jobs && ctx->jobs_cnt >= ctx->jobs_max)
+    pthread_cond_wait(&ctx->cond_free, &ctx->lock);
+  if (ctx->free_jobs) {
+    job = ctx->free_jobs;
+    ctx->free_jobs = job->next;
+  } else {
+    job = calloc(1, sizeof(*job));
+    if (job) ctx->jobs_cnt++;
+  }
+  pthread_mutex_unlock(&ctx->lock);
+
+  if (job) {
+    job->pkts_cnt = 0;
+    job->next = NULL;
+  }
+  return job;
+}
+
+static void ta_job_put(struct ta_ctx* ctx, struct ta_job* job) {
+  pthread_mutex_lock(&ctx->lock);
+  job->next = ctx->free_jobs;
+  ctx->free_jobs = job;
+  pthread_cond_signal(&ctx->cond_free);
+  pthread_mutex_unlock(&ctx->lock);
+}
+
+static void ta_job_dispatch(struct ta_ctx* ctx, struct ta_job* job) {
+  pthread_mutex_lock(&ctx->lock);
+  job->next = NULL;
+  if (ctx->queue_tail)
+    ctx->queue_tail->next = job;
+  else
+    ctx->queue_head = job;
+  ctx->queue_tail = job;
+  pthread_cond_signal(&ctx->cond_job);
+  pthread_mutex_unlock(&ctx->lock);
+}
+
+static int ta_job_add_pkt(struct ta_job* job, uint64_t time, uint32_t idx) {
+  if (job->pkts_cnt >= job->pkts_max) {
+    uint32_t max = job->pkts_max ? job->pkts_max * 2 : 4096;
+    struct ta_pkt* pkts = realloc(job->pkts, max * sizeof(*job->pkts));
+    if (!pkts) return -ENOMEM;
+    job->pkts = pkts;
+    job->pkts_max = max;
+  }
+  job->pkts[job->pkts_cnt].time = time;
+  job->pkts[job->pkts_cnt].idx = idx;
+  job->pkts_cnt++;
+  return 0;
+}
+
+static void ta_worker_parse(struct ta_worker* worker, struct ta_job* job) {
+  struct ta_ctx* ctx = worker->ctx;
+  struct ta_flow* flow = &ctx->flows[job->flow];
+  st20_tp_parser_handle parser = worker->parsers[job->flow];
+  struct ta_flow_result* result = &worker->results[job->flow];
+  struct st20_rx_tp_meta meta;
+  int ret;
+
+  if (!parser) {
+    parser = st20_tp_parser_create(&flow->ops);
+    if (!parser) {
+      err("%s(%d), parser create fail for flow %d\n", __func__, worker->idx, job->flow);
+      return;
+    }
+    worker->parsers[job->flow] = parser;
+  }
+
+  /* frames of one flow are spread across workers, pass the previous rtp timestamp */
+  st20_tp_parser_frame_start(parser, job->prev_rtp_tmstamp);
+  for (uint32_t i = 0; i < job->pkts_cnt; i++) {
+    st20_tp_parser_on_packet(parser, job->rtp_tmstamp, job->pkts[i].time,
+                             job->pkts[i].idx);
+  }
+  ret = st20_tp_parser_frame_result(parser, &meta);
+  if (ret < 0) return;
+
+  result->frames++;
+  if (meta.compliant < ST_RX_TP_COMPLIANT_MAX) result->compliant[meta.compliant]++;
+  ta_hist_add(&result->cinst_max, meta.cinst_max);
+  ta_hist_add(&result->vrx_max, meta.vrx_max);
+  ta_hist_add(&result->fpt, meta.fpt);
+  ta_hist_add(&result->latency, meta.latency);
+
+  if (ctx->frame_report) {
+    struct ta_frame_result frame;
+
+    memset(&frame, 0, sizeof(frame));
+    frame.frame_idx = job->frame_idx;
+    frame.rtp_tmstamp = job->rtp_tmstamp;
+    frame.compliant = meta.compliant;
+    frame.cinst_max = meta.cinst_max;
+    frame.vrx_max = meta.vrx_max;
+    frame.fpt = meta.fpt;
+    frame.latency = meta.latency;
+    if (meta.compliant != ST_RX_TP_COMPLIANT_NARROW)
+      snprintf(frame.failed_cause, sizeof(frame.failed_cause), "%s", meta.failed_cause);
+    if (ta_flow_result_add_frame(result, &frame) < 0)
+      err("%s(%d), frame result malloc fail\n", __func__, worker->idx);
+  }
+}
+
+static void* ta_worker_thread(void* arg) {
+  struct ta_worker* worker = arg;
+  struct ta_ctx* ctx = worker->ctx;
+  struct ta_job* job;
+
+  dbg("%s(%d), start\n", __func__, worker->idx);
+  while (1) {
+    pthread_mutex_lock(&ctx->lock);
+    while (!ctx->queue_head && !ctx->scan_done)
+      pthread_cond_wait(&ctx->cond_job, &ctx->lock);
+    job = ctx->queue_head;
+    if (job) {
+      ctx->queue_head = job->next;
+      if (!ctx->queue_head) ctx->queue_tail = NULL;
+    }
+    pthread_mutex_unlock(&ctx->lock);
+    if (!job) break; /* scan done and queue empty */
+
+    ta_worker_parse(worker, job);
+    ta_job_put(ctx, job);
+  }
+  dbg("%s(%d), stop\n", __func__, worker->idx);
+
+  return NULL;
+}
+
+static int ta_flow_lookup(struct ta_ctx* ctx, uint32_t src_ip, uint32_t dst_ip,
+                          uint16_t dst_port) {
+  for (int i = 0; i < ctx->flows_cnt; i++) {
+    struct ta_flow* flow = &ctx->flows[i];
+    if (flow->src_ip == src_ip && flow->dst_ip == dst_ip && flow->dst_port == dst_port)
+      return i;
+  }
+  if (ctx->flows_cnt >= TA_MAX_FLOWS) return -ENOSPC;
+
+  int idx = ctx->flows_cnt;
+  struct ta_flow* flow = &ctx->flows[idx];
+  memset(flow, 0, sizeof(*flow));
+  flow->src_ip = src_ip;
+  flow->dst_ip = dst_ip;
+  flow->dst_port = dst_port;
+  ctx->flows_cnt++;
+  return idx;
+}
+
+/* prepare the parser ops of the flow by the first frame to dispatch */
+static int ta_flow_ops_init(struct ta_ctx* ctx, int idx, struct ta_job* job) {
+  struct ta_flow* flow = &ctx->flows[idx];
+  struct st20_tp_parser_ops* ops = &flow->ops;
+  uint32_t delta = job->rtp_tmstamp - job->prev_rtp_tmstamp;
+  uint32_t pkts = 0;
+
+  for (uint32_t i = 0; i < job->pkts_cnt; i++) {
+    if (job->pkts[i].idx + 1 > pkts) pkts = job->pkts[i].idx + 1;
+  }
+  if (pkts < TA_MIN_PKTS_PER_FRAME) {
+    info("%s(%d), only %u pkts per frame, not a video flow\n", __func__, idx, pkts);
+    return -EINVAL;
+  }
+
+  ops->fps = ctx->fps;
+  if (ops->fps == ST_FPS_MAX) {
+    /* one delta can't tell 119.88 from 120, wait more frames */
+    flow->fps_deltas[flow->fps_deltas_cnt++] = delta;
+    if (flow->fps_deltas_cnt < TA_FPS_DETECT_DELTAS) return -EAGAIN;
+    ops->fps = ta_fps_detect(flow->fps_deltas, flow->fps_deltas_cnt);
+  }
+  if (ops->fps == ST_FPS_MAX) {
+    err("%s(%d), unknown rtp deltas from %u to %u, try --fps\n", __func__, idx,
+        flow->fps_deltas[0], flow->fps_deltas[flow->fps_deltas_cnt - 1]);
+    return -EINVAL;
+  }
+  ops->height = ctx->height;
+  ops->interlaced = ctx->interlaced;
+  ops->pkts_per_frame = ctx->pkts_per_frame ? ctx->pkts_per_frame : pkts;
+  flow->ops_ready = true;
+  info("%s(%d), fps %s pkts per frame %u\n", __func__, idx, ta_fps_name(ops->fps),
+       ops->pkts_per_frame);
+  return 0;
+}
+
+/* the current frame of the flow end, dispatch it to workers or drop it */
+static void ta_flow_frame_end(struct ta_ctx* ctx, int idx) {
+  struct ta_flow* flow = &ctx->flows[idx];
+  struct ta_job* job = flow->cur;
+  bool dispatch = flow->started && flow->has_prev_rtp_tmstamp && !flow->ignored;
+
+  if (!job) return;
+  flow->cur = NULL;
+
+  if (dispatch && !flow->ops_ready) {
+    int ret = ta_flow_ops_init(ctx, idx, job);
+    if (ret < 0) {
+      /* the frames before the fps detected are not parsed */
+      if (ret != -EAGAIN) flow->ignored = true;
+      dispatch = false;
+    }
+  }
+
+  flow->started = true;
+  flow->prev_rtp_tmstamp = job->rtp_tmstamp;
+  flow->has_prev_rtp_tmstamp = true;
+  if (!dispatch) {
+    ta_job_put(ctx, job);
+    return;
+  }
+  job->frame_idx = flow->frames_dispatched++;
+  ta_job_dispatch(ctx, job);
+}
+
+static int ta_on_rtp(struct ta_ctx* ctx, int idx, uint64_t time, const uint8_t* rtp,
+                     uint32_t len) {
+  struct ta_flow* flow = &ctx->flows[idx];
+  bool marker = rtp[1] & 0x80;
+  uint32_t rtp_tmstamp = ntohl(*(const uint32_t*)(rtp + 4));
+  uint32_t seq = ntohs(*(const uint16_t*)(rtp + 2));
+
+  /* RFC4175, the extended sequence number follow the rtp header */
+  if (len >= TA_RTP_HDR_LEN + 2)
+    seq |= (uint32_t)ntohs(*(const uint16_t*)(rtp + TA_RTP_HDR_LEN)) << 16;
+
+  if (flow->ignored) return 0;
+  flow->pkts++;
+
+  if (flow->cur && rtp_tmstamp != flow->cur_rtp_tmstamp) {
+    /* no marker for current frame */
+    ta_flow_frame_end(ctx, idx);
+  }
+  if (!flow->cur) {
+    flow->cur = ta_job_get(ctx);
+    if (!flow->cur) return -ENOMEM;
+    flow->cur->flow = idx;
+    flow->cur->rtp_tmstamp = rtp_tmstamp;
+    flow->cur->prev_rtp_tmstamp = flow->has_prev_rtp_tmstamp ? flow->prev_rtp_tmstamp : 0;
+    flow->cur_rtp_tmstamp = rtp_tmstamp;
+    flow->first_seq = seq;
+  }
+
+  int ret = ta_job_add_pkt(flow->cur, time, seq - flow->first_seq);
+  if (ret < 0) return ret;
+  if (marker) ta_flow_frame_end(ctx, idx);
+  return 0;
+}
+
+static int ta_scan(struct ta_ctx* ctx) {
+  char errbuf[PCAP_ERRBUF_SIZE];
+  struct pcap_pkthdr* hdr;
+  const uint8_t* pkt;
+  pcap_t* pcap;
+  int ret = 0;
+
+  pcap = pcap_open_offline_with_tstamp_precision(ctx->pcap_file,
+                                                 PCAP_TSTAMP_PRECISION_NANO, errbuf);
+  if (!pcap) {
+    err("%s, pcap open %s fail: %s\n", __func__, ctx->pcap_file, errbuf);
+    return -EIO;
+  }
+  if (pcap_datalink(pcap) != DLT_EN10MB) {
+    err("%s, not an ethernet capture\n", __func__);
+    pcap_close(pcap);
+    return -EINVAL;
+  }
+
+  while (pcap_next_ex(pcap, &hdr, &pkt) == 1) {
+    uint32_t caplen = hdr->caplen;
+    uint32_t offset = TA_ETH_HDR_LEN;
+
+    ctx->pcap_pkts++;
+    if (caplen < TA_ETH_HDR_LEN) continue;
+    uint16_t ether_type = ntohs(*(const uint16_t*)(pkt + 12));
+    if (ether_type == 0x8100) { /* vlan */
+      if (caplen < TA_ETH_HDR_LEN + TA_VLAN_HDR_LEN) continue;
+      ether_type = ntohs(*(const uint16_t*)(pkt + 16));
+      offset += TA_VLAN_HDR_LEN;
+    }
+    if (ether_type != 0x0800) continue; /* ipv4 only */
+
+    const uint8_t* ip = pkt + offset;
+    if (caplen < offset + 20) continue;
+    uint32_t ip_hdr_len = (ip[0] & 0x0f) * 4;
+    if (ip[9] != 17) continue; /* udp only */
+    offset += ip_hdr_len;
+    if (caplen < offset + 8 + TA_RTP_HDR_LEN) continue;
+
+    const uint8_t* udp = pkt + offset;
+    const uint8_t* rtp = udp + 8;
+    if ((rtp[0] >> 6) != 2) continue; /* rtp version 2 */
+
+    uint32_t src_ip = *(const uint32_t*)(ip + 12);
+    uint32_t dst_ip = *(const uint32_t*)(ip + 16);
+    uint16_t dst_port = ntohs(*(const uint16_t*)(udp + 2));
+    int idx = ta_flow_lookup(ctx, src_ip, dst_ip, dst_port);
+    if (idx < 0) continue; /* flow table full */
+
+    uint64_t time = (uint64_t)hdr->ts.tv_sec * TA_NS_PER_S + hdr->ts.tv_usec;
+    time += ctx->time_offset_ns;
+    ctx->video_pkts++;
+    ret = ta_on_rtp(ctx, idx, time, rtp, caplen - offset - 8);
+    if (ret < 0) {
+      err("%s, rtp handle fail %d\n", __func__, ret);
+      break;
+    }
+  }
+  pcap_close(pcap);
+
+  /* drop the last frames without marker, may be partial */
+  for (int i = 0; i < ctx->flows_cnt; i++) {
+    struct ta_flow* flow = &ctx->flows[i];
+    if (flow->cur) {
+      ta_job_put(ctx, flow->cur);
+      flow->cur = NULL;
+    }
+  }
+  return ret;
+}
+
+static int ta_frame_result_cmp(const void* a, const void* b) {
+  const struct ta_frame_result* fa = a;
+  const struct ta_frame_result* fb = b;
+  if (fa->frame_idx < fb->frame_idx) return -1;
+  if (fa->frame_idx > fb->frame_idx) return 1;
+  return 0;
+}
+
+static void ta_json_hist(FILE* fp, const char* name, struct ta_hist* hist) {
+  fprintf(fp, "      \"%s\": {\"min\": %d, \"max\": %d, \"bin_width\": %d, ", name,
+          hist->min, hist->max, hist->bin_width);
+  fprintf(fp, "\"underflow\": %" PRIu64 ", \"overflow\": %" PRIu64 ", \"bins\": [",
+          hist->underflow, hist->overflow);
+  for (int i = 0; i < TA_HIST_BINS; i++)
+    fprintf(fp, "%s%" PRIu64, i ? ", " : "", hist->bins[i]);
+  fprintf(fp, "]},\n");
+}
+
+static void ta_json_flow(struct ta_ctx* ctx, FILE* fp, int idx,
+                         struct ta_flow_result* result, bool last) {
+  struct ta_flow* flow = &ctx->flows[idx];
+  struct in_addr addr;
+  char src[INET_ADDRSTRLEN], dst[INET_ADDRSTRLEN];
+  struct st20_rx_tp_pass pass;
+  enum st_rx_tp_compliant verdict = ST_RX_TP_COMPLIANT_NARROW;
+
+  addr.s_addr = flow->src_ip;
+  inet_ntop(AF_INET, &addr, src, sizeof(src));
+  addr.s_addr = flow->dst_ip;
+  inet_ntop(AF_INET, &addr, dst, sizeof(dst));
+  if (result->compliant[ST_RX_TP_COMPLIANT_WIDE]) verdict = ST_RX_TP_COMPLIANT_WIDE;
+  if (result->compliant[ST_RX_TP_COMPLIANT_FAILED] || !result->frames)
+    verdict = ST_RX_TP_COMPLIANT_FAILED;
+
+  fprintf(fp, "    {\n");
+  fprintf(fp, "      \"src_ip\": \"%s\", \"dst_ip\": \"%s\", \"dst_port\": %u,\n", src,
+          dst, flow->dst_port);
+  fprintf(fp, "      \"fps\": \"%s\", \"height\": %u, \"interlaced\": %s,\n",
+          ta_fps_name(flow->ops.fps), flow->ops.height,
+          flow->ops.interlaced ? "true" : "false");
+  fprintf(fp, "      \"pkts_per_frame\": %u, \"pkts\": %" PRIu64 ",\n",
+          flow->ops.pkts_per_frame, flow->pkts);
+  fprintf(fp,
+          "      \"frames\": %" PRIu64 ", \"narrow\": %" PRIu64 ", \"wide\": %" PRIu64
+          ", \"failed\": %" PRIu64 ", \"verdict\": \"%s\",\n",
+          result->frames, result->compliant[ST_RX_TP_COMPLIANT_NARROW],
+          result->compliant[ST_RX_TP_COMPLIANT_WIDE],
+          result->compliant[ST_RX_TP_COMPLIANT_FAILED], ta_compliant_name(verdict));
+
+  st20_tp_parser_handle parser = st20_tp_parser_create(&flow->ops);
+  if (parser) {
+    st20_tp_parser_pass(parser, &pass);
+    st20_tp_parser_free(parser);
+    fprintf(fp,
+            "      \"pass\": {\"cinst_max_narrow\": %d, \"cinst_max_wide\": %d, "
+            "\"vrx_max_narrow\": %d, \"vrx_max_wide\": %d, \"tr_offset\": %d, "
+            "\"latency_max\": %d, \"rtp_offset_max\": %d},\n",
+            pass.cinst_max_narrow, pass.cinst_max_wide, pass.vrx_max_narrow,
+            pass.vrx_max_wide, pass.tr_offset, pass.latency_max, pass.rtp_offset_max);
+  }
+
+  ta_json_hist(fp, "cinst_max", &result->cinst_max);
+  ta_json_hist(fp, "vrx_max", &result->vrx_max);
+  ta_json_hist(fp, "fpt_ns", &result->fpt);
+  ta_json_hist(fp, "latency_ns", &result->latency);
+
+  fprintf(fp, "      \"frame_results\": [");
+  if (result->frame_results_cnt)
+    qsort(result->frame_results, result->frame_results_cnt,
+          sizeof(*result->frame_results), ta_frame_result_cmp);
+  for (uint64_t i = 0; i < result->frame_results_cnt; i++) {
+    struct ta_frame_result* frame = &result->frame_results[i];
+    fprintf(fp,
+            "%s\n        {\"idx\": %" PRIu64
+            ", \"rtp_timestamp\": %u, \"verdict\": \"%s\", "
+            "\"cinst_max\": %d, \"vrx_max\": %d, \"fpt\": %d, \"latency\": %d",
+            i ? "," : "", frame->frame_idx, frame->rtp_tmstamp,
+            ta_compliant_name(frame->compliant), frame->cinst_max, frame->vrx_max,
+            frame->fpt, frame->latency);
+    if (frame->failed_cause[0]) fprintf(fp, ", \"cause\": \"%s\"", frame->failed_cause);
+    fprintf(fp, "}");
+  }
+  fprintf(fp, "%s]\n", result->frame_results_cnt ? "\n      " : "");
+  fprintf(fp, "    }%s\n", last ? "" : ",");
+}
+
+static int ta_report(struct ta_ctx* ctx) {
+  FILE* fp;
+  struct ta_flow_result* result;
+  int streams = 0, reported = 0;
+
+  fp = fopen(ctx->out_file, "w");
+  if (!fp) {
+    err("%s, open %s fail\n", __func__, ctx->out_file);
+    return -EIO;
+  }
+
+  for (int i = 0; i < ctx->flows_cnt; i++) {
+    if (ctx->flows[i].ops_ready) streams++;
+  }
+
+  fprintf(fp, "{\n");
+  fprintf(fp, "  \"file\": \"%s\",\n", ctx->pcap_file);
+  fprintf(fp, "  \"pkts\": %" PRIu64 ", \"rtp_pkts\": %" PRIu64 ",\n", ctx->pcap_pkts,
+          ctx->video_pkts);
+  fprintf(fp, "  \"streams\": [\n");
+  for (int i = 0; i < ctx->flows_cnt; i++) {
+    if (!ctx->flows[i].ops_ready) continue;
+
+    result = malloc(sizeof(*result));
+    if (!result) {
+      err("%s, result malloc fail\n", __func__);
+      break;
+    }
+    ta_flow_result_init(result);
+    /* merge the results of all workers */
+    for (int t = 0; t < ctx->threads; t++) {
+      struct ta_flow_result* w_result = &ctx->workers[t].results[i];
+
+      result->frames += w_result->frames;
+      for (int c = 0; c < ST_RX_TP_COMPLIANT_MAX; c++)
+        result->compliant[c] += w_result->compliant[c];
+      ta_hist_merge(&result->cinst_max, &w_result->cinst_max);
+      ta_hist_merge(&result->vrx_max, &w_result->vrx_max);
+      ta_hist_merge(&result->fpt, &w_result->fpt);
+      ta_hist_merge(&result->latency, &w_result->latency);
+      for (uint64_t f = 0; f < w_result->frame_results_cnt; f++)
+        ta_flow_result_add_frame(result, &w_result->frame_results[f]);
+    }
+
+    reported++;
+    ta_json_flow(ctx, fp, i, result, reported == streams);
+    free(result->frame_results);
+    free(result);
+  }
+  fprintf(fp, "  ]\n");
+  fprintf(fp, "}\n");
+
+  fclose(fp);
+  info("%s, %d streams reported to %s\n", __func__, streams, ctx->out_file);
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  struct ta_ctx* ctx;
+  int ret;
+
+  ctx = calloc(1, sizeof(*ctx));
+  if (!ctx) {
+    err("%s, ctx malloc fail\n", __func__);
+    return -ENOMEM;
+  }
+  ctx->threads = 4;
+  ctx->fps = ST_FPS_MAX;
+  ctx->height = 1080;
+  ctx->out_file = "tp_report.json";
+  ret = ta_parse_args(ctx, argc, argv);
+  if (ret < 0) {
+    free(ctx);
+    return ret;
+  }
+
+  pthread_mutex_init(&ctx->lock, NULL);
+  pthread_cond_init(&ctx->cond_job, NULL);
+  pthread_cond_init(&ctx->cond_free, NULL);
+  /* one more for each flow in building by the scanner */
+  ctx->jobs_max = ctx->threads * TA_JOBS_PER_THREAD + TA_MAX_FLOWS;
+
+  for (int i = 0; i < ctx->threads; i++) {
+    struct ta_worker* worker = &ctx->workers[i];
+
+    worker->idx = i;
+    worker->ctx = ctx;
+    for (int f = 0; f < TA_MAX_FLOWS; f++) ta_flow_result_init(&worker->results[f]);
+    ret = pthread_create(&worker->thread, NULL, ta_worker_thread, worker);
+    if (ret) {
+      err("%s(%d), thread create fail %d\n", __func__, i, ret);
+      ctx->threads = i;
+      ret = -EIO;
+      break;
+    }
+  }
+
+  if (ret >= 0) ret = ta_scan(ctx);
+
+  pthread_mutex_lock(&ctx->lock);
+  ctx->scan_done = true;
+  pthread_cond_broadcast(&ctx->cond_job);
+  pthread_mutex_unlock(&ctx->lock);
+  for (int i = 0; i < ctx->threads; i++) pthread_join(ctx->workers[i].thread, NULL);
+
+  if (ret >= 0) {
+    info("%s, %" PRIu64 " pkts, %" PRIu64 " rtp pkts, %d flows\n", __func__,
+         ctx->pcap_pkts, ctx->video_pkts, ctx->flows_cnt);
+    ret = ta_report(ctx);
+  }
+
+  for (int i = 0; i < ctx->threads; i++) {
+    struct ta_worker* worker = &ctx->workers[i];
+    for (int f = 0; f < TA_MAX_FLOWS; f++) {
+      if (worker->parsers[f]) st20_tp_parser_free(worker->parsers[f]);
+      free(worker->results[f].frame_results);
+    }
+  }
+  while (ctx->free_jobs) {
+    struct ta_job* job = ctx->free_jobs;
+    ctx->free_jobs = job->next;
+    free(job->pkts);
+    free(job);
+  }
+  pthread_mutex_destroy(&ctx->lock);
+  pthread_cond_destroy(&ctx->cond_job);
+  pthread_cond_destroy(&ctx->cond_free);
+  free(ctx);
+  return ret;
+}
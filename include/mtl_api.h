@@ -245,6 +245,16 @@ enum mtl_pmd_type {
   MTL_PMD_DPDK_AF_XDP = 19,
   /** experimental, DPDK PMD send and receive raw packets through the kernel */
   MTL_PMD_DPDK_AF_PACKET = 20,
+  /**
+   * experimental, DPDK memif PMD, a shared memory virtual port without any NIC, for
+   * loopback benchmarks and CI between two ports of one process or two processes.
+   */
+  MTL_PMD_DPDK_MEMIF = 21,
+  /**
+   * experimental, replay a pcap/pcapng capture file into the RX sessions without NIC,
+   * RX only. See mtl_pcap_replay_mode for the timing.
+   */
+  MTL_PMD_PCAP_REPLAY = 22,
   /** max value of this enum */
   MTL_PMD_TYPE_MAX,
 };
@@ -495,6 +505,12 @@ enum mtl_init_flag {
    * correctly; a session whose every port is down will still fail to create.
    */
   MTL_FLAG_ALLOW_DOWN_PORTS = (MTL_BIT64(48)),
+  /**
+   * Software emulated launch time for ST21_TX_PACING_WAY_TSN on the kernel socket and
+   * native AF_XDP backends, the pkt is held until the target PTP time instead of
+   * passing the time to the etf qdisc or the xdp tx metadata. For testing only.
+   */
+  MTL_FLAG_TX_TXTIME_EMULATE = (MTL_BIT64(49)),
 
   /** Debug option to enable dropping some percentage of packets for
    *  testing redundant video streams only works for video, needs the
@@ -527,6 +543,24 @@ enum mtl_port_init_flag {
    *   Any port still down after this window is silently skipped.
    */
   MTL_PORT_FLAG_ALLOW_DOWN_INITIALIZATION = (MTL_BIT64(1)),
+  /** MTL_PMD_PCAP_REPLAY only, restart from the first packet when reach the file end */
+  MTL_PORT_FLAG_PCAP_REPLAY_LOOP = (MTL_BIT64(2)),
+};
+
+/**
+ * The timing mode of MTL_PMD_PCAP_REPLAY. For all modes, the rx timestamp of each
+ * packet is synthesized from the capture timestamp, so the timing parser results
+ * reflect the original sender.
+ */
+enum mtl_pcap_replay_mode {
+  /** replay with the original inter packet timing of the capture */
+  MTL_PCAP_REPLAY_ORIGINAL = 0,
+  /** replay with the original timing scaled by pcap_replay_speed */
+  MTL_PCAP_REPLAY_SCALED,
+  /** replay as fast as possible, for the rx stack throughput benchmark */
+  MTL_PCAP_REPLAY_AFAP,
+  /** max value of this enum */
+  MTL_PCAP_REPLAY_MAX,
 };
 
 struct mtl_ptp_sync_notify_meta {
@@ -547,6 +581,13 @@ struct mtl_port_init_params {
    * the detail.
    */
   int socket_id;
+  /** Optional for MTL_PMD_PCAP_REPLAY. The timing mode, default original timing */
+  enum mtl_pcap_replay_mode pcap_replay_mode;
+  /**
+   * Optional for MTL_PCAP_REPLAY_SCALED. The speed factor to the original timing,
+   * 2.0 means replay twice faster. Default 1.0.
+   */
+  double pcap_replay_speed;
 };
 
 /**
@@ -562,6 +603,9 @@ struct mtl_init_params {
    * MTL_PMD_KERNEL_SOCKET, use kernel + ifname, ex: kernel:enp175s0f0.
    * MTL_PMD_DPDK_AF_XDP, use dpdk_af_xdp + ifname, ex: dpdk_af_xdp:enp175s0f0.
    * MTL_PMD_DPDK_AF_PACKET, use dpdk_af_packet + ifname, ex: dpdk_af_packet:enp175s0f0.
+   * MTL_PMD_DPDK_MEMIF, use dpdk_memif + net_memif devargs,
+   * ex: dpdk_memif:role=server,id=0 and dpdk_memif:role=client,id=0.
+   * MTL_PMD_PCAP_REPLAY, use pcap_replay + file path, ex: pcap_replay:/tmp/cap.pcapng.
    */
   char port[MTL_PORT_MAX][MTL_PORT_MAX_LEN];
 
@@ -728,6 +772,22 @@ struct mtl_init_params {
    * is used. */
   uint32_t main_lcore;
 
+  /**
+   * Optional. The number of worker threads for the shared converter pool on each numa,
+   * used by the st20p internal converter with convert_parallel. Leave to zero to use
+   * the default 4. The threads are created only when a session uses the pool.
+   */
+  uint16_t convert_threads_per_numa;
+
+  /**
+   * Optional. The file to cache the simd level benchmark of the internal converter,
+   * used by ST20P_TX_FLAG_CONVERT_AUTO_SELECT and ST20P_RX_FLAG_CONVERT_AUTO_SELECT.
+   * The entries are keyed by the cpu model. The file is created with 0600 and must be a
+   * regular file of the process user which is not writable by others, a symlink is
+   * refused. Leave to NULL to keep the results in memory only.
+   */
+  const char* convert_select_cache;
+
   /**
    * deprecated for MTL_TRANSPORT_ST2110.
    * max tx sessions(st20, st22, st30, st40) requested the lib to support,
@@ -263,6 +263,14 @@ extern "C" {
  * Force the numa of the created session, both CPU and memory.
  */
 #define ST22_RX_FLAG_FORCE_NUMA (MTL_BIT32(5))
+/**
+ * Flag bit in flags of struct st22_rx_ops.
+ * Only for ST22_TYPE_FRAME_LEVEL.
+ * If set, lib will not reassemble the codestream into the framebuffer, the packets
+ * are kept and passed as a list of segments by segs of st22_rx_frame_meta. The
+ * packets are released when the frame is put back by st22_rx_put_framebuff.
+ */
+#define ST22_RX_FLAG_CODESTREAM_SG (MTL_BIT32(6))
 
 /**
  * Flag bit in flags of struct st22_rx_ops.
@@ -288,6 +296,10 @@ typedef struct st_rx_video_session_handle_impl* st20_rx_handle;
  * Handle to rx st2110-22(compressed video) session
  */
 typedef struct st22_rx_video_session_handle_impl* st22_rx_handle;
+/**
+ * Handle to the offline st2110-21 timing parser
+ */
+typedef struct st20_tp_parser_impl* st20_tp_parser_handle;
 
 /**
  * Pacing type of st2110-20(video) sender
@@ -525,6 +537,20 @@ struct st20_rx_tp_pass {
   int32_t rtp_ts_delta_min;
 };
 
+/**
+ * The st2110-20 stream format for the offline timing parser.
+ */
+struct st20_tp_parser_ops {
+  /** Stream fps */
+  enum st_fps fps;
+  /** Stream resolution height */
+  uint32_t height;
+  /** interlace or not, false: non-interlaced: true: interlaced */
+  bool interlaced;
+  /** The packets number of one frame(field for interlaced) */
+  uint32_t pkts_per_frame;
+};
+
 /**
  * Frame meta data of st2110-20(video) rx streaming
  */
@@ -638,6 +664,32 @@ struct st20_rx_uframe_pg_meta {
   uint64_t timestamp;
 };
 
+/**
+ * The pixel group meta data for the uframe_pg_callback of st20 tx session.
+ */
+struct st20_tx_uframe_pg_meta {
+  /** Frame resolution width */
+  uint32_t width;
+  /** Frame resolution height */
+  uint32_t height;
+  /** Frame resolution fps */
+  enum st_fps fps;
+  /** Frame resolution format */
+  enum st20_fmt fmt;
+  /** The total size for raw frame */
+  size_t frame_total_size;
+  /** Point to the pixel groups area of the packet payload, lib will send it */
+  void* payload;
+  /** Number of octets of data should be filled to the payload */
+  uint16_t row_length;
+  /** Scan line number */
+  uint16_t row_number;
+  /** Offset of the first pixel of the payload data within the scan line */
+  uint16_t row_offset;
+  /** How many pixel groups in current meta */
+  uint32_t pg_cnt;
+};
+
 /**
  * Frame meta data of st2110-22(video) tx streaming
  */
@@ -665,6 +717,16 @@ struct st22_tx_frame_meta {
 /**
  * Frame meta data of st2110-22(video) rx streaming
  */
+/**
+ * A segment of the st2110-22 codestream, see ST22_RX_FLAG_CODESTREAM_SG.
+ */
+struct st22_rx_codestream_seg {
+  /** Address of the codestream bytes, NULL for a lost packet */
+  void* addr;
+  /** Length of the codestream bytes, zero for a lost packet */
+  uint32_t len;
+};
+
 struct st22_rx_frame_meta {
   /** Second field type indicate, for interlaced mode */
   bool second_field;
@@ -684,6 +746,13 @@ struct st22_rx_frame_meta {
    * of received packets can be assessed by comparing 'pkts_recv[s_port]' with
    * 'pkts_total,' which serves as an indicator of signal quality.  */
   uint32_t pkts_recv[MTL_SESSION_PORT_MAX];
+  /**
+   * Only for ST22_RX_FLAG_CODESTREAM_SG, the codestream segments in packet order,
+   * valid until the frame is put back by st22_rx_put_framebuff.
+   */
+  struct st22_rx_codestream_seg* segs;
+  /** Only for ST22_RX_FLAG_CODESTREAM_SG, the number of entries in segs */
+  uint32_t segs_nb;
 };
 
 /**
@@ -1234,6 +1303,21 @@ struct st20_tx_ops {
    */
   int (*query_frame_lines_ready)(void* priv, uint16_t frame_idx,
                                  struct st20_tx_slice_meta* meta);
+  /**
+   * Optional for ST20_TYPE_FRAME_LEVEL/ST20_TYPE_SLICE_LEVEL.
+   * User frame callback when lib build the payload of one packet. If set, lib never
+   * read the pixel groups from the transport frame(no framebuffer allocated), the
+   * callback should fill the pixel groups of the frame_idx to the meta->payload, ex:
+   * convert one line segment from the user format to the transport format directly.
+   * Lib will not use chain mbuf for this session since the payload is written in place.
+   * return:
+   *   - 0: if app fill the pixel group successfully.
+   *   < 0: the error code if app can't handle.
+   * And only non-block method can be used in this callback as it run from lcore tasklet
+   * routine.
+   */
+  int (*uframe_pg_callback)(void* priv, uint16_t frame_idx,
+                            struct st20_tx_uframe_pg_meta* meta);
 
   /** Mandatory for ST20_TYPE_RTP_LEVEL. rtp ring queue size, must be power of 2 */
   uint32_t rtp_ring_size;
@@ -1720,6 +1804,7 @@ struct st20_tx_user_stats {
   uint64_t stat_lines_not_ready;
   uint64_t stat_vsync_mismatch;
   uint64_t stat_pkts_chain_realloc_fail;
+  uint64_t stat_pkts_uframe_fail;
   uint64_t stat_user_meta_cnt;
   uint64_t stat_user_meta_pkt_cnt;
   uint64_t stat_interlace_first_field;
@@ -2308,6 +2393,93 @@ bool st20_rx_dma_enabled(st20_rx_handle handle);
  */
 int st20_rx_timing_parser_critical(st20_rx_handle handle, struct st20_rx_tp_pass* pass);
 
+/**
+ * Create one offline st2110-21 timing parser, which runs the same timing parser of the
+ * rx st2110-20(video) session on packets from other sources, ex: a pcap file.
+ * It doesn't need a mtl instance, and the handle is not thread safe, use one handle for
+ * each stream in each thread.
+ *
+ * @param ops
+ *   The pointer to the stream format.
+ * @return
+ *   - NULL on error.
+ *   - Otherwise, the handle to the timing parser.
+ */
+st20_tp_parser_handle st20_tp_parser_create(struct st20_tp_parser_ops* ops);
+
+/**
+ * Free the offline st2110-21 timing parser.
+ *
+ * @param handle
+ *   The handle to the timing parser.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st20_tp_parser_free(st20_tp_parser_handle handle);
+
+/**
+ * Get the pass critical of the offline st2110-21 timing parser.
+ *
+ * @param handle
+ *   The handle to the timing parser.
+ * @param pass
+ *   the pointer to save the timing parser pass critical.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st20_tp_parser_pass(st20_tp_parser_handle handle, struct st20_rx_tp_pass* pass);
+
+/**
+ * Start a new frame of the offline st2110-21 timing parser, optional if the frames of
+ * one stream are fed in order to the same handle. It's used when the frames of one stream
+ * are parsed by different handles in parallel.
+ *
+ * @param handle
+ *   The handle to the timing parser.
+ * @param prev_rtp_tmstamp
+ *   The rtp timestamp of the previous frame for the rtp_ts_delta check, 0 if unknown.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st20_tp_parser_frame_start(st20_tp_parser_handle handle, uint32_t prev_rtp_tmstamp);
+
+/**
+ * Feed one packet of current frame to the offline st2110-21 timing parser, the packets
+ * of one frame should be fed in the arrival order.
+ *
+ * @param handle
+ *   The handle to the timing parser.
+ * @param rtp_tmstamp
+ *   The rtp timestamp of the packet.
+ * @param pkt_time
+ *   The arrival time of the packet, TAI in ns.
+ * @param pkt_idx
+ *   The packet index in current frame, start from 0.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st20_tp_parser_on_packet(st20_tp_parser_handle handle, uint32_t rtp_tmstamp,
+                             uint64_t pkt_time, uint32_t pkt_idx);
+
+/**
+ * Finish current frame of the offline st2110-21 timing parser, the result is saved to
+ * meta and the parser is ready for the next frame.
+ *
+ * @param handle
+ *   The handle to the timing parser.
+ * @param meta
+ *   the pointer to save the timing parser result of current frame.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code, no packet for current frame.
+ */
+int st20_tp_parser_frame_result(st20_tp_parser_handle handle,
+                                struct st20_rx_tp_meta* meta);
+
 /**
  * Retrieve the general statistics(I/O) for one rx st2110-20(video) session.
  *
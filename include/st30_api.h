@@ -26,6 +26,10 @@ typedef struct st_tx_audio_session_handle_impl* st30_tx_handle;
  * Handle to rx st2110-30(audio) session
  */
 typedef struct st_rx_audio_session_handle_impl* st30_rx_handle;
+/**
+ * Handle to rx st2110-30(audio) aggregation group, several flows into one buffer
+ */
+typedef struct st_rx_audio_agg_impl* st30_rx_agg_handle;
 
 /**
  * Flag bit in flags of struct st30_tx_ops.
@@ -69,6 +73,22 @@ typedef struct st_rx_audio_session_handle_impl* st30_rx_handle;
 #define ST30_TX_FLAG_DEDICATE_QUEUE (MTL_BIT32(7))
 /** Force the numa of the created session, both CPU and memory */
 #define ST30_TX_FLAG_FORCE_NUMA (MTL_BIT32(8))
+/**
+ * Flag bit in flags of struct st30_tx_ops, for ST30_TYPE_FRAME_LEVEL.
+ * Build the session in one batch with the other sessions of the same profile(ptime,
+ * sampling, packet size and ports) on the same scheduler: one shared pacing epoch, one
+ * bulk mbuf alloc and one burst per port for all the sessions of the group.
+ * Ignored if the session need RL pacing, a dedicated queue, user pacing or user
+ * timestamp, the session is built alone then.
+ */
+#define ST30_TX_FLAG_GROUP_BUILD (MTL_BIT32(9))
+/**
+ * Flag bit in flags of struct st30_tx_ops.
+ * Allow the packets up to a jumbo frame of ST30_JUMBO_MTU bytes for the high channel
+ * count or the long ptime. Only for the MTL_PMD_KERNEL_SOCKET ports, the interfaces and
+ * the network path should be set to this mtu by the user. No UDP GSO for the session.
+ */
+#define ST30_TX_FLAG_JUMBO_FRAME (MTL_BIT32(10))
 
 /**
  * Flag bit in flags of struct st30_rx_ops, for non MTL_PMD_DPDK_USER.
@@ -88,6 +108,18 @@ typedef struct st_rx_audio_session_handle_impl* st30_rx_handle;
  * If enabled, simulate random packet loss, test usage only.
  */
 #define ST30_RX_FLAG_SIMULATE_PKT_LOSS (MTL_BIT32(3))
+/**
+ * Flag bit in flags of struct st30_rx_ops, for ST30_TYPE_FRAME_LEVEL.
+ * If enabled, the peak, true peak, rms and loudness of each channel are metered on the
+ * received packets, read them by st30_rx_get_meter. Not for the aggregation group.
+ */
+#define ST30_RX_FLAG_ENABLE_METER (MTL_BIT32(4))
+/**
+ * Flag bit in flags of struct st30_rx_ops.
+ * Accept the packets up to a jumbo frame of ST30_JUMBO_MTU bytes, see
+ * ST30_TX_FLAG_JUMBO_FRAME. Only for the MTL_PMD_KERNEL_SOCKET ports.
+ */
+#define ST30_RX_FLAG_JUMBO_FRAME (MTL_BIT32(5))
 /**
  * Flag bit in flags of struct st30_rx_ops.
  * Enable the timing analyze in the stat dump
@@ -102,6 +134,12 @@ typedef struct st_rx_audio_session_handle_impl* st30_rx_handle;
 /** default time in the fifo between packet builder and pacing */
 #define ST30_TX_FIFO_DEFAULT_TIME_MS (10)
 
+/** The mtu of the ST30_TX_FLAG_JUMBO_FRAME and ST30_RX_FLAG_JUMBO_FRAME sessions */
+#define ST30_JUMBO_MTU (9000)
+
+/** The max number of the rx flows in one st2110-30(audio) aggregation group */
+#define ST30_RX_AGG_FLOWS_MAX (64)
+
 /**
  * Payload format of st2110-30/31(audio) streaming
  * Note: PCM format is interpreted as big endian.
@@ -299,6 +337,38 @@ struct st30_rx_frame_meta {
   enum st_frame_status status;
 };
 
+/**
+ * Frame meta data of the rx st2110-30(audio) aggregation group, one frame holds the
+ * samples of all the flows for the same time.
+ */
+struct st30_rx_agg_frame_meta {
+  /** Frame format */
+  enum st30_fmt fmt;
+  /** Frame sampling type */
+  enum st30_sampling sampling;
+  /** Frame channel number, all the channels of the group */
+  uint16_t channel;
+  /** Frame timestamp format */
+  enum st10_timestamp_fmt tfmt;
+  /** Frame timestamp value */
+  uint64_t timestamp;
+  /** TAI timestamp measured right after the first RTP packet for this frame received */
+  uint64_t timestamp_first_pkt;
+  /** Timestamp value in the rtp header of the first sample */
+  uint32_t rtp_timestamp;
+  /** received data size for current frame */
+  size_t frame_recv_size;
+  /**
+   * Frame status, complete or corrupted if any flow missed packets. The samples of the
+   * missed packets are silence.
+   */
+  enum st_frame_status status;
+  /** The number of the flows attached to the group */
+  uint16_t flow_cnt;
+  /** Bit i is set if the flow i delivered all the packets of this frame */
+  uint64_t flows_complete;
+};
+
 /**
  * st30 rx timing parser meta for every 200ms
  *
@@ -549,6 +619,57 @@ struct st30_rx_ops {
    * use st30_get_sample_num to get the number from different ptime and sampling rate.
    */
   uint16_t sample_num __mtl_deprecated_msg("Not use anymore, plan to remove");
+
+  /**
+   * Optional for ST30_TYPE_FRAME_LEVEL. The aggregation group by st30_rx_agg_create to
+   * join, the packets are written into the interleaved frames of the group from the
+   * channel agg_channel_offset, and the group notifies the frames. framebuff_cnt,
+   * framebuff_size and notify_frame_ready of this session are not used then.
+   */
+  st30_rx_agg_handle agg;
+  /** Optional. The first channel of this flow in the frames of the aggregation group */
+  uint16_t agg_channel_offset;
+};
+
+/**
+ * The structure describing how to create a rx st2110-30(audio) aggregation group.
+ * The rx sessions join the group with agg of struct st30_rx_ops, each flow writes its
+ * packets straight into the channels of the group frame at its agg_channel_offset and
+ * the frames are aligned by the RTP timestamp, so all the flows have to be sent from the
+ * same PTP locked media clock with the same fmt, sampling and ptime.
+ */
+struct st30_rx_agg_ops {
+  /** Optional. name */
+  const char* name;
+  /** Optional. private data to the callback function */
+  void* priv;
+  /** Mandatory. PCM format of all the flows */
+  enum st30_fmt fmt;
+  /** Mandatory. The channel number of the group frame, the sum of the flows or more */
+  uint16_t channel;
+  /** Mandatory. Sampling rate of all the flows */
+  enum st30_sampling sampling;
+  /** Mandatory. Packet time of all the flows */
+  enum st30_ptime ptime;
+  /** Mandatory. The frame buffer count of the group */
+  uint16_t framebuff_cnt;
+  /**
+   * Mandatory. Size for each frame buffer, should be multiple of the packet size of
+   * the group channel number, st30_get_packet_size(fmt, ptime, sampling, channel).
+   * Up to 64 packets for one frame.
+   */
+  uint32_t framebuff_size;
+  /**
+   * Mandatory. callback when one frame of all the flows is ready, or when it is closed
+   * by the packets of a later frame with some packets missed.
+   * return:
+   *   - 0: if app consume the frame successful. App should call
+   * st30_rx_agg_put_framebuff to return the frame when it finish the handling
+   *   < 0: the error code if app can't handle, lib will free the frame then.
+   * And only non-block method can be used in this callback as it run from lcore tasklet
+   * routine.
+   */
+  int (*notify_frame_ready)(void* priv, void* frame, struct st30_rx_agg_frame_meta* meta);
 };
 
 /**
@@ -565,6 +686,24 @@ struct st30_tx_user_stats {
   uint64_t stat_hit_backup_cp;
 };
 
+/** The level reported by the meter for the silence or below */
+#define ST30_METER_LEVEL_MIN (-200.0f)
+
+/**
+ * The levels of one channel by the meter of ST30_RX_FLAG_ENABLE_METER, over the last
+ * complete 100ms block of the samples. Each channel is metered as one mono program.
+ */
+struct st30_meter_level {
+  /** The sample peak, dBFS */
+  float peak;
+  /** The true peak of the 4x oversampled signal per ITU-R BS.1770, dBTP */
+  float true_peak;
+  /** The rms, dBFS, -3.01 for the full scale sine */
+  float rms;
+  /** The momentary loudness of the last 400ms, K-weighted per ITU-R BS.1770, LUFS */
+  float loudness;
+};
+
 /**
  * A structure used to retrieve general statistics(I/O) for a st30 rx session.
  */
@@ -635,6 +774,24 @@ int st30_rx_get_session_stats(st30_rx_handle handle, struct st30_rx_user_stats*
  */
 int st30_rx_reset_session_stats(st30_rx_handle handle);
 
+/**
+ * Retrieve the levels of the ST30_RX_FLAG_ENABLE_METER meter for one rx
+ * st2110-30(audio) session, ST30_METER_LEVEL_MIN before the first 100ms block.
+ *
+ * @note Thread-safe and lock free, the levels of all the channels are from one block.
+ * @param handle
+ *   The handle to the rx st2110-30(audio) session.
+ * @param levels
+ *   The array of at least channel_cnt levels, one for each channel from 0.
+ * @param channel_cnt
+ *   The number of the channels to read, at most the channel of the session.
+ * @return
+ *   - >=0 the number of the channels read.
+ *   - <0: Error code, -EINVAL if the meter is not enabled.
+ */
+int st30_rx_get_meter(st30_rx_handle handle, struct st30_meter_level* levels,
+                      uint16_t channel_cnt);
+
 /**
  * Create one tx st2110-30(audio) session.
  *
@@ -898,6 +1055,45 @@ void st30_rx_put_mbuf(st30_rx_handle handle, void* mbuf);
  */
 int st30_rx_get_queue_meta(st30_rx_handle handle, struct st_queue_meta* meta);
 
+/**
+ * Create one rx st2110-30(audio) aggregation group, the rx sessions join it with agg
+ * of struct st30_rx_ops.
+ *
+ * @param mt
+ *   The handle to the media transport device context.
+ * @param ops
+ *   The pointer to the structure describing how to create the group.
+ * @return
+ *   - NULL on error.
+ *   - Otherwise, the handle to the rx st2110-30(audio) aggregation group.
+ */
+st30_rx_agg_handle st30_rx_agg_create(mtl_handle mt, struct st30_rx_agg_ops* ops);
+
+/**
+ * Free the rx st2110-30(audio) aggregation group, all the rx sessions of the group have
+ * to be freed before.
+ *
+ * @param handle
+ *   The handle to the rx st2110-30(audio) aggregation group.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st30_rx_agg_free(st30_rx_agg_handle handle);
+
+/**
+ * Put back the frame get from notify_frame_ready of the aggregation group.
+ *
+ * @param handle
+ *   The handle to the rx st2110-30(audio) aggregation group.
+ * @param frame
+ *   The framebuffer pointer.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st30_rx_agg_put_framebuff(st30_rx_agg_handle handle, void* frame);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -41,6 +41,13 @@ enum st30p_tx_flag {
    * lib will wait until timestamp is reached for each frame.
    */
   ST30P_TX_FLAG_USER_PACING = (MTL_BIT32(3)),
+  /**
+   * The app writes any number of samples with st30p_tx_write_samples instead of the
+   * frames, the packets are sliced from a sample ring of framebuff_cnt *
+   * framebuff_size bytes. The first packet is sent once framebuff_size bytes are
+   * written, then at each packet time, silence if the app is behind.
+   */
+  ST30P_TX_FLAG_STREAM = (MTL_BIT32(4)),
   /**
    * Flag bit in flags of struct st30p_tx_ops.
    * If use dedicated queue for TX.
@@ -48,6 +55,11 @@ enum st30p_tx_flag {
   ST30P_TX_FLAG_DEDICATE_QUEUE = (MTL_BIT32(7)),
   /** Force the numa of the created session, both CPU and memory */
   ST30P_TX_FLAG_FORCE_NUMA = (MTL_BIT32(8)),
+  /**
+   * Flag bit in flags of struct st30p_tx_ops.
+   * Allow the jumbo frame packets, see ST30_TX_FLAG_JUMBO_FRAME.
+   */
+  ST30P_TX_FLAG_JUMBO_FRAME = (MTL_BIT32(9)),
 
   /** Enable the st30p_tx_get_frame block behavior to wait until a frame becomes
    available or timeout(default: 1s, use st30p_tx_set_block_timeout to customize)*/
@@ -61,13 +73,32 @@ enum st30p_tx_flag {
   ST30P_TX_FLAG_DROP_WHEN_LATE = (MTL_BIT32(16)),
 };
 
+/**
+ * The sample format of the st30p frames exchanged with the application, the lib converts
+ * between it and the session payload format (the wire format).
+ */
+enum st30p_sample_fmt {
+  /** The session payload format, big endian PCM or AM824 as on the wire */
+  ST30P_SAMPLE_FMT_WIRE = 0,
+  /** Native endian signed 32 bit, the wire sample in the msb bits */
+  ST30P_SAMPLE_FMT_S32,
+  /** Native endian float, the full scale is [-1.0, 1.0) */
+  ST30P_SAMPLE_FMT_F32,
+  /** max value of this enum */
+  ST30P_SAMPLE_FMT_MAX,
+};
+
 /** The structure info for st30 frame meta. */
 struct st30_frame {
   /** frame buffer address */
   void* addr;
-  /** frame format */
+  /** frame format, the wire format of the session */
   enum st30_fmt fmt;
-  /** channels number */
+  /** the sample format of addr, see app_fmt in the ops */
+  enum st30p_sample_fmt sample_fmt;
+  /** channel major planes of samples(one plane for each channel), not interleaved */
+  bool planar;
+  /** channels number, the app_channel of ops if the sample_fmt is not wire */
   uint16_t channel;
   /** sampling rate */
   enum st30_sampling sampling;
@@ -98,6 +129,12 @@ struct st30_frame {
   /** frame status, set by lib before notify_frame_done: complete or dropped */
   enum st_frame_status status;
 
+  /**
+   * The levels of the session channels(the wire channels) for ST30P_RX_FLAG_ENABLE_METER
+   * at the time the frame is received, the last complete 100ms block. NULL if disabled.
+   */
+  struct st30_meter_level* meter;
+
   /** priv pointer for lib, do not touch this */
   void* priv;
 };
@@ -177,6 +214,23 @@ struct st30p_tx_ops {
   int32_t rl_offset_ns;
   /**  Use this socket if ST30P_TX_FLAG_FORCE_NUMA is on, default use the NIC numa */
   int socket_id;
+
+  /**
+   * Optional. The sample format of the frames from the application, the lib converts it
+   * to the fmt in st30p_tx_put_frame. Default ST30P_SAMPLE_FMT_WIRE, no conversion.
+   * The PCM formats only, AM824 carries the channel status bits so it stays wire only.
+   */
+  enum st30p_sample_fmt app_fmt;
+  /** Optional. Planar(channel major) app frames, for the app_fmt other than wire */
+  bool app_planar;
+  /** Optional. The channel number of the app frames, zero means same to channel */
+  uint16_t app_channel;
+  /**
+   * Optional. The session channel of each app channel, app channel i is sent on the
+   * session channel app_channel_map[i], the session channels not mapped are silent.
+   * NULL means app channel i on session channel i. Copied in st30p_tx_create.
+   */
+  const uint16_t* app_channel_map;
 };
 
 /**
@@ -227,7 +281,7 @@ st30p_tx_handle st30p_tx_create(mtl_handle mt, struct st30p_tx_ops* ops);
 int st30p_tx_update_destination(st30p_tx_handle handle, struct st_tx_dest_info* dst);
 /** Wake up the block wait on st30p_tx_get_frame if ST30P_TX_FLAG_BLOCK_GET is enabled.*/
 int st30p_tx_wake_block(st30p_tx_handle handle);
-/* get framebuff size */
+/* get framebuff size, the app frame size if app_fmt is not wire */
 size_t st30p_tx_frame_size(st30p_tx_handle handle);
 /* get framebuff pointer */
 void* st30p_tx_get_fb_addr(st30p_tx_handle handle, uint16_t idx);
@@ -235,6 +289,25 @@ void* st30p_tx_get_fb_addr(st30p_tx_handle handle, uint16_t idx);
  * enabled. */
 int st30p_tx_set_block_timeout(st30p_tx_handle handle, uint64_t timedwait_ns);
 
+/**
+ * Write the samples of one ST30P_TX_FLAG_STREAM session, any count each call. The
+ * samples go to the sample ring the packets are built from, so the rtp timestamp
+ * follows the samples without the frame alignment. Non-blocking and lock-free, call it
+ * from one thread only.
+ *
+ * @param handle
+ *   The handle to the tx st2110-30(pipeline) session.
+ * @param buf
+ *   The interleaved samples, samples * channel * st30_get_sample_size(fmt) bytes of the
+ *   wire format, or samples * channel of 4 bytes for the S32/F32 app_fmt.
+ * @param samples
+ *   The samples of each channel to write.
+ * @return
+ *   - >=0: The samples written, less than samples if the ring is full.
+ *   - <0: Error code.
+ */
+int st30p_tx_write_samples(st30p_tx_handle handle, const void* buf, uint32_t samples);
+
 /** Bit define for flags of struct st20p_rx_ops. */
 enum st30p_rx_flag {
   /**
@@ -251,6 +324,25 @@ enum st30p_rx_flag {
    * If enabled, simulate random packet loss, test usage only.
    */
   ST30P_RX_FLAG_SIMULATE_PKT_LOSS = (MTL_BIT32(3)),
+  /**
+   * Flag bit in flags of struct st30p_rx_ops.
+   * If enabled, the packets of all the ports are written to a playout ring by the media
+   * clock position, the app reads the samples for a PTP time by st30p_rx_playout_read
+   * instead of st30p_rx_get_frame. The wire format only.
+   */
+  ST30P_RX_FLAG_PLAYOUT = (MTL_BIT32(4)),
+  /**
+   * Flag bit in flags of struct st30p_rx_ops.
+   * If enabled, the levels of each channel are metered on the received packets, see
+   * ST30_RX_FLAG_ENABLE_METER. The levels are in the meter of each frame, or read by
+   * st30p_rx_get_meter.
+   */
+  ST30P_RX_FLAG_ENABLE_METER = (MTL_BIT32(5)),
+  /**
+   * Flag bit in flags of struct st30p_rx_ops.
+   * Accept the jumbo frame packets, see ST30_RX_FLAG_JUMBO_FRAME.
+   */
+  ST30P_RX_FLAG_JUMBO_FRAME = (MTL_BIT32(6)),
 
   /** Enable the st30p_rx_get_frame block behavior to wait until a frame becomes
    available or timeout(default: 1s, use st30p_rx_set_block_timeout to customize) */
@@ -293,6 +385,51 @@ struct st30p_rx_ops {
   int (*notify_frame_available)(void* priv);
   /**  Use this socket if ST30P_RX_FLAG_FORCE_NUMA is on, default use the NIC numa */
   int socket_id;
+
+  /**
+   * Optional. The sample format of the frames to the application, the lib converts the
+   * fmt to it in st30p_rx_get_frame. Default ST30P_SAMPLE_FMT_WIRE, no conversion.
+   * The PCM formats only, AM824 carries the channel status bits so it stays wire only.
+   */
+  enum st30p_sample_fmt app_fmt;
+  /** Optional. Planar(channel major) app frames, for the app_fmt other than wire */
+  bool app_planar;
+  /** Optional. The channel number of the app frames, zero means same to channel */
+  uint16_t app_channel;
+  /**
+   * Optional. The session channel of each app channel, app channel i gets the session
+   * channel app_channel_map[i], a session channel can feed more than one app channel.
+   * NULL means app channel i from session channel i. Copied in st30p_rx_create.
+   */
+  const uint16_t* app_channel_map;
+
+  /**
+   * Optional for ST30P_RX_FLAG_PLAYOUT. The samples of PTP time T are read at T plus
+   * this latency(us), zero means ST30P_RX_PLAYOUT_LATENCY_US_DEFAULT.
+   */
+  uint32_t playout_latency_us;
+  /**
+   * Optional for ST30P_RX_FLAG_PLAYOUT. The time(ms) kept in the playout ring, zero
+   * means ST30P_RX_PLAYOUT_BUFFER_MS_DEFAULT.
+   */
+  uint32_t playout_buffer_ms;
+};
+
+/** The default latency of ST30P_RX_FLAG_PLAYOUT, in us */
+#define ST30P_RX_PLAYOUT_LATENCY_US_DEFAULT (2000)
+/** The default time kept in the ring of ST30P_RX_FLAG_PLAYOUT, in ms */
+#define ST30P_RX_PLAYOUT_BUFFER_MS_DEFAULT (100)
+
+/** The meta data of one st30p_rx_playout_read. */
+struct st30p_rx_playout_meta {
+  /** The PTP time(ns) of the read, the current PTP time if zero is given */
+  uint64_t ptp_time;
+  /** The rtp timestamp(media clock) of the first sample read */
+  uint32_t rtp_timestamp;
+  /** The samples filled with silence as the packets are lost */
+  uint32_t concealed_samples;
+  /** The samples filled with silence as the packets are not received yet */
+  uint32_t ahead_samples;
 };
 
 /**
@@ -325,6 +462,24 @@ int st30p_rx_get_session_stats(st30p_rx_handle handle, struct st30_rx_user_stats
  */
 int st30p_rx_reset_session_stats(st30p_rx_handle handle);
 
+/**
+ * Retrieve the levels of the ST30P_RX_FLAG_ENABLE_METER meter for one rx
+ * st2110-30(pipeline) session, see st30_rx_get_meter.
+ *
+ * @note Thread-safe and lock free.
+ * @param handle
+ *   The handle to the rx st2110-30(pipeline) session.
+ * @param levels
+ *   The array of at least channel_cnt levels, one for each wire channel from 0.
+ * @param channel_cnt
+ *   The number of the channels to read, at most the channel of the session.
+ * @return
+ *   - >=0 the number of the channels read.
+ *   - <0: Error code.
+ */
+int st30p_rx_get_meter(st30p_rx_handle handle, struct st30_meter_level* levels,
+                       uint16_t channel_cnt);
+
 /**
  * Get one rx frame from the rx st2110-30 pipeline session.
  * Call st30p_rx_put_frame to return the frame to session.
@@ -344,9 +499,32 @@ int st30p_rx_wake_block(st30p_rx_handle handle);
 /** Set the block timeout time on st30p_rx_get_frame if ST30P_RX_FLAG_BLOCK_GET is
  * enabled. */
 int st30p_rx_set_block_timeout(st30p_rx_handle handle, uint64_t timedwait_ns);
-/* get framebuff size */
+/* get framebuff size, the app frame size if app_fmt is not wire */
 size_t st30p_rx_frame_size(st30p_rx_handle handle);
 
+/**
+ * Read the samples of one ST30P_RX_FLAG_PLAYOUT session, the samples played at the PTP
+ * time ptp_time, which are the samples of ptp_time - playout_latency_us at the sender.
+ * The samples of the lost or not received packets are silence. Non-blocking and
+ * lock-free, the packets of both ports go to the ring without any frame copy.
+ *
+ * @param handle
+ *   The handle to the rx st2110-30(pipeline) session.
+ * @param ptp_time
+ *   The PTP time(ns) of the first sample, zero for the current PTP time.
+ * @param buf
+ *   The buffer of samples * channel * st30_get_sample_size(fmt) bytes, the wire format.
+ * @param samples
+ *   The samples of each channel to read.
+ * @param meta
+ *   Optional. The meta data of the read.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st30p_rx_playout_read(st30p_rx_handle handle, uint64_t ptp_time, void* buf,
+                          uint32_t samples, struct st30p_rx_playout_meta* meta);
+
 /**
  * Check if a frame is late by comparing its TAI timestamp against the current
  * MTL PTP time.
@@ -365,6 +543,35 @@ static inline bool st30_frame_is_late(mtl_handle mt, struct st30_frame* frame) {
   return (int64_t)(frame->timestamp - ptp_now) < 0;
 }
 
+/**
+ * Convert one st2110-30 frame of the wire format to the app sample format with the
+ * simd level, same as the rx pipeline with app_fmt and all the channels. For the tools
+ * and the benchmarks, the pipeline keeps the plan of the conversion for the session.
+ *
+ * @param wire
+ *   The frame of the wire format, wire_size bytes of full sample rows.
+ * @param app
+ *   The app frame, wire_size / st30_get_sample_size(fmt) samples of 4 bytes.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st30p_sample_to_app_simd(enum st30_fmt fmt, uint16_t channel, const void* wire,
+                             size_t wire_size, enum st30p_sample_fmt app_fmt, bool planar,
+                             void* app, enum mtl_simd_level level);
+
+/**
+ * Convert one app frame of the app sample format to the st2110-30 wire format with the
+ * simd level, same as the tx pipeline with app_fmt and all the channels.
+ *
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st30p_sample_to_wire_simd(enum st30_fmt fmt, uint16_t channel, const void* app,
+                              enum st30p_sample_fmt app_fmt, bool planar, void* wire,
+                              size_t wire_size, enum mtl_simd_level level);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -302,6 +302,12 @@ struct st40_meta {
  */
 #define ST40_MAX_META (20)
 
+/**
+ * Max value of max_meta in the ops of st40 sessions. The udw_offset of 256 meta of
+ * 255 udw each still fits in 16 bits.
+ */
+#define ST40_MAX_META_DYNAMIC (256)
+
 /**
  * Structure for ST2110-40(ancillary) frame
  */
@@ -310,8 +316,25 @@ struct st40_frame {
   uint8_t* data;                        /**<  Handle to data buffer  */
   uint32_t data_size;                   /**<  Size of content data  */
   uint32_t meta_num;                    /**<  number of meta data  */
+  /**
+   * The meta array of meta_cap entries set by lib when max_meta of st40_tx_ops is above
+   * ST40_MAX_META, NULL for the meta of this struct. Use st40_frame_meta() to get the
+   * array of the frame.
+   */
+  struct st40_meta* meta_array;
+  uint32_t meta_cap; /**<  Capacity of meta_array  */
 };
 
+/** The meta array of the st40 frame, meta_array or the meta of the struct. */
+static inline struct st40_meta* st40_frame_meta(struct st40_frame* frame) {
+  return frame->meta_array ? frame->meta_array : frame->meta;
+}
+
+/** The capacity of the meta array of the st40 frame. */
+static inline uint32_t st40_frame_meta_cap(const struct st40_frame* frame) {
+  return frame->meta_array ? frame->meta_cap : ST40_MAX_META;
+}
+
 /**
  * Frame meta data of st2110-40(ancillary) tx streaming
  */
@@ -377,6 +400,12 @@ struct st40_tx_ops {
    * the frame buffer count requested for one st40 tx session,
    */
   uint16_t framebuff_cnt;
+  /**
+   * Optional for ST40_TYPE_FRAME_LEVEL. The max meta number of one frame, up to
+   * ST40_MAX_META_DYNAMIC, 0 for ST40_MAX_META. The frame content larger than one packet
+   * is sent in several packets with the marker on the last one, see st40_frame_meta().
+   */
+  uint16_t max_meta;
   /**
    * Mandatory for ST40_TYPE_FRAME_LEVEL. callback when lib require a new frame for
    * sending. User should provide the next available frame index to next_frame_idx. It
@@ -456,7 +485,7 @@ struct st40_rx_frame_meta {
 
   /** Number of `struct st40_meta` entries written into the meta array */
   uint32_t meta_num;
-  /** Pointer to the meta array, sized ST40_MAX_META, owned by transport */
+  /** Pointer to the meta array, sized max_meta of the ops, owned by transport */
   struct st40_meta* meta;
   /** Bytes written into the UDW buffer */
   size_t udw_buffer_fill;
@@ -527,6 +556,11 @@ struct st40_rx_ops {
    * largest expected ANC payload.
    */
   uint32_t framebuff_size;
+  /**
+   * Optional for ST40_TYPE_FRAME_LEVEL. The max meta number of one frame assembled from
+   * all the packets of the frame, up to ST40_MAX_META_DYNAMIC, 0 for ST40_MAX_META.
+   */
+  uint16_t max_meta;
   /**
    * Mandatory for ST40_TYPE_FRAME_LEVEL.  Callback when lib finishes assembling
    * one full frame.  Frame ownership is transferred to the app; the app must
@@ -822,6 +856,55 @@ uint16_t st40_get_udw(uint32_t idx, const uint8_t* data);
  */
 void st40_set_udw(uint32_t idx, uint16_t udw, uint8_t* data);
 
+/**
+ * Set n udw from 8 bit values for st2110-40(ancillary) payload, the parity bits are
+ * added. Same as st40_set_udw(idx + i, st40_add_parity_bits(udw[i]), data) for each i,
+ * with the SIMD path when the cpu has it.
+ *
+ * @param idx
+ *   Index of the first udw.
+ * @param udw
+ *   The 8 bit values, n bytes.
+ * @param n
+ *   The number of udw.
+ * @param data
+ *   The pointer to st2110-40 payload.
+ * @return
+ *   - The sum of the 10 bit words set, for st40_checksum_from_sum().
+ */
+uint16_t st40_set_udws(uint32_t idx, const uint8_t* udw, uint32_t n, uint8_t* data);
+
+/**
+ * Get n udw from st2110-40(ancillary) payload with the parity check in the same pass,
+ * with the SIMD path when the cpu has it.
+ *
+ * @param idx
+ *   Index of the first udw.
+ * @param data
+ *   The pointer to st2110-40 payload.
+ * @param n
+ *   The number of udw.
+ * @param udw
+ *   The low 8 bits of each udw, n bytes. May be NULL for the check only.
+ * @param sum
+ *   The sum of the 10 bit words got, for st40_checksum_from_sum(). May be NULL.
+ * @return
+ *   - The number of udw with a parity error, 0 if all good.
+ */
+uint32_t st40_get_udws(uint32_t idx, const uint8_t* data, uint32_t n, uint8_t* udw,
+                       uint16_t* sum);
+
+/**
+ * The checksum word from the sum of the 10 bit words, same as st40_calc_checksum() of
+ * the words.
+ *
+ * @param sum
+ *   The sum of the 10 bit words.
+ * @return
+ *   - checksum
+ */
+uint16_t st40_checksum_from_sum(uint16_t sum);
+
 /**
  * Calculate checksum from st2110-40(ancillary) payload.
  *
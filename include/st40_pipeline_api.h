@@ -24,6 +24,8 @@ struct st40_frame_info {
   struct st40_meta* meta;
   /** Pointer to the number of metadata entries in the frame */
   uint32_t meta_num;
+  /** The capacity of the metadata array, max_meta of the ops */
+  uint32_t meta_cap;
   /** user data words buffer address */
   uint8_t* udw_buff_addr;
   /** user data words buffer size */
@@ -146,6 +148,9 @@ struct st40p_tx_ops {
   uint16_t framebuff_cnt;
   /** Maximum combined size of all user data words to send in single st40p frame */
   uint32_t max_udw_buff_size;
+  /** Optional. Max metadata entries in single st40p frame, up to ST40_MAX_META_DYNAMIC,
+   * 0 for ST40_MAX_META */
+  uint16_t max_meta;
   /** Optional. name */
   const char* name;
   /** Optional. private data to the callback function */
@@ -230,6 +235,9 @@ struct st40p_rx_ops {
   uint16_t framebuff_cnt;
   /** Maximum combined size of all user data words to receive in single st40p frame */
   uint32_t max_udw_buff_size;
+  /** Optional. Max metadata entries in single st40p frame, up to ST40_MAX_META_DYNAMIC,
+   * 0 for ST40_MAX_META */
+  uint16_t max_meta;
   /** Mandatory. RTP ring queue size, must be power of 2 */
   uint32_t rtp_ring_size;
   /** Optional. name */
@@ -179,6 +179,54 @@ static inline int st20_rfc4175_422be10_to_yuv420p8(struct st20_rfc4175_422_10_pg
   return st20_rfc4175_422be10_to_yuv420p8_simd(pg, y, b, r, w, h, MTL_SIMD_LEVEL_MAX);
 }
 
+/**
+ * Convert rfc4175_422be10 to nv12 with the max optimized SIMD level, the chroma of each
+ * two lines is averaged vertically.
+ *
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param y
+ *   Point to Y(nv12) vector.
+ * @param uv
+ *   Point to the interleaved CbCr(nv12) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height, an even value.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_rfc4175_422be10_to_nv12(struct st20_rfc4175_422_10_pg2_be* pg,
+                                               uint8_t* y, uint8_t* uv, uint32_t w,
+                                               uint32_t h) {
+  return st20_rfc4175_422be10_to_nv12_simd(pg, y, uv, w, h, MTL_SIMD_LEVEL_MAX);
+}
+
+/**
+ * Convert rfc4175_422be10 to p010 with the max optimized SIMD level, the chroma of each
+ * two lines is averaged vertically.
+ *
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param y
+ *   Point to Y(p010) vector.
+ * @param uv
+ *   Point to the interleaved CbCr(p010) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height, an even value.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+static inline int st20_rfc4175_422be10_to_p010(struct st20_rfc4175_422_10_pg2_be* pg,
+                                               uint16_t* y, uint16_t* uv, uint32_t w,
+                                               uint32_t h) {
+  return st20_rfc4175_422be10_to_p010_simd(pg, y, uv, w, h, MTL_SIMD_LEVEL_MAX);
+}
+
 /**
  * Convert rfc4175_422be12 to yuv422p12le with the max optimized SIMD level.
  *
@@ -150,6 +150,11 @@ enum st_frame_fmt {
   ST_FRAME_FMT_YUV420PLANAR8 = 14,
   /** YUV 422 planar 10bit little endian, with 6-bit padding in least significant bits*/
   ST_FRAME_FMT_YUV422PLANAR16LE = 15,
+  /** YUV 420 semi-planar 8bit, a Y plane and an interleaved CbCr plane of half lines */
+  ST_FRAME_FMT_NV12 = 16,
+  /** YUV 420 semi-planar 10bit little endian, the NV12 layout with 16-bit samples, the
+   * data in the most significant 10 bits */
+  ST_FRAME_FMT_P010 = 17,
   /** End of yuv format list, new yuv should be inserted before this */
   ST_FRAME_FMT_YUV_END,
 
@@ -212,6 +217,10 @@ enum st_frame_fmt {
 #define ST_FMT_CAP_YUV422RFC4175PG2BE10 (MTL_BIT64(ST_FRAME_FMT_YUV422RFC4175PG2BE10))
 /** ST format cap of ST_FRAME_FMT_YUV422PLANAR16LE (10 bit with 6 bit padding)*/
 #define ST_FMT_CAP_YUV422PLANAR16LE (MTL_BIT64(ST_FRAME_FMT_YUV422PLANAR16LE))
+/** ST format cap of ST_FRAME_FMT_NV12 */
+#define ST_FMT_CAP_NV12 (MTL_BIT64(ST_FRAME_FMT_NV12))
+/** ST format cap of ST_FRAME_FMT_P010 */
+#define ST_FMT_CAP_P010 (MTL_BIT64(ST_FRAME_FMT_P010))
 
 /** ST format cap of ST_FRAME_FMT_ARGB */
 #define ST_FMT_CAP_ARGB (MTL_BIT64(ST_FRAME_FMT_ARGB))
@@ -244,6 +253,29 @@ enum st_frame_flag {
 /** Max planes number for one frame */
 #define ST_MAX_PLANES (4)
 
+/** Max outputs of one st_frame_scale_multi call or one st20p rx session */
+#define ST_FRAME_SCALE_OUTPUTS_MAX (8)
+
+/** Filter of the frame scaler */
+enum st_frame_scale_method {
+  /** Box, the area average of the source samples, for integer and arbitrary ratios */
+  ST_FRAME_SCALE_BOX = 0,
+  /** Bilinear, two taps on each axis */
+  ST_FRAME_SCALE_BILINEAR,
+  /** Polyphase Lanczos-2, 64 phases and taps widened by the ratio, sharper */
+  ST_FRAME_SCALE_POLYPHASE,
+  /** max value of this enum */
+  ST_FRAME_SCALE_MAX,
+};
+
+/** The size of one scaler output */
+struct st_frame_scale_size {
+  /** output width */
+  uint32_t width;
+  /** output height */
+  uint32_t height;
+};
+
 /** The structure info for external frame */
 struct st_ext_frame { /** Each plane's virtual address of external frame */
   void* addr[ST_MAX_PLANES];
@@ -502,9 +534,22 @@ enum st20p_tx_flag {
    * immediately after notify_frame_done).
    */
   ST20P_TX_FLAG_EXT_FRAME_MANUAL_RELEASE = (MTL_BIT32(13)),
+  /**
+   * Only used for internal convert mode and limited input formats:
+   * ST_FRAME_FMT_YUV422PLANAR10LE, ST_FRAME_FMT_Y210, ST_FRAME_FMT_YUV422PLANAR16LE
+   * Perform the color format conversion on each packet when building the payload, no
+   * transport framebuffer is allocated.
+   */
+  ST20P_TX_FLAG_PKT_CONVERT = (MTL_BIT32(14)),
   /** Enable the st20p_tx_get_frame block behavior to wait until a frame becomes
      available or (default: 1s, use st20p_tx_set_block_timeout to customize) */
   ST20P_TX_FLAG_BLOCK_GET = (MTL_BIT32(15)),
+  /**
+   * Only used for internal convert mode. Benchmark the simd levels of the converter for
+   * the session resolution and use the cheapest one instead of the max level of the
+   * cpu, the result is cached in memory and mtl_init_params.convert_select_cache if set.
+   */
+  ST20P_TX_FLAG_CONVERT_AUTO_SELECT = (MTL_BIT32(16)),
 };
 
 /** Bit define for flags of struct st22p_rx_ops. */
@@ -534,6 +579,12 @@ enum st22p_rx_flag {
   ST22P_RX_FLAG_EXT_FRAME = (MTL_BIT32(4)),
   /** Force the numa of the created session, both CPU and memory */
   ST22P_RX_FLAG_FORCE_NUMA = MTL_BIT32(5),
+  /**
+   * Allow the decoder to read the codestream as the received packets, see
+   * ST22_DECODER_RESP_FLAG_CODESTREAM_SG. The packets stay in the rx pool until the
+   * frame is decoded, only for a decoder that keeps up with the stream.
+   */
+  ST22P_RX_FLAG_CODESTREAM_SG = MTL_BIT32(6),
 
   /** Enable the st22p_rx_get_frame block behavior to wait until a frame becomes
      available or timeout(default: 1s, use st22p_rx_set_block_timeout to customize) */
@@ -629,6 +680,19 @@ enum st20p_rx_flag {
    * Use gpu_direct vram for framebuffers
    */
   ST20P_RX_FLAG_USE_GPU_DIRECT_FRAMEBUFFERS = (MTL_BIT32(24)),
+  /**
+   * Only used for internal convert mode. Benchmark the simd levels of the converter for
+   * the session resolution and use the cheapest one instead of the max level of the
+   * cpu, the result is cached in memory and mtl_init_params.convert_select_cache if set.
+   */
+  ST20P_RX_FLAG_CONVERT_AUTO_SELECT = (MTL_BIT32(25)),
+  /**
+   * Deliver the frame by slices before it's complete, see slice_lines and
+   * notify_slice_ready of st20p_rx_ops and st20p_rx_get_slice. The internal converter
+   * converts each slice once it arrives. Not for the plugin converters,
+   * ST20P_RX_FLAG_PKT_CONVERT and ST20P_RX_FLAG_EXT_FRAME.
+   */
+  ST20P_RX_FLAG_SLICE_LEVEL = (MTL_BIT32(26)),
 };
 
 /** Bit define for flag_resp of struct st22_decoder_create_req. */
@@ -637,6 +701,12 @@ enum st22_decoder_resp_flag {
      available or timeout(default: 1s, use st22_decoder_set_block_timeout to customize)
    */
   ST22_DECODER_RESP_FLAG_BLOCK_GET = (MTL_BIT32(0)),
+  /**
+   * The decoder consumes the codestream by src_segs of st22_decode_frame_meta, the lib
+   * skips the reassembly of the received packets into the src frame. Only honored if
+   * codestream_sg of st22_decoder_create_req is set.
+   */
+  ST22_DECODER_RESP_FLAG_CODESTREAM_SG = (MTL_BIT32(1)),
 };
 
 /** Bit define for flag_resp of struct st22_encoder_create_req. */
@@ -675,6 +745,16 @@ struct st22_encoder_create_req {
   uint32_t resp_flag;
   /** numa socket id, set by lib */
   int socket_id;
+  /**
+   * max frames the plugin holds between st22_encoder_get_frame and
+   * st22_encoder_put_frame. Set by lib to encode_frames_in_flight of st22p_tx_ops (0 to
+   * let plugin decide), updated by plugin to the depth it runs, 0 or 1 is one frame at a
+   * time. The frames can be put back out of order, lib transmits them in order.
+   */
+  uint16_t max_frames_in_flight;
+  /** slices or tiles of one frame to encode in parallel, 0 for plugin default, set by
+   * lib */
+  uint32_t slice_cnt;
 };
 
 /** The structure info for st22 encoder dev. */
@@ -731,6 +811,11 @@ struct st22_decoder_create_req {
   uint32_t resp_flag;
   /** numa socket id, set by lib */
   int socket_id;
+  /**
+   * Set by lib if the application enabled ST22P_RX_FLAG_CODESTREAM_SG, the plugin may
+   * then set ST22_DECODER_RESP_FLAG_CODESTREAM_SG in resp_flag.
+   */
+  bool codestream_sg;
 };
 
 /** The structure info for st22 decoder dev. */
@@ -763,6 +848,13 @@ struct st22_decode_frame_meta {
   struct st_frame* dst;
   /** priv pointer for lib, do not touch this */
   void* priv;
+  /**
+   * Only for ST22_DECODER_RESP_FLAG_CODESTREAM_SG, the codestream segments in packet
+   * order, src->addr[0] does not hold the codestream. Valid until put_frame.
+   */
+  const struct st22_rx_codestream_seg* src_segs;
+  /** Only for ST22_DECODER_RESP_FLAG_CODESTREAM_SG, the number of entries in src_segs */
+  uint32_t src_segs_nb;
 };
 
 /** The structure info for st plugin convert session create request. */
@@ -963,6 +1055,12 @@ struct st20p_tx_ops {
   int (*notify_event)(void* priv, enum st_event event, void* args);
   /**  Use this socket if ST20P_TX_FLAG_FORCE_NUMA is on, default use the NIC numa */
   int socket_id;
+  /**
+   * Optional for the internal converter. The max number of line bands to convert one
+   * frame in parallel by the shared converter pool of mtl. 0 or 1 means convert on the
+   * calling thread only.
+   */
+  uint16_t convert_parallel;
 };
 
 /** The structure describing how to create a rx st2110-20 pipeline session. */
@@ -1035,6 +1133,36 @@ struct st20p_rx_ops {
                          struct st20_detect_reply* reply);
   /**  Use this socket if ST20P_RX_FLAG_FORCE_NUMA is on, default use the NIC numa */
   int socket_id;
+  /**
+   * Optional for the internal converter. The max number of line bands to convert one
+   * frame in parallel by the shared converter pool of mtl. 0 or 1 means convert on the
+   * calling thread only.
+   */
+  uint16_t convert_parallel;
+  /**
+   * Optional for ST20P_RX_FLAG_SLICE_LEVEL. Lines in one slice, must be even for the
+   * 420 output formats. Leave to zero to use height / 32.
+   */
+  uint32_t slice_lines;
+  /**
+   * Optional for ST20P_RX_FLAG_SLICE_LEVEL. Callback when more lines of a frame are
+   * ready, the lines [0, lines_ready) of frame are final and can be read until the
+   * frame is put back after st20p_rx_get_frame. The frame is still owned by the lib.
+   * And only non-block method can be used within this callback as it run from lcore
+   * tasklet routine.
+   */
+  int (*notify_slice_ready)(void* priv, struct st_frame* frame, uint32_t lines_ready);
+  /**
+   * Optional. The sizes of the downscaled auxiliary outputs, for proxy or multiviewer
+   * tiles. Each frame is scaled to all the sizes in one pass by st20p_rx_get_frame, get
+   * them by st20p_rx_get_scaled_frame. The output_fmt must be a planar format supported
+   * by st_frame_scale, not for ST20P_RX_FLAG_AUTO_DETECT.
+   */
+  struct st_frame_scale_size scale_sizes[ST_FRAME_SCALE_OUTPUTS_MAX];
+  /** Optional. The number of the scale_sizes, 0 means no auxiliary output */
+  uint16_t scale_cnt;
+  /** Optional. The scale filter of the auxiliary outputs */
+  enum st_frame_scale_method scale_method;
 
   /* use to store framebuffers on vram */
   void* gpu_context;
@@ -1123,6 +1251,13 @@ struct st22p_tx_ops {
   int (*notify_event)(void* priv, enum st_event event, void* args);
   /**  Use this socket if ST22P_TX_FLAG_FORCE_NUMA is on, default use the NIC numa */
   int socket_id;
+  /**
+   * Optional. max frames in the encoder at the same time, for the plugins which encode
+   * several frames in parallel. 0 for plugin default, limited to framebuff_cnt.
+   */
+  uint16_t encode_frames_in_flight;
+  /** Optional. slices or tiles of one frame to encode in parallel, 0 for plugin default */
+  uint32_t encode_slice_cnt;
 };
 
 /** The structure describing how to create a rx st2110-22 pipeline session. */
@@ -2001,6 +2136,39 @@ int st20p_rx_free(st20p_rx_handle handle);
  */
 struct st_frame* st20p_rx_get_frame(st20p_rx_handle handle);
 
+/**
+ * Get the oldest frame which is still receiving in the rx st2110-20 pipeline session,
+ * only for ST20P_RX_FLAG_SLICE_LEVEL. The frame is still owned by the lib, don't put it.
+ * The lines [0, lines_ready) are final and can be read, the whole frame is returned by
+ * st20p_rx_get_frame once it's complete.
+ *
+ * @param handle
+ *   The handle to the rx st2110-20 pipeline session.
+ * @param lines_ready
+ *   Return the lines ready in the frame, the lines of one field for interlaced.
+ * @return
+ *   - NULL if no frame is receiving or no line is ready.
+ *   - Otherwise, the frame pointer.
+ */
+struct st_frame* st20p_rx_get_slice(st20p_rx_handle handle, uint32_t* lines_ready);
+
+/**
+ * Get the downscaled auxiliary output of one frame got by st20p_rx_get_frame, only if
+ * scale_cnt is set in the ops. The output is valid until the frame is put back.
+ *
+ * @param handle
+ *   The handle to the rx st2110-20 pipeline session.
+ * @param frame
+ *   the frame pointer by st20p_rx_get_frame.
+ * @param idx
+ *   The index of the output in scale_sizes.
+ * @return
+ *   - NULL if no such output or the scale fail.
+ *   - Otherwise, the scaled frame pointer.
+ */
+struct st_frame* st20p_rx_get_scaled_frame(st20p_rx_handle handle, struct st_frame* frame,
+                                           uint16_t idx);
+
 /**
  * Put back the frame which get by st20p_rx_get_frame to the rx
  * st2110-20 pipeline session.
@@ -2189,6 +2357,41 @@ int st20p_rx_set_block_timeout(st20p_rx_handle handle, uint64_t timedwait_ns);
  */
 int st_frame_convert(struct st_frame* src, struct st_frame* dst);
 
+/**
+ * Convert color format from source frame to destination frame with the built-in
+ * converter at the required SIMD level, to benchmark or to compare the SIMD levels.
+ * Note the level may downgrade to the SIMD which system really support.
+ *
+ * @param src
+ *   The source frame.
+ * @param dst
+ *   The destination frame.
+ * @param level
+ *   The SIMD level.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st_frame_convert_simd(struct st_frame* src, struct st_frame* dst,
+                          enum mtl_simd_level level);
+
+/**
+ * Get the formats of the built-in converter at idx, call from idx 0 until it fails to
+ * enumerate all the built-in converters.
+ *
+ * @param idx
+ *   The index of the built-in converter.
+ * @param src_fmt
+ *   The source format of the converter.
+ * @param dst_fmt
+ *   The destination format of the converter.
+ * @return
+ *   - 0: Success.
+ *   - -ENOENT: No converter at idx.
+ */
+int st_frame_converter_query(uint32_t idx, enum st_frame_fmt* src_fmt,
+                             enum st_frame_fmt* dst_fmt);
+
 /**
  * Downsample frame size to destination frame.
  *
@@ -2204,6 +2407,45 @@ int st_frame_convert(struct st_frame* src, struct st_frame* dst);
  */
 int st_frame_downsample(struct st_frame* src, struct st_frame* dst, int idx);
 
+/**
+ * Scale the planar source frame down to the size of the destination frame.
+ * Supported formats: ST_FRAME_FMT_YUV422PLANAR8, ST_FRAME_FMT_YUV420PLANAR8,
+ * ST_FRAME_FMT_YUV422PLANAR10LE/12LE/16LE, ST_FRAME_FMT_YUV444PLANAR10LE/12LE and
+ * ST_FRAME_FMT_GBRPLANAR10LE/12LE. The destination has the same format, a size not
+ * larger than the source and a ratio up to 1/16.
+ *
+ * @param src
+ *   The source frame.
+ * @param dst
+ *   The destination frame.
+ * @param method
+ *   The scale filter.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st_frame_scale(struct st_frame* src, struct st_frame* dst,
+                   enum st_frame_scale_method method);
+
+/**
+ * Scale the planar source frame down to several destination frames of different sizes
+ * in one pass over the source lines, see st_frame_scale for the formats.
+ *
+ * @param src
+ *   The source frame.
+ * @param dsts
+ *   The destination frames.
+ * @param dst_cnt
+ *   The number of destination frames, up to ST_FRAME_SCALE_OUTPUTS_MAX.
+ * @param method
+ *   The scale filter.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st_frame_scale_multi(struct st_frame* src, struct st_frame** dsts, uint16_t dst_cnt,
+                         enum st_frame_scale_method method);
+
 /**
  * Calculate the least linesize per the format, w, plane
  *
@@ -20,6 +20,15 @@
 
 #ifndef WINDOWSENV
 
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <linux/sockios.h>
+
+#ifndef SO_TXTIME
+#define SO_TXTIME 61
+#define SCM_TXTIME SO_TXTIME
+#endif
+
 static inline void mt_dp_init_sockaddr(struct sockaddr_in* addr,
                                        const uint8_t ip[MTL_IP_ADDR_LEN], uint16_t port) {
   *addr = (struct sockaddr_in){
@@ -180,6 +189,113 @@ static uint16_t tx_socket_send_mbuf_gso(struct mt_tx_socket_thread* t,
   return tx;
 }
 
+/*
+ * Send with the launch time attached by the tsn transmitter, each pkt is one msg with a
+ * SCM_TXTIME cmsg so the etf qdisc can release it on time. GSO is not used here as the
+ * kernel apply one txtime to the whole gso skb. In the emulate mode the pkt is held in
+ * the caller until the target ptp time is reached.
+ */
+static uint16_t tx_socket_send_mbuf_txtime(struct mt_tx_socket_thread* t,
+                                           struct rte_mbuf** tx_pkts, uint16_t nb_pkts) {
+  struct mt_tx_socket_entry* entry = t->parent;
+  struct mtl_main_impl* impl = entry->parent;
+  enum mtl_port port = entry->port;
+  struct mt_interface* inf = mt_if(impl, port);
+  struct mtl_port_status* stats = inf->dev_stats_sw;
+  int fd = t->fd, ret;
+  uint16_t tx = 0;
+  uint64_t cur_ptp = mt_get_ptp_time(impl, port);
+  /* the launch time is in CLOCK_TAI for the etf qdisc, read the delta once per burst */
+  int64_t tai_delta = entry->txtime_emulate ? 0 : (int64_t)(mt_get_tai_time() - cur_ptp);
+
+  while (tx < nb_pkts) {
+    uint16_t n = RTE_MIN(nb_pkts - tx, MT_DP_SOCKET_TXTIME_BURST);
+    uint16_t build = 0;
+    uint64_t bytes = 0;
+
+    for (; build < n; build++) {
+      struct rte_mbuf* m = tx_pkts[tx + build];
+      ret = tx_socket_verify_mbuf(m);
+      if (ret < 0) {
+        err("%s(%d,%d), unsupported mbuf %p ret %d\n", __func__, port, fd, m, ret);
+        break;
+      }
+
+      uint64_t launch_ptp = mt_mbuf_launch_time(inf, m);
+      if (launch_ptp && entry->txtime_emulate && (launch_ptp > cur_ptp)) {
+        t->stat_tx_txtime_wait++;
+        break; /* not reach the target time */
+      }
+
+      struct msghdr* msg = &t->txtime_msgs[build].msg_hdr;
+      struct iovec* iov = &t->txtime_iovs[build];
+      iov->iov_base = rte_pktmbuf_mtod_offset(m, void*, sizeof(struct mt_udp_hdr));
+      iov->iov_len = m->data_len - sizeof(struct mt_udp_hdr);
+      msg->msg_name = &t->send_addr;
+      msg->msg_namelen = sizeof(t->send_addr);
+      msg->msg_iov = iov;
+      msg->msg_iovlen = 1;
+      msg->msg_flags = 0;
+      if (launch_ptp && !entry->txtime_emulate) {
+        uint64_t txtime = launch_ptp + tai_delta;
+
+        msg->msg_control = t->txtime_control[build];
+        msg->msg_controllen = sizeof(t->txtime_control[build]);
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_TXTIME;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(txtime));
+        memcpy(CMSG_DATA(cmsg), &txtime, sizeof(txtime));
+        t->stat_tx_txtime++;
+      } else {
+        msg->msg_control = NULL;
+        msg->msg_controllen = 0;
+      }
+      bytes += m->data_len;
+    }
+    if (!build) break;
+
+    t->stat_tx_try += build;
+    int sent = sendmmsg(fd, t->txtime_msgs, build, MSG_DONTWAIT);
+    dbg("%s(%d,%d), build %u sent %d\n", __func__, port, fd, build, sent);
+    if (sent <= 0) break;
+    if (sent < build) { /* recalculate the bytes for the partial send */
+      bytes = 0;
+      for (int i = 0; i < sent; i++) bytes += tx_pkts[tx + i]->data_len;
+    }
+    tx += sent;
+    if (stats) {
+      stats->tx_packets += sent;
+      stats->tx_bytes += bytes;
+    }
+    t->stat_tx_pkt += sent;
+    if (sent < build) break; /* the socket is busy */
+    if (build < n) break;    /* the rest is not ready */
+  }
+
+  return tx;
+}
+
+/*
+ * The emulate mode holds the pkt until the target ptp time, sleep the tx thread till
+ * then instead of the busy retry. The sleep is cut to stay responsive to the stop.
+ */
+static void tx_socket_txtime_emulate_wait(struct mt_tx_socket_thread* t,
+                                          struct rte_mbuf* m) {
+  struct mt_tx_socket_entry* entry = t->parent;
+  struct mtl_main_impl* impl = entry->parent;
+  enum mtl_port port = entry->port;
+  uint64_t launch_ptp, cur_ptp;
+
+  if (!entry->txtime_emulate) return;
+  launch_ptp = mt_mbuf_launch_time(mt_if(impl, port), m);
+  cur_ptp = mt_get_ptp_time(impl, port);
+  if (launch_ptp <= cur_ptp) return;
+
+  uint64_t wait_us = (launch_ptp - cur_ptp) / NS_PER_US;
+  if (wait_us) mt_sleep_us(RTE_MIN(wait_us, MT_DP_SOCKET_TXTIME_WAIT_MAX_US));
+}
+
 static void* tx_socket_thread_loop(void* arg) {
   struct mt_tx_socket_thread* t = arg;
   struct mt_tx_socket_entry* entry = t->parent;
@@ -192,7 +308,11 @@ static void* tx_socket_thread_loop(void* arg) {
     ret = rte_ring_mc_dequeue(entry->ring, (void**)&m);
     if (ret < 0) continue;
     do {
-      ret = tx_socket_send_mbuf(t, m);
+      if (entry->txtime) {
+        ret = tx_socket_send_mbuf_txtime(t, &m, 1) ? 0 : -EBUSY;
+        if (ret < 0) tx_socket_txtime_emulate_wait(t, m);
+      } else
+        ret = tx_socket_send_mbuf(t, m);
     } while ((ret < 0) && (rte_atomic32_read(&t->stop_thread) == 0));
     rte_pktmbuf_free(m);
   }
@@ -229,6 +349,21 @@ static int tx_socket_init_thread_data(struct mt_tx_socket_thread* t) {
     return ret;
   }
 
+  if (entry->txtime) {
+    mt_dp_init_sockaddr(&t->send_addr, entry->flow.dip_addr, entry->flow.dst_port);
+    if (!entry->txtime_emulate) {
+      struct sock_txtime txtime_cfg;
+      memset(&txtime_cfg, 0, sizeof(txtime_cfg));
+      txtime_cfg.clockid = MT_CLOCK_TAI_ID;
+      ret = setsockopt(fd, SOL_SOCKET, SO_TXTIME, &txtime_cfg, sizeof(txtime_cfg));
+      if (ret < 0) {
+        warn("%s(%d,%d), SO_TXTIME fail %d, fallback to emulated launch time\n",
+             __func__, port, idx, ret);
+        entry->txtime_emulate = true;
+      }
+    }
+  }
+
   if (entry->gso_sz) {
     mt_dp_init_sockaddr(&t->send_addr, entry->flow.dip_addr, entry->flow.dst_port);
     t->msg.msg_namelen = sizeof(t->send_addr);
@@ -305,6 +440,12 @@ static int tx_socket_stat_dump(void* priv) {
     t->stat_tx_pkt = 0;
     t->stat_tx_gso = 0;
     t->stat_tx_try = 0;
+    if (entry->txtime) {
+      info("%s(%d,%d), txtime pkt %d wait %d%s\n", __func__, port, fd, t->stat_tx_txtime,
+           t->stat_tx_txtime_wait, entry->txtime_emulate ? " emulated" : "");
+      t->stat_tx_txtime = 0;
+      t->stat_tx_txtime_wait = 0;
+    }
   }
 
   return 0;
@@ -332,6 +473,17 @@ struct mt_tx_socket_entry* mt_tx_socket_get(struct mtl_main_impl* impl,
   entry->rate_limit_per_thread = (uint64_t)6 * 1000 * 1000 * 1000;
   entry->gso_sz = flow->gso_sz;
   rte_memcpy(&entry->flow, flow, sizeof(entry->flow));
+  if (flow->flags & MT_TXQ_FLOW_F_LAUNCH_TIME) {
+    entry->txtime = true;
+    entry->txtime_emulate = mt_user_tx_txtime_emulate(impl);
+    if (!entry->txtime_emulate && !MT_HAS_CLOCK_TAI) {
+      warn("%s(%d), no CLOCK_TAI for the etf launch time, use software emulated\n",
+           __func__, port);
+      entry->txtime_emulate = true;
+    }
+    /* the kernel apply one txtime to the whole gso skb */
+    entry->gso_sz = 0;
+  }
 
   for (int i = 0; i < MT_DP_SOCKET_THREADS_MAX; i++) {
     struct mt_tx_socket_thread* t = &entry->threads_data[i];
@@ -349,6 +501,12 @@ struct mt_tx_socket_entry* mt_tx_socket_get(struct mtl_main_impl* impl,
   uint64_t required = flow->bytes_per_sec * 8;
   entry->threads = required / entry->rate_limit_per_thread + 1;
   entry->threads = RTE_MIN(entry->threads, MT_DP_SOCKET_THREADS_MAX);
+  if (entry->txtime && entry->threads > 1) {
+    /* the etf qdisc drops the pkts out of the launch time order, one thread keeps it */
+    warn("%s(%d), %d threads required, only one with the launch time\n", __func__,
+         port, entry->threads);
+    entry->threads = 1;
+  }
   if (entry->threads > 1) {
     ret = tx_socket_init_threads(entry);
     if (ret < 0) {
@@ -367,9 +525,10 @@ struct mt_tx_socket_entry* mt_tx_socket_get(struct mtl_main_impl* impl,
   entry->stat_registered = true;
 
   uint8_t* ip = flow->dip_addr;
-  info("%s(%d), fd %d ip %u.%u.%u.%u, port %u, threads %u gso_sz %u\n", __func__, port,
-       entry->threads_data[0].fd, ip[0], ip[1], ip[2], ip[3], flow->dst_port,
-       entry->threads, entry->gso_sz);
+  info("%s(%d), fd %d ip %u.%u.%u.%u, port %u, threads %u gso_sz %u txtime %s\n",
+       __func__, port, entry->threads_data[0].fd, ip[0], ip[1], ip[2], ip[3],
+       flow->dst_port, entry->threads, entry->gso_sz,
+       entry->txtime ? (entry->txtime_emulate ? "emulated" : "etf") : "off");
   return entry;
 }
 
@@ -427,7 +586,9 @@ uint16_t mt_tx_socket_burst(struct mt_tx_socket_entry* entry, struct rte_mbuf**
     return n;
   }
 
-  if (entry->gso_sz) {
+  if (entry->txtime) {
+    tx = tx_socket_send_mbuf_txtime(&entry->threads_data[0], tx_pkts, nb_pkts);
+  } else if (entry->gso_sz) {
     tx = tx_socket_send_mbuf_gso(&entry->threads_data[0], tx_pkts, nb_pkts);
   } else {
     for (tx = 0; tx < nb_pkts; tx++) {
@@ -441,6 +602,107 @@ uint16_t mt_tx_socket_burst(struct mt_tx_socket_entry* entry, struct rte_mbuf**
   return tx;
 }
 
+static int rx_socket_hwtstamp_ioctl(struct mt_rx_socket_entry* entry, int fd,
+                                    unsigned long request, struct hwtstamp_config* cfg) {
+  enum mtl_port port = entry->port;
+  const char* if_name = mt_kernel_if_name(entry->parent, port);
+  struct ifreq ifr;
+  int ret;
+
+  memset(&ifr, 0, sizeof(ifr));
+  snprintf(ifr.ifr_name, sizeof(ifr.ifr_name), "%s", if_name);
+  ifr.ifr_data = (void*)cfg;
+  ret = ioctl(fd, request, &ifr);
+  if (ret < 0) {
+    warn("%s(%d,%d), %s on %s fail %d\n", __func__, port, fd,
+         (request == SIOCSHWTSTAMP) ? "SIOCSHWTSTAMP" : "SIOCGHWTSTAMP", if_name, ret);
+  }
+  return ret;
+}
+
+/*
+ * Enable the hw timestamp of all rx pkts on the interface if it's not enabled. The
+ * config is shared by all the rx sockets of the interface, the first user saves the
+ * original rx filter and the last user restores it in rx_socket_uinit_hw_timestamp.
+ */
+static int rx_socket_init_hw_timestamp(struct mt_rx_socket_entry* entry, int fd) {
+  enum mtl_port port = entry->port;
+  struct mt_interface* inf = mt_if(entry->parent, port);
+  struct hwtstamp_config cfg;
+  int ret = 0;
+
+  mt_pthread_mutex_lock(&inf->hwtstamp_mutex);
+  if (!inf->hwtstamp_users) {
+    memset(&cfg, 0, sizeof(cfg));
+    ret = rx_socket_hwtstamp_ioctl(entry, fd, SIOCGHWTSTAMP, &cfg);
+    if (ret >= 0 && cfg.rx_filter != HWTSTAMP_FILTER_ALL) {
+      int rx_filter = cfg.rx_filter;
+
+      /* keep the tx type as it may used by ptp4l */
+      cfg.rx_filter = HWTSTAMP_FILTER_ALL;
+      ret = rx_socket_hwtstamp_ioctl(entry, fd, SIOCSHWTSTAMP, &cfg);
+      if (ret >= 0) {
+        inf->hwtstamp_changed = true;
+        inf->hwtstamp_rx_filter = rx_filter;
+        info("%s(%d,%d), hw timestamp enabled for all rx pkts, rx filter was %d\n",
+             __func__, port, fd, rx_filter);
+      }
+    }
+  }
+  if (ret >= 0) {
+    inf->hwtstamp_users++;
+    entry->hw_timestamp = true;
+  }
+  mt_pthread_mutex_unlock(&inf->hwtstamp_mutex);
+
+  return ret;
+}
+
+/* restore the original rx filter of the interface when the last user gone */
+static void rx_socket_uinit_hw_timestamp(struct mt_rx_socket_entry* entry, int fd) {
+  enum mtl_port port = entry->port;
+  struct mt_interface* inf = mt_if(entry->parent, port);
+  struct hwtstamp_config cfg;
+
+  if (!entry->hw_timestamp) return;
+  entry->hw_timestamp = false;
+
+  mt_pthread_mutex_lock(&inf->hwtstamp_mutex);
+  inf->hwtstamp_users--;
+  if (!inf->hwtstamp_users && inf->hwtstamp_changed) {
+    memset(&cfg, 0, sizeof(cfg));
+    /* read it again to keep the tx type which may be changed by ptp4l since */
+    if (rx_socket_hwtstamp_ioctl(entry, fd, SIOCGHWTSTAMP, &cfg) >= 0) {
+      cfg.rx_filter = inf->hwtstamp_rx_filter;
+      if (rx_socket_hwtstamp_ioctl(entry, fd, SIOCSHWTSTAMP, &cfg) >= 0)
+        info("%s(%d,%d), rx filter restored to %d\n", __func__, port, fd, cfg.rx_filter);
+    }
+    inf->hwtstamp_changed = false;
+  }
+  mt_pthread_mutex_unlock(&inf->hwtstamp_mutex);
+}
+
+/* the kernel timestamp of each pkt, software and hardware(if user enabled) */
+static int rx_socket_init_timestamping(struct mt_rx_socket_entry* entry, int fd) {
+  enum mtl_port port = entry->port;
+  int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+  int ret;
+
+  if (mt_user_hw_timestamp(entry->parent)) {
+    ret = rx_socket_init_hw_timestamp(entry, fd);
+    if (ret >= 0) flags |= SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+  }
+
+  ret = setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags));
+  if (ret < 0) {
+    warn("%s(%d,%d), SO_TIMESTAMPING fail %d, use the time of recv\n", __func__, port, fd,
+         ret);
+    return ret;
+  }
+  entry->timestamping = true;
+  return 0;
+}
+
 static int rx_socket_init_fd(struct mt_rx_socket_entry* entry, int fd, bool reuse) {
   int ret;
   enum mtl_port port = entry->port;
@@ -493,9 +755,52 @@ static int rx_socket_init_fd(struct mt_rx_socket_entry* entry, int fd, bool reus
     }
   }
 
+  if (mt_if_has_sw_timestamp(impl, port)) rx_socket_init_timestamping(entry, fd);
+
   return 0;
 }
 
+static inline void rx_socket_ts_delta_refresh(struct mt_rx_socket_thread* t) {
+  struct mt_rx_socket_entry* entry = t->parent;
+
+  if (t->delta_refresh) {
+    t->delta_refresh--;
+    return;
+  }
+  uint64_t ptp = mt_get_ptp_time(entry->parent, entry->port);
+  t->real_delta = ptp - mt_get_real_time();
+  t->tai_delta = ptp - mt_get_tai_time();
+  t->delta_refresh = MT_DP_SOCKET_TS_DELTA_REFRESH;
+}
+
+/* the kernel rx timestamp in ptp time, fallback to the current ptp time */
+static uint64_t rx_socket_time_stamp(struct mt_rx_socket_thread* t, struct msghdr* msg) {
+  struct mt_rx_socket_entry* entry = t->parent;
+  struct cmsghdr* cmsg;
+
+  if (entry->timestamping) {
+    for (cmsg = CMSG_FIRSTHDR(msg); cmsg; cmsg = CMSG_NXTHDR(msg, cmsg)) {
+      if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_TIMESTAMPING)
+        continue;
+
+      struct scm_timestamping* ts = (struct scm_timestamping*)CMSG_DATA(cmsg);
+      /* ts[2] is the raw hw timestamp of the nic ptp clock(tai), ts[0] is the sw */
+      if (ts->ts[2].tv_sec || ts->ts[2].tv_nsec) {
+        rx_socket_ts_delta_refresh(t);
+        t->stat_rx_hw_timestamp++;
+        return mt_timespec_to_ns(&ts->ts[2]) + t->tai_delta;
+      }
+      if (ts->ts[0].tv_sec || ts->ts[0].tv_nsec) {
+        rx_socket_ts_delta_refresh(t);
+        t->stat_rx_sw_timestamp++;
+        return mt_timespec_to_ns(&ts->ts[0]) + t->real_delta;
+      }
+    }
+  }
+
+  return mt_get_ptp_time(entry->parent, entry->port);
+}
+
 static struct rte_mbuf* rx_socket_recv_mbuf(struct mt_rx_socket_thread* t) {
   struct mt_rx_socket_entry* entry = t->parent;
   enum mtl_port port = entry->port;
@@ -517,11 +822,20 @@ static struct rte_mbuf* rx_socket_recv_mbuf(struct mt_rx_socket_thread* t) {
   struct rte_udp_hdr* udp = &hdr->udp;
   struct rte_ipv4_hdr* ipv4 = &hdr->ipv4;
   struct sockaddr_in addr_in;
-  socklen_t addr_in_len = sizeof(addr_in);
+  struct msghdr* msg = &t->msg;
+
+  t->iov.iov_base = payload;
+  t->iov.iov_len = entry->pool_element_sz - sizeof(struct mt_udp_hdr);
+  msg->msg_name = &addr_in;
+  msg->msg_namelen = sizeof(addr_in);
+  msg->msg_iov = &t->iov;
+  msg->msg_iovlen = 1;
+  msg->msg_control = t->msg_control;
+  msg->msg_controllen = sizeof(t->msg_control);
+  msg->msg_flags = 0;
 
   t->stat_rx_try++;
-  ssize_t len =
-      recvfrom(fd, payload, entry->pool_element_sz, MSG_DONTWAIT, &addr_in, &addr_in_len);
+  ssize_t len = recvmsg(fd, msg, MSG_DONTWAIT);
   if (len <= 0) {
     return NULL;
   }
@@ -533,6 +847,10 @@ static struct rte_mbuf* rx_socket_recv_mbuf(struct mt_rx_socket_thread* t) {
   udp->src_port = addr_in.sin_port;
   ipv4->src_addr = addr_in.sin_addr.s_addr;
   ipv4->next_proto_id = IPPROTO_UDP;
+  if (mt_if_has_sw_timestamp(entry->parent, port)) {
+    *RTE_MBUF_DYNFIELD(pkt, entry->parent->dynfield_offset, rte_mbuf_timestamp_t*) =
+        rx_socket_time_stamp(t, msg);
+  }
 
   if (stats) {
     stats->rx_packets++;
@@ -613,6 +931,12 @@ static int rx_socket_stat_dump(void* priv) {
          t->stat_rx_try, i);
     t->stat_rx_pkt = 0;
     t->stat_rx_try = 0;
+    if (t->stat_rx_sw_timestamp || t->stat_rx_hw_timestamp) {
+      info("%s(%d,%d), rx timestamp sw %d hw %d on thread %d\n", __func__, port, fd,
+           t->stat_rx_sw_timestamp, t->stat_rx_hw_timestamp, i);
+      t->stat_rx_sw_timestamp = 0;
+      t->stat_rx_hw_timestamp = 0;
+    }
   }
 
   return 0;
@@ -652,7 +976,7 @@ struct mt_rx_socket_entry* mt_rx_socket_get(struct mtl_main_impl* impl,
   }
   entry->parent = impl;
   entry->port = port;
-  entry->pool_element_sz = 2048;
+  entry->pool_element_sz = RTE_MAX(2048, flow->pkt_max_len);
   rte_memcpy(&entry->flow, flow, sizeof(entry->flow));
   /* 5g bit per second */
   entry->rate_limit_per_thread = (uint64_t)5 * 1000 * 1000 * 1000;
@@ -743,6 +1067,7 @@ int mt_rx_socket_put(struct mt_rx_socket_entry* entry) {
   }
   /* close fd */
   if (entry->fd >= 0) {
+    rx_socket_uinit_hw_timestamp(entry, entry->fd);
     close(entry->fd);
     entry->fd = -1;
   }
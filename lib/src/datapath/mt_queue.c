@@ -148,6 +148,11 @@ static uint16_t tx_dpdk_burst(struct mt_txq_entry* entry, struct rte_mbuf** tx_p
 
 struct mt_txq_entry* mt_txq_get(struct mtl_main_impl* impl, enum mtl_port port,
                                 struct mt_txq_flow* flow) {
+  if (mt_pmd_is_pcap_replay(impl, port)) {
+    err("%s(%d), pcap replay port is rx only\n", __func__, port);
+    return NULL;
+  }
+
   struct mt_txq_entry* entry =
       mt_rte_zmalloc_socket(sizeof(*entry), mt_socket_id(impl, port));
   if (!entry) {
@@ -6,6 +6,7 @@
 
 #include "../dev/mt_af_xdp.h"
 #include "../dev/mt_dev.h"
+#include "../dev/mt_pcap_replay.h"
 #include "../mt_flow.h"
 #include "../mt_log.h"
 #include "../mt_socket.h"
@@ -135,6 +136,8 @@ static int rsq_init(struct mtl_main_impl* impl, struct mt_rsq_impl* rsq) {
     rsq_queue = &rsq->rsq_queues[q];
     rsq_queue->queue_id = q;
     rsq_queue->port_id = mt_port_id(impl, port);
+    if (mt_pmd_is_pcap_replay(impl, port))
+      rsq_queue->pcap_replay = mt_if(impl, port)->pcap_replay;
     rte_atomic32_set(&rsq_queue->entry_cnt, 0);
     rte_spinlock_init(&rsq_queue->mutex);
     MT_TAILQ_INIT(&rsq_queue->head);
@@ -299,6 +302,8 @@ static int rsq_rx(struct mt_rsq_queue* rsq_queue) {
 
   if (rsq_queue->xdp)
     rx = mt_rx_xdp_burst(rsq_queue->xdp, pkts, MT_SQ_BURST_SIZE);
+  else if (rsq_queue->pcap_replay)
+    rx = mt_pcap_replay_rx_burst(rsq_queue->pcap_replay, pkts, MT_SQ_BURST_SIZE);
   else
     rx = rte_eth_rx_burst(rsq_queue->port_id, q, pkts, MT_SQ_BURST_SIZE);
   if (rx) dbg("%s(%u), rx pkts %u\n", __func__, q, rx);
@@ -321,7 +326,10 @@ static int rsq_rx(struct mt_rsq_queue* rsq_queue) {
     }
     if (!rsq_entry) { /* no match, redirect to cni */
       UPDATE_ENTRY();
-      if (rsq_queue->cni_entry) rsq_entry_pkts_enqueue(rsq_queue->cni_entry, &pkts[i], 1);
+      if (rsq_queue->cni_entry)
+        rsq_entry_pkts_enqueue(rsq_queue->cni_entry, &pkts[i], 1);
+      else
+        rte_pktmbuf_free(pkts[i]);
     }
   }
   if (matched_pkts_nb)
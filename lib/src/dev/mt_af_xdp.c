@@ -16,6 +16,7 @@
 #include "../mt_socket.h"
 #include "../mt_stat.h"
 #include "../mt_util.h"
+#include "../../manager/mtl_xdp_meta.h"
 
 #ifndef XDP_UMEM_UNALIGNED_CHUNK_FLAG
 #error "Please use XDP lib version with XDP_UMEM_UNALIGNED_CHUNK_FLAG support"
@@ -23,6 +24,10 @@
 
 #define XDP_F_ZERO_COPY (MTL_BIT32(0))
 #define XDP_F_RATE_LIMIT (MTL_BIT32(1))
+/* launch time by the xdp tx metadata */
+#define XDP_F_LAUNCH_TIME (MTL_BIT32(2))
+/* software emulated launch time, hold the pkt until the target ptp time */
+#define XDP_F_LAUNCH_TIME_EMULATE (MTL_BIT32(3))
 
 struct mt_xdp_queue {
   enum mtl_port port;
@@ -61,12 +66,16 @@ struct mt_xdp_queue {
   uint64_t stat_tx_mbuf_alloc_fail;
   uint64_t stat_tx_prod_reserve_fail;
   uint64_t stat_tx_prod_full;
+  uint64_t stat_tx_launch_time;
+  uint64_t stat_tx_launch_time_wait;
 
   uint64_t stat_rx_pkts;
   uint64_t stat_rx_bytes;
   uint64_t stat_rx_burst;
   uint64_t stat_rx_mbuf_alloc_fail;
   uint64_t stat_rx_prod_reserve_fail;
+  uint64_t stat_rx_hw_timestamp;
+  uint64_t stat_rx_tai_timestamp;
 
   uint32_t stat_rx_pkt_invalid;
   uint32_t stat_rx_pkt_err_udp_port;
@@ -117,6 +126,12 @@ static int xdp_queue_tx_stat(struct mt_xdp_queue* xq) {
     notice("%s(%d,%u), pkts copy %" PRIu64 "\n", __func__, port, q, xq->stat_tx_copy);
     xq->stat_tx_copy = 0;
   }
+  if (xq->stat_tx_launch_time || xq->stat_tx_launch_time_wait) {
+    notice("%s(%d,%u), launch time pkts %" PRIu64 " wait %" PRIu64 "\n", __func__, port,
+           q, xq->stat_tx_launch_time, xq->stat_tx_launch_time_wait);
+    xq->stat_tx_launch_time = 0;
+    xq->stat_tx_launch_time_wait = 0;
+  }
 
   uint32_t ring_sz = xq->umem_ring_size;
   uint32_t cons_avail = xsk_cons_nb_avail(&xq->tx_cons, ring_sz);
@@ -156,6 +171,12 @@ static int xdp_queue_rx_stat(struct mt_xdp_queue* xq) {
   xq->stat_rx_pkts = 0;
   xq->stat_rx_bytes = 0;
   xq->stat_rx_burst = 0;
+  if (xq->stat_rx_hw_timestamp || xq->stat_rx_tai_timestamp) {
+    notice("%s(%d,%u), rx timestamp from meta hw %" PRIu64 " tai %" PRIu64 "\n", __func__,
+           port, q, xq->stat_rx_hw_timestamp, xq->stat_rx_tai_timestamp);
+    xq->stat_rx_hw_timestamp = 0;
+    xq->stat_rx_tai_timestamp = 0;
+  }
 
   uint32_t ring_sz = xq->umem_ring_size;
   uint32_t cons_avail = xsk_cons_nb_avail(&xq->rx_cons, ring_sz);
@@ -315,8 +336,24 @@ static int xdp_umem_init(struct mt_xdp_priv* xdp, struct mt_xdp_queue* xq) {
   umem_size = mt_mempool_mem_size(pool) + base_addr - aligned_base_addr;
   dbg("%s(%d), base_addr %p umem_size %" PRIu64 "\n", __func__, port, aligned_base_addr,
       umem_size);
-  ret = xsk_umem__create(&xq->umem, aligned_base_addr, umem_size, &xq->rx_prod,
-                         &xq->tx_cons, &cfg);
+#ifdef MTL_HAS_XDP_TX_LAUNCH_TIME
+  if (xdp->flags & XDP_F_LAUNCH_TIME) {
+    /* the metadata sit in the headroom just before the pkt data */
+    cfg.tx_metadata_len = sizeof(struct xsk_tx_metadata);
+    ret = xsk_umem__create(&xq->umem, aligned_base_addr, umem_size, &xq->rx_prod,
+                           &xq->tx_cons, &cfg);
+    if (ret) {
+      warn("%s(%d,%u), umem with tx metadata fail %d, fallback to emulated launch time\n",
+           __func__, port, q, ret);
+      xdp->flags &= ~XDP_F_LAUNCH_TIME;
+      xdp->flags |= XDP_F_LAUNCH_TIME_EMULATE;
+      cfg.tx_metadata_len = 0;
+    }
+  }
+  if (!xq->umem)
+#endif
+    ret = xsk_umem__create(&xq->umem, aligned_base_addr, umem_size, &xq->rx_prod,
+                           &xq->tx_cons, &cfg);
   if (ret) {
     err("%s(%d,%u), umem create fail %d %s\n", __func__, port, q, ret, strerror(errno));
     if (ret == -EPERM)
@@ -540,8 +577,15 @@ static uint16_t xdp_tx(struct mtl_main_impl* impl, struct mt_xdp_queue* xq,
   struct rte_mempool* mbuf_pool = xq->mbuf_pool;
   uint16_t tx = 0;
   struct xsk_ring_prod* pd = &xq->tx_prod;
-  struct mtl_port_status* stats = mt_if(impl, port)->dev_stats_sw;
+  struct mt_interface* inf = mt_if(impl, port);
+  struct mt_xdp_priv* xdp = inf->xdp;
+  struct mtl_port_status* stats = inf->dev_stats_sw;
   uint64_t tx_bytes = 0;
+  uint64_t cur_ptp = 0;
+#ifdef MTL_HAS_XDP_TX_LAUNCH_TIME
+  /* the launch time is in CLOCK_TAI, read the delta once per burst */
+  int64_t tai_delta = 0;
+#endif
 
   xdp_tx_check_free(xq); /* do we need check free threshold for every tx burst */
 
@@ -553,6 +597,19 @@ static uint16_t xdp_tx(struct mtl_main_impl* impl, struct mt_xdp_queue* xq,
 
   for (uint16_t i = 0; i < nb_pkts; i++) {
     struct rte_mbuf* m = tx_pkts[i];
+    uint64_t launch_ptp = mt_mbuf_launch_time(inf, m);
+    if (launch_ptp) {
+      if (!cur_ptp) {
+        cur_ptp = mt_get_ptp_time(impl, port);
+#ifdef MTL_HAS_XDP_TX_LAUNCH_TIME
+        tai_delta = mt_get_tai_time() - cur_ptp;
+#endif
+      }
+      if ((xdp->flags & XDP_F_LAUNCH_TIME_EMULATE) && (launch_ptp > cur_ptp)) {
+        xq->stat_tx_launch_time_wait++;
+        goto exit; /* not reach the target time */
+      }
+    }
     struct rte_mbuf* local = rte_pktmbuf_alloc(mbuf_pool);
     if (!local) {
       dbg("%s(%d, %u), local mbuf alloc fail\n", __func__, port, xq->q);
@@ -577,6 +634,17 @@ static uint16_t xdp_tx(struct mtl_main_impl* impl, struct mt_xdp_queue* xq,
     void* pkt = xsk_umem__get_data(xq->umem_buffer, addr + offset);
     offset = offset << XSK_UNALIGNED_BUF_OFFSET_SHIFT;
     desc->addr = addr | offset;
+    desc->options = 0;
+#ifdef MTL_HAS_XDP_TX_LAUNCH_TIME
+    if (launch_ptp && (xdp->flags & XDP_F_LAUNCH_TIME)) {
+      struct xsk_tx_metadata* meta = (struct xsk_tx_metadata*)pkt - 1;
+      memset(meta, 0, sizeof(*meta));
+      meta->flags = XDP_TXMD_FLAGS_LAUNCH_TIME;
+      meta->request.launch_time = launch_ptp + tai_delta;
+      desc->options |= XDP_TX_METADATA;
+      xq->stat_tx_launch_time++;
+    }
+#endif
 
     struct rte_mbuf* n = m;
     uint16_t nb_segs = m->nb_segs;
@@ -649,6 +717,35 @@ static bool xdp_rx_check_pkt(struct mt_rx_xdp_entry* entry, struct rte_mbuf* pkt
   return true;
 }
 
+/* the rx time of the xdp prog metadata, or the ptp time of this burst if no metadata */
+static inline void xdp_rx_time_stamp(struct mt_rx_xdp_entry* entry, struct rte_mbuf* pkt,
+                                     uint64_t* cur_ptp, int64_t* tai_delta) {
+  struct mtl_main_impl* impl = entry->parent;
+  struct mt_xdp_queue* xq = entry->xq;
+  struct mtl_xdp_rx_meta* meta =
+      rte_pktmbuf_mtod_offset(pkt, struct mtl_xdp_rx_meta*, -(int)sizeof(*meta));
+  uint64_t time_stamp;
+
+  if (!*cur_ptp) *cur_ptp = mt_get_ptp_time(impl, entry->port);
+  time_stamp = *cur_ptp;
+  if (meta->magic == MTL_XDP_RX_META_MAGIC) {
+    bool hw = (meta->flags & MTL_XDP_RX_META_F_HW_TIMESTAMP) ? true : false;
+
+    meta->magic = 0; /* the umem frame is reused */
+    /* the raw phc time is tai only if the phc is synced by ptp4l, use it on request */
+    if (!hw || mt_user_hw_timestamp(impl)) {
+      /* read the tai to ptp delta once for each burst */
+      if (!*tai_delta) *tai_delta = *cur_ptp - mt_get_tai_time();
+      time_stamp = meta->rx_timestamp + *tai_delta;
+      if (hw)
+        xq->stat_rx_hw_timestamp++;
+      else
+        xq->stat_rx_tai_timestamp++;
+    }
+  }
+  *RTE_MBUF_DYNFIELD(pkt, impl->dynfield_offset, rte_mbuf_timestamp_t*) = time_stamp;
+}
+
 static uint16_t xdp_rx(struct mt_rx_xdp_entry* entry, struct rte_mbuf** rx_pkts,
                        uint16_t nb_pkts) {
   struct mt_xdp_queue* xq = entry->xq;
@@ -659,6 +756,9 @@ static uint16_t xdp_rx(struct mt_rx_xdp_entry* entry, struct rte_mbuf** rx_pkts,
   struct mtl_port_status* stats = mt_if(entry->parent, port)->dev_stats_sw;
   uint64_t rx_bytes = 0;
   uint32_t idx = 0;
+  bool sw_timestamp = mt_if_has_sw_timestamp(entry->parent, port);
+  uint64_t cur_ptp = 0;
+  int64_t tai_delta = 0;
   uint32_t rx = xsk_ring_cons__peek(rx_cons, nb_pkts, &idx);
   if (!rx) return 0;
 
@@ -691,6 +791,7 @@ static uint16_t xdp_rx(struct mt_rx_xdp_entry* entry, struct rte_mbuf** rx_pkts,
     rte_pktmbuf_pkt_len(pkt) = len;
     rte_pktmbuf_data_len(pkt) = len;
     if (entry->skip_all_check || xdp_rx_check_pkt(entry, pkt)) {
+      if (sw_timestamp) xdp_rx_time_stamp(entry, pkt, &cur_ptp, &tai_delta);
       rx_pkts[valid_rx] = pkt;
       valid_rx++;
     } else {
@@ -717,6 +818,30 @@ static uint16_t xdp_rx(struct mt_rx_xdp_entry* entry, struct rte_mbuf** rx_pkts,
   return valid_rx;
 }
 
+static void xdp_init_launch_time(struct mt_xdp_priv* xdp) {
+  enum mtl_port port = xdp->port;
+
+  if (mt_user_tx_txtime_emulate(xdp->parent)) {
+    info("%s(%d), software emulated launch time\n", __func__, port);
+    xdp->flags |= XDP_F_LAUNCH_TIME_EMULATE;
+    return;
+  }
+#ifdef MTL_HAS_XDP_TX_LAUNCH_TIME
+  if (!MT_HAS_CLOCK_TAI) {
+    warn("%s(%d), no CLOCK_TAI for the launch time, use software emulated\n", __func__,
+         port);
+    xdp->flags |= XDP_F_LAUNCH_TIME_EMULATE;
+    return;
+  }
+  info("%s(%d), launch time by xdp tx metadata\n", __func__, port);
+  xdp->flags |= XDP_F_LAUNCH_TIME;
+#else
+  warn("%s(%d), no xdp tx metadata launch time in this build, use software emulated\n",
+       __func__, port);
+  xdp->flags |= XDP_F_LAUNCH_TIME_EMULATE;
+#endif
+}
+
 int mt_dev_xdp_init(struct mt_interface* inf) {
   struct mtl_main_impl* impl = inf->parent;
   enum mtl_port port = inf->port;
@@ -745,6 +870,7 @@ int mt_dev_xdp_init(struct mt_interface* inf) {
   mt_pthread_mutex_init(&xdp->queues_lock, NULL);
 
   xdp_parse_drv_name(xdp);
+  if (ST21_TX_PACING_WAY_TSN == inf->tx_pacing_way) xdp_init_launch_time(xdp);
 
   xdp->queues_info = mt_rte_zmalloc_socket(sizeof(*xdp->queues_info) * xdp->queues_cnt,
                                            mt_socket_id(impl, port));
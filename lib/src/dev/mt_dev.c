@@ -11,6 +11,7 @@
 #include "../mt_stat.h"
 #include "../mt_util.h"
 #include "mt_af_xdp.h"
+#include "mt_pcap_replay.h"
 
 static const struct mt_dev_driver_info dev_drvs[] = {
     {
@@ -89,6 +90,14 @@ static const struct mt_dev_driver_info dev_drvs[] = {
         .flags = MT_DRV_F_USE_KERNEL_CTL | MT_DRV_F_RX_POOL_COMMON | MT_DRV_F_RX_NO_FLOW |
                  MT_DRV_F_KERNEL_BASED | MT_DRV_F_MCAST_IN_DP,
     },
+    {
+        /* shared memory virtual port, arp handled by cni, no flow and no rss */
+        .name = "net_memif",
+        .port_type = MT_PORT_DPDK_MEMIF,
+        .drv_type = MT_DRV_DPDK_MEMIF,
+        .flow_type = MT_FLOW_ALL,
+        .flags = MT_DRV_F_RX_POOL_COMMON | MT_DRV_F_RX_NO_FLOW,
+    },
     {
         .name = "kernel_socket",
         .port_type = MT_PORT_KERNEL_SOCKET,
@@ -104,6 +113,15 @@ static const struct mt_dev_driver_info dev_drvs[] = {
         .flow_type = MT_FLOW_ALL,
         .flags = MT_DRV_F_NOT_DPDK_PMD | MT_DRV_F_NO_CNI | MT_DRV_F_USE_KERNEL_CTL |
                  MT_DRV_F_RX_POOL_COMMON | MT_DRV_F_MCAST_IN_DP | MT_DRV_F_KERNEL_BASED,
+    },
+    {
+        /* rx only virtual port, the packets are read from a capture file */
+        .name = "pcap_replay",
+        .port_type = MT_PORT_PCAP_REPLAY,
+        .drv_type = MT_DRV_PCAP_REPLAY,
+        .flow_type = MT_FLOW_ALL,
+        .flags = MT_DRV_F_NOT_DPDK_PMD | MT_DRV_F_NO_CNI | MT_DRV_F_RX_POOL_COMMON |
+                 MT_DRV_F_RX_NO_FLOW | MT_DRV_F_MCAST_IN_DP | MT_DRV_F_NO_SYS_TX_QUEUE,
     }};
 
 static int parse_driver_info(const char* driver, struct mt_dev_driver_info* drv_info) {
@@ -314,6 +332,8 @@ static int dev_eal_init(struct mtl_init_params* p, struct mt_kport_info* kport_i
   static bool eal_initted = false; /* eal cann't re-enter in one process */
   bool has_afxdp = false;
   bool has_afpkt = false;
+  bool has_memif = false;
+  bool memif_zc = false;
   char port_params[MTL_PORT_MAX][2 * MTL_PORT_MAX_LEN];
   char* port_param;
   int pci_ports = 0;
@@ -348,12 +368,19 @@ static int dev_eal_init(struct mtl_init_params* p, struct mt_kport_info* kport_i
       snprintf(kport_info->dpdk_port[i], MTL_PORT_MAX_LEN, "native_af_xdp_%d", i);
       snprintf(kport_info->kernel_if[i], MTL_PORT_MAX_LEN, "%s", if_name);
       continue;
+    } else if (pmd == MTL_PMD_PCAP_REPLAY) {
+      /* no dpdk device and no kernel if for the replay port */
+      snprintf(kport_info->dpdk_port[i], MTL_PORT_MAX_LEN, "pcap_replay_%d", i);
+      continue;
     } else if (pmd == MTL_PMD_DPDK_AF_XDP) {
       argv[argc] = "--vdev";
       has_afxdp = true;
     } else if (pmd == MTL_PMD_DPDK_AF_PACKET) {
       argv[argc] = "--vdev";
       has_afpkt = true;
+    } else if (pmd == MTL_PMD_DPDK_MEMIF) {
+      argv[argc] = "--vdev";
+      has_memif = true;
     } else if (pmd == MTL_PMD_DPDK_USER) {
       argv[argc] = "-a";
       pci_ports++;
@@ -384,6 +411,14 @@ static int dev_eal_init(struct mtl_init_params* p, struct mt_kport_info* kport_i
       /* save kport info */
       snprintf(kport_info->dpdk_port[i], MTL_PORT_MAX_LEN, "eth_af_packet%d", i);
       snprintf(kport_info->kernel_if[i], MTL_PORT_MAX_LEN, "%s", if_name);
+    } else if (p->pmd[i] == MTL_PMD_DPDK_MEMIF) {
+      const char* memif_args = mt_dpdk_memif_port2args(p->port[i]);
+      if (!memif_args) return -EINVAL;
+      snprintf(port_param, 2 * MTL_PORT_MAX_LEN, "net_memif%d,%s", i, memif_args);
+      /* the zero copy client maps the hugepage memory as the memif regions */
+      if (strstr(memif_args, "zero-copy=yes")) memif_zc = true;
+      /* save kport info, no kernel if for memif */
+      snprintf(kport_info->dpdk_port[i], MTL_PORT_MAX_LEN, "net_memif%d", i);
     } else {
       snprintf(port_param, 2 * MTL_PORT_MAX_LEN, "%s", p->port[i]);
     }
@@ -436,6 +471,11 @@ static int dev_eal_init(struct mtl_init_params* p, struct mt_kport_info* kport_i
     argc++;
   }
 
+  if (memif_zc) {
+    argv[argc] = "--single-file-segments";
+    argc++;
+  }
+
   if (p->iova_mode > MTL_IOVA_MODE_AUTO && p->iova_mode < MTL_IOVA_MODE_MAX) {
     argv[argc] = "--iova-mode";
     argc++;
@@ -457,6 +497,8 @@ static int dev_eal_init(struct mtl_init_params* p, struct mt_kport_info* kport_i
       argv[argc] = "pmd.net.af_xdp,info";
     else if (has_afpkt)
       argv[argc] = "pmd.net.af_packet,info";
+    else if (has_memif)
+      argv[argc] = "pmd.net.memif,info";
     else
       argv[argc] = "info";
   } else if (p->log_level == MTL_LOG_LEVEL_NOTICE) {
@@ -1486,6 +1528,13 @@ static int dev_if_init_pacing(struct mt_interface* inf) {
       err("%s(%d), this port not support tsn launch time\n", __func__, port);
       return -EINVAL;
     }
+    if (inf->drv_info.flags & MT_DRV_F_NOT_DPDK_PMD) {
+      /* the kernel compare the launch time against CLOCK_TAI, not the phc */
+      info("%s(%d), kernel launch time, system clock should be ptp synced(phc2sys)%s\n",
+           __func__, port,
+           mt_user_tx_txtime_emulate(inf->parent) ? ", software emulated" : "");
+      return 0;
+    }
     /* tsn launch time is compared against the phc, the packet timestamp must be
      * phc-synced: only the built-in ptp service disciplines the phc when PF is used
      */
@@ -2149,6 +2198,9 @@ int mt_dev_if_uinit(struct mtl_main_impl* impl) {
     if (mt_pmd_is_native_af_xdp(impl, i)) {
       mt_dev_xdp_uinit(inf);
     }
+    if (mt_pmd_is_pcap_replay(impl, i)) {
+      mt_dev_pcap_replay_uinit(inf);
+    }
 
     if (inf->pad) {
       rte_pktmbuf_free(inf->pad);
@@ -2176,6 +2228,7 @@ int mt_dev_if_uinit(struct mtl_main_impl* impl) {
     mt_pthread_mutex_destroy(&inf->tx_queues_mutex);
     mt_pthread_mutex_destroy(&inf->rx_queues_mutex);
     mt_pthread_mutex_destroy(&inf->vf_cmd_mutex);
+    mt_pthread_mutex_destroy(&inf->hwtstamp_mutex);
 
     dev_close_port(inf);
   }
@@ -2201,11 +2254,14 @@ int mt_dev_if_init(struct mtl_main_impl* impl) {
     if (mt_pmd_is_kernel_socket(impl, i) || mt_pmd_is_native_af_xdp(impl, i)) {
       port = impl->kport_info.kernel_if[i];
       port_id = i;
+    } else if (mt_pmd_is_pcap_replay(impl, i)) {
+      port = impl->kport_info.dpdk_port[i];
+      port_id = i;
     } else {
-      if (mt_pmd_is_kernel_based(impl, i))
-        port = impl->kport_info.dpdk_port[i];
-      else
+      if (mt_pmd_is_dpdk_user(impl, i))
         port = p->port[i];
+      else
+        port = impl->kport_info.dpdk_port[i];
       ret = rte_eth_dev_get_port_by_name(port, &port_id);
       if (ret < 0) {
         err("%s, failed to get port for %s\n", __func__, port);
@@ -2227,6 +2283,8 @@ int mt_dev_if_init(struct mtl_main_impl* impl) {
       ret = parse_driver_info("kernel_socket", &inf->drv_info);
     else if (mt_pmd_is_native_af_xdp(impl, i))
       ret = parse_driver_info("native_af_xdp", &inf->drv_info);
+    else if (mt_pmd_is_pcap_replay(impl, i))
+      ret = parse_driver_info("pcap_replay", &inf->drv_info);
     else
       ret = parse_driver_info(dev_info->driver_name, &inf->drv_info);
     if (ret < 0) {
@@ -2239,6 +2297,7 @@ int mt_dev_if_init(struct mtl_main_impl* impl) {
     mt_pthread_mutex_init(&inf->tx_queues_mutex, NULL);
     mt_pthread_mutex_init(&inf->rx_queues_mutex, NULL);
     mt_pthread_mutex_init(&inf->vf_cmd_mutex, NULL);
+    mt_pthread_mutex_init(&inf->hwtstamp_mutex, NULL);
     rte_spinlock_init(&inf->stats_lock);
 
     if (mt_user_ptp_tsc_source(impl)) {
@@ -2276,6 +2335,19 @@ int mt_dev_if_init(struct mtl_main_impl* impl) {
       inf->nb_rx_q = 1;
       p->flags |= MTL_FLAG_SHARED_RX_QUEUE;
       inf->system_rx_queues_end = 0;
+    } else if (mt_pmd_is_dpdk_memif(impl, i)) {
+      inf->nb_tx_q = p->tx_queues_cnt[i];
+      inf->nb_tx_q++; /* arp, mcast, ptp use shared sys queue */
+      /* no flow and no rss on memif, dispatch all rx packets by the shared queue */
+      inf->nb_rx_q = 1;
+      p->flags |= MTL_FLAG_SHARED_RX_QUEUE;
+      inf->system_rx_queues_end = 0;
+    } else if (mt_pmd_is_pcap_replay(impl, i)) {
+      /* rx only, all packets from the file are dispatched by the shared queue */
+      inf->nb_tx_q = 0;
+      inf->nb_rx_q = 1;
+      p->flags |= MTL_FLAG_SHARED_RX_QUEUE;
+      inf->system_rx_queues_end = 0;
     } else if (mt_pmd_is_dpdk_af_xdp(impl, i)) {
       /* no system queues as no cni */
       inf->nb_tx_q = queue_pair_cnt;
@@ -2351,8 +2423,12 @@ int mt_dev_if_init(struct mtl_main_impl* impl) {
 #endif
 
 #if RTE_VERSION >= RTE_VERSION_NUM(23, 3, 0, 0)
-    /* Detect LaunchTime capability */
-    if (dev_info->tx_offload_capa & RTE_ETH_TX_OFFLOAD_SEND_ON_TIMESTAMP &&
+    /*
+     * Detect LaunchTime capability, the kernel based data path(SO_TXTIME for socket,
+     * tx metadata for native af_xdp) carry the same dynfield to the backend.
+     */
+    if (((dev_info->tx_offload_capa & RTE_ETH_TX_OFFLOAD_SEND_ON_TIMESTAMP) ||
+         (inf->drv_info.flags & MT_DRV_F_NOT_DPDK_PMD)) &&
         ST21_TX_PACING_WAY_TSN == inf->tx_pacing_way) {
       inf->feature |= MT_IF_FEATURE_TX_OFFLOAD_SEND_ON_TIMESTAMP;
 
@@ -2402,6 +2478,20 @@ int mt_dev_if_init(struct mtl_main_impl* impl) {
       inf->feature |= MT_IF_FEATURE_RX_OFFLOAD_TIMESTAMP;
     }
 
+#ifndef WINDOWSENV
+    /* the kernel based rx fill the arrival time from the kernel or the xdp metadata */
+    if (mt_pmd_is_kernel_socket(impl, i) || mt_pmd_is_native_af_xdp(impl, i)) {
+      if (!impl->dynfield_offset) {
+        ret = rte_mbuf_dyn_rx_timestamp_register(&impl->dynfield_offset, NULL);
+        if (ret < 0) {
+          err("%s, rte_mbuf_dyn_rx_timestamp_register fail\n", __func__);
+          return ret;
+        }
+      }
+      inf->feature |= MT_IF_FEATURE_RX_SW_TIMESTAMP;
+    }
+#endif
+
 #ifdef RTE_ETH_RX_OFFLOAD_BUFFER_SPLIT
     if (dev_info->rx_queue_offload_capa & RTE_ETH_RX_OFFLOAD_BUFFER_SPLIT) {
       inf->feature |= MT_IF_FEATURE_RXQ_OFFLOAD_BUFFER_SPLIT;
@@ -2478,7 +2568,8 @@ int mt_dev_if_init(struct mtl_main_impl* impl) {
       return -ENOMEM;
     }
 
-    if (inf->drv_info.flags & MT_DRV_F_NOT_DPDK_PMD) {
+    if ((inf->drv_info.flags & MT_DRV_F_NOT_DPDK_PMD) &&
+        !mt_pmd_is_pcap_replay(impl, i)) {
       /* get mac */
       mt_socket_get_if_mac(mt_kernel_if_name(impl, i), &inf->k_mac_addr);
     }
@@ -2491,6 +2582,14 @@ int mt_dev_if_init(struct mtl_main_impl* impl) {
         return -ENOMEM;
       }
     }
+    if (mt_pmd_is_pcap_replay(impl, i)) {
+      ret = mt_dev_pcap_replay_init(inf);
+      if (ret < 0) {
+        err("%s(%d), pcap replay dev init fail %d\n", __func__, i, ret);
+        mt_dev_if_uinit(impl);
+        return ret;
+      }
+    }
 
     info("%s(%d), port_id %d port_type %d drv_type %d\n", __func__, i, port_id,
          inf->drv_info.port_type, inf->drv_info.drv_type);
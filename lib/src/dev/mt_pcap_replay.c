@@ -0,0 +1,590 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include "mt_pcap_replay.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "../mt_log.h"
+#include "../mt_stat.h"
+#include "../mt_util.h"
+
+#define MT_PCAP_MAGIC_US (0xa1b2c3d4)
+#define MT_PCAP_MAGIC_NS (0xa1b23c4d)
+#define MT_PCAP_HDR_LEN (24)
+#define MT_PCAP_REC_HDR_LEN (16)
+
+#define MT_PCAPNG_BT_SHB (0x0a0d0d0a)
+#define MT_PCAPNG_BT_IDB (0x00000001)
+#define MT_PCAPNG_BT_SPB (0x00000003)
+#define MT_PCAPNG_BT_EPB (0x00000006)
+#define MT_PCAPNG_BOM (0x1a2b3c4d)
+#define MT_PCAPNG_OPT_END (0)
+#define MT_PCAPNG_OPT_IF_TSRESOL (9)
+/* the default if_tsresol is 10^-6 */
+#define MT_PCAPNG_TSRESOL_DEFAULT (1000 * 1000)
+#define MT_PCAPNG_MAX_IF (16)
+
+#define MT_PCAP_LINKTYPE_ETHERNET (1)
+
+/* a packet due more than this is counted as late */
+#define MT_PCAP_REPLAY_LATE_NS (1000 * 1000)
+
+struct mt_pcap_replay_if {
+  uint16_t linktype;
+  uint64_t units_per_s; /* the timestamp units per second */
+};
+
+struct mt_pcap_replay_rec {
+  const uint8_t* pkt;
+  uint32_t len;
+  uint64_t ts_ns;
+  size_t next; /* the offset of the next record */
+};
+
+struct mt_pcap_replay_impl {
+  struct mtl_main_impl* parent;
+  enum mtl_port port;
+  const char* file;
+
+  int fd;
+  uint8_t* map;
+  size_t map_size;
+
+  bool pcapng;
+  bool swap; /* the file byte order differ with the host */
+  size_t first_rec;
+  size_t offset;
+  /* for classic pcap */
+  uint16_t linktype;
+  uint64_t units_per_s;
+  /* for pcapng, the interfaces in current section */
+  struct mt_pcap_replay_if ifs[MT_PCAPNG_MAX_IF];
+  uint32_t nb_ifs;
+  uint64_t last_ts_ns; /* for the spb which has no timestamp */
+
+  enum mtl_pcap_replay_mode mode;
+  double speed;
+  bool loop;
+  struct rte_mempool* mbuf_pool;
+
+  /* the replay timeline */
+  bool started;
+  bool eof;
+  uint64_t start_tsc;
+  bool has_first_ts;
+  uint64_t first_ts_ns;
+  uint64_t last_pkt_ts_ns;
+  uint64_t loop_offset_ns;
+  uint64_t loop_pkts;
+
+  /* stat */
+  uint64_t stat_pkts;
+  uint64_t stat_bytes;
+  uint32_t stat_late;
+  uint32_t stat_oversize;
+  uint32_t stat_nombuf;
+  uint32_t stat_unsupported;
+  uint32_t stat_loops;
+};
+
+static inline uint16_t replay_u16(struct mt_pcap_replay_impl* replay, const uint8_t* p) {
+  uint16_t v;
+  memcpy(&v, p, sizeof(v));
+  return replay->swap ? rte_bswap16(v) : v;
+}
+
+static inline uint32_t replay_u32(struct mt_pcap_replay_impl* replay, const uint8_t* p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return replay->swap ? rte_bswap32(v) : v;
+}
+
+static inline uint64_t replay_ts_ns(uint64_t ts, uint64_t units_per_s) {
+  /* split to avoid the overflow of ts * NS_PER_S */
+  return (ts / units_per_s) * NS_PER_S + (ts % units_per_s) * NS_PER_S / units_per_s;
+}
+
+static int replay_parse_pcap_hdr(struct mt_pcap_replay_impl* replay) {
+  enum mtl_port port = replay->port;
+  uint32_t magic;
+
+  if (replay->map_size < MT_PCAP_HDR_LEN) {
+    err("%s(%d), file too short %" PRIu64 "\n", __func__, port,
+        (uint64_t)replay->map_size);
+    return -EINVAL;
+  }
+
+  memcpy(&magic, replay->map, sizeof(magic));
+  if (magic == MT_PCAP_MAGIC_US || magic == MT_PCAP_MAGIC_NS) {
+    replay->swap = false;
+  } else if (rte_bswap32(magic) == MT_PCAP_MAGIC_US ||
+             rte_bswap32(magic) == MT_PCAP_MAGIC_NS) {
+    replay->swap = true;
+    magic = rte_bswap32(magic);
+  } else {
+    return -EINVAL;
+  }
+
+  replay->pcapng = false;
+  replay->units_per_s = (magic == MT_PCAP_MAGIC_NS) ? NS_PER_S : US_PER_S;
+  replay->linktype = replay_u32(replay, replay->map + 20) & 0xffff;
+  replay->first_rec = MT_PCAP_HDR_LEN;
+  if (replay->linktype != MT_PCAP_LINKTYPE_ETHERNET) {
+    err("%s(%d), unsupported linktype %u\n", __func__, port, replay->linktype);
+    return -ENOTSUP;
+  }
+  info("%s(%d), pcap %s timestamp%s\n", __func__, port,
+       (magic == MT_PCAP_MAGIC_NS) ? "ns" : "us", replay->swap ? ", swapped" : "");
+  return 0;
+}
+
+static int replay_parse_pcapng_shb(struct mt_pcap_replay_impl* replay, size_t offset) {
+  uint32_t bom;
+
+  if (offset + 12 > replay->map_size) return -EINVAL;
+  memcpy(&bom, replay->map + offset + 8, sizeof(bom));
+  if (bom == MT_PCAPNG_BOM)
+    replay->swap = false;
+  else if (rte_bswap32(bom) == MT_PCAPNG_BOM)
+    replay->swap = true;
+  else
+    return -EINVAL;
+
+  /* a new section, the interfaces of previous section are gone */
+  replay->nb_ifs = 0;
+  return 0;
+}
+
+static int replay_parse_pcapng_idb(struct mt_pcap_replay_impl* replay,
+                                   const uint8_t* body, uint32_t body_len) {
+  struct mt_pcap_replay_if* inf;
+
+  if (body_len < 8) return -EINVAL;
+  if (replay->nb_ifs >= MT_PCAPNG_MAX_IF) {
+    err("%s(%d), too many interfaces\n", __func__, replay->port);
+    return -ENOTSUP;
+  }
+
+  inf = &replay->ifs[replay->nb_ifs];
+  inf->linktype = replay_u16(replay, body);
+  inf->units_per_s = MT_PCAPNG_TSRESOL_DEFAULT;
+
+  /* options */
+  uint32_t off = 8;
+  while (off + 4 <= body_len) {
+    uint16_t code = replay_u16(replay, body + off);
+    uint16_t len = replay_u16(replay, body + off + 2);
+    off += 4;
+    if (code == MT_PCAPNG_OPT_END) break;
+    if (off + len > body_len) return -EINVAL;
+    if (code == MT_PCAPNG_OPT_IF_TSRESOL && len >= 1) {
+      uint8_t resol = body[off];
+      uint8_t exp = resol & 0x7f;
+      uint64_t units = 1;
+
+      if (resol & 0x80) { /* power of 2 */
+        if (exp > 63) return -ENOTSUP;
+        units = 1ULL << exp;
+      } else { /* power of 10 */
+        if (exp > 19) return -ENOTSUP;
+        for (uint8_t i = 0; i < exp; i++) units *= 10;
+      }
+      inf->units_per_s = units;
+    }
+    off += RTE_ALIGN_CEIL(len, 4);
+  }
+
+  dbg("%s(%d), if %u linktype %u units_per_s %" PRIu64 "\n", __func__, replay->port,
+      replay->nb_ifs, inf->linktype, inf->units_per_s);
+  replay->nb_ifs++;
+  return 0;
+}
+
+static int replay_parse_pcapng_hdr(struct mt_pcap_replay_impl* replay) {
+  uint32_t type;
+  int ret;
+
+  if (replay->map_size < 28) return -EINVAL;
+  memcpy(&type, replay->map, sizeof(type));
+  if (type != MT_PCAPNG_BT_SHB) return -EINVAL;
+
+  ret = replay_parse_pcapng_shb(replay, 0);
+  if (ret < 0) return ret;
+
+  replay->pcapng = true;
+  /* start from the shb, the blocks are parsed on the fly */
+  replay->first_rec = 0;
+  info("%s(%d), pcapng%s\n", __func__, replay->port, replay->swap ? ", swapped" : "");
+  return 0;
+}
+
+/* get the packet at current offset without consume it */
+static int replay_peek_pcap(struct mt_pcap_replay_impl* replay,
+                            struct mt_pcap_replay_rec* rec) {
+  size_t offset = replay->offset;
+  const uint8_t* hdr;
+
+  if (offset + MT_PCAP_REC_HDR_LEN > replay->map_size) return -ENODATA;
+  hdr = replay->map + offset;
+  uint32_t ts_sec = replay_u32(replay, hdr);
+  uint32_t ts_frac = replay_u32(replay, hdr + 4);
+  uint32_t incl_len = replay_u32(replay, hdr + 8);
+
+  if (offset + MT_PCAP_REC_HDR_LEN + incl_len > replay->map_size) {
+    warn("%s(%d), truncated record at %" PRIu64 "\n", __func__, replay->port,
+         (uint64_t)offset);
+    return -ENODATA;
+  }
+
+  rec->pkt = hdr + MT_PCAP_REC_HDR_LEN;
+  rec->len = incl_len;
+  rec->ts_ns = (uint64_t)ts_sec * NS_PER_S +
+               (uint64_t)ts_frac * (NS_PER_S / replay->units_per_s);
+  rec->next = offset + MT_PCAP_REC_HDR_LEN + incl_len;
+  return 0;
+}
+
+static int replay_peek_pcapng(struct mt_pcap_replay_impl* replay,
+                              struct mt_pcap_replay_rec* rec) {
+  enum mtl_port port = replay->port;
+  int ret;
+
+  /* skip the non packet blocks until a packet */
+  while (replay->offset + 12 <= replay->map_size) {
+    size_t offset = replay->offset;
+    const uint8_t* blk = replay->map + offset;
+    uint32_t type;
+
+    memcpy(&type, blk, sizeof(type)); /* the shb type is byte order independent */
+    if (type == MT_PCAPNG_BT_SHB) {
+      ret = replay_parse_pcapng_shb(replay, offset);
+      if (ret < 0) {
+        err("%s(%d), invalid shb at %" PRIu64 "\n", __func__, port, (uint64_t)offset);
+        return ret;
+      }
+    } else {
+      type = replay_u32(replay, blk);
+    }
+
+    uint32_t blk_len = replay_u32(replay, blk + 4);
+    if (blk_len < 12 || (blk_len % 4) || offset + blk_len > replay->map_size) {
+      warn("%s(%d), invalid block len %u at %" PRIu64 "\n", __func__, port, blk_len,
+           (uint64_t)offset);
+      return -ENODATA;
+    }
+    const uint8_t* body = blk + 8;
+    uint32_t body_len = blk_len - 12;
+
+    if (type == MT_PCAPNG_BT_IDB) {
+      ret = replay_parse_pcapng_idb(replay, body, body_len);
+      if (ret < 0) return ret;
+    } else if (type == MT_PCAPNG_BT_EPB && body_len >= 20) {
+      uint32_t if_id = replay_u32(replay, body);
+      uint64_t ts = ((uint64_t)replay_u32(replay, body + 4) << 32) |
+                    replay_u32(replay, body + 8);
+      uint32_t cap_len = replay_u32(replay, body + 12);
+
+      if (if_id >= replay->nb_ifs || cap_len > body_len - 20) {
+        warn("%s(%d), invalid epb at %" PRIu64 "\n", __func__, port, (uint64_t)offset);
+        return -EIO;
+      }
+      struct mt_pcap_replay_if* inf = &replay->ifs[if_id];
+      rec->ts_ns = replay_ts_ns(ts, inf->units_per_s);
+      replay->last_ts_ns = rec->ts_ns;
+      if (inf->linktype == MT_PCAP_LINKTYPE_ETHERNET) {
+        rec->pkt = body + 20;
+        rec->len = cap_len;
+        rec->next = offset + blk_len;
+        return 0;
+      }
+      replay->stat_unsupported++;
+    } else if (type == MT_PCAPNG_BT_SPB && body_len >= 4) {
+      uint32_t orig_len = replay_u32(replay, body);
+
+      if (replay->nb_ifs && replay->ifs[0].linktype == MT_PCAP_LINKTYPE_ETHERNET) {
+        /* no timestamp in spb, use the last one */
+        rec->ts_ns = replay->last_ts_ns;
+        rec->pkt = body + 4;
+        rec->len = RTE_MIN(orig_len, body_len - 4);
+        rec->next = offset + blk_len;
+        return 0;
+      }
+      replay->stat_unsupported++;
+    }
+    /* not a packet, skip this block */
+    replay->offset = offset + blk_len;
+  }
+
+  return -ENODATA;
+}
+
+static inline int replay_peek(struct mt_pcap_replay_impl* replay,
+                              struct mt_pcap_replay_rec* rec) {
+  if (replay->pcapng)
+    return replay_peek_pcapng(replay, rec);
+  else
+    return replay_peek_pcap(replay, rec);
+}
+
+static int replay_rewind(struct mt_pcap_replay_impl* replay) {
+  uint64_t duration = replay->last_pkt_ts_ns - replay->first_ts_ns;
+  uint64_t gap;
+
+  if (!replay->loop_pkts) {
+    warn("%s(%d), no packet in %s\n", __func__, replay->port, replay->file);
+    return -ENODATA;
+  }
+
+  /* keep the timeline monotonic, the next loop start after an average packet gap */
+  if (replay->loop_pkts > 1)
+    gap = duration / (replay->loop_pkts - 1);
+  else
+    gap = NS_PER_MS;
+  replay->loop_offset_ns += duration + gap;
+  replay->loop_pkts = 0;
+  replay->offset = replay->first_rec;
+  replay->stat_loops++;
+  dbg("%s(%d), loop offset %" PRIu64 "\n", __func__, replay->port,
+      replay->loop_offset_ns);
+  return 0;
+}
+
+uint16_t mt_pcap_replay_rx_burst(struct mt_pcap_replay_impl* replay,
+                                 struct rte_mbuf** rx_pkts, const uint16_t nb_pkts) {
+  struct mtl_main_impl* impl = replay->parent;
+  struct mt_interface* inf = mt_if(impl, replay->port);
+  struct mtl_port_status* stats = inf->dev_stats_sw;
+  struct mt_pcap_replay_rec rec;
+  uint64_t rx_bytes = 0;
+  uint16_t rx = 0;
+  uint32_t nombuf = 0;
+  int ret;
+
+  if (replay->eof) return 0;
+
+  uint64_t now = mt_get_tsc(impl);
+  if (!replay->started) {
+    replay->start_tsc = now;
+    replay->started = true;
+  }
+
+  while (rx < nb_pkts) {
+    ret = replay_peek(replay, &rec);
+    if (ret < 0) {
+      if (ret == -ENODATA && replay->loop && replay_rewind(replay) >= 0) continue;
+      info("%s(%d), end of %s, %" PRIu64 " pkts replayed\n", __func__, replay->port,
+           replay->file, replay->stat_pkts + rx);
+      replay->eof = true;
+      break;
+    }
+
+    if (!replay->has_first_ts) {
+      replay->first_ts_ns = rec.ts_ns;
+      replay->has_first_ts = true;
+    }
+    uint64_t rel_ns = replay->loop_offset_ns;
+    if (rec.ts_ns > replay->first_ts_ns) rel_ns += rec.ts_ns - replay->first_ts_ns;
+
+    if (replay->mode != MTL_PCAP_REPLAY_AFAP) {
+      uint64_t due = replay->start_tsc + (uint64_t)(rel_ns / replay->speed);
+      if (now < due) break; /* not the time */
+      if ((now - due) > MT_PCAP_REPLAY_LATE_NS) replay->stat_late++;
+    }
+
+    struct rte_mbuf* m = rte_pktmbuf_alloc(replay->mbuf_pool);
+    if (!m) {
+      replay->stat_nombuf++;
+      nombuf++;
+      break; /* retry at next burst */
+    }
+    if (rec.len > rte_pktmbuf_tailroom(m)) {
+      rte_pktmbuf_free(m);
+      replay->stat_oversize++;
+      goto next;
+    }
+    /* warm the next record as the file is read sequentially */
+    rte_prefetch0(rec.pkt + rec.len);
+    rte_memcpy(rte_pktmbuf_mtod(m, void*), rec.pkt, rec.len);
+    m->data_len = rec.len;
+    m->pkt_len = rec.len;
+    /* the capture time in ptp domain, shift by loops to keep it monotonic */
+    *RTE_MBUF_DYNFIELD(m, impl->dynfield_offset, rte_mbuf_timestamp_t*) =
+        rec.ts_ns + replay->loop_offset_ns;
+    rx_pkts[rx++] = m;
+    rx_bytes += rec.len;
+
+  next:
+    replay->last_pkt_ts_ns = rec.ts_ns;
+    replay->loop_pkts++;
+    replay->offset = rec.next;
+  }
+
+  replay->stat_pkts += rx;
+  replay->stat_bytes += rx_bytes;
+  if (stats) {
+    stats->rx_packets += rx;
+    stats->rx_bytes += rx_bytes;
+    stats->rx_nombuf_packets += nombuf;
+  }
+  return rx;
+}
+
+static int replay_stat_dump(void* priv) {
+  struct mt_pcap_replay_impl* replay = priv;
+  enum mtl_port port = replay->port;
+
+  notice("%s(%d), pkts %" PRIu64 " bytes %" PRIu64 " loops %u%s\n", __func__, port,
+         replay->stat_pkts, replay->stat_bytes, replay->stat_loops,
+         replay->eof ? ", eof" : "");
+  if (replay->stat_late) {
+    warn("%s(%d), late %u pkts\n", __func__, port, replay->stat_late);
+    replay->stat_late = 0;
+  }
+  if (replay->stat_oversize) {
+    warn("%s(%d), oversize %u pkts\n", __func__, port, replay->stat_oversize);
+    replay->stat_oversize = 0;
+  }
+  if (replay->stat_nombuf) {
+    warn("%s(%d), nombuf %u\n", __func__, port, replay->stat_nombuf);
+    replay->stat_nombuf = 0;
+  }
+  if (replay->stat_unsupported) {
+    warn("%s(%d), unsupported linktype %u pkts\n", __func__, port,
+         replay->stat_unsupported);
+    replay->stat_unsupported = 0;
+  }
+  return 0;
+}
+
+static int replay_free(struct mt_pcap_replay_impl* replay) {
+  if (replay->map) {
+    munmap(replay->map, replay->map_size);
+    replay->map = NULL;
+  }
+  if (replay->fd >= 0) {
+    close(replay->fd);
+    replay->fd = -1;
+  }
+  mt_rte_free(replay);
+  return 0;
+}
+
+static int replay_open(struct mt_pcap_replay_impl* replay) {
+  enum mtl_port port = replay->port;
+  struct stat st;
+  int ret;
+
+  replay->fd = open(replay->file, O_RDONLY);
+  if (replay->fd < 0) {
+    err("%s(%d), open %s fail\n", __func__, port, replay->file);
+    return -EIO;
+  }
+  if (fstat(replay->fd, &st) < 0 || st.st_size <= 0) {
+    err("%s(%d), empty or invalid file %s\n", __func__, port, replay->file);
+    return -EIO;
+  }
+  replay->map_size = st.st_size;
+  replay->map = mmap(NULL, replay->map_size, PROT_READ, MAP_PRIVATE, replay->fd, 0);
+  if (replay->map == MAP_FAILED) {
+    replay->map = NULL;
+    err("%s(%d), mmap %s fail\n", __func__, port, replay->file);
+    return -EIO;
+  }
+  /* the file is read once from begin to end for each loop */
+  madvise(replay->map, replay->map_size, MADV_SEQUENTIAL);
+  madvise(replay->map, replay->map_size, MADV_WILLNEED);
+
+  ret = replay_parse_pcap_hdr(replay);
+  if (ret == -EINVAL) ret = replay_parse_pcapng_hdr(replay);
+  if (ret < 0) {
+    err("%s(%d), %s is not a supported pcap/pcapng file\n", __func__, port,
+        replay->file);
+    return ret;
+  }
+  replay->offset = replay->first_rec;
+
+  return 0;
+}
+
+int mt_dev_pcap_replay_init(struct mt_interface* inf) {
+  struct mtl_main_impl* impl = inf->parent;
+  enum mtl_port port = inf->port;
+  struct mtl_init_params* p = mt_get_user_params(impl);
+  struct mtl_port_init_params* port_params = &p->port_params[port];
+  int ret;
+
+  if (!mt_pmd_is_pcap_replay(impl, port)) {
+    err("%s(%d), not pcap replay\n", __func__, port);
+    return -EIO;
+  }
+
+  struct mt_pcap_replay_impl* replay =
+      mt_rte_zmalloc_socket(sizeof(*replay), mt_socket_id(impl, port));
+  if (!replay) {
+    err("%s(%d), replay malloc fail\n", __func__, port);
+    return -ENOMEM;
+  }
+  replay->parent = impl;
+  replay->port = port;
+  replay->fd = -1;
+  replay->file = mt_pcap_replay_port2file(p->port[port]);
+  replay->mode = port_params->pcap_replay_mode;
+  replay->speed = 1.0;
+  if (replay->mode == MTL_PCAP_REPLAY_SCALED && port_params->pcap_replay_speed > 0)
+    replay->speed = port_params->pcap_replay_speed;
+  replay->loop = (port_params->flags & MTL_PORT_FLAG_PCAP_REPLAY_LOOP) ? true : false;
+  replay->mbuf_pool =
+      inf->rx_queues[0].mbuf_pool ? inf->rx_queues[0].mbuf_pool : inf->rx_mbuf_pool;
+  if (!replay->file || !replay->mbuf_pool) {
+    err("%s(%d), no file or mbuf_pool\n", __func__, port);
+    replay_free(replay);
+    return -EIO;
+  }
+
+  ret = replay_open(replay);
+  if (ret < 0) {
+    replay_free(replay);
+    return ret;
+  }
+
+  /* the capture timestamp is carried to the rx sessions by the rx timestamp dynfield */
+  if (!impl->dynfield_offset) {
+    ret = rte_mbuf_dyn_rx_timestamp_register(&impl->dynfield_offset, NULL);
+    if (ret < 0) {
+      err("%s(%d), rte_mbuf_dyn_rx_timestamp_register fail\n", __func__, port);
+      replay_free(replay);
+      return ret;
+    }
+  }
+  inf->feature |= MT_IF_FEATURE_RX_SW_TIMESTAMP;
+
+  ret = mt_stat_register(impl, replay_stat_dump, replay, "pcap_replay");
+  if (ret < 0) {
+    err("%s(%d), stat register fail %d\n", __func__, port, ret);
+    replay_free(replay);
+    return ret;
+  }
+
+  inf->pcap_replay = replay;
+  info("%s(%d), %s, mode %d speed %f%s, size %" PRIu64 "\n", __func__, port,
+       replay->file, replay->mode, replay->speed, replay->loop ? ", loop" : "",
+       (uint64_t)replay->map_size);
+  return 0;
+}
+
+int mt_dev_pcap_replay_uinit(struct mt_interface* inf) {
+  struct mt_pcap_replay_impl* replay = inf->pcap_replay;
+  if (!replay) return 0;
+
+  mt_stat_unregister(replay->parent, replay_stat_dump, replay);
+  replay_stat_dump(replay);
+  inf->feature &= ~MT_IF_FEATURE_RX_SW_TIMESTAMP;
+  replay_free(replay);
+  inf->pcap_replay = NULL;
+  info("%s(%d), succ\n", __func__, inf->port);
+  return 0;
+}
@@ -0,0 +1,43 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#ifndef _MT_LIB_DEV_PCAP_REPLAY_HEAD_H_
+#define _MT_LIB_DEV_PCAP_REPLAY_HEAD_H_
+
+#include "../mt_main.h"
+
+#ifndef WINDOWSENV
+
+int mt_dev_pcap_replay_init(struct mt_interface* inf);
+int mt_dev_pcap_replay_uinit(struct mt_interface* inf);
+
+uint16_t mt_pcap_replay_rx_burst(struct mt_pcap_replay_impl* replay,
+                                 struct rte_mbuf** rx_pkts, const uint16_t nb_pkts);
+
+#else
+
+#include "../mt_log.h"
+
+static inline int mt_dev_pcap_replay_init(struct mt_interface* inf) {
+  err("%s(%d), no pcap replay support for this build\n", __func__, inf->port);
+  return -ENOTSUP;
+}
+
+static inline int mt_dev_pcap_replay_uinit(struct mt_interface* inf) {
+  MTL_MAY_UNUSED(inf);
+  return -ENOTSUP;
+}
+
+static inline uint16_t mt_pcap_replay_rx_burst(struct mt_pcap_replay_impl* replay,
+                                               struct rte_mbuf** rx_pkts,
+                                               const uint16_t nb_pkts) {
+  MTL_MAY_UNUSED(replay);
+  MTL_MAY_UNUSED(rx_pkts);
+  MTL_MAY_UNUSED(nb_pkts);
+  return 0;
+}
+
+#endif
+
+#endif
@@ -36,6 +36,7 @@ enum mt_handle_type {
   MT_ST40_HANDLE_PIPELINE_RX = 33,
   MT_HANDLE_TX_FMD = 34,
   MT_HANDLE_RX_FMD = 35,
+  MT_HANDLE_RX_AUDIO_AGG = 36,
 
   MT_HANDLE_UDMA = 40,
   MT_HANDLE_UDP = 41,
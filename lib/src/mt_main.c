@@ -21,6 +21,8 @@
 #include "mt_socket.h"
 #include "mt_stat.h"
 #include "mt_util.h"
+#include "st2110/pipeline/st_convert_pool.h"
+#include "st2110/pipeline/st_convert_select.h"
 #include "st2110/pipeline/st_plugin.h"
 
 enum mtl_port mt_port_by_id(struct mtl_main_impl* impl, uint16_t port_id) {
@@ -191,6 +193,18 @@ static int mt_main_create(struct mtl_main_impl* impl) {
     return ret;
   }
 
+  ret = st_convert_pools_init(impl);
+  if (ret < 0) {
+    err("%s, st_convert_pools_init fail %d\n", __func__, ret);
+    return ret;
+  }
+
+  ret = st_convert_select_init(impl);
+  if (ret < 0) {
+    err("%s, st_convert_select_init fail %d\n", __func__, ret);
+    return ret;
+  }
+
   ret = mt_config_init(impl);
   if (ret < 0) {
     err("%s, mt_config_init fail %d\n", __func__, ret);
@@ -228,6 +242,8 @@ static int mt_main_free(struct mtl_main_impl* impl) {
   mt_ptp_uinit(impl);
   mt_dhcp_uinit(impl);
   mt_config_uinit(impl);
+  st_convert_select_uinit(impl);
+  st_convert_pools_uinit(impl);
   st_plugins_uinit(impl);
   mt_admin_uinit(impl);
   mt_cni_uinit(impl);
@@ -251,6 +267,15 @@ bool mt_sessions_time_measure(struct mtl_main_impl* impl) {
   return enabled;
 }
 
+/* pmd without kernel netdev, the ip is assigned by the user */
+static inline bool mt_pmd_user_ip(enum mtl_pmd_type pmd) {
+  if (pmd == MTL_PMD_DPDK_USER || pmd == MTL_PMD_DPDK_MEMIF ||
+      pmd == MTL_PMD_PCAP_REPLAY)
+    return true;
+  else
+    return false;
+}
+
 static int mt_user_params_check(struct mtl_init_params* p) {
   int num_ports = p->num_ports, ret;
   uint8_t* ip = NULL;
@@ -300,6 +325,27 @@ static int mt_user_params_check(struct mtl_init_params* p) {
         return -EINVAL;
       }
     }
+    /* memif port check */
+    if (pmd == MTL_PMD_DPDK_MEMIF) {
+      const char* memif_args = mt_dpdk_memif_port2args(p->port[i]);
+      if (!memif_args || !strlen(memif_args)) {
+        err("%s(%d), no memif args from %s\n", __func__, i, p->port[i]);
+        return -EINVAL;
+      }
+    }
+    /* pcap replay port check */
+    if (pmd == MTL_PMD_PCAP_REPLAY) {
+      const char* file = mt_pcap_replay_port2file(p->port[i]);
+      if (!file || access(file, R_OK) < 0) {
+        err("%s(%d), can't read the pcap file from %s\n", __func__, i, p->port[i]);
+        return -EINVAL;
+      }
+      if (p->port_params[i].pcap_replay_mode >= MTL_PCAP_REPLAY_MAX) {
+        err("%s(%d), invalid pcap replay mode %d\n", __func__, i,
+            p->port_params[i].pcap_replay_mode);
+        return -EINVAL;
+      }
+    }
     if (if_name) {
       ret = mt_socket_get_if_ip(if_name, if_ip, if_netmask);
       if (ret < 0) {
@@ -307,7 +353,7 @@ static int mt_user_params_check(struct mtl_init_params* p) {
         return ret;
       }
     }
-    if (p->net_proto[i] == MTL_PROTO_STATIC && p->pmd[i] == MTL_PMD_DPDK_USER) {
+    if (p->net_proto[i] == MTL_PROTO_STATIC && mt_pmd_user_ip(p->pmd[i])) {
       ip = p->sip_addr[i];
       ret = mt_ip_addr_check(ip);
       if (ret < 0) {
@@ -329,8 +375,8 @@ static int mt_user_params_check(struct mtl_init_params* p) {
           }
         }
         /* check if duplicate ip */
-        if ((p->net_proto[i] == MTL_PROTO_STATIC) && (p->pmd[i] == MTL_PMD_DPDK_USER) &&
-            (p->pmd[j] == MTL_PMD_DPDK_USER)) {
+        if ((p->net_proto[i] == MTL_PROTO_STATIC) && mt_pmd_user_ip(p->pmd[i]) &&
+            mt_pmd_user_ip(p->pmd[j])) {
           if (0 == memcmp(p->sip_addr[i], p->sip_addr[j], MTL_IP_ADDR_LEN)) {
             ip = p->sip_addr[j];
             err("%s, same ip %d.%d.%d.%d for port %d and %d\n", __func__, ip[0], ip[1],
@@ -425,6 +471,8 @@ mtl_handle mtl_init(struct mtl_init_params* p) {
     pmd = p->pmd[i];
     if (pmd == MTL_PMD_KERNEL_SOCKET || pmd == MTL_PMD_NATIVE_AF_XDP) {
       socket[i] = mt_socket_get_numa(kport_info.kernel_if[i]);
+    } else if (pmd == MTL_PMD_PCAP_REPLAY) {
+      socket[i] = 0; /* no device, the file is read by the rx thread */
     } else if (pmd != MTL_PMD_DPDK_USER) {
       socket[i] = mt_dev_get_socket_id(kport_info.dpdk_port[i]);
     } else {
@@ -496,7 +544,7 @@ mtl_handle mtl_init(struct mtl_init_params* p) {
     inf = mt_if(impl, i);
     inf->parent = impl;
 
-    if (p->pmd[i] != MTL_PMD_DPDK_USER) {
+    if (!mt_pmd_user_ip(p->pmd[i])) {
       uint8_t if_ip[MTL_IP_ADDR_LEN];
       uint8_t if_netmask[MTL_IP_ADDR_LEN];
       uint8_t if_gateway[MTL_IP_ADDR_LEN];
@@ -518,7 +566,7 @@ mtl_handle mtl_init(struct mtl_init_params* p) {
           rte_memcpy(impl->user_para.gateway[i], if_gateway, MTL_IP_ADDR_LEN);
         }
       }
-    } else { /* MTL_PMD_DPDK_USER */
+    } else { /* MTL_PMD_DPDK_USER, MTL_PMD_DPDK_MEMIF or MTL_PMD_PCAP_REPLAY */
       uint32_t netmask = mt_ip_to_u32(impl->user_para.netmask[i]);
       if (!netmask) { /* set to default if user not set a netmask */
         impl->user_para.netmask[i][0] = 255;
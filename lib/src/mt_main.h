@@ -77,6 +77,8 @@
 #define MT_IF_FEATURE_RXQ_OFFLOAD_BUFFER_SPLIT (MTL_BIT32(6))
 /* LaunchTime Tx */
 #define MT_IF_FEATURE_TX_OFFLOAD_SEND_ON_TIMESTAMP (MTL_BIT32(7))
+/* Rx timestamp in mbuf dynamic field is filled by software in ptp time domain */
+#define MT_IF_FEATURE_RX_SW_TIMESTAMP (MTL_BIT32(8))
 
 #define MT_IF_STAT_PORT_CONFIGURED (MTL_BIT32(0))
 #define MT_IF_STAT_PORT_STARTED (MTL_BIT32(1))
@@ -130,7 +132,9 @@ enum mt_port_type {
   MT_PORT_DPDK_AF_XDP,
   MT_PORT_DPDK_AF_PKT,
   MT_PORT_KERNEL_SOCKET,
-  MT_PORT_NATIVE_AF_XDP
+  MT_PORT_NATIVE_AF_XDP,
+  MT_PORT_DPDK_MEMIF,
+  MT_PORT_PCAP_REPLAY,
 };
 
 enum mt_rl_type {
@@ -158,7 +162,11 @@ enum mt_driver_type {
   /* kernel based socket */
   MT_DRV_KERNEL_SOCKET,
   /* native af xdp */
-  MT_DRV_NATIVE_AF_XDP
+  MT_DRV_NATIVE_AF_XDP,
+  /* dpdk memif, net_memif */
+  MT_DRV_DPDK_MEMIF,
+  /* pcap file replay */
+  MT_DRV_PCAP_REPLAY,
 };
 
 enum mt_flow_type {
@@ -330,6 +338,8 @@ struct mt_rxq_flow {
   uint32_t flags;
   /* rate in bytes */
   uint64_t bytes_per_sec;
+  /* the max packet size from the ether hdr if above the standard mtu, only for socket */
+  uint16_t pkt_max_len;
 
   /* optional for hdr split */
   void* hdr_split_mbuf_cb_priv;
@@ -643,6 +653,8 @@ struct mt_rx_queue {
   struct mt_rx_flow_rsp* flow_rsp;
   struct rte_mempool* mbuf_pool;
   unsigned int mbuf_elements;
+  /* mbufs of mbuf_pool held by the sessions after the rx burst */
+  rte_atomic32_t mbuf_held;
   /* pool for hdr split payload */
   struct rte_mempool* mbuf_payload_pool;
 };
@@ -670,7 +682,7 @@ struct mt_tx_queue {
 #define MT_DRV_F_USE_KERNEL_CTL (MTL_BIT64(4))
 /* no priv for the mbuf in the rx queue */
 #define MT_DRV_F_RX_POOL_COMMON (MTL_BIT64(5))
-/* no rx flow, for MTL_PMD_DPDK_AF_PACKET and MTL_PMD_KERNEL_SOCKET */
+/* no rx flow, for MTL_PMD_DPDK_AF_PACKET, MTL_PMD_DPDK_MEMIF and MTL_PMD_KERNEL_SOCKET */
 #define MT_DRV_F_RX_NO_FLOW (MTL_BIT64(6))
 /* mcast control in data path, for MTL_PMD_KERNEL_SOCKET */
 #define MT_DRV_F_MCAST_IN_DP (MTL_BIT64(7))
@@ -710,6 +722,8 @@ struct mt_interface {
   struct rte_mempool* tx_mbuf_pool;
   /* default rx mbuf_pool */
   struct rte_mempool* rx_mbuf_pool;
+  /* mbufs held by the sessions after the rx burst, for pools not owned by a queue */
+  rte_atomic32_t rx_mbuf_held;
   uint16_t nb_tx_desc;
   uint16_t nb_rx_desc;
 
@@ -766,8 +780,15 @@ struct mt_interface {
 
   /* the mac for kernel socket based transport */
   struct rte_ether_addr k_mac_addr;
+  /* the hw timestamp rx filter of the kernel if, set by the socket rx */
+  pthread_mutex_t hwtstamp_mutex;
+  int hwtstamp_users;     /* the socket rx entries use the hw timestamp */
+  bool hwtstamp_changed;  /* the rx filter was changed, restore on the last put */
+  int hwtstamp_rx_filter; /* the rx filter before changed */
 
   void* xdp;
+  /* for MTL_PMD_PCAP_REPLAY */
+  void* pcap_replay;
 };
 
 struct mt_user_info {
@@ -938,6 +959,8 @@ struct mt_rsq_queue {
   uint16_t queue_id;
   /* for native xdp based shared queue */
   struct mt_rx_xdp_entry* xdp;
+  /* for pcap replay based shared queue */
+  struct mt_pcap_replay_impl* pcap_replay;
   /* List of rsq entry */
   struct mt_rsq_entrys_list head;
   rte_spinlock_t mutex;
@@ -1073,6 +1096,10 @@ struct mt_srss_impl {
 };
 
 #define MT_DP_SOCKET_THREADS_MAX (4)
+/* max pkts for one sendmmsg call in the SO_TXTIME path */
+#define MT_DP_SOCKET_TXTIME_BURST (32)
+/* the max sleep of the tx thread for the launch time in the emulate mode */
+#define MT_DP_SOCKET_TXTIME_WAIT_MAX_US (1000)
 
 struct mt_tx_socket_thread {
   struct mt_tx_socket_entry* parent;
@@ -1085,11 +1112,17 @@ struct mt_tx_socket_thread {
   struct sockaddr_in send_addr;
   struct msghdr msg;
   char msg_control[CMSG_SPACE(sizeof(uint16_t))];
+  /* SO_TXTIME, one SCM_TXTIME cmsg for each pkt */
+  struct mmsghdr txtime_msgs[MT_DP_SOCKET_TXTIME_BURST];
+  struct iovec txtime_iovs[MT_DP_SOCKET_TXTIME_BURST];
+  char txtime_control[MT_DP_SOCKET_TXTIME_BURST][CMSG_SPACE(sizeof(uint64_t))];
 #endif
 
   int stat_tx_try;
   int stat_tx_pkt;
   int stat_tx_gso;
+  int stat_tx_txtime;
+  int stat_tx_txtime_wait;
 };
 
 struct mt_tx_socket_entry {
@@ -1099,12 +1132,19 @@ struct mt_tx_socket_entry {
 
   uint64_t rate_limit_per_thread;
   uint16_t gso_sz;
+  /* launch time by SO_TXTIME, for MT_TXQ_FLOW_F_LAUNCH_TIME */
+  bool txtime;
+  /* software emulated launch time, hold the pkt until the target ptp time */
+  bool txtime_emulate;
   int threads;
   struct rte_ring* ring;
   struct mt_tx_socket_thread threads_data[MT_DP_SOCKET_THREADS_MAX];
   bool stat_registered;
 };
 
+/* pkts to refresh the delta from the kernel clock to the ptp time */
+#define MT_DP_SOCKET_TS_DELTA_REFRESH (1024)
+
 struct mt_rx_socket_thread {
   struct mt_rx_socket_entry* parent;
   int idx;
@@ -1112,8 +1152,21 @@ struct mt_rx_socket_thread {
   pthread_t tid;
   rte_atomic32_t stop_thread;
 
+#ifndef WINDOWSENV
+  struct msghdr msg;
+  struct iovec iov;
+  /* SO_TIMESTAMPING, struct scm_timestamping */
+  char msg_control[CMSG_SPACE(sizeof(struct timespec) * 3)];
+  /* ptp time - kernel clock */
+  int64_t real_delta;
+  int64_t tai_delta;
+  uint32_t delta_refresh;
+#endif
+
   int stat_rx_try;
   int stat_rx_pkt;
+  int stat_rx_sw_timestamp;
+  int stat_rx_hw_timestamp;
 };
 
 struct mt_rx_socket_entry {
@@ -1124,6 +1177,10 @@ struct mt_rx_socket_entry {
   struct rte_mempool* pool;
   uint16_t pool_element_sz;
   int fd;
+  /* the arrival time from SO_TIMESTAMPING */
+  bool timestamping;
+  /* one user of the hw timestamp of the kernel if */
+  bool hw_timestamp;
 
   uint64_t rate_limit_per_thread;
   int threads;
@@ -1222,6 +1279,10 @@ struct mtl_main_impl {
 
   /* st plugin dev mgr */
   struct st_plugin_mgr plugin_mgr;
+  /* shared worker pool for the internal converter */
+  struct st_convert_pool_mgr convert_pool_mgr;
+  /* benchmark based simd level selection for the internal converter */
+  struct st_convert_select_mgr convert_select_mgr;
 
   struct mt_user_info u_info;
 
@@ -1308,7 +1369,10 @@ static inline bool mt_pmd_is_dpdk_user(struct mtl_main_impl* impl, enum mtl_port
 
 static inline bool mt_pmd_is_kernel_based(struct mtl_main_impl* impl,
                                           enum mtl_port port) {
-  if (MTL_PMD_DPDK_USER == mt_get_user_params(impl)->pmd[port])
+  enum mtl_pmd_type pmd = mt_get_user_params(impl)->pmd[port];
+
+  if (MTL_PMD_DPDK_USER == pmd || MTL_PMD_DPDK_MEMIF == pmd ||
+      MTL_PMD_PCAP_REPLAY == pmd)
     return false;
   else
     return true;
@@ -1392,6 +1456,21 @@ static inline bool mt_pmd_is_native_af_xdp(struct mtl_main_impl* impl,
     return false;
 }
 
+static inline bool mt_pmd_is_dpdk_memif(struct mtl_main_impl* impl, enum mtl_port port) {
+  if (MTL_PMD_DPDK_MEMIF == mt_get_user_params(impl)->pmd[port])
+    return true;
+  else
+    return false;
+}
+
+static inline bool mt_pmd_is_pcap_replay(struct mtl_main_impl* impl,
+                                         enum mtl_port port) {
+  if (MTL_PMD_PCAP_REPLAY == mt_get_user_params(impl)->pmd[port])
+    return true;
+  else
+    return false;
+}
+
 static inline int mt_num_ports(struct mtl_main_impl* impl) {
   return RTE_MIN(mt_get_user_params(impl)->num_ports, MTL_PORT_MAX);
 }
@@ -1544,6 +1623,14 @@ static inline bool mt_user_tx_no_chain(struct mtl_main_impl* impl) {
     return false;
 }
 
+/* if user force the software emulated launch time for kernel based tsn pacing */
+static inline bool mt_user_tx_txtime_emulate(struct mtl_main_impl* impl) {
+  if (mt_get_user_params(impl)->flags & MTL_FLAG_TX_TXTIME_EMULATE)
+    return true;
+  else
+    return false;
+}
+
 static inline bool mt_has_cni(struct mtl_main_impl* impl, enum mtl_port port) {
   if (impl->cni.entries[port].rxq)
     return true;
@@ -1673,6 +1760,14 @@ static inline bool mt_if_has_offload_timestamp(struct mtl_main_impl* impl,
     return false;
 }
 
+static inline bool mt_if_has_sw_timestamp(struct mtl_main_impl* impl,
+                                          enum mtl_port port) {
+  if (mt_if(impl, port)->feature & MT_IF_FEATURE_RX_SW_TIMESTAMP)
+    return true;
+  else
+    return false;
+}
+
 static inline bool mt_if_has_offload_ipv4_cksum(struct mtl_main_impl* impl,
                                                 enum mtl_port port) {
   if (mt_if(impl, port)->feature & MT_IF_FEATURE_TX_OFFLOAD_IPV4_CKSUM)
@@ -1778,6 +1873,20 @@ static inline struct rte_mempool* mt_sys_rx_mempool(struct mtl_main_impl* impl,
   return mt_if(impl, port)->rx_mbuf_pool;
 }
 
+/* the held counter shared by all the rx users of the pool */
+static inline rte_atomic32_t* mt_if_rx_pool_held(struct mtl_main_impl* impl,
+                                                 enum mtl_port port,
+                                                 struct rte_mempool* pool) {
+  struct mt_interface* inf = mt_if(impl, port);
+
+  if (inf->rx_queues) {
+    for (uint16_t q = 0; q < inf->nb_rx_q; q++) {
+      if (inf->rx_queues[q].mbuf_pool == pool) return &inf->rx_queues[q].mbuf_held;
+    }
+  }
+  return &inf->rx_mbuf_held;
+}
+
 static inline struct rte_mbuf* mt_get_pad(struct mtl_main_impl* impl,
                                           enum mtl_port port) {
   return mt_if(impl, port)->pad;
@@ -1875,6 +1984,14 @@ static inline uint64_t mt_get_real_time(void) {
   return mt_timespec_to_ns(&ts);
 }
 
+/* TAI time, the time base of the kernel launch time(SO_TXTIME, xdp tx metadata) */
+static inline uint64_t mt_get_tai_time(void) {
+  struct timespec ts;
+
+  clock_gettime(MT_CLOCK_TAI_ID, &ts);
+  return mt_timespec_to_ns(&ts);
+}
+
 static inline void st_tx_mbuf_set_tsc(struct rte_mbuf* mbuf, uint64_t time_stamp) {
   struct mt_muf_priv_data* priv = rte_mbuf_to_priv(mbuf);
   priv->tx_priv.tsc_time_stamp = time_stamp;
@@ -1952,6 +2069,13 @@ static inline uint64_t mt_get_ptp_time(struct mtl_main_impl* impl, enum mtl_port
   return mt_if(impl, port)->ptp_get_time_fn(impl, port);
 }
 
+/* the launch time(ptp ns) attached by the tsn transmitter, 0 if no launch time */
+static inline uint64_t mt_mbuf_launch_time(struct mt_interface* inf,
+                                           struct rte_mbuf* mbuf) {
+  if (!(mbuf->ol_flags & inf->tx_launch_time_flag)) return 0;
+  return *RTE_MBUF_DYNFIELD(mbuf, inf->tx_dynfield_offset, uint64_t*);
+}
+
 int mt_ptp_wait_stable(struct mtl_main_impl* impl, enum mtl_port port, int timeout_ms);
 
 uint64_t mt_get_raw_ptp_time(struct mtl_main_impl* impl, enum mtl_port port);
@@ -31,6 +31,16 @@
 #define MT_CLOCK_MONOTONIC_ID CLOCK_MONOTONIC
 #endif
 
+/* the clock used by the etf qdisc and the SO_TXTIME launch time */
+#ifdef CLOCK_TAI
+#define MT_CLOCK_TAI_ID CLOCK_TAI
+#define MT_HAS_CLOCK_TAI (1)
+#else
+/* the launch time would be off by the TAI-UTC offset, the users check MT_HAS_CLOCK_TAI */
+#define MT_CLOCK_TAI_ID CLOCK_REALTIME
+#define MT_HAS_CLOCK_TAI (0)
+#endif
+
 #ifdef WINDOWSENV
 typedef unsigned long int nfds_t;
 #endif
@@ -143,6 +153,10 @@ static inline int mt_pthread_cond_signal(pthread_cond_t* cond) {
   return pthread_cond_signal(cond);
 }
 
+static inline int mt_pthread_cond_broadcast(pthread_cond_t* cond) {
+  return pthread_cond_broadcast(cond);
+}
+
 static inline bool mt_socket_match(int cpu_socket, int dev_socket) {
 #ifdef WINDOWSENV
   MTL_MAY_UNUSED(cpu_socket);
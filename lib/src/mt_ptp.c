@@ -1625,7 +1625,9 @@ static uint64_t mbuf_hw_time_stamp(struct mtl_main_impl* impl, struct rte_mbuf*
 
 uint64_t mt_mbuf_time_stamp(struct mtl_main_impl* impl, struct rte_mbuf* mbuf,
                             enum mtl_port port) {
-  if (mt_if_has_offload_timestamp(impl, port))
+  if (mt_if_has_sw_timestamp(impl, port))
+    return *RTE_MBUF_DYNFIELD(mbuf, impl->dynfield_offset, rte_mbuf_timestamp_t*);
+  else if (mt_if_has_offload_timestamp(impl, port))
     return mbuf_hw_time_stamp(impl, mbuf, port);
   else
     return mtl_ptp_read_time(impl);
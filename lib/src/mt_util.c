@@ -941,6 +941,8 @@ static const char* dpdk_afxdp_port_prefix = "dpdk_af_xdp:";
 static const char* dpdk_afpkt_port_prefix = "dpdk_af_packet:";
 static const char* kernel_port_prefix = "kernel:";
 static const char* native_afxdp_port_prefix = "native_af_xdp:";
+static const char* dpdk_memif_port_prefix = "dpdk_memif:";
+static const char* pcap_replay_port_prefix = "pcap_replay:";
 
 enum mtl_pmd_type mtl_pmd_by_port_name(const char* port) {
   dbg("%s, port %s\n", __func__, port);
@@ -952,6 +954,10 @@ enum mtl_pmd_type mtl_pmd_by_port_name(const char* port) {
     return MTL_PMD_KERNEL_SOCKET;
   else if (strncmp(port, native_afxdp_port_prefix, strlen(native_afxdp_port_prefix)) == 0)
     return MTL_PMD_NATIVE_AF_XDP;
+  else if (strncmp(port, dpdk_memif_port_prefix, strlen(dpdk_memif_port_prefix)) == 0)
+    return MTL_PMD_DPDK_MEMIF;
+  else if (strncmp(port, pcap_replay_port_prefix, strlen(pcap_replay_port_prefix)) == 0)
+    return MTL_PMD_PCAP_REPLAY;
   else
     return MTL_PMD_DPDK_USER; /* default */
 }
@@ -988,6 +994,22 @@ const char* mt_native_afxdp_port2if(const char* port) {
   return port + strlen(native_afxdp_port_prefix);
 }
 
+const char* mt_dpdk_memif_port2args(const char* port) {
+  if (mtl_pmd_by_port_name(port) != MTL_PMD_DPDK_MEMIF) {
+    err("%s, port %s is not dpdk_memif\n", __func__, port);
+    return NULL;
+  }
+  return port + strlen(dpdk_memif_port_prefix);
+}
+
+const char* mt_pcap_replay_port2file(const char* port) {
+  if (mtl_pmd_by_port_name(port) != MTL_PMD_PCAP_REPLAY) {
+    err("%s, port %s is not pcap_replay\n", __func__, port);
+    return NULL;
+  }
+  return port + strlen(pcap_replay_port_prefix);
+}
+
 int mt_user_info_init(struct mt_user_info* info) {
   int ret = -EIO;
 
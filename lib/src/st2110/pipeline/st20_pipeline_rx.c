@@ -7,6 +7,8 @@
 #include "../../mt_handle_guard.h"
 #include "../../mt_log.h"
 #include "../../mt_stat.h"
+#include "st_convert_pool.h"
+#include "st_convert_select.h"
 
 static int rx_st20p_uinit_dst_fbs(struct st20p_rx_ctx* ctx);
 
@@ -89,6 +91,70 @@ static struct st20p_rx_frame* rx_st20p_claim_available(
   return NULL;
 }
 
+/* the line pairs of the frame are not all converted */
+static inline bool rx_st20p_pair_incomplete(struct st20p_rx_frame* framebuff) {
+  return framebuff->pair_broken || (framebuff->pair_done != framebuff->pair_parked);
+}
+
+/*
+ * The 420 chroma needs the line pair, the even line payload is parked in the idle user
+ * frame of the transport and converted together with the odd line, which relies on the
+ * packets of one frame arriving in line order. An odd packet without its parked even
+ * pixels is skipped and the frame marked incomplete.
+ */
+static int rx_st20p_packet_convert_420(struct st20p_rx_ctx* ctx,
+                                       struct st20p_rx_frame* framebuff, void* frame,
+                                       struct st20_rx_uframe_pg_meta* meta) {
+  struct st_frame* dst = &framebuff->dst;
+  size_t pg_size = sizeof(struct st20_rfc4175_422_10_pg2_be);
+  size_t src_linesize = (size_t)ctx->ops.width / 2 * pg_size;
+  uint32_t row = meta->row_number;
+  uint32_t w = meta->pg_cnt * 2;
+  struct st20_rfc4175_422_10_pg2_be* even =
+      frame + src_linesize * (row & ~1U) + meta->row_offset / 2 * pg_size;
+
+  if (!(row & 1)) {
+    if (row != framebuff->pair_row) { /* next pair, the last one has to be done */
+      if (framebuff->pair_done != framebuff->pair_parked) framebuff->pair_broken = true;
+      framebuff->pair_row = row;
+      framebuff->pair_parked = 0;
+      framebuff->pair_done = 0;
+    }
+    if (meta->row_offset != framebuff->pair_parked) {
+      dbg("%s(%d), row %u offset %u but parked %u\n", __func__, ctx->idx, row,
+          meta->row_offset, framebuff->pair_parked);
+      framebuff->pair_broken = true;
+      return 0;
+    }
+    mtl_memcpy(even, meta->payload, meta->pg_cnt * pg_size);
+    framebuff->pair_parked += w;
+    return 0;
+  }
+
+  if ((row - 1 != framebuff->pair_row) || (meta->row_offset != framebuff->pair_done) ||
+      (meta->row_offset + w > framebuff->pair_parked)) {
+    dbg("%s(%d), row %u offset %u not paired, even row %u parked %u\n", __func__,
+        ctx->idx, row, meta->row_offset, framebuff->pair_row, framebuff->pair_parked);
+    framebuff->pair_broken = true;
+    return 0;
+  }
+  framebuff->pair_done += w;
+
+  uint8_t bytes = (ctx->ops.output_fmt == ST_FRAME_FMT_P010) ? 2 : 1;
+  uint8_t* y0 =
+      (uint8_t*)dst->addr[0] + dst->linesize[0] * (row - 1) + meta->row_offset * bytes;
+  uint8_t* y1 = y0 + dst->linesize[0];
+  uint8_t* uv =
+      (uint8_t*)dst->addr[1] + dst->linesize[1] * (row / 2) + meta->row_offset * bytes;
+
+  if (ctx->ops.output_fmt == ST_FRAME_FMT_P010)
+    return st20_rfc4175_422be10_to_p010_pair_simd(even, meta->payload, (uint16_t*)y0,
+                                                  (uint16_t*)y1, (uint16_t*)uv, w,
+                                                  MTL_SIMD_LEVEL_MAX);
+  return st20_rfc4175_422be10_to_nv12_pair_simd(even, meta->payload, y0, y1, uv, w,
+                                                MTL_SIMD_LEVEL_MAX);
+}
+
 static int rx_st20p_packet_convert(void* priv, void* frame,
                                    struct st20_rx_uframe_pg_meta* meta) {
   struct st20p_rx_ctx* ctx = priv;
@@ -105,6 +171,10 @@ static int rx_st20p_packet_convert(void* priv, void* frame,
       atomic_store_explicit(&framebuff->stat, ST20P_RX_FRAME_IN_CONVERTING,
                             memory_order_release);
       framebuff->dst.timestamp = meta->timestamp;
+      framebuff->pair_row = 0;
+      framebuff->pair_parked = 0;
+      framebuff->pair_done = 0;
+      framebuff->pair_broken = false;
     }
   } else {
     framebuff = rx_st20p_next_available(ctx, ctx->framebuff_producer_idx,
@@ -161,11 +231,88 @@ static int rx_st20p_packet_convert(void* priv, void* frame,
     uint8_t* r = (uint8_t*)framebuff->dst.addr[2] +
                  framebuff->dst.linesize[2] * meta->row_number + meta->row_offset;
     ret = st20_rfc4175_422be10_to_yuv420p8(src, y, b, r, meta->pg_cnt, 2);
+  } else if (ctx->ops.output_fmt == ST_FRAME_FMT_NV12 ||
+             ctx->ops.output_fmt == ST_FRAME_FMT_P010) {
+    ret = rx_st20p_packet_convert_420(ctx, framebuff, frame, meta);
   }
 
   return ret;
 }
 
+/* the framebuff which is receiving the slices of the transport frame */
+static struct st20p_rx_frame* rx_st20p_slice_framebuff(struct st20p_rx_ctx* ctx,
+                                                       void* frame) {
+  for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+    struct st20p_rx_frame* framebuff = &ctx->framebuffs[i];
+    if ((atomic_load_explicit(&framebuff->stat, memory_order_acquire) ==
+         ST20P_RX_FRAME_IN_CONVERTING) &&
+        (framebuff->src.addr[0] == frame))
+      return framebuff;
+  }
+  return NULL;
+}
+
+/* find the framebuff of the transport frame, or claim a free one for the first slice */
+static struct st20p_rx_frame* rx_st20p_slice_claim(struct st20p_rx_ctx* ctx,
+                                                   void* frame) {
+  struct st20p_rx_frame* framebuff = rx_st20p_slice_framebuff(ctx, frame);
+
+  if (framebuff) return framebuff;
+  framebuff = rx_st20p_claim_available(ctx, ctx->framebuff_producer_idx,
+                                       ST20P_RX_FRAME_FREE, ST20P_RX_FRAME_IN_CONVERTING);
+  if (!framebuff) return NULL;
+  framebuff->src.addr[0] = frame;
+  if (ctx->derive) framebuff->dst = framebuff->src;
+  atomic_store_explicit(&framebuff->lines_ready, 0, memory_order_relaxed);
+  /* point to next */
+  ctx->framebuff_producer_idx = rx_st20p_next_idx(ctx, framebuff->idx);
+  return framebuff;
+}
+
+/* convert the new lines up to lines and move the watermark */
+static int rx_st20p_slice_convert(struct st20p_rx_ctx* ctx,
+                                  struct st20p_rx_frame* framebuff, uint32_t lines) {
+  uint32_t done = atomic_load_explicit(&framebuff->lines_ready, memory_order_relaxed);
+  int ret = 0;
+
+  if (lines <= done) return 0;
+  if (ctx->internal_converter) {
+    ret = st_frame_converter_convert_lines(ctx->internal_converter, &framebuff->src,
+                                           &framebuff->dst, done, lines - done);
+    if (ret < 0) rte_atomic32_inc(&ctx->stat_convert_fail);
+  }
+  /* release: the converted lines are visible before the watermark */
+  atomic_store_explicit(&framebuff->lines_ready, lines, memory_order_release);
+  return ret;
+}
+
+static int rx_st20p_slice_ready(void* priv, void* frame,
+                                struct st20_rx_slice_meta* meta) {
+  struct st20p_rx_ctx* ctx = priv;
+  struct st20p_rx_frame* framebuff;
+  uint32_t lines;
+
+  if (!ctx->ready) return -EBUSY; /* not ready */
+
+  framebuff = rx_st20p_slice_claim(ctx, frame);
+  if (!framebuff) {
+    /* frame_ready will account the drop */
+    ctx->stat_slices_busy++;
+    return -EBUSY;
+  }
+
+  lines = RTE_MIN(meta->frame_recv_lines, st_frame_data_height(&framebuff->src));
+  lines = RTE_ALIGN_FLOOR(lines, ctx->slice_align);
+  rx_st20p_slice_convert(ctx, framebuff, lines);
+  ctx->stat_slices++;
+
+  if (ctx->ops.notify_slice_ready)
+    ctx->ops.notify_slice_ready(ctx->ops.priv, &framebuff->dst,
+                                atomic_load_explicit(&framebuff->lines_ready,
+                                                     memory_order_relaxed));
+  return 0;
+}
+
 static int rx_st20p_frame_ready(void* priv, void* frame,
                                 struct st20_rx_frame_meta* meta) {
   struct st20p_rx_ctx* ctx = priv;
@@ -186,6 +333,26 @@ static int rx_st20p_frame_ready(void* priv, void* frame,
         return 0; /* surpress the error */
       }
     }
+    /* some line pairs of the 420 output are missed */
+    if (framebuff && rx_st20p_pair_incomplete(framebuff) &&
+        !(ctx->ops.flags & ST20P_RX_FLAG_RECEIVE_INCOMPLETE_FRAME)) {
+      atomic_store_explicit(&framebuff->stat, ST20P_RX_FRAME_FREE, memory_order_release);
+      atomic_fetch_add_explicit(&ctx->stat_frames_dropped, 1, memory_order_relaxed);
+      st20_rx_put_framebuff(ctx->transport, frame);
+      return 0;
+    }
+  } else if (ctx->slice_level) {
+    /* the transport notify the incomplete frames also for the slice mode */
+    if ((meta->status == ST_FRAME_STATUS_CORRUPTED) &&
+        !(ctx->ops.flags & ST20P_RX_FLAG_RECEIVE_INCOMPLETE_FRAME)) {
+      framebuff = rx_st20p_slice_framebuff(ctx, frame);
+      if (framebuff)
+        atomic_store_explicit(&framebuff->stat, ST20P_RX_FRAME_FREE,
+                              memory_order_release);
+      st20_rx_put_framebuff(ctx->transport, frame);
+      return 0;
+    }
+    framebuff = rx_st20p_slice_claim(ctx, frame);
   } else {
     framebuff =
         rx_st20p_next_available(ctx, ctx->framebuff_producer_idx, ST20P_RX_FRAME_FREE);
@@ -195,6 +362,11 @@ static int rx_st20p_frame_ready(void* priv, void* frame,
   if (!framebuff) {
     rte_atomic32_inc(&ctx->stat_busy);
     atomic_fetch_add_explicit(&ctx->stat_frames_dropped, 1, memory_order_relaxed);
+    if (ctx->slice_level) {
+      /* the transport not put the incomplete frame back on error */
+      st20_rx_put_framebuff(ctx->transport, frame);
+      return 0;
+    }
     return -EBUSY;
   }
 
@@ -236,6 +408,8 @@ static int rx_st20p_frame_ready(void* priv, void* frame,
   framebuff->src.timestamp = framebuff->dst.timestamp = meta->timestamp;
   framebuff->src.rtp_timestamp = framebuff->dst.rtp_timestamp = meta->rtp_timestamp;
   framebuff->src.status = framebuff->dst.status = meta->status;
+  if ((ctx->ops.flags & ST20P_RX_FLAG_PKT_CONVERT) && rx_st20p_pair_incomplete(framebuff))
+    framebuff->src.status = framebuff->dst.status = ST_FRAME_STATUS_CORRUPTED;
   framebuff->src.receive_timestamp = framebuff->dst.receive_timestamp =
       meta->timestamp_first_pkt;
 
@@ -268,8 +442,11 @@ static int rx_st20p_frame_ready(void* priv, void* frame,
   }
 
   /* ask app to consume src frame directly */
-  if (ctx->derive || (ctx->ops.flags & ST20P_RX_FLAG_PKT_CONVERT)) {
+  if (ctx->derive || ctx->slice_level || (ctx->ops.flags & ST20P_RX_FLAG_PKT_CONVERT)) {
     if (ctx->derive) framebuff->dst = framebuff->src;
+    /* the lines after the last full slice */
+    if (ctx->slice_level)
+      rx_st20p_slice_convert(ctx, framebuff, st_frame_data_height(&framebuff->src));
     atomic_store_explicit(&framebuff->stat, ST20P_RX_FRAME_CONVERTED,
                           memory_order_release);
     /* point to next */
@@ -522,7 +699,8 @@ static int rx_st20p_create_transport(struct mtl_main_impl* impl, struct st20p_rx
     ops_rx.flags |= ST20_RX_FLAG_USE_MULTI_THREADS;
   if (ops->flags & ST20P_RX_FLAG_PKT_CONVERT) {
     uint64_t pkt_cvt_output_cap = ST_FMT_CAP_YUV422PLANAR10LE | ST_FMT_CAP_Y210 |
-                                  ST_FMT_CAP_UYVY | ST_FMT_CAP_YUV422PLANAR16LE;
+                                  ST_FMT_CAP_UYVY | ST_FMT_CAP_YUV422PLANAR16LE |
+                                  ST_FMT_CAP_NV12 | ST_FMT_CAP_P010;
     if (ops->transport_fmt != ST20_FMT_YUV_422_10BIT) {
       err("%s(%d), only 422 10bit support packet convert\n", __func__, idx);
       return -EIO;
@@ -532,6 +710,18 @@ static int rx_st20p_create_transport(struct mtl_main_impl* impl, struct st20p_rx
           st_frame_fmt_name(ops->output_fmt));
       return -EIO;
     }
+    if (st_frame_fmt_get_sampling(ops->output_fmt) == ST_FRAME_SAMPLING_420) {
+      if (ops->height % 2) {
+        err("%s(%d), 420 packet convert needs an even height %u\n", __func__, idx,
+            ops->height);
+        return -EIO;
+      }
+      /* the line pair is parked across packets, only one thread may handle them */
+      if (ops->flags & ST20P_RX_FLAG_USE_MULTI_THREADS) {
+        err("%s(%d), 420 packet convert not support multi threads\n", __func__, idx);
+        return -EIO;
+      }
+    }
     ops_rx.uframe_pg_callback = rx_st20p_packet_convert;
     ops_rx.uframe_size = st20_frame_size(ops->transport_fmt, ops->width, ops->height);
   }
@@ -561,6 +751,13 @@ static int rx_st20p_create_transport(struct mtl_main_impl* impl, struct st20p_rx
   ops_rx.payload_type = ops->port.payload_type;
   ops_rx.ssrc = ops->port.ssrc;
   ops_rx.type = ST20_TYPE_FRAME_LEVEL;
+  if (ctx->slice_level) {
+    ops_rx.type = ST20_TYPE_SLICE_LEVEL;
+    ops_rx.slice_lines = ops->slice_lines;
+    ops_rx.notify_slice_ready = rx_st20p_slice_ready;
+    /* the slice mode of transport requires it, dropped in frame_ready if not wanted */
+    ops_rx.flags |= ST20_RX_FLAG_RECEIVE_INCOMPLETE_FRAME;
+  }
   ops_rx.framebuff_cnt = ops->framebuff_cnt;
   ops_rx.rx_burst_size = ops->rx_burst_size;
   ops_rx.notify_frame_ready = rx_st20p_frame_ready;
@@ -645,6 +842,16 @@ static int rx_st20p_uinit_dst_fbs(struct st20p_rx_ctx* ctx) {
         mt_rte_free(ctx->framebuffs[i].user_meta);
         ctx->framebuffs[i].user_meta = NULL;
       }
+      for (uint16_t j = 0; j < ST_FRAME_SCALE_OUTPUTS_MAX; j++) {
+        if (ctx->framebuffs[i].scaled[j].addr[0]) {
+          mt_rte_free(ctx->framebuffs[i].scaled[j].addr[0]);
+          ctx->framebuffs[i].scaled[j].addr[0] = NULL;
+        }
+      }
+      if (ctx->framebuffs[i].scale_line) {
+        mt_rte_free(ctx->framebuffs[i].scale_line);
+        ctx->framebuffs[i].scale_line = NULL;
+      }
     }
     mt_rte_free(ctx->framebuffs);
     ctx->framebuffs = NULL;
@@ -735,6 +942,25 @@ static int rx_st20p_init_dst_fbs(struct mtl_main_impl* impl, struct st20p_rx_ctx
   return 0;
 }
 
+static void rx_st20p_convert_select(struct mtl_main_impl* impl,
+                                    struct st20p_rx_ctx* ctx) {
+  struct st20p_rx_ops* ops = &ctx->ops;
+  struct st_convert_select_entry* sel = &ctx->convert_select;
+  int ret;
+
+  ret = st_convert_select(impl, ctx->internal_converter, ops->width, ops->height,
+                          ops->interlaced, ctx->socket_id, sel,
+                          &ctx->convert_select_cached);
+  if (ret < 0) {
+    warn("%s(%d), select fail %d, use the max simd level\n", __func__, ctx->idx, ret);
+    return;
+  }
+  ctx->convert_selected = true;
+  info("%s(%d), simd %s %" PRIu64 "ns, max level %" PRIu64 "ns, %s\n", __func__,
+       ctx->idx, mtl_get_simd_level_name(sel->level), sel->ns, sel->max_ns,
+       ctx->convert_select_cached ? "cached" : "benchmarked");
+}
+
 static int rx_st20p_get_converter(struct mtl_main_impl* impl, struct st20p_rx_ctx* ctx,
                                   struct st20p_rx_ops* ops) {
   int idx = ctx->idx;
@@ -769,7 +995,15 @@ static int rx_st20p_get_converter(struct mtl_main_impl* impl, struct st20p_rx_ct
       return -EIO;
     }
     ctx->internal_converter = converter;
-    info("%s(%d), use internal converter\n", __func__, idx);
+    if (ops->flags & ST20P_RX_FLAG_CONVERT_AUTO_SELECT)
+      rx_st20p_convert_select(impl, ctx);
+    if (ops->convert_parallel > 1) {
+      ctx->convert_pool = st_convert_pool_get(impl, ctx->socket_id);
+      if (!ctx->convert_pool)
+        warn("%s(%d), no convert pool, fallback to single thread\n", __func__, idx);
+    }
+    info("%s(%d), use internal converter, parallel %u\n", __func__, idx,
+         ctx->convert_pool ? ops->convert_parallel : 1);
     return 0;
   }
   ctx->convert_impl = convert_impl;
@@ -777,6 +1011,136 @@ static int rx_st20p_get_converter(struct mtl_main_impl* impl, struct st20p_rx_ct
   return 0;
 }
 
+static int rx_st20p_slice_init(struct st20p_rx_ctx* ctx) {
+  struct st20p_rx_ops* ops = &ctx->ops;
+  int idx = ctx->idx;
+
+  if (ctx->convert_impl) {
+    err("%s(%d), not support the plugin converter\n", __func__, idx);
+    return -EINVAL;
+  }
+  if (ops->flags & (ST20P_RX_FLAG_PKT_CONVERT | ST20P_RX_FLAG_EXT_FRAME)) {
+    err("%s(%d), not support pkt convert or ext frame\n", __func__, idx);
+    return -EINVAL;
+  }
+  ctx->slice_align = 1;
+  if (st_frame_fmt_get_sampling(ops->output_fmt) == ST_FRAME_SAMPLING_420) {
+    if (ops->slice_lines % 2) {
+      err("%s(%d), slice_lines %u not even for %s\n", __func__, idx, ops->slice_lines,
+          st_frame_fmt_name(ops->output_fmt));
+      return -EINVAL;
+    }
+    ctx->slice_align = 2;
+  }
+  ctx->slice_level = true;
+
+  info("%s(%d), slice lines %u\n", __func__, idx, ops->slice_lines);
+  return 0;
+}
+
+static int rx_st20p_scale_init(struct st20p_rx_ctx* ctx) {
+  struct st20p_rx_ops* ops = &ctx->ops;
+  int idx = ctx->idx;
+  uint32_t widths[ST_FRAME_SCALE_OUTPUTS_MAX];
+  uint32_t heights[ST_FRAME_SCALE_OUTPUTS_MAX];
+  uint32_t src_h = ops->interlaced ? ops->height / 2 : ops->height;
+
+  if (ops->scale_cnt > ST_FRAME_SCALE_OUTPUTS_MAX) {
+    err("%s(%d), invalid scale_cnt %u\n", __func__, idx, ops->scale_cnt);
+    return -EINVAL;
+  }
+  if (ops->flags & ST20P_RX_FLAG_AUTO_DETECT) {
+    err("%s(%d), not support auto detect\n", __func__, idx);
+    return -EINVAL;
+  }
+  if (!st_frame_scale_fmt_supported(ops->output_fmt)) {
+    err("%s(%d), output fmt %s not supported\n", __func__, idx,
+        st_frame_fmt_name(ops->output_fmt));
+    return -EINVAL;
+  }
+  for (uint16_t i = 0; i < ops->scale_cnt; i++) {
+    widths[i] = ops->scale_sizes[i].width;
+    heights[i] =
+        ops->interlaced ? ops->scale_sizes[i].height / 2 : ops->scale_sizes[i].height;
+  }
+  ctx->scaler = st_frame_scaler_create(ops->output_fmt, ops->width, src_h, widths,
+                                       heights, ops->scale_cnt, ops->scale_method);
+  if (!ctx->scaler) {
+    err("%s(%d), scaler create fail\n", __func__, idx);
+    return -EINVAL;
+  }
+
+  for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+    struct st20p_rx_frame* framebuff = &ctx->framebuffs[i];
+
+    size_t line_size = sizeof(*framebuff->scale_line) * ops->width;
+    framebuff->scale_line = mt_rte_zmalloc_socket(line_size, ctx->socket_id);
+    if (!framebuff->scale_line) {
+      err("%s(%d), scale line malloc fail at %u\n", __func__, idx, i);
+      return -ENOMEM;
+    }
+    for (uint16_t j = 0; j < ops->scale_cnt; j++) {
+      struct st_frame* scaled = &framebuff->scaled[j];
+      size_t size = st_frame_size(ops->output_fmt, ops->scale_sizes[j].width,
+                                  ops->scale_sizes[j].height, ops->interlaced);
+      void* addr = mt_rte_zmalloc_socket(size, ctx->socket_id);
+      if (!addr) {
+        err("%s(%d), scaled frame %u malloc fail at %u\n", __func__, idx, j, i);
+        return -ENOMEM;
+      }
+      scaled->fmt = ops->output_fmt;
+      scaled->interlaced = ops->interlaced;
+      scaled->width = ops->scale_sizes[j].width;
+      scaled->height = ops->scale_sizes[j].height;
+      scaled->buffer_size = size;
+      scaled->data_size = size;
+      st_frame_init_plane_single_src(scaled, addr, mtl_hp_virt2iova(ctx->impl, addr));
+      scaled->priv = framebuff;
+    }
+  }
+
+  info("%s(%d), %u outputs, method %d\n", __func__, idx, ops->scale_cnt,
+       ops->scale_method);
+  return 0;
+}
+
+/* scale the dst to all the auxiliary outputs in one pass */
+static void rx_st20p_scale(struct st20p_rx_ctx* ctx, struct st20p_rx_frame* framebuff) {
+  struct st_frame* dsts[ST_FRAME_SCALE_OUTPUTS_MAX];
+  struct st_frame* frame = &framebuff->dst;
+  int ret;
+
+  for (uint16_t i = 0; i < ctx->ops.scale_cnt; i++) {
+    struct st_frame* scaled = &framebuff->scaled[i];
+    scaled->second_field = frame->second_field;
+    scaled->tfmt = frame->tfmt;
+    scaled->timestamp = frame->timestamp;
+    scaled->rtp_timestamp = frame->rtp_timestamp;
+    scaled->status = frame->status;
+    dsts[i] = scaled;
+  }
+  /* get_frame may run on several app threads, each framebuff has its own line */
+  ret = st_frame_scaler_run_line(ctx->scaler, frame, dsts, framebuff->scale_line);
+  if (ret < 0) {
+    dbg("%s(%d), frame %u scale fail %d\n", __func__, ctx->idx, framebuff->idx, ret);
+    framebuff->scaled_ok = false;
+    ctx->stat_scale_fail++;
+    return;
+  }
+  framebuff->scaled_ok = true;
+  ctx->stat_scaled++;
+}
+
+static int rx_st20p_internal_convert(struct st20p_rx_ctx* ctx,
+                                     struct st20p_rx_frame* framebuff) {
+  if (ctx->convert_pool)
+    return st_convert_pool_run(ctx->convert_pool, ctx->internal_converter,
+                               &framebuff->src, &framebuff->dst,
+                               ctx->ops.convert_parallel);
+  return st_frame_converter_convert(ctx->internal_converter, &framebuff->src,
+                                    &framebuff->dst);
+}
+
 static int rx_st20p_stat(void* priv) {
   struct st20p_rx_ctx* ctx = priv;
   struct st20p_rx_frame* framebuff = ctx->framebuffs;
@@ -798,9 +1162,27 @@ static int rx_st20p_stat(void* priv) {
 
   notice("RX_st20p(%d), frame get try %d succ %d, put %d\n", ctx->idx,
          ctx->stat_get_frame_try, ctx->stat_get_frame_succ, ctx->stat_put_frame);
+  if (ctx->convert_selected) {
+    struct st_convert_select_entry* sel = &ctx->convert_select;
+    notice("RX_st20p(%d), convert simd %s %" PRIu64 "ns, max level %" PRIu64 "ns, %s\n",
+           ctx->idx, mtl_get_simd_level_name(sel->level), sel->ns, sel->max_ns,
+           ctx->convert_select_cached ? "cached" : "benchmarked");
+  }
   ctx->stat_get_frame_try = 0;
   ctx->stat_get_frame_succ = 0;
   ctx->stat_put_frame = 0;
+  if (ctx->slice_level) {
+    notice("RX_st20p(%d), slices %u busy %u\n", ctx->idx, ctx->stat_slices,
+           ctx->stat_slices_busy);
+    ctx->stat_slices = 0;
+    ctx->stat_slices_busy = 0;
+  }
+  if (ctx->scaler) {
+    notice("RX_st20p(%d), scaled %u fail %u\n", ctx->idx, ctx->stat_scaled,
+           ctx->stat_scale_fail);
+    ctx->stat_scaled = 0;
+    ctx->stat_scale_fail = 0;
+  }
 
   return 0;
 }
@@ -850,7 +1232,7 @@ struct st_frame* st20p_rx_get_frame(st20p_rx_handle handle) {
 
   ctx->stat_get_frame_try++;
 
-  if (ctx->internal_converter) { /* convert internal */
+  if (ctx->internal_converter && !ctx->slice_level) { /* convert internal */
     /* Claim READY->IN_USER before converting so no other consumer can take this
      * slot. rx_st20p_claim_available() retries across the ring on a lost CAS
      * race, so it only returns NULL once every slot has actually been checked. */
@@ -875,7 +1257,7 @@ struct st_frame* st20p_rx_get_frame(st20p_rx_handle handle) {
     if (!framebuff) {
       goto out;
     }
-    ctx->internal_converter->convert_func(&framebuff->src, &framebuff->dst);
+    rx_st20p_internal_convert(ctx, framebuff);
   } else {
     framebuff =
         rx_st20p_claim_available(ctx, ctx->framebuff_consumer_idx,
@@ -907,6 +1289,7 @@ struct st_frame* st20p_rx_get_frame(st20p_rx_handle handle) {
 
   dbg("%s(%d), frame %u succ\n", __func__, idx, framebuff->idx);
   frame = &framebuff->dst;
+  if (ctx->scaler) rx_st20p_scale(ctx, framebuff);
   if (framebuff->user_meta_data_size) {
     frame->user_meta = framebuff->user_meta;
     frame->user_meta_size = framebuff->user_meta_data_size;
@@ -934,6 +1317,60 @@ out:
   return frame;
 }
 
+struct st_frame* st20p_rx_get_slice(st20p_rx_handle handle, uint32_t* lines_ready) {
+  struct st20p_rx_ctx* ctx = handle;
+  struct st20p_rx_frame* framebuff;
+  struct st_frame* frame = NULL;
+  uint16_t idx;
+
+  MT_HANDLE_GUARD(ctx, MT_ST20_HANDLE_PIPELINE_RX, NULL);
+
+  if (!ctx->ready || !ctx->slice_level) goto out;
+
+  /* the receiving frames are claimed in order from the consumer position */
+  idx = ctx->framebuff_consumer_idx;
+  for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+    framebuff = &ctx->framebuffs[idx];
+    idx = rx_st20p_next_idx(ctx, idx);
+    if (atomic_load_explicit(&framebuff->stat, memory_order_acquire) !=
+        ST20P_RX_FRAME_IN_CONVERTING)
+      continue;
+    uint32_t lines = atomic_load_explicit(&framebuff->lines_ready, memory_order_acquire);
+    if (!lines) continue;
+    *lines_ready = lines;
+    frame = &framebuff->dst;
+    break;
+  }
+
+out:
+  MT_HANDLE_RELEASE(ctx);
+  return frame;
+}
+
+struct st_frame* st20p_rx_get_scaled_frame(st20p_rx_handle handle, struct st_frame* frame,
+                                           uint16_t idx) {
+  struct st20p_rx_ctx* ctx = handle;
+  struct st20p_rx_frame* framebuff = frame->priv;
+  struct st_frame* scaled = NULL;
+
+  MT_HANDLE_GUARD(ctx, MT_ST20_HANDLE_PIPELINE_RX, NULL);
+
+  if (!ctx->scaler || idx >= ctx->ops.scale_cnt) {
+    err("%s(%d), invalid scale idx %u\n", __func__, ctx->idx, idx);
+    goto out;
+  }
+  if (ST20P_RX_FRAME_IN_USER !=
+      atomic_load_explicit(&framebuff->stat, memory_order_acquire)) {
+    err("%s(%d), frame %u not in user\n", __func__, ctx->idx, framebuff->idx);
+    goto out;
+  }
+  if (framebuff->scaled_ok) scaled = &framebuff->scaled[idx];
+
+out:
+  MT_HANDLE_RELEASE(ctx);
+  return scaled;
+}
+
 int st20p_rx_put_frame(st20p_rx_handle handle, struct st_frame* frame) {
   struct st20p_rx_ctx* ctx = handle;
   int idx = ctx->idx;
@@ -1083,6 +1520,15 @@ st20p_rx_handle st20p_rx_create(mtl_handle mt, struct st20p_rx_ops* ops) {
     }
   }
 
+  if (ops->flags & ST20P_RX_FLAG_SLICE_LEVEL) {
+    ret = rx_st20p_slice_init(ctx);
+    if (ret < 0) {
+      err("%s(%d), slice init fail %d\n", __func__, idx, ret);
+      st20p_rx_free(ctx);
+      return NULL;
+    }
+  }
+
   /* init fbs */
   ret = rx_st20p_init_dst_fbs(impl, ctx, ops);
   if (ret < 0) {
@@ -1091,6 +1537,15 @@ st20p_rx_handle st20p_rx_create(mtl_handle mt, struct st20p_rx_ops* ops) {
     return NULL;
   }
 
+  if (ops->scale_cnt) {
+    ret = rx_st20p_scale_init(ctx);
+    if (ret < 0) {
+      err("%s(%d), scale init fail %d\n", __func__, idx, ret);
+      st20p_rx_free(ctx);
+      return NULL;
+    }
+  }
+
   /* crete transport handle */
   ret = rx_st20p_create_transport(impl, ctx, ops);
   if (ret < 0) {
@@ -1148,6 +1603,11 @@ int st20p_rx_free(st20p_rx_handle handle) {
   }
   rx_st20p_uinit_dst_fbs(ctx);
 
+  if (ctx->scaler) {
+    st_frame_scaler_free(ctx->scaler);
+    ctx->scaler = NULL;
+  }
+
   mt_pthread_mutex_destroy(&ctx->block_wake_mutex);
   mt_pthread_cond_destroy(&ctx->block_wake_cond);
   notice("%s(%d), succ\n", __func__, ctx->idx);
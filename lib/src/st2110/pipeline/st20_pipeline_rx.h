@@ -6,6 +6,7 @@
 #define _ST_LIB_PIPELINE_ST20_RX_HEAD_H_
 
 #include "../st_main.h"
+#include "../st_scale.h"
 #include "st_plugin.h"
 
 enum st20p_rx_frame_status {
@@ -27,6 +28,21 @@ struct st20p_rx_frame {
   size_t user_meta_buffer_size;
   size_t user_meta_data_size;
   struct st20_rx_tp_meta tp[MTL_SESSION_PORT_MAX];
+  /* ST20P_RX_FLAG_SLICE_LEVEL, lines of dst ready while in converting */
+  _Atomic uint32_t lines_ready;
+  /*
+   * ST20P_RX_FLAG_PKT_CONVERT to 420, the even row of the current line pair, its
+   * pixels parked and the pixels converted with the odd row. pair_broken if the odd
+   * row didn't match the parked pixels, the frame is incomplete then.
+   */
+  uint32_t pair_row;
+  uint32_t pair_parked;
+  uint32_t pair_done;
+  bool pair_broken;
+  /* the downscaled auxiliary outputs of dst */
+  struct st_frame scaled[ST_FRAME_SCALE_OUTPUTS_MAX];
+  bool scaled_ok;
+  int32_t* scale_line; /* the scaler work line, width samples */
 };
 
 /* IMPORTANT: After st20p_rx_free() returns, this->transport (and other
@@ -65,9 +81,17 @@ struct st20p_rx_ctx {
 
   struct st20_convert_session_impl* convert_impl;
   struct st_frame_converter* internal_converter;
+  struct st_convert_pool* convert_pool; /* band split the internal converter */
+  /* the simd level selected for the internal converter by the benchmark */
+  bool convert_selected;
+  bool convert_select_cached;
+  struct st_convert_select_entry convert_select;
   bool ready;
   bool derive;
   bool dynamic_ext_frame;
+  bool slice_level;    /* ST20P_RX_FLAG_SLICE_LEVEL */
+  uint32_t slice_align; /* 2 for the 420 output, the chroma line is shared */
+  struct st_frame_scaler* scaler; /* the auxiliary outputs, NULL if no scale_cnt */
 
   size_t dst_size;
 
@@ -77,6 +101,10 @@ struct st20p_rx_ctx {
   uint32_t stat_get_frame_try;
   uint32_t stat_get_frame_succ;
   uint32_t stat_put_frame;
+  uint32_t stat_slices;
+  uint32_t stat_slices_busy;
+  uint32_t stat_scaled;
+  uint32_t stat_scale_fail;
   /* cumulative user-facing counters; reset only by reset_session_stats */
   uint64_t stat_frames_received;
   uint64_t stat_frames_dropped;
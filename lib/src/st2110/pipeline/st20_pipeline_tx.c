@@ -7,6 +7,8 @@
 #include "../../mt_handle_guard.h"
 #include "../../mt_log.h"
 #include "../../mt_stat.h"
+#include "st_convert_pool.h"
+#include "st_convert_select.h"
 
 static const char* st20p_tx_frame_stat_name[ST20P_TX_FRAME_STATUS_MAX] = {
     "free",    "ready",   "in_converting",   "converted",
@@ -45,49 +47,39 @@ static void tx_st20p_notify_frame_available(struct st20p_tx_ctx* ctx) {
   }
 }
 
-static struct st20p_tx_frame* tx_st20p_next_available(
-    struct st20p_tx_ctx* ctx, enum st20p_tx_frame_status desired) {
-  struct st20p_tx_frame* framebuff;
-
-  /* check ready frame from start */
-  for (int idx = 0; idx < ctx->framebuff_cnt; idx++) {
-    framebuff = &ctx->framebuffs[idx];
-    if (desired == atomic_load_explicit(&framebuff->stat, memory_order_acquire)) {
-      return framebuff;
-    }
-  }
-
-  return NULL;
+static void tx_st20p_queue_put(struct st20p_tx_ctx* ctx, struct rte_ring* queue,
+                               struct st20p_tx_frame* framebuff) {
+  /* never full as a framebuff is queued only once when it enters the status */
+  if (st_frame_queue_put(queue, framebuff) < 0)
+    err("%s(%d), queue full for frame %u\n", __func__, ctx->idx, framebuff->idx);
 }
 
-static struct st20p_tx_frame* tx_st20p_newest_available(
-    struct st20p_tx_ctx* ctx, enum st20p_tx_frame_status desired) {
-  struct st20p_tx_frame* framebuff = NULL;
-  struct st20p_tx_frame* framebuff_newest = NULL;
-
-  for (uint16_t idx = 0; idx < ctx->framebuff_cnt; idx++) {
-    framebuff = &ctx->framebuffs[idx];
-    if ((desired == atomic_load_explicit(&framebuff->stat, memory_order_acquire) &&
-         (!framebuff_newest ||
-          !mt_seq32_greater(framebuff->seq_number, framebuff_newest->seq_number)))) {
-      framebuff_newest = framebuff;
-    }
-  }
-
-  return framebuff_newest;
+/* Store the status and queue the framebuff if the status has a consumer: FREE for
+ * get_frame, READY for the converter and CONVERTED for the transport. */
+static void tx_st20p_set_stat(struct st20p_tx_ctx* ctx, struct st20p_tx_frame* framebuff,
+                              enum st20p_tx_frame_status stat) {
+  struct rte_ring* queue = NULL;
+
+  atomic_store_explicit(&framebuff->stat, stat, memory_order_release);
+  if (stat == ST20P_TX_FRAME_FREE)
+    queue = ctx->free_queue;
+  else if (stat == ST20P_TX_FRAME_READY)
+    queue = ctx->ready_queue;
+  else if (stat == ST20P_TX_FRAME_CONVERTED)
+    queue = ctx->converted_queue;
+  if (queue) tx_st20p_queue_put(ctx, queue, framebuff);
 }
 
-/* Scan for a framebuff in state `desired` and atomically claim it by
- * transitioning it to `claimed`. A concurrent thread can win the race on the
- * scanned candidate between the scan and the claim; on a lost race this keeps
- * scanning instead of giving up, so the caller only sees NULL once every slot
- * has genuinely been checked and found unavailable. */
-static struct st20p_tx_frame* tx_st20p_claim_available(
-    struct st20p_tx_ctx* ctx, enum st20p_tx_frame_status desired,
+/* Get framebuffs from the queue of `desired` in fifo order and atomically claim the
+ * first one by transitioning it to `claimed`. An entry which fails the CAS was already
+ * moved out of `desired` by a direct status write, it is dropped and the next entry is
+ * tried, so the caller only sees NULL once the queue is really empty. */
+static struct st20p_tx_frame* tx_st20p_claim_queued(
+    struct rte_ring* queue, enum st20p_tx_frame_status desired,
     enum st20p_tx_frame_status claimed) {
   struct st20p_tx_frame* framebuff;
 
-  while ((framebuff = tx_st20p_next_available(ctx, desired))) {
+  while ((framebuff = st_frame_queue_get(queue))) {
     uint32_t expected = desired;
     if (atomic_compare_exchange_strong_explicit(&framebuff->stat, &expected, claimed,
                                                 memory_order_acq_rel,
@@ -98,7 +90,8 @@ static struct st20p_tx_frame* tx_st20p_claim_available(
   return NULL;
 }
 
-/* Check if a CONVERTED frame is late.
+/* Check if the oldest CONVERTED frame, already claimed to IN_TRANSMITTING from the
+ * converted queue, is late.
  *
  * If late, the sequence is:
  *   1. Park as DROPPED — invisible to both next_frame (CONVERTED) and
@@ -168,9 +161,8 @@ static bool tx_st20p_if_frame_late(struct st20p_tx_ctx* ctx,
 
   /* ext_frame derive: park in IN_USER until app calls
    * st20p_tx_notify_ext_frame_free */
-  atomic_store_explicit(&framebuff->stat,
-                        need_in_user ? ST20P_TX_FRAME_IN_USER : ST20P_TX_FRAME_FREE,
-                        memory_order_release);
+  tx_st20p_set_stat(ctx, framebuff,
+                    need_in_user ? ST20P_TX_FRAME_IN_USER : ST20P_TX_FRAME_FREE);
 
   if (!need_in_user) {
     tx_st20p_notify_frame_available(ctx);
@@ -188,39 +180,26 @@ static int tx_st20p_next_frame(void* priv, uint16_t* next_frame_idx,
 
   if (!ctx->ready) return -EBUSY; /* not ready */
 
+  /* Claim the oldest CONVERTED -> IN_TRANSMITTING, the late check runs on the claimed
+   * frame so a concurrent transport thread never sees it. */
   while (1) {
-    framebuff = tx_st20p_newest_available(ctx, ST20P_TX_FRAME_CONVERTED);
-    if (!framebuff) break; /* no converted frame available */
-
-    if (tx_st20p_if_frame_late(ctx, framebuff)) {
-      /* frame missed its TX window and was dropped; cap the batch then rescan */
-      if (++drop_cnt >= ST_TX_DROP_MAX_BATCH) {
-        info("%s(%d), max drop batch %d reached, stopping\n", __func__, ctx->idx,
-             drop_cnt);
-        framebuff = NULL;
-        break;
-      }
-      continue;
+    if (drop_cnt >= ST_TX_DROP_MAX_BATCH) {
+      info("%s(%d), max drop batch %d reached, stopping\n", __func__, ctx->idx, drop_cnt);
+      framebuff = NULL;
+      break;
     }
-
-    /* Claim CONVERTED -> IN_TRANSMITTING atomically. newest_available() is a
-     * lock-free scan, so between it and here the slot may have been taken by a
-     * late-drop or (defensively) another consumer; on a lost race the CAS fails
-     * and we rescan for another CONVERTED frame. Mirrors the FREE->IN_USER and
-     * READY->IN_CONVERTING claims. */
-    uint32_t expected = ST20P_TX_FRAME_CONVERTED;
-    if (atomic_compare_exchange_strong_explicit(
-            &framebuff->stat, &expected, ST20P_TX_FRAME_IN_TRANSMITTING,
-            memory_order_acq_rel, memory_order_relaxed))
-      break; /* claimed */
+    framebuff = tx_st20p_claim_queued(ctx->converted_queue, ST20P_TX_FRAME_CONVERTED,
+                                      ST20P_TX_FRAME_IN_TRANSMITTING);
+    if (!framebuff) break; /* no converted frame available */
+    if (!tx_st20p_if_frame_late(ctx, framebuff)) break;
+    drop_cnt++;
   }
 
   if (!framebuff) {
     /* When drop-when-late is active, ensure the app knows about free slots so it
      * can refill the pipeline promptly after drops freed frames. */
     if (ctx->ops.flags & ST20P_TX_FLAG_DROP_WHEN_LATE) {
-      if (tx_st20p_next_available(ctx, ST20P_TX_FRAME_FREE))
-        tx_st20p_notify_frame_available(ctx);
+      if (st_frame_queue_count(ctx->free_queue)) tx_st20p_notify_frame_available(ctx);
     }
     return -EBUSY;
   }
@@ -268,9 +247,8 @@ static int tx_st20p_frame_done(void* priv, uint16_t frame_idx,
   if (ST20P_TX_FRAME_IN_TRANSMITTING ==
       atomic_load_explicit(&framebuff->stat, memory_order_acquire)) {
     ret = 0;
-    atomic_store_explicit(&framebuff->stat,
-                          need_in_user ? ST20P_TX_FRAME_IN_USER : ST20P_TX_FRAME_FREE,
-                          memory_order_release);
+    tx_st20p_set_stat(ctx, framebuff,
+                      need_in_user ? ST20P_TX_FRAME_IN_USER : ST20P_TX_FRAME_FREE);
     dbg("%s(%d), frame_idx: %u\n", __func__, ctx->idx, frame_idx);
   } else {
     ret = -EIO;
@@ -309,6 +287,38 @@ static int tx_st20p_notify_event(void* priv, enum st_event event, void* args) {
   return 0;
 }
 
+static int tx_st20p_packet_convert(void* priv, uint16_t frame_idx,
+                                   struct st20_tx_uframe_pg_meta* meta) {
+  struct st20p_tx_ctx* ctx = priv;
+  struct st20p_tx_frame* framebuff = &ctx->framebuffs[frame_idx];
+  struct st_frame* src = &framebuff->src;
+  struct st20_rfc4175_422_10_pg2_be* dst = meta->payload;
+  uint32_t w = meta->pg_cnt * 2; /* 2 pixels per pg */
+  int ret = -EIO;
+
+  if (ctx->ops.input_fmt == ST_FRAME_FMT_YUV422PLANAR10LE ||
+      ctx->ops.input_fmt == ST_FRAME_FMT_YUV422PLANAR16LE) {
+    uint8_t* y = (uint8_t*)src->addr[0] + src->linesize[0] * meta->row_number +
+                 meta->row_offset * 2;
+    uint8_t* b = (uint8_t*)src->addr[1] + src->linesize[1] * meta->row_number +
+                 meta->row_offset;
+    uint8_t* r = (uint8_t*)src->addr[2] + src->linesize[2] * meta->row_number +
+                 meta->row_offset;
+    if (ctx->ops.input_fmt == ST_FRAME_FMT_YUV422PLANAR10LE)
+      ret = st20_yuv422p10le_to_rfc4175_422be10((uint16_t*)y, (uint16_t*)b,
+                                                (uint16_t*)r, dst, w, 1);
+    else
+      ret = st20_yuv422p16le_to_rfc4175_422be10((uint16_t*)y, (uint16_t*)b,
+                                                (uint16_t*)r, dst, w, 1);
+  } else if (ctx->ops.input_fmt == ST_FRAME_FMT_Y210) {
+    uint8_t* y210 = (uint8_t*)src->addr[0] + src->linesize[0] * meta->row_number +
+                    meta->row_offset * 4;
+    ret = st20_y210_to_rfc4175_422be10((uint16_t*)y210, dst, w, 1);
+  }
+
+  return ret;
+}
+
 static struct st20_convert_frame_meta* tx_st20p_convert_get_frame(void* priv) {
   struct st20p_tx_ctx* ctx = priv;
   int idx = ctx->idx;
@@ -320,18 +330,9 @@ static struct st20_convert_frame_meta* tx_st20p_convert_get_frame(void* priv) {
 
   if (!ctx->ready) goto out; /* not ready */
 
-  /* Claim the oldest READY -> IN_CONVERTING.  newest_available() picks by
-   * seq_number to preserve conversion order; a concurrent converter thread may
-   * have already taken the picked slot between the scan and the CAS, so on a
-   * lost race rescan rather than giving up -- otherwise a losing thread would
-   * report "no frame" even though other READY frames remain. */
-  while ((framebuff = tx_st20p_newest_available(ctx, ST20P_TX_FRAME_READY))) {
-    uint32_t expected_stat = ST20P_TX_FRAME_READY;
-    if (atomic_compare_exchange_strong_explicit(
-            &framebuff->stat, &expected_stat, ST20P_TX_FRAME_IN_CONVERTING,
-            memory_order_acq_rel, memory_order_relaxed))
-      break;
-  }
+  /* Claim the oldest READY -> IN_CONVERTING from the ready queue, in put order. */
+  framebuff = tx_st20p_claim_queued(ctx->ready_queue, ST20P_TX_FRAME_READY,
+                                    ST20P_TX_FRAME_IN_CONVERTING);
   /* not any ready frame */
   if (!framebuff) {
     goto out;
@@ -368,14 +369,13 @@ static int tx_st20p_convert_put_frame(void* priv, struct st20_convert_frame_meta
     dbg("%s(%d), frame %u result %d data_size %" PRIu64 ", frame_idx: %u\n", __func__,
         idx, convert_idx, result, data_size, convert_idx);
 
-    atomic_store_explicit(&framebuff->stat, ST20P_TX_FRAME_FREE, memory_order_release);
+    tx_st20p_set_stat(ctx, framebuff, ST20P_TX_FRAME_FREE);
 
     /* notify app can get frame */
     tx_st20p_notify_frame_available(ctx);
     rte_atomic32_inc(&ctx->stat_convert_fail);
   } else {
-    atomic_store_explicit(&framebuff->stat, ST20P_TX_FRAME_CONVERTED,
-                          memory_order_release);
+    tx_st20p_set_stat(ctx, framebuff, ST20P_TX_FRAME_CONVERTED);
   }
 
   if (ctx->ops.notify_frame_done && !framebuff->frame_done_cb_called) {
@@ -479,6 +479,7 @@ static int tx_st20p_create_transport(struct mtl_main_impl* impl, struct st20p_tx
     ops_tx.socket_id = ops->socket_id;
     ops_tx.flags |= ST20_TX_FLAG_FORCE_NUMA;
   }
+  if (ctx->pkt_convert) ops_tx.uframe_pg_callback = tx_st20p_packet_convert;
 
   transport = st20_tx_create(impl, &ops_tx);
   if (!transport) {
@@ -489,7 +490,7 @@ static int tx_st20p_create_transport(struct mtl_main_impl* impl, struct st20p_tx
 
   struct st20p_tx_frame* frames = ctx->framebuffs;
   for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
-    if (ctx->derive && ops->flags & ST20P_TX_FLAG_EXT_FRAME) {
+    if ((ctx->derive && ops->flags & ST20P_TX_FLAG_EXT_FRAME) || ctx->pkt_convert) {
       frames[i].dst.addr[0] = NULL;
     } else {
       frames[i].dst.addr[0] = st20_tx_get_framebuffer(transport, i);
@@ -538,6 +539,18 @@ static int tx_st20p_uinit_src_fbs(struct st20p_tx_ctx* ctx) {
     mt_rte_free(ctx->framebuffs);
     ctx->framebuffs = NULL;
   }
+  if (ctx->free_queue) {
+    st_frame_queue_free(ctx->free_queue);
+    ctx->free_queue = NULL;
+  }
+  if (ctx->ready_queue) {
+    st_frame_queue_free(ctx->ready_queue);
+    ctx->ready_queue = NULL;
+  }
+  if (ctx->converted_queue) {
+    st_frame_queue_free(ctx->converted_queue);
+    ctx->converted_queue = NULL;
+  }
 
   return 0;
 }
@@ -558,9 +571,19 @@ static int tx_st20p_init_src_fbs(struct mtl_main_impl* impl, struct st20p_tx_ctx
   }
   ctx->framebuffs = frames;
 
+  ctx->free_queue = st_frame_queue_create("st20p_tx_free", ctx->framebuff_cnt, soc_id);
+  ctx->ready_queue = st_frame_queue_create("st20p_tx_ready", ctx->framebuff_cnt, soc_id);
+  ctx->converted_queue =
+      st_frame_queue_create("st20p_tx_converted", ctx->framebuff_cnt, soc_id);
+  if (!ctx->free_queue || !ctx->ready_queue || !ctx->converted_queue) {
+    err("%s(%d), frame queue create fail\n", __func__, idx);
+    tx_st20p_uinit_src_fbs(ctx);
+    return -ENOMEM;
+  }
+
   for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
-    atomic_store_explicit(&frames[i].stat, ST20P_TX_FRAME_FREE, memory_order_relaxed);
     frames[i].idx = i;
+    tx_st20p_set_stat(ctx, &frames[i], ST20P_TX_FRAME_FREE);
     frames[i].src.fmt = ops->input_fmt;
     frames[i].src.interlaced = ops->interlaced;
     frames[i].src.width = ops->width;
@@ -609,6 +632,25 @@ static int tx_st20p_init_src_fbs(struct mtl_main_impl* impl, struct st20p_tx_ctx
   return 0;
 }
 
+static void tx_st20p_convert_select(struct mtl_main_impl* impl,
+                                    struct st20p_tx_ctx* ctx) {
+  struct st20p_tx_ops* ops = &ctx->ops;
+  struct st_convert_select_entry* sel = &ctx->convert_select;
+  int ret;
+
+  ret = st_convert_select(impl, ctx->internal_converter, ops->width, ops->height,
+                          ops->interlaced, ctx->socket_id, sel,
+                          &ctx->convert_select_cached);
+  if (ret < 0) {
+    warn("%s(%d), select fail %d, use the max simd level\n", __func__, ctx->idx, ret);
+    return;
+  }
+  ctx->convert_selected = true;
+  info("%s(%d), simd %s %" PRIu64 "ns, max level %" PRIu64 "ns, %s\n", __func__,
+       ctx->idx, mtl_get_simd_level_name(sel->level), sel->ns, sel->max_ns,
+       ctx->convert_select_cached ? "cached" : "benchmarked");
+}
+
 static int tx_st20p_get_converter(struct mtl_main_impl* impl, struct st20p_tx_ctx* ctx,
                                   struct st20p_tx_ops* ops) {
   int idx = ctx->idx;
@@ -643,7 +685,15 @@ static int tx_st20p_get_converter(struct mtl_main_impl* impl, struct st20p_tx_ct
       return -EIO;
     }
     ctx->internal_converter = converter;
-    info("%s(%d), use internal converter\n", __func__, idx);
+    if (ops->flags & ST20P_TX_FLAG_CONVERT_AUTO_SELECT)
+      tx_st20p_convert_select(impl, ctx);
+    if (ops->convert_parallel > 1) {
+      ctx->convert_pool = st_convert_pool_get(impl, ctx->socket_id);
+      if (!ctx->convert_pool)
+        warn("%s(%d), no convert pool, fallback to single thread\n", __func__, idx);
+    }
+    info("%s(%d), use internal converter, parallel %u\n", __func__, idx,
+         ctx->convert_pool ? ops->convert_parallel : 1);
     return 0;
   }
   ctx->convert_impl = convert_impl;
@@ -651,6 +701,16 @@ static int tx_st20p_get_converter(struct mtl_main_impl* impl, struct st20p_tx_ct
   return 0;
 }
 
+static int tx_st20p_internal_convert(struct st20p_tx_ctx* ctx,
+                                     struct st20p_tx_frame* framebuff) {
+  if (ctx->convert_pool)
+    return st_convert_pool_run(ctx->convert_pool, ctx->internal_converter,
+                               &framebuff->src, &framebuff->dst,
+                               ctx->ops.convert_parallel);
+  return st_frame_converter_convert(ctx->internal_converter, &framebuff->src,
+                                    &framebuff->dst);
+}
+
 static int tx_st20p_stat(void* priv) {
   struct st20p_tx_ctx* ctx = priv;
   struct st20p_tx_frame* framebuff = ctx->framebuffs;
@@ -681,6 +741,12 @@ static int tx_st20p_stat(void* priv) {
   notice("TX_st20p(%d), frame get try %d succ %d, put %d, drop %d\n", ctx->idx,
          ctx->stat_get_frame_try, ctx->stat_get_frame_succ, ctx->stat_put_frame,
          ctx->stat_drop_frame);
+  if (ctx->convert_selected) {
+    struct st_convert_select_entry* sel = &ctx->convert_select;
+    notice("TX_st20p(%d), convert simd %s %" PRIu64 "ns, max level %" PRIu64 "ns, %s\n",
+           ctx->idx, mtl_get_simd_level_name(sel->level), sel->ns, sel->max_ns,
+           ctx->convert_select_cached ? "cached" : "benchmarked");
+  }
   ctx->stat_get_frame_try = 0;
   ctx->stat_get_frame_succ = 0;
   ctx->stat_put_frame = 0;
@@ -767,11 +833,9 @@ struct st_frame* st20p_tx_get_frame(st20p_tx_handle handle) {
 
   ctx->stat_get_frame_try++;
 
-  /* Claim FREE->IN_USER. tx_st20p_claim_available() retries across the ring
-   * on a lost CAS race, so it only returns NULL once every slot has actually
-   * been checked -- unlike a scan-then-single-CAS-attempt, which could give up
-   * even while other FREE frames remain (spurious failure under contention). */
-  framebuff = tx_st20p_claim_available(ctx, ST20P_TX_FRAME_FREE, ST20P_TX_FRAME_IN_USER);
+  /* Claim FREE->IN_USER from the free queue, O(1) regardless of framebuff_cnt. */
+  framebuff =
+      tx_st20p_claim_queued(ctx->free_queue, ST20P_TX_FRAME_FREE, ST20P_TX_FRAME_IN_USER);
   if (!framebuff && ctx->block_get) { /* wait here */
     mt_pthread_mutex_lock(&ctx->block_wake_mutex);
     while (!ctx->block_wake_pending &&
@@ -784,8 +848,8 @@ struct st_frame* st20p_tx_get_frame(st20p_tx_handle handle) {
     mt_pthread_mutex_unlock(&ctx->block_wake_mutex);
     if (atomic_load_explicit(&ctx->lc_destroying, memory_order_acquire)) goto out;
     /* get again */
-    framebuff =
-        tx_st20p_claim_available(ctx, ST20P_TX_FRAME_FREE, ST20P_TX_FRAME_IN_USER);
+    framebuff = tx_st20p_claim_queued(ctx->free_queue, ST20P_TX_FRAME_FREE,
+                                      ST20P_TX_FRAME_IN_USER);
   }
   /* not any free frame */
   if (!framebuff) {
@@ -840,7 +904,7 @@ int st20p_tx_put_frame(st20p_tx_handle handle, struct st_frame* frame) {
     if (frame->user_meta_size > framebuff->user_meta_buffer_size) {
       err("%s(%d), frame %u user meta size %" PRId64 " too large\n", __func__, idx,
           producer_idx, frame->user_meta_size);
-      atomic_store_explicit(&framebuff->stat, ST20P_TX_FRAME_FREE, memory_order_release);
+      tx_st20p_set_stat(ctx, framebuff, ST20P_TX_FRAME_FREE);
       ret = -EIO;
       goto out;
     }
@@ -855,14 +919,12 @@ int st20p_tx_put_frame(st20p_tx_handle handle, struct st_frame* frame) {
   }
 
   if (ctx->internal_converter) { /* convert internal */
-    ctx->internal_converter->convert_func(&framebuff->src, &framebuff->dst);
-    atomic_store_explicit(&framebuff->stat, ST20P_TX_FRAME_CONVERTED,
-                          memory_order_release);
-  } else if (ctx->derive) {
-    atomic_store_explicit(&framebuff->stat, ST20P_TX_FRAME_CONVERTED,
-                          memory_order_release);
+    tx_st20p_internal_convert(ctx, framebuff);
+    tx_st20p_set_stat(ctx, framebuff, ST20P_TX_FRAME_CONVERTED);
+  } else if (ctx->derive || ctx->pkt_convert) {
+    tx_st20p_set_stat(ctx, framebuff, ST20P_TX_FRAME_CONVERTED);
   } else {
-    atomic_store_explicit(&framebuff->stat, ST20P_TX_FRAME_READY, memory_order_release);
+    tx_st20p_set_stat(ctx, framebuff, ST20P_TX_FRAME_READY);
     st20_convert_notify_frame_ready(ctx->convert_impl);
   }
   ctx->stat_put_frame++;
@@ -902,7 +964,7 @@ int st20p_tx_put_frame_abort(st20p_tx_handle handle, struct st_frame* frame) {
     goto out;
   }
 
-  atomic_store_explicit(&framebuff->stat, ST20P_TX_FRAME_FREE, memory_order_release);
+  tx_st20p_set_stat(ctx, framebuff, ST20P_TX_FRAME_FREE);
   ctx->stat_drop_frame++;
   atomic_fetch_add_explicit(&ctx->stat_frames_dropped, 1, memory_order_relaxed);
   dbg("%s(%d), frame %u aborted\n", __func__, idx, producer_idx);
@@ -956,8 +1018,7 @@ int st20p_tx_put_ext_frame(st20p_tx_handle handle, struct st_frame* frame,
     framebuff->dst.iova[0] = ext_frame->iova[0];
     framebuff->dst.opaque = ext_frame->opaque;
     framebuff->dst.flags |= ST_FRAME_FLAG_EXT_BUF;
-    atomic_store_explicit(&framebuff->stat, ST20P_TX_FRAME_CONVERTED,
-                          memory_order_release);
+    tx_st20p_set_stat(ctx, framebuff, ST20P_TX_FRAME_CONVERTED);
   } else {
     for (int plane = 0; plane < planes; plane++) {
       framebuff->src.addr[plane] = ext_frame->addr[plane];
@@ -975,17 +1036,19 @@ int st20p_tx_put_ext_frame(st20p_tx_handle handle, struct st_frame* frame,
       goto out;
     }
     if (ctx->internal_converter) { /* convert internal */
-      ctx->internal_converter->convert_func(&framebuff->src, &framebuff->dst);
-      atomic_store_explicit(&framebuff->stat, ST20P_TX_FRAME_CONVERTED,
-                            memory_order_release);
+      tx_st20p_internal_convert(ctx, framebuff);
+      tx_st20p_set_stat(ctx, framebuff, ST20P_TX_FRAME_CONVERTED);
       if (ctx->ops.notify_frame_done && !framebuff->frame_done_cb_called) {
         /* Set before the callback: see the matching comment in
          * tx_st20p_if_frame_late(). */
         framebuff->frame_done_cb_called = true;
         ctx->ops.notify_frame_done(ctx->ops.priv, &framebuff->src);
       }
+    } else if (ctx->pkt_convert) {
+      /* ext frame is read by the packet builder, notify done after transmitted */
+      tx_st20p_set_stat(ctx, framebuff, ST20P_TX_FRAME_CONVERTED);
     } else {
-      atomic_store_explicit(&framebuff->stat, ST20P_TX_FRAME_READY, memory_order_release);
+      tx_st20p_set_stat(ctx, framebuff, ST20P_TX_FRAME_READY);
       st20_convert_notify_frame_ready(ctx->convert_impl);
     }
   }
@@ -1040,7 +1103,7 @@ int st20p_tx_notify_ext_frame_free(st20p_tx_handle handle, struct st_frame* fram
     ret = -EIO;
     goto out;
   }
-  atomic_store_explicit(&framebuff->stat, ST20P_TX_FRAME_FREE, memory_order_release);
+  tx_st20p_set_stat(ctx, framebuff, ST20P_TX_FRAME_FREE);
 
   tx_st20p_notify_frame_available(ctx);
 
@@ -1119,8 +1182,25 @@ st20p_tx_handle st20p_tx_create(mtl_handle mt, struct st20p_tx_ops* ops) {
   }
   ctx->ops = *ops;
 
+  if (!ctx->derive && (ops->flags & ST20P_TX_FLAG_PKT_CONVERT)) {
+    uint64_t pkt_cvt_input_cap =
+        ST_FMT_CAP_YUV422PLANAR10LE | ST_FMT_CAP_Y210 | ST_FMT_CAP_YUV422PLANAR16LE;
+    if (ops->transport_fmt != ST20_FMT_YUV_422_10BIT) {
+      err("%s(%d), only 422 10bit support packet convert\n", __func__, idx);
+      st20p_tx_free(ctx);
+      return NULL;
+    }
+    if (!(MTL_BIT64(ops->input_fmt) & pkt_cvt_input_cap)) {
+      err("%s(%d), %s not supported by packet convert\n", __func__, idx,
+          st_frame_fmt_name(ops->input_fmt));
+      st20p_tx_free(ctx);
+      return NULL;
+    }
+    ctx->pkt_convert = true;
+  }
+
   /* get one suitable convert device */
-  if (!ctx->derive) {
+  if (!ctx->derive && !ctx->pkt_convert) {
     ret = tx_st20p_get_converter(impl, ctx, ops);
     if (ret < 0) {
       err("%s(%d), get converter fail %d\n", __func__, idx, ret);
@@ -6,6 +6,7 @@
 #define _ST_LIB_PIPELINE_ST20_TX_HEAD_H_
 
 #include "../st_main.h"
+#include "st_frame_queue.h"
 #include "st_plugin.h"
 
 enum st20p_tx_frame_status {
@@ -49,12 +50,21 @@ struct st20p_tx_ctx {
   uint16_t framebuff_cnt;
   _Atomic uint32_t framebuff_sequence_number;
   struct st20p_tx_frame* framebuffs;
+  struct rte_ring* free_queue;      /* FREE framebuffs for get_frame */
+  struct rte_ring* ready_queue;     /* READY framebuffs for the converter, put order */
+  struct rte_ring* converted_queue; /* CONVERTED framebuffs for the transport */
   int usdt_frame_cnt;
 
   struct st20_convert_session_impl* convert_impl;
   struct st_frame_converter* internal_converter;
+  struct st_convert_pool* convert_pool; /* band split the internal converter */
+  /* the simd level selected for the internal converter by the benchmark */
+  bool convert_selected;
+  bool convert_select_cached;
+  struct st_convert_select_entry convert_select;
   bool ready;
   bool derive; /* input_fmt == transport_fmt */
+  bool pkt_convert; /* ST20P_TX_FLAG_PKT_CONVERT, convert when build the payload */
 
   size_t src_size;
 
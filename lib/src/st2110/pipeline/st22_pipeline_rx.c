@@ -180,6 +180,8 @@ static int rx_st22p_frame_ready(void* priv, void* frame,
         meta->pkts_recv[s_port];
   }
   framebuff->src.status = framebuff->dst.status = meta->status;
+  framebuff->decode_frame.src_segs = meta->segs;
+  framebuff->decode_frame.src_segs_nb = meta->segs_nb;
 
   /* ask app to consume src frame directly for derive mode */
   if (ctx->derive) {
@@ -388,6 +390,7 @@ static int rx_st22p_create_transport(struct mtl_main_impl* impl, struct st22p_rx
   }
   if (ops->flags & ST22P_RX_FLAG_RECEIVE_INCOMPLETE_FRAME)
     ops_rx.flags |= ST22_RX_FLAG_RECEIVE_INCOMPLETE_FRAME;
+  if (ctx->codestream_sg) ops_rx.flags |= ST22_RX_FLAG_CODESTREAM_SG;
   if (ops->flags & ST22P_RX_FLAG_FORCE_NUMA) {
     ops_rx.socket_id = ops->socket_id;
     ops_rx.flags |= ST22_RX_FLAG_FORCE_NUMA;
@@ -524,6 +527,7 @@ static int rx_st22p_get_decoder(struct mtl_main_impl* impl, struct st22p_rx_ctx*
   req.req.codec_thread_cnt = ops->codec_thread_cnt;
   req.req.interlaced = ops->interlaced;
   req.req.socket_id = ctx->socket_id;
+  req.req.codestream_sg = (ops->flags & ST22P_RX_FLAG_CODESTREAM_SG) ? true : false;
   req.priv = ctx;
   req.get_frame = rx_st22p_decode_get_frame;
   req.wake_block = rx_st22p_decode_wake_block;
@@ -542,6 +546,14 @@ static int rx_st22p_get_decoder(struct mtl_main_impl* impl, struct st22p_rx_ctx*
     ctx->decode_block_get = true;
     info("%s(%d), decoder use block get mode\n", __func__, idx);
   }
+  if (decode_impl->req.req.resp_flag & ST22_DECODER_RESP_FLAG_CODESTREAM_SG) {
+    if (req.req.codestream_sg) {
+      ctx->codestream_sg = true;
+      info("%s(%d), decoder use codestream sg mode\n", __func__, idx);
+    } else {
+      warn("%s(%d), codestream sg not enabled by app, ignore\n", __func__, idx);
+    }
+  }
 
   dbg("%s(%d), succ\n", __func__, idx);
   return 0;
@@ -58,6 +58,8 @@ struct st22p_rx_ctx {
   pthread_cond_t decode_block_wake_cond;
   pthread_mutex_t decode_block_wake_mutex;
   uint64_t decode_block_timeout_ns;
+  /* for ST22_DECODER_RESP_FLAG_CODESTREAM_SG */
+  bool codestream_sg;
 
   bool ready;
   bool derive; /* output_fmt == transport_fmt */
@@ -73,22 +73,6 @@ static void tx_st22p_encode_notify_frame_ready(struct st22p_tx_ctx* ctx) {
   }
 }
 
-static struct st22p_tx_frame* tx_st22p_next_available(
-    struct st22p_tx_ctx* ctx, enum st22p_tx_frame_status desired) {
-  struct st22p_tx_frame* framebuff;
-
-  /* check ready frame from start */
-  for (int idx = 0; idx < ctx->framebuff_cnt; idx++) {
-    framebuff = &ctx->framebuffs[idx];
-    if (desired == framebuff->stat) {
-      return framebuff;
-    }
-  }
-
-  /* no any desired frame */
-  return NULL;
-}
-
 static struct st22p_tx_frame* tx_st22p_newest_available(
     struct st22p_tx_ctx* ctx, enum st22p_tx_frame_status desired) {
   struct st22p_tx_frame* framebuff = NULL;
@@ -106,17 +90,41 @@ static struct st22p_tx_frame* tx_st22p_newest_available(
   return framebuff_newest;
 }
 
-/* Scan for a framebuff in state `desired` and atomically claim it by
- * transitioning it to `claimed`. A concurrent thread can win the race on the
- * scanned candidate between the scan and the claim; on a lost race this keeps
- * scanning instead of giving up, so the caller only sees NULL once every slot
- * has genuinely been checked and found unavailable. */
-static struct st22p_tx_frame* tx_st22p_claim_available(
-    struct st22p_tx_ctx* ctx, enum st22p_tx_frame_status desired,
+static void tx_st22p_queue_put(struct st22p_tx_ctx* ctx, struct rte_ring* queue,
+                               struct st22p_tx_frame* framebuff) {
+  /* never full as a framebuff is queued only once when it enters the status */
+  if (st_frame_queue_put(queue, framebuff) < 0)
+    err("%s(%d), queue full for frame %u\n", __func__, ctx->idx, framebuff->idx);
+}
+
+/* Store the status and queue the framebuff if the status has a consumer: FREE for
+ * get_frame, READY for the encoder and ENCODED for the transport. A pipelined encode
+ * completes out of order, the transport then picks the oldest ENCODED frame by seq
+ * number so the ENCODED queue is only used for one frame in flight. */
+static void tx_st22p_set_stat(struct st22p_tx_ctx* ctx, struct st22p_tx_frame* framebuff,
+                              enum st22p_tx_frame_status stat) {
+  struct rte_ring* queue = NULL;
+
+  framebuff->stat = stat;
+  if (stat == ST22P_TX_FRAME_FREE)
+    queue = ctx->free_queue;
+  else if (stat == ST22P_TX_FRAME_READY)
+    queue = ctx->ready_queue;
+  else if ((stat == ST22P_TX_FRAME_ENCODED) && (ctx->encode_depth <= 1))
+    queue = ctx->encoded_queue;
+  if (queue) tx_st22p_queue_put(ctx, queue, framebuff);
+}
+
+/* Get framebuffs from the queue of `desired` in fifo order and atomically claim the
+ * first one by transitioning it to `claimed`. An entry which fails the CAS was already
+ * moved out of `desired` by a direct status write, it is dropped and the next entry is
+ * tried, so the caller only sees NULL once the queue is really empty. */
+static struct st22p_tx_frame* tx_st22p_claim_queued(
+    struct rte_ring* queue, enum st22p_tx_frame_status desired,
     enum st22p_tx_frame_status claimed) {
   struct st22p_tx_frame* framebuff;
 
-  while ((framebuff = tx_st22p_next_available(ctx, desired))) {
+  while ((framebuff = st_frame_queue_get(queue))) {
     uint32_t expected = desired;
     if (atomic_compare_exchange_strong_explicit(&framebuff->stat, &expected, claimed,
                                                 memory_order_acq_rel,
@@ -127,8 +135,88 @@ static struct st22p_tx_frame* tx_st22p_claim_available(
   return NULL;
 }
 
-/* Check if the newest ENCODED frame has missed its transmission window.
- * Drops the frame (ENCODED -> DROPPED -> FREE) if cur_tai > frame_tai + frame_period.
+/* if any frame older than framebuff is still waiting or in the encoder */
+static bool tx_st22p_older_in_encode(struct st22p_tx_ctx* ctx,
+                                     struct st22p_tx_frame* framebuff) {
+  for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+    struct st22p_tx_frame* other = &ctx->framebuffs[i];
+    uint32_t stat = atomic_load_explicit(&other->stat, memory_order_acquire);
+    if ((stat != ST22P_TX_FRAME_READY) && (stat != ST22P_TX_FRAME_IN_ENCODING)) continue;
+    if (mt_seq32_greater(framebuff->seq_number, other->seq_number)) return true;
+  }
+  return false;
+}
+
+static void tx_st22p_stat_max32(_Atomic uint32_t* stat, uint32_t value) {
+  uint32_t cur = atomic_load_explicit(stat, memory_order_relaxed);
+
+  while (value > cur) {
+    if (atomic_compare_exchange_weak_explicit(stat, &cur, value, memory_order_relaxed,
+                                              memory_order_relaxed))
+      break;
+  }
+}
+
+static void tx_st22p_stat_max64(_Atomic uint64_t* stat, uint64_t value) {
+  uint64_t cur = atomic_load_explicit(stat, memory_order_relaxed);
+
+  while (value > cur) {
+    if (atomic_compare_exchange_weak_explicit(stat, &cur, value, memory_order_relaxed,
+                                              memory_order_relaxed))
+      break;
+  }
+}
+
+/* Claim the oldest READY frame for the encoder if it has room for one more. */
+static struct st22p_tx_frame* tx_st22p_encode_claim(struct st22p_tx_ctx* ctx) {
+  struct st22p_tx_frame* framebuff;
+  uint32_t inflight =
+      atomic_fetch_add_explicit(&ctx->encode_inflight, 1, memory_order_acq_rel);
+
+  if (inflight >= ctx->encode_depth) {
+    atomic_fetch_sub_explicit(&ctx->encode_inflight, 1, memory_order_release);
+    atomic_fetch_add_explicit(&ctx->stat_encode_depth_full, 1, memory_order_relaxed);
+    return NULL;
+  }
+
+  framebuff = tx_st22p_claim_queued(ctx->ready_queue, ST22P_TX_FRAME_READY,
+                                    ST22P_TX_FRAME_IN_ENCODING);
+  if (!framebuff) {
+    atomic_fetch_sub_explicit(&ctx->encode_inflight, 1, memory_order_release);
+    return NULL;
+  }
+  tx_st22p_stat_max32(&ctx->stat_encode_depth_max, inflight + 1);
+  framebuff->encode_start_ns = mt_get_monotonic_time();
+  return framebuff;
+}
+
+/* Claim the oldest ENCODED -> IN_TRANSMITTING for the transport. */
+static struct st22p_tx_frame* tx_st22p_claim_encoded(struct st22p_tx_ctx* ctx) {
+  struct st22p_tx_frame* framebuff;
+
+  if (ctx->encode_depth <= 1)
+    return tx_st22p_claim_queued(ctx->encoded_queue, ST22P_TX_FRAME_ENCODED,
+                                 ST22P_TX_FRAME_IN_TRANSMITTING);
+
+  /* pipelined encode may complete out of order, keep the transmit order */
+  while ((framebuff = tx_st22p_newest_available(ctx, ST22P_TX_FRAME_ENCODED))) {
+    if (tx_st22p_older_in_encode(ctx, framebuff)) {
+      ctx->stat_encode_wait_order++;
+      return NULL;
+    }
+    uint32_t expected = ST22P_TX_FRAME_ENCODED;
+    if (atomic_compare_exchange_strong_explicit(
+            &framebuff->stat, &expected, ST22P_TX_FRAME_IN_TRANSMITTING,
+            memory_order_acq_rel, memory_order_relaxed))
+      return framebuff;
+  }
+
+  return NULL;
+}
+
+/* Check if the oldest ENCODED frame, already claimed to IN_TRANSMITTING, has missed
+ * its transmission window.
+ * Drops the frame (-> DROPPED -> FREE) if cur_tai > frame_tai + frame_period.
  *
  * Locking contract (mirrors st20p):
  *   1. Caller holds ctx->lock.
@@ -177,7 +265,7 @@ static bool tx_st22p_if_frame_late(struct st22p_tx_ctx* ctx,
   if (ctx->ops.notify_frame_late) ctx->ops.notify_frame_late(ctx->ops.priv, 0);
   MT_USDT_ST22P_TX_FRAME_DROP(ctx->idx, framebuff->idx, rtp_ts);
 
-  framebuff->stat = ST22P_TX_FRAME_FREE;
+  tx_st22p_set_stat(ctx, framebuff, ST22P_TX_FRAME_FREE);
 
   tx_st22p_notify_frame_available(ctx);
 
@@ -192,30 +280,18 @@ static int tx_st22p_next_frame(void* priv, uint16_t* next_frame_idx,
 
   if (!ctx->ready) return -EBUSY; /* not ready */
 
+  /* Claim the oldest ENCODED -> IN_TRANSMITTING, the late check runs on the claimed
+   * frame so a concurrent transport thread never sees it. */
   while (1) {
-    framebuff = tx_st22p_newest_available(ctx, ST22P_TX_FRAME_ENCODED);
-    if (!framebuff) break; /* no encoded frame available */
-
-    if (tx_st22p_if_frame_late(ctx, framebuff)) {
-      /* frame missed its TX window and was dropped; cap the batch then rescan */
-      if (++drop_cnt >= ST_TX_DROP_MAX_BATCH) {
-        info("%s(%d), max drop batch %d reached, stopping\n", __func__, ctx->idx,
-             drop_cnt);
-        framebuff = NULL;
-        break;
-      }
-      continue;
+    if (drop_cnt >= ST_TX_DROP_MAX_BATCH) {
+      info("%s(%d), max drop batch %d reached, stopping\n", __func__, ctx->idx, drop_cnt);
+      framebuff = NULL;
+      break;
     }
-
-    /* Claim ENCODED -> IN_TRANSMITTING atomically. newest_available() is a
-     * lock-free scan, so the slot may have been taken by a late-drop or
-     * (defensively) another consumer between the scan and here; on a lost race
-     * the CAS fails and we rescan. Mirrors the FREE->IN_USER claim. */
-    uint32_t expected = ST22P_TX_FRAME_ENCODED;
-    if (atomic_compare_exchange_strong_explicit(
-            &framebuff->stat, &expected, ST22P_TX_FRAME_IN_TRANSMITTING,
-            memory_order_acq_rel, memory_order_relaxed))
-      break; /* claimed */
+    framebuff = tx_st22p_claim_encoded(ctx);
+    if (!framebuff) break; /* no encoded frame available */
+    if (!tx_st22p_if_frame_late(ctx, framebuff)) break;
+    drop_cnt++;
   }
 
   /* not any encoded frame */
@@ -223,8 +299,7 @@ static int tx_st22p_next_frame(void* priv, uint16_t* next_frame_idx,
     /* When drop-when-late is active, ensure the app knows about free slots so it
      * can refill the pipeline promptly after drops freed frames. */
     if (ctx->ops.flags & ST22P_TX_FLAG_DROP_WHEN_LATE) {
-      if (tx_st22p_next_available(ctx, ST22P_TX_FRAME_FREE))
-        tx_st22p_notify_frame_available(ctx);
+      if (st_frame_queue_count(ctx->free_queue)) tx_st22p_notify_frame_available(ctx);
     }
     return -EBUSY;
   }
@@ -261,7 +336,7 @@ static int tx_st22p_frame_done(void* priv, uint16_t frame_idx,
 
   if (ST22P_TX_FRAME_IN_TRANSMITTING == framebuff->stat) {
     ret = 0;
-    framebuff->stat = ST22P_TX_FRAME_FREE;
+    tx_st22p_set_stat(ctx, framebuff, ST22P_TX_FRAME_FREE);
     dbg("%s(%d), done_idx %u\n", __func__, ctx->idx, frame_idx);
   } else {
     ret = -EIO;
@@ -334,19 +409,17 @@ static struct st22_encode_frame_meta* tx_st22p_encode_get_frame(void* priv) {
     goto out; /* not ready */
   }
 
-  ctx->stat_encode_get_frame_try++;
+  atomic_fetch_add_explicit(&ctx->stat_encode_get_frame_try, 1, memory_order_relaxed);
 
-  /* Claim READY->IN_ENCODING. tx_st22p_claim_available() retries across the
-   * ring on a lost CAS race, so it only returns NULL once every slot has
-   * actually been checked -- unlike a scan-then-single-CAS-attempt, which
-   * could give up even while other READY frames remain. */
-  framebuff =
-      tx_st22p_claim_available(ctx, ST22P_TX_FRAME_READY, ST22P_TX_FRAME_IN_ENCODING);
+  /* Claim the oldest READY->IN_ENCODING within the encode depth. The claim
+   * retries across the ring on a lost CAS race, so it only returns NULL once
+   * every slot has actually been checked -- unlike a scan-then-single-CAS-attempt,
+   * which could give up even while other READY frames remain. */
+  framebuff = tx_st22p_encode_claim(ctx);
   if (!framebuff && ctx->encode_block_get) { /* wait here for block mode */
     tx_st22p_encode_get_block_wait(ctx);
     /* get again */
-    framebuff =
-        tx_st22p_claim_available(ctx, ST22P_TX_FRAME_READY, ST22P_TX_FRAME_IN_ENCODING);
+    framebuff = tx_st22p_encode_claim(ctx);
   }
   /* not any free frame */
   if (!framebuff) {
@@ -354,7 +427,7 @@ static struct st22_encode_frame_meta* tx_st22p_encode_get_frame(void* priv) {
     goto out;
   }
 
-  ctx->stat_encode_get_frame_succ++;
+  atomic_fetch_add_explicit(&ctx->stat_encode_get_frame_succ, 1, memory_order_relaxed);
   dbg("%s(%d), frame %u succ\n", __func__, idx, framebuff->idx);
   ret_frame = &framebuff->encode_frame;
   MT_USDT_ST22P_TX_ENCODE_GET(idx, framebuff->idx, ret_frame->src->addr[0],
@@ -386,20 +459,28 @@ static int tx_st22p_encode_put_frame(void* priv, struct st22_encode_frame_meta*
     goto out;
   }
 
-  ctx->stat_encode_put_frame++;
+  atomic_fetch_add_explicit(&ctx->stat_encode_put_frame, 1, memory_order_relaxed);
   dbg("%s(%d), frame %u result %d data_size %" PRIu64 "\n", __func__, idx, encode_idx,
       result, data_size);
+  uint64_t encode_ns = mt_get_monotonic_time() - framebuff->encode_start_ns;
+  atomic_fetch_add_explicit(&ctx->stat_encode_ns_sum, encode_ns, memory_order_relaxed);
+  tx_st22p_stat_max64(&ctx->stat_encode_ns_max, encode_ns);
+  if ((ctx->encode_depth > 1) && tx_st22p_older_in_encode(ctx, framebuff))
+    atomic_fetch_add_explicit(&ctx->stat_encode_out_of_order, 1, memory_order_relaxed);
   if ((result < 0) || (data_size <= ST22_ENCODE_MIN_FRAME_SZ) || (data_size > max_size)) {
     warn("%s(%d), invalid frame %u result %d data_size %" PRIu64
          ", allowed min %u max %" PRIu64 "\n",
          __func__, idx, encode_idx, result, data_size, ST22_ENCODE_MIN_FRAME_SZ,
          max_size);
-    framebuff->stat = ST22P_TX_FRAME_FREE;
+    tx_st22p_set_stat(ctx, framebuff, ST22P_TX_FRAME_FREE);
     tx_st22p_notify_frame_available(ctx);
     rte_atomic32_inc(&ctx->stat_encode_fail);
   } else {
-    framebuff->stat = ST22P_TX_FRAME_ENCODED;
+    tx_st22p_set_stat(ctx, framebuff, ST22P_TX_FRAME_ENCODED);
   }
+  atomic_fetch_sub_explicit(&ctx->encode_inflight, 1, memory_order_release);
+  /* the encoder may wait on the depth for the next frame */
+  if (ctx->encode_block_get && (ctx->encode_depth > 1)) tx_st22p_encode_block_wake(ctx);
 
   MT_USDT_ST22P_TX_ENCODE_PUT(idx, framebuff->idx, frame->src->addr[0],
                               frame->dst->addr[0], result, data_size);
@@ -445,12 +526,35 @@ static int tx_st22p_encode_dump(void* priv) {
   ctx->stat_get_frame_succ = 0;
   ctx->stat_put_frame = 0;
 
-  notice("TX_ST22P(%s), encoder get try %d succ %d, put %d\n", ctx->ops_name,
-         ctx->stat_encode_get_frame_try, ctx->stat_encode_get_frame_succ,
-         ctx->stat_encode_put_frame);
-  ctx->stat_encode_get_frame_try = 0;
-  ctx->stat_encode_get_frame_succ = 0;
-  ctx->stat_encode_put_frame = 0;
+  uint32_t encode_try =
+      atomic_exchange_explicit(&ctx->stat_encode_get_frame_try, 0, memory_order_relaxed);
+  uint32_t encode_succ =
+      atomic_exchange_explicit(&ctx->stat_encode_get_frame_succ, 0, memory_order_relaxed);
+  uint32_t encode_put =
+      atomic_exchange_explicit(&ctx->stat_encode_put_frame, 0, memory_order_relaxed);
+  notice("TX_ST22P(%s), encoder get try %u succ %u, put %u\n", ctx->ops_name,
+         encode_try, encode_succ, encode_put);
+
+  uint64_t ns_sum = atomic_exchange_explicit(&ctx->stat_encode_ns_sum, 0,
+                                             memory_order_relaxed);
+  uint64_t ns_max = atomic_exchange_explicit(&ctx->stat_encode_ns_max, 0,
+                                             memory_order_relaxed);
+  if (encode_put) {
+    notice("TX_ST22P(%s), encode latency avg %.2fus max %.2fus\n", ctx->ops_name,
+           (float)ns_sum / encode_put / NS_PER_US, (float)ns_max / NS_PER_US);
+  }
+  uint32_t depth_max =
+      atomic_exchange_explicit(&ctx->stat_encode_depth_max, 0, memory_order_relaxed);
+  uint32_t depth_full =
+      atomic_exchange_explicit(&ctx->stat_encode_depth_full, 0, memory_order_relaxed);
+  uint32_t out_of_order =
+      atomic_exchange_explicit(&ctx->stat_encode_out_of_order, 0, memory_order_relaxed);
+  if (ctx->encode_depth > 1) {
+    notice("TX_ST22P(%s), encode depth max %u/%u full %u, out of order %u wait %u\n",
+           ctx->ops_name, depth_max, ctx->encode_depth, depth_full, out_of_order,
+           ctx->stat_encode_wait_order);
+    ctx->stat_encode_wait_order = 0;
+  }
 
   return 0;
 }
@@ -562,6 +666,18 @@ static int tx_st22p_uinit_src_fbs(struct st22p_tx_ctx* ctx) {
     mt_rte_free(ctx->framebuffs);
     ctx->framebuffs = NULL;
   }
+  if (ctx->free_queue) {
+    st_frame_queue_free(ctx->free_queue);
+    ctx->free_queue = NULL;
+  }
+  if (ctx->ready_queue) {
+    st_frame_queue_free(ctx->ready_queue);
+    ctx->ready_queue = NULL;
+  }
+  if (ctx->encoded_queue) {
+    st_frame_queue_free(ctx->encoded_queue);
+    ctx->encoded_queue = NULL;
+  }
 
   return 0;
 }
@@ -581,9 +697,19 @@ static int tx_st22p_init_src_fbs(struct st22p_tx_ctx* ctx, struct st22p_tx_ops*
   }
   ctx->framebuffs = frames;
 
+  ctx->free_queue = st_frame_queue_create("st22p_tx_free", ctx->framebuff_cnt, soc_id);
+  ctx->ready_queue = st_frame_queue_create("st22p_tx_ready", ctx->framebuff_cnt, soc_id);
+  ctx->encoded_queue =
+      st_frame_queue_create("st22p_tx_encoded", ctx->framebuff_cnt, soc_id);
+  if (!ctx->free_queue || !ctx->ready_queue || !ctx->encoded_queue) {
+    err("%s(%d), frame queue create fail\n", __func__, idx);
+    tx_st22p_uinit_src_fbs(ctx);
+    return -ENOMEM;
+  }
+
   for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
-    frames[i].stat = ST22P_TX_FRAME_FREE;
     frames[i].idx = i;
+    tx_st22p_set_stat(ctx, &frames[i], ST22P_TX_FRAME_FREE);
     frames[i].src.fmt = ops->input_fmt;
     frames[i].src.interlaced = ops->interlaced;
     frames[i].src.buffer_size = src_size;
@@ -645,6 +771,8 @@ static int tx_st22p_get_encoder(struct mtl_main_impl* impl, struct st22p_tx_ctx*
   req.req.codec_thread_cnt = ops->codec_thread_cnt;
   req.req.interlaced = ops->interlaced;
   req.req.socket_id = ctx->socket_id;
+  req.req.max_frames_in_flight = ops->encode_frames_in_flight;
+  req.req.slice_cnt = ops->encode_slice_cnt;
   req.priv = ctx;
   req.get_frame = tx_st22p_encode_get_frame;
   req.wake_block = tx_st22p_encode_wake_block;
@@ -669,6 +797,14 @@ static int tx_st22p_get_encoder(struct mtl_main_impl* impl, struct st22p_tx_ctx*
     info("%s(%d), encoder use block get mode\n", __func__, idx);
   }
 
+  uint16_t depth = encode_impl->req.req.max_frames_in_flight;
+  if (ops->encode_frames_in_flight && depth > ops->encode_frames_in_flight)
+    depth = ops->encode_frames_in_flight;
+  ctx->encode_depth = RTE_MAX(RTE_MIN(depth, ops->framebuff_cnt), 1);
+  if (ctx->encode_depth > 1)
+    info("%s(%d), pipelined encode, %u frames in flight\n", __func__, idx,
+         ctx->encode_depth);
+
   dbg("%s(%d), succ\n", __func__, idx);
   return 0;
 }
@@ -748,11 +884,9 @@ struct st_frame* st22p_tx_get_frame(st22p_tx_handle handle) {
 
   ctx->stat_get_frame_try++;
 
-  /* Claim FREE->IN_USER. tx_st22p_claim_available() retries across the ring
-   * on a lost CAS race, so it only returns NULL once every slot has actually
-   * been checked -- unlike a scan-then-single-CAS-attempt, which could give up
-   * even while other FREE frames remain (spurious failure under contention). */
-  framebuff = tx_st22p_claim_available(ctx, ST22P_TX_FRAME_FREE, ST22P_TX_FRAME_IN_USER);
+  /* Claim FREE->IN_USER from the free queue, O(1) regardless of framebuff_cnt. */
+  framebuff =
+      tx_st22p_claim_queued(ctx->free_queue, ST22P_TX_FRAME_FREE, ST22P_TX_FRAME_IN_USER);
   if (!framebuff && ctx->block_get) {
     mt_pthread_mutex_lock(&ctx->block_wake_mutex);
     while (!ctx->block_wake_pending &&
@@ -765,8 +899,8 @@ struct st_frame* st22p_tx_get_frame(st22p_tx_handle handle) {
     mt_pthread_mutex_unlock(&ctx->block_wake_mutex);
     if (atomic_load_explicit(&ctx->lc_destroying, memory_order_acquire)) goto out;
     /* get again */
-    framebuff =
-        tx_st22p_claim_available(ctx, ST22P_TX_FRAME_FREE, ST22P_TX_FRAME_IN_USER);
+    framebuff = tx_st22p_claim_queued(ctx->free_queue, ST22P_TX_FRAME_FREE,
+                                      ST22P_TX_FRAME_IN_USER);
   }
   /* not any free frame */
   if (!framebuff) {
@@ -818,9 +952,9 @@ int st22p_tx_put_frame(st22p_tx_handle handle, struct st_frame* frame) {
   }
 
   if (ctx->derive) {
-    framebuff->stat = ST22P_TX_FRAME_ENCODED;
+    tx_st22p_set_stat(ctx, framebuff, ST22P_TX_FRAME_ENCODED);
   } else {
-    framebuff->stat = ST22P_TX_FRAME_READY;
+    tx_st22p_set_stat(ctx, framebuff, ST22P_TX_FRAME_READY);
     tx_st22p_encode_notify_frame_ready(ctx);
   }
   ctx->stat_put_frame++;
@@ -861,7 +995,7 @@ int st22p_tx_put_frame_abort(st22p_tx_handle handle, struct st_frame* frame) {
     goto out;
   }
 
-  framebuff->stat = ST22P_TX_FRAME_FREE;
+  tx_st22p_set_stat(ctx, framebuff, ST22P_TX_FRAME_FREE);
   ctx->stat_drop_frame++;
   dbg("%s(%d), frame %u aborted\n", __func__, idx, producer_idx);
   ret = 0;
@@ -920,7 +1054,7 @@ int st22p_tx_put_ext_frame(st22p_tx_handle handle, struct st_frame* frame,
     framebuff->dst.second_field = framebuff->src.second_field = frame->second_field;
   }
 
-  framebuff->stat = ST22P_TX_FRAME_READY;
+  tx_st22p_set_stat(ctx, framebuff, ST22P_TX_FRAME_READY);
   tx_st22p_encode_notify_frame_ready(ctx);
   ctx->stat_put_frame++;
   dbg("%s(%d), frame %u succ\n", __func__, idx, producer_idx);
@@ -6,6 +6,7 @@
 #define _ST_LIB_PIPELINE_ST22_TX_HEAD_H_
 
 #include "../st_main.h"
+#include "st_frame_queue.h"
 #include "st_plugin.h"
 
 enum st22p_tx_frame_status {
@@ -27,6 +28,7 @@ struct st22p_tx_frame {
   uint16_t idx;
   uint32_t seq_number;
   bool frame_done_cb_called; /* frame done callback called */
+  uint64_t encode_start_ns;  /* time of encode get frame */
 };
 
 /* See st20p_rx_ctx note re: ->transport lifetime; access via MT_HANDLE_GUARD. */
@@ -47,6 +49,9 @@ struct st22p_tx_ctx {
   uint16_t framebuff_cnt;
   _Atomic uint32_t framebuff_sequence_number;
   struct st22p_tx_frame* framebuffs;
+  struct rte_ring* free_queue;    /* FREE framebuffs for get_frame */
+  struct rte_ring* ready_queue;   /* READY framebuffs for the encoder, put order */
+  struct rte_ring* encoded_queue; /* ENCODED framebuffs for the transport, depth 1 */
 
   /* for ST22P_TX_FLAG_BLOCK_GET */
   bool block_get;
@@ -61,6 +66,9 @@ struct st22p_tx_ctx {
   pthread_cond_t encode_block_wake_cond;
   pthread_mutex_t encode_block_wake_mutex;
   uint64_t encode_block_timeout_ns;
+  /* max frames in the encoder, transmit in order if more than one */
+  uint16_t encode_depth;
+  _Atomic uint32_t encode_inflight;
 
   bool ready;
   bool derive; /* input_fmt == transport_fmt */
@@ -76,10 +84,17 @@ struct st22p_tx_ctx {
   uint32_t stat_get_frame_succ;
   uint32_t stat_put_frame;
   uint32_t stat_drop_frame;
-  /* get frame stat */
-  uint32_t stat_encode_get_frame_try;
-  uint32_t stat_encode_get_frame_succ;
-  uint32_t stat_encode_put_frame;
+  /* encoder get frame stat, the encoder may update from several threads */
+  _Atomic uint32_t stat_encode_get_frame_try;
+  _Atomic uint32_t stat_encode_get_frame_succ;
+  _Atomic uint32_t stat_encode_put_frame;
+  /* pipelined encode stat */
+  _Atomic uint64_t stat_encode_ns_sum;
+  _Atomic uint64_t stat_encode_ns_max;
+  _Atomic uint32_t stat_encode_depth_max;
+  _Atomic uint32_t stat_encode_depth_full;
+  _Atomic uint32_t stat_encode_out_of_order;
+  uint32_t stat_encode_wait_order; /* transport waits an older frame in encoding */
 };
 
 #endif
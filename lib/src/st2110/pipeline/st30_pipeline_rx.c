@@ -7,6 +7,7 @@
 #include "../../mt_handle_guard.h"
 #include "../../mt_log.h"
 #include "../../mt_stat.h"
+#include "../st_rx_audio_session.h"
 
 static const char* st30p_rx_frame_stat_name[ST30P_RX_FRAME_STATUS_MAX] = {
     "free",
@@ -45,40 +46,29 @@ static void rx_st30p_notify_frame_available(struct st30p_rx_ctx* ctx) {
   }
 }
 
-static struct st30p_rx_frame* rx_st30p_next_available(
-    struct st30p_rx_ctx* ctx, uint16_t idx_start, enum st30p_rx_frame_status desired) {
-  uint16_t idx = idx_start;
-  struct st30p_rx_frame* framebuff;
-
-  /* check ready frame from idx_start */
-  while (1) {
-    framebuff = &ctx->framebuffs[idx];
-    if (desired == atomic_load_explicit(&framebuff->stat, memory_order_acquire)) {
-      /* find one desired */
-      return framebuff;
-    }
-    idx = rx_st30p_next_idx(ctx, idx);
-    if (idx == idx_start) {
-      /* loop all frames end */
-      break;
-    }
-  }
+static void rx_st30p_queue_put(struct st30p_rx_ctx* ctx, struct rte_ring* queue,
+                               struct st30p_rx_frame* framebuff) {
+  /* never full as a framebuff is queued only once when it enters the status */
+  if (st_frame_queue_put(queue, framebuff) < 0)
+    err("%s(%d), queue full for frame %u\n", __func__, ctx->idx, framebuff->idx);
+}
 
-  /* no any desired frame */
-  return NULL;
+static void rx_st30p_set_free(struct st30p_rx_ctx* ctx,
+                              struct st30p_rx_frame* framebuff) {
+  atomic_store_explicit(&framebuff->stat, ST30P_RX_FRAME_FREE, memory_order_release);
+  rx_st30p_queue_put(ctx, ctx->free_queue, framebuff);
 }
 
-/* Scan from idx_start for a framebuff in state `desired` and atomically claim
- * it by transitioning it to `claimed`. A concurrent thread can win the race on
- * the scanned candidate between the scan and the claim; on a lost race this
- * keeps scanning instead of giving up, so the caller only sees NULL once every
- * slot has genuinely been checked and found unavailable. */
-static struct st30p_rx_frame* rx_st30p_claim_available(
-    struct st30p_rx_ctx* ctx, uint16_t idx_start, enum st30p_rx_frame_status desired,
+/* Get framebuffs from the queue of `desired` in fifo order and atomically claim the
+ * first one by transitioning it to `claimed`. An entry which fails the CAS was already
+ * moved out of `desired` by a direct status write, it is dropped and the next entry is
+ * tried, so the caller only sees NULL once the queue is really empty. */
+static struct st30p_rx_frame* rx_st30p_claim_queued(
+    struct rte_ring* queue, enum st30p_rx_frame_status desired,
     enum st30p_rx_frame_status claimed) {
   struct st30p_rx_frame* framebuff;
 
-  while ((framebuff = rx_st30p_next_available(ctx, idx_start, desired))) {
+  while ((framebuff = st_frame_queue_get(queue))) {
     uint32_t expected = desired;
     if (atomic_compare_exchange_strong_explicit(&framebuff->stat, &expected, claimed,
                                                 memory_order_acq_rel,
@@ -95,8 +85,12 @@ static int rx_st30p_frame_ready(void* priv, void* addr, struct st30_rx_frame_met
 
   if (!ctx->ready) return -EBUSY; /* not ready */
 
-  framebuff =
-      rx_st30p_next_available(ctx, ctx->framebuff_producer_idx, ST30P_RX_FRAME_FREE);
+  /* the transport is the only producer, nobody else can take a FREE framebuff */
+  while ((framebuff = st_frame_queue_get(ctx->free_queue))) {
+    if (ST30P_RX_FRAME_FREE ==
+        atomic_load_explicit(&framebuff->stat, memory_order_acquire))
+      break;
+  }
 
   /* not any free frame */
   if (!framebuff) {
@@ -108,14 +102,24 @@ static int rx_st30p_frame_ready(void* priv, void* addr, struct st30_rx_frame_met
   }
 
   struct st30_frame* frame = &framebuff->frame;
-  frame->addr = addr;
-  frame->data_size = meta->frame_recv_size;
+  if (ctx->pcm) {
+    /* converted to the app frame in st30p_rx_get_frame */
+    framebuff->wire_addr = addr;
+    frame->data_size = ctx->pcm->app_frame_size;
+  } else {
+    frame->addr = addr;
+    frame->data_size = meta->frame_recv_size;
+  }
   frame->tfmt = meta->tfmt;
   frame->timestamp = meta->timestamp;
   frame->receive_timestamp = meta->timestamp_first_pkt;
   frame->rtp_timestamp = meta->rtp_timestamp;
   frame->status = meta->status;
+  /* from the session tasklet, the writer of the meter */
+  if (frame->meter)
+    st_rx_audio_meter_read(ctx->transport->impl->meter, frame->meter, ctx->ops.channel);
   atomic_store_explicit(&framebuff->stat, ST30P_RX_FRAME_READY, memory_order_release);
+  rx_st30p_queue_put(ctx, ctx->ready_queue, framebuff);
   /* point to next */
   ctx->framebuff_producer_idx = rx_st30p_next_idx(ctx, framebuff->idx);
 
@@ -151,10 +155,12 @@ static int rx_st30p_create_transport(struct mtl_main_impl* impl, struct st30p_rx
   ops_rx.channel = ops->channel;
   ops_rx.sampling = ops->sampling;
   ops_rx.ptime = ops->ptime;
-  ops_rx.framebuff_cnt = ops->framebuff_cnt;
-  ops_rx.framebuff_size = ops->framebuff_size;
   ops_rx.type = ST30_TYPE_FRAME_LEVEL;
-  ops_rx.notify_frame_ready = rx_st30p_frame_ready;
+  if (!ctx->playout) {
+    ops_rx.framebuff_cnt = ops->framebuff_cnt;
+    ops_rx.framebuff_size = ops->framebuff_size;
+    ops_rx.notify_frame_ready = rx_st30p_frame_ready;
+  }
 
   if (ops->flags & ST30P_RX_FLAG_DATA_PATH_ONLY)
     ops_rx.flags |= ST30_RX_FLAG_DATA_PATH_ONLY;
@@ -164,8 +170,10 @@ static int rx_st30p_create_transport(struct mtl_main_impl* impl, struct st30p_rx
   }
   if (ops->flags & ST30P_RX_FLAG_SIMULATE_PKT_LOSS)
     ops_rx.flags |= ST30_RX_FLAG_SIMULATE_PKT_LOSS;
+  if (ops->flags & ST30P_RX_FLAG_ENABLE_METER) ops_rx.flags |= ST30_RX_FLAG_ENABLE_METER;
+  if (ops->flags & ST30P_RX_FLAG_JUMBO_FRAME) ops_rx.flags |= ST30_RX_FLAG_JUMBO_FRAME;
 
-  transport = st30_rx_create(impl, &ops_rx);
+  transport = st30_rx_create_with_playout(impl, &ops_rx, ctx->playout);
   if (!transport) {
     err("%s(%d), transport create fail\n", __func__, idx);
     return -EIO;
@@ -177,18 +185,106 @@ static int rx_st30p_create_transport(struct mtl_main_impl* impl, struct st30p_rx
 }
 
 static int rx_st30p_uinit_fbs(struct st30p_rx_ctx* ctx) {
+  if (ctx->playout) {
+    st_rx_audio_playout_free(ctx->playout);
+    ctx->playout = NULL;
+  }
+  if (ctx->pcm) {
+    st_pcm_converter_free(ctx->pcm);
+    ctx->pcm = NULL;
+  }
+  if (ctx->app_fbs) {
+    mt_rte_free(ctx->app_fbs);
+    ctx->app_fbs = NULL;
+  }
+  if (ctx->meters) {
+    mt_rte_free(ctx->meters);
+    ctx->meters = NULL;
+  }
   if (ctx->framebuffs) {
     mt_rte_free(ctx->framebuffs);
     ctx->framebuffs = NULL;
   }
+  if (ctx->free_queue) {
+    st_frame_queue_free(ctx->free_queue);
+    ctx->free_queue = NULL;
+  }
+  if (ctx->ready_queue) {
+    st_frame_queue_free(ctx->ready_queue);
+    ctx->ready_queue = NULL;
+  }
 
   return 0;
 }
 
+static int rx_st30p_init_pcm(struct st30p_rx_ctx* ctx, struct st30p_rx_ops* ops) {
+  int idx = ctx->idx;
+
+  if (ops->app_fmt == ST30P_SAMPLE_FMT_WIRE) return 0;
+  if (ops->app_fmt >= ST30P_SAMPLE_FMT_MAX || !st_pcm_convert_fmt_supported(ops->fmt)) {
+    err("%s(%d), app fmt %d not supported for fmt %d\n", __func__, idx, ops->app_fmt,
+        ops->fmt);
+    return -EINVAL;
+  }
+
+  ctx->pcm = st_pcm_converter_create(ops->fmt, ops->channel, ops->framebuff_size,
+                                     ops->app_fmt, ops->app_planar, ops->app_channel,
+                                     ops->app_channel_map);
+  if (!ctx->pcm) {
+    err("%s(%d), pcm converter create fail\n", __func__, idx);
+    return -EINVAL;
+  }
+  /* the map is in the converter, the pointer of app may not live after create */
+  ctx->ops.app_channel_map = NULL;
+
+  ctx->app_fbs = mt_rte_zmalloc_socket(ctx->pcm->app_frame_size * ctx->framebuff_cnt,
+                                       ctx->socket_id);
+  if (!ctx->app_fbs) {
+    err("%s(%d), app frames malloc fail\n", __func__, idx);
+    return -ENOMEM;
+  }
+  info("%s(%d), app fmt %d %s, %u ch\n", __func__, idx, ops->app_fmt,
+       ops->app_planar ? "planar" : "interleaved", ctx->pcm->app_channel);
+  return 0;
+}
+
+static int rx_st30p_init_playout(struct st30p_rx_ctx* ctx, struct st30p_rx_ops* ops) {
+  int idx = ctx->idx;
+  uint32_t latency_us = ops->playout_latency_us;
+  uint32_t buffer_ms = ops->playout_buffer_ms;
+
+  if (ops->app_fmt != ST30P_SAMPLE_FMT_WIRE) {
+    err("%s(%d), the playout is the wire format only\n", __func__, idx);
+    return -EINVAL;
+  }
+  if (!latency_us) latency_us = ST30P_RX_PLAYOUT_LATENCY_US_DEFAULT;
+  if (!buffer_ms) buffer_ms = ST30P_RX_PLAYOUT_BUFFER_MS_DEFAULT;
+
+  ctx->playout =
+      st_rx_audio_playout_create(ctx->impl, idx, ops->fmt, ops->channel, ops->sampling,
+                                 ops->ptime, latency_us, buffer_ms, ctx->socket_id);
+  if (!ctx->playout) {
+    err("%s(%d), playout create fail\n", __func__, idx);
+    return -EINVAL;
+  }
+  info("%s(%d), latency %uus buffer %ums\n", __func__, idx, latency_us, buffer_ms);
+  return 0;
+}
+
 static int rx_st30p_init_fbs(struct st30p_rx_ctx* ctx, struct st30p_rx_ops* ops) {
   int idx = ctx->idx;
   int soc_id = ctx->socket_id;
   struct st30p_rx_frame* frames;
+  int ret;
+
+  /* the app reads the playout ring, no framebuffs */
+  if (ops->flags & ST30P_RX_FLAG_PLAYOUT) {
+    ctx->framebuff_cnt = 0;
+    return rx_st30p_init_playout(ctx, ops);
+  }
+
+  ret = rx_st30p_init_pcm(ctx, ops);
+  if (ret < 0) return ret;
 
   frames = mt_rte_zmalloc_socket(sizeof(*frames) * ctx->framebuff_cnt, soc_id);
   if (!frames) {
@@ -197,12 +293,28 @@ static int rx_st30p_init_fbs(struct st30p_rx_ctx* ctx, struct st30p_rx_ops* ops)
   }
   ctx->framebuffs = frames;
 
+  if (ops->flags & ST30P_RX_FLAG_ENABLE_METER) {
+    ctx->meters = mt_rte_zmalloc_socket(
+        sizeof(*ctx->meters) * ops->channel * ctx->framebuff_cnt, soc_id);
+    if (!ctx->meters) {
+      err("%s(%d), meters malloc fail\n", __func__, idx);
+      return -ENOMEM;
+    }
+  }
+
+  ctx->free_queue = st_frame_queue_create("st30p_rx_free", ctx->framebuff_cnt, soc_id);
+  ctx->ready_queue = st_frame_queue_create("st30p_rx_ready", ctx->framebuff_cnt, soc_id);
+  if (!ctx->free_queue || !ctx->ready_queue) {
+    err("%s(%d), frame queue create fail\n", __func__, idx);
+    return -ENOMEM;
+  }
+
   for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
     struct st30p_rx_frame* framebuff = &frames[i];
     struct st30_frame* frame = &framebuff->frame;
 
-    atomic_store_explicit(&framebuff->stat, ST30P_RX_FRAME_FREE, memory_order_relaxed);
     framebuff->idx = i;
+    rx_st30p_set_free(ctx, framebuff);
 
     /* addr will be resolved later in rx_st30p_frame_ready */
     frame->priv = framebuff;
@@ -212,7 +324,15 @@ static int rx_st30p_init_fbs(struct st30p_rx_ctx* ctx, struct st30p_rx_ops* ops)
     frame->ptime = ops->ptime;
     /* same to framebuffer size */
     frame->buffer_size = frame->data_size = ops->framebuff_size;
+    if (ctx->pcm) {
+      frame->addr = ctx->app_fbs + ctx->pcm->app_frame_size * i;
+      frame->sample_fmt = ops->app_fmt;
+      frame->planar = ops->app_planar;
+      frame->channel = ctx->pcm->app_channel;
+      frame->buffer_size = frame->data_size = ctx->pcm->app_frame_size;
+    }
     frame->receive_timestamp = 0;
+    if (ctx->meters) frame->meter = ctx->meters + (size_t)ops->channel * i;
     dbg("%s(%d), init fb %u\n", __func__, idx, i);
   }
 
@@ -229,6 +349,11 @@ static int rx_st30p_stat(void* priv) {
 
   if (!ctx->ready) return -EBUSY; /* not ready */
 
+  if (ctx->playout) {
+    st_rx_audio_playout_stat(ctx->playout);
+    return 0;
+  }
+
   producer_idx = ctx->framebuff_producer_idx;
   consumer_idx = ctx->framebuff_consumer_idx;
   producer_stat = framebuff[producer_idx].stat;
@@ -310,15 +435,16 @@ struct st30_frame* st30p_rx_get_frame(st30p_rx_handle handle) {
   MT_HANDLE_GUARD(ctx, MT_ST30_HANDLE_PIPELINE_RX, NULL);
 
   if (!ctx->ready) goto out; /* not ready */
+  if (ctx->playout) {
+    dbg("%s(%d), use st30p_rx_playout_read for the playout\n", __func__, idx);
+    goto out;
+  }
 
   ctx->stat_get_frame_try++;
 
-  /* Claim READY->IN_USER. rx_st30p_claim_available() retries across the ring
-   * on a lost CAS race, so it only returns NULL once every slot has actually
-   * been checked -- unlike a scan-then-single-CAS-attempt, which could give up
-   * even while other READY frames remain (spurious failure under contention). */
-  framebuff = rx_st30p_claim_available(ctx, ctx->framebuff_consumer_idx,
-                                       ST30P_RX_FRAME_READY, ST30P_RX_FRAME_IN_USER);
+  /* Claim the oldest READY->IN_USER from the ready queue. */
+  framebuff = rx_st30p_claim_queued(ctx->ready_queue, ST30P_RX_FRAME_READY,
+                                    ST30P_RX_FRAME_IN_USER);
   if (!framebuff && ctx->block_get) { /* wait here */
     mt_pthread_mutex_lock(&ctx->block_wake_mutex);
     while (!ctx->block_wake_pending &&
@@ -331,17 +457,26 @@ struct st30_frame* st30p_rx_get_frame(st30p_rx_handle handle) {
     mt_pthread_mutex_unlock(&ctx->block_wake_mutex);
     if (atomic_load_explicit(&ctx->lc_destroying, memory_order_acquire)) goto out;
     /* get again */
-    framebuff = rx_st30p_claim_available(ctx, ctx->framebuff_consumer_idx,
-                                         ST30P_RX_FRAME_READY, ST30P_RX_FRAME_IN_USER);
+    framebuff = rx_st30p_claim_queued(ctx->ready_queue, ST30P_RX_FRAME_READY,
+                                      ST30P_RX_FRAME_IN_USER);
   }
   /* not any converted frame */
   if (!framebuff) {
     goto out;
   }
-  /* point to next (best-effort hint; the CAS above is the real guard) */
+  /* point to next (only for the stat dump, the queue gives the order) */
   ctx->framebuff_consumer_idx = rx_st30p_next_idx(ctx, framebuff->idx);
 
   frame = &framebuff->frame;
+  if (ctx->pcm) {
+    /* convert on the app thread, the transport framebuff goes back at once */
+    if (st_pcm_converter_to_app(ctx->pcm, framebuff->wire_addr, frame->addr) < 0) {
+      err("%s(%d), frame %u convert fail\n", __func__, idx, framebuff->idx);
+      frame->status = ST_FRAME_STATUS_CORRUPTED;
+    }
+    st30_rx_put_framebuff(ctx->transport, framebuff->wire_addr);
+    framebuff->wire_addr = NULL;
+  }
   ctx->stat_get_frame_succ++;
   atomic_fetch_add_explicit(&ctx->stat_frames_received, 1, memory_order_relaxed);
   if (frame->status == ST_FRAME_STATUS_CORRUPTED)
@@ -376,9 +511,9 @@ int st30p_rx_put_frame(st30p_rx_handle handle, struct st30_frame* frame) {
     goto out;
   }
 
-  /* free the frame */
-  st30_rx_put_framebuff(ctx->transport, frame->addr);
-  atomic_store_explicit(&framebuff->stat, ST30P_RX_FRAME_FREE, memory_order_release);
+  /* free the frame, the transport framebuff of a converted frame is already back */
+  if (!ctx->pcm) st30_rx_put_framebuff(ctx->transport, frame->addr);
+  rx_st30p_set_free(ctx, framebuff);
   ctx->stat_put_frame++;
 
   MT_USDT_ST30P_RX_FRAME_PUT(idx, framebuff->idx, frame->addr);
@@ -407,8 +542,8 @@ int st30p_rx_put_frame_abort(st30p_rx_handle handle, struct st30_frame* frame) {
   }
 
   /* free the frame without processing */
-  st30_rx_put_framebuff(ctx->transport, frame->addr);
-  atomic_store_explicit(&framebuff->stat, ST30P_RX_FRAME_FREE, memory_order_release);
+  if (!ctx->pcm) st30_rx_put_framebuff(ctx->transport, frame->addr);
+  rx_st30p_set_free(ctx, framebuff);
   dbg("%s(%d), frame %u aborted\n", __func__, idx, consumer_idx);
   ret = 0;
 out:
@@ -536,7 +671,7 @@ st30p_rx_handle st30p_rx_create(mtl_handle mt, struct st30p_rx_ops* ops) {
   notice("%s(%d), flags 0x%x\n", __func__, idx, ops->flags);
   st30p_rx_idx++;
 
-  if (!ctx->block_get) rx_st30p_notify_frame_available(ctx);
+  if (!ctx->block_get && !ctx->playout) rx_st30p_notify_frame_available(ctx);
 
   mt_stat_register(impl, rx_st30p_stat, ctx, ctx->ops_name);
 
@@ -549,7 +684,7 @@ size_t st30p_rx_frame_size(st30p_rx_handle handle) {
 
   MT_HANDLE_GUARD(ctx, MT_ST30_HANDLE_PIPELINE_RX, 0);
 
-  ret = ctx->ops.framebuff_size;
+  ret = ctx->pcm ? ctx->pcm->app_frame_size : ctx->ops.framebuff_size;
   MT_HANDLE_RELEASE(ctx);
   return ret;
 }
@@ -591,6 +726,23 @@ out:
   return ret;
 }
 
+int st30p_rx_get_meter(st30p_rx_handle handle, struct st30_meter_level* levels,
+                       uint16_t channel_cnt) {
+  struct st30p_rx_ctx* ctx = handle;
+  int ret;
+
+  if (!handle) {
+    err("%s, invalid handle %p\n", __func__, handle);
+    return -EINVAL;
+  }
+
+  MT_HANDLE_GUARD(ctx, MT_ST30_HANDLE_PIPELINE_RX, -EIO);
+
+  ret = st30_rx_get_meter(ctx->transport, levels, channel_cnt);
+  MT_HANDLE_RELEASE(ctx);
+  return ret;
+}
+
 int st30p_rx_reset_session_stats(st30p_rx_handle handle) {
   struct st30p_rx_ctx* ctx = handle;
   int ret;
@@ -640,4 +792,42 @@ int st30p_rx_set_block_timeout(st30p_rx_handle handle, uint64_t timedwait_ns) {
   ctx->block_timeout_ns = timedwait_ns;
   MT_HANDLE_RELEASE(ctx);
   return 0;
-}
\ No newline at end of file
+}
+
+int st30p_rx_playout_read(st30p_rx_handle handle, uint64_t ptp_time, void* buf,
+                          uint32_t samples, struct st30p_rx_playout_meta* meta) {
+  struct st30p_rx_ctx* ctx = handle;
+  struct st_rx_audio_playout_impl* p;
+  uint32_t concealed, ahead;
+  uint64_t pos;
+  int ret;
+
+  if (!handle || !buf) {
+    err("%s, invalid handle %p or buf %p\n", __func__, handle, buf);
+    return -EINVAL;
+  }
+
+  MT_HANDLE_GUARD(ctx, MT_ST30_HANDLE_PIPELINE_RX, -EIO);
+
+  p = ctx->playout;
+  if (!ctx->ready || !p) {
+    err("%s(%d), not a ready playout session\n", __func__, ctx->idx);
+    ret = -EIO;
+    goto out;
+  }
+
+  if (!ptp_time) ptp_time = mt_get_ptp_time(ctx->impl, MTL_PORT_P);
+  pos = st_rx_audio_playout_ptp2pos(p, ptp_time) - p->latency_samples;
+  ret = st_rx_audio_playout_read(p, pos, samples, buf, &concealed, &ahead);
+  if (ret < 0) goto out;
+
+  if (meta) {
+    meta->ptp_time = ptp_time;
+    meta->rtp_timestamp = (uint32_t)pos;
+    meta->concealed_samples = concealed;
+    meta->ahead_samples = ahead;
+  }
+out:
+  MT_HANDLE_RELEASE(ctx);
+  return ret;
+}
@@ -6,7 +6,11 @@
 #define _ST_LIB_PIPELINE_ST30_RX_HEAD_H_
 
 #include "../st_main.h"
+#include "../st_pcm_convert.h"
+#include "../st_rx_audio_meter.h"
+#include "../st_rx_audio_playout.h"
 #include "st30_pipeline_api.h"
+#include "st_frame_queue.h"
 
 enum st30p_rx_frame_status {
   ST30P_RX_FRAME_FREE = 0,
@@ -19,6 +23,8 @@ struct st30p_rx_frame {
   _Atomic uint32_t stat;
   struct st30_frame frame;
   uint16_t idx;
+  /* the transport framebuff for the app_fmt conversion, NULL once put back */
+  void* wire_addr;
 };
 
 /* See st20p_rx_ctx note re: ->transport lifetime; access via MT_HANDLE_GUARD. */
@@ -39,8 +45,20 @@ struct st30p_rx_ctx {
   uint16_t framebuff_producer_idx;
   uint16_t framebuff_consumer_idx;
   struct st30p_rx_frame* framebuffs;
+  struct rte_ring* free_queue;  /* FREE framebuffs for the transport */
+  struct rte_ring* ready_queue; /* READY framebuffs for get_frame, arrival order */
   bool ready;
 
+  /* the ring of ST30P_RX_FLAG_PLAYOUT, no framebuffs then */
+  struct st_rx_audio_playout_impl* playout;
+
+  /* the app_fmt conversion, NULL if the app gets the wire format */
+  struct st_pcm_converter* pcm;
+  uint8_t* app_fbs; /* the converted frames */
+
+  /* the levels of ST30P_RX_FLAG_ENABLE_METER, channel entries for each framebuff */
+  struct st30_meter_level* meters;
+
   /* usdt dump */
   int usdt_dump_fd;
   char usdt_dump_path[64];
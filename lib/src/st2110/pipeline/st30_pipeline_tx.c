@@ -7,6 +7,7 @@
 #include "../../mt_handle_guard.h"
 #include "../../mt_log.h"
 #include "../../mt_stat.h"
+#include "../st_tx_audio_session.h"
 
 static const char* st30p_tx_frame_stat_name[ST30P_TX_FRAME_STATUS_MAX] = {
     "free", "in_user", "ready", "dropped", "in_transmitting",
@@ -38,48 +39,29 @@ static void tx_st30p_notify_frame_available(struct st30p_tx_ctx* ctx) {
   }
 }
 
-static struct st30p_tx_frame* tx_st30p_next_available(
-    struct st30p_tx_ctx* ctx, enum st30p_tx_frame_status desired) {
-  struct st30p_tx_frame* framebuff;
-
-  for (int idx = 0; idx < ctx->framebuff_cnt; idx++) {
-    framebuff = &ctx->framebuffs[idx];
-    if (desired == atomic_load_explicit(&framebuff->stat, memory_order_acquire)) {
-      return framebuff;
-    }
-  }
-
-  /* no any desired frame */
-  return NULL;
+static void tx_st30p_queue_put(struct st30p_tx_ctx* ctx, struct rte_ring* queue,
+                               struct st30p_tx_frame* framebuff) {
+  /* never full as a framebuff is queued only once when it enters the status */
+  if (st_frame_queue_put(queue, framebuff) < 0)
+    err("%s(%d), queue full for frame %u\n", __func__, ctx->idx, framebuff->idx);
 }
 
-static struct st30p_tx_frame* tx_st30p_newest_available(
-    struct st30p_tx_ctx* ctx, enum st30p_tx_frame_status desired) {
-  struct st30p_tx_frame* framebuff_newest = NULL;
-
-  for (uint16_t idx = 0; idx < ctx->framebuff_cnt; idx++) {
-    struct st30p_tx_frame* framebuff = &ctx->framebuffs[idx];
-    if ((desired == framebuff->stat) &&
-        (!framebuff_newest ||
-         !mt_seq32_greater(framebuff->seq_number, framebuff_newest->seq_number))) {
-      framebuff_newest = framebuff;
-    }
-  }
-
-  return framebuff_newest;
+static void tx_st30p_set_free(struct st30p_tx_ctx* ctx,
+                              struct st30p_tx_frame* framebuff) {
+  atomic_store_explicit(&framebuff->stat, ST30P_TX_FRAME_FREE, memory_order_release);
+  tx_st30p_queue_put(ctx, ctx->free_queue, framebuff);
 }
 
-/* Scan for a framebuff in state `desired` and atomically claim it by
- * transitioning it to `claimed`. A concurrent thread can win the race on the
- * scanned candidate between the scan and the claim; on a lost race this keeps
- * scanning instead of giving up, so the caller only sees NULL once every slot
- * has genuinely been checked and found unavailable. */
-static struct st30p_tx_frame* tx_st30p_claim_available(
-    struct st30p_tx_ctx* ctx, enum st30p_tx_frame_status desired,
+/* Get framebuffs from the queue of `desired` in fifo order and atomically claim the
+ * first one by transitioning it to `claimed`. An entry which fails the CAS was already
+ * moved out of `desired` by a direct status write, it is dropped and the next entry is
+ * tried, so the caller only sees NULL once the queue is really empty. */
+static struct st30p_tx_frame* tx_st30p_claim_queued(
+    struct rte_ring* queue, enum st30p_tx_frame_status desired,
     enum st30p_tx_frame_status claimed) {
   struct st30p_tx_frame* framebuff;
 
-  while ((framebuff = tx_st30p_next_available(ctx, desired))) {
+  while ((framebuff = st_frame_queue_get(queue))) {
     uint32_t expected = desired;
     if (atomic_compare_exchange_strong_explicit(&framebuff->stat, &expected, claimed,
                                                 memory_order_acq_rel,
@@ -90,8 +72,9 @@ static struct st30p_tx_frame* tx_st30p_claim_available(
   return NULL;
 }
 
-/* Check if the oldest READY frame has missed its transmission window.
- * Drops the frame (READY -> DROPPED -> FREE) if cur_tai > frame_tai + frame_period.
+/* Check if the oldest READY frame, already claimed to IN_TRANSMITTING from the ready
+ * queue, has missed its transmission window.
+ * Drops the frame (-> DROPPED -> FREE) if cur_tai > frame_tai + frame_period.
  *
  * Locking contract (mirrors st20p):
  *   1. Caller holds ctx->lock.
@@ -143,7 +126,7 @@ static bool tx_st30p_if_frame_late(struct st30p_tx_ctx* ctx,
   if (ctx->ops.notify_frame_late) ctx->ops.notify_frame_late(ctx->ops.priv, 0);
   MT_USDT_ST30P_TX_FRAME_DROP(ctx->idx, framebuff->idx, rtp_ts);
 
-  atomic_store_explicit(&framebuff->stat, ST30P_TX_FRAME_FREE, memory_order_release);
+  tx_st30p_set_free(ctx, framebuff);
 
   tx_st30p_notify_frame_available(ctx);
 
@@ -160,39 +143,31 @@ static int tx_st30p_next_frame(void* priv, uint16_t* next_frame_idx,
 
   if (!ctx->ready) return -EBUSY; /* not ready */
 
-  do {
-    framebuff = tx_st30p_newest_available(ctx, ST30P_TX_FRAME_READY);
-    if (!framebuff) break; /* no ready frame available */
+  /* Claim the oldest READY -> IN_TRANSMITTING, the late check runs on the claimed
+   * frame so a concurrent transport thread never sees it. */
+  while (1) {
     if (drop_cnt >= ST_TX_ST30P_DROP_MAX_BATCH) {
       info("%s(%d), max drop batch %d reached, stopping\n", __func__, ctx->idx, drop_cnt);
       framebuff = NULL;
       break;
     }
+    framebuff = tx_st30p_claim_queued(ctx->ready_queue, ST30P_TX_FRAME_READY,
+                                      ST30P_TX_FRAME_IN_TRANSMITTING);
+    if (!framebuff) break; /* no ready frame available */
+    if (!tx_st30p_if_frame_late(ctx, framebuff)) break;
     drop_cnt++;
-  } while (tx_st30p_if_frame_late(ctx, framebuff));
+  }
 
   /* not any ready frame */
   if (!framebuff) {
     /* When drop-when-late is active, ensure the app knows about free slots so it
      * can refill the pipeline promptly after drops freed frames. */
     if (ctx->ops.flags & ST30P_TX_FLAG_DROP_WHEN_LATE) {
-      if (tx_st30p_next_available(ctx, ST30P_TX_FRAME_FREE))
-        tx_st30p_notify_frame_available(ctx);
+      if (st_frame_queue_count(ctx->free_queue)) tx_st30p_notify_frame_available(ctx);
     }
     return -EBUSY;
   }
 
-  /* Atomically claim READY -> IN_TRANSMITTING.  A concurrent transport thread
-   * may have already taken this slot between the scan and now; on a lost
-   * race return -EBUSY and let the caller (transport loop) retry. */
-  {
-    uint32_t expected_stat = ST30P_TX_FRAME_READY;
-    if (!atomic_compare_exchange_strong_explicit(
-            &framebuff->stat, &expected_stat, ST30P_TX_FRAME_IN_TRANSMITTING,
-            memory_order_acq_rel, memory_order_relaxed)) {
-      return -EBUSY;
-    }
-  }
   *next_frame_idx = framebuff->idx;
 
   if (ctx->ops.flags & (ST30P_TX_FLAG_USER_PACING)) {
@@ -222,7 +197,7 @@ static int tx_st30p_frame_done(void* priv, uint16_t frame_idx,
   if (ST30P_TX_FRAME_IN_TRANSMITTING ==
       atomic_load_explicit(&framebuff->stat, memory_order_acquire)) {
     ret = 0;
-    atomic_store_explicit(&framebuff->stat, ST30P_TX_FRAME_FREE, memory_order_release);
+    tx_st30p_set_free(ctx, framebuff);
     dbg("%s(%d), done_idx %u\n", __func__, ctx->idx, frame_idx);
   } else {
     ret = -EIO;
@@ -276,6 +251,7 @@ static int tx_st30p_create_transport(struct mtl_main_impl* impl, struct st30p_tx
   }
   if (ops->flags & ST30P_TX_FLAG_DEDICATE_QUEUE)
     ops_tx.flags |= ST30_TX_FLAG_DEDICATE_QUEUE;
+  if (ops->flags & ST30P_TX_FLAG_JUMBO_FRAME) ops_tx.flags |= ST30_TX_FLAG_JUMBO_FRAME;
   if (ops->flags & ST30P_TX_FLAG_FORCE_NUMA) {
     ops_tx.socket_id = ops->socket_id;
     ops_tx.flags |= ST30_TX_FLAG_FORCE_NUMA;
@@ -292,13 +268,15 @@ static int tx_st30p_create_transport(struct mtl_main_impl* impl, struct st30p_tx
   ops_tx.framebuff_cnt = ops->framebuff_cnt;
   ops_tx.framebuff_size = ops->framebuff_size;
   ops_tx.type = ST30_TYPE_FRAME_LEVEL;
-  ops_tx.get_next_frame = tx_st30p_next_frame;
-  ops_tx.notify_frame_done = tx_st30p_frame_done;
+  if (!ctx->stream) {
+    ops_tx.get_next_frame = tx_st30p_next_frame;
+    ops_tx.notify_frame_done = tx_st30p_frame_done;
+  }
   ops_tx.rl_accuracy_ns = ops->rl_accuracy_ns;
   ops_tx.rl_offset_ns = ops->rl_offset_ns;
   ops_tx.fifo_size = ops->fifo_size;
 
-  transport = st30_tx_create(impl, &ops_tx);
+  transport = st30_tx_create_with_stream(impl, &ops_tx, ctx->stream);
   if (!transport) {
     err("%s(%d), transport create fail\n", __func__, idx);
     return -EIO;
@@ -310,6 +288,11 @@ static int tx_st30p_create_transport(struct mtl_main_impl* impl, struct st30p_tx
   for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
     struct st30_frame* frame = &frames[i].frame;
 
+    if (ctx->pcm) {
+      /* the app frame is set in tx_st30p_init_fbs, converted in st30p_tx_put_frame */
+      frames[i].wire_addr = st30_tx_get_framebuffer(transport, i);
+      continue;
+    }
     frame->addr = st30_tx_get_framebuffer(transport, i);
     dbg("%s(%d), fb %p\n", __func__, idx, frame->addr);
   }
@@ -318,6 +301,18 @@ static int tx_st30p_create_transport(struct mtl_main_impl* impl, struct st30p_tx
 }
 
 static int tx_st30p_uinit_fbs(struct st30p_tx_ctx* ctx) {
+  if (ctx->stream) {
+    st_tx_audio_stream_free(ctx->stream);
+    ctx->stream = NULL;
+  }
+  if (ctx->pcm) {
+    st_pcm_converter_free(ctx->pcm);
+    ctx->pcm = NULL;
+  }
+  if (ctx->app_fbs) {
+    mt_rte_free(ctx->app_fbs);
+    ctx->app_fbs = NULL;
+  }
   if (ctx->framebuffs) {
     for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
       if (ctx->framebuffs[i].stat != ST30P_TX_FRAME_FREE) {
@@ -328,14 +323,118 @@ static int tx_st30p_uinit_fbs(struct st30p_tx_ctx* ctx) {
     mt_rte_free(ctx->framebuffs);
     ctx->framebuffs = NULL;
   }
+  if (ctx->free_queue) {
+    st_frame_queue_free(ctx->free_queue);
+    ctx->free_queue = NULL;
+  }
+  if (ctx->ready_queue) {
+    st_frame_queue_free(ctx->ready_queue);
+    ctx->ready_queue = NULL;
+  }
 
   return 0;
 }
 
+static int tx_st30p_init_pcm(struct st30p_tx_ctx* ctx, struct st30p_tx_ops* ops) {
+  int idx = ctx->idx;
+
+  if (ops->app_fmt == ST30P_SAMPLE_FMT_WIRE) return 0;
+  if (ops->app_fmt >= ST30P_SAMPLE_FMT_MAX || !st_pcm_convert_fmt_supported(ops->fmt)) {
+    err("%s(%d), app fmt %d not supported for fmt %d\n", __func__, idx, ops->app_fmt,
+        ops->fmt);
+    return -EINVAL;
+  }
+  if (ops->app_channel_map) {
+    uint16_t app_channel = ops->app_channel ? ops->app_channel : ops->channel;
+
+    /* one session channel can only be sent from one app channel */
+    for (uint16_t i = 0; i < app_channel; i++) {
+      for (uint16_t j = i + 1; j < app_channel; j++) {
+        if (ops->app_channel_map[i] == ops->app_channel_map[j]) {
+          err("%s(%d), app channel %u and %u both map to %u\n", __func__, idx, i, j,
+              ops->app_channel_map[i]);
+          return -EINVAL;
+        }
+      }
+    }
+  }
+
+  ctx->pcm = st_pcm_converter_create(ops->fmt, ops->channel, ops->framebuff_size,
+                                     ops->app_fmt, ops->app_planar, ops->app_channel,
+                                     ops->app_channel_map);
+  if (!ctx->pcm) {
+    err("%s(%d), pcm converter create fail\n", __func__, idx);
+    return -EINVAL;
+  }
+  /* the map is in the converter, the pointer of app may not live after create */
+  ctx->ops.app_channel_map = NULL;
+
+  ctx->app_fbs = mt_rte_zmalloc_socket(ctx->pcm->app_frame_size * ctx->framebuff_cnt,
+                                       ctx->socket_id);
+  if (!ctx->app_fbs) {
+    err("%s(%d), app frames malloc fail\n", __func__, idx);
+    return -ENOMEM;
+  }
+  info("%s(%d), app fmt %d %s, %u ch\n", __func__, idx, ops->app_fmt,
+       ops->app_planar ? "planar" : "interleaved", ctx->pcm->app_channel);
+  return 0;
+}
+
+static int tx_st30p_init_stream(struct st30p_tx_ctx* ctx, struct st30p_tx_ops* ops) {
+  int idx = ctx->idx;
+  uint64_t size = (uint64_t)ops->framebuff_size * ops->framebuff_cnt;
+
+  if (ops->flags & (ST30P_TX_FLAG_USER_PACING | ST30P_TX_FLAG_DROP_WHEN_LATE)) {
+    err("%s(%d), the stream is paced by the media clock, flags 0x%x\n", __func__, idx,
+        ops->flags);
+    return -EINVAL;
+  }
+  if (ops->app_fmt != ST30P_SAMPLE_FMT_WIRE) {
+    if (ops->app_fmt >= ST30P_SAMPLE_FMT_MAX || !st_pcm_convert_fmt_supported(ops->fmt)) {
+      err("%s(%d), app fmt %d not supported for fmt %d\n", __func__, idx, ops->app_fmt,
+          ops->fmt);
+      return -EINVAL;
+    }
+    ctx->pcm = st_pcm_converter_create(ops->fmt, ops->channel, ops->framebuff_size,
+                                       ops->app_fmt, ops->app_planar, ops->app_channel,
+                                       ops->app_channel_map);
+    if (!ctx->pcm) {
+      err("%s(%d), pcm converter create fail\n", __func__, idx);
+      return -EINVAL;
+    }
+    ctx->ops.app_channel_map = NULL;
+    /* the samples are converted straight to the ring, one run for any count */
+    if (!ctx->pcm->flat) {
+      err("%s(%d), the stream converts the interleaved 1:1 channels only\n", __func__,
+          idx);
+      return -EINVAL;
+    }
+  }
+
+  ctx->stream =
+      st_tx_audio_stream_create(idx, ops->fmt, ops->channel, ops->sampling, ops->ptime,
+                                size, ops->framebuff_size, ctx->socket_id);
+  if (!ctx->stream) {
+    err("%s(%d), stream create fail\n", __func__, idx);
+    return -EINVAL;
+  }
+  return 0;
+}
+
 static int tx_st30p_init_fbs(struct st30p_tx_ctx* ctx, struct st30p_tx_ops* ops) {
   int idx = ctx->idx;
   int soc_id = ctx->socket_id;
   struct st30p_tx_frame* frames;
+  int ret;
+
+  /* the app writes the sample ring, no framebuffs */
+  if (ops->flags & ST30P_TX_FLAG_STREAM) {
+    ctx->framebuff_cnt = 0;
+    return tx_st30p_init_stream(ctx, ops);
+  }
+
+  ret = tx_st30p_init_pcm(ctx, ops);
+  if (ret < 0) return ret;
 
   frames = mt_rte_zmalloc_socket(sizeof(*frames) * ctx->framebuff_cnt, soc_id);
   if (!frames) {
@@ -344,12 +443,19 @@ static int tx_st30p_init_fbs(struct st30p_tx_ctx* ctx, struct st30p_tx_ops* ops)
   }
   ctx->framebuffs = frames;
 
+  ctx->free_queue = st_frame_queue_create("st30p_tx_free", ctx->framebuff_cnt, soc_id);
+  ctx->ready_queue = st_frame_queue_create("st30p_tx_ready", ctx->framebuff_cnt, soc_id);
+  if (!ctx->free_queue || !ctx->ready_queue) {
+    err("%s(%d), frame queue create fail\n", __func__, idx);
+    return -ENOMEM;
+  }
+
   for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
     struct st30p_tx_frame* framebuff = &frames[i];
     struct st30_frame* frame = &framebuff->frame;
 
-    atomic_store_explicit(&framebuff->stat, ST30P_TX_FRAME_FREE, memory_order_relaxed);
     framebuff->idx = i;
+    tx_st30p_set_free(ctx, framebuff);
 
     /* addr will be resolved later in tx_st30p_create_transport */
     frame->priv = framebuff;
@@ -359,6 +465,13 @@ static int tx_st30p_init_fbs(struct st30p_tx_ctx* ctx, struct st30p_tx_ops* ops)
     frame->ptime = ops->ptime;
     /* same to framebuffer size */
     frame->buffer_size = frame->data_size = ops->framebuff_size;
+    if (ctx->pcm) {
+      frame->addr = ctx->app_fbs + ctx->pcm->app_frame_size * i;
+      frame->sample_fmt = ops->app_fmt;
+      frame->planar = ops->app_planar;
+      frame->channel = ctx->pcm->app_channel;
+      frame->buffer_size = frame->data_size = ctx->pcm->app_frame_size;
+    }
     dbg("%s(%d), init fb %u\n", __func__, idx, i);
   }
 
@@ -389,6 +502,11 @@ static int tx_st30p_stat(void* priv) {
   }
   dbg("TX_st30p(%d,%s), framebuffer queue: %s\n", ctx->idx, ctx->ops_name, status_str);
 
+  if (ctx->stream) {
+    st_tx_audio_stream_stat(ctx->stream);
+    return 0;
+  }
+
   notice("TX_st30p(%d), frame get try %d succ %d, put %d, drop %d\n", ctx->idx,
          ctx->stat_get_frame_try, ctx->stat_get_frame_succ, ctx->stat_put_frame,
          ctx->stat_drop_frame);
@@ -493,14 +611,16 @@ struct st30_frame* st30p_tx_get_frame(st30p_tx_handle handle) {
   MT_HANDLE_GUARD(ctx, MT_ST30_HANDLE_PIPELINE_TX, NULL);
 
   if (!ctx->ready) goto out; /* not ready */
+  if (ctx->stream) {
+    dbg("%s(%d), use st30p_tx_write_samples for the stream\n", __func__, idx);
+    goto out;
+  }
 
   ctx->stat_get_frame_try++;
 
-  /* Claim FREE->IN_USER. tx_st30p_claim_available() retries across the ring
-   * on a lost CAS race, so it only returns NULL once every slot has actually
-   * been checked -- unlike a scan-then-single-CAS-attempt, which could give up
-   * even while other FREE frames remain (spurious failure under contention). */
-  framebuff = tx_st30p_claim_available(ctx, ST30P_TX_FRAME_FREE, ST30P_TX_FRAME_IN_USER);
+  /* Claim FREE->IN_USER from the free queue, O(1) regardless of framebuff_cnt. */
+  framebuff =
+      tx_st30p_claim_queued(ctx->free_queue, ST30P_TX_FRAME_FREE, ST30P_TX_FRAME_IN_USER);
   if (!framebuff && ctx->block_get) { /* wait here */
     mt_pthread_mutex_lock(&ctx->block_wake_mutex);
     while (!ctx->block_wake_pending &&
@@ -513,8 +633,8 @@ struct st30_frame* st30p_tx_get_frame(st30p_tx_handle handle) {
     mt_pthread_mutex_unlock(&ctx->block_wake_mutex);
     if (atomic_load_explicit(&ctx->lc_destroying, memory_order_acquire)) goto out;
     /* get again */
-    framebuff =
-        tx_st30p_claim_available(ctx, ST30P_TX_FRAME_FREE, ST30P_TX_FRAME_IN_USER);
+    framebuff = tx_st30p_claim_queued(ctx->free_queue, ST30P_TX_FRAME_FREE,
+                                      ST30P_TX_FRAME_IN_USER);
   }
   /* not any free frame */
   if (!framebuff) {
@@ -557,7 +677,17 @@ int st30p_tx_put_frame(st30p_tx_handle handle, struct st30_frame* frame) {
     goto out;
   }
 
+  if (ctx->pcm) {
+    /* convert on the app thread, the transport only sees the wire format */
+    ret = st_pcm_converter_to_wire(ctx->pcm, frame->addr, framebuff->wire_addr);
+    if (ret < 0) {
+      err("%s(%d), frame %u convert fail %d\n", __func__, idx, producer_idx, ret);
+      goto out;
+    }
+  }
+
   atomic_store_explicit(&framebuff->stat, ST30P_TX_FRAME_READY, memory_order_release);
+  tx_st30p_queue_put(ctx, ctx->ready_queue, framebuff);
   ctx->stat_put_frame++;
   MT_USDT_ST30P_TX_FRAME_PUT(idx, framebuff->idx, frame->addr);
   dbg("%s(%d), frame %u(%p) succ\n", __func__, idx, producer_idx, frame->addr);
@@ -584,7 +714,7 @@ int st30p_tx_put_frame_abort(st30p_tx_handle handle, struct st30_frame* frame) {
     goto out;
   }
 
-  atomic_store_explicit(&framebuff->stat, ST30P_TX_FRAME_FREE, memory_order_release);
+  tx_st30p_set_free(ctx, framebuff);
   ctx->stat_drop_frame++;
   atomic_fetch_add_explicit(&ctx->stat_frames_dropped, 1, memory_order_relaxed);
   dbg("%s(%d), frame %u aborted\n", __func__, idx, producer_idx);
@@ -714,7 +844,7 @@ st30p_tx_handle st30p_tx_create(mtl_handle mt, struct st30p_tx_ops* ops) {
   st30p_tx_idx++;
 
   /* notify app can get frame */
-  if (!ctx->block_get) tx_st30p_notify_frame_available(ctx);
+  if (!ctx->block_get && !ctx->stream) tx_st30p_notify_frame_available(ctx);
 
   mt_stat_register(impl, tx_st30p_stat, ctx, ctx->ops_name);
 
@@ -759,7 +889,7 @@ size_t st30p_tx_frame_size(st30p_tx_handle handle) {
 
   MT_HANDLE_GUARD(ctx, MT_ST30_HANDLE_PIPELINE_TX, 0);
 
-  ret = ctx->ops.framebuff_size;
+  ret = ctx->pcm ? ctx->pcm->app_frame_size : ctx->ops.framebuff_size;
   MT_HANDLE_RELEASE(ctx);
   return ret;
 }
@@ -783,6 +913,56 @@ out:
   return ret_addr;
 }
 
+int st30p_tx_write_samples(st30p_tx_handle handle, const void* buf, uint32_t samples) {
+  struct st30p_tx_ctx* ctx = handle;
+  struct st_tx_audio_stream_impl* stream;
+  const uint8_t* src = buf;
+  uint32_t written = 0;
+  int ret;
+
+  if (!handle || !buf) {
+    err("%s, invalid handle %p or buf %p\n", __func__, handle, buf);
+    return -EINVAL;
+  }
+
+  MT_HANDLE_GUARD(ctx, MT_ST30_HANDLE_PIPELINE_TX, -EIO);
+
+  stream = ctx->stream;
+  if (!ctx->ready || !stream) {
+    err("%s(%d), not a ready stream session\n", __func__, ctx->idx);
+    ret = -EIO;
+    goto out;
+  }
+
+  if (!ctx->pcm) {
+    ret = st_tx_audio_stream_write(stream, buf, samples);
+    goto out;
+  }
+
+  /* convert to the ring, at most two runs for the wrap */
+  while (written < samples) {
+    struct st_pcm_converter* pcm = ctx->pcm;
+    uint8_t* dst;
+    uint32_t n = RTE_MIN(st_tx_audio_stream_reserve(stream, &dst), samples - written);
+
+    if (!n) break; /* full */
+    st_pcm_to_wire_simd(src, dst, n * pcm->wire_channel, pcm->wire_fmt, pcm->app_fmt,
+                        pcm->simd_level);
+    st_tx_audio_stream_commit(stream, n);
+    src += (size_t)n * pcm->app_channel * sizeof(int32_t);
+    written += n;
+  }
+  atomic_fetch_add_explicit(&stream->stat_samples_written, written,
+                            memory_order_relaxed);
+  if (written < samples)
+    atomic_fetch_add_explicit(&stream->stat_samples_full, samples - written,
+                              memory_order_relaxed);
+  ret = written;
+out:
+  MT_HANDLE_RELEASE(ctx);
+  return ret;
+}
+
 int st30p_tx_get_session_stats(st30p_tx_handle handle, struct st30_tx_user_stats* stats) {
   struct st30p_tx_ctx* ctx;
   struct st30p_tx_frame* framebuff;
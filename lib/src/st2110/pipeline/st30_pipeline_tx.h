@@ -6,7 +6,10 @@
 #define _ST_LIB_PIPELINE_ST30_TX_HEAD_H_
 
 #include "../st_main.h"
+#include "../st_pcm_convert.h"
+#include "../st_tx_audio_stream.h"
 #include "st30_pipeline_api.h"
+#include "st_frame_queue.h"
 
 /* Maximum number of late frames that can be dropped in a single next_frame call. */
 #ifndef ST_TX_ST30P_DROP_MAX_BATCH
@@ -28,6 +31,8 @@ struct st30p_tx_frame {
   uint16_t idx;
   uint32_t seq_number;
   bool frame_done_cb_called; /* frame done callback called */
+  /* the transport framebuff for the app_fmt conversion */
+  void* wire_addr;
 };
 
 /* See st20p_rx_ctx note re: ->transport lifetime; access via MT_HANDLE_GUARD. */
@@ -47,8 +52,16 @@ struct st30p_tx_ctx {
   uint16_t framebuff_cnt;
   _Atomic uint32_t framebuff_seq_number;
   struct st30p_tx_frame* framebuffs;
+  struct rte_ring* free_queue;  /* FREE framebuffs for get_frame */
+  struct rte_ring* ready_queue; /* READY framebuffs for the transport, put order */
   bool ready;
 
+  /* the app_fmt conversion, NULL if the app puts the wire format */
+  struct st_pcm_converter* pcm;
+  uint8_t* app_fbs; /* the frames of the app */
+  /* the sample ring of ST30P_TX_FLAG_STREAM, no framebuffs */
+  struct st_tx_audio_stream_impl* stream;
+
   /* usdt dump */
   int usdt_dump_fd;
   char usdt_dump_path[64];
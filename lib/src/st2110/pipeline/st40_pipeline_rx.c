@@ -45,40 +45,29 @@ static void rx_st40p_notify_frame_available(struct st40p_rx_ctx* ctx) {
   }
 }
 
-static struct st40p_rx_frame* rx_st40p_next_available(
-    struct st40p_rx_ctx* ctx, uint16_t idx_start, enum st40p_rx_frame_status desired) {
-  uint16_t idx = idx_start;
-  struct st40p_rx_frame* framebuff;
-
-  /* check ready frame from idx_start */
-  while (1) {
-    framebuff = &ctx->framebuffs[idx];
-    if (desired == atomic_load_explicit(&framebuff->stat, memory_order_acquire)) {
-      /* find one desired */
-      return framebuff;
-    }
-    idx = rx_st40p_next_idx(ctx, idx);
-    if (idx == idx_start) {
-      /* loop all frames end */
-      break;
-    }
-  }
+static void rx_st40p_queue_put(struct st40p_rx_ctx* ctx, struct rte_ring* queue,
+                               struct st40p_rx_frame* framebuff) {
+  /* never full as a framebuff is queued only once when it enters the status */
+  if (st_frame_queue_put(queue, framebuff) < 0)
+    err("%s(%d), queue full for frame %u\n", __func__, ctx->idx, framebuff->idx);
+}
 
-  /* no any desired frame */
-  return NULL;
+static void rx_st40p_set_free(struct st40p_rx_ctx* ctx,
+                              struct st40p_rx_frame* framebuff) {
+  atomic_store_explicit(&framebuff->stat, ST40P_RX_FRAME_FREE, memory_order_release);
+  rx_st40p_queue_put(ctx, ctx->free_queue, framebuff);
 }
 
-/* Scan from idx_start for a framebuff in state `desired` and atomically claim
- * it by transitioning it to `claimed`. A concurrent thread can win the race on
- * the scanned candidate between the scan and the claim; on a lost race this
- * keeps scanning instead of giving up, so the caller only sees NULL once every
- * slot has genuinely been checked and found unavailable. */
-static struct st40p_rx_frame* rx_st40p_claim_available(
-    struct st40p_rx_ctx* ctx, uint16_t idx_start, enum st40p_rx_frame_status desired,
+/* Get framebuffs from the queue of `desired` in fifo order and atomically claim the
+ * first one by transitioning it to `claimed`. An entry which fails the CAS was already
+ * moved out of `desired` by a direct status write, it is dropped and the next entry is
+ * tried, so the caller only sees NULL once the queue is really empty. */
+static struct st40p_rx_frame* rx_st40p_claim_queued(
+    struct rte_ring* queue, enum st40p_rx_frame_status desired,
     enum st40p_rx_frame_status claimed) {
   struct st40p_rx_frame* framebuff;
 
-  while ((framebuff = rx_st40p_next_available(ctx, idx_start, desired))) {
+  while ((framebuff = st_frame_queue_get(queue))) {
     uint32_t expected = desired;
     if (atomic_compare_exchange_strong_explicit(&framebuff->stat, &expected, claimed,
                                                 memory_order_acq_rel,
@@ -100,8 +89,12 @@ static int rx_st40p_frame_ready(void* priv, void* addr, struct st40_rx_frame_met
 
   if (!ctx->ready) return -EBUSY;
 
-  framebuff =
-      rx_st40p_next_available(ctx, ctx->framebuff_producer_idx, ST40P_RX_FRAME_FREE);
+  /* the transport is the only producer, nobody else can take a FREE framebuff */
+  while ((framebuff = st_frame_queue_get(ctx->free_queue))) {
+    if (ST40P_RX_FRAME_FREE ==
+        atomic_load_explicit(&framebuff->stat, memory_order_acquire))
+      break;
+  }
   if (!framebuff) {
     ctx->stat_busy++;
     atomic_fetch_add_explicit(&ctx->stat_frames_dropped, 1, memory_order_relaxed);
@@ -114,7 +107,7 @@ static int rx_st40p_frame_ready(void* priv, void* addr, struct st40_rx_frame_met
   frame_info->udw_buffer_fill = meta->udw_buffer_fill;
   frame_info->meta_num = meta->meta_num;
   if (meta->meta_num && meta->meta) {
-    uint32_t copy = meta->meta_num > ST40_MAX_META ? ST40_MAX_META : meta->meta_num;
+    uint32_t copy = RTE_MIN(meta->meta_num, frame_info->meta_cap);
     memcpy(frame_info->meta, meta->meta, sizeof(struct st40_meta) * copy);
   }
   frame_info->pkts_total = meta->pkts_total;
@@ -136,6 +129,7 @@ static int rx_st40p_frame_ready(void* priv, void* addr, struct st40_rx_frame_met
   frame_info->status = meta->status;
 
   atomic_store_explicit(&framebuff->stat, ST40P_RX_FRAME_READY, memory_order_release);
+  rx_st40p_queue_put(ctx, ctx->ready_queue, framebuff);
   ctx->framebuff_producer_idx = rx_st40p_next_idx(ctx, framebuff->idx);
   atomic_fetch_add_explicit(&ctx->stat_frames_received, 1, memory_order_relaxed);
   if (frame_info->seq_discont)
@@ -175,6 +169,7 @@ static int rx_st40p_create_transport(struct mtl_main_impl* impl, struct st40p_rx
   ops_rx.type = ST40_TYPE_FRAME_LEVEL;
   ops_rx.framebuff_cnt = ctx->framebuff_cnt;
   ops_rx.framebuff_size = ops->max_udw_buff_size;
+  ops_rx.max_meta = ops->max_meta;
   ops_rx.notify_frame_ready = rx_st40p_frame_ready;
 
   if (ops->flags & ST40P_RX_FLAG_DATA_PATH_ONLY)
@@ -195,9 +190,23 @@ static int rx_st40p_create_transport(struct mtl_main_impl* impl, struct st40p_rx
 static int rx_st40p_uinit_fbs(struct st40p_rx_ctx* ctx) {
   if (!ctx->framebuffs) return 0;
 
-  /* UDW buffers are owned by the transport pool; nothing to free here. */
+  /* UDW buffers are owned by the transport pool, only the meta arrays here. */
+  for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+    if (ctx->framebuffs[i].meta_array) {
+      mt_rte_free(ctx->framebuffs[i].meta_array);
+      ctx->framebuffs[i].meta_array = NULL;
+    }
+  }
   mt_rte_free(ctx->framebuffs);
   ctx->framebuffs = NULL;
+  if (ctx->free_queue) {
+    st_frame_queue_free(ctx->free_queue);
+    ctx->free_queue = NULL;
+  }
+  if (ctx->ready_queue) {
+    st_frame_queue_free(ctx->ready_queue);
+    ctx->ready_queue = NULL;
+  }
 
   return 0;
 }
@@ -220,11 +229,19 @@ static int rx_st40p_init_fbs(struct st40p_rx_ctx* ctx, struct st40p_rx_ops* ops)
   }
   ctx->framebuffs = frames;
 
+  ctx->free_queue = st_frame_queue_create("st40p_rx_free", ctx->framebuff_cnt, soc_id);
+  ctx->ready_queue = st_frame_queue_create("st40p_rx_ready", ctx->framebuff_cnt, soc_id);
+  if (!ctx->free_queue || !ctx->ready_queue) {
+    err("%s(%d), frame queue create fail\n", __func__, idx);
+    rx_st40p_uinit_fbs(ctx);
+    return -ENOMEM;
+  }
+
   for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
     framebuff = &frames[i];
     frame_info = &framebuff->frame_info;
-    atomic_store_explicit(&framebuff->stat, ST40P_RX_FRAME_FREE, memory_order_relaxed);
     framebuff->idx = i;
+    rx_st40p_set_free(ctx, framebuff);
 
     /* udw_buff_addr is bound at frame_ready time to the transport's pool
      * slot; pipeline does not allocate per-frame UDW buffers. */
@@ -232,7 +249,20 @@ static int rx_st40p_init_fbs(struct st40p_rx_ctx* ctx, struct st40p_rx_ops* ops)
     frame_info->udw_buffer_size = ops->max_udw_buff_size;
     frame_info->udw_buffer_fill = 0;
     frame_info->meta_num = 0;
-    frame_info->meta = framebuff->meta;
+    if (ops->max_meta > ST40_MAX_META) {
+      framebuff->meta_array =
+          mt_rte_zmalloc_socket(sizeof(*framebuff->meta_array) * ops->max_meta, soc_id);
+      if (!framebuff->meta_array) {
+        err("%s(%d), meta_array malloc failed at %u\n", __func__, idx, i);
+        rx_st40p_uinit_fbs(ctx);
+        return -ENOMEM;
+      }
+      frame_info->meta = framebuff->meta_array;
+      frame_info->meta_cap = ops->max_meta;
+    } else {
+      frame_info->meta = framebuff->meta;
+      frame_info->meta_cap = ST40_MAX_META;
+    }
     frame_info->pkts_total = 0;
     frame_info->pkts_recv[MTL_SESSION_PORT_P] = 0;
     frame_info->pkts_recv[MTL_SESSION_PORT_R] = 0;
@@ -336,12 +366,9 @@ struct st40_frame_info* st40p_rx_get_frame(st40p_rx_handle handle) {
 
   ctx->stat_get_frame_try++;
 
-  /* Claim READY->IN_USER. rx_st40p_claim_available() retries across the ring
-   * on a lost CAS race, so it only returns NULL once every slot has actually
-   * been checked -- unlike a scan-then-single-CAS-attempt, which could give up
-   * even while other READY frames remain (spurious failure under contention). */
-  framebuff = rx_st40p_claim_available(ctx, ctx->framebuff_consumer_idx,
-                                       ST40P_RX_FRAME_READY, ST40P_RX_FRAME_IN_USER);
+  /* Claim the oldest READY->IN_USER from the ready queue. */
+  framebuff = rx_st40p_claim_queued(ctx->ready_queue, ST40P_RX_FRAME_READY,
+                                    ST40P_RX_FRAME_IN_USER);
   if (!framebuff && ctx->block_get) { /* wait here */
     mt_pthread_mutex_lock(&ctx->block_wake_mutex);
     while (!ctx->block_wake_pending &&
@@ -354,15 +381,15 @@ struct st40_frame_info* st40p_rx_get_frame(st40p_rx_handle handle) {
     mt_pthread_mutex_unlock(&ctx->block_wake_mutex);
     if (atomic_load_explicit(&ctx->lc_destroying, memory_order_acquire)) goto out;
     /* get again */
-    framebuff = rx_st40p_claim_available(ctx, ctx->framebuff_consumer_idx,
-                                         ST40P_RX_FRAME_READY, ST40P_RX_FRAME_IN_USER);
+    framebuff = rx_st40p_claim_queued(ctx->ready_queue, ST40P_RX_FRAME_READY,
+                                      ST40P_RX_FRAME_IN_USER);
   }
 
   /* not any ready frame */
   if (!framebuff) {
     goto out;
   }
-  /* point to next (best-effort hint; the CAS above is the real guard) */
+  /* point to next (only for the stat dump, the queue gives the order) */
   ctx->framebuff_consumer_idx = rx_st40p_next_idx(ctx, framebuff->idx);
 
   frame_info = &framebuff->frame_info;
@@ -421,7 +448,7 @@ int st40p_rx_put_frame(st40p_rx_handle handle, struct st40_frame_info* frame_inf
   frame_info->receive_timestamp = 0;
   frame_info->second_field = false;
   frame_info->interlaced = false;
-  atomic_store_explicit(&framebuff->stat, ST40P_RX_FRAME_FREE, memory_order_release);
+  rx_st40p_set_free(ctx, framebuff);
   ctx->stat_put_frame++;
 
   MT_USDT_ST40P_RX_FRAME_PUT(idx, consumer_idx, meta_num_before_reset);
@@ -458,7 +485,7 @@ int st40p_rx_put_frame_abort(st40p_rx_handle handle, struct st40_frame_info* fra
   /* reset frame for reuse without processing */
   frame_info->meta_num = 0;
   frame_info->udw_buffer_fill = 0;
-  atomic_store_explicit(&framebuff->stat, ST40P_RX_FRAME_FREE, memory_order_release);
+  rx_st40p_set_free(ctx, framebuff);
   dbg("%s(%d), frame %u aborted\n", __func__, idx, consumer_idx);
   ret = 0;
 out:
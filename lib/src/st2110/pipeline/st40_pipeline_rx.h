@@ -7,6 +7,7 @@
 
 #include "../st_main.h"
 #include "st40_pipeline_api.h"
+#include "st_frame_queue.h"
 
 #if defined(__cplusplus)
 extern "C" {
@@ -41,6 +42,8 @@ struct st40p_rx_ctx {
   uint16_t framebuff_producer_idx;
   uint16_t framebuff_consumer_idx;
   struct st40p_rx_frame* framebuffs;
+  struct rte_ring* free_queue;  /* FREE framebuffs for the transport */
+  struct rte_ring* ready_queue; /* READY framebuffs for get_frame, arrival order */
   bool ready;
 
   /* for ST40P_RX_FLAG_BLOCK_GET */
@@ -69,6 +72,7 @@ struct st40p_rx_frame {
   _Atomic uint32_t stat;
   struct st40_frame_info frame_info;
   struct st40_meta meta[ST40_MAX_META];
+  struct st40_meta* meta_array; /* ops.max_meta entries when over ST40_MAX_META */
   uint16_t idx;
 };
 
@@ -39,50 +39,29 @@ static void tx_st40p_notify_frame_available(struct st40p_tx_ctx* ctx) {
   }
 }
 
-static struct st40p_tx_frame* tx_st40p_newest_available(
-    struct st40p_tx_ctx* ctx, enum st40p_tx_frame_status desired) {
-  struct st40p_tx_frame* framebuff = NULL;
-  struct st40p_tx_frame* framebuff_newest = NULL;
-
-  for (uint16_t idx = 0; idx < ctx->framebuff_cnt; idx++) {
-    framebuff = &ctx->framebuffs[idx];
-    if ((desired == framebuff->stat &&
-         (!framebuff_newest ||
-          !mt_seq32_greater(framebuff->seq_number, framebuff_newest->seq_number)))) {
-      framebuff_newest = framebuff;
-    }
-  }
-
-  return framebuff_newest;
+static void tx_st40p_queue_put(struct st40p_tx_ctx* ctx, struct rte_ring* queue,
+                               struct st40p_tx_frame* framebuff) {
+  /* never full as a framebuff is queued only once when it enters the status */
+  if (st_frame_queue_put(queue, framebuff) < 0)
+    err("%s(%d), queue full for frame %u\n", __func__, ctx->idx, framebuff->idx);
 }
 
-static struct st40p_tx_frame* tx_st40p_next_available(
-    struct st40p_tx_ctx* ctx, enum st40p_tx_frame_status desired) {
-  struct st40p_tx_frame* framebuff;
-
-  /* check ready frame from idx_start */
-  for (uint16_t idx = 0; idx < ctx->framebuff_cnt; idx++) {
-    framebuff = &ctx->framebuffs[idx];
-    if (desired == atomic_load_explicit(&framebuff->stat, memory_order_acquire)) {
-      return framebuff;
-    }
-  }
-
-  /* no any desired frame */
-  return NULL;
+static void tx_st40p_set_free(struct st40p_tx_ctx* ctx,
+                              struct st40p_tx_frame* framebuff) {
+  atomic_store_explicit(&framebuff->stat, ST40P_TX_FRAME_FREE, memory_order_release);
+  tx_st40p_queue_put(ctx, ctx->free_queue, framebuff);
 }
 
-/* Scan for a framebuff in state `desired` and atomically claim it by
- * transitioning it to `claimed`. A concurrent thread can win the race on the
- * scanned candidate between the scan and the claim; on a lost race this keeps
- * scanning instead of giving up, so the caller only sees NULL once every slot
- * has genuinely been checked and found unavailable. */
-static struct st40p_tx_frame* tx_st40p_claim_available(
-    struct st40p_tx_ctx* ctx, enum st40p_tx_frame_status desired,
+/* Get framebuffs from the queue of `desired` in fifo order and atomically claim the
+ * first one by transitioning it to `claimed`. An entry which fails the CAS was already
+ * moved out of `desired` by a direct status write, it is dropped and the next entry is
+ * tried, so the caller only sees NULL once the queue is really empty. */
+static struct st40p_tx_frame* tx_st40p_claim_queued(
+    struct rte_ring* queue, enum st40p_tx_frame_status desired,
     enum st40p_tx_frame_status claimed) {
   struct st40p_tx_frame* framebuff;
 
-  while ((framebuff = tx_st40p_next_available(ctx, desired))) {
+  while ((framebuff = st_frame_queue_get(queue))) {
     uint32_t expected = desired;
     if (atomic_compare_exchange_strong_explicit(&framebuff->stat, &expected, claimed,
                                                 memory_order_acq_rel,
@@ -93,8 +72,9 @@ static struct st40p_tx_frame* tx_st40p_claim_available(
   return NULL;
 }
 
-/* Check if the newest READY frame has missed its transmission window.
- * Drops the frame (READY -> DROPPED -> FREE) if cur_tai > frame_tai + frame_period.
+/* Check if the oldest READY frame, already claimed to IN_TRANSMITTING from the ready
+ * queue, has missed its transmission window.
+ * Drops the frame (-> DROPPED -> FREE) if cur_tai > frame_tai + frame_period.
  *
  * Locking contract (mirrors st20p):
  *   1. Caller holds ctx->lock.
@@ -146,7 +126,7 @@ static bool tx_st40p_if_frame_late(struct st40p_tx_ctx* ctx,
   if (ctx->ops.notify_frame_late) ctx->ops.notify_frame_late(ctx->ops.priv, 0);
   MT_USDT_ST40P_TX_FRAME_DROP(ctx->idx, framebuff->idx, rtp_ts);
 
-  atomic_store_explicit(&framebuff->stat, ST40P_TX_FRAME_FREE, memory_order_release);
+  tx_st40p_set_free(ctx, framebuff);
 
   tx_st40p_notify_frame_available(ctx);
 
@@ -162,39 +142,31 @@ static int tx_st40p_next_frame(void* priv, uint16_t* next_frame_idx,
 
   if (!ctx->ready) return -EBUSY; /* not ready */
 
-  do {
-    framebuff = tx_st40p_newest_available(ctx, ST40P_TX_FRAME_READY);
-    if (!framebuff) break; /* no ready frame available */
+  /* Claim the oldest READY -> IN_TRANSMITTING, the late check runs on the claimed
+   * frame so a concurrent transport thread never sees it. */
+  while (1) {
     if (drop_cnt >= ST_TX_ST40P_DROP_MAX_BATCH) {
       info("%s(%d), max drop batch %d reached, stopping\n", __func__, ctx->idx, drop_cnt);
       framebuff = NULL;
       break;
     }
+    framebuff = tx_st40p_claim_queued(ctx->ready_queue, ST40P_TX_FRAME_READY,
+                                      ST40P_TX_FRAME_IN_TRANSMITTING);
+    if (!framebuff) break; /* no ready frame available */
+    if (!tx_st40p_if_frame_late(ctx, framebuff)) break;
     drop_cnt++;
-  } while (tx_st40p_if_frame_late(ctx, framebuff));
+  }
 
   /* not any ready frame */
   if (!framebuff) {
     /* When drop-when-late is active, ensure the app knows about free slots so it
      * can refill the pipeline promptly after drops freed frames. */
     if (ctx->ops.flags & ST40P_TX_FLAG_DROP_WHEN_LATE) {
-      if (tx_st40p_next_available(ctx, ST40P_TX_FRAME_FREE))
-        tx_st40p_notify_frame_available(ctx);
+      if (st_frame_queue_count(ctx->free_queue)) tx_st40p_notify_frame_available(ctx);
     }
     return -EBUSY;
   }
 
-  /* Atomically claim READY -> IN_TRANSMITTING.  A concurrent transport thread
-   * may have already taken this slot between the scan and now; on a lost
-   * race return -EBUSY and let the caller (transport loop) retry. */
-  {
-    uint32_t expected_stat = ST40P_TX_FRAME_READY;
-    if (!atomic_compare_exchange_strong_explicit(
-            &framebuff->stat, &expected_stat, ST40P_TX_FRAME_IN_TRANSMITTING,
-            memory_order_acq_rel, memory_order_relaxed)) {
-      return -EBUSY;
-    }
-  }
   *next_frame_idx = framebuff->idx;
 
   if (ctx->ops.flags & (ST40P_TX_FLAG_USER_PACING)) {
@@ -228,7 +200,7 @@ static int tx_st40p_frame_done(void* priv, uint16_t frame_idx,
   if (ST40P_TX_FRAME_IN_TRANSMITTING ==
       atomic_load_explicit(&framebuff->stat, memory_order_acquire)) {
     ret = 0;
-    atomic_store_explicit(&framebuff->stat, ST40P_TX_FRAME_FREE, memory_order_release);
+    tx_st40p_set_free(ctx, framebuff);
     dbg("%s(%d), done_idx %u\n", __func__, ctx->idx, frame_idx);
   } else {
     ret = -EIO;
@@ -267,7 +239,8 @@ static int tx_st40p_asign_anc_frames(struct st40p_tx_ctx* ctx) {
     }
     dbg("%s(%d), fb %p\n", __func__, idx, frames[i].anc_frame);
 
-    frame_info->meta = frames[i].anc_frame->meta;
+    frame_info->meta = st40_frame_meta(frames[i].anc_frame);
+    frame_info->meta_cap = st40_frame_meta_cap(frames[i].anc_frame);
     frames[i].anc_frame->data = frame_info->udw_buff_addr;
   }
   return 0;
@@ -323,6 +296,7 @@ static int tx_st40p_create_transport(struct mtl_main_impl* impl, struct st40p_tx
   ops_tx.interlaced = ops->interlaced;
   ops_tx.fps = ops->fps;
   ops_tx.framebuff_cnt = ops->framebuff_cnt;
+  ops_tx.max_meta = ops->max_meta;
   ops_tx.type = ST40_TYPE_FRAME_LEVEL;
   ops_tx.get_next_frame = tx_st40p_next_frame;
   ops_tx.notify_frame_done = tx_st40p_frame_done;
@@ -352,6 +326,14 @@ static int tx_st40p_uinit_fbs(struct st40p_tx_ctx* ctx) {
   }
   mt_rte_free(ctx->framebuffs);
   ctx->framebuffs = NULL;
+  if (ctx->free_queue) {
+    st_frame_queue_free(ctx->free_queue);
+    ctx->free_queue = NULL;
+  }
+  if (ctx->ready_queue) {
+    st_frame_queue_free(ctx->ready_queue);
+    ctx->ready_queue = NULL;
+  }
 
   return 0;
 }
@@ -374,11 +356,18 @@ static int tx_st40p_init_fbs(struct st40p_tx_ctx* ctx, struct st40p_tx_ops* ops)
   }
   ctx->framebuffs = frames;
 
+  ctx->free_queue = st_frame_queue_create("st40p_tx_free", ctx->framebuff_cnt, soc_id);
+  ctx->ready_queue = st_frame_queue_create("st40p_tx_ready", ctx->framebuff_cnt, soc_id);
+  if (!ctx->free_queue || !ctx->ready_queue) {
+    err("%s(%d), frame queue create fail\n", __func__, idx);
+    return -ENOMEM;
+  }
+
   for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
     framebuff = &frames[i];
     frame_info = &framebuff->frame_info;
-    atomic_store_explicit(&framebuff->stat, ST40P_TX_FRAME_FREE, memory_order_relaxed);
     framebuff->idx = i;
+    tx_st40p_set_free(ctx, framebuff);
 
     frame_info->udw_buff_addr = mt_rte_zmalloc_socket(ops->max_udw_buff_size, soc_id);
     if (!frame_info->udw_buff_addr) {
@@ -488,11 +477,9 @@ struct st40_frame_info* st40p_tx_get_frame(st40p_tx_handle handle) {
 
   ctx->stat_get_frame_try++;
 
-  /* Claim FREE->IN_USER. tx_st40p_claim_available() retries across the ring
-   * on a lost CAS race, so it only returns NULL once every slot has actually
-   * been checked -- unlike a scan-then-single-CAS-attempt, which could give up
-   * even while other FREE frames remain (spurious failure under contention). */
-  framebuff = tx_st40p_claim_available(ctx, ST40P_TX_FRAME_FREE, ST40P_TX_FRAME_IN_USER);
+  /* Claim FREE->IN_USER from the free queue, O(1) regardless of framebuff_cnt. */
+  framebuff =
+      tx_st40p_claim_queued(ctx->free_queue, ST40P_TX_FRAME_FREE, ST40P_TX_FRAME_IN_USER);
   if (!framebuff && ctx->block_get) { /* wait here */
     mt_pthread_mutex_lock(&ctx->block_wake_mutex);
     while (!ctx->block_wake_pending &&
@@ -505,8 +492,8 @@ struct st40_frame_info* st40p_tx_get_frame(st40p_tx_handle handle) {
     mt_pthread_mutex_unlock(&ctx->block_wake_mutex);
     if (atomic_load_explicit(&ctx->lc_destroying, memory_order_acquire)) goto out;
     /* get again */
-    framebuff =
-        tx_st40p_claim_available(ctx, ST40P_TX_FRAME_FREE, ST40P_TX_FRAME_IN_USER);
+    framebuff = tx_st40p_claim_queued(ctx->free_queue, ST40P_TX_FRAME_FREE,
+                                      ST40P_TX_FRAME_IN_USER);
   }
 
   /* not any free frame */
@@ -547,7 +534,7 @@ int st40p_tx_put_frame(st40p_tx_handle handle, struct st40_frame_info* frame_inf
   framebuff->anc_frame->meta_num = frame_info->meta_num;
   framebuff->anc_frame->data_size = frame_info->udw_buffer_fill;
 
-  if (framebuff->anc_frame->meta_num > ST40_MAX_META) {
+  if (framebuff->anc_frame->meta_num > st40_frame_meta_cap(framebuff->anc_frame)) {
     err("%s(%d), frame %u meta_num %u invalid\n", __func__, idx, producer_idx,
         frame_info->meta_num);
     ret = -EIO;
@@ -556,6 +543,7 @@ int st40p_tx_put_frame(st40p_tx_handle handle, struct st40_frame_info* frame_inf
 
   framebuff->frame_info.udw_buffer_fill = 0;
   atomic_store_explicit(&framebuff->stat, ST40P_TX_FRAME_READY, memory_order_release);
+  tx_st40p_queue_put(ctx, ctx->ready_queue, framebuff);
   ctx->stat_put_frame++;
   MT_USDT_ST40P_TX_FRAME_PUT(idx, framebuff->idx, framebuff->anc_frame->data);
   dbg("%s(%d), frame %u(%p) succ\n", __func__, idx, producer_idx, framebuff->anc_frame);
@@ -582,7 +570,7 @@ int st40p_tx_put_frame_abort(st40p_tx_handle handle, struct st40_frame_info* fra
     goto out;
   }
 
-  atomic_store_explicit(&framebuff->stat, ST40P_TX_FRAME_FREE, memory_order_release);
+  tx_st40p_set_free(ctx, framebuff);
   ctx->stat_drop_frame++;
   atomic_fetch_add_explicit(&ctx->stat_frames_dropped, 1, memory_order_relaxed);
   dbg("%s(%d), frame %u aborted\n", __func__, idx, producer_idx);
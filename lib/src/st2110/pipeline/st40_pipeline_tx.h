@@ -7,6 +7,7 @@
 
 #include "../st_main.h"
 #include "st40_pipeline_api.h"
+#include "st_frame_queue.h"
 
 /* Maximum number of late frames that can be dropped in a single next_frame call. */
 #ifndef ST_TX_ST40P_DROP_MAX_BATCH
@@ -43,6 +44,8 @@ struct st40p_tx_ctx {
   uint16_t framebuff_cnt;
   _Atomic uint32_t framebuff_seq_number;
   struct st40p_tx_frame* framebuffs;
+  struct rte_ring* free_queue;  /* FREE framebuffs for get_frame */
+  struct rte_ring* ready_queue; /* READY framebuffs for the transport, put order */
   bool ready;
 
   int frames_per_sec;
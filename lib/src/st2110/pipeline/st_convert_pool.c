@@ -0,0 +1,285 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include "st_convert_pool.h"
+
+#include "../../mt_log.h"
+#include "../../mt_stat.h"
+
+static inline struct st_convert_pool_mgr* cvt_pool_get_mgr(struct mtl_main_impl* impl) {
+  return &impl->convert_pool_mgr;
+}
+
+static void cvt_band_done(struct st_convert_band* band, int ret) {
+  struct st_convert_band_batch* batch = band->batch;
+
+  mt_pthread_mutex_lock(&batch->lock);
+  if (ret < 0) batch->ret = ret;
+  batch->pending--;
+  if (!batch->pending) mt_pthread_cond_signal(&batch->cond);
+  /* the batch is on the stack of the caller, not touch it after unlock */
+  mt_pthread_mutex_unlock(&batch->lock);
+}
+
+static void* cvt_pool_worker(void* arg) {
+  struct st_convert_pool* pool = arg;
+  struct st_convert_band* band;
+  int ret;
+
+  dbg("%s(%d), start\n", __func__, pool->socket_id);
+  while (1) {
+    mt_pthread_mutex_lock(&pool->lock);
+    while (!pool->stop && (pool->queue_head == pool->queue_tail))
+      mt_pthread_cond_wait(&pool->cond, &pool->lock);
+    if (pool->queue_head == pool->queue_tail) { /* stop and no pending band */
+      mt_pthread_mutex_unlock(&pool->lock);
+      break;
+    }
+    band = pool->queue[pool->queue_tail % ST_CONVERT_POOL_QUEUE_SIZE];
+    pool->queue_tail++;
+    mt_pthread_mutex_unlock(&pool->lock);
+
+    ret = st_frame_converter_convert(band->converter, &band->src, &band->dst);
+    cvt_band_done(band, ret);
+  }
+  dbg("%s(%d), stop\n", __func__, pool->socket_id);
+
+  return NULL;
+}
+
+static void cvt_pool_set_affinity(struct st_convert_pool* pool, pthread_t tid) {
+#ifndef WINDOWSENV
+  if (numa_available() < 0) return;
+
+  struct bitmask* cpus = numa_allocate_cpumask();
+  if (!cpus) return;
+  if (numa_node_to_cpus(pool->socket_id, cpus) < 0) {
+    numa_free_cpumask(cpus);
+    return;
+  }
+
+  /* the cpus of the busy polling lcores of the schedulers, lcore id is not cpu id */
+  cpu_set_t lcore_cpus;
+  unsigned int lcore;
+  CPU_ZERO(&lcore_cpus);
+  RTE_LCORE_FOREACH(lcore) {
+    int lcore_cpu = rte_lcore_to_cpu_id(lcore);
+    if (lcore_cpu >= 0 && lcore_cpu < CPU_SETSIZE) CPU_SET(lcore_cpu, &lcore_cpus);
+  }
+
+  cpu_set_t mask, mask_no_lcore;
+  CPU_ZERO(&mask);
+  CPU_ZERO(&mask_no_lcore);
+  for (unsigned int cpu = 0; cpu < cpus->size && cpu < CPU_SETSIZE; cpu++) {
+    if (!numa_bitmask_isbitset(cpus, cpu)) continue;
+    CPU_SET(cpu, &mask);
+    if (!CPU_ISSET(cpu, &lcore_cpus)) CPU_SET(cpu, &mask_no_lcore);
+  }
+  numa_free_cpumask(cpus);
+
+  if (CPU_COUNT(&mask_no_lcore))
+    pthread_setaffinity_np(tid, sizeof(mask_no_lcore), &mask_no_lcore);
+  else if (CPU_COUNT(&mask))
+    pthread_setaffinity_np(tid, sizeof(mask), &mask);
+#else
+  MTL_MAY_UNUSED(pool);
+  MTL_MAY_UNUSED(tid);
+#endif
+}
+
+static int cvt_pool_dump(void* priv) {
+  struct st_convert_pool* pool = priv;
+
+  mt_pthread_mutex_lock(&pool->lock);
+  uint32_t frames = pool->stat_frames;
+  uint32_t bands = pool->stat_bands;
+  uint32_t bands_inline = pool->stat_bands_inline;
+  pool->stat_frames = 0;
+  pool->stat_bands = 0;
+  pool->stat_bands_inline = 0;
+  mt_pthread_mutex_unlock(&pool->lock);
+
+  if (frames) {
+    notice("CVT_POOL(%d), workers %d, frames %u bands %u\n", pool->socket_id,
+           pool->workers_nb, frames, bands);
+  }
+  if (bands_inline) {
+    notice("CVT_POOL(%d), queue full, bands run by caller %u\n", pool->socket_id,
+           bands_inline);
+  }
+  return 0;
+}
+
+static int cvt_pool_free(struct st_convert_pool* pool) {
+  struct mtl_main_impl* impl = pool->parent;
+
+  mt_pthread_mutex_lock(&pool->lock);
+  pool->stop = true;
+  for (int i = 0; i < pool->workers_nb; i++) mt_pthread_cond_signal(&pool->cond);
+  mt_pthread_mutex_unlock(&pool->lock);
+  for (int i = 0; i < pool->workers_nb; i++) {
+    pthread_join(pool->workers[i], NULL);
+  }
+  mt_stat_unregister(impl, cvt_pool_dump, pool);
+  mt_pthread_mutex_destroy(&pool->lock);
+  mt_pthread_cond_destroy(&pool->cond);
+  mt_rte_free(pool);
+  return 0;
+}
+
+static struct st_convert_pool* cvt_pool_create(struct mtl_main_impl* impl, int socket_id,
+                                               int workers_nb) {
+  struct st_convert_pool* pool;
+  int ret;
+
+  pool = mt_rte_zmalloc_socket(sizeof(*pool), socket_id);
+  if (!pool) {
+    err("%s(%d), pool malloc fail\n", __func__, socket_id);
+    return NULL;
+  }
+  pool->parent = impl;
+  pool->socket_id = socket_id;
+  mt_pthread_mutex_init(&pool->lock, NULL);
+  mt_pthread_cond_init(&pool->cond, NULL);
+
+  for (int i = 0; i < workers_nb; i++) {
+    ret = pthread_create(&pool->workers[i], NULL, cvt_pool_worker, pool);
+    if (ret) {
+      err("%s(%d), worker %d create fail %d\n", __func__, socket_id, i, ret);
+      break;
+    }
+    char name[32];
+    snprintf(name, sizeof(name), "mtl_cvt_s%d_%d", socket_id, i);
+    mtl_thread_setname(pool->workers[i], name);
+    cvt_pool_set_affinity(pool, pool->workers[i]);
+    pool->workers_nb++;
+  }
+  if (!pool->workers_nb) {
+    mt_pthread_mutex_destroy(&pool->lock);
+    mt_pthread_cond_destroy(&pool->cond);
+    mt_rte_free(pool);
+    return NULL;
+  }
+  mt_stat_register(impl, cvt_pool_dump, pool, "convert_pool");
+
+  info("%s(%d), %d workers\n", __func__, socket_id, pool->workers_nb);
+  return pool;
+}
+
+struct st_convert_pool* st_convert_pool_get(struct mtl_main_impl* impl, int socket_id) {
+  struct st_convert_pool_mgr* mgr = cvt_pool_get_mgr(impl);
+  struct st_convert_pool* pool;
+
+  if (socket_id < 0 || socket_id >= ST_CONVERT_POOL_MAX_NUMA) {
+    err("%s, invalid socket %d\n", __func__, socket_id);
+    return NULL;
+  }
+
+  mt_pthread_mutex_lock(&mgr->lock);
+  pool = mgr->pools[socket_id];
+  if (!pool) {
+    pool = cvt_pool_create(impl, socket_id, mgr->workers_per_numa);
+    mgr->pools[socket_id] = pool;
+  }
+  mt_pthread_mutex_unlock(&mgr->lock);
+
+  return pool;
+}
+
+int st_convert_pool_run(struct st_convert_pool* pool,
+                        const struct st_frame_converter* converter, struct st_frame* src,
+                        struct st_frame* dst, uint16_t parallel) {
+  uint32_t h = st_frame_data_height(dst);
+  uint32_t align = 1;
+  int ret;
+
+  if ((st_frame_fmt_get_sampling(src->fmt) == ST_FRAME_SAMPLING_420) ||
+      (st_frame_fmt_get_sampling(dst->fmt) == ST_FRAME_SAMPLING_420))
+    align = 2;
+
+  uint32_t bands_nb = RTE_MIN(parallel, pool->workers_nb + 1);
+  bands_nb = RTE_MIN(bands_nb, ST_CONVERT_POOL_MAX_BANDS);
+  if (bands_nb <= 1 || h < align * 2)
+    return st_frame_converter_convert(converter, src, dst);
+  uint32_t band_lines = RTE_ALIGN_CEIL((h + bands_nb - 1) / bands_nb, align);
+  bands_nb = (h + band_lines - 1) / band_lines;
+  if (bands_nb <= 1) return st_frame_converter_convert(converter, src, dst);
+
+  struct st_convert_band bands[ST_CONVERT_POOL_MAX_BANDS];
+  struct st_convert_band_batch batch;
+  uint32_t queued = 0;
+
+  mt_pthread_mutex_init(&batch.lock, NULL);
+  mt_pthread_cond_init(&batch.cond, NULL);
+  batch.ret = 0;
+  batch.pending = bands_nb - 1; /* band 0 run by the caller */
+  for (uint32_t i = 0; i < bands_nb; i++) {
+    uint32_t line = i * band_lines;
+    uint32_t lines = RTE_MIN(band_lines, h - line);
+    bands[i].converter = converter;
+    bands[i].batch = &batch;
+    st_frame_init_band(src, &bands[i].src, line, lines);
+    st_frame_init_band(dst, &bands[i].dst, line, lines);
+  }
+
+  mt_pthread_mutex_lock(&pool->lock);
+  for (uint32_t i = 1; i < bands_nb; i++) {
+    if ((pool->queue_head - pool->queue_tail) >= ST_CONVERT_POOL_QUEUE_SIZE) break;
+    pool->queue[pool->queue_head % ST_CONVERT_POOL_QUEUE_SIZE] = &bands[i];
+    pool->queue_head++;
+    queued++;
+  }
+  pool->stat_frames++;
+  pool->stat_bands += bands_nb;
+  pool->stat_bands_inline += bands_nb - 1 - queued;
+  for (uint32_t i = 0; i < queued; i++) mt_pthread_cond_signal(&pool->cond);
+  mt_pthread_mutex_unlock(&pool->lock);
+
+  ret = st_frame_converter_convert(converter, &bands[0].src, &bands[0].dst);
+  /* queue full, run the left bands on the caller */
+  for (uint32_t i = queued + 1; i < bands_nb; i++) {
+    cvt_band_done(&bands[i],
+                  st_frame_converter_convert(converter, &bands[i].src, &bands[i].dst));
+  }
+
+  mt_pthread_mutex_lock(&batch.lock);
+  while (batch.pending) mt_pthread_cond_wait(&batch.cond, &batch.lock);
+  mt_pthread_mutex_unlock(&batch.lock);
+  mt_pthread_mutex_destroy(&batch.lock);
+  mt_pthread_cond_destroy(&batch.cond);
+
+  if (ret < 0) return ret;
+  return batch.ret;
+}
+
+int st_convert_pools_init(struct mtl_main_impl* impl) {
+  struct st_convert_pool_mgr* mgr = cvt_pool_get_mgr(impl);
+  struct mtl_init_params* p = mt_get_user_params(impl);
+
+  mt_pthread_mutex_init(&mgr->lock, NULL);
+  mgr->workers_per_numa = p->convert_threads_per_numa;
+  if (!mgr->workers_per_numa) mgr->workers_per_numa = ST_CONVERT_POOL_DEFAULT_WORKERS;
+  if (mgr->workers_per_numa > ST_CONVERT_POOL_MAX_WORKERS) {
+    warn("%s, workers %u capped to %d\n", __func__, mgr->workers_per_numa,
+         ST_CONVERT_POOL_MAX_WORKERS);
+    mgr->workers_per_numa = ST_CONVERT_POOL_MAX_WORKERS;
+  }
+
+  info("%s, workers per numa %u\n", __func__, mgr->workers_per_numa);
+  return 0;
+}
+
+int st_convert_pools_uinit(struct mtl_main_impl* impl) {
+  struct st_convert_pool_mgr* mgr = cvt_pool_get_mgr(impl);
+
+  for (int i = 0; i < ST_CONVERT_POOL_MAX_NUMA; i++) {
+    if (mgr->pools[i]) {
+      cvt_pool_free(mgr->pools[i]);
+      mgr->pools[i] = NULL;
+    }
+  }
+  mt_pthread_mutex_destroy(&mgr->lock);
+
+  return 0;
+}
@@ -0,0 +1,24 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#ifndef _ST_LIB_PIPELINE_CONVERT_POOL_HEAD_H_
+#define _ST_LIB_PIPELINE_CONVERT_POOL_HEAD_H_
+
+#include "../st_main.h"
+
+int st_convert_pools_init(struct mtl_main_impl* impl);
+int st_convert_pools_uinit(struct mtl_main_impl* impl);
+
+/* get the pool of the numa, workers are created when first used */
+struct st_convert_pool* st_convert_pool_get(struct mtl_main_impl* impl, int socket_id);
+
+/*
+ * Split the frame into line bands and convert them in parallel, at most parallel bands
+ * and the calling thread converts one band also. Return after all bands finished.
+ */
+int st_convert_pool_run(struct st_convert_pool* pool,
+                        const struct st_frame_converter* converter, struct st_frame* src,
+                        struct st_frame* dst, uint16_t parallel);
+
+#endif
@@ -0,0 +1,345 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include "st_convert_select.h"
+
+#ifndef WINDOWSENV
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif
+
+#include "../../mt_log.h"
+
+#define CVT_SELECT_WARMUP (1)
+#define CVT_SELECT_LOOPS (3)
+
+static inline struct st_convert_select_mgr* cvt_select_get_mgr(
+    struct mtl_main_impl* impl) {
+  return &impl->convert_select_mgr;
+}
+
+static void cvt_select_read_cpu_model(char* model, size_t sz) {
+  FILE* fp = fopen("/proc/cpuinfo", "r");
+  char line[256];
+
+  snprintf(model, sz, "unknown");
+  if (!fp) return;
+  while (fgets(line, sizeof(line), fp)) {
+    if (strncmp(line, "model name", strlen("model name"))) continue;
+    char* value = strchr(line, ':');
+    if (!value) break;
+    value++;
+    while (*value == ' ' || *value == '\t') value++;
+    value[strcspn(value, "\r\n")] = 0;
+    /* ';' is the separator of the cache file */
+    for (char* c = value; *c; c++) {
+      if (*c == ';') *c = ' ';
+    }
+    snprintf(model, sz, "%s", value);
+    break;
+  }
+  fclose(fp);
+}
+
+static enum mtl_simd_level cvt_select_name_to_level(const char* name) {
+  for (int level = 0; level < MTL_SIMD_LEVEL_MAX; level++) {
+    if (!strcmp(name, mtl_get_simd_level_name(level))) return level;
+  }
+  return MTL_SIMD_LEVEL_MAX;
+}
+
+static struct st_convert_select_entry* cvt_select_find(
+    struct st_convert_select_mgr* mgr, const struct st_convert_select_entry* key) {
+  for (int i = 0; i < mgr->entries_nb; i++) {
+    struct st_convert_select_entry* entry = &mgr->entries[i];
+    if (entry->src_fmt == key->src_fmt && entry->dst_fmt == key->dst_fmt &&
+        entry->width == key->width && entry->height == key->height &&
+        entry->interlaced == key->interlaced)
+      return entry;
+  }
+  return NULL;
+}
+
+static struct st_convert_select_entry* cvt_select_add(
+    struct st_convert_select_mgr* mgr, const struct st_convert_select_entry* entry) {
+  struct st_convert_select_entry* slot = cvt_select_find(mgr, entry);
+
+  if (!slot) {
+    if (mgr->entries_nb >= ST_CONVERT_SELECT_MAX_ENTRIES) return NULL;
+    slot = &mgr->entries[mgr->entries_nb++];
+  }
+  *slot = *entry;
+  return slot;
+}
+
+static void cvt_select_del(struct st_convert_select_mgr* mgr,
+                           struct st_convert_select_entry* entry) {
+  *entry = mgr->entries[--mgr->entries_nb];
+}
+
+/*
+ * The entries pick the simd kernels of the converter, refuse a symlink or a file which
+ * is not owned by this user or can be written by others.
+ */
+static FILE* cvt_select_open_cache(struct st_convert_select_mgr* mgr, bool append) {
+#ifndef WINDOWSENV
+  int flags = O_CLOEXEC | O_NOFOLLOW;
+  struct stat st;
+  FILE* fp;
+  int fd;
+
+  if (append)
+    flags |= O_WRONLY | O_APPEND | O_CREAT;
+  else
+    flags |= O_RDONLY;
+  fd = open(mgr->cache_path, flags, 0600);
+  if (fd < 0) return NULL;
+  if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode) || st.st_uid != geteuid() ||
+      (st.st_mode & (S_IWGRP | S_IWOTH))) {
+    warn("%s, refuse %s, not a file of this user only\n", __func__, mgr->cache_path);
+    close(fd);
+    return NULL;
+  }
+  fp = fdopen(fd, append ? "a" : "r");
+  if (!fp) close(fd);
+  return fp;
+#else
+  return fopen(mgr->cache_path, append ? "a" : "r");
+#endif
+}
+
+/* load the entries of this cpu model, the entries of other models are skipped */
+static void cvt_select_load_cache(struct st_convert_select_mgr* mgr) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  char line[512];
+  char model[128], src_name[32], dst_name[32], level_name[32];
+  struct st_convert_select_entry entry;
+  int interlaced;
+  int loaded = 0;
+  FILE* fp;
+
+  mgr->cache_loaded = true;
+  if (!mgr->cache_path[0]) return; /* no cache file */
+  fp = cvt_select_open_cache(mgr, false);
+  if (!fp) {
+    info("%s, no cache at %s\n", __func__, mgr->cache_path);
+    return;
+  }
+  while (fgets(line, sizeof(line), fp)) {
+    memset(&entry, 0, sizeof(entry));
+    if (sscanf(line, "%127[^;];%31[^;];%31[^;];%u;%u;%d;%31[^;];%" SCNu64 ";%" SCNu64,
+               model, src_name, dst_name, &entry.width, &entry.height, &interlaced,
+               level_name, &entry.ns, &entry.max_ns) != 9)
+      continue;
+    if (strcmp(model, mgr->cpu_model)) continue;
+    entry.src_fmt = st_frame_name_to_fmt(src_name);
+    entry.dst_fmt = st_frame_name_to_fmt(dst_name);
+    entry.level = cvt_select_name_to_level(level_name);
+    /* a level above the cpu would run instructions the cpu doesn't have */
+    if (entry.src_fmt == ST_FRAME_FMT_MAX || entry.dst_fmt == ST_FRAME_FMT_MAX ||
+        entry.level > cpu_level || !entry.width || !entry.height ||
+        entry.width > ST_CONVERT_SELECT_MAX_DIM ||
+        entry.height > ST_CONVERT_SELECT_MAX_DIM ||
+        (interlaced != 0 && interlaced != 1) || !entry.ns || !entry.max_ns) {
+      warn("%s, invalid line %s", __func__, line);
+      continue;
+    }
+    entry.interlaced = interlaced ? true : false;
+    if (cvt_select_add(mgr, &entry)) loaded++;
+  }
+  fclose(fp);
+  info("%s, %d entries for %s from %s\n", __func__, loaded, mgr->cpu_model,
+       mgr->cache_path);
+}
+
+static void cvt_select_save_entry(struct st_convert_select_mgr* mgr,
+                                  const struct st_convert_select_entry* entry) {
+  FILE* fp;
+
+  if (!mgr->cache_path[0]) return; /* no cache file */
+  fp = cvt_select_open_cache(mgr, true);
+  if (!fp) {
+    warn("%s, open %s fail\n", __func__, mgr->cache_path);
+    return;
+  }
+  fprintf(fp, "%s;%s;%s;%u;%u;%d;%s;%" PRIu64 ";%" PRIu64 "\n", mgr->cpu_model,
+          st_frame_fmt_name(entry->src_fmt), st_frame_fmt_name(entry->dst_fmt),
+          entry->width, entry->height, entry->interlaced ? 1 : 0,
+          mtl_get_simd_level_name(entry->level), entry->ns, entry->max_ns);
+  fclose(fp);
+}
+
+static struct st_frame* cvt_select_frame_create(enum st_frame_fmt fmt, uint32_t width,
+                                                uint32_t height, bool interlaced,
+                                                int socket_id) {
+  size_t sz = st_frame_size(fmt, width, height, interlaced);
+  struct st_frame* frame;
+  void* data;
+
+  if (!sz) return NULL;
+  frame = mt_rte_zmalloc_socket(sizeof(*frame), socket_id);
+  if (!frame) return NULL;
+  data = mt_rte_zmalloc_socket(sz, socket_id);
+  if (!data) {
+    mt_rte_free(frame);
+    return NULL;
+  }
+  /* small values, valid for both the 10/12 bit planar and the packed formats */
+  memset(data, 0x01, sz);
+  frame->fmt = fmt;
+  frame->width = width;
+  frame->height = height;
+  frame->interlaced = interlaced;
+  frame->buffer_size = sz;
+  frame->data_size = sz;
+  st_frame_init_plane_single_src(frame, data, 0);
+  return frame;
+}
+
+static void cvt_select_frame_free(struct st_frame* frame) {
+  if (!frame) return;
+  mt_rte_free(frame->addr[0]);
+  mt_rte_free(frame);
+}
+
+/* the best ns of one frame, or zero if the converter fail */
+static uint64_t cvt_select_time(const struct st_frame_converter* converter,
+                                enum mtl_simd_level level, struct st_frame* src,
+                                struct st_frame* dst) {
+  uint64_t best = 0;
+
+  for (int i = 0; i < CVT_SELECT_WARMUP + CVT_SELECT_LOOPS; i++) {
+    uint64_t start = mt_get_monotonic_time();
+    if (converter->convert_simd_func(src, dst, level) < 0) return 0;
+    uint64_t ns = mt_get_monotonic_time() - start;
+    if (i < CVT_SELECT_WARMUP) continue;
+    if (!best || ns < best) best = ns;
+  }
+  return best ? best : 1;
+}
+
+static int cvt_select_bench(struct st_convert_select_entry* entry,
+                            const struct st_frame_converter* converter, int socket_id) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  struct st_frame* src;
+  struct st_frame* dst;
+  int ret = 0;
+
+  src = cvt_select_frame_create(entry->src_fmt, entry->width, entry->height,
+                                entry->interlaced, socket_id);
+  dst = cvt_select_frame_create(entry->dst_fmt, entry->width, entry->height,
+                                entry->interlaced, socket_id);
+  if (!src || !dst) {
+    err("%s, frame create fail\n", __func__);
+    ret = -ENOMEM;
+    goto out;
+  }
+
+  entry->max_ns = cvt_select_time(converter, MTL_SIMD_LEVEL_MAX, src, dst);
+  entry->level = cpu_level;
+  entry->ns = entry->max_ns;
+  if (!entry->max_ns) {
+    err("%s, convert fail\n", __func__);
+    ret = -EIO;
+    goto out;
+  }
+  /* from the highest level, a lower level has to be faster to win */
+  for (int level = cpu_level; level >= MTL_SIMD_LEVEL_NONE; level--) {
+    uint64_t ns = cvt_select_time(converter, level, src, dst);
+    dbg("%s, level %s ns %" PRIu64 "\n", __func__, mtl_get_simd_level_name(level), ns);
+    if (ns && ns < entry->ns) {
+      entry->level = level;
+      entry->ns = ns;
+    }
+  }
+
+out:
+  cvt_select_frame_free(src);
+  cvt_select_frame_free(dst);
+  return ret;
+}
+
+int st_convert_select(struct mtl_main_impl* impl, struct st_frame_converter* converter,
+                      uint32_t width, uint32_t height, bool interlaced, int socket_id,
+                      struct st_convert_select_entry* result, bool* cached) {
+  struct st_convert_select_mgr* mgr = cvt_select_get_mgr(impl);
+  struct st_convert_select_entry key;
+  struct st_convert_select_entry* entry;
+  int ret = 0;
+
+  if (!converter->convert_simd_func) {
+    err("%s, not a built-in converter\n", __func__);
+    return -EINVAL;
+  }
+
+  memset(&key, 0, sizeof(key));
+  key.src_fmt = converter->src_fmt;
+  key.dst_fmt = converter->dst_fmt;
+  key.width = width;
+  key.height = height;
+  key.interlaced = interlaced;
+
+  mt_pthread_mutex_lock(&mgr->lock);
+  if (!mgr->cache_loaded) cvt_select_load_cache(mgr);
+  entry = cvt_select_find(mgr, &key);
+  /* another session is benching the same key, wait for the result */
+  while (entry && entry->benching) {
+    mt_pthread_cond_wait(&mgr->cond, &mgr->lock);
+    entry = cvt_select_find(mgr, &key);
+  }
+  *cached = entry ? true : false;
+  if (entry) {
+    *result = *entry;
+    mt_pthread_mutex_unlock(&mgr->lock);
+  } else {
+    /* mark the key then bench without the lock, the other keys are not blocked */
+    key.benching = true;
+    bool marked = cvt_select_add(mgr, &key) ? true : false;
+    mt_pthread_mutex_unlock(&mgr->lock);
+
+    ret = cvt_select_bench(&key, converter, socket_id);
+    key.benching = false;
+
+    mt_pthread_mutex_lock(&mgr->lock);
+    if (marked) {
+      entry = cvt_select_find(mgr, &key);
+      if (ret >= 0)
+        *entry = key;
+      else
+        cvt_select_del(mgr, entry); /* the waiters bench it again */
+      mt_pthread_cond_broadcast(&mgr->cond);
+    }
+    /* the file still has it if the memory table is full */
+    if (ret >= 0) cvt_select_save_entry(mgr, &key);
+    mt_pthread_mutex_unlock(&mgr->lock);
+    if (ret >= 0) *result = key;
+  }
+  if (ret < 0) return ret;
+
+  converter->simd_level = result->level;
+  return 0;
+}
+
+int st_convert_select_init(struct mtl_main_impl* impl) {
+  struct st_convert_select_mgr* mgr = cvt_select_get_mgr(impl);
+  struct mtl_init_params* p = mt_get_user_params(impl);
+
+  mt_pthread_mutex_init(&mgr->lock, NULL);
+  mt_pthread_cond_init(&mgr->cond, NULL);
+  cvt_select_read_cpu_model(mgr->cpu_model, sizeof(mgr->cpu_model));
+  if (p->convert_select_cache)
+    snprintf(mgr->cache_path, sizeof(mgr->cache_path), "%s", p->convert_select_cache);
+
+  info("%s, cpu %s, cache %s\n", __func__, mgr->cpu_model,
+       mgr->cache_path[0] ? mgr->cache_path : "none");
+  return 0;
+}
+
+int st_convert_select_uinit(struct mtl_main_impl* impl) {
+  struct st_convert_select_mgr* mgr = cvt_select_get_mgr(impl);
+
+  mt_pthread_mutex_destroy(&mgr->lock);
+  mt_pthread_cond_destroy(&mgr->cond);
+  return 0;
+}
@@ -0,0 +1,25 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#ifndef _ST_LIB_PIPELINE_CONVERT_SELECT_HEAD_H_
+#define _ST_LIB_PIPELINE_CONVERT_SELECT_HEAD_H_
+
+#include "../st_main.h"
+
+int st_convert_select_init(struct mtl_main_impl* impl);
+int st_convert_select_uinit(struct mtl_main_impl* impl);
+
+/*
+ * Set the cheapest simd level to the built-in converter for the resolution. The level
+ * is from the cache if this cpu model already benchmarked it, otherwise every level
+ * the cpu supports is timed on a synthetic frame without the lock of the manager and
+ * the result is appended to the cache file if any. A session of the same key waits
+ * for the running benchmark. result is the entry used, cached tell if it's not
+ * benchmarked by this call.
+ */
+int st_convert_select(struct mtl_main_impl* impl, struct st_frame_converter* converter,
+                      uint32_t width, uint32_t height, bool interlaced, int socket_id,
+                      struct st_convert_select_entry* result, bool* cached);
+
+#endif
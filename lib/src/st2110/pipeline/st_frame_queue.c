@@ -0,0 +1,38 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include "st_frame_queue.h"
+
+#include "../../mt_log.h"
+
+struct rte_ring* st_frame_queue_create(const char* name, uint16_t cnt, int socket_id) {
+  /* the usable size of a non exact ring is count - 1 */
+  unsigned int count = rte_align32pow2((uint32_t)cnt + 1);
+  ssize_t sz = rte_ring_get_memsize(count);
+  struct rte_ring* queue;
+  int ret;
+
+  if (sz < 0) {
+    err("%s(%s), invalid cnt %u\n", __func__, name, cnt);
+    return NULL;
+  }
+  queue = mt_rte_zmalloc_socket(sz, socket_id);
+  if (!queue) {
+    err("%s(%s), queue malloc fail\n", __func__, name);
+    return NULL;
+  }
+  /* multi-producer and multi-consumer, the user APIs can be called from any thread */
+  ret = rte_ring_init(queue, name, count, 0);
+  if (ret < 0) {
+    err("%s(%s), ring init fail %d\n", __func__, name, ret);
+    mt_rte_free(queue);
+    return NULL;
+  }
+
+  return queue;
+}
+
+void st_frame_queue_free(struct rte_ring* queue) {
+  mt_rte_free(queue);
+}
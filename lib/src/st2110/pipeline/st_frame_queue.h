@@ -0,0 +1,35 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#ifndef _ST_LIB_PIPELINE_FRAME_QUEUE_HEAD_H_
+#define _ST_LIB_PIPELINE_FRAME_QUEUE_HEAD_H_
+
+#include "../st_main.h"
+
+/*
+ * Lock-free fifo of framebuffer pointers, one queue for each status which has a
+ * consumer, backed by a multi-producer/multi-consumer rte_ring. A framebuffer is put
+ * to the queue when it enters the status and got from the queue by the thread which
+ * claims it, so the claim is O(1) and keeps the order of the status change.
+ * The queue memory is from the socket of the session, not a named memzone, so no name
+ * conflict between sessions.
+ */
+struct rte_ring* st_frame_queue_create(const char* name, uint16_t cnt, int socket_id);
+void st_frame_queue_free(struct rte_ring* queue);
+
+static inline int st_frame_queue_put(struct rte_ring* queue, void* framebuff) {
+  return rte_ring_mp_enqueue(queue, framebuff);
+}
+
+static inline void* st_frame_queue_get(struct rte_ring* queue) {
+  void* framebuff = NULL;
+  if (rte_ring_mc_dequeue(queue, &framebuff) < 0) return NULL;
+  return framebuff;
+}
+
+static inline unsigned int st_frame_queue_count(struct rte_ring* queue) {
+  return rte_ring_count(queue);
+}
+
+#endif
@@ -5,9 +5,17 @@
 #include <errno.h>
 #include <string.h>
 
+#include "st_ancillary.h"
+
 #include "../mt_log.h"
 #include "../mt_platform.h"
 #include "st40_api.h"
+#ifdef MTL_HAS_AVX2
+#include "st_avx2.h"
+#endif
+#ifdef MTL_HAS_AVX512
+#include "st_avx512.h"
+#endif
 
 typedef union anc_udw_10_6e {
   struct {
@@ -178,16 +186,168 @@ void st40_set_udw(uint32_t idx, uint16_t udw, uint8_t* data) {
   set_10bit_udw(idx, udw, data);
 }
 
+uint16_t st40_checksum_from_sum(uint16_t sum) {
+  uint16_t chks = sum & 0x1ff;
+  chks = (~((chks << 1)) & 0x200) | chks;
+
+  return chks;
+}
+
 uint16_t st40_calc_checksum(uint32_t data_num, const uint8_t* data) {
   uint16_t chks = 0, udw;
   for (uint32_t i = 0; i < data_num; i++) {
     udw = get_10bit_udw(i, data);
     chks += udw;
   }
-  chks &= 0x1ff;
-  chks = (~((chks << 1)) & 0x200) | chks;
 
-  return chks;
+  return st40_checksum_from_sum(chks);
+}
+
+static uint16_t anc_udw_pack_scalar(uint32_t idx, const uint8_t* udw, uint32_t n,
+                                    uint8_t* data) {
+  uint16_t sum = 0, word;
+
+  for (uint32_t i = 0; i < n; i++) {
+    word = st40_add_parity_bits(udw[i]);
+    set_10bit_udw(idx + i, word, data);
+    sum += word;
+  }
+  return sum;
+}
+
+static uint32_t anc_udw_unpack_scalar(uint32_t idx, const uint8_t* data, uint32_t n,
+                                      uint8_t* udw, uint16_t* sum) {
+  uint32_t bad = 0;
+  uint16_t word;
+
+  for (uint32_t i = 0; i < n; i++) {
+    word = get_10bit_udw(idx + i, data);
+    if (!st40_check_parity_bits(word)) bad++;
+    if (udw) udw[i] = (uint8_t)(word & 0xFF);
+    *sum += word;
+  }
+  return bad;
+}
+
+/* the words from idx to the first index of a multiple of 4, the kernels start there */
+static inline uint32_t anc_udw_head(uint32_t idx, uint32_t n) {
+  uint32_t head = (4 - idx % 4) % 4;
+  return (head < n) ? head : n;
+}
+
+uint16_t st_anc_udw_pack_simd(uint32_t idx, const uint8_t* udw, uint32_t n,
+                              uint8_t* data, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  uint32_t done = anc_udw_head(idx, n);
+  uint32_t bulk = (n - done) & ~0x7U;
+  uint16_t sum = anc_udw_pack_scalar(idx, udw, done, data);
+  uint8_t* dst = data + (idx + done) / 4 * 5;
+  uint16_t bulk_sum;
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(level);
+  MTL_MAY_UNUSED(dst);
+  MTL_MAY_UNUSED(bulk_sum);
+  MTL_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512
+  if (bulk && (level >= MTL_SIMD_LEVEL_AVX512) &&
+      (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st_anc_udw_pack_avx512(udw + done, bulk, dst, &bulk_sum);
+    if (ret == 0) {
+      sum += bulk_sum;
+      done += bulk;
+      bulk = 0;
+    } else {
+      err("%s, avx512 ways failed %d\n", __func__, ret);
+    }
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if (bulk && (level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st_anc_udw_pack_avx2(udw + done, bulk, dst, &bulk_sum);
+    if (ret == 0) {
+      sum += bulk_sum;
+      done += bulk;
+    } else {
+      err("%s, avx2 ways failed %d\n", __func__, ret);
+    }
+  }
+#endif
+
+  /* the tail, or all the rest as the last option */
+  sum += anc_udw_pack_scalar(idx + done, udw + done, n - done, data);
+  return sum;
+}
+
+uint32_t st_anc_udw_unpack_simd(uint32_t idx, const uint8_t* data, uint32_t n,
+                                uint8_t* udw, uint16_t* sum, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  uint32_t done = anc_udw_head(idx, n);
+  uint32_t bulk = (n - done) & ~0x7U;
+  uint16_t words_sum = 0, bulk_sum;
+  uint32_t bad = anc_udw_unpack_scalar(idx, data, done, udw, &words_sum);
+  const uint8_t* src = data + (idx + done) / 4 * 5;
+  uint32_t bulk_bad;
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(level);
+  MTL_MAY_UNUSED(src);
+  MTL_MAY_UNUSED(bulk_sum);
+  MTL_MAY_UNUSED(bulk_bad);
+  MTL_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512
+  if (bulk && (level >= MTL_SIMD_LEVEL_AVX512) &&
+      (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st_anc_udw_unpack_avx512(src, bulk, udw ? udw + done : NULL, &bulk_sum,
+                                   &bulk_bad);
+    if (ret == 0) {
+      words_sum += bulk_sum;
+      bad += bulk_bad;
+      done += bulk;
+      bulk = 0;
+    } else {
+      err("%s, avx512 ways failed %d\n", __func__, ret);
+    }
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if (bulk && (level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st_anc_udw_unpack_avx2(src, bulk, udw ? udw + done : NULL, &bulk_sum,
+                                 &bulk_bad);
+    if (ret == 0) {
+      words_sum += bulk_sum;
+      bad += bulk_bad;
+      done += bulk;
+    } else {
+      err("%s, avx2 ways failed %d\n", __func__, ret);
+    }
+  }
+#endif
+
+  /* the tail, or all the rest as the last option */
+  bad += anc_udw_unpack_scalar(idx + done, data, n - done, udw ? udw + done : NULL,
+                               &words_sum);
+  if (sum) *sum = words_sum;
+  return bad;
+}
+
+uint16_t st40_set_udws(uint32_t idx, const uint8_t* udw, uint32_t n, uint8_t* data) {
+  return st_anc_udw_pack_simd(idx, udw, n, data, MTL_SIMD_LEVEL_MAX);
+}
+
+uint32_t st40_get_udws(uint32_t idx, const uint8_t* data, uint32_t n, uint8_t* udw,
+                       uint16_t* sum) {
+  return st_anc_udw_unpack_simd(idx, data, n, udw, sum, MTL_SIMD_LEVEL_MAX);
 }
 
 uint32_t st40_rfc8331_payload_bytes(uint16_t udw_size) {
@@ -226,15 +386,15 @@ int st40_rfc8331_encode_packet(uint8_t* buf, uint32_t room, const struct st40_me
   ph->second_hdr_chunk.did = st40_add_parity_bits(meta->did);
   ph->second_hdr_chunk.sdid = st40_add_parity_bits(meta->sdid);
   ph->second_hdr_chunk.data_count = st40_add_parity_bits(udw_size);
+  /* the checksum sums DID, SDID, DC and the udw as they are packed */
+  uint16_t sum = ph->second_hdr_chunk.did + ph->second_hdr_chunk.sdid +
+                 ph->second_hdr_chunk.data_count;
 
   st40_rfc8331_payload_hdr_bswap(ph);
 
   uint8_t* udw_dst = (uint8_t*)&ph->second_hdr_chunk;
-  for (uint16_t i = 0; i < udw_size; i++) {
-    st40_set_udw(i + 3, st40_add_parity_bits(udw_in[i]), udw_dst);
-  }
-  uint16_t checksum = st40_calc_checksum(3 + udw_size, udw_dst);
-  st40_set_udw(udw_size + 3, checksum, udw_dst);
+  sum += st40_set_udws(3, udw_in, udw_size, udw_dst);
+  st40_set_udw(udw_size + 3, st40_checksum_from_sum(sum), udw_dst);
 
   *written = need;
   return 0;
@@ -265,14 +425,14 @@ enum st40_rfc8331_decode_result st40_rfc8331_decode_packet(
   const uint8_t* udw_src =
       (const uint8_t*)&((const struct st40_rfc8331_payload_hdr*)buf)->second_hdr_chunk;
 
-  for (uint16_t i = 0; i < udw_size; i++) {
-    uint16_t udw = st40_get_udw(i + 3, udw_src);
-    if (!st40_check_parity_bits(udw)) return ST40_RFC8331_DECODE_PARITY_FAIL;
-    if (udw_out) udw_out[i] = (uint8_t)(udw & 0xFF);
-  }
+  uint16_t sum;
+  if (st40_get_udws(3, udw_src, udw_size, udw_out, &sum))
+    return ST40_RFC8331_DECODE_PARITY_FAIL;
+  sum += hdr_local.second_hdr_chunk.did + hdr_local.second_hdr_chunk.sdid +
+         hdr_local.second_hdr_chunk.data_count;
 
   uint16_t checksum_wire = st40_get_udw(udw_size + 3, udw_src);
-  uint16_t checksum_calc = st40_calc_checksum(3 + udw_size, udw_src);
+  uint16_t checksum_calc = st40_checksum_from_sum(sum);
   if (checksum_wire != checksum_calc) return ST40_RFC8331_DECODE_CHECKSUM_FAIL;
 
   meta->c = hdr_local.first_hdr_chunk.c;
@@ -0,0 +1,24 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#ifndef _ST_LIB_ANCILLARY_HEAD_H_
+#define _ST_LIB_ANCILLARY_HEAD_H_
+
+#include "st_main.h"
+
+/*
+ * The bulk udw path of the rfc8331 payload. Four 10 bit words are five bytes, the
+ * kernels start at a word index of a multiple of 4 and take the words in blocks of 8,
+ * the head and the tail words go the scalar way of st40_set_udw/st40_get_udw. The
+ * parity bits and the sum for the checksum are done in the same pass of the words.
+ */
+
+/* n udw at idx from the 8 bit values, the sum of the 10 bit words */
+uint16_t st_anc_udw_pack_simd(uint32_t idx, const uint8_t* udw, uint32_t n,
+                              uint8_t* data, enum mtl_simd_level level);
+/* n udw at idx to the 8 bit values(NULL for none), the count of parity errors */
+uint32_t st_anc_udw_unpack_simd(uint32_t idx, const uint8_t* data, uint32_t n,
+                                uint8_t* udw, uint16_t* sum, enum mtl_simd_level level);
+
+#endif
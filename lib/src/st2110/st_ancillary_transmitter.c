@@ -37,9 +37,10 @@ static int st_ancillary_trs_tasklet_stop(void* priv) {
            rte_ring_count(mgr->ring[port]));
     }
 
-    if (trs->inflight[port]) {
-      rte_pktmbuf_free(trs->inflight[port]);
-      trs->inflight[port] = NULL;
+    if (trs->inflight_num[port]) {
+      rte_pktmbuf_free_bulk(&trs->inflight[port][trs->inflight_idx[port]],
+                            trs->inflight_num[port]);
+      trs->inflight_num[port] = 0;
     }
   }
   mgr->stat_pkts_burst = 0;
@@ -52,38 +53,38 @@ static int st_ancillary_trs_session_tasklet(struct st_ancillary_transmitter_impl
                                             struct st_tx_ancillary_sessions_mgr* mgr,
                                             enum mtl_port port) {
   struct rte_ring* ring = mgr->ring[port];
-  int ret;
-  uint16_t n;
-  struct rte_mbuf* pkt;
+  struct rte_mbuf** pkts = trs->inflight[port];
+  uint16_t n, nb_pkts;
 
   if (!ring) return 0;
 
   /* check if any inflight pkts in transmitter */
-  pkt = trs->inflight[port];
-  if (pkt) {
-    n = mt_txq_burst(mgr->queue[port], &pkt, 1);
-    if (n >= 1) {
-      trs->inflight[port] = NULL;
-    } else {
+  nb_pkts = trs->inflight_num[port];
+  if (nb_pkts) {
+    n = mt_txq_burst(mgr->queue[port], &pkts[trs->inflight_idx[port]], nb_pkts);
+    mgr->stat_pkts_burst += n;
+    trs->inflight_idx[port] += n;
+    trs->inflight_num[port] -= n;
+    if (n < nb_pkts) {
       mgr->stat_trs_ret_code[port] = -STI_TSCTRS_BURST_INFLIGHT_FAIL;
       return MTL_TASKLET_HAS_PENDING;
     }
-    mgr->stat_pkts_burst += n;
   }
 
-  /* try to dequeue */
-  for (int i = 0; i < mgr->max_idx; i++) {
+  /* the pkts of all sessions due in this loop go in one burst */
+  for (int i = 0; i < mgr->max_idx; i += nb_pkts) {
     /* try to dequeue */
-    ret = rte_ring_sc_dequeue(ring, (void**)&pkt);
-    if (ret < 0) {
+    nb_pkts = rte_ring_sc_dequeue_burst(ring, (void**)pkts, ST_TX_TRS_BURST_SIZE, NULL);
+    if (!nb_pkts) {
       mgr->stat_trs_ret_code[port] = -STI_TSCTRS_DEQUEUE_FAIL;
       return MTL_TASKLET_ALL_DONE; /* all done */
     }
 
-    n = mt_txq_burst(mgr->queue[port], &pkt, 1);
+    n = mt_txq_burst(mgr->queue[port], pkts, nb_pkts);
     mgr->stat_pkts_burst += n;
-    if (n < 1) {
-      trs->inflight[port] = pkt;
+    if (n < nb_pkts) {
+      trs->inflight_idx[port] = n;
+      trs->inflight_num[port] = nb_pkts - n;
       trs->inflight_cnt[port]++;
       mgr->stat_trs_ret_code[port] = -STI_TSCTRS_BURST_INFLIGHT_FAIL;
       return MTL_TASKLET_HAS_PENDING;
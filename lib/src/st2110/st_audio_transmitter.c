@@ -37,9 +37,10 @@ static int st_audio_trs_tasklet_stop(void* priv) {
            rte_ring_count(mgr->ring[port]));
     }
 
-    if (trs->inflight[port]) {
-      rte_pktmbuf_free(trs->inflight[port]);
-      trs->inflight[port] = NULL;
+    if (trs->inflight_num[port]) {
+      rte_pktmbuf_free_bulk(&trs->inflight[port][trs->inflight_idx[port]],
+                            trs->inflight_num[port]);
+      trs->inflight_num[port] = 0;
     }
   }
   mgr->stat_pkts_burst = 0;
@@ -49,7 +50,7 @@ static int st_audio_trs_tasklet_stop(void* priv) {
 
 static uint16_t st_audio_trs_burst_fail(struct mtl_main_impl* impl,
                                         struct st_tx_audio_sessions_mgr* mgr,
-                                        enum mtl_port port) {
+                                        enum mtl_port port, uint16_t nb_pkts) {
   uint64_t cur_tsc = mt_get_tsc(impl);
   uint64_t fail_duration = cur_tsc - mgr->last_burst_succ_time_tsc[port];
   if (fail_duration > mgr->tx_hang_detect_time_thresh) {
@@ -57,7 +58,7 @@ static uint16_t st_audio_trs_burst_fail(struct mtl_main_impl* impl,
         fail_duration / NS_PER_MS);
     st_audio_queue_fatal_error(impl, mgr, port);
     mgr->last_burst_succ_time_tsc[port] = cur_tsc;
-    return 1; /* skip current pkts */
+    return nb_pkts; /* skip current pkts */
   }
 
   return 0;
@@ -65,10 +66,11 @@ static uint16_t st_audio_trs_burst_fail(struct mtl_main_impl* impl,
 
 static uint16_t st_audio_trs_burst(struct mtl_main_impl* impl,
                                    struct st_tx_audio_sessions_mgr* mgr,
-                                   enum mtl_port port, struct rte_mbuf* pkt) {
+                                   enum mtl_port port, struct rte_mbuf** pkts,
+                                   uint16_t nb_pkts) {
   if (!mgr->queue[port]) return 0;
-  uint16_t tx = mt_txq_burst(mgr->queue[port], &pkt, 1);
-  if (!tx) return st_audio_trs_burst_fail(impl, mgr, port);
+  uint16_t tx = mt_txq_burst(mgr->queue[port], pkts, nb_pkts);
+  if (!tx) return st_audio_trs_burst_fail(impl, mgr, port, nb_pkts);
   mgr->last_burst_succ_time_tsc[port] = mt_get_tsc(impl);
   return tx;
 }
@@ -79,37 +81,38 @@ static int st_audio_trs_session_tasklet(struct mtl_main_impl* impl,
                                         struct st_tx_audio_sessions_mgr* mgr,
                                         enum mtl_port port) {
   struct rte_ring* ring = mgr->ring[port];
-  int ret;
-  uint16_t n;
-  struct rte_mbuf* pkt;
+  struct rte_mbuf** pkts = trs->inflight[port];
+  uint16_t n, nb_pkts;
 
   if (!ring) return 0;
 
   /* check if any inflight pkts in transmitter */
-  pkt = trs->inflight[port];
-  if (pkt) {
-    n = st_audio_trs_burst(impl, mgr, port, pkt);
-    if (n >= 1) {
-      trs->inflight[port] = NULL;
-    } else {
+  nb_pkts = trs->inflight_num[port];
+  if (nb_pkts) {
+    n = st_audio_trs_burst(impl, mgr, port, &pkts[trs->inflight_idx[port]], nb_pkts);
+    mgr->stat_pkts_burst += n;
+    trs->inflight_idx[port] += n;
+    trs->inflight_num[port] -= n;
+    if (n < nb_pkts) {
       mgr->stat_trs_ret_code[port] = -STI_TSCTRS_BURST_INFLIGHT_FAIL;
       return MTL_TASKLET_HAS_PENDING;
     }
-    mgr->stat_pkts_burst += n;
   }
 
-  for (int i = 0; i < mgr->max_idx; i++) {
+  /* the pkts of all sessions due in this loop go in one burst */
+  for (int i = 0; i < mgr->max_idx; i += nb_pkts) {
     /* try to dequeue */
-    ret = rte_ring_sc_dequeue(ring, (void**)&pkt);
-    if (ret < 0) {
+    nb_pkts = rte_ring_sc_dequeue_burst(ring, (void**)pkts, ST_TX_TRS_BURST_SIZE, NULL);
+    if (!nb_pkts) {
       mgr->stat_trs_ret_code[port] = -STI_TSCTRS_DEQUEUE_FAIL;
       return MTL_TASKLET_ALL_DONE; /* all done */
     }
 
-    n = st_audio_trs_burst(impl, mgr, port, pkt);
+    n = st_audio_trs_burst(impl, mgr, port, pkts, nb_pkts);
     mgr->stat_pkts_burst += n;
-    if (n < 1) {
-      trs->inflight[port] = pkt;
+    if (n < nb_pkts) {
+      trs->inflight_idx[port] = n;
+      trs->inflight_num[port] = nb_pkts - n;
       trs->inflight_cnt[port]++;
       mgr->stat_trs_ret_code[port] = -STI_TSCTRS_BURST_INFLIGHT_FAIL;
       return MTL_TASKLET_HAS_PENDING;
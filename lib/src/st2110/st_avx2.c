@@ -6,6 +6,8 @@
 
 #include "../mt_log.h"
 #include "st_main.h"
+#include "st_pcm_convert.h"
+#include "st_scale.h"
 
 #ifdef MTL_HAS_AVX2
 MT_TARGET_CODE_START_AVX2
@@ -215,5 +217,577 @@ int st20_rfc4175_422le10_to_422be10_avx2(struct st20_rfc4175_422_10_pg2_le* pg_l
   return 0;
 }
 /* end st20_rfc4175_422le10_to_422be10_avx2 */
+
+/* begin st_scale_vfilter_avx2 */
+static inline void scale_vfilter_tail(const void** lines, bool u16, const int32_t* coeff,
+                                      uint16_t taps, uint32_t x, uint32_t w,
+                                      uint8_t shift, int32_t* out) {
+  for (; x < w; x++) {
+    int32_t acc = 1 << (shift - 1);
+    for (uint16_t t = 0; t < taps; t++) {
+      int32_t v = u16 ? ((const uint16_t*)lines[t])[x] : ((const uint8_t*)lines[t])[x];
+      acc += coeff[t] * v;
+    }
+    out[x] = acc >> shift;
+  }
+}
+
+int st_scale_vfilter_u16_avx2(const uint16_t** lines, const int32_t* coeff, uint16_t taps,
+                              uint32_t w, uint8_t frac_bits, int32_t* out) {
+  uint8_t shift = ST_SCALE_COEFF_BITS - frac_bits;
+  __m256i round = _mm256_set1_epi32(1 << (shift - 1));
+  __m128i shift_v = _mm_cvtsi32_si128(shift);
+  uint32_t x = 0;
+
+  for (; x + 8 <= w; x += 8) {
+    __m256i acc = round;
+    for (uint16_t t = 0; t < taps; t++) {
+      __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i*)(lines[t] + x)));
+      acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(v, _mm256_set1_epi32(coeff[t])));
+    }
+    _mm256_storeu_si256((__m256i*)(out + x), _mm256_sra_epi32(acc, shift_v));
+  }
+  scale_vfilter_tail((const void**)lines, true, coeff, taps, x, w, shift, out);
+
+  return 0;
+}
+
+int st_scale_vfilter_u8_avx2(const uint8_t** lines, const int32_t* coeff, uint16_t taps,
+                             uint32_t w, uint8_t frac_bits, int32_t* out) {
+  uint8_t shift = ST_SCALE_COEFF_BITS - frac_bits;
+  __m256i round = _mm256_set1_epi32(1 << (shift - 1));
+  __m128i shift_v = _mm_cvtsi32_si128(shift);
+  uint32_t x = 0;
+
+  for (; x + 8 <= w; x += 8) {
+    __m256i acc = round;
+    for (uint16_t t = 0; t < taps; t++) {
+      __m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i*)(lines[t] + x)));
+      acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(v, _mm256_set1_epi32(coeff[t])));
+    }
+    _mm256_storeu_si256((__m256i*)(out + x), _mm256_sra_epi32(acc, shift_v));
+  }
+  scale_vfilter_tail((const void**)lines, false, coeff, taps, x, w, shift, out);
+
+  return 0;
+}
+/* end st_scale_vfilter_avx2 */
+
+/* begin st_scale_hfilter_avx2 */
+static inline __m256i scale_hfilter_8(const int32_t* in, const uint32_t* offset,
+                                      const int32_t* coeff, uint16_t taps,
+                                      uint32_t dst_n, uint32_t i, uint8_t shift,
+                                      __m256i max) {
+  __m256i off = _mm256_loadu_si256((__m256i*)(offset + i));
+  __m256i acc = _mm256_set1_epi32(1 << (shift - 1));
+
+  for (uint16_t t = 0; t < taps; t++) {
+    __m256i idx = _mm256_add_epi32(off, _mm256_set1_epi32(t));
+    __m256i v = _mm256_i32gather_epi32((const int*)in, idx, 4);
+    __m256i c = _mm256_loadu_si256((__m256i*)(coeff + t * dst_n + i));
+    acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(v, c));
+  }
+  acc = _mm256_sra_epi32(acc, _mm_cvtsi32_si128(shift));
+  acc = _mm256_min_epi32(_mm256_max_epi32(acc, _mm256_setzero_si256()), max);
+  return _mm256_and_si256(acc, max);
+}
+
+static inline int32_t scale_hfilter_1(const int32_t* in, const uint32_t* offset,
+                                      const int32_t* coeff, uint16_t taps,
+                                      uint32_t dst_n, uint32_t i, uint8_t shift,
+                                      int32_t max) {
+  const int32_t* src = in + offset[i];
+  int32_t acc = 1 << (shift - 1);
+
+  for (uint16_t t = 0; t < taps; t++) acc += coeff[t * dst_n + i] * src[t];
+  acc >>= shift;
+  if (acc < 0) acc = 0;
+  if (acc > max) acc = max;
+  return acc & max;
+}
+
+int st_scale_hfilter_u16_avx2(const int32_t* in, const uint32_t* offset,
+                              const int32_t* coeff, uint16_t taps, uint32_t dst_n,
+                              uint8_t frac_bits, uint32_t max, uint16_t* out) {
+  uint8_t shift = ST_SCALE_COEFF_BITS + frac_bits;
+  __m256i max_v = _mm256_set1_epi32(max);
+  uint32_t i = 0;
+
+  for (; i + 8 <= dst_n; i += 8) {
+    __m256i v = scale_hfilter_8(in, offset, coeff, taps, dst_n, i, shift, max_v);
+    __m128i s16 =
+        _mm_packus_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    _mm_storeu_si128((__m128i*)(out + i), s16);
+  }
+  for (; i < dst_n; i++)
+    out[i] = scale_hfilter_1(in, offset, coeff, taps, dst_n, i, shift, max);
+
+  return 0;
+}
+
+int st_scale_hfilter_u8_avx2(const int32_t* in, const uint32_t* offset,
+                             const int32_t* coeff, uint16_t taps, uint32_t dst_n,
+                             uint8_t frac_bits, uint32_t max, uint8_t* out) {
+  uint8_t shift = ST_SCALE_COEFF_BITS + frac_bits;
+  __m256i max_v = _mm256_set1_epi32(max);
+  uint32_t i = 0;
+
+  for (; i + 8 <= dst_n; i += 8) {
+    __m256i v = scale_hfilter_8(in, offset, coeff, taps, dst_n, i, shift, max_v);
+    __m128i s16 =
+        _mm_packus_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    _mm_storel_epi64((__m128i*)(out + i), _mm_packus_epi16(s16, s16));
+  }
+  for (; i < dst_n; i++)
+    out[i] = scale_hfilter_1(in, offset, coeff, taps, dst_n, i, shift, max);
+
+  return 0;
+}
+/* end st_scale_hfilter_avx2 */
+
+/* begin st_pcm_to_app_avx2 */
+static uint8_t pcm_be16_to_s32_tbl_avx2[32] = {
+    0x80, 0x80, 1,  0,  0x80, 0x80, 3,  2,  0x80, 0x80, 5,  4,  0x80, 0x80, 7,  6,
+    0x80, 0x80, 9,  8,  0x80, 0x80, 11, 10, 0x80, 0x80, 13, 12, 0x80, 0x80, 15, 14,
+};
+
+/* same for both lanes, lane 1 is loaded from the 5th sample */
+static uint8_t pcm_be24_to_s32_tbl_avx2[32] = {
+    0x80, 2, 1, 0, 0x80, 5, 4, 3, 0x80, 8, 7, 6, 0x80, 11, 10, 9,
+    0x80, 2, 1, 0, 0x80, 5, 4, 3, 0x80, 8, 7, 6, 0x80, 11, 10, 9,
+};
+
+/* the gathered 32 bit word starts at the sample, same for both lanes */
+static uint8_t pcm_word16_to_s32_tbl_avx2[32] = {
+    0x80, 0x80, 1, 0, 0x80, 0x80, 5, 4, 0x80, 0x80, 9, 8, 0x80, 0x80, 13, 12,
+    0x80, 0x80, 1, 0, 0x80, 0x80, 5, 4, 0x80, 0x80, 9, 8, 0x80, 0x80, 13, 12,
+};
+
+static uint8_t pcm_word24_to_s32_tbl_avx2[32] = {
+    0x80, 2, 1, 0, 0x80, 6, 5, 4, 0x80, 10, 9, 8, 0x80, 14, 13, 12,
+    0x80, 2, 1, 0, 0x80, 6, 5, 4, 0x80, 10, 9, 8, 0x80, 14, 13, 12,
+};
+
+static inline void pcm_app_store_avx2(void* dst, uint32_t i, __m256i v,
+                                      enum st30p_sample_fmt app_fmt) {
+  if (app_fmt == ST30P_SAMPLE_FMT_F32) {
+    __m256 f = _mm256_mul_ps(_mm256_cvtepi32_ps(v), _mm256_set1_ps(1.0f / 2147483648.0f));
+    _mm256_storeu_ps((float*)dst + i, f);
+  } else {
+    _mm256_storeu_si256((__m256i*)((int32_t*)dst + i), v);
+  }
+}
+
+int st_pcm_to_app_avx2(const uint8_t* src, void* dst, uint32_t n, enum st30_fmt fmt,
+                       enum st30p_sample_fmt app_fmt) {
+  uint8_t ss = st30_get_sample_size(fmt);
+  uint32_t i = 0;
+
+  if (fmt == ST30_FMT_PCM8) {
+    __m256i offset = _mm256_set1_epi32(0x80);
+    for (; i + 8 <= n; i += 8) {
+      __m128i in = _mm_loadl_epi64((__m128i*)(src + i));
+      __m256i v = _mm256_cvtepu8_epi32(in);
+      v = _mm256_slli_epi32(_mm256_xor_si256(v, offset), 24);
+      pcm_app_store_avx2(dst, i, v, app_fmt);
+    }
+  } else if (fmt == ST30_FMT_PCM16) {
+    __m256i shuffle = _mm256_loadu_si256((__m256i*)pcm_be16_to_s32_tbl_avx2);
+    for (; i + 8 <= n; i += 8) {
+      __m128i in = _mm_loadu_si128((__m128i*)(src + i * 2));
+      __m256i v = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(in), shuffle);
+      pcm_app_store_avx2(dst, i, v, app_fmt);
+    }
+  } else if (fmt == ST30_FMT_PCM24) {
+    __m256i shuffle = _mm256_loadu_si256((__m256i*)pcm_be24_to_s32_tbl_avx2);
+    /* the lane 1 load reads 4 bytes after the 8 samples */
+    for (; i + 10 <= n; i += 8) {
+      __m128i lo = _mm_loadu_si128((__m128i*)(src + i * 3));
+      __m128i hi = _mm_loadu_si128((__m128i*)(src + i * 3 + 12));
+      __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+      pcm_app_store_avx2(dst, i, _mm256_shuffle_epi8(v, shuffle), app_fmt);
+    }
+  } else {
+    return -EINVAL;
+  }
+
+  for (; i < n; i++) st_pcm_app_store(dst, i, st_pcm_load(src + i * ss, fmt), app_fmt);
+  return 0;
+}
+/* end st_pcm_to_app_avx2 */
+
+/* begin st_pcm_gather_to_app_avx2 */
+int st_pcm_gather_to_app_avx2(const uint8_t* base, const int32_t* offset, uint32_t n,
+                              uint32_t limit, void* dst, enum st30_fmt fmt,
+                              enum st30p_sample_fmt app_fmt) {
+  /* the gather reads a 32 bit word from each sample */
+  __m256i last = _mm256_set1_epi32((int32_t)limit - 4);
+  __m256i shuffle;
+  uint32_t i = 0;
+
+  if (fmt == ST30_FMT_PCM16)
+    shuffle = _mm256_loadu_si256((__m256i*)pcm_word16_to_s32_tbl_avx2);
+  else if (fmt == ST30_FMT_PCM24)
+    shuffle = _mm256_loadu_si256((__m256i*)pcm_word24_to_s32_tbl_avx2);
+  else if (fmt == ST30_FMT_PCM8)
+    shuffle = _mm256_setzero_si256();
+  else
+    return -EINVAL;
+
+  for (; i + 8 <= n; i += 8) {
+    __m256i off = _mm256_loadu_si256((__m256i*)(offset + i));
+    __m256i v;
+
+    if (_mm256_movemask_epi8(_mm256_cmpgt_epi32(off, last))) {
+      /* a word over the end, the scalar way for this run */
+      for (uint32_t j = i; j < i + 8; j++)
+        st_pcm_app_store(dst, j, st_pcm_load(base + offset[j], fmt), app_fmt);
+      continue;
+    }
+    v = _mm256_i32gather_epi32((const int*)base, off, 1);
+    if (fmt == ST30_FMT_PCM8) {
+      v = _mm256_and_si256(v, _mm256_set1_epi32(0xFF));
+      v = _mm256_slli_epi32(_mm256_xor_si256(v, _mm256_set1_epi32(0x80)), 24);
+    } else {
+      v = _mm256_shuffle_epi8(v, shuffle);
+    }
+    pcm_app_store_avx2(dst, i, v, app_fmt);
+  }
+
+  for (; i < n; i++)
+    st_pcm_app_store(dst, i, st_pcm_load(base + offset[i], fmt), app_fmt);
+  return 0;
+}
+/* end st_pcm_gather_to_app_avx2 */
+
+/* begin st_pcm_to_wire_avx2 */
+static uint8_t pcm_s16_to_be16_tbl_avx2[32] = {
+    1,    0,    5,    4,    9,    8,    13,   12,   0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 1,    0,    5,    4,    9,    8,
+    13,   12,   0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+static uint8_t pcm_s24_to_be24_tbl_avx2[32] = {
+    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, 0x80, 0x80, 0x80, 0x80,
+    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, 0x80, 0x80, 0x80, 0x80,
+};
+
+static uint8_t pcm_s8_to_u8_tbl_avx2[32] = {
+    0,    4,    8,    12,   0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0,    4,    8,    12,   0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+/* the app samples to the sample values of the bits */
+static inline __m256i pcm_app_to_sample_avx2(__m256i in, uint8_t bits,
+                                             enum st30p_sample_fmt app_fmt) {
+  if (app_fmt == ST30P_SAMPLE_FMT_F32) {
+    float scale = (float)(1u << (bits - 1));
+    __m256 f = _mm256_castsi256_ps(in);
+    /* a NaN takes the second operand of max, -1.0 */
+    f = _mm256_max_ps(f, _mm256_set1_ps(-1.0f));
+    f = _mm256_min_ps(f, _mm256_set1_ps(1.0f - 1.0f / scale));
+    return _mm256_cvtps_epi32(_mm256_mul_ps(f, _mm256_set1_ps(scale)));
+  }
+  return _mm256_srai_epi32(in, 32 - bits);
+}
+
+/* 8 sample values to the wire, no byte after the 8 samples is written */
+static inline void pcm_wire_store_avx2(uint8_t* dst, __m256i v, enum st30_fmt fmt,
+                                       __m256i shuffle) {
+  __m128i lo, hi;
+  uint32_t word;
+
+  if (fmt == ST30_FMT_PCM8) v = _mm256_xor_si256(v, _mm256_set1_epi32(0x80));
+  v = _mm256_shuffle_epi8(v, shuffle);
+  lo = _mm256_castsi256_si128(v);
+  hi = _mm256_extracti128_si256(v, 1);
+  if (fmt == ST30_FMT_PCM8) {
+    word = _mm_cvtsi128_si32(lo);
+    memcpy(dst, &word, 4);
+    word = _mm_cvtsi128_si32(hi);
+    memcpy(dst + 4, &word, 4);
+  } else if (fmt == ST30_FMT_PCM16) {
+    _mm_storel_epi64((__m128i*)dst, lo);
+    _mm_storel_epi64((__m128i*)(dst + 8), hi);
+  } else {
+    _mm_storel_epi64((__m128i*)dst, lo);
+    word = _mm_extract_epi32(lo, 2);
+    memcpy(dst + 8, &word, 4);
+    _mm_storel_epi64((__m128i*)(dst + 12), hi);
+    word = _mm_extract_epi32(hi, 2);
+    memcpy(dst + 20, &word, 4);
+  }
+}
+
+static inline __m256i pcm_wire_shuffle_avx2(enum st30_fmt fmt) {
+  if (fmt == ST30_FMT_PCM8) return _mm256_loadu_si256((__m256i*)pcm_s8_to_u8_tbl_avx2);
+  if (fmt == ST30_FMT_PCM16)
+    return _mm256_loadu_si256((__m256i*)pcm_s16_to_be16_tbl_avx2);
+  return _mm256_loadu_si256((__m256i*)pcm_s24_to_be24_tbl_avx2);
+}
+
+int st_pcm_to_wire_avx2(const void* src, uint8_t* dst, uint32_t n, enum st30_fmt fmt,
+                        enum st30p_sample_fmt app_fmt) {
+  uint8_t ss = st30_get_sample_size(fmt);
+  uint8_t bits = st_pcm_bits(fmt);
+  __m256i shuffle;
+  uint32_t i = 0;
+
+  if (!st_pcm_convert_fmt_supported(fmt)) return -EINVAL;
+  shuffle = pcm_wire_shuffle_avx2(fmt);
+
+  for (; i + 8 <= n; i += 8) {
+    __m256i in = _mm256_loadu_si256((__m256i*)((const int32_t*)src + i));
+    __m256i v = pcm_app_to_sample_avx2(in, bits, app_fmt);
+    pcm_wire_store_avx2(dst + i * ss, v, fmt, shuffle);
+  }
+
+  for (; i < n; i++)
+    st_pcm_store(dst + i * ss, st_pcm_app_load(src, i, fmt, app_fmt), fmt);
+  return 0;
+}
+/* end st_pcm_to_wire_avx2 */
+
+/* begin st_pcm_gather_to_wire_avx2 */
+int st_pcm_gather_to_wire_avx2(const void* base, const int32_t* idx, uint32_t n,
+                               uint8_t* dst, enum st30_fmt fmt,
+                               enum st30p_sample_fmt app_fmt) {
+  uint8_t ss = st30_get_sample_size(fmt);
+  uint8_t bits = st_pcm_bits(fmt);
+  __m256i none = _mm256_set1_epi32(-1);
+  __m256i shuffle;
+  uint32_t i = 0;
+
+  if (!st_pcm_convert_fmt_supported(fmt)) return -EINVAL;
+  shuffle = pcm_wire_shuffle_avx2(fmt);
+
+  for (; i + 8 <= n; i += 8) {
+    __m256i index = _mm256_loadu_si256((__m256i*)(idx + i));
+    /* the silent channels are not loaded, zero for both s32 and f32 */
+    __m256i mask = _mm256_cmpgt_epi32(index, none);
+    __m256i in = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int*)base,
+                                             index, mask, 4);
+    __m256i v = pcm_app_to_sample_avx2(in, bits, app_fmt);
+    pcm_wire_store_avx2(dst + i * ss, v, fmt, shuffle);
+  }
+
+  for (; i < n; i++)
+    st_pcm_store(dst + i * ss, st_pcm_app_load(base, idx[i], fmt, app_fmt), fmt);
+  return 0;
+}
+/* end st_pcm_gather_to_wire_avx2 */
+
+/* begin st_audio_scatter_rows_avx2 */
+int st_audio_scatter_rows_avx2(const uint8_t* src, uint32_t src_row, uint32_t rows,
+                               uint8_t* dst, uint32_t dst_stride) {
+  for (uint32_t r = 0; r < rows; r++) {
+    const uint8_t* s = src + (size_t)r * src_row;
+    uint8_t* d = dst + (size_t)r * dst_stride;
+    uint32_t i = 0;
+
+    for (; i + 32 <= src_row; i += 32)
+      _mm256_storeu_si256((__m256i*)(d + i), _mm256_loadu_si256((__m256i*)(s + i)));
+    for (; i + 16 <= src_row; i += 16)
+      _mm_storeu_si128((__m128i*)(d + i), _mm_loadu_si128((__m128i*)(s + i)));
+    if (i < src_row) memcpy(d + i, s + i, src_row - i);
+  }
+  return 0;
+}
+/* end st_audio_scatter_rows_avx2 */
+
+/* begin st_audio_meter_rows_avx2 */
+int st_audio_meter_rows_avx2(const struct st_audio_meter_coef* coef, const float* x,
+                             uint32_t rows, uint16_t channel, uint16_t stride, float* z,
+                             float* acc) {
+  const float* k1 = coef->kw[0];
+  const float* k2 = coef->kw[1];
+  __m256 sign = _mm256_set1_ps(-0.0f);
+  __m256 b10 = _mm256_set1_ps(k1[0]), b11 = _mm256_set1_ps(k1[1]);
+  __m256 b12 = _mm256_set1_ps(k1[2]), a11 = _mm256_set1_ps(k1[3]);
+  __m256 a12 = _mm256_set1_ps(k1[4]), b20 = _mm256_set1_ps(k2[0]);
+  __m256 b21 = _mm256_set1_ps(k2[1]), b22 = _mm256_set1_ps(k2[2]);
+  __m256 a21 = _mm256_set1_ps(k2[3]), a22 = _mm256_set1_ps(k2[4]);
+
+  /* 8 channels in the lanes, the lanes after the last channel are on the padding */
+  for (uint16_t c = 0; c < channel; c += 8) {
+    __m256 z0 = _mm256_loadu_ps(z + c);
+    __m256 z1 = _mm256_loadu_ps(z + stride + c);
+    __m256 z2 = _mm256_loadu_ps(z + stride * 2 + c);
+    __m256 z3 = _mm256_loadu_ps(z + stride * 3 + c);
+    __m256 peak = _mm256_loadu_ps(acc + ST_AUDIO_METER_ACC_PEAK * stride + c);
+    __m256 tp = _mm256_loadu_ps(acc + ST_AUDIO_METER_ACC_TP * stride + c);
+    __m256 sq = _mm256_loadu_ps(acc + ST_AUDIO_METER_ACC_SQ * stride + c);
+    __m256 ksq = _mm256_loadu_ps(acc + ST_AUDIO_METER_ACC_KSQ * stride + c);
+
+    for (uint32_t r = 0; r < rows; r++) {
+      const float* p = x + (size_t)r * channel + c;
+      __m256 v = _mm256_loadu_ps(p);
+
+      peak = _mm256_max_ps(peak, _mm256_andnot_ps(sign, v));
+      sq = _mm256_add_ps(sq, _mm256_mul_ps(v, v));
+
+      __m256 y1 = _mm256_add_ps(_mm256_mul_ps(b10, v), z0);
+      z0 = _mm256_sub_ps(_mm256_mul_ps(b11, v), _mm256_mul_ps(a11, y1));
+      z0 = _mm256_add_ps(z0, z1);
+      z1 = _mm256_sub_ps(_mm256_mul_ps(b12, v), _mm256_mul_ps(a12, y1));
+      __m256 y2 = _mm256_add_ps(_mm256_mul_ps(b20, y1), z2);
+      z2 = _mm256_sub_ps(_mm256_mul_ps(b21, y1), _mm256_mul_ps(a21, y2));
+      z2 = _mm256_add_ps(z2, z3);
+      z3 = _mm256_sub_ps(_mm256_mul_ps(b22, y1), _mm256_mul_ps(a22, y2));
+      ksq = _mm256_add_ps(ksq, _mm256_mul_ps(y2, y2));
+
+      for (int ph = 0; ph < ST_AUDIO_METER_TP_PHASES; ph++) {
+        __m256 t = _mm256_mul_ps(_mm256_set1_ps(coef->tp[ph][0]), v);
+        for (int j = 1; j < ST_AUDIO_METER_TP_TAPS; j++) {
+          __m256 h = _mm256_loadu_ps(p - (ptrdiff_t)j * channel);
+          t = _mm256_add_ps(t, _mm256_mul_ps(_mm256_set1_ps(coef->tp[ph][j]), h));
+        }
+        tp = _mm256_max_ps(tp, _mm256_andnot_ps(sign, t));
+      }
+    }
+
+    _mm256_storeu_ps(z + c, z0);
+    _mm256_storeu_ps(z + stride + c, z1);
+    _mm256_storeu_ps(z + stride * 2 + c, z2);
+    _mm256_storeu_ps(z + stride * 3 + c, z3);
+    _mm256_storeu_ps(acc + ST_AUDIO_METER_ACC_PEAK * stride + c, peak);
+    _mm256_storeu_ps(acc + ST_AUDIO_METER_ACC_TP * stride + c, tp);
+    _mm256_storeu_ps(acc + ST_AUDIO_METER_ACC_SQ * stride + c, sq);
+    _mm256_storeu_ps(acc + ST_AUDIO_METER_ACC_KSQ * stride + c, ksq);
+  }
+
+  return 0;
+}
+/* end st_audio_meter_rows_avx2 */
+
+/* begin st_anc_udw_pack_avx2 */
+/* the 40 bit group of 4 words in each 64 bit to 5 bytes of big endian */
+static uint8_t anc_udw_pack_shuffle_tbl_avx2[32] = {
+    4, 3, 2, 1, 0, 12, 11, 10, 9, 8, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    4, 3, 2, 1, 0, 12, 11, 10, 9, 8, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+/* the 8 bit values in 16 bit to the words, b8 the even parity and b9 the not of b8 */
+static inline __m256i anc_udw_parity_avx2(__m256i v) {
+  __m256i p = _mm256_xor_si256(v, _mm256_srli_epi16(v, 4));
+  p = _mm256_xor_si256(p, _mm256_srli_epi16(p, 2));
+  p = _mm256_xor_si256(p, _mm256_srli_epi16(p, 1));
+  p = _mm256_slli_epi16(_mm256_and_si256(p, _mm256_set1_epi16(1)), 8);
+  /* 0x200 for an even count of ones, 0x100 for odd */
+  return _mm256_or_si256(v, _mm256_sub_epi16(_mm256_set1_epi16(0x200), p));
+}
+
+static inline uint16_t anc_udw_hsum_avx2(__m256i acc) {
+  uint16_t lanes[16], sum = 0;
+
+  _mm256_storeu_si256((__m256i*)lanes, acc);
+  for (int k = 0; k < 16; k++) sum += lanes[k];
+  return sum;
+}
+
+/* the 10 bytes in the low of v, no byte after is written */
+static inline void anc_udw_store10_avx2(uint8_t* dst, __m128i v) {
+  uint16_t tail = _mm_extract_epi16(v, 4);
+
+  _mm_storel_epi64((__m128i*)dst, v);
+  memcpy(dst + 8, &tail, 2);
+}
+
+int st_anc_udw_pack_avx2(const uint8_t* udw, uint32_t n, uint8_t* dst, uint16_t* sum) {
+  __m256i shuffle = _mm256_loadu_si256((__m256i*)anc_udw_pack_shuffle_tbl_avx2);
+  /* w0 << 10 | w1 of each pair of words */
+  __m256i pair_mul = _mm256_set1_epi32(0x00010400);
+  __m256i acc = _mm256_setzero_si256();
+
+  if (n % 8) return -EINVAL;
+
+  for (uint32_t i = 0; i < n; i += 16) {
+    bool half = (n - i) < 16;
+    __m128i in = half ? _mm_loadl_epi64((__m128i*)(udw + i))
+                      : _mm_loadu_si128((__m128i*)(udw + i));
+    __m256i w = anc_udw_parity_avx2(_mm256_cvtepu8_epi16(in));
+    /* the zero bytes of a half load are not words */
+    if (half) w = _mm256_and_si256(w, _mm256_setr_epi64x(-1, -1, 0, 0));
+    acc = _mm256_add_epi16(acc, w);
+
+    /* p01 << 20 | p23 of each group, the bits from 40 on are not stored */
+    __m256i p = _mm256_madd_epi16(w, pair_mul);
+    __m256i g = _mm256_or_si256(_mm256_slli_epi64(p, 20), _mm256_srli_epi64(p, 32));
+    __m256i out = _mm256_shuffle_epi8(g, shuffle);
+
+    anc_udw_store10_avx2(dst, _mm256_castsi256_si128(out));
+    if (!half) anc_udw_store10_avx2(dst + 10, _mm256_extracti128_si256(out, 1));
+    dst += 20;
+  }
+
+  *sum = anc_udw_hsum_avx2(acc);
+  return 0;
+}
+/* end st_anc_udw_pack_avx2 */
+
+/* begin st_anc_udw_unpack_avx2 */
+/* the 2 bytes holding each word of the 10 bytes, to 16 bit of little endian */
+static uint8_t anc_udw_unpack_shuffle_tbl_avx2[32] = {
+    1, 0, 2, 1, 3, 2, 4, 3, 6, 5, 7, 6, 8, 7, 9, 8,
+    1, 0, 2, 1, 3, 2, 4, 3, 6, 5, 7, 6, 8, 7, 9, 8,
+};
+
+/* shift left by the bit offset of the word in its 2 bytes, 0, 2, 4, 6 */
+static uint16_t anc_udw_unpack_mul_tbl_avx2[16] = {
+    1, 4, 16, 64, 1, 4, 16, 64, 1, 4, 16, 64, 1, 4, 16, 64,
+};
+
+/* the 10 bytes of src to the low of the 128 bit, no byte after is read */
+static inline __m128i anc_udw_load10_avx2(const uint8_t* src) {
+  uint16_t tail;
+
+  memcpy(&tail, src + 8, 2);
+  return _mm_insert_epi16(_mm_loadl_epi64((const __m128i*)src), tail, 4);
+}
+
+int st_anc_udw_unpack_avx2(const uint8_t* src, uint32_t n, uint8_t* udw,
+                           uint16_t* sum, uint32_t* bad) {
+  __m256i shuffle = _mm256_loadu_si256((__m256i*)anc_udw_unpack_shuffle_tbl_avx2);
+  __m256i mul = _mm256_loadu_si256((__m256i*)anc_udw_unpack_mul_tbl_avx2);
+  __m256i low = _mm256_set1_epi16(0xFF);
+  __m256i acc = _mm256_setzero_si256();
+  uint32_t bad_cnt = 0;
+
+  if (n % 8) return -EINVAL;
+
+  for (uint32_t i = 0; i < n; i += 16) {
+    bool half = (n - i) < 16;
+    __m128i lo = anc_udw_load10_avx2(src);
+    __m128i hi = half ? _mm_setzero_si128() : anc_udw_load10_avx2(src + 10);
+    __m256i b = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    __m256i w = _mm256_shuffle_epi8(b, shuffle);
+    w = _mm256_srli_epi16(_mm256_mullo_epi16(w, mul), 6);
+
+    __m256i v = _mm256_and_si256(w, low);
+    __m256i ok = _mm256_cmpeq_epi16(w, anc_udw_parity_avx2(v));
+    /* 2 bits of the mask for each word, the zero words of a half are not counted */
+    uint32_t fail = ~(uint32_t)_mm256_movemask_epi8(ok);
+    if (half) fail &= 0xFFFF;
+    bad_cnt += __builtin_popcount(fail) / 2;
+    acc = _mm256_add_epi16(acc, w);
+
+    if (udw) {
+      __m128i out = _mm_packus_epi16(_mm256_castsi256_si128(v),
+                                     _mm256_extracti128_si256(v, 1));
+      if (half)
+        _mm_storel_epi64((__m128i*)(udw + i), out);
+      else
+        _mm_storeu_si128((__m128i*)(udw + i), out);
+    }
+    src += 20;
+  }
+
+  *sum = anc_udw_hsum_avx2(acc);
+  *bad = bad_cnt;
+  return 0;
+}
+/* end st_anc_udw_unpack_avx2 */
+
 MT_TARGET_CODE_STOP
 #endif
@@ -5,6 +5,7 @@
 #ifndef _ST_LIB_AVX2_H_
 #define _ST_LIB_AVX2_H_
 
+#include "st30_pipeline_api.h"
 #include "st_main.h"
 
 int st20_rfc4175_422be10_to_422le10_avx2(struct st20_rfc4175_422_10_pg2_be* pg_be,
@@ -15,4 +16,45 @@ int st20_rfc4175_422le10_to_422be10_avx2(struct st20_rfc4175_422_10_pg2_le* pg_l
                                          struct st20_rfc4175_422_10_pg2_be* pg_be,
                                          uint32_t w, uint32_t h);
 
-#endif
\ No newline at end of file
+int st_scale_vfilter_u16_avx2(const uint16_t** lines, const int32_t* coeff, uint16_t taps,
+                              uint32_t w, uint8_t frac_bits, int32_t* out);
+
+int st_scale_vfilter_u8_avx2(const uint8_t** lines, const int32_t* coeff, uint16_t taps,
+                             uint32_t w, uint8_t frac_bits, int32_t* out);
+
+int st_scale_hfilter_u16_avx2(const int32_t* in, const uint32_t* offset,
+                              const int32_t* coeff, uint16_t taps, uint32_t dst_n,
+                              uint8_t frac_bits, uint32_t max, uint16_t* out);
+
+int st_scale_hfilter_u8_avx2(const int32_t* in, const uint32_t* offset,
+                             const int32_t* coeff, uint16_t taps, uint32_t dst_n,
+                             uint8_t frac_bits, uint32_t max, uint8_t* out);
+
+int st_pcm_to_app_avx2(const uint8_t* src, void* dst, uint32_t n, enum st30_fmt fmt,
+                       enum st30p_sample_fmt app_fmt);
+
+int st_pcm_gather_to_app_avx2(const uint8_t* base, const int32_t* offset, uint32_t n,
+                              uint32_t limit, void* dst, enum st30_fmt fmt,
+                              enum st30p_sample_fmt app_fmt);
+
+int st_pcm_to_wire_avx2(const void* src, uint8_t* dst, uint32_t n, enum st30_fmt fmt,
+                        enum st30p_sample_fmt app_fmt);
+
+int st_pcm_gather_to_wire_avx2(const void* base, const int32_t* idx, uint32_t n,
+                               uint8_t* dst, enum st30_fmt fmt,
+                               enum st30p_sample_fmt app_fmt);
+
+int st_audio_scatter_rows_avx2(const uint8_t* src, uint32_t src_row, uint32_t rows,
+                               uint8_t* dst, uint32_t dst_stride);
+
+int st_audio_meter_rows_avx2(const struct st_audio_meter_coef* coef, const float* x,
+                             uint32_t rows, uint16_t channel, uint16_t stride, float* z,
+                             float* acc);
+
+/* n(a multiple of 8) udw from the 8 bit values to dst of a 4 words boundary */
+int st_anc_udw_pack_avx2(const uint8_t* udw, uint32_t n, uint8_t* dst, uint16_t* sum);
+
+int st_anc_udw_unpack_avx2(const uint8_t* src, uint32_t n, uint8_t* udw,
+                           uint16_t* sum, uint32_t* bad);
+
+#endif
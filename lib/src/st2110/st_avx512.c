@@ -6,6 +6,7 @@
 
 #include "../mt_log.h"
 #include "st_main.h"
+#include "st_pcm_convert.h"
 
 #ifdef MTL_HAS_AVX512
 MT_TARGET_CODE_START_AVX512
@@ -927,6 +928,156 @@ int st20_rfc4175_422be10_to_yuv420p8_avx512(struct st20_rfc4175_422_10_pg2_be* p
   return 0;
 }
 
+/* begin st20_rfc4175_422be10_to_nv12_avx512 */
+static uint8_t be10_to_yuyv16_shuffle_tbl_128[16] = {
+    2,     1,     1,     0,     4,     3,     3,     2,     /* pg0 */
+    2 + 5, 1 + 5, 1 + 5, 0 + 5, 4 + 5, 3 + 5, 3 + 5, 2 + 5, /* pg1 */
+};
+
+static uint16_t be10_to_yuyv16_sllv_tbl_128[8] = {
+    2, 0, 6, 4, 2, 0, 6, 4,
+};
+
+static uint8_t yuyv16_to_yyuv16_shuffle_tbl_128[16] = {
+    0, 1, 4, 5, 8, 9, 12, 13, /* y */
+    2, 3, 6, 7, 10, 11, 14, 15, /* u v */
+};
+
+/* 4 pgs to 8 Y and 4 CbCr pairs, the 10 bits in the most significant bits of 16 bits */
+static inline void be10_to_yuv16_4pg(struct st20_rfc4175_422_10_pg2_be* pg,
+                                     __m128i shuffle_mask, __m128i sllv_mask,
+                                     __m128i and_mask, __m128i yyuv_mask, __m128i* y,
+                                     __m128i* uv) {
+  __mmask16 k = 0x3FF; /* each __m128i with 2 pg group, 10 bytes */
+
+  __m128i input = _mm_maskz_loadu_epi8(k, (__m128i*)pg);
+  __m128i yuyv = _mm_and_si128(
+      _mm_sllv_epi16(_mm_shuffle_epi8(input, shuffle_mask), sllv_mask), and_mask);
+  /* y0 y1 y2 y3 u0 v0 u1 v1 */
+  __m128i yyuv0 = _mm_shuffle_epi8(yuyv, yyuv_mask);
+
+  input = _mm_maskz_loadu_epi8(k, (__m128i*)(pg + 2));
+  yuyv = _mm_and_si128(_mm_sllv_epi16(_mm_shuffle_epi8(input, shuffle_mask), sllv_mask),
+                       and_mask);
+  __m128i yyuv1 = _mm_shuffle_epi8(yuyv, yyuv_mask);
+
+  *y = _mm_unpacklo_epi64(yyuv0, yyuv1);
+  *uv = _mm_unpackhi_epi64(yyuv0, yyuv1);
+}
+
+int st20_rfc4175_422be10_to_nv12_avx512(struct st20_rfc4175_422_10_pg2_be* pg0,
+                                        struct st20_rfc4175_422_10_pg2_be* pg1,
+                                        uint8_t* y0, uint8_t* y1, uint8_t* uv,
+                                        uint32_t w) {
+  __m128i shuffle_mask = _mm_loadu_si128((__m128i*)be10_to_yuyv16_shuffle_tbl_128);
+  __m128i sllv_mask = _mm_loadu_si128((__m128i*)be10_to_yuyv16_sllv_tbl_128);
+  __m128i and_mask = _mm_set1_epi16(0xFFC0);
+  __m128i yyuv_mask = _mm_loadu_si128((__m128i*)yuyv16_to_yyuv16_shuffle_tbl_128);
+  uint32_t pg_cnt = w / 2;
+
+  while (pg_cnt >= 8) {
+    __m128i ya, yb, uva0, uvb0, uva1, uvb1;
+
+    /* the even line */
+    be10_to_yuv16_4pg(pg0, shuffle_mask, sllv_mask, and_mask, yyuv_mask, &ya, &uva0);
+    be10_to_yuv16_4pg(pg0 + 4, shuffle_mask, sllv_mask, and_mask, yyuv_mask, &yb, &uvb0);
+    _mm_storeu_si128((__m128i*)y0,
+                     _mm_packus_epi16(_mm_srli_epi16(ya, 8), _mm_srli_epi16(yb, 8)));
+    /* the odd line */
+    be10_to_yuv16_4pg(pg1, shuffle_mask, sllv_mask, and_mask, yyuv_mask, &ya, &uva1);
+    be10_to_yuv16_4pg(pg1 + 4, shuffle_mask, sllv_mask, and_mask, yyuv_mask, &yb, &uvb1);
+    _mm_storeu_si128((__m128i*)y1,
+                     _mm_packus_epi16(_mm_srli_epi16(ya, 8), _mm_srli_epi16(yb, 8)));
+    /*
+     * (c0 + c1 + 4) >> 3 of the 10 bits, the halves sum never overflow 16 bits and the
+     * rounding add saturates, so 1023 + 1023 gives 255 like the scalar clamp.
+     */
+    __m128i round = _mm_set1_epi16(0x80);
+    __m128i uva = _mm_add_epi16(_mm_srli_epi16(uva0, 1), _mm_srli_epi16(uva1, 1));
+    __m128i uvb = _mm_add_epi16(_mm_srli_epi16(uvb0, 1), _mm_srli_epi16(uvb1, 1));
+    uva = _mm_adds_epu16(uva, round);
+    uvb = _mm_adds_epu16(uvb, round);
+    _mm_storeu_si128((__m128i*)uv,
+                     _mm_packus_epi16(_mm_srli_epi16(uva, 8), _mm_srli_epi16(uvb, 8)));
+
+    pg0 += 8;
+    pg1 += 8;
+    y0 += 16;
+    y1 += 16;
+    uv += 16;
+    pg_cnt -= 8;
+  }
+
+  while (pg_cnt > 0) {
+    uint16_t cb0, y00, cr0, y01;
+    uint16_t cb1, y10, cr1, y11;
+
+    st20_unpack_pg2be_422le10(pg0++, &cb0, &y00, &cr0, &y01);
+    st20_unpack_pg2be_422le10(pg1++, &cb1, &y10, &cr1, &y11);
+    *y0++ = y00 >> 2;
+    *y0++ = y01 >> 2;
+    *y1++ = y10 >> 2;
+    *y1++ = y11 >> 2;
+    *uv++ = st20_chroma_avg_10to8(cb0, cb1);
+    *uv++ = st20_chroma_avg_10to8(cr0, cr1);
+
+    pg_cnt--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422be10_to_nv12_avx512 */
+
+/* begin st20_rfc4175_422be10_to_p010_avx512 */
+int st20_rfc4175_422be10_to_p010_avx512(struct st20_rfc4175_422_10_pg2_be* pg0,
+                                        struct st20_rfc4175_422_10_pg2_be* pg1,
+                                        uint16_t* y0, uint16_t* y1, uint16_t* uv,
+                                        uint32_t w) {
+  __m128i shuffle_mask = _mm_loadu_si128((__m128i*)be10_to_yuyv16_shuffle_tbl_128);
+  __m128i sllv_mask = _mm_loadu_si128((__m128i*)be10_to_yuyv16_sllv_tbl_128);
+  __m128i and_mask = _mm_set1_epi16(0xFFC0);
+  __m128i yyuv_mask = _mm_loadu_si128((__m128i*)yuyv16_to_yyuv16_shuffle_tbl_128);
+  uint32_t pg_cnt = w / 2;
+
+  while (pg_cnt >= 4) {
+    __m128i y, uv0, uv1;
+
+    be10_to_yuv16_4pg(pg0, shuffle_mask, sllv_mask, and_mask, yyuv_mask, &y, &uv0);
+    _mm_storeu_si128((__m128i*)y0, y);
+    be10_to_yuv16_4pg(pg1, shuffle_mask, sllv_mask, and_mask, yyuv_mask, &y, &uv1);
+    _mm_storeu_si128((__m128i*)y1, y);
+    /* the rounded average of the 10 bits, back to the most significant bits */
+    __m128i avg = _mm_avg_epu16(_mm_srli_epi16(uv0, 6), _mm_srli_epi16(uv1, 6));
+    _mm_storeu_si128((__m128i*)uv, _mm_slli_epi16(avg, 6));
+
+    pg0 += 4;
+    pg1 += 4;
+    y0 += 8;
+    y1 += 8;
+    uv += 8;
+    pg_cnt -= 4;
+  }
+
+  while (pg_cnt > 0) {
+    uint16_t cb0, y00, cr0, y01;
+    uint16_t cb1, y10, cr1, y11;
+
+    st20_unpack_pg2be_422le10(pg0++, &cb0, &y00, &cr0, &y01);
+    st20_unpack_pg2be_422le10(pg1++, &cb1, &y10, &cr1, &y11);
+    *y0++ = y00 << 6;
+    *y0++ = y01 << 6;
+    *y1++ = y10 << 6;
+    *y1++ = y11 << 6;
+    *uv++ = ((cb0 + cb1 + 1) >> 1) << 6;
+    *uv++ = ((cr0 + cr1 + 1) >> 1) << 6;
+
+    pg_cnt--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422be10_to_p010_avx512 */
+
 /* begin st20_rfc4175_422le10_to_v210_avx512 */
 static uint8_t le10_to_v210_shuffle_r_tbl_128[16] = {
     0, 1, 2, 3, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
@@ -3023,5 +3174,408 @@ int st20_yuv422p16le_to_rfc4175_422be10_avx512(uint16_t* y, uint16_t* b, uint16_
   return 0;
 }
 
+/* begin st_pcm_to_app_avx512 */
+/* each 128 bit lane from the 4th sample of the last lane, 12 bytes of 4 samples */
+static uint32_t pcm_be24_lane_idx_avx512[16] = {
+    0, 1, 2, 3, 3, 4, 5, 6, 6, 7, 8, 9, 9, 10, 11, 12,
+};
+
+static uint8_t pcm_be24_to_s32_tbl_avx512[16] = {
+    0x80, 2, 1, 0, 0x80, 5, 4, 3, 0x80, 8, 7, 6, 0x80, 11, 10, 9,
+};
+
+/* the zero extended 16 bit sample or the gathered word, bytes 0 and 1 */
+static uint8_t pcm_word16_to_s32_tbl_avx512[16] = {
+    0x80, 0x80, 1, 0, 0x80, 0x80, 5, 4, 0x80, 0x80, 9, 8, 0x80, 0x80, 13, 12,
+};
+
+static uint8_t pcm_word24_to_s32_tbl_avx512[16] = {
+    0x80, 2, 1, 0, 0x80, 6, 5, 4, 0x80, 10, 9, 8, 0x80, 14, 13, 12,
+};
+
+static inline __mmask16 pcm_mask16_avx512(uint32_t cnt) {
+  return (cnt >= 16) ? 0xFFFF : (__mmask16)((1u << cnt) - 1);
+}
+
+static inline void pcm_app_store_avx512(void* dst, uint32_t i, __mmask16 k, __m512i v,
+                                        enum st30p_sample_fmt app_fmt) {
+  if (app_fmt == ST30P_SAMPLE_FMT_F32) {
+    __m512 f = _mm512_mul_ps(_mm512_cvtepi32_ps(v), _mm512_set1_ps(1.0f / 2147483648.0f));
+    _mm512_mask_storeu_ps((float*)dst + i, k, f);
+  } else {
+    _mm512_mask_storeu_epi32((int32_t*)dst + i, k, v);
+  }
+}
+
+int st_pcm_to_app_avx512(const uint8_t* src, void* dst, uint32_t n, enum st30_fmt fmt,
+                         enum st30p_sample_fmt app_fmt) {
+  __m512i lane_idx = _mm512_loadu_si512(pcm_be24_lane_idx_avx512);
+  __m512i be24 =
+      _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)pcm_be24_to_s32_tbl_avx512));
+  __m512i word16 =
+      _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)pcm_word16_to_s32_tbl_avx512));
+
+  if (!st_pcm_convert_fmt_supported(fmt)) return -EINVAL;
+
+  /* the masked load and store for the tail, no scalar way */
+  for (uint32_t i = 0; i < n; i += 16) {
+    uint32_t cnt = RTE_MIN(n - i, 16);
+    __mmask16 k = pcm_mask16_avx512(cnt);
+    __m512i v;
+
+    if (fmt == ST30_FMT_PCM8) {
+      __m128i in = _mm_maskz_loadu_epi8(k, src + i);
+      v = _mm512_xor_si512(_mm512_cvtepu8_epi32(in), _mm512_set1_epi32(0x80));
+      v = _mm512_slli_epi32(v, 24);
+    } else if (fmt == ST30_FMT_PCM16) {
+      __m256i in = _mm256_maskz_loadu_epi16(k, src + i * 2);
+      v = _mm512_shuffle_epi8(_mm512_cvtepu16_epi32(in), word16);
+    } else {
+      __mmask64 k64 = _cvtu64_mask64((1ULL << (cnt * 3)) - 1);
+      __m512i in = _mm512_maskz_loadu_epi8(k64, src + i * 3);
+      v = _mm512_shuffle_epi8(_mm512_permutexvar_epi32(lane_idx, in), be24);
+    }
+    pcm_app_store_avx512(dst, i, k, v, app_fmt);
+  }
+
+  return 0;
+}
+/* end st_pcm_to_app_avx512 */
+
+/* begin st_pcm_gather_to_app_avx512 */
+int st_pcm_gather_to_app_avx512(const uint8_t* base, const int32_t* offset, uint32_t n,
+                                uint32_t limit, void* dst, enum st30_fmt fmt,
+                                enum st30p_sample_fmt app_fmt) {
+  /* the gather reads a 32 bit word from each sample */
+  __m512i last = _mm512_set1_epi32((int32_t)limit - 4);
+  __m512i shuffle;
+
+  if (fmt == ST30_FMT_PCM16)
+    shuffle =
+        _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)pcm_word16_to_s32_tbl_avx512));
+  else if (fmt == ST30_FMT_PCM24)
+    shuffle =
+        _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)pcm_word24_to_s32_tbl_avx512));
+  else if (fmt == ST30_FMT_PCM8)
+    shuffle = _mm512_setzero_si512();
+  else
+    return -EINVAL;
+
+  for (uint32_t i = 0; i < n; i += 16) {
+    __mmask16 k = pcm_mask16_avx512(RTE_MIN(n - i, 16));
+    __m512i off = _mm512_maskz_loadu_epi32(k, offset + i);
+    /* the words over the end go to the scalar way */
+    __mmask16 over = _mm512_mask_cmpgt_epi32_mask(k, off, last);
+    __mmask16 in = k & ~over;
+    __m512i v = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), in, off, base, 1);
+
+    if (fmt == ST30_FMT_PCM8) {
+      v = _mm512_and_si512(v, _mm512_set1_epi32(0xFF));
+      v = _mm512_slli_epi32(_mm512_xor_si512(v, _mm512_set1_epi32(0x80)), 24);
+    } else {
+      v = _mm512_shuffle_epi8(v, shuffle);
+    }
+    pcm_app_store_avx512(dst, i, in, v, app_fmt);
+    for (uint32_t j = 0; over; j++, over >>= 1) {
+      if (over & 1)
+        st_pcm_app_store(dst, i + j, st_pcm_load(base + offset[i + j], fmt), app_fmt);
+    }
+  }
+
+  return 0;
+}
+/* end st_pcm_gather_to_app_avx512 */
+
+/* begin st_pcm_to_wire_avx512 */
+static uint8_t pcm_s24_to_be24_tbl_avx512[16] = {
+    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, 0x80, 0x80, 0x80, 0x80,
+};
+
+/* pack the 12 bytes of each 128 bit lane */
+static uint32_t pcm_be24_pack_idx_avx512[16] = {
+    0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, 15, 15, 15, 15,
+};
+
+static uint8_t pcm_swap16_tbl_avx512[32] = {
+    1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+    1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+};
+
+/* the app samples to the sample values of the bits */
+static inline __m512i pcm_app_to_sample_avx512(__m512i in, uint8_t bits,
+                                               enum st30p_sample_fmt app_fmt) {
+  if (app_fmt == ST30P_SAMPLE_FMT_F32) {
+    float scale = (float)(1u << (bits - 1));
+    __m512 f = _mm512_castsi512_ps(in);
+    /* a NaN takes the second operand of max, -1.0 */
+    f = _mm512_max_ps(f, _mm512_set1_ps(-1.0f));
+    f = _mm512_min_ps(f, _mm512_set1_ps(1.0f - 1.0f / scale));
+    return _mm512_cvtps_epi32(_mm512_mul_ps(f, _mm512_set1_ps(scale)));
+  }
+  return _mm512_srai_epi32(in, 32 - bits);
+}
+
+/* cnt sample values to the wire */
+static inline void pcm_wire_store_avx512(uint8_t* dst, uint32_t cnt, __m512i v,
+                                         enum st30_fmt fmt) {
+  __mmask16 k = pcm_mask16_avx512(cnt);
+
+  if (fmt == ST30_FMT_PCM8) {
+    __m128i out = _mm512_cvtepi32_epi8(_mm512_xor_si512(v, _mm512_set1_epi32(0x80)));
+    _mm_mask_storeu_epi8(dst, k, out);
+  } else if (fmt == ST30_FMT_PCM16) {
+    __m256i out = _mm512_cvtepi32_epi16(v);
+    out = _mm256_shuffle_epi8(out, _mm256_loadu_si256((__m256i*)pcm_swap16_tbl_avx512));
+    _mm256_mask_storeu_epi16(dst, k, out);
+  } else {
+    __m512i shuffle =
+        _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)pcm_s24_to_be24_tbl_avx512));
+    __m512i pack = _mm512_loadu_si512(pcm_be24_pack_idx_avx512);
+    __m512i out = _mm512_permutexvar_epi32(pack, _mm512_shuffle_epi8(v, shuffle));
+    _mm512_mask_storeu_epi8(dst, _cvtu64_mask64((1ULL << (cnt * 3)) - 1), out);
+  }
+}
+
+int st_pcm_to_wire_avx512(const void* src, uint8_t* dst, uint32_t n, enum st30_fmt fmt,
+                          enum st30p_sample_fmt app_fmt) {
+  uint8_t ss = st30_get_sample_size(fmt);
+  uint8_t bits = st_pcm_bits(fmt);
+
+  if (!st_pcm_convert_fmt_supported(fmt)) return -EINVAL;
+
+  for (uint32_t i = 0; i < n; i += 16) {
+    uint32_t cnt = RTE_MIN(n - i, 16);
+    __m512i in =
+        _mm512_maskz_loadu_epi32(pcm_mask16_avx512(cnt), (const int32_t*)src + i);
+    __m512i v = pcm_app_to_sample_avx512(in, bits, app_fmt);
+    pcm_wire_store_avx512(dst + i * ss, cnt, v, fmt);
+  }
+
+  return 0;
+}
+/* end st_pcm_to_wire_avx512 */
+
+/* begin st_pcm_gather_to_wire_avx512 */
+int st_pcm_gather_to_wire_avx512(const void* base, const int32_t* idx, uint32_t n,
+                                 uint8_t* dst, enum st30_fmt fmt,
+                                 enum st30p_sample_fmt app_fmt) {
+  uint8_t ss = st30_get_sample_size(fmt);
+  uint8_t bits = st_pcm_bits(fmt);
+
+  if (!st_pcm_convert_fmt_supported(fmt)) return -EINVAL;
+
+  for (uint32_t i = 0; i < n; i += 16) {
+    uint32_t cnt = RTE_MIN(n - i, 16);
+    __mmask16 k = pcm_mask16_avx512(cnt);
+    __m512i index = _mm512_maskz_loadu_epi32(k, idx + i);
+    /* the silent channels are not loaded, zero for both s32 and f32 */
+    __mmask16 load = _mm512_mask_cmpge_epi32_mask(k, index, _mm512_setzero_si512());
+    __m512i in =
+        _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), load, index, base, 4);
+    __m512i v = pcm_app_to_sample_avx512(in, bits, app_fmt);
+    pcm_wire_store_avx512(dst + i * ss, cnt, v, fmt);
+  }
+
+  return 0;
+}
+/* end st_pcm_gather_to_wire_avx512 */
+
+/* begin st_audio_scatter_rows_avx512 */
+int st_audio_scatter_rows_avx512(const uint8_t* src, uint32_t src_row, uint32_t rows,
+                                 uint8_t* dst, uint32_t dst_stride) {
+  for (uint32_t r = 0; r < rows; r++) {
+    const uint8_t* s = src + (size_t)r * src_row;
+    uint8_t* d = dst + (size_t)r * dst_stride;
+
+    /* the byte mask keeps the channels of the other flows in the row untouched */
+    for (uint32_t i = 0; i < src_row; i += 64) {
+      uint32_t cnt = RTE_MIN(src_row - i, 64);
+      __mmask64 k = (cnt == 64) ? ~0ULL : ((1ULL << cnt) - 1);
+      _mm512_mask_storeu_epi8(d + i, k, _mm512_maskz_loadu_epi8(k, s + i));
+    }
+  }
+  return 0;
+}
+/* end st_audio_scatter_rows_avx512 */
+
+/* begin st_audio_meter_rows_avx512 */
+int st_audio_meter_rows_avx512(const struct st_audio_meter_coef* coef, const float* x,
+                               uint32_t rows, uint16_t channel, uint16_t stride, float* z,
+                               float* acc) {
+  const float* k1 = coef->kw[0];
+  const float* k2 = coef->kw[1];
+  __m512 b10 = _mm512_set1_ps(k1[0]), b11 = _mm512_set1_ps(k1[1]);
+  __m512 b12 = _mm512_set1_ps(k1[2]), a11 = _mm512_set1_ps(k1[3]);
+  __m512 a12 = _mm512_set1_ps(k1[4]), b20 = _mm512_set1_ps(k2[0]);
+  __m512 b21 = _mm512_set1_ps(k2[1]), b22 = _mm512_set1_ps(k2[2]);
+  __m512 a21 = _mm512_set1_ps(k2[3]), a22 = _mm512_set1_ps(k2[4]);
+
+  /* 16 channels in the lanes, the lanes after the last channel are on the padding */
+  for (uint16_t c = 0; c < channel; c += 16) {
+    __m512 z0 = _mm512_loadu_ps(z + c);
+    __m512 z1 = _mm512_loadu_ps(z + stride + c);
+    __m512 z2 = _mm512_loadu_ps(z + stride * 2 + c);
+    __m512 z3 = _mm512_loadu_ps(z + stride * 3 + c);
+    __m512 peak = _mm512_loadu_ps(acc + ST_AUDIO_METER_ACC_PEAK * stride + c);
+    __m512 tp = _mm512_loadu_ps(acc + ST_AUDIO_METER_ACC_TP * stride + c);
+    __m512 sq = _mm512_loadu_ps(acc + ST_AUDIO_METER_ACC_SQ * stride + c);
+    __m512 ksq = _mm512_loadu_ps(acc + ST_AUDIO_METER_ACC_KSQ * stride + c);
+
+    for (uint32_t r = 0; r < rows; r++) {
+      const float* p = x + (size_t)r * channel + c;
+      __m512 v = _mm512_loadu_ps(p);
+
+      peak = _mm512_max_ps(peak, _mm512_abs_ps(v));
+      sq = _mm512_add_ps(sq, _mm512_mul_ps(v, v));
+
+      __m512 y1 = _mm512_add_ps(_mm512_mul_ps(b10, v), z0);
+      z0 = _mm512_sub_ps(_mm512_mul_ps(b11, v), _mm512_mul_ps(a11, y1));
+      z0 = _mm512_add_ps(z0, z1);
+      z1 = _mm512_sub_ps(_mm512_mul_ps(b12, v), _mm512_mul_ps(a12, y1));
+      __m512 y2 = _mm512_add_ps(_mm512_mul_ps(b20, y1), z2);
+      z2 = _mm512_sub_ps(_mm512_mul_ps(b21, y1), _mm512_mul_ps(a21, y2));
+      z2 = _mm512_add_ps(z2, z3);
+      z3 = _mm512_sub_ps(_mm512_mul_ps(b22, y1), _mm512_mul_ps(a22, y2));
+      ksq = _mm512_add_ps(ksq, _mm512_mul_ps(y2, y2));
+
+      for (int ph = 0; ph < ST_AUDIO_METER_TP_PHASES; ph++) {
+        __m512 t = _mm512_mul_ps(_mm512_set1_ps(coef->tp[ph][0]), v);
+        for (int j = 1; j < ST_AUDIO_METER_TP_TAPS; j++) {
+          __m512 h = _mm512_loadu_ps(p - (ptrdiff_t)j * channel);
+          t = _mm512_add_ps(t, _mm512_mul_ps(_mm512_set1_ps(coef->tp[ph][j]), h));
+        }
+        tp = _mm512_max_ps(tp, _mm512_abs_ps(t));
+      }
+    }
+
+    _mm512_storeu_ps(z + c, z0);
+    _mm512_storeu_ps(z + stride + c, z1);
+    _mm512_storeu_ps(z + stride * 2 + c, z2);
+    _mm512_storeu_ps(z + stride * 3 + c, z3);
+    _mm512_storeu_ps(acc + ST_AUDIO_METER_ACC_PEAK * stride + c, peak);
+    _mm512_storeu_ps(acc + ST_AUDIO_METER_ACC_TP * stride + c, tp);
+    _mm512_storeu_ps(acc + ST_AUDIO_METER_ACC_SQ * stride + c, sq);
+    _mm512_storeu_ps(acc + ST_AUDIO_METER_ACC_KSQ * stride + c, ksq);
+  }
+
+  return 0;
+}
+/* end st_audio_meter_rows_avx512 */
+
+/* begin st_anc_udw_pack_avx512 */
+/* the 40 bit group of 4 words in each 64 bit to 5 bytes of big endian */
+static uint8_t anc_udw_pack_shuffle_tbl_avx512[16] = {
+    4, 3, 2, 1, 0, 12, 11, 10, 9, 8, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+/* pack the 10 bytes(5 x 16 bit) of each 128 bit lane */
+static uint16_t anc_udw_pack_idx_avx512[32] = {
+    0,  1,  2,  3,  4,  8,  9,  10, 11, 12, 16, 17, 18, 19, 20, 24,
+    25, 26, 27, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+};
+
+static inline __mmask32 anc_udw_mask32_avx512(uint32_t cnt) {
+  return (cnt >= 32) ? 0xFFFFFFFF : (__mmask32)((1u << cnt) - 1);
+}
+
+/* the 8 bit values in 16 bit to the words, b8 the even parity and b9 the not of b8 */
+static inline __m512i anc_udw_parity_avx512(__m512i v) {
+  __m512i p = _mm512_xor_si512(v, _mm512_srli_epi16(v, 4));
+  p = _mm512_xor_si512(p, _mm512_srli_epi16(p, 2));
+  p = _mm512_xor_si512(p, _mm512_srli_epi16(p, 1));
+  p = _mm512_slli_epi16(_mm512_and_si512(p, _mm512_set1_epi16(1)), 8);
+  /* 0x200 for an even count of ones, 0x100 for odd */
+  return _mm512_or_si512(v, _mm512_sub_epi16(_mm512_set1_epi16(0x200), p));
+}
+
+static inline uint16_t anc_udw_hsum_avx512(__m512i acc) {
+  uint16_t lanes[32], sum = 0;
+
+  _mm512_storeu_si512(lanes, acc);
+  for (int k = 0; k < 32; k++) sum += lanes[k];
+  return sum;
+}
+
+int st_anc_udw_pack_avx512(const uint8_t* udw, uint32_t n, uint8_t* dst, uint16_t* sum) {
+  __m512i shuffle =
+      _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)anc_udw_pack_shuffle_tbl_avx512));
+  __m512i pack_idx = _mm512_loadu_si512(anc_udw_pack_idx_avx512);
+  /* w0 << 10 | w1 of each pair of words */
+  __m512i pair_mul = _mm512_set1_epi32(0x00010400);
+  __m512i acc = _mm512_setzero_si512();
+
+  if (n % 8) return -EINVAL;
+
+  for (uint32_t i = 0; i < n; i += 32) {
+    uint32_t cnt = RTE_MIN(n - i, 32);
+    uint32_t bytes = cnt / 4 * 5;
+    __mmask32 k = anc_udw_mask32_avx512(cnt);
+    __m512i w = _mm512_cvtepu8_epi16(_mm256_maskz_loadu_epi8(k, udw + i));
+    /* the zero bytes out of the mask are not words */
+    w = _mm512_maskz_mov_epi16(k, anc_udw_parity_avx512(w));
+    acc = _mm512_add_epi16(acc, w);
+
+    /* p01 << 20 | p23 of each group, the bits from 40 on are not stored */
+    __m512i p = _mm512_madd_epi16(w, pair_mul);
+    __m512i g = _mm512_or_si512(_mm512_slli_epi64(p, 20), _mm512_srli_epi64(p, 32));
+    __m512i out = _mm512_permutexvar_epi16(pack_idx, _mm512_shuffle_epi8(g, shuffle));
+    _mm512_mask_storeu_epi8(dst, (1ULL << bytes) - 1, out);
+    dst += bytes;
+  }
+
+  *sum = anc_udw_hsum_avx512(acc);
+  return 0;
+}
+/* end st_anc_udw_pack_avx512 */
+
+/* begin st_anc_udw_unpack_avx512 */
+/* the 10 bytes(5 x 16 bit) of each group of 8 words to a 128 bit lane */
+static uint16_t anc_udw_unpack_idx_avx512[32] = {
+    0,  1,  2,  3,  4,  4,  4,  4,  5,  6,  7,  8,  9,  9,  9,  9,
+    10, 11, 12, 13, 14, 14, 14, 14, 15, 16, 17, 18, 19, 19, 19, 19,
+};
+
+/* the 2 bytes holding each word of the 10 bytes, to 16 bit of little endian */
+static uint8_t anc_udw_unpack_shuffle_tbl_avx512[16] = {
+    1, 0, 2, 1, 3, 2, 4, 3, 6, 5, 7, 6, 8, 7, 9, 8,
+};
+
+int st_anc_udw_unpack_avx512(const uint8_t* src, uint32_t n, uint8_t* udw,
+                             uint16_t* sum, uint32_t* bad) {
+  __m512i lane_idx = _mm512_loadu_si512(anc_udw_unpack_idx_avx512);
+  __m512i shuffle = _mm512_broadcast_i32x4(
+      _mm_loadu_si128((__m128i*)anc_udw_unpack_shuffle_tbl_avx512));
+  /* shift left by the bit offset of the word in its 2 bytes, 0, 2, 4, 6 */
+  __m512i mul = _mm512_set1_epi64(0x0040001000040001);
+  __m512i low = _mm512_set1_epi16(0xFF);
+  __m512i acc = _mm512_setzero_si512();
+  uint32_t bad_cnt = 0;
+
+  if (n % 8) return -EINVAL;
+
+  for (uint32_t i = 0; i < n; i += 32) {
+    uint32_t cnt = RTE_MIN(n - i, 32);
+    uint32_t bytes = cnt / 4 * 5;
+    __mmask32 k = anc_udw_mask32_avx512(cnt);
+    __m512i b = _mm512_maskz_loadu_epi8((1ULL << bytes) - 1, src);
+    __m512i w = _mm512_shuffle_epi8(_mm512_permutexvar_epi16(lane_idx, b), shuffle);
+    w = _mm512_srli_epi16(_mm512_mullo_epi16(w, mul), 6);
+    w = _mm512_maskz_mov_epi16(k, w);
+
+    __m512i v = _mm512_and_si512(w, low);
+    __mmask32 fail = _mm512_mask_cmpneq_epi16_mask(k, w, anc_udw_parity_avx512(v));
+    bad_cnt += __builtin_popcount(fail);
+    acc = _mm512_add_epi16(acc, w);
+
+    if (udw) _mm256_mask_storeu_epi8(udw + i, k, _mm512_cvtepi16_epi8(v));
+    src += bytes;
+  }
+
+  *sum = anc_udw_hsum_avx512(acc);
+  *bad = bad_cnt;
+  return 0;
+}
+/* end st_anc_udw_unpack_avx512 */
+
 MT_TARGET_CODE_STOP
 #endif
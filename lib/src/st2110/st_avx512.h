@@ -5,6 +5,7 @@
 #ifndef _ST_LIB_AVX512_H_
 #define _ST_LIB_AVX512_H_
 
+#include "st30_pipeline_api.h"
 #include "st_main.h"
 
 int st20_rfc4175_422be10_to_yuv422p10le_avx512(struct st20_rfc4175_422_10_pg2_be* pg,
@@ -119,6 +120,16 @@ int st20_rfc4175_422be10_to_yuv420p8_avx512(struct st20_rfc4175_422_10_pg2_be* p
                                             uint8_t* y, uint8_t* b, uint8_t* r,
                                             uint32_t w, uint32_t h);
 
+int st20_rfc4175_422be10_to_nv12_avx512(struct st20_rfc4175_422_10_pg2_be* pg0,
+                                        struct st20_rfc4175_422_10_pg2_be* pg1,
+                                        uint8_t* y0, uint8_t* y1, uint8_t* uv,
+                                        uint32_t w);
+
+int st20_rfc4175_422be10_to_p010_avx512(struct st20_rfc4175_422_10_pg2_be* pg0,
+                                        struct st20_rfc4175_422_10_pg2_be* pg1,
+                                        uint16_t* y0, uint16_t* y1, uint16_t* uv,
+                                        uint32_t w);
+
 int st20_rfc4175_422be10_to_yuv422p16le_avx512(struct st20_rfc4175_422_10_pg2_be* pg,
                                                uint16_t* y, uint16_t* b, uint16_t* r,
                                                uint32_t w, uint32_t h);
@@ -127,4 +138,31 @@ int st20_yuv422p16le_to_rfc4175_422be10_avx512(uint16_t* y, uint16_t* b, uint16_
                                                struct st20_rfc4175_422_10_pg2_be* pg,
                                                uint32_t w, uint32_t h);
 
-#endif
\ No newline at end of file
+int st_pcm_to_app_avx512(const uint8_t* src, void* dst, uint32_t n, enum st30_fmt fmt,
+                         enum st30p_sample_fmt app_fmt);
+
+int st_pcm_gather_to_app_avx512(const uint8_t* base, const int32_t* offset, uint32_t n,
+                                uint32_t limit, void* dst, enum st30_fmt fmt,
+                                enum st30p_sample_fmt app_fmt);
+
+int st_pcm_to_wire_avx512(const void* src, uint8_t* dst, uint32_t n, enum st30_fmt fmt,
+                          enum st30p_sample_fmt app_fmt);
+
+int st_pcm_gather_to_wire_avx512(const void* base, const int32_t* idx, uint32_t n,
+                                 uint8_t* dst, enum st30_fmt fmt,
+                                 enum st30p_sample_fmt app_fmt);
+
+int st_audio_scatter_rows_avx512(const uint8_t* src, uint32_t src_row, uint32_t rows,
+                                 uint8_t* dst, uint32_t dst_stride);
+
+int st_audio_meter_rows_avx512(const struct st_audio_meter_coef* coef, const float* x,
+                               uint32_t rows, uint16_t channel, uint16_t stride, float* z,
+                               float* acc);
+
+/* n(a multiple of 8) udw from the 8 bit values to dst of a 4 words boundary */
+int st_anc_udw_pack_avx512(const uint8_t* udw, uint32_t n, uint8_t* dst, uint16_t* sum);
+
+int st_anc_udw_unpack_avx512(const uint8_t* src, uint32_t n, uint8_t* udw,
+                             uint16_t* sum, uint32_t* bad);
+
+#endif
@@ -38,7 +38,8 @@ static bool has_lines_padding(struct st_frame* src, struct st_frame* dst) {
 }
 
 static int convert_rfc4175_422be10_to_yuv422p10le(struct st_frame* src,
-                                                  struct st_frame* dst) {
+                                                  struct st_frame* dst,
+                                                  enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
   uint16_t* y = NULL;
@@ -51,20 +52,21 @@ static int convert_rfc4175_422be10_to_yuv422p10le(struct st_frame* src,
     y = dst->addr[0];
     b = dst->addr[1];
     r = dst->addr[2];
-    ret = st20_rfc4175_422be10_to_yuv422p10le(be10, y, b, r, dst->width, h);
+    ret = st20_rfc4175_422be10_to_yuv422p10le_simd(be10, y, b, r, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       be10 = src->addr[0] + src->linesize[0] * line;
       y = dst->addr[0] + dst->linesize[0] * line;
       b = dst->addr[1] + dst->linesize[1] * line;
       r = dst->addr[2] + dst->linesize[2] * line;
-      ret = st20_rfc4175_422be10_to_yuv422p10le(be10, y, b, r, dst->width, 1);
+      ret = st20_rfc4175_422be10_to_yuv422p10le_simd(be10, y, b, r, dst->width, 1, level);
     }
   }
   return ret;
 }
 
-static int convert_rfc4175_422be10_to_422le8(struct st_frame* src, struct st_frame* dst) {
+static int convert_rfc4175_422be10_to_422le8(struct st_frame* src, struct st_frame* dst,
+                                             enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
   struct st20_rfc4175_422_8_pg2_le* le8 = NULL;
@@ -73,19 +75,19 @@ static int convert_rfc4175_422be10_to_422le8(struct st_frame* src, struct st_fra
   if (!has_lines_padding(src, dst)) {
     be10 = src->addr[0];
     le8 = dst->addr[0];
-    ret = st20_rfc4175_422be10_to_422le8(be10, le8, dst->width, h);
+    ret = st20_rfc4175_422be10_to_422le8_simd(be10, le8, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       be10 = src->addr[0] + src->linesize[0] * line;
       le8 = dst->addr[0] + dst->linesize[0] * line;
-      ret = st20_rfc4175_422be10_to_422le8(be10, le8, dst->width, 1);
+      ret = st20_rfc4175_422be10_to_422le8_simd(be10, le8, dst->width, 1, level);
     }
   }
   return ret;
 }
 
-static int convert_rfc4175_422be10_to_yuv422p8(struct st_frame* src,
-                                               struct st_frame* dst) {
+static int convert_rfc4175_422be10_to_yuv422p8(struct st_frame* src, struct st_frame* dst,
+                                               enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
   uint8_t* y = NULL;
@@ -98,21 +100,21 @@ static int convert_rfc4175_422be10_to_yuv422p8(struct st_frame* src,
     y = dst->addr[0];
     b = dst->addr[1];
     r = dst->addr[2];
-    ret = st20_rfc4175_422be10_to_yuv422p8(be10, y, b, r, dst->width, h);
+    ret = st20_rfc4175_422be10_to_yuv422p8_simd(be10, y, b, r, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       be10 = src->addr[0] + src->linesize[0] * line;
       y = dst->addr[0] + dst->linesize[0] * line;
       b = dst->addr[1] + dst->linesize[1] * line;
       r = dst->addr[2] + dst->linesize[2] * line;
-      ret = st20_rfc4175_422be10_to_yuv422p8(be10, y, b, r, dst->width, 1);
+      ret = st20_rfc4175_422be10_to_yuv422p8_simd(be10, y, b, r, dst->width, 1, level);
     }
   }
   return ret;
 }
 
-static int convert_rfc4175_422be10_to_yuv420p8(struct st_frame* src,
-                                               struct st_frame* dst) {
+static int convert_rfc4175_422be10_to_yuv420p8(struct st_frame* src, struct st_frame* dst,
+                                               enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
   uint8_t* y = NULL;
@@ -125,20 +127,74 @@ static int convert_rfc4175_422be10_to_yuv420p8(struct st_frame* src,
     y = dst->addr[0];
     b = dst->addr[1];
     r = dst->addr[2];
-    ret = st20_rfc4175_422be10_to_yuv420p8(be10, y, b, r, dst->width, h);
+    ret = st20_rfc4175_422be10_to_yuv420p8_simd(be10, y, b, r, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       be10 = src->addr[0] + src->linesize[0] * line;
       y = dst->addr[0] + dst->linesize[0] * line;
       b = dst->addr[1] + dst->linesize[1] * line;
       r = dst->addr[2] + dst->linesize[2] * line;
-      ret = st20_rfc4175_422be10_to_yuv420p8(be10, y, b, r, dst->width, 1);
+      ret = st20_rfc4175_422be10_to_yuv420p8_simd(be10, y, b, r, dst->width, 1, level);
+    }
+  }
+  return ret;
+}
+
+static int convert_rfc4175_422be10_to_nv12(struct st_frame* src, struct st_frame* dst,
+                                           enum mtl_simd_level level) {
+  int ret = 0;
+  struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
+  uint8_t* y = NULL;
+  uint8_t* uv = NULL;
+  uint32_t h = st_frame_data_height(dst);
+
+  if (!has_lines_padding(src, dst)) {
+    be10 = src->addr[0];
+    y = dst->addr[0];
+    uv = dst->addr[1];
+    ret = st20_rfc4175_422be10_to_nv12_simd(be10, y, uv, dst->width, h, level);
+  } else {
+    for (uint32_t line = 0; line + 1 < h; line += 2) {
+      be10 = src->addr[0] + src->linesize[0] * line;
+      y = dst->addr[0] + dst->linesize[0] * line;
+      uv = dst->addr[1] + dst->linesize[1] * (line / 2);
+      ret = st20_rfc4175_422be10_to_nv12_pair_simd(
+          be10, src->addr[0] + src->linesize[0] * (line + 1), y, y + dst->linesize[0], uv,
+          dst->width, level);
     }
   }
   return ret;
 }
 
-static int convert_rfc4175_422be10_to_v210(struct st_frame* src, struct st_frame* dst) {
+static int convert_rfc4175_422be10_to_p010(struct st_frame* src, struct st_frame* dst,
+                                           enum mtl_simd_level level) {
+  int ret = 0;
+  struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
+  uint8_t* y = NULL;
+  uint8_t* uv = NULL;
+  uint32_t h = st_frame_data_height(dst);
+
+  if (!has_lines_padding(src, dst)) {
+    be10 = src->addr[0];
+    y = dst->addr[0];
+    uv = dst->addr[1];
+    ret = st20_rfc4175_422be10_to_p010_simd(be10, (uint16_t*)y, (uint16_t*)uv, dst->width,
+                                            h, level);
+  } else {
+    for (uint32_t line = 0; line + 1 < h; line += 2) {
+      be10 = src->addr[0] + src->linesize[0] * line;
+      y = dst->addr[0] + dst->linesize[0] * line;
+      uv = dst->addr[1] + dst->linesize[1] * (line / 2);
+      ret = st20_rfc4175_422be10_to_p010_pair_simd(
+          be10, src->addr[0] + src->linesize[0] * (line + 1), (uint16_t*)y,
+          (uint16_t*)(y + dst->linesize[0]), (uint16_t*)uv, dst->width, level);
+    }
+  }
+  return ret;
+}
+
+static int convert_rfc4175_422be10_to_v210(struct st_frame* src, struct st_frame* dst,
+                                           enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
   uint8_t* v210 = NULL;
@@ -147,18 +203,19 @@ static int convert_rfc4175_422be10_to_v210(struct st_frame* src, struct st_frame
   if (!has_lines_padding(src, dst)) {
     be10 = src->addr[0];
     v210 = dst->addr[0];
-    ret = st20_rfc4175_422be10_to_v210(be10, v210, dst->width, h);
+    ret = st20_rfc4175_422be10_to_v210_simd(be10, v210, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       be10 = src->addr[0] + src->linesize[0] * line;
       v210 = dst->addr[0] + dst->linesize[0] * line;
-      ret = st20_rfc4175_422be10_to_v210(be10, v210, dst->width, 1);
+      ret = st20_rfc4175_422be10_to_v210_simd(be10, v210, dst->width, 1, level);
     }
   }
   return ret;
 }
 
-static int convert_rfc4175_422be10_to_y210(struct st_frame* src, struct st_frame* dst) {
+static int convert_rfc4175_422be10_to_y210(struct st_frame* src, struct st_frame* dst,
+                                           enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
   uint16_t* y210 = NULL;
@@ -167,19 +224,20 @@ static int convert_rfc4175_422be10_to_y210(struct st_frame* src, struct st_frame
   if (!has_lines_padding(src, dst)) {
     be10 = src->addr[0];
     y210 = dst->addr[0];
-    ret = st20_rfc4175_422be10_to_y210(be10, y210, dst->width, h);
+    ret = st20_rfc4175_422be10_to_y210_simd(be10, y210, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       be10 = src->addr[0] + src->linesize[0] * line;
       y210 = dst->addr[0] + dst->linesize[0] * line;
-      ret = st20_rfc4175_422be10_to_y210(be10, y210, dst->width, 1);
+      ret = st20_rfc4175_422be10_to_y210_simd(be10, y210, dst->width, 1, level);
     }
   }
   return ret;
 }
 
 static int convert_rfc4175_422be12_to_yuv422p12le(struct st_frame* src,
-                                                  struct st_frame* dst) {
+                                                  struct st_frame* dst,
+                                                  enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_422_12_pg2_be* be12 = NULL;
   uint16_t* y = NULL;
@@ -192,21 +250,22 @@ static int convert_rfc4175_422be12_to_yuv422p12le(struct st_frame* src,
     y = dst->addr[0];
     b = dst->addr[1];
     r = dst->addr[2];
-    ret = st20_rfc4175_422be12_to_yuv422p12le(be12, y, b, r, dst->width, h);
+    ret = st20_rfc4175_422be12_to_yuv422p12le_simd(be12, y, b, r, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       be12 = src->addr[0] + src->linesize[0] * line;
       y = dst->addr[0] + dst->linesize[0] * line;
       b = dst->addr[1] + dst->linesize[1] * line;
       r = dst->addr[2] + dst->linesize[2] * line;
-      ret = st20_rfc4175_422be12_to_yuv422p12le(be12, y, b, r, dst->width, 1);
+      ret = st20_rfc4175_422be12_to_yuv422p12le_simd(be12, y, b, r, dst->width, 1, level);
     }
   }
   return ret;
 }
 
 static int convert_rfc4175_444be10_to_yuv444p10le(struct st_frame* src,
-                                                  struct st_frame* dst) {
+                                                  struct st_frame* dst,
+                                                  enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_444_10_pg4_be* be10 = NULL;
   uint16_t* y = NULL;
@@ -219,21 +278,21 @@ static int convert_rfc4175_444be10_to_yuv444p10le(struct st_frame* src,
     y = dst->addr[0];
     b = dst->addr[1];
     r = dst->addr[2];
-    ret = st20_rfc4175_444be10_to_yuv444p10le(be10, y, b, r, dst->width, h);
+    ret = st20_rfc4175_444be10_to_444p10le_simd(be10, y, b, r, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       be10 = src->addr[0] + src->linesize[0] * line;
       y = dst->addr[0] + dst->linesize[0] * line;
       b = dst->addr[1] + dst->linesize[1] * line;
       r = dst->addr[2] + dst->linesize[2] * line;
-      ret = st20_rfc4175_444be10_to_yuv444p10le(be10, y, b, r, dst->width, 1);
+      ret = st20_rfc4175_444be10_to_444p10le_simd(be10, y, b, r, dst->width, 1, level);
     }
   }
   return ret;
 }
 
-static int convert_rfc4175_444be10_to_gbrp10le(struct st_frame* src,
-                                               struct st_frame* dst) {
+static int convert_rfc4175_444be10_to_gbrp10le(struct st_frame* src, struct st_frame* dst,
+                                               enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_444_10_pg4_be* be10 = NULL;
   uint16_t* g = NULL;
@@ -246,21 +305,22 @@ static int convert_rfc4175_444be10_to_gbrp10le(struct st_frame* src,
     g = dst->addr[0];
     b = dst->addr[1];
     r = dst->addr[2];
-    ret = st20_rfc4175_444be10_to_gbrp10le(be10, g, b, r, dst->width, h);
+    ret = st20_rfc4175_444be10_to_444p10le_simd(be10, g, r, b, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       be10 = src->addr[0] + src->linesize[0] * line;
       g = dst->addr[0] + dst->linesize[0] * line;
       b = dst->addr[1] + dst->linesize[1] * line;
       r = dst->addr[2] + dst->linesize[2] * line;
-      ret = st20_rfc4175_444be10_to_gbrp10le(be10, g, b, r, dst->width, 1);
+      ret = st20_rfc4175_444be10_to_444p10le_simd(be10, g, r, b, dst->width, 1, level);
     }
   }
   return ret;
 }
 
 static int convert_rfc4175_444be12_to_yuv444p12le(struct st_frame* src,
-                                                  struct st_frame* dst) {
+                                                  struct st_frame* dst,
+                                                  enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_444_12_pg2_be* be12 = NULL;
   uint16_t* y = NULL;
@@ -273,21 +333,21 @@ static int convert_rfc4175_444be12_to_yuv444p12le(struct st_frame* src,
     y = dst->addr[0];
     b = dst->addr[1];
     r = dst->addr[2];
-    ret = st20_rfc4175_444be12_to_yuv444p12le(be12, y, b, r, dst->width, h);
+    ret = st20_rfc4175_444be12_to_444p12le_simd(be12, y, b, r, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       be12 = src->addr[0] + src->linesize[0] * line;
       y = dst->addr[0] + dst->linesize[0] * line;
       b = dst->addr[1] + dst->linesize[1] * line;
       r = dst->addr[2] + dst->linesize[2] * line;
-      ret = st20_rfc4175_444be12_to_yuv444p12le(be12, y, b, r, dst->width, 1);
+      ret = st20_rfc4175_444be12_to_444p12le_simd(be12, y, b, r, dst->width, 1, level);
     }
   }
   return ret;
 }
 
-static int convert_rfc4175_444be12_to_gbrp12le(struct st_frame* src,
-                                               struct st_frame* dst) {
+static int convert_rfc4175_444be12_to_gbrp12le(struct st_frame* src, struct st_frame* dst,
+                                               enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_444_12_pg2_be* be12 = NULL;
   uint16_t* g = NULL;
@@ -300,21 +360,22 @@ static int convert_rfc4175_444be12_to_gbrp12le(struct st_frame* src,
     g = dst->addr[0];
     b = dst->addr[1];
     r = dst->addr[2];
-    ret = st20_rfc4175_444be12_to_gbrp12le(be12, g, b, r, dst->width, h);
+    ret = st20_rfc4175_444be12_to_444p12le_simd(be12, g, r, b, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       be12 = src->addr[0] + src->linesize[0] * line;
       g = dst->addr[0] + dst->linesize[0] * line;
       b = dst->addr[1] + dst->linesize[1] * line;
       r = dst->addr[2] + dst->linesize[2] * line;
-      ret = st20_rfc4175_444be12_to_gbrp12le(be12, g, b, r, dst->width, 1);
+      ret = st20_rfc4175_444be12_to_444p12le_simd(be12, g, r, b, dst->width, 1, level);
     }
   }
   return ret;
 }
 
 static int convert_yuv422p10le_to_rfc4175_422be10(struct st_frame* src,
-                                                  struct st_frame* dst) {
+                                                  struct st_frame* dst,
+                                                  enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
   uint16_t* y = NULL;
@@ -327,20 +388,21 @@ static int convert_yuv422p10le_to_rfc4175_422be10(struct st_frame* src,
     b = src->addr[1];
     r = src->addr[2];
     be10 = dst->addr[0];
-    ret = st20_yuv422p10le_to_rfc4175_422be10(y, b, r, be10, dst->width, h);
+    ret = st20_yuv422p10le_to_rfc4175_422be10_simd(y, b, r, be10, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       y = src->addr[0] + src->linesize[0] * line;
       b = src->addr[1] + src->linesize[1] * line;
       r = src->addr[2] + src->linesize[2] * line;
       be10 = dst->addr[0] + dst->linesize[0] * line;
-      ret = st20_yuv422p10le_to_rfc4175_422be10(y, b, r, be10, dst->width, 1);
+      ret = st20_yuv422p10le_to_rfc4175_422be10_simd(y, b, r, be10, dst->width, 1, level);
     }
   }
   return ret;
 }
 
-static int convert_v210_to_rfc4175_422be10(struct st_frame* src, struct st_frame* dst) {
+static int convert_v210_to_rfc4175_422be10(struct st_frame* src, struct st_frame* dst,
+                                           enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
   uint8_t* v210 = NULL;
@@ -349,18 +411,19 @@ static int convert_v210_to_rfc4175_422be10(struct st_frame* src, struct st_frame
   if (!has_lines_padding(src, dst)) {
     v210 = src->addr[0];
     be10 = dst->addr[0];
-    ret = st20_v210_to_rfc4175_422be10(v210, be10, dst->width, h);
+    ret = st20_v210_to_rfc4175_422be10_simd(v210, be10, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       v210 = src->addr[0] + src->linesize[0] * line;
       be10 = dst->addr[0] + dst->linesize[0] * line;
-      ret = st20_v210_to_rfc4175_422be10(v210, be10, dst->width, 1);
+      ret = st20_v210_to_rfc4175_422be10_simd(v210, be10, dst->width, 1, level);
     }
   }
   return ret;
 }
 
-static int convert_y210_to_rfc4175_422be10(struct st_frame* src, struct st_frame* dst) {
+static int convert_y210_to_rfc4175_422be10(struct st_frame* src, struct st_frame* dst,
+                                           enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
   uint16_t* y210 = NULL;
@@ -369,19 +432,20 @@ static int convert_y210_to_rfc4175_422be10(struct st_frame* src, struct st_frame
   if (!has_lines_padding(src, dst)) {
     y210 = src->addr[0];
     be10 = dst->addr[0];
-    ret = st20_y210_to_rfc4175_422be10(y210, be10, dst->width, h);
+    ret = st20_y210_to_rfc4175_422be10_simd(y210, be10, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       y210 = src->addr[0] + src->linesize[0] * line;
       be10 = dst->addr[0] + dst->linesize[0] * line;
-      ret = st20_y210_to_rfc4175_422be10(y210, be10, dst->width, 1);
+      ret = st20_y210_to_rfc4175_422be10_simd(y210, be10, dst->width, 1, level);
     }
   }
   return ret;
 }
 
 static int convert_yuv422p12le_to_rfc4175_422be12(struct st_frame* src,
-                                                  struct st_frame* dst) {
+                                                  struct st_frame* dst,
+                                                  enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_422_12_pg2_be* be12 = NULL;
   uint16_t* y = NULL;
@@ -394,21 +458,22 @@ static int convert_yuv422p12le_to_rfc4175_422be12(struct st_frame* src,
     y = src->addr[0];
     b = src->addr[1];
     r = src->addr[2];
-    ret = st20_yuv422p12le_to_rfc4175_422be12(y, b, r, be12, dst->width, h);
+    ret = st20_yuv422p12le_to_rfc4175_422be12_simd(y, b, r, be12, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       be12 = dst->addr[0] + dst->linesize[0] * line;
       y = src->addr[0] + src->linesize[0] * line;
       b = src->addr[1] + src->linesize[1] * line;
       r = src->addr[2] + src->linesize[2] * line;
-      ret = st20_yuv422p12le_to_rfc4175_422be12(y, b, r, be12, dst->width, 1);
+      ret = st20_yuv422p12le_to_rfc4175_422be12_simd(y, b, r, be12, dst->width, 1, level);
     }
   }
   return ret;
 }
 
 static int convert_yuv444p10le_to_rfc4175_444be10(struct st_frame* src,
-                                                  struct st_frame* dst) {
+                                                  struct st_frame* dst,
+                                                  enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_444_10_pg4_be* be10 = NULL;
   uint16_t* y = NULL;
@@ -421,21 +486,21 @@ static int convert_yuv444p10le_to_rfc4175_444be10(struct st_frame* src,
     y = src->addr[0];
     b = src->addr[1];
     r = src->addr[2];
-    ret = st20_yuv444p10le_to_rfc4175_444be10(y, b, r, be10, dst->width, h);
+    ret = st20_444p10le_to_rfc4175_444be10_simd(y, b, r, be10, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       be10 = dst->addr[0] + dst->linesize[0] * line;
       y = src->addr[0] + src->linesize[0] * line;
       b = src->addr[1] + src->linesize[1] * line;
       r = src->addr[2] + src->linesize[2] * line;
-      ret = st20_yuv444p10le_to_rfc4175_444be10(y, b, r, be10, dst->width, 1);
+      ret = st20_444p10le_to_rfc4175_444be10_simd(y, b, r, be10, dst->width, 1, level);
     }
   }
   return ret;
 }
 
-static int convert_gbrp10le_to_rfc4175_444be10(struct st_frame* src,
-                                               struct st_frame* dst) {
+static int convert_gbrp10le_to_rfc4175_444be10(struct st_frame* src, struct st_frame* dst,
+                                               enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_444_10_pg4_be* be10 = NULL;
   uint16_t* g = NULL;
@@ -448,21 +513,22 @@ static int convert_gbrp10le_to_rfc4175_444be10(struct st_frame* src,
     g = src->addr[0];
     b = src->addr[1];
     r = src->addr[2];
-    ret = st20_gbrp10le_to_rfc4175_444be10(g, b, r, be10, dst->width, h);
+    ret = st20_444p10le_to_rfc4175_444be10_simd(g, r, b, be10, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       be10 = dst->addr[0] + dst->linesize[0] * line;
       g = src->addr[0] + src->linesize[0] * line;
       b = src->addr[1] + src->linesize[1] * line;
       r = src->addr[2] + src->linesize[2] * line;
-      ret = st20_gbrp10le_to_rfc4175_444be10(g, b, r, be10, dst->width, 1);
+      ret = st20_444p10le_to_rfc4175_444be10_simd(g, r, b, be10, dst->width, 1, level);
     }
   }
   return ret;
 }
 
 static int convert_yuv444p12le_to_rfc4175_444be12(struct st_frame* src,
-                                                  struct st_frame* dst) {
+                                                  struct st_frame* dst,
+                                                  enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_444_12_pg2_be* be12 = NULL;
   uint16_t* y = NULL;
@@ -475,21 +541,21 @@ static int convert_yuv444p12le_to_rfc4175_444be12(struct st_frame* src,
     y = src->addr[0];
     b = src->addr[1];
     r = src->addr[2];
-    ret = st20_yuv444p12le_to_rfc4175_444be12(y, b, r, be12, dst->width, h);
+    ret = st20_444p12le_to_rfc4175_444be12_simd(y, b, r, be12, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       be12 = dst->addr[0] + dst->linesize[0] * line;
       y = src->addr[0] + src->linesize[0] * line;
       b = src->addr[1] + src->linesize[1] * line;
       r = src->addr[2] + src->linesize[2] * line;
-      ret = st20_yuv444p12le_to_rfc4175_444be12(y, b, r, be12, dst->width, 1);
+      ret = st20_444p12le_to_rfc4175_444be12_simd(y, b, r, be12, dst->width, 1, level);
     }
   }
   return ret;
 }
 
-static int convert_gbrp12le_to_rfc4175_444be12(struct st_frame* src,
-                                               struct st_frame* dst) {
+static int convert_gbrp12le_to_rfc4175_444be12(struct st_frame* src, struct st_frame* dst,
+                                               enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_444_12_pg2_be* be12 = NULL;
   uint16_t* g = NULL;
@@ -502,14 +568,14 @@ static int convert_gbrp12le_to_rfc4175_444be12(struct st_frame* src,
     g = src->addr[0];
     b = src->addr[1];
     r = src->addr[2];
-    ret = st20_gbrp12le_to_rfc4175_444be12(g, b, r, be12, dst->width, h);
+    ret = st20_444p12le_to_rfc4175_444be12_simd(g, r, b, be12, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       be12 = dst->addr[0] + dst->linesize[0] * line;
       g = src->addr[0] + src->linesize[0] * line;
       b = src->addr[1] + src->linesize[1] * line;
       r = src->addr[2] + src->linesize[2] * line;
-      ret = st20_gbrp12le_to_rfc4175_444be12(g, b, r, be12, dst->width, 1);
+      ret = st20_444p12le_to_rfc4175_444be12_simd(g, r, b, be12, dst->width, 1, level);
     }
   }
   return ret;
@@ -517,7 +583,8 @@ static int convert_gbrp12le_to_rfc4175_444be12(struct st_frame* src,
 
 // 10bit with 6bit padding
 static int convert_rfc4175_422be10_to_yuv422p16le(struct st_frame* src,
-                                                  struct st_frame* dst) {
+                                                  struct st_frame* dst,
+                                                  enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
   uint16_t* y = NULL;
@@ -530,21 +597,22 @@ static int convert_rfc4175_422be10_to_yuv422p16le(struct st_frame* src,
     y = dst->addr[0];
     b = dst->addr[1];
     r = dst->addr[2];
-    ret = st20_rfc4175_422be10_to_yuv422p16le(be10, y, b, r, dst->width, h);
+    ret = st20_rfc4175_422be10_to_yuv422p16le_simd(be10, y, b, r, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       be10 = src->addr[0] + src->linesize[0] * line;
       y = dst->addr[0] + dst->linesize[0] * line;
       b = dst->addr[1] + dst->linesize[1] * line;
       r = dst->addr[2] + dst->linesize[2] * line;
-      ret = st20_rfc4175_422be10_to_yuv422p16le(be10, y, b, r, dst->width, 1);
+      ret = st20_rfc4175_422be10_to_yuv422p16le_simd(be10, y, b, r, dst->width, 1, level);
     }
   }
   return ret;
 }
 
 static int convert_yuv422p16le_to_rfc4175_422be10(struct st_frame* src,
-                                                  struct st_frame* dst) {
+                                                  struct st_frame* dst,
+                                                  enum mtl_simd_level level) {
   int ret = 0;
   struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
   uint16_t* y = NULL;
@@ -557,14 +625,14 @@ static int convert_yuv422p16le_to_rfc4175_422be10(struct st_frame* src,
     b = src->addr[1];
     r = src->addr[2];
     be10 = dst->addr[0];
-    ret = st20_yuv422p16le_to_rfc4175_422be10(y, b, r, be10, dst->width, h);
+    ret = st20_yuv422p16le_to_rfc4175_422be10_simd(y, b, r, be10, dst->width, h, level);
   } else {
     for (uint32_t line = 0; line < h; line++) {
       y = src->addr[0] + src->linesize[0] * line;
       b = src->addr[1] + src->linesize[1] * line;
       r = src->addr[2] + src->linesize[2] * line;
       be10 = dst->addr[0] + dst->linesize[0] * line;
-      ret = st20_yuv422p16le_to_rfc4175_422be10(y, b, r, be10, dst->width, 1);
+      ret = st20_yuv422p16le_to_rfc4175_422be10_simd(y, b, r, be10, dst->width, 1, level);
     }
   }
   return ret;
@@ -668,107 +736,117 @@ static const struct st_frame_converter converters[] = {
     {
         .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
         .dst_fmt = ST_FRAME_FMT_YUV422PLANAR10LE,
-        .convert_func = convert_rfc4175_422be10_to_yuv422p10le,
+        .convert_simd_func = convert_rfc4175_422be10_to_yuv422p10le,
     },
     {
         .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
         .dst_fmt = ST_FRAME_FMT_UYVY,
-        .convert_func = convert_rfc4175_422be10_to_422le8,
+        .convert_simd_func = convert_rfc4175_422be10_to_422le8,
     },
     {
         .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
         .dst_fmt = ST_FRAME_FMT_YUV422PLANAR8,
-        .convert_func = convert_rfc4175_422be10_to_yuv422p8,
+        .convert_simd_func = convert_rfc4175_422be10_to_yuv422p8,
     },
     {
         .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
         .dst_fmt = ST_FRAME_FMT_YUV420PLANAR8,
-        .convert_func = convert_rfc4175_422be10_to_yuv420p8,
+        .convert_simd_func = convert_rfc4175_422be10_to_yuv420p8,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .dst_fmt = ST_FRAME_FMT_NV12,
+        .convert_simd_func = convert_rfc4175_422be10_to_nv12,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .dst_fmt = ST_FRAME_FMT_P010,
+        .convert_simd_func = convert_rfc4175_422be10_to_p010,
     },
     {
         .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
         .dst_fmt = ST_FRAME_FMT_V210,
-        .convert_func = convert_rfc4175_422be10_to_v210,
+        .convert_simd_func = convert_rfc4175_422be10_to_v210,
     },
     {
         .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
         .dst_fmt = ST_FRAME_FMT_Y210,
-        .convert_func = convert_rfc4175_422be10_to_y210,
+        .convert_simd_func = convert_rfc4175_422be10_to_y210,
     },
     {
         .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE12,
         .dst_fmt = ST_FRAME_FMT_YUV422PLANAR12LE,
-        .convert_func = convert_rfc4175_422be12_to_yuv422p12le,
+        .convert_simd_func = convert_rfc4175_422be12_to_yuv422p12le,
     },
     {
         .src_fmt = ST_FRAME_FMT_YUV444RFC4175PG4BE10,
         .dst_fmt = ST_FRAME_FMT_YUV444PLANAR10LE,
-        .convert_func = convert_rfc4175_444be10_to_yuv444p10le,
+        .convert_simd_func = convert_rfc4175_444be10_to_yuv444p10le,
     },
     {
         .src_fmt = ST_FRAME_FMT_YUV444RFC4175PG2BE12,
         .dst_fmt = ST_FRAME_FMT_YUV444PLANAR12LE,
-        .convert_func = convert_rfc4175_444be12_to_yuv444p12le,
+        .convert_simd_func = convert_rfc4175_444be12_to_yuv444p12le,
     },
     {
         .src_fmt = ST_FRAME_FMT_RGBRFC4175PG4BE10,
         .dst_fmt = ST_FRAME_FMT_GBRPLANAR10LE,
-        .convert_func = convert_rfc4175_444be10_to_gbrp10le,
+        .convert_simd_func = convert_rfc4175_444be10_to_gbrp10le,
     },
     {
         .src_fmt = ST_FRAME_FMT_RGBRFC4175PG2BE12,
         .dst_fmt = ST_FRAME_FMT_GBRPLANAR12LE,
-        .convert_func = convert_rfc4175_444be12_to_gbrp12le,
+        .convert_simd_func = convert_rfc4175_444be12_to_gbrp12le,
     },
     {
         .src_fmt = ST_FRAME_FMT_YUV422PLANAR10LE,
         .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
-        .convert_func = convert_yuv422p10le_to_rfc4175_422be10,
+        .convert_simd_func = convert_yuv422p10le_to_rfc4175_422be10,
     },
     {
         .src_fmt = ST_FRAME_FMT_V210,
         .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
-        .convert_func = convert_v210_to_rfc4175_422be10,
+        .convert_simd_func = convert_v210_to_rfc4175_422be10,
     },
     {
         .src_fmt = ST_FRAME_FMT_Y210,
         .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
-        .convert_func = convert_y210_to_rfc4175_422be10,
+        .convert_simd_func = convert_y210_to_rfc4175_422be10,
     },
     {
         .src_fmt = ST_FRAME_FMT_YUV422PLANAR12LE,
         .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE12,
-        .convert_func = convert_yuv422p12le_to_rfc4175_422be12,
+        .convert_simd_func = convert_yuv422p12le_to_rfc4175_422be12,
     },
     {
         .src_fmt = ST_FRAME_FMT_YUV444PLANAR10LE,
         .dst_fmt = ST_FRAME_FMT_YUV444RFC4175PG4BE10,
-        .convert_func = convert_yuv444p10le_to_rfc4175_444be10,
+        .convert_simd_func = convert_yuv444p10le_to_rfc4175_444be10,
     },
     {
         .src_fmt = ST_FRAME_FMT_YUV444PLANAR12LE,
         .dst_fmt = ST_FRAME_FMT_YUV444RFC4175PG2BE12,
-        .convert_func = convert_yuv444p12le_to_rfc4175_444be12,
+        .convert_simd_func = convert_yuv444p12le_to_rfc4175_444be12,
     },
     {
         .src_fmt = ST_FRAME_FMT_GBRPLANAR10LE,
         .dst_fmt = ST_FRAME_FMT_RGBRFC4175PG4BE10,
-        .convert_func = convert_gbrp10le_to_rfc4175_444be10,
+        .convert_simd_func = convert_gbrp10le_to_rfc4175_444be10,
     },
     {
         .src_fmt = ST_FRAME_FMT_GBRPLANAR12LE,
         .dst_fmt = ST_FRAME_FMT_RGBRFC4175PG2BE12,
-        .convert_func = convert_gbrp12le_to_rfc4175_444be12,
+        .convert_simd_func = convert_gbrp12le_to_rfc4175_444be12,
     },
     {
         .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
         .dst_fmt = ST_FRAME_FMT_YUV422PLANAR16LE,
-        .convert_func = convert_rfc4175_422be10_to_yuv422p16le,
+        .convert_simd_func = convert_rfc4175_422be10_to_yuv422p16le,
     },
     {
         .src_fmt = ST_FRAME_FMT_YUV422PLANAR16LE,
         .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
-        .convert_func = convert_yuv422p16le_to_rfc4175_422be10,
+        .convert_simd_func = convert_yuv422p16le_to_rfc4175_422be10,
     },
 };
 
@@ -783,7 +861,61 @@ int st_frame_convert(struct st_frame* src, struct st_frame* dst) {
     err("%s, get converter fail\n", __func__);
     return -EINVAL;
   }
-  return converter.convert_func(src, dst);
+  return st_frame_converter_convert(&converter, src, dst);
+}
+
+int st_frame_convert_simd(struct st_frame* src, struct st_frame* dst,
+                          enum mtl_simd_level level) {
+  if (src->width != dst->width || src->height != dst->height) {
+    err("%s, width/height mismatch, source: %u x %u, dest: %u x %u\n", __func__,
+        src->width, src->height, dst->width, dst->height);
+    return -EINVAL;
+  }
+  if (level >= MTL_SIMD_LEVEL_MAX) {
+    err("%s, invalid simd level %d\n", __func__, level);
+    return -EINVAL;
+  }
+  struct st_frame_converter converter;
+  if (st_frame_get_converter(src->fmt, dst->fmt, &converter) < 0) {
+    err("%s, get converter fail\n", __func__);
+    return -EINVAL;
+  }
+  converter.simd_level = level;
+  return st_frame_converter_convert(&converter, src, dst);
+}
+
+int st_frame_converter_query(uint32_t idx, enum st_frame_fmt* src_fmt,
+                             enum st_frame_fmt* dst_fmt) {
+  if (idx >= MTL_ARRAY_SIZE(converters)) return -ENOENT;
+  *src_fmt = converters[idx].src_fmt;
+  *dst_fmt = converters[idx].dst_fmt;
+  return 0;
+}
+
+void st_frame_init_band(struct st_frame* frame, struct st_frame* band, uint32_t line,
+                        uint32_t lines) {
+  uint8_t planes = st_frame_fmt_planes(frame->fmt);
+  bool sub_v = (st_frame_fmt_get_sampling(frame->fmt) == ST_FRAME_SAMPLING_420);
+
+  *band = *frame;
+  for (uint8_t plane = 0; plane < planes; plane++) {
+    uint32_t plane_line = (sub_v && plane) ? line / 2 : line;
+    size_t offset = st_frame_plane_row_size(frame, plane) * plane_line;
+    band->addr[plane] = (uint8_t*)frame->addr[plane] + offset;
+    if (frame->iova[plane]) band->iova[plane] = frame->iova[plane] + offset;
+  }
+  band->height = lines;
+  band->interlaced = false; /* the band is already the data of one field */
+}
+
+int st_frame_converter_convert_lines(const struct st_frame_converter* converter,
+                                     struct st_frame* src, struct st_frame* dst,
+                                     uint32_t line, uint32_t lines) {
+  struct st_frame src_band, dst_band;
+
+  st_frame_init_band(src, &src_band, line, lines);
+  st_frame_init_band(dst, &dst_band, line, lines);
+  return st_frame_converter_convert(converter, &src_band, &dst_band);
 }
 
 static int field_frame_check(const struct st_frame* field, const struct st_frame* frame) {
@@ -880,6 +1012,7 @@ int st_frame_get_converter(enum st_frame_fmt src_fmt, enum st_frame_fmt dst_fmt,
   for (int i = 0; i < MTL_ARRAY_SIZE(converters); i++) {
     if (src_fmt == converters[i].src_fmt && dst_fmt == converters[i].dst_fmt) {
       *converter = converters[i];
+      converter->simd_level = MTL_SIMD_LEVEL_MAX;
       return 0;
     }
   }
@@ -1652,6 +1785,143 @@ int st20_rfc4175_422be10_to_yuv420p8_simd(struct st20_rfc4175_422_10_pg2_be* pg,
   return st20_rfc4175_422be10_to_yuv420p8_scalar(pg, y, b, r, w, h);
 }
 
+/* the chroma of the line pair is averaged, the 420 chroma sits between the two lines */
+static int st20_rfc4175_422be10_to_nv12_scalar(struct st20_rfc4175_422_10_pg2_be* pg0,
+                                               struct st20_rfc4175_422_10_pg2_be* pg1,
+                                               uint8_t* y0, uint8_t* y1, uint8_t* uv,
+                                               uint32_t w) {
+  uint16_t cb0, y00, cr0, y01;
+  uint16_t cb1, y10, cr1, y11;
+
+  for (uint32_t i = 0; i < (w / 2); i++) {
+    st20_unpack_pg2be_422le10(pg0++, &cb0, &y00, &cr0, &y01);
+    st20_unpack_pg2be_422le10(pg1++, &cb1, &y10, &cr1, &y11);
+    *y0++ = y00 >> 2;
+    *y0++ = y01 >> 2;
+    *y1++ = y10 >> 2;
+    *y1++ = y11 >> 2;
+    *uv++ = st20_chroma_avg_10to8(cb0, cb1);
+    *uv++ = st20_chroma_avg_10to8(cr0, cr1);
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422be10_to_nv12_pair_simd(struct st20_rfc4175_422_10_pg2_be* pg0,
+                                           struct st20_rfc4175_422_10_pg2_be* pg1,
+                                           uint8_t* y0, uint8_t* y1, uint8_t* uv,
+                                           uint32_t w, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(level);
+  MTL_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_nv12_avx512(pg0, pg1, y0, y1, uv, w);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
+  return st20_rfc4175_422be10_to_nv12_scalar(pg0, pg1, y0, y1, uv, w);
+}
+
+int st20_rfc4175_422be10_to_nv12_simd(struct st20_rfc4175_422_10_pg2_be* pg, uint8_t* y,
+                                      uint8_t* uv, uint32_t w, uint32_t h,
+                                      enum mtl_simd_level level) {
+  uint32_t line_pg_cnt = w / 2;
+  int ret = 0;
+
+  if (h % 2) {
+    err("%s, invalid height %u, not even\n", __func__, h);
+    return -EINVAL;
+  }
+
+  for (uint32_t i = 0; i < (h / 2); i++) { /* 2 lines each loop */
+    ret = st20_rfc4175_422be10_to_nv12_pair_simd(pg, pg + line_pg_cnt, y, y + w, uv, w,
+                                                 level);
+    if (ret < 0) return ret;
+    pg += line_pg_cnt * 2;
+    y += w * 2;
+    uv += w;
+  }
+
+  return 0;
+}
+
+static int st20_rfc4175_422be10_to_p010_scalar(struct st20_rfc4175_422_10_pg2_be* pg0,
+                                               struct st20_rfc4175_422_10_pg2_be* pg1,
+                                               uint16_t* y0, uint16_t* y1, uint16_t* uv,
+                                               uint32_t w) {
+  uint16_t cb0, y00, cr0, y01;
+  uint16_t cb1, y10, cr1, y11;
+
+  for (uint32_t i = 0; i < (w / 2); i++) {
+    st20_unpack_pg2be_422le10(pg0++, &cb0, &y00, &cr0, &y01);
+    st20_unpack_pg2be_422le10(pg1++, &cb1, &y10, &cr1, &y11);
+    *y0++ = y00 << 6;
+    *y0++ = y01 << 6;
+    *y1++ = y10 << 6;
+    *y1++ = y11 << 6;
+    *uv++ = ((cb0 + cb1 + 1) >> 1) << 6;
+    *uv++ = ((cr0 + cr1 + 1) >> 1) << 6;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422be10_to_p010_pair_simd(struct st20_rfc4175_422_10_pg2_be* pg0,
+                                           struct st20_rfc4175_422_10_pg2_be* pg1,
+                                           uint16_t* y0, uint16_t* y1, uint16_t* uv,
+                                           uint32_t w, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(level);
+  MTL_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_p010_avx512(pg0, pg1, y0, y1, uv, w);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
+  return st20_rfc4175_422be10_to_p010_scalar(pg0, pg1, y0, y1, uv, w);
+}
+
+int st20_rfc4175_422be10_to_p010_simd(struct st20_rfc4175_422_10_pg2_be* pg, uint16_t* y,
+                                      uint16_t* uv, uint32_t w, uint32_t h,
+                                      enum mtl_simd_level level) {
+  uint32_t line_pg_cnt = w / 2;
+  int ret = 0;
+
+  if (h % 2) {
+    err("%s, invalid height %u, not even\n", __func__, h);
+    return -EINVAL;
+  }
+
+  for (uint32_t i = 0; i < (h / 2); i++) { /* 2 lines each loop */
+    ret = st20_rfc4175_422be10_to_p010_pair_simd(pg, pg + line_pg_cnt, y, y + w, uv, w,
+                                                 level);
+    if (ret < 0) return ret;
+    pg += line_pg_cnt * 2;
+    y += w * 2;
+    uv += w;
+  }
+
+  return 0;
+}
+
 int st20_rfc4175_422le10_to_v210_scalar(uint8_t* pg_le, uint8_t* pg_v210, uint32_t w,
                                         uint32_t h) {
   uint32_t pg_count = w * h / 2;
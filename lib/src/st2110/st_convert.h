@@ -12,8 +12,38 @@ struct st_frame_converter {
   enum st_frame_fmt src_fmt;
   enum st_frame_fmt dst_fmt;
   int (*convert_func)(struct st_frame* src, struct st_frame* dst);
+  /* the built-in converters, run at simd_level, preferred over convert_func if set */
+  int (*convert_simd_func)(struct st_frame* src, struct st_frame* dst,
+                           enum mtl_simd_level level);
+  enum mtl_simd_level simd_level;
 };
 
+static inline int st_frame_converter_convert(const struct st_frame_converter* converter,
+                                             struct st_frame* src, struct st_frame* dst) {
+  if (converter->convert_simd_func)
+    return converter->convert_simd_func(src, dst, converter->simd_level);
+  return converter->convert_func(src, dst);
+}
+
+/* the band view of the lines from line of the frame, 420 chroma planes have half lines */
+void st_frame_init_band(struct st_frame* frame, struct st_frame* band, uint32_t line,
+                        uint32_t lines);
+
+/* convert the lines [line, line + lines) only, 420 formats need an even line */
+int st_frame_converter_convert_lines(const struct st_frame_converter* converter,
+                                     struct st_frame* src, struct st_frame* dst,
+                                     uint32_t line, uint32_t lines);
+
+/* convert one line pair, pg0/y0 the even line and pg1/y1 the odd line, w pixels */
+int st20_rfc4175_422be10_to_nv12_pair_simd(struct st20_rfc4175_422_10_pg2_be* pg0,
+                                           struct st20_rfc4175_422_10_pg2_be* pg1,
+                                           uint8_t* y0, uint8_t* y1, uint8_t* uv,
+                                           uint32_t w, enum mtl_simd_level level);
+int st20_rfc4175_422be10_to_p010_pair_simd(struct st20_rfc4175_422_10_pg2_be* pg0,
+                                           struct st20_rfc4175_422_10_pg2_be* pg1,
+                                           uint16_t* y0, uint16_t* y1, uint16_t* uv,
+                                           uint32_t w, enum mtl_simd_level level);
+
 int st_frame_get_converter(enum st_frame_fmt src_fmt, enum st_frame_fmt dst_fmt,
                            struct st_frame_converter* converter);
 
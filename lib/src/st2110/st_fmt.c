@@ -380,6 +380,20 @@ static const struct st_frame_fmt_desc st_frame_fmt_descs[] = {
         .planes = 3,
         .sampling = ST_FRAME_SAMPLING_420,
     },
+    {
+        /* ST_FRAME_FMT_NV12 */
+        .fmt = ST_FRAME_FMT_NV12,
+        .name = "NV12",
+        .planes = 2,
+        .sampling = ST_FRAME_SAMPLING_420,
+    },
+    {
+        /* ST_FRAME_FMT_P010 */
+        .fmt = ST_FRAME_FMT_P010,
+        .name = "P010",
+        .planes = 2,
+        .sampling = ST_FRAME_SAMPLING_420,
+    },
     {
         /* ST_FRAME_FMT_RGBRFC4175PG4BE10 */
         .fmt = ST_FRAME_FMT_RGBRFC4175PG4BE10,
@@ -521,6 +535,14 @@ size_t st_frame_least_linesize(enum st_frame_fmt fmt, uint32_t width, uint8_t pl
         }
         break;
       case ST_FRAME_SAMPLING_420:
+        if (st_frame_fmt_planes(fmt) == 2) {
+          /* semi-planar, the interleaved CbCr line has the bytes of the Y line */
+          if (plane < 2)
+            linesize = st_frame_size(fmt, width, 2, false) / 3;
+          else
+            err("%s, invalid plane idx %u for 420 semi-planar fmt\n", __func__, plane);
+          break;
+        }
         switch (plane) {
           case 0:
             linesize = st_frame_size(fmt, width, 1, false) * 4 / 6;
@@ -598,6 +620,12 @@ size_t st_frame_size(enum st_frame_fmt fmt, uint32_t width, uint32_t height,
     case ST_FRAME_FMT_YUV420PLANAR8:
       size = st20_frame_size(ST20_FMT_YUV_420_8BIT, width, height);
       break;
+    case ST_FRAME_FMT_NV12:
+      size = pixels * 3 / 2;
+      break;
+    case ST_FRAME_FMT_P010:
+      size = pixels * 3; /* 10bits in two bytes */
+      break;
     case ST_FRAME_FMT_YUV422PLANAR16LE:
       size = st20_frame_size(ST20_FMT_YUV_422_16BIT, width, height);
       break;
@@ -1233,6 +1261,13 @@ void st_frame_init_plane_single_src(struct st_frame* frame, void* addr, mtl_iova
   }
 }
 
+size_t st_frame_plane_row_size(struct st_frame* frame, uint8_t plane) {
+  /* the linesize of yuv420p8 chroma is a quarter of width for all the frame lines */
+  if (plane && (frame->fmt == ST_FRAME_FMT_YUV420PLANAR8))
+    return frame->linesize[plane] * 2;
+  return frame->linesize[plane];
+}
+
 struct st_frame* st_frame_create(mtl_handle mt, enum st_frame_fmt fmt, uint32_t w,
                                  uint32_t h, bool interlaced) {
   struct mtl_main_impl* impl = mt;
@@ -62,6 +62,13 @@ static inline void st20_unpack_pg2be_422le10(struct st20_rfc4175_422_10_pg2_be*
   *y01 = y1;
 }
 
+/* the rounded 8 bits average of two 10 bits chroma, 1023 + 1023 rounds up to 256 */
+static inline uint8_t st20_chroma_avg_10to8(uint16_t c0, uint16_t c1) {
+  uint16_t c = (c0 + c1 + 4) >> 3;
+
+  return c > UINT8_MAX ? UINT8_MAX : c;
+}
+
 static inline void st20_unpack_pg2be_422le12(struct st20_rfc4175_422_12_pg2_be* pg,
                                              uint16_t* cb00, uint16_t* y00,
                                              uint16_t* cr00, uint16_t* y01) {
@@ -96,6 +103,9 @@ static inline void st20_unpack_pg2be_422le16(struct st20_rfc4175_422_10_pg2_be*
 
 void st_frame_init_plane_single_src(struct st_frame* frame, void* addr, mtl_iova_t iova);
 
+/* the bytes between two sample rows of a plane, a yuv420p8 chroma row spans two lines */
+size_t st_frame_plane_row_size(struct st_frame* frame, uint8_t plane);
+
 enum st_frame_fmt st_codec_codestream_fmt(enum st22_codec codec);
 
 #endif
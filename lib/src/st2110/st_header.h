@@ -43,11 +43,21 @@
 #define ST_VIDEO_STAT_UPDATE_INTERVAL (1000)
 /* data size for each pkt in block packing mode */
 #define ST_VIDEO_BPM_SIZE (1260)
+/*
+ * max rx mbufs held out of one rx pool by all the st22 sessions with
+ * ST22_RX_FLAG_CODESTREAM_SG, the rx queue pool only has 1024 mbufs above the nic ring.
+ * Copy to the framebuffer if reached.
+ */
+#define ST_VIDEO_RX_ST22_SG_HOLD_MAX (512)
 
 /* max tx/rx audio(st30) sessions */
 #define ST_SCH_MAX_TX_AUDIO_SESSIONS (512) /* max audio tx sessions per sch lcore */
 #define ST_TX_AUDIO_SESSIONS_RING_SIZE (ST_SCH_MAX_TX_AUDIO_SESSIONS * 2)
 #define ST_SCH_MAX_RX_AUDIO_SESSIONS (512 * 2) /* max audio rx sessions per sch lcore */
+/* max batch build groups of tx audio sessions per sch lcore */
+#define ST_TX_AUDIO_GROUPS_MAX (8)
+/* max pkts of one burst from the shared ring of the audio and anc transmitter */
+#define ST_TX_TRS_BURST_SIZE (16)
 
 /* max tx/rx anc(st40) sessions */
 #define ST_MAX_TX_ANC_SESSIONS (180)
@@ -276,6 +286,8 @@ struct st_tx_video_session_impl {
   struct rte_mempool* mbuf_mempool_copy_chain;
   bool tx_mono_pool;   /* if reuse tx mono pool */
   bool tx_no_chain;    /* if tx not use chain mbuf */
+  /* reclaim the done mbufs at each frame start, st22 chain frames may be small */
+  bool tx_done_cleanup;
   bool multi_src_port; /* if tx use multiple src port */
   /* if the eth dev support chain buff */
   bool eth_has_chain[MTL_SESSION_PORT_MAX];
@@ -338,6 +350,8 @@ struct st_tx_video_session_impl {
   uint16_t st20_frames_cnt; /* numbers of frames requested */
   struct st_frame_trans* st20_frames;
 
+  struct st20_tx_uframe_pg_meta pg_meta; /* for ops.uframe_pg_callback */
+
   uint16_t st20_frame_idx; /* current frame index */
   enum st21_tx_frame_status st20_frame_stat;
   uint16_t st20_frame_lines_ready;
@@ -466,12 +480,30 @@ struct st_rx_video_detector {
   struct st20_detect_meta meta;
 };
 
+/* the codestream segments of one rx framebuffer, ST22_RX_FLAG_CODESTREAM_SG */
+struct st22_rx_sg_frame {
+  struct st22_rx_codestream_seg* segs; /* indexed by the pkt counter */
+  struct rte_mbuf** mbufs;             /* the held mbuf, NULL if copied */
+  uint32_t segs_nb;                    /* max pkt counter + 1 */
+};
+
 struct st22_rx_video_info {
   /* app callback */
   int (*notify_frame_ready)(void* priv, void* frame, struct st22_rx_frame_meta* meta);
 
   struct st22_rx_frame_meta meta;
   size_t cur_frame_size; /* size per frame */
+
+  /* for ST22_RX_FLAG_CODESTREAM_SG, one for each framebuffer */
+  struct st22_rx_sg_frame* sg_frames;
+  uint16_t sg_frames_cnt;
+  uint32_t sg_segs_max;   /* max pkts of one frame */
+  rte_atomic32_t sg_held; /* mbufs held by all frames, put from app thread */
+  /* the rx pool of each port and its held counter, shared with the other sessions */
+  struct rte_mempool* sg_pool[MTL_SESSION_PORT_MAX];
+  rte_atomic32_t* sg_pool_held[MTL_SESSION_PORT_MAX];
+  uint32_t stat_sg_hold;
+  uint32_t stat_sg_copy;
 };
 
 struct st_rx_video_hdr_split_info {
@@ -535,6 +567,9 @@ struct st_rv_tp_stat {
 };
 
 struct st_rx_video_tp {
+  /* frame time in ns and in sampling clock ticks */
+  double frame_time;
+  double frame_time_sampling;
   /* in ns for of 2 consecutive packets, T-Frame / N-Packets */
   double trs;
   /* pass criteria */
@@ -549,6 +584,13 @@ struct st_rx_video_tp {
   uint32_t stat_untrusted_pkts;
 };
 
+/* the timing parser without rx session, for offline analysis */
+struct st20_tp_parser_impl {
+  struct st_rx_video_tp tp;
+  /* the frame in parsing */
+  struct st_rv_tp_slot slot;
+};
+
 struct st_rx_video_session_impl {
   struct mtl_main_impl* impl;
   int idx; /* index for current session */
@@ -748,6 +790,65 @@ struct st_tx_audio_session_rl_info {
   struct st_tx_audio_session_rl_port port_info[MTL_SESSION_PORT_MAX];
 };
 
+/* tx audio sessions of the same profile, built in one batch for each epoch */
+struct st_tx_audio_group {
+  int idx; /* index in the mgr */
+  int members;
+  /* the profile of the group */
+  enum st30_ptime ptime;
+  enum st30_sampling sampling;
+  uint32_t pkt_len;
+  int num_port;
+  enum mtl_port port[MTL_SESSION_PORT_MAX]; /* physical port of each session port */
+
+  /* the shared pacing of all members, one epoch for all pkts of the batch */
+  struct st_tx_audio_session_pacing pacing;
+  struct rte_mempool* mbuf_pool[MTL_SESSION_PORT_MAX];
+  bool mono_pool; /* if reuse tx mono pool */
+
+  /* the members built in current epoch, the session lock is held while building */
+  struct st_tx_audio_session_impl* batch[ST_SCH_MAX_TX_AUDIO_SESSIONS];
+  /* the pkts of the built epoch, wait the epoch time and burst to the mgr ring */
+  struct rte_mbuf* pkts[MTL_SESSION_PORT_MAX][ST_SCH_MAX_TX_AUDIO_SESSIONS];
+  uint16_t pkts_cnt;
+  uint16_t pkts_sent[MTL_SESSION_PORT_MAX];
+
+  /* stat */
+  uint64_t stat_epochs;
+  uint64_t stat_pkts;
+  uint32_t stat_batch_max;
+  uint32_t stat_epoch_drop;
+  uint32_t stat_epoch_late;
+  uint32_t stat_epoch_mismatch;
+  uint32_t stat_alloc_fail;
+  uint32_t stat_burst_fail;
+};
+
+/*
+ * The sample ring of one tx session fed by st30p_tx_write_samples, the packets of the
+ * session are sliced from it. Single producer (the app) and single consumer (the
+ * session tasklet), the cursors are the bytes since create.
+ */
+struct st_tx_audio_stream_impl {
+  int idx;
+  uint32_t row_size; /* bytes of one sample of all the channels */
+  uint32_t pkt_len;  /* bytes of one packet payload */
+  uint64_t size;     /* bytes of the ring, multiple of pkt_len */
+  uint64_t prefill;  /* bytes in the ring before the first packet */
+  uint8_t silence;
+  uint8_t* ring;
+
+  _Atomic uint64_t wr; /* by the app */
+  _Atomic uint64_t rd; /* by the tasklet, always on a packet */
+  bool started;        /* tasklet only, the prefill reached */
+
+  /* stat */
+  uint64_t stat_pkts_sent;
+  uint64_t stat_pkts_underrun;
+  _Atomic uint64_t stat_samples_written;
+  _Atomic uint64_t stat_samples_full;
+};
+
 struct st_tx_audio_session_impl {
   int idx; /* index for current session */
   int socket_id;
@@ -800,6 +901,11 @@ struct st_tx_audio_session_impl {
   struct st_tx_audio_session_pacing pacing;
   bool calculate_time_cursor;
   bool check_frame_done_time;
+  /* the batch build group if ST30_TX_FLAG_GROUP_BUILD */
+  struct st_tx_audio_group* group;
+  int32_t group_rtp_delta; /* rtp_timestamp_delta_us in sampling */
+  /* the packets are sliced from the sample ring of the pipeline if any, no frames */
+  struct st_tx_audio_stream_impl* stream;
 
   uint16_t sample_size;
   uint16_t sample_num;
@@ -827,6 +933,31 @@ struct st_tx_audio_session_impl {
   struct mt_stat_u64 stat_tx_delta;
 };
 
+/* one session parked in the deadline heap */
+struct st_tx_deadline_node {
+  uint64_t due; /* tsc */
+  uint16_t idx; /* session idx */
+};
+
+/*
+ * The sessions of a tx sessions tasklet by the tsc they are due: a min heap of the
+ * parked sessions and a bitmap of the ready ones, both owned by the tasklet. The
+ * control path kicks it after a session change, the tasklet then makes all ready.
+ */
+struct st_tx_deadline {
+  uint16_t cap;                      /* max session idx */
+  uint16_t num;                      /* the parked sessions */
+  struct st_tx_deadline_node* nodes; /* cap nodes in the heap order */
+  int16_t* pos;                      /* the node of each session, -1 if not parked */
+  uint64_t* ready;                   /* bitmap of the sessions to visit */
+  rte_atomic32_t kick;               /* bumped by the control path */
+  int32_t kick_seen;
+  /* status */
+  uint64_t stat_parked;
+  uint64_t stat_expired;
+  uint64_t stat_visited;
+};
+
 struct st_tx_audio_sessions_mgr {
   struct mtl_main_impl* parent;
   int socket_id;
@@ -844,10 +975,17 @@ struct st_tx_audio_sessions_mgr {
   struct st_tx_audio_session_impl* sessions[ST_SCH_MAX_TX_AUDIO_SESSIONS];
   /* protect session, spin(fast) lock as it call from tasklet aslo */
   rte_spinlock_t mutex[ST_SCH_MAX_TX_AUDIO_SESSIONS]; /* protect session */
+  /* the sessions waiting the tsc only are parked out of the tasklet loop */
+  struct st_tx_deadline deadline;
 
   rte_atomic32_t transmitter_started;
   rte_atomic32_t transmitter_clients;
 
+  /* batch build groups, created by the first member and freed with the last one */
+  struct st_tx_audio_group* groups[ST_TX_AUDIO_GROUPS_MAX];
+  rte_spinlock_t group_mutex[ST_TX_AUDIO_GROUPS_MAX]; /* protect group */
+  int group_seq;                                      /* for the pool name */
+
   /* status */
   int stat_pkts_burst;
   int stat_trs_ret_code[MTL_PORT_MAX];
@@ -861,8 +999,11 @@ struct st_audio_transmitter_impl {
   struct mt_sch_tasklet_impl* tasklet;
   int idx; /* index for current transmitter */
 
-  struct rte_mbuf* inflight[MTL_PORT_MAX]; /* inflight mbuf */
-  int inflight_cnt[MTL_PORT_MAX];          /* for stats */
+  /* the mbufs of the last burst not sent yet, from inflight_idx */
+  struct rte_mbuf* inflight[MTL_PORT_MAX][ST_TX_TRS_BURST_SIZE];
+  uint16_t inflight_idx[MTL_PORT_MAX];
+  uint16_t inflight_num[MTL_PORT_MAX];
+  int inflight_cnt[MTL_PORT_MAX]; /* for stats */
 };
 
 /* tp for every 200ms */
@@ -977,6 +1118,14 @@ struct st_rx_audio_session_impl {
 
   struct st30_rx_frame_meta meta; /* only for frame type */
 
+  /* the aggregation group this flow writes into, NULL for the own frames */
+  struct st_rx_audio_agg_impl* agg;
+  int agg_flow; /* the flow index in the group */
+  /* the playout ring of the pipeline, NULL for the own frames */
+  struct st_rx_audio_playout_impl* playout;
+  /* the level meter of ST30_RX_FLAG_ENABLE_METER, NULL if not enabled */
+  struct st_rx_audio_meter_impl* meter;
+
   struct mt_rtcp_rx* rtcp_rx[MTL_SESSION_PORT_MAX];
 
   /* stat – port_user_stats is the single source for API-visible counters (monotonic) */
@@ -1003,6 +1152,159 @@ struct st_rx_audio_sessions_mgr {
   rte_spinlock_t mutex[ST_SCH_MAX_RX_AUDIO_SESSIONS];
 };
 
+/* the frames assembled at the same time, for the flows with a time skew */
+#define ST_RX_AUDIO_AGG_OPEN_MAX (2)
+
+struct st_rx_audio_agg_flow {
+  bool attached;
+  uint16_t channel;
+  uint16_t channel_offset;
+  uint32_t row_size; /* bytes of one sample of all the channels of this flow */
+};
+
+struct st_rx_audio_agg_slot {
+  struct st_frame_trans* frame; /* NULL until the first packet of the slot */
+  uint64_t first_pkt_ptp_ts;
+  size_t recv_size;
+  uint64_t pkt_bitmap[ST30_RX_AGG_FLOWS_MAX]; /* received packets of each flow */
+};
+
+struct st_rx_audio_agg_impl {
+  enum mt_handle_type type; /* for sanity check */
+  _Atomic uint32_t lc_destroying;
+  _Atomic uint32_t lc_refcnt;
+  struct mtl_main_impl* parent;
+  int socket_id;
+  struct st30_rx_agg_ops ops;
+  char ops_name[ST_MAX_NAME_LEN];
+
+  uint8_t sample_size;
+  uint32_t row_size;         /* bytes of one sample of all the channels */
+  uint32_t samples_per_pkt;  /* rtp ticks of one packet */
+  uint32_t pkts_per_frame;   /* packets of each flow in one frame */
+  uint32_t ticks_per_frame;  /* rtp ticks of one frame */
+  size_t frame_size;         /* bytes of one frame */
+  size_t frame_expect_size;  /* bytes of all the attached flows in one frame */
+  bool has_gap;              /* channels not covered by any flow, silence */
+  enum mtl_simd_level simd_level;
+
+  struct st_frame_trans* frames;
+  uint16_t frames_cnt;
+
+  /* the flows may run on different sch tasklets */
+  rte_spinlock_t lock;
+  struct st_rx_audio_agg_flow flows[ST30_RX_AGG_FLOWS_MAX];
+  uint16_t flow_cnt;
+  /* the open frames, slot i is at the rtp timestamp base + i * ticks_per_frame */
+  struct st_rx_audio_agg_slot slots[ST_RX_AUDIO_AGG_OPEN_MAX];
+  bool synced;
+  uint32_t base;
+  /* packets in a row far behind the base, resync to behind_ts after a frame of them */
+  uint32_t behind_cnt;
+  uint32_t behind_ts; /* rtp timestamp of the first one */
+  /* notify_frame_ready runs out of the lock, this keeps the frames in order */
+  rte_spinlock_t notify_lock;
+
+  /* stat */
+  uint64_t stat_frames_received;
+  uint64_t stat_frames_incomplete;
+  uint64_t stat_pkts_received;
+  uint64_t stat_pkts_late;
+  uint64_t stat_pkts_misaligned;
+  uint64_t stat_pkts_redundant;
+  uint64_t stat_no_framebuffer;
+};
+
+/*
+ * The playout ring of one rx session, the packets of all the ports are written to the
+ * slot of their media clock position and read by the app for a PTP time. Single writer
+ * (the session tasklet), the readers check the slot tag before and after the copy.
+ */
+struct st_rx_audio_playout_impl {
+  struct mtl_main_impl* parent;
+  int idx;
+  enum st30_fmt fmt;
+  uint32_t sample_rate;
+  uint32_t row_size;        /* bytes of one sample of all the channels */
+  uint32_t samples_per_pkt; /* rtp ticks of one packet */
+  uint32_t pkt_len;         /* bytes of one packet payload */
+  uint32_t slots;           /* packet slots of the ring, power of 2 */
+  uint32_t latency_samples; /* the read position behind the PTP time */
+  uint8_t silence;
+
+  uint8_t* ring; /* slots * pkt_len */
+  /* packet index + 1 of the payload in each slot, 0 for empty or in write */
+  _Atomic uint64_t* tags;
+
+  /* writer only */
+  bool synced;
+  uint32_t phase;          /* media clock position of packet 0 modulo samples_per_pkt */
+  uint32_t floor_ts;       /* the rtp timestamp of the oldest packet the ring keeps */
+  _Atomic uint64_t newest; /* the newest packet index + 1, 0 before the first */
+
+  /* stat */
+  uint64_t stat_pkts_written;
+  uint64_t stat_pkts_redundant;
+  uint64_t stat_pkts_late;
+  uint64_t stat_pkts_misaligned;
+  _Atomic uint64_t stat_samples_read;
+  _Atomic uint64_t stat_samples_concealed;
+  _Atomic uint64_t stat_samples_ahead;
+};
+
+#define ST_AUDIO_METER_TP_PHASES (4) /* the true peak oversampling */
+#define ST_AUDIO_METER_TP_TAPS (12)  /* the fir taps of each phase */
+#define ST_AUDIO_METER_BLOCKS (4)    /* the 100ms blocks of the momentary loudness */
+
+/* the accumulators of each channel in the block */
+enum st_audio_meter_acc {
+  ST_AUDIO_METER_ACC_PEAK = 0, /* max |x| */
+  ST_AUDIO_METER_ACC_TP,       /* max |x| of the oversampled signal */
+  ST_AUDIO_METER_ACC_SQ,       /* sum of x^2 */
+  ST_AUDIO_METER_ACC_KSQ,      /* sum of the k-weighted x^2 */
+  ST_AUDIO_METER_ACC_MAX,
+};
+
+struct st_audio_meter_coef {
+  /* b0, b1, b2, a1, a2 of the shelf then the high pass biquad, a0 is 1 */
+  float kw[2][5];
+  float tp[ST_AUDIO_METER_TP_PHASES][ST_AUDIO_METER_TP_TAPS];
+};
+
+/*
+ * The level meter of one rx session, the packets are metered in the session tasklet
+ * and the levels of each 100ms block are published with a seqlock for the readers.
+ */
+struct st_rx_audio_meter_impl {
+  int idx;
+  enum st30_fmt fmt;
+  uint16_t channel;
+  uint16_t stride;          /* the channel arrays stride, a multiple of 16 */
+  uint32_t sample_rate;
+  uint32_t samples_per_pkt; /* sample rows of one packet */
+  uint32_t pkt_len;
+  uint32_t block_samples;   /* sample rows of one 100ms block */
+  enum mtl_simd_level simd_level;
+  struct st_audio_meter_coef coef;
+  int32_t* am824_offset; /* the byte offset of each 24 bit sample of the AM824 packet */
+
+  /* writer only */
+  float* x;          /* (ST_AUDIO_METER_TP_TAPS - 1) history rows then one packet */
+  float* z;          /* the 4 biquad states of each channel */
+  float* acc;        /* ST_AUDIO_METER_ACC_MAX accumulators of each channel */
+  float* ksq_blocks; /* the k-weighted sum of the last ST_AUDIO_METER_BLOCKS blocks */
+  uint32_t block_pos; /* sample rows in the current block */
+  uint64_t blocks;
+
+  /* the levels of the last block, odd seq in write */
+  _Atomic uint32_t seq;
+  struct st30_meter_level* levels;
+
+  /* stat */
+  uint64_t stat_pkts;
+  _Atomic uint64_t stat_read_busy;
+};
+
 struct st_tx_ancillary_session_pacing {
   long double frame_time;          /* time of the frame in nanoseconds */
   long double frame_time_sampling; /* time of the frame in sampling(90k) */
@@ -1105,6 +1407,8 @@ struct st_tx_ancillary_sessions_mgr {
   struct st_tx_ancillary_session_impl* sessions[ST_MAX_TX_ANC_SESSIONS];
   /* protect session, spin(fast) lock as it call from tasklet aslo */
   rte_spinlock_t mutex[ST_MAX_TX_ANC_SESSIONS];
+  /* the sessions waiting the tsc only are parked out of the tasklet loop */
+  struct st_tx_deadline deadline;
 
   rte_atomic32_t transmitter_started;
   rte_atomic32_t transmitter_clients;
@@ -1128,7 +1432,8 @@ enum st_rx_anc_slot_state {
 struct st_rx_anc_frame_slot {
   uint8_t* udw_buf; /* size = ops.framebuff_size */
   size_t udw_buf_size;
-  struct st40_meta meta[ST40_MAX_META];
+  struct st40_meta* meta;             /* meta_cap entries, ops.max_meta */
+  uint16_t meta_cap;
   struct st40_rx_frame_meta cur_meta; /* assembled meta delivered to app */
   _Atomic enum st_rx_anc_slot_state state;
   uint16_t idx;
@@ -1251,8 +1556,11 @@ struct st_ancillary_transmitter_impl {
   struct mt_sch_tasklet_impl* tasklet;
   int idx; /* index for current transmitter */
 
-  struct rte_mbuf* inflight[MTL_PORT_MAX]; /* inflight mbuf */
-  int inflight_cnt[MTL_PORT_MAX];          /* for stats */
+  /* the mbufs of the last burst not sent yet, from inflight_idx */
+  struct rte_mbuf* inflight[MTL_PORT_MAX][ST_TX_TRS_BURST_SIZE];
+  uint16_t inflight_idx[MTL_PORT_MAX];
+  uint16_t inflight_num[MTL_PORT_MAX];
+  int inflight_cnt[MTL_PORT_MAX]; /* for stats */
 };
 
 struct st_tx_fastmetadata_session_pacing {
@@ -1526,6 +1834,81 @@ struct st_plugin_mgr {
   int plugins_nb;
 };
 
+#define ST_CONVERT_POOL_MAX_NUMA (8)
+#define ST_CONVERT_POOL_MAX_WORKERS (32)
+#define ST_CONVERT_POOL_DEFAULT_WORKERS (4)
+/* the bands of one frame, the workers and the calling thread */
+#define ST_CONVERT_POOL_MAX_BANDS (ST_CONVERT_POOL_MAX_WORKERS + 1)
+#define ST_CONVERT_POOL_QUEUE_SIZE (256) /* max pending bands in one pool */
+
+/* all bands of one frame, the caller wait until pending reach zero */
+struct st_convert_band_batch {
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  int pending; /* bands not finished */
+  int ret;
+};
+
+/* a range of lines of one frame, src and dst point to the first line of the band */
+struct st_convert_band {
+  const struct st_frame_converter* converter;
+  struct st_frame src;
+  struct st_frame dst;
+  struct st_convert_band_batch* batch;
+};
+
+/* worker threads pool for one numa node */
+struct st_convert_pool {
+  struct mtl_main_impl* parent;
+  int socket_id;
+  int workers_nb;
+  pthread_t workers[ST_CONVERT_POOL_MAX_WORKERS];
+
+  pthread_mutex_t lock; /* lock for queue and stop */
+  pthread_cond_t cond;  /* wake workers */
+  bool stop;
+  struct st_convert_band* queue[ST_CONVERT_POOL_QUEUE_SIZE];
+  uint32_t queue_head; /* producer */
+  uint32_t queue_tail; /* consumer */
+
+  /* stat, protected by lock */
+  uint32_t stat_frames;
+  uint32_t stat_bands;
+  uint32_t stat_bands_inline; /* band run by the caller as queue full */
+};
+
+struct st_convert_pool_mgr {
+  pthread_mutex_t lock; /* lock for pools */
+  uint16_t workers_per_numa;
+  struct st_convert_pool* pools[ST_CONVERT_POOL_MAX_NUMA];
+};
+
+#define ST_CONVERT_SELECT_MAX_ENTRIES (64)
+#define ST_CONVERT_SELECT_MAX_DIM (16384) /* the max width/height of a cache entry */
+
+/* the benchmark result of one converter for one resolution */
+struct st_convert_select_entry {
+  enum st_frame_fmt src_fmt;
+  enum st_frame_fmt dst_fmt;
+  uint32_t width;
+  uint32_t height;
+  bool interlaced;
+  enum mtl_simd_level level; /* the cheapest simd level */
+  uint64_t ns;               /* ns of one frame at level */
+  uint64_t max_ns;           /* ns of one frame at MTL_SIMD_LEVEL_MAX */
+  bool benching;             /* the benchmark is running, no result yet */
+};
+
+struct st_convert_select_mgr {
+  pthread_mutex_t lock; /* lock for entries and the cache file */
+  pthread_cond_t cond;  /* wake the sessions wait on a benching entry */
+  char cpu_model[128];
+  char cache_path[256]; /* empty if no cache file */
+  bool cache_loaded;
+  int entries_nb;
+  struct st_convert_select_entry entries[ST_CONVERT_SELECT_MAX_ENTRIES];
+};
+
 /* IMPORTANT: After *_free returns this->impl is dangling memory.
  * Access it ONLY through MT_HANDLE_GUARD which atomically rejects
  * post-destroy callers via the destroying gate. */
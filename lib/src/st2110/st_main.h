@@ -18,4 +18,20 @@ static inline enum st21_tx_pacing_way st_tx_pacing_way(struct mtl_main_impl* imp
   return mt_if(impl, port)->tx_pacing_way;
 }
 
+/*
+ * The max ether bytes of one audio packet on the session ports, -ENOTSUP if jumbo on a
+ * port other than the kernel socket as the dpdk ports run with the standard mtu.
+ */
+static inline int st_audio_max_ether_bytes(struct mtl_main_impl* impl,
+                                           enum mtl_port* port_maps, int num_port,
+                                           bool jumbo) {
+  if (!jumbo) return ST_PKT_MAX_ETHER_BYTES;
+
+  for (int i = 0; i < num_port; i++) {
+    if (!mt_pmd_is_kernel_socket(impl, mt_port_logic2phy(port_maps, i)))
+      return -ENOTSUP;
+  }
+  return ST_PKT_MAX_JUMBO_ETHER_BYTES;
+}
+
 #endif
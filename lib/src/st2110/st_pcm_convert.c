@@ -0,0 +1,371 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include "st_pcm_convert.h"
+
+#include "../mt_log.h"
+
+#ifdef MTL_HAS_AVX2
+#include "st_avx2.h"
+#endif
+#ifdef MTL_HAS_AVX512
+#include "st_avx512.h"
+#endif
+
+static bool pcm_app_fmt_valid(enum st30p_sample_fmt app_fmt) {
+  return (app_fmt == ST30P_SAMPLE_FMT_S32) || (app_fmt == ST30P_SAMPLE_FMT_F32);
+}
+
+bool st_pcm_convert_fmt_supported(enum st30_fmt fmt) {
+  return (fmt == ST30_FMT_PCM8) || (fmt == ST30_FMT_PCM16) || (fmt == ST30_FMT_PCM24);
+}
+
+static int pcm_args_check(enum st30_fmt fmt, enum st30p_sample_fmt app_fmt) {
+  if (!st_pcm_convert_fmt_supported(fmt)) {
+    err("%s, unsupported fmt %d\n", __func__, fmt);
+    return -EINVAL;
+  }
+  if (!pcm_app_fmt_valid(app_fmt)) {
+    err("%s, unsupported app fmt %d\n", __func__, app_fmt);
+    return -EINVAL;
+  }
+  return 0;
+}
+
+static int pcm_to_app_scalar(const uint8_t* src, void* dst, uint32_t n,
+                             enum st30_fmt fmt, enum st30p_sample_fmt app_fmt) {
+  uint8_t ss = st30_get_sample_size(fmt);
+
+  for (uint32_t i = 0; i < n; i++)
+    st_pcm_app_store(dst, i, st_pcm_load(src + i * ss, fmt), app_fmt);
+  return 0;
+}
+
+static int pcm_gather_to_app_scalar(const uint8_t* base, const int32_t* offset,
+                                    uint32_t n, void* dst, enum st30_fmt fmt,
+                                    enum st30p_sample_fmt app_fmt) {
+  for (uint32_t i = 0; i < n; i++)
+    st_pcm_app_store(dst, i, st_pcm_load(base + offset[i], fmt), app_fmt);
+  return 0;
+}
+
+static int pcm_to_wire_scalar(const void* src, uint8_t* dst, uint32_t n,
+                              enum st30_fmt fmt, enum st30p_sample_fmt app_fmt) {
+  uint8_t ss = st30_get_sample_size(fmt);
+
+  for (uint32_t i = 0; i < n; i++)
+    st_pcm_store(dst + i * ss, st_pcm_app_load(src, i, fmt, app_fmt), fmt);
+  return 0;
+}
+
+static int pcm_gather_to_wire_scalar(const void* base, const int32_t* idx, uint32_t n,
+                                     uint8_t* dst, enum st30_fmt fmt,
+                                     enum st30p_sample_fmt app_fmt) {
+  uint8_t ss = st30_get_sample_size(fmt);
+
+  for (uint32_t i = 0; i < n; i++)
+    st_pcm_store(dst + i * ss, st_pcm_app_load(base, idx[i], fmt, app_fmt), fmt);
+  return 0;
+}
+
+int st_pcm_to_app_simd(const uint8_t* src, void* dst, uint32_t n, enum st30_fmt fmt,
+                       enum st30p_sample_fmt app_fmt, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret = pcm_args_check(fmt, app_fmt);
+
+  if (ret < 0) return ret;
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(level);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st_pcm_to_app_avx512(src, dst, n, fmt, app_fmt);
+    if (ret == 0) return 0;
+    err("%s, avx512 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st_pcm_to_app_avx2(src, dst, n, fmt, app_fmt);
+    if (ret == 0) return 0;
+    err("%s, avx2 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  /* the last option */
+  return pcm_to_app_scalar(src, dst, n, fmt, app_fmt);
+}
+
+int st_pcm_gather_to_app_simd(const uint8_t* base, const int32_t* offset, uint32_t n,
+                              uint32_t limit, void* dst, enum st30_fmt fmt,
+                              enum st30p_sample_fmt app_fmt, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret = pcm_args_check(fmt, app_fmt);
+
+  if (ret < 0) return ret;
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(level);
+  MTL_MAY_UNUSED(limit);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st_pcm_gather_to_app_avx512(base, offset, n, limit, dst, fmt, app_fmt);
+    if (ret == 0) return 0;
+    err("%s, avx512 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st_pcm_gather_to_app_avx2(base, offset, n, limit, dst, fmt, app_fmt);
+    if (ret == 0) return 0;
+    err("%s, avx2 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  /* the last option */
+  return pcm_gather_to_app_scalar(base, offset, n, dst, fmt, app_fmt);
+}
+
+int st_pcm_to_wire_simd(const void* src, uint8_t* dst, uint32_t n, enum st30_fmt fmt,
+                        enum st30p_sample_fmt app_fmt, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret = pcm_args_check(fmt, app_fmt);
+
+  if (ret < 0) return ret;
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(level);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st_pcm_to_wire_avx512(src, dst, n, fmt, app_fmt);
+    if (ret == 0) return 0;
+    err("%s, avx512 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st_pcm_to_wire_avx2(src, dst, n, fmt, app_fmt);
+    if (ret == 0) return 0;
+    err("%s, avx2 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  /* the last option */
+  return pcm_to_wire_scalar(src, dst, n, fmt, app_fmt);
+}
+
+int st_pcm_gather_to_wire_simd(const void* base, const int32_t* idx, uint32_t n,
+                               uint8_t* dst, enum st30_fmt fmt,
+                               enum st30p_sample_fmt app_fmt, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret = pcm_args_check(fmt, app_fmt);
+
+  if (ret < 0) return ret;
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(level);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st_pcm_gather_to_wire_avx512(base, idx, n, dst, fmt, app_fmt);
+    if (ret == 0) return 0;
+    err("%s, avx512 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st_pcm_gather_to_wire_avx2(base, idx, n, dst, fmt, app_fmt);
+    if (ret == 0) return 0;
+    err("%s, avx2 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  /* the last option */
+  return pcm_gather_to_wire_scalar(base, idx, n, dst, fmt, app_fmt);
+}
+
+void st_pcm_converter_free(struct st_pcm_converter* cvt) {
+  if (!cvt) return;
+  if (cvt->ch_offset) mt_free(cvt->ch_offset);
+  if (cvt->row_offset) mt_free(cvt->row_offset);
+  if (cvt->wire_src) mt_free(cvt->wire_src);
+  mt_free(cvt);
+}
+
+struct st_pcm_converter* st_pcm_converter_create(enum st30_fmt wire_fmt,
+                                                 uint16_t wire_channel,
+                                                 size_t wire_frame_size,
+                                                 enum st30p_sample_fmt app_fmt,
+                                                 bool planar, uint16_t app_channel,
+                                                 const uint16_t* map) {
+  struct st_pcm_converter* cvt;
+  size_t row_size;
+
+  if (pcm_args_check(wire_fmt, app_fmt) < 0) return NULL;
+  if (!wire_channel) {
+    err("%s, zero channel\n", __func__);
+    return NULL;
+  }
+  if (!app_channel) app_channel = wire_channel;
+  if (!map && app_channel > wire_channel) {
+    err("%s, app channel %u over the channel %u without a map\n", __func__, app_channel,
+        wire_channel);
+    return NULL;
+  }
+  row_size = (size_t)st30_get_sample_size(wire_fmt) * wire_channel;
+  if (!wire_frame_size || (wire_frame_size % row_size) ||
+      (wire_frame_size > INT32_MAX)) {
+    err("%s, frame size %" PRIu64 " not multiple of the sample row %" PRIu64 "\n",
+        __func__, (uint64_t)wire_frame_size, (uint64_t)row_size);
+    return NULL;
+  }
+
+  cvt = mt_zmalloc(sizeof(*cvt));
+  if (!cvt) {
+    err("%s, converter malloc fail\n", __func__);
+    return NULL;
+  }
+  cvt->wire_fmt = wire_fmt;
+  cvt->sample_size = st30_get_sample_size(wire_fmt);
+  cvt->wire_channel = wire_channel;
+  cvt->app_fmt = app_fmt;
+  cvt->planar = planar;
+  cvt->app_channel = app_channel;
+  cvt->samples = wire_frame_size / row_size;
+  cvt->wire_frame_size = wire_frame_size;
+  cvt->app_frame_size = (size_t)cvt->samples * app_channel * sizeof(int32_t);
+  cvt->simd_level = MTL_SIMD_LEVEL_MAX;
+
+  cvt->ch_offset = mt_zmalloc(sizeof(*cvt->ch_offset) * app_channel);
+  cvt->wire_src = mt_zmalloc(sizeof(*cvt->wire_src) * wire_channel);
+  if (planar) cvt->row_offset = mt_zmalloc(sizeof(*cvt->row_offset) * cvt->samples);
+  if (!cvt->ch_offset || !cvt->wire_src || (planar && !cvt->row_offset)) {
+    err("%s, tables malloc fail\n", __func__);
+    st_pcm_converter_free(cvt);
+    return NULL;
+  }
+
+  cvt->flat = !planar && (app_channel == wire_channel);
+  for (uint16_t w = 0; w < wire_channel; w++) cvt->wire_src[w] = -1;
+  for (uint16_t c = 0; c < app_channel; c++) {
+    uint16_t w = map ? map[c] : c;
+
+    if (w >= wire_channel) {
+      err("%s, app channel %u map to %u, over the channel %u\n", __func__, c, w,
+          wire_channel);
+      st_pcm_converter_free(cvt);
+      return NULL;
+    }
+    if (w != c) cvt->flat = false;
+    cvt->ch_offset[c] = w * cvt->sample_size;
+    /* more app channels of one wire channel only for the rx, the tx takes the first */
+    if (cvt->wire_src[w] < 0) cvt->wire_src[w] = planar ? c * cvt->samples : c;
+  }
+  if (planar) {
+    for (uint32_t s = 0; s < cvt->samples; s++) cvt->row_offset[s] = s * row_size;
+  }
+
+  dbg("%s, %s %u ch to %s %u ch %s, %u samples%s\n", __func__,
+      (wire_fmt == ST30_FMT_PCM8) ? "pcm8"
+                                  : ((wire_fmt == ST30_FMT_PCM16) ? "pcm16" : "pcm24"),
+      wire_channel, (app_fmt == ST30P_SAMPLE_FMT_F32) ? "f32" : "s32", app_channel,
+      planar ? "planar" : "interleaved", cvt->samples, cvt->flat ? ", flat" : "");
+  return cvt;
+}
+
+int st_pcm_converter_to_app(struct st_pcm_converter* cvt, const void* wire, void* app) {
+  const uint8_t* src = wire;
+  size_t row_size = (size_t)cvt->sample_size * cvt->wire_channel;
+  int ret;
+
+  if (cvt->flat)
+    return st_pcm_to_app_simd(src, app, cvt->samples * cvt->wire_channel, cvt->wire_fmt,
+                              cvt->app_fmt, cvt->simd_level);
+
+  if (cvt->planar) {
+    uint8_t* dst = app;
+    size_t plane_size = (size_t)cvt->samples * sizeof(int32_t);
+
+    for (uint16_t c = 0; c < cvt->app_channel; c++) {
+      ret = st_pcm_gather_to_app_simd(
+          src + cvt->ch_offset[c], cvt->row_offset, cvt->samples,
+          cvt->wire_frame_size - cvt->ch_offset[c], dst + plane_size * c, cvt->wire_fmt,
+          cvt->app_fmt, cvt->simd_level);
+      if (ret < 0) return ret;
+    }
+    return 0;
+  }
+
+  for (uint32_t s = 0; s < cvt->samples; s++) {
+    int32_t* dst = (int32_t*)app + (size_t)s * cvt->app_channel;
+
+    ret = st_pcm_gather_to_app_simd(src + row_size * s, cvt->ch_offset, cvt->app_channel,
+                                    cvt->wire_frame_size - row_size * s, dst,
+                                    cvt->wire_fmt, cvt->app_fmt, cvt->simd_level);
+    if (ret < 0) return ret;
+  }
+  return 0;
+}
+
+int st_pcm_converter_to_wire(struct st_pcm_converter* cvt, const void* app, void* wire) {
+  uint8_t* dst = wire;
+  size_t row_size = (size_t)cvt->sample_size * cvt->wire_channel;
+  int ret;
+
+  if (cvt->flat)
+    return st_pcm_to_wire_simd(app, dst, cvt->samples * cvt->wire_channel, cvt->wire_fmt,
+                               cvt->app_fmt, cvt->simd_level);
+
+  for (uint32_t s = 0; s < cvt->samples; s++) {
+    /* the app sample of the row, the wire_src is the channel index for interleaved and
+     * the plane start for planar */
+    const int32_t* src =
+        (const int32_t*)app + (cvt->planar ? s : (size_t)s * cvt->app_channel);
+
+    ret = st_pcm_gather_to_wire_simd(src, cvt->wire_src, cvt->wire_channel,
+                                     dst + row_size * s, cvt->wire_fmt, cvt->app_fmt,
+                                     cvt->simd_level);
+    if (ret < 0) return ret;
+  }
+  return 0;
+}
+
+int st30p_sample_to_app_simd(enum st30_fmt fmt, uint16_t channel, const void* wire,
+                             size_t wire_size, enum st30p_sample_fmt app_fmt, bool planar,
+                             void* app, enum mtl_simd_level level) {
+  struct st_pcm_converter* cvt;
+  int ret;
+
+  cvt = st_pcm_converter_create(fmt, channel, wire_size, app_fmt, planar, 0, NULL);
+  if (!cvt) return -EINVAL;
+  cvt->simd_level = level;
+  ret = st_pcm_converter_to_app(cvt, wire, app);
+  st_pcm_converter_free(cvt);
+  return ret;
+}
+
+int st30p_sample_to_wire_simd(enum st30_fmt fmt, uint16_t channel, const void* app,
+                              enum st30p_sample_fmt app_fmt, bool planar, void* wire,
+                              size_t wire_size, enum mtl_simd_level level) {
+  struct st_pcm_converter* cvt;
+  int ret;
+
+  cvt = st_pcm_converter_create(fmt, channel, wire_size, app_fmt, planar, 0, NULL);
+  if (!cvt) return -EINVAL;
+  cvt->simd_level = level;
+  ret = st_pcm_converter_to_wire(cvt, app, wire);
+  st_pcm_converter_free(cvt);
+  return ret;
+}
@@ -0,0 +1,129 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#ifndef _ST_LIB_PCM_CONVERT_HEAD_H_
+#define _ST_LIB_PCM_CONVERT_HEAD_H_
+
+#include <math.h>
+
+#include "st30_pipeline_api.h"
+#include "st_main.h"
+
+/*
+ * The conversion between the big endian PCM of the wire and the 32 bit samples of the
+ * app. S32 keeps the wire sample in the msb bits, F32 is the S32 value scaled by 2^-31,
+ * both are exact. To the wire, S32 drops the lsb bits and F32 is clamped to the full
+ * scale then rounded to the nearest even, same as the cvtps2dq of the SIMD kernels.
+ * PCM8 is offset binary(L8), PCM16 and PCM24 are two's complement.
+ */
+
+struct st_pcm_converter {
+  enum st30_fmt wire_fmt;
+  uint8_t sample_size; /* bytes of one wire sample */
+  uint16_t wire_channel;
+  enum st30p_sample_fmt app_fmt;
+  bool planar;
+  uint16_t app_channel;
+  uint32_t samples; /* samples of each channel in one frame */
+  size_t wire_frame_size;
+  size_t app_frame_size;
+  /* interleaved app frames with the 1:1 channels, one flat run of the frame */
+  bool flat;
+  enum mtl_simd_level simd_level;
+
+  /* to app, the byte offset of the wire sample in a sample row for each app channel */
+  int32_t* ch_offset;
+  /* to app, the byte offset of each sample row in the wire frame, for planar */
+  int32_t* row_offset;
+  /* to wire, the app sample index in a row for each wire channel, -1 for silence */
+  int32_t* wire_src;
+};
+
+bool st_pcm_convert_fmt_supported(enum st30_fmt fmt);
+
+static inline uint8_t st_pcm_bits(enum st30_fmt fmt) {
+  return (fmt == ST30_FMT_PCM8) ? 8 : ((fmt == ST30_FMT_PCM16) ? 16 : 24);
+}
+
+/* the wire sample to the s32 app sample */
+static inline int32_t st_pcm_load(const uint8_t* p, enum st30_fmt fmt) {
+  if (fmt == ST30_FMT_PCM8) return (int32_t)((uint32_t)(p[0] ^ 0x80) << 24);
+  if (fmt == ST30_FMT_PCM16)
+    return (int32_t)((uint32_t)p[0] << 24 | (uint32_t)p[1] << 16);
+  return (int32_t)((uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8);
+}
+
+static inline void st_pcm_app_store(void* dst, uint32_t i, int32_t v,
+                                    enum st30p_sample_fmt app_fmt) {
+  if (app_fmt == ST30P_SAMPLE_FMT_F32)
+    ((float*)dst)[i] = (float)v * (1.0f / 2147483648.0f);
+  else
+    ((int32_t*)dst)[i] = v;
+}
+
+/* the app sample to the wire sample value of the bits */
+static inline int32_t st_pcm_app_load(const void* src, int32_t i, enum st30_fmt fmt,
+                                      enum st30p_sample_fmt app_fmt) {
+  uint8_t bits = st_pcm_bits(fmt);
+
+  if (i < 0) return 0; /* silence */
+  if (app_fmt == ST30P_SAMPLE_FMT_F32) {
+    float scale = (float)(1u << (bits - 1));
+    float hi = 1.0f - 1.0f / scale;
+    float f = ((const float*)src)[i];
+    /* the operand order of maxps/minps, a NaN goes to -1.0 */
+    f = (f > -1.0f) ? f : -1.0f;
+    f = (f < hi) ? f : hi;
+    return (int32_t)lrintf(f * scale);
+  }
+  return ((const int32_t*)src)[i] >> (32 - bits);
+}
+
+static inline void st_pcm_store(uint8_t* p, int32_t v, enum st30_fmt fmt) {
+  if (fmt == ST30_FMT_PCM8) {
+    p[0] = (uint8_t)v ^ 0x80;
+  } else if (fmt == ST30_FMT_PCM16) {
+    p[0] = v >> 8;
+    p[1] = v;
+  } else {
+    p[0] = v >> 16;
+    p[1] = v >> 8;
+    p[2] = v;
+  }
+}
+
+/*
+ * The plan of the conversion for the frames of wire_frame_size bytes, map is the wire
+ * channel of each app channel, NULL for 1:1. Free with st_pcm_converter_free.
+ */
+struct st_pcm_converter* st_pcm_converter_create(enum st30_fmt wire_fmt,
+                                                 uint16_t wire_channel,
+                                                 size_t wire_frame_size,
+                                                 enum st30p_sample_fmt app_fmt,
+                                                 bool planar, uint16_t app_channel,
+                                                 const uint16_t* map);
+void st_pcm_converter_free(struct st_pcm_converter* cvt);
+
+int st_pcm_converter_to_app(struct st_pcm_converter* cvt, const void* wire, void* app);
+int st_pcm_converter_to_wire(struct st_pcm_converter* cvt, const void* app, void* wire);
+
+/* n wire samples at src to n app samples */
+int st_pcm_to_app_simd(const uint8_t* src, void* dst, uint32_t n, enum st30_fmt fmt,
+                       enum st30p_sample_fmt app_fmt, enum mtl_simd_level level);
+/*
+ * n wire samples at base + offset[i] to n app samples, no byte at or after base + limit
+ * is read.
+ */
+int st_pcm_gather_to_app_simd(const uint8_t* base, const int32_t* offset, uint32_t n,
+                              uint32_t limit, void* dst, enum st30_fmt fmt,
+                              enum st30p_sample_fmt app_fmt, enum mtl_simd_level level);
+/* n app samples at src to n wire samples */
+int st_pcm_to_wire_simd(const void* src, uint8_t* dst, uint32_t n, enum st30_fmt fmt,
+                        enum st30p_sample_fmt app_fmt, enum mtl_simd_level level);
+/* n app samples at base[idx[i]] to n wire samples, a negative idx is silence */
+int st_pcm_gather_to_wire_simd(const void* base, const int32_t* idx, uint32_t n,
+                               uint8_t* dst, enum st30_fmt fmt,
+                               enum st30p_sample_fmt app_fmt, enum mtl_simd_level level);
+
+#endif
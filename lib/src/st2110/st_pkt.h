@@ -90,4 +90,7 @@ struct st41_fmd_hdr {
 #define ST_PKT_MAX_ETHER_BYTES \
   (1460 + sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr))
 
+/* ST30_JUMBO_MTU for the audio jumbo frame sessions */
+#define ST_PKT_MAX_JUMBO_ETHER_BYTES (ST30_JUMBO_MTU + sizeof(struct rte_ether_hdr))
+
 #endif
@@ -202,7 +202,7 @@ static void rx_anc_slot_parse_pkt(struct st_rx_ancillary_session_impl* s,
   uint32_t payload_offset = 0;
 
   for (uint32_t anc_idx = 0; anc_idx < anc_count; anc_idx++) {
-    if (slot->meta_num >= ST40_MAX_META) {
+    if (slot->meta_num >= slot->meta_cap) {
       warn("%s(%d), meta slots exhausted at %u\n", __func__, s->idx, slot->meta_num);
       break;
     }
@@ -896,6 +896,10 @@ static int rx_ancillary_session_uinit_frames(struct st_rx_ancillary_session_impl
         mt_rte_free(s->frame_slots[i].udw_buf);
         s->frame_slots[i].udw_buf = NULL;
       }
+      if (s->frame_slots[i].meta) {
+        mt_rte_free(s->frame_slots[i].meta);
+        s->frame_slots[i].meta = NULL;
+      }
     }
     mt_rte_free(s->frame_slots);
     s->frame_slots = NULL;
@@ -907,6 +911,7 @@ static int rx_ancillary_session_uinit_frames(struct st_rx_ancillary_session_impl
 static int rx_ancillary_session_init_frames(struct st_rx_ancillary_session_impl* s) {
   uint16_t cnt = s->ops.framebuff_cnt;
   size_t buf_sz = s->ops.framebuff_size;
+  uint16_t meta_cap = s->ops.max_meta ? s->ops.max_meta : ST40_MAX_META;
   int idx = s->idx;
 
   s->frame_slots = mt_rte_zmalloc_socket(sizeof(*s->frame_slots) * cnt, s->socket_id);
@@ -928,9 +933,18 @@ static int rx_ancillary_session_init_frames(struct st_rx_ancillary_session_impl*
       rx_ancillary_session_uinit_frames(s);
       return -ENOMEM;
     }
+    slot->meta = mt_rte_zmalloc_socket(sizeof(*slot->meta) * meta_cap, s->socket_id);
+    if (!slot->meta) {
+      err("%s(%d), meta alloc fail (%u entries) for slot %u\n", __func__, idx, meta_cap,
+          i);
+      rx_ancillary_session_uinit_frames(s);
+      return -ENOMEM;
+    }
+    slot->meta_cap = meta_cap;
   }
 
-  info("%s(%d), %u frame slots, %zu bytes UDW each\n", __func__, idx, cnt, buf_sz);
+  info("%s(%d), %u frame slots, %zu bytes UDW and %u meta each\n", __func__, idx, cnt,
+       buf_sz, meta_cap);
   return 0;
 }
 
@@ -1294,11 +1308,11 @@ static int rx_ancillary_sessions_mgr_init(struct mtl_main_impl* impl,
   int idx = sch->idx;
   struct mtl_tasklet_ops ops;
 
-  /* rx_anc_slot_parse_pkt sums up to ST40_MAX_META entries of at most 0xFF
-   * (wire 8-bit data_count) bytes each into udw_buffer_fill, then narrows
-   * that running sum into st40_meta.udw_offset (uint16_t). Catch it at
-   * compile time if ST40_MAX_META ever grows enough to overflow that field. */
-  RTE_BUILD_BUG_ON(ST40_MAX_META * 0xFF > UINT16_MAX);
+  /* rx_anc_slot_parse_pkt sums up to ops.max_meta (at most ST40_MAX_META_DYNAMIC)
+   * entries of at most 0xFF (wire 8-bit data_count) bytes each into udw_buffer_fill,
+   * then narrows that running sum into st40_meta.udw_offset (uint16_t). Catch it at
+   * compile time if ST40_MAX_META_DYNAMIC ever grows enough to overflow that field. */
+  RTE_BUILD_BUG_ON(ST40_MAX_META_DYNAMIC * 0xFF > UINT16_MAX);
 
   mgr->parent = impl;
   mgr->idx = idx;
@@ -1512,6 +1526,11 @@ static int rx_ancillary_ops_check(struct st40_rx_ops* ops) {
       err("%s, FRAME_LEVEL: framebuff_size must be > 0\n", __func__);
       return -EINVAL;
     }
+    if (ops->max_meta > ST40_MAX_META_DYNAMIC) {
+      err("%s, FRAME_LEVEL: max_meta %u over %d\n", __func__, ops->max_meta,
+          ST40_MAX_META_DYNAMIC);
+      return -EINVAL;
+    }
   } else { /* ST40_TYPE_RTP_LEVEL */
     if (ops->rtp_ring_size <= 0) {
       err("%s, invalid rtp_ring_size %d\n", __func__, ops->rtp_ring_size);
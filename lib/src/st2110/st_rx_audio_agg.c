@@ -0,0 +1,612 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include "st_rx_audio_agg.h"
+
+#include "../mt_handle_guard.h"
+#include "../mt_log.h"
+#include "../mt_stat.h"
+
+#ifdef MTL_HAS_AVX2
+#include "st_avx2.h"
+#endif
+#ifdef MTL_HAS_AVX512
+#include "st_avx512.h"
+#endif
+
+/*
+ * The flows of the group are aligned by the rtp timestamp only, slot i of the open
+ * frames starts at base + i * ticks_per_frame. The packet of a later slot out of the
+ * open window closes the oldest slots in order, the missed packets are silence.
+ */
+
+int st_audio_scatter_rows_simd(const uint8_t* src, uint32_t src_row, uint32_t rows,
+                               uint8_t* dst, uint32_t dst_stride,
+                               enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(level);
+  MTL_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st_audio_scatter_rows_avx512(src, src_row, rows, dst, dst_stride);
+    if (ret == 0) return 0;
+    err("%s, avx512 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st_audio_scatter_rows_avx2(src, src_row, rows, dst, dst_stride);
+    if (ret == 0) return 0;
+    err("%s, avx2 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  for (uint32_t r = 0; r < rows; r++)
+    memcpy(dst + (size_t)r * dst_stride, src + (size_t)r * src_row, src_row);
+  return 0;
+}
+
+static inline uint8_t rx_audio_agg_silence(struct st_rx_audio_agg_impl* agg) {
+  /* PCM8 is offset binary, zero bytes for the others */
+  return (agg->ops.fmt == ST30_FMT_PCM8) ? 0x80 : 0;
+}
+
+static inline uint64_t rx_audio_agg_pkts_mask(struct st_rx_audio_agg_impl* agg) {
+  return (agg->pkts_per_frame >= 64) ? ~0ULL : ((1ULL << agg->pkts_per_frame) - 1);
+}
+
+static struct st_frame_trans* rx_audio_agg_get_frame(struct st_rx_audio_agg_impl* agg) {
+  struct st_frame_trans* frame_info;
+
+  for (int i = 0; i < agg->frames_cnt; i++) {
+    frame_info = &agg->frames[i];
+
+    if (0 == rte_atomic32_read(&frame_info->refcnt)) {
+      dbg("%s(%s), find frame at %d\n", __func__, agg->ops_name, i);
+      rte_atomic32_inc(&frame_info->refcnt);
+      return frame_info;
+    }
+  }
+
+  dbg("%s(%s), no free frame\n", __func__, agg->ops_name);
+  return NULL;
+}
+
+static void rx_audio_agg_put_frame(struct st_rx_audio_agg_impl* agg,
+                                   struct st_frame_trans* frame) {
+  MTL_MAY_UNUSED(agg);
+  dbg("%s(%s), put frame at %d\n", __func__, agg->ops_name, frame->idx);
+  rte_atomic32_dec(&frame->refcnt);
+}
+
+/* the rows of the flow in the missed packets of the slot to silence */
+static void rx_audio_agg_flow_silence(struct st_rx_audio_agg_impl* agg,
+                                      struct st_rx_audio_agg_slot* slot,
+                                      struct st_rx_audio_agg_flow* flow,
+                                      uint64_t missed) {
+  uint8_t silence = rx_audio_agg_silence(agg);
+
+  while (missed) {
+    uint32_t pkt = __builtin_ctzll(missed);
+    uint8_t* dst = (uint8_t*)slot->frame->addr +
+                   (size_t)pkt * agg->samples_per_pkt * agg->row_size +
+                   (size_t)flow->channel_offset * agg->sample_size;
+
+    for (uint32_t r = 0; r < agg->samples_per_pkt; r++)
+      memset(dst + (size_t)r * agg->row_size, silence, flow->row_size);
+    missed &= missed - 1;
+  }
+}
+
+static void rx_audio_agg_fill_silence(struct st_rx_audio_agg_impl* agg,
+                                      struct st_rx_audio_agg_slot* slot) {
+  uint64_t all = rx_audio_agg_pkts_mask(agg);
+
+  for (int f = 0; f < ST30_RX_AGG_FLOWS_MAX; f++) {
+    struct st_rx_audio_agg_flow* flow = &agg->flows[f];
+
+    if (!flow->attached) continue;
+    rx_audio_agg_flow_silence(agg, slot, flow, ~slot->pkt_bitmap[f] & all);
+  }
+}
+
+/* the frames closed by one packet, notified to the app after the lock is released */
+struct rx_audio_agg_ready {
+  struct st_frame_trans* frame;
+  struct st30_rx_agg_frame_meta meta;
+};
+
+struct rx_audio_agg_done {
+  uint32_t cnt;
+  /* one window by a resync, one more by the packet */
+  struct rx_audio_agg_ready ready[ST_RX_AUDIO_AGG_OPEN_MAX * 2];
+};
+
+/* build the meta of the closed slot, with the lock held */
+static void rx_audio_agg_slot_ready(struct st_rx_audio_agg_impl* agg,
+                                    struct st_rx_audio_agg_slot* slot, uint32_t rtp_ts,
+                                    struct rx_audio_agg_done* done) {
+  struct st30_rx_agg_ops* ops = &agg->ops;
+  struct rx_audio_agg_ready* ready = &done->ready[done->cnt++];
+  struct st30_rx_agg_frame_meta* meta = &ready->meta;
+  uint64_t all = rx_audio_agg_pkts_mask(agg);
+  uint64_t complete = 0;
+
+  for (int f = 0; f < ST30_RX_AGG_FLOWS_MAX; f++) {
+    if (agg->flows[f].attached && (slot->pkt_bitmap[f] == all)) complete |= 1ULL << f;
+  }
+
+  ready->frame = slot->frame;
+  memset(meta, 0, sizeof(*meta));
+  meta->tfmt = ST10_TIMESTAMP_FMT_MEDIA_CLK;
+  meta->timestamp = rtp_ts;
+  meta->timestamp_first_pkt = slot->first_pkt_ptp_ts;
+  meta->fmt = ops->fmt;
+  meta->sampling = ops->sampling;
+  meta->channel = ops->channel;
+  meta->rtp_timestamp = rtp_ts;
+  meta->frame_recv_size = slot->recv_size;
+  meta->flow_cnt = agg->flow_cnt;
+  meta->flows_complete = complete;
+  if (slot->recv_size >= agg->frame_expect_size) {
+    meta->status = ST_FRAME_STATUS_COMPLETE;
+  } else {
+    rx_audio_agg_fill_silence(agg, slot);
+    meta->status = ST_FRAME_STATUS_CORRUPTED;
+    agg->stat_frames_incomplete++;
+  }
+  agg->stat_frames_received++;
+}
+
+static void rx_audio_agg_notify(struct st_rx_audio_agg_impl* agg,
+                                struct rx_audio_agg_ready* ready) {
+  struct st30_rx_agg_ops* ops = &agg->ops;
+  int ret;
+
+  ret = ops->notify_frame_ready(ops->priv, ready->frame->addr, &ready->meta);
+  if (ret < 0) {
+    warn("%s(%s), notify_frame_ready return fail %d\n", __func__, agg->ops_name, ret);
+    rx_audio_agg_put_frame(agg, ready->frame);
+  }
+}
+
+/* close the first n open slots in order and move the window, with the lock held */
+static void rx_audio_agg_close(struct st_rx_audio_agg_impl* agg, uint32_t n,
+                               struct rx_audio_agg_done* done) {
+  uint32_t closed = RTE_MIN(n, ST_RX_AUDIO_AGG_OPEN_MAX);
+
+  for (uint32_t i = 0; i < closed; i++) {
+    struct st_rx_audio_agg_slot* slot = &agg->slots[i];
+    if (slot->frame)
+      rx_audio_agg_slot_ready(agg, slot, agg->base + i * agg->ticks_per_frame, done);
+  }
+
+  memmove(&agg->slots[0], &agg->slots[closed],
+          sizeof(agg->slots[0]) * (ST_RX_AUDIO_AGG_OPEN_MAX - closed));
+  memset(&agg->slots[ST_RX_AUDIO_AGG_OPEN_MAX - closed], 0,
+         sizeof(agg->slots[0]) * closed);
+  agg->base += n * agg->ticks_per_frame;
+}
+
+int st_rx_audio_agg_put_pkt(struct st_rx_audio_agg_impl* agg, int flow, uint32_t tmstamp,
+                            const void* payload, uint64_t ptp_ts, uint32_t* base) {
+  struct st_rx_audio_agg_flow* f = &agg->flows[flow];
+  struct st_rx_audio_agg_slot* slot;
+  struct rx_audio_agg_done done;
+  uint32_t idx, offset, pkt;
+  uint8_t* dst;
+  int32_t delta;
+  int ret = 0;
+
+  done.cnt = 0;
+  rte_spinlock_lock(&agg->lock);
+
+  if (!agg->synced) {
+    agg->base = tmstamp;
+    agg->synced = true;
+  }
+
+  delta = (int32_t)(tmstamp - agg->base);
+  if (st_rx_audio_agg_far_behind(agg, tmstamp, agg->base)) {
+    /*
+     * far behind, the media clock of the senders went back. Resync once a frame of
+     * packets in a row is behind, a single late flow is dropped as the others go on.
+     */
+    if (!agg->behind_cnt) agg->behind_ts = tmstamp;
+    if (++agg->behind_cnt < agg->pkts_per_frame) {
+      agg->stat_pkts_late++;
+      ret = -EAGAIN;
+      goto out;
+    }
+    info("%s(%s), resync as flow %d tmstamp %u back from base %u\n", __func__,
+         agg->ops_name, flow, tmstamp, agg->base);
+    rx_audio_agg_close(agg, ST_RX_AUDIO_AGG_OPEN_MAX, &done);
+    agg->base = agg->behind_ts;
+    delta = (int32_t)(tmstamp - agg->base);
+    if (delta < 0) { /* the clock went back again in between */
+      agg->base = tmstamp;
+      delta = 0;
+    }
+  } else if (delta < 0) {
+    dbg("%s(%s), flow %d tmstamp %u late to base %u\n", __func__, agg->ops_name, flow,
+        tmstamp, agg->base);
+    agg->stat_pkts_late++;
+    ret = -EAGAIN;
+    goto out;
+  }
+  agg->behind_cnt = 0;
+  idx = (uint32_t)delta / agg->ticks_per_frame;
+  offset = (uint32_t)delta % agg->ticks_per_frame;
+  if (offset % agg->samples_per_pkt) {
+    dbg("%s(%s), flow %d tmstamp %u not on the packet grid\n", __func__, agg->ops_name,
+        flow, tmstamp);
+    agg->stat_pkts_misaligned++;
+    ret = -EINVAL;
+    goto out;
+  }
+
+  if (idx >= ST_RX_AUDIO_AGG_OPEN_MAX * 2) {
+    /* a jump of the media clock, close all and resync to this packet */
+    info("%s(%s), resync as flow %d tmstamp %u jump from base %u\n", __func__,
+         agg->ops_name, flow, tmstamp, agg->base);
+    rx_audio_agg_close(agg, ST_RX_AUDIO_AGG_OPEN_MAX, &done);
+    agg->base = tmstamp - offset;
+    idx = 0;
+  } else if (idx >= ST_RX_AUDIO_AGG_OPEN_MAX) {
+    uint32_t n = idx - ST_RX_AUDIO_AGG_OPEN_MAX + 1;
+    rx_audio_agg_close(agg, n, &done);
+    idx -= n;
+  }
+
+  slot = &agg->slots[idx];
+  if (!slot->frame) {
+    slot->frame = rx_audio_agg_get_frame(agg);
+    if (!slot->frame) {
+      agg->stat_no_framebuffer++;
+      ret = -EIO;
+      goto out;
+    }
+    slot->first_pkt_ptp_ts = ptp_ts;
+    if (agg->has_gap)
+      memset(slot->frame->addr, rx_audio_agg_silence(agg), agg->frame_size);
+  }
+
+  pkt = offset / agg->samples_per_pkt;
+  if (slot->pkt_bitmap[flow] & (1ULL << pkt)) {
+    agg->stat_pkts_redundant++;
+    goto out;
+  }
+  slot->pkt_bitmap[flow] |= 1ULL << pkt;
+
+  dst = (uint8_t*)slot->frame->addr + (size_t)offset * agg->row_size +
+        (size_t)f->channel_offset * agg->sample_size;
+  st_audio_scatter_rows_simd(payload, f->row_size, agg->samples_per_pkt, dst,
+                             agg->row_size, agg->simd_level);
+  slot->recv_size += (size_t)f->row_size * agg->samples_per_pkt;
+  agg->stat_pkts_received++;
+
+  /* all the flows are in, the older slots are closed also to keep the order */
+  if (slot->recv_size >= agg->frame_expect_size) rx_audio_agg_close(agg, idx + 1, &done);
+
+out:
+  *base = agg->base;
+  /* the callback may take long, only a packet closing the next frames waits for it */
+  if (done.cnt) rte_spinlock_lock(&agg->notify_lock);
+  rte_spinlock_unlock(&agg->lock);
+  if (done.cnt) {
+    for (uint32_t i = 0; i < done.cnt; i++) rx_audio_agg_notify(agg, &done.ready[i]);
+    rte_spinlock_unlock(&agg->notify_lock);
+  }
+  return ret;
+}
+
+static void rx_audio_agg_update_expect(struct st_rx_audio_agg_impl* agg) {
+  uint32_t channels = 0;
+
+  for (int f = 0; f < ST30_RX_AGG_FLOWS_MAX; f++) {
+    if (agg->flows[f].attached) channels += agg->flows[f].channel;
+  }
+  agg->frame_expect_size = (size_t)channels * agg->sample_size * agg->ticks_per_frame;
+  agg->has_gap = (channels != agg->ops.channel);
+}
+
+int st_rx_audio_agg_attach(struct st_rx_audio_agg_impl* agg, struct st30_rx_ops* ops) {
+  uint16_t offset = ops->agg_channel_offset;
+  int flow = -1;
+
+  MT_HANDLE_GUARD(agg, MT_HANDLE_RX_AUDIO_AGG, -EIO);
+
+  if ((ops->fmt != agg->ops.fmt) || (ops->sampling != agg->ops.sampling) ||
+      (ops->ptime != agg->ops.ptime)) {
+    err("%s(%s), fmt %d sampling %d ptime %d not same as the group\n", __func__,
+        agg->ops_name, ops->fmt, ops->sampling, ops->ptime);
+    flow = -EINVAL;
+    goto out;
+  }
+  if (!ops->channel || ((uint32_t)offset + ops->channel > agg->ops.channel)) {
+    err("%s(%s), channel %u at offset %u out of the group channel %u\n", __func__,
+        agg->ops_name, ops->channel, offset, agg->ops.channel);
+    flow = -EINVAL;
+    goto out;
+  }
+
+  rte_spinlock_lock(&agg->lock);
+  for (int f = 0; f < ST30_RX_AGG_FLOWS_MAX; f++) {
+    struct st_rx_audio_agg_flow* exist = &agg->flows[f];
+    if (!exist->attached) {
+      if (flow < 0) flow = f;
+      continue;
+    }
+    if ((offset < exist->channel_offset + exist->channel) &&
+        (exist->channel_offset < offset + ops->channel)) {
+      err("%s(%s), channel %u at offset %u overlap with flow %d\n", __func__,
+          agg->ops_name, ops->channel, offset, f);
+      flow = -EINVAL;
+      break;
+    }
+  }
+  if (flow >= 0) {
+    struct st_rx_audio_agg_flow* f = &agg->flows[flow];
+    f->attached = true;
+    f->channel = ops->channel;
+    f->channel_offset = offset;
+    f->row_size = (uint32_t)ops->channel * agg->sample_size;
+    agg->flow_cnt++;
+    rx_audio_agg_update_expect(agg);
+  } else if (flow == -1) {
+    err("%s(%s), all %d flows are used\n", __func__, agg->ops_name,
+        ST30_RX_AGG_FLOWS_MAX);
+    flow = -ENOSPC;
+  }
+  rte_spinlock_unlock(&agg->lock);
+
+  if (flow >= 0)
+    info("%s(%s), flow %d channel %u at offset %u\n", __func__, agg->ops_name, flow,
+         ops->channel, offset);
+out:
+  MT_HANDLE_RELEASE(agg);
+  return flow;
+}
+
+void st_rx_audio_agg_detach(struct st_rx_audio_agg_impl* agg, int flow) {
+  struct st_rx_audio_agg_flow* f = &agg->flows[flow];
+
+  rte_spinlock_lock(&agg->lock);
+  /* drop the packets of the flow from the open frames, its channels are silence */
+  for (int i = 0; i < ST_RX_AUDIO_AGG_OPEN_MAX; i++) {
+    struct st_rx_audio_agg_slot* slot = &agg->slots[i];
+    uint64_t recv = slot->pkt_bitmap[flow];
+
+    if (!recv) continue;
+    slot->recv_size -=
+        (size_t)__builtin_popcountll(recv) * f->row_size * agg->samples_per_pkt;
+    if (slot->frame) rx_audio_agg_flow_silence(agg, slot, f, recv);
+    slot->pkt_bitmap[flow] = 0;
+  }
+  f->attached = false;
+  agg->flow_cnt--;
+  rx_audio_agg_update_expect(agg);
+  rte_spinlock_unlock(&agg->lock);
+  info("%s(%s), flow %d\n", __func__, agg->ops_name, flow);
+}
+
+static int rx_audio_agg_stat(void* priv) {
+  struct st_rx_audio_agg_impl* agg = priv;
+
+  notice("RX_AUDIO_AGG(%s), flows %u frames %" PRIu64 " incomplete %" PRIu64
+         " pkts %" PRIu64 "\n",
+         agg->ops_name, agg->flow_cnt, agg->stat_frames_received,
+         agg->stat_frames_incomplete, agg->stat_pkts_received);
+  agg->stat_frames_received = 0;
+  agg->stat_frames_incomplete = 0;
+  agg->stat_pkts_received = 0;
+
+  if (agg->stat_pkts_late || agg->stat_pkts_misaligned || agg->stat_pkts_redundant) {
+    notice("RX_AUDIO_AGG(%s), pkts late %" PRIu64 " misaligned %" PRIu64
+           " redundant %" PRIu64 "\n",
+           agg->ops_name, agg->stat_pkts_late, agg->stat_pkts_misaligned,
+           agg->stat_pkts_redundant);
+    agg->stat_pkts_late = 0;
+    agg->stat_pkts_misaligned = 0;
+    agg->stat_pkts_redundant = 0;
+  }
+  if (agg->stat_no_framebuffer) {
+    warn("RX_AUDIO_AGG(%s), no framebuffer %" PRIu64 "\n", agg->ops_name,
+         agg->stat_no_framebuffer);
+    agg->stat_no_framebuffer = 0;
+  }
+  return 0;
+}
+
+static void rx_audio_agg_free_frames(struct st_rx_audio_agg_impl* agg) {
+  if (!agg->frames) return;
+
+  for (int i = 0; i < agg->frames_cnt; i++) st_frame_trans_uinit(&agg->frames[i], NULL);
+  mt_rte_free(agg->frames);
+  agg->frames = NULL;
+}
+
+static int rx_audio_agg_alloc_frames(struct st_rx_audio_agg_impl* agg) {
+  int soc_id = agg->socket_id;
+
+  agg->frames = mt_rte_zmalloc_socket(sizeof(*agg->frames) * agg->frames_cnt, soc_id);
+  if (!agg->frames) {
+    err("%s(%s), frames alloc fail\n", __func__, agg->ops_name);
+    return -ENOMEM;
+  }
+
+  for (int i = 0; i < agg->frames_cnt; i++) {
+    struct st_frame_trans* frame_info = &agg->frames[i];
+    void* frame;
+
+    rte_atomic32_set(&frame_info->refcnt, 0);
+    frame_info->idx = i;
+    frame = mt_rte_zmalloc_socket(agg->frame_size, soc_id);
+    if (!frame) {
+      err("%s(%s), frame malloc %" PRIu64 " fail for %d\n", __func__, agg->ops_name,
+          agg->frame_size, i);
+      rx_audio_agg_free_frames(agg);
+      return -ENOMEM;
+    }
+    frame_info->flags = ST_FT_FLAG_RTE_MALLOC;
+    frame_info->addr = frame;
+    frame_info->iova = rte_malloc_virt2iova(frame);
+  }
+
+  return 0;
+}
+
+static int rx_audio_agg_ops_check(struct st30_rx_agg_ops* ops) {
+  int pkt_len;
+
+  if (!ops->channel) {
+    err("%s, invalid channel %u\n", __func__, ops->channel);
+    return -EINVAL;
+  }
+  if (ops->framebuff_cnt < 1) {
+    err("%s, invalid framebuff_cnt %d\n", __func__, ops->framebuff_cnt);
+    return -EINVAL;
+  }
+  if (!ops->notify_frame_ready) {
+    err("%s, pls set notify_frame_ready\n", __func__);
+    return -EINVAL;
+  }
+
+  pkt_len = st30_get_packet_size(ops->fmt, ops->ptime, ops->sampling, ops->channel);
+  if (pkt_len <= 0) {
+    err("%s, invalid fmt %d ptime %d sampling %d\n", __func__, ops->fmt, ops->ptime,
+        ops->sampling);
+    return -EINVAL;
+  }
+  if (!ops->framebuff_size || (ops->framebuff_size % pkt_len) ||
+      (ops->framebuff_size / pkt_len > 64)) {
+    err("%s, framebuff_size %u not 1 to 64 multiple of pkt_len %d\n", __func__,
+        ops->framebuff_size, pkt_len);
+    return -EINVAL;
+  }
+
+  return 0;
+}
+
+st30_rx_agg_handle st30_rx_agg_create(mtl_handle mt, struct st30_rx_agg_ops* ops) {
+  struct mtl_main_impl* impl = mt;
+  struct st_rx_audio_agg_impl* agg;
+  int socket, ret;
+
+  notice("%s, start for %s\n", __func__, mt_string_safe(ops->name));
+
+  if (impl->type != MT_HANDLE_MAIN) {
+    err("%s, invalid type %d\n", __func__, impl->type);
+    return NULL;
+  }
+
+  ret = rx_audio_agg_ops_check(ops);
+  if (ret < 0) {
+    err("%s, rx_audio_agg_ops_check fail %d\n", __func__, ret);
+    return NULL;
+  }
+
+  socket = mt_socket_id(impl, MTL_PORT_P);
+  agg = mt_rte_zmalloc_socket(sizeof(*agg), socket);
+  if (!agg) {
+    err("%s, agg malloc fail on socket %d\n", __func__, socket);
+    return NULL;
+  }
+
+  agg->parent = impl;
+  agg->socket_id = socket;
+  agg->ops = *ops;
+  if (ops->name) {
+    snprintf(agg->ops_name, sizeof(agg->ops_name), "%s", ops->name);
+  } else {
+    snprintf(agg->ops_name, sizeof(agg->ops_name), "RX_AUDIO_AGG_%p", agg);
+  }
+  agg->ops.name = agg->ops_name;
+  rte_spinlock_init(&agg->lock);
+  rte_spinlock_init(&agg->notify_lock);
+
+  agg->sample_size = st30_get_sample_size(ops->fmt);
+  agg->row_size = (uint32_t)agg->sample_size * ops->channel;
+  agg->samples_per_pkt = st30_get_sample_num(ops->ptime, ops->sampling);
+  agg->pkts_per_frame = ops->framebuff_size / (agg->samples_per_pkt * agg->row_size);
+  agg->ticks_per_frame = agg->samples_per_pkt * agg->pkts_per_frame;
+  agg->frame_size = ops->framebuff_size;
+  agg->frames_cnt = ops->framebuff_cnt;
+  agg->simd_level = mtl_get_simd_level();
+  rx_audio_agg_update_expect(agg);
+
+  ret = rx_audio_agg_alloc_frames(agg);
+  if (ret < 0) {
+    mt_rte_free(agg);
+    return NULL;
+  }
+
+  agg->type = MT_HANDLE_RX_AUDIO_AGG;
+  mt_stat_register(impl, rx_audio_agg_stat, agg, agg->ops_name);
+
+  notice("%s(%s), channel %u, %u pkts %u samples each in frame of %" PRIu64 " bytes\n",
+         __func__, agg->ops_name, ops->channel, agg->pkts_per_frame,
+         agg->samples_per_pkt, agg->frame_size);
+  return agg;
+}
+
+int st30_rx_agg_free(st30_rx_agg_handle handle) {
+  struct st_rx_audio_agg_impl* agg = handle;
+  uint16_t flow_cnt;
+
+  if (agg->type != MT_HANDLE_RX_AUDIO_AGG) {
+    err("%s, invalid type %d\n", __func__, agg->type);
+    return -EIO;
+  }
+
+  rte_spinlock_lock(&agg->lock);
+  flow_cnt = agg->flow_cnt;
+  rte_spinlock_unlock(&agg->lock);
+  if (flow_cnt) {
+    err("%s(%s), still %u flows, free the rx sessions first\n", __func__, agg->ops_name,
+        flow_cnt);
+    return -EBUSY;
+  }
+
+  int _gd =
+      mt_handle_begin_destroy(&agg->lc_destroying, &agg->type, MT_HANDLE_RX_AUDIO_AGG);
+  if (_gd < 0) {
+    if (_gd == -EIO) err("%s, invalid type %d\n", __func__, agg->type);
+    return _gd;
+  }
+  mt_handle_drain(&agg->lc_refcnt);
+
+  notice("%s(%s), start\n", __func__, agg->ops_name);
+  mt_stat_unregister(agg->parent, rx_audio_agg_stat, agg);
+  rx_audio_agg_free_frames(agg);
+  mt_rte_free(agg);
+  return 0;
+}
+
+int st30_rx_agg_put_framebuff(st30_rx_agg_handle handle, void* frame) {
+  struct st_rx_audio_agg_impl* agg = handle;
+  int ret = -EIO;
+
+  MT_HANDLE_GUARD(agg, MT_HANDLE_RX_AUDIO_AGG, -EIO);
+
+  for (int i = 0; i < agg->frames_cnt; i++) {
+    if (agg->frames[i].addr == frame) {
+      rx_audio_agg_put_frame(agg, &agg->frames[i]);
+      ret = 0;
+      goto out;
+    }
+  }
+
+  err("%s(%s), invalid frame %p\n", __func__, agg->ops_name, frame);
+out:
+  MT_HANDLE_RELEASE(agg);
+  return ret;
+}
@@ -0,0 +1,33 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#ifndef _ST_LIB_RX_AUDIO_AGG_HEAD_H_
+#define _ST_LIB_RX_AUDIO_AGG_HEAD_H_
+
+#include "st_main.h"
+
+/* join the group with the flow of the rx session ops, return the flow index */
+int st_rx_audio_agg_attach(struct st_rx_audio_agg_impl* agg, struct st30_rx_ops* ops);
+void st_rx_audio_agg_detach(struct st_rx_audio_agg_impl* agg, int flow);
+
+/*
+ * one packet payload of the flow at the rtp tmstamp into the group frames, base is set
+ * to the rtp timestamp of the oldest open frame after the packet
+ */
+int st_rx_audio_agg_put_pkt(struct st_rx_audio_agg_impl* agg, int flow, uint32_t tmstamp,
+                            const void* payload, uint64_t ptp_ts, uint32_t* base);
+
+/* the tmstamp is far behind the base, a step back of the media clock of the senders */
+static inline bool st_rx_audio_agg_far_behind(struct st_rx_audio_agg_impl* agg,
+                                              uint32_t tmstamp, uint32_t base) {
+  return (int32_t)(tmstamp - base) <
+         -(int32_t)(agg->ticks_per_frame * ST_RX_AUDIO_AGG_OPEN_MAX * 2);
+}
+
+/* copy rows of src_row bytes from the packed src to dst with the dst_stride */
+int st_audio_scatter_rows_simd(const uint8_t* src, uint32_t src_row, uint32_t rows,
+                               uint8_t* dst, uint32_t dst_stride,
+                               enum mtl_simd_level level);
+
+#endif
@@ -0,0 +1,357 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include "st_rx_audio_meter.h"
+
+#include <math.h>
+
+#include "../mt_log.h"
+#include "st_avx2.h"
+#include "st_avx512.h"
+#include "st_pcm_convert.h"
+
+/*
+ * The payload is decoded to the float rows of the packet while it is hot in the cache,
+ * the AM824 subframe as the 24 bit sample after the label byte. The rows kernel runs
+ * over the channels in the vector lanes: the peak, the sum of squares, the K-weighting
+ * biquads of ITU-R BS.1770 for the loudness and the 4 phases of the BS.1770 annex 2
+ * fir for the true peak, which reads the 11 rows before the packet. The K-weighting is
+ * designed for the session sample rate, the biquad states are in float.
+ *
+ * Each block of 100ms closes with the levels of all the channels published under the
+ * seqlock, the momentary loudness is from the last 4 blocks. The packets are metered
+ * in the arrival order, a lost packet is simply skipped.
+ */
+
+#define ST_AUDIO_METER_READ_RETRY (16)
+/* the biquad states below are flushed at the block end, no denormal in the silence */
+#define ST_AUDIO_METER_DENORMAL (1e-20f)
+
+/* ITU-R BS.1770-4 annex 2, the 48 taps of the 4x oversampling in 4 phases */
+static const float meter_tp_coef[ST_AUDIO_METER_TP_PHASES][ST_AUDIO_METER_TP_TAPS] = {
+    {0.0017089843750f, 0.0109863281250f, -0.0196533203125f, 0.0332031250000f,
+     -0.0594482421875f, 0.1373291015625f, 0.9721679687500f, -0.1022949218750f,
+     0.0476074218750f, -0.0266113281250f, 0.0148925781250f, -0.0083007812500f},
+    {-0.0291748046875f, 0.0292968750000f, -0.0517578125000f, 0.0891113281250f,
+     -0.1665039062500f, 0.4650878906250f, 0.7797851562500f, -0.2003173828125f,
+     0.1015625000000f, -0.0582275390625f, 0.0330810546875f, -0.0189208984375f},
+    {-0.0189208984375f, 0.0330810546875f, -0.0582275390625f, 0.1015625000000f,
+     -0.2003173828125f, 0.7797851562500f, 0.4650878906250f, -0.1665039062500f,
+     0.0891113281250f, -0.0517578125000f, 0.0292968750000f, -0.0291748046875f},
+    {-0.0083007812500f, 0.0148925781250f, -0.0266113281250f, 0.0476074218750f,
+     -0.1022949218750f, 0.9721679687500f, 0.1373291015625f, -0.0594482421875f,
+     0.0332031250000f, -0.0196533203125f, 0.0109863281250f, 0.0017089843750f},
+};
+
+/* the BS.1770 K-weighting of the rate, the analog prototypes of the 48k coefficients */
+static void meter_kw_design(float kw[2][5], uint32_t rate) {
+  /* the high shelf */
+  double f0 = 1681.974450955533, g = 3.999843853973347, q = 0.7071752369554196;
+  double k = tan(M_PI * f0 / rate);
+  double vh = pow(10.0, g / 20.0);
+  double vb = pow(vh, 0.4996667741545416);
+  double a0 = 1.0 + k / q + k * k;
+
+  kw[0][0] = (vh + vb * k / q + k * k) / a0;
+  kw[0][1] = 2.0 * (k * k - vh) / a0;
+  kw[0][2] = (vh - vb * k / q + k * k) / a0;
+  kw[0][3] = 2.0 * (k * k - 1.0) / a0;
+  kw[0][4] = (1.0 - k / q + k * k) / a0;
+
+  /* the high pass */
+  f0 = 38.13547087602444;
+  q = 0.5003270373238773;
+  k = tan(M_PI * f0 / rate);
+  a0 = 1.0 + k / q + k * k;
+  kw[1][0] = 1.0f;
+  kw[1][1] = -2.0f;
+  kw[1][2] = 1.0f;
+  kw[1][3] = 2.0 * (k * k - 1.0) / a0;
+  kw[1][4] = (1.0 - k / q + k * k) / a0;
+}
+
+static int meter_rows_scalar(const struct st_audio_meter_coef* coef, const float* x,
+                             uint32_t rows, uint16_t channel, uint16_t stride, float* z,
+                             float* acc) {
+  const float* s1 = coef->kw[0];
+  const float* s2 = coef->kw[1];
+
+  for (uint16_t c = 0; c < channel; c++) {
+    float z0 = z[c], z1 = z[stride + c], z2 = z[stride * 2 + c], z3 = z[stride * 3 + c];
+    float peak = acc[ST_AUDIO_METER_ACC_PEAK * stride + c];
+    float tp = acc[ST_AUDIO_METER_ACC_TP * stride + c];
+    float sq = acc[ST_AUDIO_METER_ACC_SQ * stride + c];
+    float ksq = acc[ST_AUDIO_METER_ACC_KSQ * stride + c];
+
+    for (uint32_t r = 0; r < rows; r++) {
+      const float* p = x + (size_t)r * channel + c;
+      float v = p[0];
+
+      peak = RTE_MAX(peak, fabsf(v));
+      sq += v * v;
+
+      float y1 = s1[0] * v + z0;
+      z0 = s1[1] * v - s1[3] * y1 + z1;
+      z1 = s1[2] * v - s1[4] * y1;
+      float y2 = s2[0] * y1 + z2;
+      z2 = s2[1] * y1 - s2[3] * y2 + z3;
+      z3 = s2[2] * y1 - s2[4] * y2;
+      ksq += y2 * y2;
+
+      for (int ph = 0; ph < ST_AUDIO_METER_TP_PHASES; ph++) {
+        float t = coef->tp[ph][0] * v;
+        for (int j = 1; j < ST_AUDIO_METER_TP_TAPS; j++)
+          t += coef->tp[ph][j] * p[-(ptrdiff_t)j * channel];
+        tp = RTE_MAX(tp, fabsf(t));
+      }
+    }
+
+    z[c] = z0;
+    z[stride + c] = z1;
+    z[stride * 2 + c] = z2;
+    z[stride * 3 + c] = z3;
+    acc[ST_AUDIO_METER_ACC_PEAK * stride + c] = peak;
+    acc[ST_AUDIO_METER_ACC_TP * stride + c] = tp;
+    acc[ST_AUDIO_METER_ACC_SQ * stride + c] = sq;
+    acc[ST_AUDIO_METER_ACC_KSQ * stride + c] = ksq;
+  }
+
+  return 0;
+}
+
+int st_audio_meter_rows_simd(const struct st_audio_meter_coef* coef, const float* x,
+                             uint32_t rows, uint16_t channel, uint16_t stride, float* z,
+                             float* acc, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(level);
+  MTL_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st_audio_meter_rows_avx512(coef, x, rows, channel, stride, z, acc);
+    if (ret == 0) return 0;
+    err("%s, avx512 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st_audio_meter_rows_avx2(coef, x, rows, channel, stride, z, acc);
+    if (ret == 0) return 0;
+    err("%s, avx2 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  /* the last option */
+  return meter_rows_scalar(coef, x, rows, channel, stride, z, acc);
+}
+
+static inline float meter_db(float ratio, float scale) {
+  if (!(ratio > 0.0f)) return ST30_METER_LEVEL_MIN;
+  return RTE_MAX(scale * log10f(ratio), ST30_METER_LEVEL_MIN);
+}
+
+/* the levels of the block to the readers, then a new block */
+static void meter_publish(struct st_rx_audio_meter_impl* m) {
+  uint16_t stride = m->stride;
+  float* peak = m->acc + ST_AUDIO_METER_ACC_PEAK * stride;
+  float* tp = m->acc + ST_AUDIO_METER_ACC_TP * stride;
+  float* sq = m->acc + ST_AUDIO_METER_ACC_SQ * stride;
+  float* ksq = m->acc + ST_AUDIO_METER_ACC_KSQ * stride;
+  uint32_t blocks = RTE_MIN(m->blocks + 1, ST_AUDIO_METER_BLOCKS);
+  float* ksq_block = m->ksq_blocks + (m->blocks % ST_AUDIO_METER_BLOCKS) * stride;
+  float samples = (float)m->block_samples;
+  uint32_t seq = atomic_load_explicit(&m->seq, memory_order_relaxed);
+
+  atomic_store_explicit(&m->seq, seq + 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  for (uint16_t c = 0; c < m->channel; c++) {
+    struct st30_meter_level* level = &m->levels[c];
+    float sum = 0.0f;
+
+    ksq_block[c] = ksq[c];
+    for (uint32_t b = 0; b < blocks; b++) sum += m->ksq_blocks[b * stride + c];
+
+    level->peak = meter_db(peak[c], 20.0f);
+    level->true_peak = meter_db(tp[c], 20.0f);
+    level->rms = meter_db(sq[c] / samples, 10.0f);
+    level->loudness = meter_db(sum / (samples * blocks), 10.0f);
+    if (level->loudness > ST30_METER_LEVEL_MIN) level->loudness -= 0.691f;
+  }
+  atomic_store_explicit(&m->seq, seq + 2, memory_order_release);
+
+  memset(m->acc, 0, sizeof(*m->acc) * ST_AUDIO_METER_ACC_MAX * stride);
+  for (uint32_t i = 0; i < 4 * stride; i++) {
+    if (fabsf(m->z[i]) < ST_AUDIO_METER_DENORMAL) m->z[i] = 0.0f;
+  }
+  m->block_pos = 0;
+  m->blocks++;
+}
+
+struct st_rx_audio_meter_impl* st_rx_audio_meter_create(int idx, enum st30_fmt fmt,
+                                                        uint16_t channel,
+                                                        enum st30_sampling sampling,
+                                                        enum st30_ptime ptime,
+                                                        int socket_id) {
+  struct st_rx_audio_meter_impl* m;
+  int pkt_len = st30_get_packet_size(fmt, ptime, sampling, channel);
+  int sample_size = st30_get_sample_size(fmt);
+  int sample_rate = st30_get_sample_rate(sampling);
+  size_t x_size;
+
+  if (pkt_len <= 0 || sample_size <= 0 || sample_rate <= 0 || !channel) {
+    err("%s(%d), invalid fmt %d sampling %d ptime %d channel %u\n", __func__, idx, fmt,
+        sampling, ptime, channel);
+    return NULL;
+  }
+  if (fmt != ST31_FMT_AM824 && !st_pcm_convert_fmt_supported(fmt)) {
+    err("%s(%d), fmt %d not supported\n", __func__, idx, fmt);
+    return NULL;
+  }
+
+  m = mt_rte_zmalloc_socket(sizeof(*m), socket_id);
+  if (!m) {
+    err("%s(%d), malloc fail\n", __func__, idx);
+    return NULL;
+  }
+  m->idx = idx;
+  m->fmt = fmt;
+  m->channel = channel;
+  m->stride = RTE_ALIGN(channel, 16);
+  m->sample_rate = sample_rate;
+  m->pkt_len = pkt_len;
+  m->samples_per_pkt = pkt_len / (sample_size * channel);
+  m->block_samples = sample_rate / 10;
+  m->simd_level = mtl_get_simd_level();
+  meter_kw_design(m->coef.kw, sample_rate);
+  memcpy(m->coef.tp, meter_tp_coef, sizeof(m->coef.tp));
+
+  /* the kernels load the full vectors, 16 floats after the last row */
+  x_size = ((size_t)(ST_AUDIO_METER_TP_TAPS - 1 + m->samples_per_pkt) * channel + 16) *
+           sizeof(float);
+  m->x = mt_rte_zmalloc_socket(x_size, socket_id);
+  m->z = mt_rte_zmalloc_socket(sizeof(float) * 4 * m->stride, socket_id);
+  m->acc = mt_rte_zmalloc_socket(sizeof(float) * ST_AUDIO_METER_ACC_MAX * m->stride,
+                                 socket_id);
+  m->ksq_blocks = mt_rte_zmalloc_socket(
+      sizeof(float) * ST_AUDIO_METER_BLOCKS * m->stride, socket_id);
+  m->levels = mt_rte_zmalloc_socket(sizeof(*m->levels) * channel, socket_id);
+  if (!m->x || !m->z || !m->acc || !m->ksq_blocks || !m->levels) {
+    err("%s(%d), buffers malloc fail\n", __func__, idx);
+    st_rx_audio_meter_free(m);
+    return NULL;
+  }
+  for (uint16_t c = 0; c < channel; c++) {
+    m->levels[c].peak = ST30_METER_LEVEL_MIN;
+    m->levels[c].true_peak = ST30_METER_LEVEL_MIN;
+    m->levels[c].rms = ST30_METER_LEVEL_MIN;
+    m->levels[c].loudness = ST30_METER_LEVEL_MIN;
+  }
+
+  if (fmt == ST31_FMT_AM824) {
+    uint32_t n = m->samples_per_pkt * channel;
+
+    m->am824_offset = mt_rte_zmalloc_socket(sizeof(int32_t) * n, socket_id);
+    if (!m->am824_offset) {
+      err("%s(%d), offset malloc fail\n", __func__, idx);
+      st_rx_audio_meter_free(m);
+      return NULL;
+    }
+    /* the label byte then the 24 bit big endian sample */
+    for (uint32_t i = 0; i < n; i++) m->am824_offset[i] = i * 4 + 1;
+  }
+
+  info("%s(%d), %u ch, %u samples per pkt, block %u samples\n", __func__, idx, channel,
+       m->samples_per_pkt, m->block_samples);
+  return m;
+}
+
+void st_rx_audio_meter_free(struct st_rx_audio_meter_impl* m) {
+  if (m->am824_offset) mt_rte_free(m->am824_offset);
+  if (m->levels) mt_rte_free(m->levels);
+  if (m->ksq_blocks) mt_rte_free(m->ksq_blocks);
+  if (m->acc) mt_rte_free(m->acc);
+  if (m->z) mt_rte_free(m->z);
+  if (m->x) mt_rte_free(m->x);
+  mt_rte_free(m);
+}
+
+int st_rx_audio_meter_put_pkt(struct st_rx_audio_meter_impl* m, const void* payload) {
+  uint16_t channel = m->channel;
+  size_t history = (size_t)(ST_AUDIO_METER_TP_TAPS - 1) * channel;
+  float* rows = m->x + history;
+  uint32_t n = m->samples_per_pkt * channel;
+  uint32_t done = 0;
+  int ret;
+
+  if (m->fmt == ST31_FMT_AM824)
+    ret = st_pcm_gather_to_app_simd(payload, m->am824_offset, n, m->pkt_len, rows,
+                                    ST30_FMT_PCM24, ST30P_SAMPLE_FMT_F32, m->simd_level);
+  else
+    ret = st_pcm_to_app_simd(payload, rows, n, m->fmt, ST30P_SAMPLE_FMT_F32,
+                             m->simd_level);
+  if (ret < 0) return ret;
+
+  /* a packet may cross the block end */
+  while (done < m->samples_per_pkt) {
+    uint32_t cnt = RTE_MIN(m->samples_per_pkt - done, m->block_samples - m->block_pos);
+
+    st_audio_meter_rows_simd(&m->coef, rows + (size_t)done * channel, cnt, channel,
+                             m->stride, m->z, m->acc, m->simd_level);
+    done += cnt;
+    m->block_pos += cnt;
+    if (m->block_pos >= m->block_samples) meter_publish(m);
+  }
+
+  /* the last rows are the history of the next packet */
+  memmove(m->x, m->x + (size_t)m->samples_per_pkt * channel, history * sizeof(float));
+  m->stat_pkts++;
+  return 0;
+}
+
+int st_rx_audio_meter_read(struct st_rx_audio_meter_impl* m,
+                           struct st30_meter_level* levels, uint16_t channel_cnt) {
+  uint16_t cnt = RTE_MIN(channel_cnt, m->channel);
+
+  for (int i = 0; i < ST_AUDIO_METER_READ_RETRY; i++) {
+    uint32_t seq = atomic_load_explicit(&m->seq, memory_order_acquire);
+
+    if (seq & 1) {
+      rte_pause();
+      continue;
+    }
+    memcpy(levels, m->levels, sizeof(*levels) * cnt);
+    atomic_thread_fence(memory_order_acquire);
+    if (atomic_load_explicit(&m->seq, memory_order_relaxed) == seq) return cnt;
+  }
+
+  atomic_fetch_add_explicit(&m->stat_read_busy, 1, memory_order_relaxed);
+  return -EBUSY;
+}
+
+void st_rx_audio_meter_stat(struct st_rx_audio_meter_impl* m) {
+  struct st30_meter_level* levels = m->levels;
+  uint16_t peak_ch = 0, loud_ch = 0;
+  uint32_t seq = atomic_load_explicit(&m->seq, memory_order_acquire);
+
+  /* the stat is a hint, no retry for a block published in the middle */
+  for (uint16_t c = 1; c < m->channel; c++) {
+    if (levels[c].true_peak > levels[peak_ch].true_peak) peak_ch = c;
+    if (levels[c].loudness > levels[loud_ch].loudness) loud_ch = c;
+  }
+  notice("RX_AUDIO_METER(%d), pkts %" PRIu64 " blocks %" PRIu64 " seq %u\n", m->idx,
+         m->stat_pkts, m->blocks, seq);
+  notice("RX_AUDIO_METER(%d), max true peak %.1f dBTP(peak %.1f dBFS) on ch %u, loudest "
+         "%.1f LUFS on ch %u\n",
+         m->idx, levels[peak_ch].true_peak, levels[peak_ch].peak, peak_ch,
+         levels[loud_ch].loudness, loud_ch);
+
+  uint64_t busy = atomic_exchange_explicit(&m->stat_read_busy, 0, memory_order_relaxed);
+  if (busy) warn("RX_AUDIO_METER(%d), read busy %" PRIu64 "\n", m->idx, busy);
+}
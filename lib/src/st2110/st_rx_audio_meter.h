@@ -0,0 +1,35 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#ifndef _ST_LIB_RX_AUDIO_METER_HEAD_H_
+#define _ST_LIB_RX_AUDIO_METER_HEAD_H_
+
+#include "st_main.h"
+
+struct st_rx_audio_meter_impl* st_rx_audio_meter_create(int idx, enum st30_fmt fmt,
+                                                        uint16_t channel,
+                                                        enum st30_sampling sampling,
+                                                        enum st30_ptime ptime,
+                                                        int socket_id);
+void st_rx_audio_meter_free(struct st_rx_audio_meter_impl* m);
+
+/* one packet payload in the arrival order, from the session tasklet only */
+int st_rx_audio_meter_put_pkt(struct st_rx_audio_meter_impl* m, const void* payload);
+
+/* the levels of the last block for the channels from 0, the channels read */
+int st_rx_audio_meter_read(struct st_rx_audio_meter_impl* m,
+                           struct st30_meter_level* levels, uint16_t channel_cnt);
+
+void st_rx_audio_meter_stat(struct st_rx_audio_meter_impl* m);
+
+/*
+ * Meter rows of channel samples at x, the ST_AUDIO_METER_TP_TAPS - 1 rows before x are
+ * the history of the true peak fir. The z and acc arrays are of stride floats for each
+ * state or accumulator, x is read up to 16 floats after the last row.
+ */
+int st_audio_meter_rows_simd(const struct st_audio_meter_coef* coef, const float* x,
+                             uint32_t rows, uint16_t channel, uint16_t stride, float* z,
+                             float* acc, enum mtl_simd_level level);
+
+#endif
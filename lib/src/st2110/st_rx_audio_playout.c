@@ -0,0 +1,191 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include "st_rx_audio_playout.h"
+
+#include "../mt_log.h"
+
+/*
+ * The rtp timestamp is the media clock of the PTP time mod 2^32, the receive PTP time
+ * of the packet extends it to the 64 bit sample position, so the slot of a packet does
+ * not depend on the link offset of the port it comes from. Packet k (the position
+ * minus the phase of the first packet, over samples_per_pkt) is slot k & (slots - 1)
+ * with the tag k + 1, the duplicate of the redundant port finds the tag already set.
+ */
+
+struct st_rx_audio_playout_impl* st_rx_audio_playout_create(
+    struct mtl_main_impl* impl, int idx, enum st30_fmt fmt, uint16_t channel,
+    enum st30_sampling sampling, enum st30_ptime ptime, uint32_t latency_us,
+    uint32_t buffer_ms, int socket_id) {
+  struct st_rx_audio_playout_impl* p;
+  int pkt_len = st30_get_packet_size(fmt, ptime, sampling, channel);
+  int sample_size = st30_get_sample_size(fmt);
+  int sample_rate = st30_get_sample_rate(sampling);
+  uint64_t buffer_samples;
+
+  if (pkt_len <= 0 || sample_size <= 0 || sample_rate <= 0 || !channel) {
+    err("%s(%d), invalid fmt %d sampling %d ptime %d channel %u\n", __func__, idx, fmt,
+        sampling, ptime, channel);
+    return NULL;
+  }
+
+  p = mt_rte_zmalloc_socket(sizeof(*p), socket_id);
+  if (!p) {
+    err("%s(%d), malloc fail\n", __func__, idx);
+    return NULL;
+  }
+  p->parent = impl;
+  p->idx = idx;
+  p->fmt = fmt;
+  p->sample_rate = sample_rate;
+  p->row_size = sample_size * channel;
+  p->pkt_len = pkt_len;
+  p->samples_per_pkt = pkt_len / p->row_size;
+  p->latency_samples = (uint64_t)latency_us * sample_rate / US_PER_S;
+  /* PCM8 is offset binary, zero bytes for the others */
+  p->silence = (fmt == ST30_FMT_PCM8) ? 0x80 : 0;
+
+  buffer_samples = (uint64_t)buffer_ms * sample_rate / MS_PER_S;
+  p->slots = rte_align32pow2(RTE_MAX(buffer_samples / p->samples_per_pkt, 2));
+  /* the latency plus one packet of jitter must stay in the ring */
+  if ((uint64_t)p->latency_samples + p->samples_per_pkt * 2 >
+      (uint64_t)p->slots * p->samples_per_pkt) {
+    err("%s(%d), latency %uus too long for the %ums buffer\n", __func__, idx, latency_us,
+        buffer_ms);
+    st_rx_audio_playout_free(p);
+    return NULL;
+  }
+
+  p->ring = mt_rte_zmalloc_socket((size_t)p->slots * p->pkt_len, socket_id);
+  p->tags = mt_rte_zmalloc_socket(sizeof(*p->tags) * p->slots, socket_id);
+  if (!p->ring || !p->tags) {
+    err("%s(%d), ring malloc fail, %u slots\n", __func__, idx, p->slots);
+    st_rx_audio_playout_free(p);
+    return NULL;
+  }
+
+  info("%s(%d), %u slots of %u samples, latency %u samples\n", __func__, idx, p->slots,
+       p->samples_per_pkt, p->latency_samples);
+  return p;
+}
+
+void st_rx_audio_playout_free(struct st_rx_audio_playout_impl* p) {
+  if (p->ring) mt_rte_free(p->ring);
+  if (p->tags) mt_rte_free(p->tags);
+  mt_rte_free(p);
+}
+
+int st_rx_audio_playout_put_pkt(struct st_rx_audio_playout_impl* p, uint32_t tmstamp,
+                                const void* payload, uint64_t ptp_ts) {
+  uint64_t now = st_rx_audio_playout_ptp2pos(p, ptp_ts);
+  uint64_t pos = now - (int32_t)((uint32_t)now - tmstamp);
+  uint64_t newest = atomic_load_explicit(&p->newest, memory_order_relaxed);
+  uint64_t k, tag;
+  uint32_t slot;
+
+  if (!p->synced) {
+    p->phase = pos % p->samples_per_pkt;
+    p->synced = true;
+  }
+  if ((pos - p->phase) % p->samples_per_pkt) {
+    dbg("%s(%d), tmstamp %u not on the packet grid\n", __func__, p->idx, tmstamp);
+    p->stat_pkts_misaligned++;
+    return -EINVAL;
+  }
+  k = (pos - p->phase) / p->samples_per_pkt;
+  tag = k + 1;
+  slot = k & (p->slots - 1);
+
+  if (k + p->slots < newest) {
+    dbg("%s(%d), tmstamp %u out of the ring\n", __func__, p->idx, tmstamp);
+    p->stat_pkts_late++;
+    return -EIO;
+  }
+  uint64_t cur = atomic_load_explicit(&p->tags[slot], memory_order_relaxed);
+  if (cur == tag) {
+    p->stat_pkts_redundant++;
+    return -EAGAIN;
+  }
+
+  /* invalid for the readers while the payload is in write */
+  atomic_store_explicit(&p->tags[slot], 0, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  rte_memcpy(p->ring + (size_t)slot * p->pkt_len, payload, p->pkt_len);
+  atomic_store_explicit(&p->tags[slot], tag, memory_order_release);
+  p->stat_pkts_written++;
+
+  if (tag > newest) {
+    atomic_store_explicit(&p->newest, tag, memory_order_release);
+    /* the packet before the ring is dropped by the session already */
+    p->floor_ts = (uint32_t)((tag - p->slots) * p->samples_per_pkt + p->phase);
+  }
+  return 0;
+}
+
+int st_rx_audio_playout_read(struct st_rx_audio_playout_impl* p, uint64_t pos,
+                             uint32_t samples, void* buf, uint32_t* concealed,
+                             uint32_t* ahead) {
+  uint64_t newest = atomic_load_explicit(&p->newest, memory_order_acquire);
+  uint32_t spp = p->samples_per_pkt;
+  uint32_t total = samples, lost = 0, future = 0;
+  uint8_t* dst = buf;
+
+  while (samples) {
+    /* the phase is set before the first newest */
+    uint64_t rel = pos - p->phase;
+    uint64_t k = rel / spp;
+    uint32_t off = rel % spp;
+    uint32_t n = RTE_MIN(spp - off, samples);
+    size_t bytes = (size_t)n * p->row_size;
+    uint32_t slot = k & (p->slots - 1);
+    _Atomic uint64_t* tag = &p->tags[slot];
+    bool valid = false;
+
+    if (newest && atomic_load_explicit(tag, memory_order_acquire) == k + 1) {
+      rte_memcpy(dst, p->ring + (size_t)slot * p->pkt_len + (size_t)off * p->row_size,
+                 bytes);
+      atomic_thread_fence(memory_order_acquire);
+      /* not overwritten by a newer packet in the copy */
+      valid = (atomic_load_explicit(tag, memory_order_relaxed) == k + 1);
+    }
+    if (!valid) {
+      memset(dst, p->silence, bytes);
+      if (k + 1 > newest)
+        future += n;
+      else
+        lost += n;
+    }
+
+    dst += bytes;
+    pos += n;
+    samples -= n;
+  }
+
+  atomic_fetch_add_explicit(&p->stat_samples_read, total, memory_order_relaxed);
+  if (lost)
+    atomic_fetch_add_explicit(&p->stat_samples_concealed, lost, memory_order_relaxed);
+  if (future)
+    atomic_fetch_add_explicit(&p->stat_samples_ahead, future, memory_order_relaxed);
+  if (concealed) *concealed = lost;
+  if (ahead) *ahead = future;
+  return 0;
+}
+
+void st_rx_audio_playout_stat(struct st_rx_audio_playout_impl* p) {
+  /* the pkt counters are from the tasklet, total since create */
+  notice("RX_st30p(%d), playout pkts written %" PRIu64 " redundant %" PRIu64
+         " late %" PRIu64 " misaligned %" PRIu64 "\n",
+         p->idx, p->stat_pkts_written, p->stat_pkts_redundant, p->stat_pkts_late,
+         p->stat_pkts_misaligned);
+
+  uint64_t read =
+      atomic_exchange_explicit(&p->stat_samples_read, 0, memory_order_relaxed);
+  uint64_t concealed =
+      atomic_exchange_explicit(&p->stat_samples_concealed, 0, memory_order_relaxed);
+  uint64_t ahead =
+      atomic_exchange_explicit(&p->stat_samples_ahead, 0, memory_order_relaxed);
+  notice("RX_st30p(%d), playout samples read %" PRIu64 " concealed %" PRIu64
+         " ahead %" PRIu64 "\n",
+         p->idx, read, concealed, ahead);
+}
@@ -0,0 +1,41 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#ifndef _ST_LIB_RX_AUDIO_PLAYOUT_HEAD_H_
+#define _ST_LIB_RX_AUDIO_PLAYOUT_HEAD_H_
+
+#include "st_main.h"
+
+struct st_rx_audio_playout_impl* st_rx_audio_playout_create(
+    struct mtl_main_impl* impl, int idx, enum st30_fmt fmt, uint16_t channel,
+    enum st30_sampling sampling, enum st30_ptime ptime, uint32_t latency_us,
+    uint32_t buffer_ms, int socket_id);
+void st_rx_audio_playout_free(struct st_rx_audio_playout_impl* p);
+
+/* the media clock sample position of the PTP time */
+static inline uint64_t st_rx_audio_playout_ptp2pos(struct st_rx_audio_playout_impl* p,
+                                                   uint64_t ptp_ns) {
+  return ptp_ns / NS_PER_S * p->sample_rate +
+         ptp_ns % NS_PER_S * p->sample_rate / NS_PER_S;
+}
+
+/*
+ * One packet payload at the rtp tmstamp received at the ptp_ts into the ring, from the
+ * session tasklet only. -EAGAIN if the slot has the packet already from the other port,
+ * -EIO if it is older than the ring.
+ */
+int st_rx_audio_playout_put_pkt(struct st_rx_audio_playout_impl* p, uint32_t tmstamp,
+                                const void* payload, uint64_t ptp_ts);
+
+/*
+ * Copy the samples from the media clock position pos to buf, the missing packets are
+ * silence, concealed are the lost samples and ahead are the ones not received yet.
+ */
+int st_rx_audio_playout_read(struct st_rx_audio_playout_impl* p, uint64_t pos,
+                             uint32_t samples, void* buf, uint32_t* concealed,
+                             uint32_t* ahead);
+
+void st_rx_audio_playout_stat(struct st_rx_audio_playout_impl* p);
+
+#endif
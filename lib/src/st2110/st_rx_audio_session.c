@@ -11,6 +11,9 @@
 #include "../mt_log.h"
 #include "../mt_pcap.h"
 #include "../mt_stat.h"
+#include "st_rx_audio_agg.h"
+#include "st_rx_audio_meter.h"
+#include "st_rx_audio_playout.h"
 #include "st_rx_common.h"
 #include "st_rx_timing_parser.h"
 
@@ -421,8 +424,11 @@ static int rx_audio_session_handle_frame_pkt(struct mtl_main_impl* impl,
   s->port_user_stats.common.port[s_port].bytes += mbuf->pkt_len;
 
   /* drop packets older than the open frame's base (or the next-frame floor
-   * between frames); the bitmap dedups packets inside the open frame */
-  if (!mt_seq32_greater(tmstamp, s->tmstamp)) {
+   * between frames); the bitmap dedups packets inside the open frame. Far behind
+   * the group goes on to it, which resyncs on a step back of the clock. */
+  if (!mt_seq32_greater(tmstamp, s->tmstamp) &&
+      !(s->agg &&
+        st_rx_audio_agg_far_behind(s->agg, tmstamp, (uint32_t)(s->tmstamp + 1)))) {
     dbg("%s(%d,%d), drop as pkt seq_id %u (%u) or tmstamp %u (%ld) is old\n", __func__,
         s->idx, s_port, seq_id, s->latest_seq_id[s_port], tmstamp, s->tmstamp);
     s->redundant_error_cnt[s_port]++;
@@ -455,6 +461,33 @@ static int rx_audio_session_handle_frame_pkt(struct mtl_main_impl* impl,
   /* only advance, never go backward */
   if (mt_seq16_greater(seq_id, s->session_seq_id)) s->session_seq_id = seq_id;
 
+  if (s->agg) {
+    /* the group aligns the flows, the floor follows the oldest open frame of it */
+    uint32_t base;
+    int ret = st_rx_audio_agg_put_pkt(s->agg, s->agg_flow, tmstamp, payload,
+                                      mt_mbuf_time_stamp(impl, mbuf, port), &base);
+    if (ret < 0) return ret;
+    s->tmstamp = (int64_t)(uint32_t)(base - 1);
+    s->port_user_stats.common.stat_pkts_received++;
+    if (s->enable_timing_parser)
+      ra_tp_on_packet(s, s_port, tmstamp, mt_mbuf_time_stamp(impl, mbuf, port));
+    return 0;
+  }
+
+  if (s->playout) {
+    /* the ring merges the ports by the media clock slot, the floor follows the ring */
+    int ret = st_rx_audio_playout_put_pkt(s->playout, tmstamp, payload,
+                                          mt_mbuf_time_stamp(impl, mbuf, port));
+    if (ret == -EAGAIN) s->port_user_stats.common.stat_pkts_redundant++;
+    if (ret < 0) return ret;
+    if (s->meter) st_rx_audio_meter_put_pkt(s->meter, payload);
+    s->tmstamp = (int64_t)(uint32_t)(s->playout->floor_ts - 1);
+    s->port_user_stats.common.stat_pkts_received++;
+    if (s->enable_timing_parser)
+      ra_tp_on_packet(s, s_port, tmstamp, mt_mbuf_time_stamp(impl, mbuf, port));
+    return 0;
+  }
+
   if (!s->st30_cur_frame) {
     if (rx_audio_session_open_frame(s, s_port, tmstamp,
                                     mt_mbuf_time_stamp(impl, mbuf, port)) < 0) {
@@ -490,6 +523,8 @@ static int rx_audio_session_handle_frame_pkt(struct mtl_main_impl* impl,
   }
 
   rte_memcpy(s->st30_cur_frame->addr + (size_t)idx * s->pkt_len, payload, s->pkt_len);
+  /* the payload is still in the cache */
+  if (s->meter) st_rx_audio_meter_put_pkt(s->meter, payload);
   s->frame_recv_size += s->pkt_len;
   s->port_user_stats.common.stat_pkts_received++;
 
@@ -859,6 +894,7 @@ static int rx_audio_session_init_hw(struct mtl_main_impl* impl,
       rte_memcpy(flow.sip_addr, mt_sip_addr(impl, port), MTL_IP_ADDR_LEN);
     flow.dst_port = s->st30_dst_port[i];
     if (mt_has_cni_rx(impl, port)) flow.flags |= MT_RXQ_FLOW_F_FORCE_CNI;
+    if (s->ops.flags & ST30_RX_FLAG_JUMBO_FRAME) flow.pkt_max_len = s->st30_pkt_size;
 
     /* no flow for data path only */
     if (s->ops.flags & ST30_RX_FLAG_DATA_PATH_ONLY) {
@@ -918,6 +954,10 @@ static int rx_audio_session_init_mcast(struct mtl_main_impl* impl,
 }
 
 static int rx_audio_session_uinit_sw(struct st_rx_audio_session_impl* s) {
+  if (s->meter) {
+    st_rx_audio_meter_free(s->meter);
+    s->meter = NULL;
+  }
   rx_audio_session_free_frames(s);
   rx_audio_session_free_rtps(s);
   rx_audio_session_usdt_dump_close(s);
@@ -932,7 +972,14 @@ static int rx_audio_session_init_sw(struct st_rx_audio_sessions_mgr* mgr,
 
   switch (st30_type) {
     case ST30_TYPE_FRAME_LEVEL:
-      ret = rx_audio_session_alloc_frames(s);
+      /* the frames are from the aggregation group, or no frames for the playout */
+      ret = (s->ops.agg || s->playout) ? 0 : rx_audio_session_alloc_frames(s);
+      if (ret < 0) break;
+      if (s->ops.flags & ST30_RX_FLAG_ENABLE_METER) {
+        s->meter = st_rx_audio_meter_create(idx, s->ops.fmt, s->ops.channel,
+                                            s->ops.sampling, s->ops.ptime, s->socket_id);
+        if (!s->meter) ret = -ENOMEM;
+      }
       break;
     case ST30_TYPE_RTP_LEVEL:
       ret = rx_audio_session_alloc_rtps(mgr, s);
@@ -950,6 +997,10 @@ static int rx_audio_session_uinit(struct mtl_main_impl* impl,
                                   struct st_rx_audio_session_impl* s) {
   rv_stop_pcap_dump(s);
   ra_tp_uinit(s);
+  if (s->agg) {
+    st_rx_audio_agg_detach(s->agg, s->agg_flow);
+    s->agg = NULL;
+  }
   rx_audio_session_uinit_mcast(impl, s);
   rx_audio_session_uinit_sw(s);
   rx_audio_session_uinit_hw(s);
@@ -983,22 +1034,37 @@ static int rx_audio_session_attach(struct mtl_main_impl* impl,
   if (ret < 0) return ret;
   s->pkt_len = ret;
 
-  size_t bytes_in_pkt = ST_PKT_MAX_ETHER_BYTES - sizeof(struct st_rfc3550_audio_hdr);
+  ret = st_audio_max_ether_bytes(impl, s->port_maps, num_port,
+                                 ops->flags & ST30_RX_FLAG_JUMBO_FRAME);
+  if (ret < 0) {
+    err("%s(%d), jumbo frame only for the kernel socket ports\n", __func__, idx);
+    return ret;
+  }
+
+  size_t bytes_in_pkt = ret - sizeof(struct st_rfc3550_audio_hdr);
   s->st30_pkt_size = s->pkt_len + sizeof(struct st_rfc3550_audio_hdr);
   if (s->pkt_len > bytes_in_pkt) {
-    err("%s(%d), invalid pkt_len %d\n", __func__, idx, s->pkt_len);
+    err("%s(%d), invalid pkt_len %d, max %" PRIu64 "\n", __func__, idx, s->pkt_len,
+        (uint64_t)bytes_in_pkt);
     return -EIO;
   }
 
-  s->st30_frames_cnt = ops->framebuff_cnt;
-  s->st30_total_pkts = ops->framebuff_size / s->pkt_len;
-  if (ops->framebuff_size % s->pkt_len) {
-    /* todo: add the support? */
-    err("%s(%d), framebuff_size %d not multiple pkt_len %d\n", __func__, idx, s->pkt_len,
-        ops->framebuff_size);
-    return -EIO;
+  if (ops->agg || s->playout) {
+    /* the group or the playout ring owns the data, one packet each for the stat */
+    s->st30_frames_cnt = 0;
+    s->st30_total_pkts = 1;
+    s->st30_frame_size = s->pkt_len;
+  } else {
+    s->st30_frames_cnt = ops->framebuff_cnt;
+    s->st30_total_pkts = ops->framebuff_size / s->pkt_len;
+    if (ops->framebuff_size % s->pkt_len) {
+      /* todo: add the support? */
+      err("%s(%d), framebuff_size %d not multiple pkt_len %d\n", __func__, idx,
+          s->pkt_len, ops->framebuff_size);
+      return -EIO;
+    }
+    s->st30_frame_size = ops->framebuff_size;
   }
-  s->st30_frame_size = ops->framebuff_size;
   uint32_t per_frame_div = (uint32_t)st30_get_sample_size(ops->fmt) * ops->channel;
   s->rtp_ticks_per_frame =
       per_frame_div ? (uint32_t)(s->st30_frame_size / per_frame_div) : 0;
@@ -1037,6 +1103,17 @@ static int rx_audio_session_attach(struct mtl_main_impl* impl,
     }
   }
 
+  if (ops->agg) {
+    ret = st_rx_audio_agg_attach(ops->agg, ops);
+    if (ret < 0) {
+      err("%s(%d), st_rx_audio_agg_attach fail %d\n", __func__, idx, ret);
+      rx_audio_session_uinit(impl, s);
+      return ret;
+    }
+    s->agg = ops->agg;
+    s->agg_flow = ret;
+  }
+
   ret = rx_audio_session_init_hw(impl, s);
   if (ret < 0) {
     err("%s(%d), rx_audio_session_init_hw fail %d\n", __func__, idx, ret);
@@ -1220,6 +1297,7 @@ static void rx_audio_session_stat(struct st_rx_audio_sessions_mgr* mgr,
   s->stat_max_notify_frame_us = 0;
 
   if (s->enable_timing_parser_stat) ra_tp_stat(s);
+  if (s->meter) st_rx_audio_meter_stat(s->meter);
 
   for (int s_port = 0; s_port < s->ops.num_port; s_port++) {
     struct mt_rx_pcap* pcap = &s->pcap[s_port];
@@ -1351,7 +1429,8 @@ static int rx_audio_session_init(struct st_rx_audio_sessions_mgr* mgr,
 }
 
 static struct st_rx_audio_session_impl* rx_audio_sessions_mgr_attach(
-    struct mtl_sch_impl* sch, struct st30_rx_ops* ops) {
+    struct mtl_sch_impl* sch, struct st30_rx_ops* ops,
+    struct st_rx_audio_playout_impl* playout) {
   struct st_rx_audio_sessions_mgr* mgr = &sch->rx_a_mgr;
   int midx = mgr->idx;
   int ret;
@@ -1376,6 +1455,7 @@ static struct st_rx_audio_session_impl* rx_audio_sessions_mgr_attach(
       mt_rte_free(s);
       return NULL;
     }
+    s->playout = playout;
     ret = rx_audio_session_attach(mgr->parent, mgr, s, ops);
     if (ret < 0) {
       err("%s(%d), attach fail on %d\n", __func__, midx, i);
@@ -1496,7 +1576,8 @@ static int rx_audio_ops_prune_down_ports(struct mtl_main_impl* impl,
   return 0;
 }
 
-static int rx_audio_ops_check(struct st30_rx_ops* ops) {
+static int rx_audio_ops_check(struct st30_rx_ops* ops,
+                              struct st_rx_audio_playout_impl* playout) {
   int num_ports = ops->num_port, ret;
   uint8_t* ip = NULL;
 
@@ -1521,7 +1602,24 @@ static int rx_audio_ops_check(struct st30_rx_ops* ops) {
     }
   }
 
-  if (ops->type == ST30_TYPE_FRAME_LEVEL) {
+  if ((ops->agg || playout) && (ops->type != ST30_TYPE_FRAME_LEVEL)) {
+    err("%s, the aggregation group or playout is only for ST30_TYPE_FRAME_LEVEL\n",
+        __func__);
+    return -EINVAL;
+  }
+  if (ops->agg && playout) {
+    err("%s, the aggregation group is not for the playout\n", __func__);
+    return -EINVAL;
+  }
+  if ((ops->flags & ST30_RX_FLAG_ENABLE_METER) &&
+      (ops->agg || ops->type != ST30_TYPE_FRAME_LEVEL)) {
+    err("%s, the meter is only for ST30_TYPE_FRAME_LEVEL without the group\n",
+        __func__);
+    return -EINVAL;
+  }
+
+  /* the frames and the notify of a group member are from the aggregation group */
+  if ((ops->type == ST30_TYPE_FRAME_LEVEL) && !ops->agg && !playout) {
     if (ops->framebuff_cnt < 1) {
       err("%s, invalid framebuff_cnt %d\n", __func__, ops->framebuff_cnt);
       return -EINVAL;
@@ -1579,8 +1677,9 @@ int st_rx_audio_sessions_sch_uinit(struct mtl_sch_impl* sch) {
   return 0;
 }
 
-st30_rx_handle st30_rx_create(mtl_handle mt, struct st30_rx_ops* ops) {
-  struct mtl_main_impl* impl = mt;
+st30_rx_handle st30_rx_create_with_playout(struct mtl_main_impl* impl,
+                                          struct st30_rx_ops* ops,
+                                          struct st_rx_audio_playout_impl* playout) {
   struct mtl_sch_impl* sch;
   struct st_rx_audio_session_handle_impl* s_impl;
   struct st_rx_audio_session_impl* s;
@@ -1599,7 +1698,7 @@ st30_rx_handle st30_rx_create(mtl_handle mt, struct st30_rx_ops* ops) {
     return NULL;
   }
 
-  ret = rx_audio_ops_check(ops);
+  ret = rx_audio_ops_check(ops, playout);
   if (ret < 0) {
     err("%s, rx_audio_ops_check fail %d\n", __func__, ret);
     return NULL;
@@ -1640,7 +1739,7 @@ st30_rx_handle st30_rx_create(mtl_handle mt, struct st30_rx_ops* ops) {
   }
 
   mt_pthread_mutex_lock(&sch->rx_a_mgr_mutex);
-  s = rx_audio_sessions_mgr_attach(sch, ops);
+  s = rx_audio_sessions_mgr_attach(sch, ops, playout);
   mt_pthread_mutex_unlock(&sch->rx_a_mgr_mutex);
   if (!s) {
     err("%s(%d), rx_audio_sessions_mgr_attach fail\n", __func__, sch->idx);
@@ -1661,6 +1760,10 @@ st30_rx_handle st30_rx_create(mtl_handle mt, struct st30_rx_ops* ops) {
   return s_impl;
 }
 
+st30_rx_handle st30_rx_create(mtl_handle mt, struct st30_rx_ops* ops) {
+  return st30_rx_create_with_playout(mt, ops, NULL);
+}
+
 int st30_rx_update_source(st30_rx_handle handle, struct st_rx_source_info* src) {
   struct st_rx_audio_session_handle_impl* s_impl = handle;
   struct st_rx_audio_session_impl* s;
@@ -1839,6 +1942,30 @@ int st30_rx_get_session_stats(st30_rx_handle handle, struct st30_rx_user_stats*
   return 0;
 }
 
+int st30_rx_get_meter(st30_rx_handle handle, struct st30_meter_level* levels,
+                      uint16_t channel_cnt) {
+  struct st_rx_audio_session_handle_impl* s_impl = handle;
+  int ret;
+
+  if (!handle || !levels) {
+    err("%s, invalid handle %p or levels %p\n", __func__, handle, levels);
+    return -EINVAL;
+  }
+
+  MT_HANDLE_GUARD(s_impl, MT_HANDLE_RX_AUDIO, -EINVAL);
+  struct st_rx_audio_session_impl* s = s_impl->impl;
+
+  if (!s->meter) {
+    err("%s(%d), the meter is not enabled\n", __func__, s->idx);
+    ret = -EINVAL;
+  } else {
+    /* the seqlock of the meter, no session lock */
+    ret = st_rx_audio_meter_read(s->meter, levels, channel_cnt);
+  }
+  MT_HANDLE_RELEASE(s_impl);
+  return ret;
+}
+
 int st30_rx_reset_session_stats(st30_rx_handle handle) {
   struct st_rx_audio_session_handle_impl* s_impl = handle;
 
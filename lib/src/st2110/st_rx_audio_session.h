@@ -13,4 +13,9 @@
 
 int st_rx_audio_sessions_sch_uinit(struct mtl_sch_impl* sch);
 
+/* the rx session writes the packets to the playout ring of the pipeline, no frames */
+st30_rx_handle st30_rx_create_with_playout(struct mtl_main_impl* impl,
+                                          struct st30_rx_ops* ops,
+                                          struct st_rx_audio_playout_impl* playout);
+
 #endif
\ No newline at end of file
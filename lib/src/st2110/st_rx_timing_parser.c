@@ -10,16 +10,15 @@ static inline float rv_tp_calculate_avg(uint32_t cnt, int64_t sum) {
   return cnt ? ((float)sum / cnt) : -1.0f;
 }
 
-void rv_tp_on_packet(struct st_rx_video_session_impl* s, enum mtl_session_port s_port,
-                     struct st_rv_tp_slot* slot, uint32_t rtp_tmstamp, uint64_t pkt_time,
-                     int pkt_idx) {
-  struct st_rx_video_tp* tp = s->tp;
+static void rv_tp_slot_on_packet(struct st_rx_video_tp* tp, enum mtl_session_port s_port,
+                                 struct st_rv_tp_slot* slot, uint32_t rtp_tmstamp,
+                                 uint64_t pkt_time, int pkt_idx) {
   uint64_t epoch_tmstamp;
   double tvd, trs = tp->trs;
 
   if (!slot->cur_epochs) { /* the first packet */
-    uint64_t epochs = (double)pkt_time / s->frame_time;
-    uint64_t epoch_tmstamp = (double)epochs * s->frame_time;
+    uint64_t epochs = (double)pkt_time / tp->frame_time;
+    uint64_t epoch_tmstamp = (double)epochs * tp->frame_time;
 
     slot->cur_epochs = epochs;
     slot->rtp_tmstamp = rtp_tmstamp;
@@ -27,10 +26,10 @@ void rv_tp_on_packet(struct st_rx_video_session_impl* s, enum mtl_session_port s
     slot->first_pkt_time = first_pkt_time;
     slot->meta.fpt = first_pkt_time - epoch_tmstamp;
 
-    uint64_t tmstamp64 = epochs * s->frame_time_sampling;
+    uint64_t tmstamp64 = epochs * tp->frame_time_sampling;
     uint32_t tmstamp32 = tmstamp64;
     double diff_rtp_ts = (double)rtp_tmstamp - tmstamp32;
-    double diff_rtp_ts_ns = diff_rtp_ts * s->frame_time / s->frame_time_sampling;
+    double diff_rtp_ts_ns = diff_rtp_ts * tp->frame_time / tp->frame_time_sampling;
     slot->meta.latency = slot->meta.fpt - diff_rtp_ts_ns;
     slot->meta.rtp_offset = diff_rtp_ts;
     if (tp->pre_rtp_tmstamp[s_port]) {
@@ -39,7 +38,7 @@ void rv_tp_on_packet(struct st_rx_video_session_impl* s, enum mtl_session_port s
     tp->pre_rtp_tmstamp[s_port] = rtp_tmstamp;
   }
 
-  epoch_tmstamp = (uint64_t)(slot->cur_epochs * s->frame_time);
+  epoch_tmstamp = (uint64_t)(slot->cur_epochs * tp->frame_time);
   tvd = epoch_tmstamp + tp->pass.tr_offset;
   double expect_time = tvd + trs * (pkt_idx + 1);
 
@@ -69,6 +68,12 @@ void rv_tp_on_packet(struct st_rx_video_session_impl* s, enum mtl_session_port s
   slot->meta.pkts_cnt++;
 }
 
+void rv_tp_on_packet(struct st_rx_video_session_impl* s, enum mtl_session_port s_port,
+                     struct st_rv_tp_slot* slot, uint32_t rtp_tmstamp, uint64_t pkt_time,
+                     int pkt_idx) {
+  rv_tp_slot_on_packet(s->tp, s_port, slot, rtp_tmstamp, pkt_time, pkt_idx);
+}
+
 static void rv_tp_compliant_set_cause(struct st20_rx_tp_meta* meta, char* cause) {
   snprintf(meta->failed_cause, sizeof(meta->failed_cause), "%s", cause);
 }
@@ -137,9 +142,8 @@ static enum st_rx_tp_compliant rv_tp_compliant(struct st_rx_video_tp* tp,
   return ST_RX_TP_COMPLIANT_NARROW;
 }
 
-void rv_tp_slot_parse_result(struct st_rx_video_session_impl* s,
-                             enum mtl_session_port s_port, struct st_rv_tp_slot* slot) {
-  struct st_rx_video_tp* tp = s->tp;
+static enum st_rx_tp_compliant rv_tp_slot_result(struct st_rx_video_tp* tp,
+                                                 struct st_rv_tp_slot* slot) {
   float cinst_avg = rv_tp_calculate_avg(slot->meta.pkts_cnt, slot->cinst_sum);
   float vrx_avg = rv_tp_calculate_avg(slot->meta.pkts_cnt, slot->vrx_sum);
   float ipt_avg = rv_tp_calculate_avg(slot->meta.pkts_cnt, slot->ipt_sum);
@@ -147,16 +151,23 @@ void rv_tp_slot_parse_result(struct st_rx_video_session_impl* s,
   slot->meta.cinst_avg = cinst_avg;
   slot->meta.vrx_avg = vrx_avg;
   slot->meta.ipt_avg = ipt_avg;
-  dbg("%s(%d), Cinst AVG %.2f MIN %d MAX %d \n", __func__, s->idx, cinst_avg,
-      slot->meta.cinst_min, slot->meta.cinst_max);
-  dbg("%s(%d), VRX AVG %.2f MIN %d MAX %d \n", __func__, s->idx, vrx_avg,
-      slot->meta.vrx_min, slot->meta.vrx_max);
-  dbg("%s(%d), Inter-packet time(ns) AVG %.2f MIN %d MAX %d!\n", __func__, s->idx,
-      ipt_avg, slot->meta.ipt_max, slot->meta.ipt_min);
+  dbg("%s, Cinst AVG %.2f MIN %d MAX %d \n", __func__, cinst_avg, slot->meta.cinst_min,
+      slot->meta.cinst_max);
+  dbg("%s, VRX AVG %.2f MIN %d MAX %d \n", __func__, vrx_avg, slot->meta.vrx_min,
+      slot->meta.vrx_max);
+  dbg("%s, Inter-packet time(ns) AVG %.2f MIN %d MAX %d!\n", __func__, ipt_avg,
+      slot->meta.ipt_max, slot->meta.ipt_min);
 
   /* parse tp compliant for current frame */
   enum st_rx_tp_compliant compliant = rv_tp_compliant(tp, slot);
   slot->meta.compliant = compliant;
+  return compliant;
+}
+
+void rv_tp_slot_parse_result(struct st_rx_video_session_impl* s,
+                             enum mtl_session_port s_port, struct st_rv_tp_slot* slot) {
+  struct st_rx_video_tp* tp = s->tp;
+  enum st_rx_tp_compliant compliant = rv_tp_slot_result(tp, slot);
 
   if (!s->enable_timing_parser_stat) return;
 
@@ -276,49 +287,40 @@ int rv_tp_uinit(struct st_rx_video_session_impl* s) {
   return 0;
 }
 
-int rv_tp_init(struct mtl_main_impl* impl, struct st_rx_video_session_impl* s) {
-  enum mtl_port port = mt_port_logic2phy(s->port_maps, MTL_SESSION_PORT_P);
-  int soc_id = mt_socket_id(impl, port);
-  int idx = s->idx, ret;
-  struct st_rx_video_tp* tp;
-  struct st20_rx_ops* ops = &s->ops;
-  double frame_time = s->frame_time;
-  double frame_time_s;
+/* init the frame timing and the pass criteria by the stream format */
+static int rv_tp_pass_init(struct st_rx_video_tp* tp, enum st_fps fps, uint32_t height,
+                           bool interlaced, int st20_total_pkts) {
+  double frame_time, frame_time_s;
   struct st_fps_timing fps_tm;
+  int ret;
 
-  ret = st_get_fps_timing(ops->fps, &fps_tm);
+  ret = st_get_fps_timing(fps, &fps_tm);
   if (ret < 0) {
-    err("%s(%d), invalid fps %d\n", __func__, idx, ops->fps);
+    err("%s, invalid fps %d\n", __func__, fps);
     return ret;
   }
-  frame_time_s = (double)fps_tm.den / fps_tm.mul;
-
-  int st20_total_pkts = s->detector.pkt_per_frame;
-  info("%s(%d), st20_total_pkts %d\n", __func__, idx, st20_total_pkts);
-  if (!st20_total_pkts) {
-    err("%s(%d), can not get total packets number\n", __func__, idx);
+  if (st20_total_pkts <= 0) {
+    err("%s, can not get total packets number\n", __func__);
     return -EINVAL;
   }
-
-  tp = mt_rte_zmalloc_socket(sizeof(*tp), soc_id);
-  if (!tp) {
-    err("%s(%d), tp malloc fail\n", __func__, idx);
-    return -ENOMEM;
-  }
-  s->tp = tp;
+  frame_time_s = (double)fps_tm.den / fps_tm.mul;
+  frame_time = (double)NS_PER_S * fps_tm.den / fps_tm.mul;
+  tp->frame_time = frame_time;
+  tp->frame_time_sampling =
+      (double)(fps_tm.sampling_clock_rate) * fps_tm.den / fps_tm.mul;
 
   double reactive = 1080.0 / 1125.0;
-  if (ops->interlaced && ops->height <= 576) {
-    reactive = (ops->height == 480) ? 487.0 / 525.0 : 576.0 / 625.0;
+  if (interlaced && height <= 576) {
+    reactive = (height == 480) ? 487.0 / 525.0 : 576.0 / 625.0;
   }
   tp->trs = frame_time * reactive / st20_total_pkts;
-  if (!ops->interlaced) {
+  if (!interlaced) {
     tp->pass.tr_offset =
-        ops->height >= 1080 ? frame_time * (43.0 / 1125.0) : frame_time * (28.0 / 750.0);
+        height >= 1080 ? frame_time * (43.0 / 1125.0) : frame_time * (28.0 / 750.0);
   } else {
-    if (ops->height == 480) {
+    if (height == 480) {
       tp->pass.tr_offset = frame_time * (20.0 / 525.0) * 2;
-    } else if (ops->height == 576) {
+    } else if (height == 576) {
       tp->pass.tr_offset = frame_time * (26.0 / 625.0) * 2;
     } else {
       tp->pass.tr_offset = frame_time * (22.0 / 1125.0) * 2;
@@ -337,14 +339,44 @@ int rv_tp_init(struct mtl_main_impl* impl, struct st_rx_video_session_impl* s) {
   tp->pass.rtp_offset_max =
       ceil((double)tp->pass.tr_offset * fps_tm.sampling_clock_rate / NS_PER_S) + 1;
   tp->pass.rtp_offset_min = -1;
-  int32_t sampling = s->frame_time_sampling;
+  int32_t sampling = tp->frame_time_sampling;
   tp->pass.rtp_ts_delta_max = sampling + 1;
   tp->pass.rtp_ts_delta_min = sampling;
 
+  return 0;
+}
+
+int rv_tp_init(struct mtl_main_impl* impl, struct st_rx_video_session_impl* s) {
+  enum mtl_port port = mt_port_logic2phy(s->port_maps, MTL_SESSION_PORT_P);
+  int soc_id = mt_socket_id(impl, port);
+  int idx = s->idx, ret;
+  struct st_rx_video_tp* tp;
+  struct st20_rx_ops* ops = &s->ops;
+
+  int st20_total_pkts = s->detector.pkt_per_frame;
+  info("%s(%d), st20_total_pkts %d\n", __func__, idx, st20_total_pkts);
+  if (!st20_total_pkts) {
+    err("%s(%d), can not get total packets number\n", __func__, idx);
+    return -EINVAL;
+  }
+
+  tp = mt_rte_zmalloc_socket(sizeof(*tp), soc_id);
+  if (!tp) {
+    err("%s(%d), tp malloc fail\n", __func__, idx);
+    return -ENOMEM;
+  }
+  s->tp = tp;
+
+  ret = rv_tp_pass_init(tp, ops->fps, ops->height, ops->interlaced, st20_total_pkts);
+  if (ret < 0) {
+    err("%s(%d), pass init fail %d\n", __func__, idx, ret);
+    return ret;
+  }
+
   rv_tp_stat_init(s, tp);
 
   info("%s[%02d], trs %f tr offset %d sampling %f\n", __func__, idx, tp->trs,
-       tp->pass.tr_offset, s->frame_time_sampling);
+       tp->pass.tr_offset, tp->frame_time_sampling);
   info(
       "%s[%02d], cinst_max_narrow %d cinst_max_wide %d vrx_max_narrow %d vrx_max_wide %d "
       "rtp_offset_max %d\n",
@@ -353,6 +385,79 @@ int rv_tp_init(struct mtl_main_impl* impl, struct st_rx_video_session_impl* s) {
   return 0;
 }
 
+st20_tp_parser_handle st20_tp_parser_create(struct st20_tp_parser_ops* ops) {
+  struct st20_tp_parser_impl* parser;
+  int ret;
+
+  if (!ops) {
+    err("%s, NULL ops\n", __func__);
+    return NULL;
+  }
+
+  /* offline use, no mtl instance hence not the hugepage memory */
+  parser = mt_zmalloc(sizeof(*parser));
+  if (!parser) {
+    err("%s, parser malloc fail\n", __func__);
+    return NULL;
+  }
+
+  ret = rv_tp_pass_init(&parser->tp, ops->fps, ops->height, ops->interlaced,
+                        ops->pkts_per_frame);
+  if (ret < 0) {
+    err("%s, pass init fail %d, fps %d height %u pkts %u\n", __func__, ret, ops->fps,
+        ops->height, ops->pkts_per_frame);
+    mt_free(parser);
+    return NULL;
+  }
+  rv_tp_slot_init(&parser->slot);
+
+  dbg("%s, trs %f tr offset %d pkts %u\n", __func__, parser->tp.trs,
+      parser->tp.pass.tr_offset, ops->pkts_per_frame);
+  return parser;
+}
+
+int st20_tp_parser_free(st20_tp_parser_handle handle) {
+  if (!handle) return -EINVAL;
+  mt_free(handle);
+  return 0;
+}
+
+int st20_tp_parser_pass(st20_tp_parser_handle handle, struct st20_rx_tp_pass* pass) {
+  if (!handle || !pass) return -EINVAL;
+  memcpy(pass, &handle->tp.pass, sizeof(*pass));
+  return 0;
+}
+
+int st20_tp_parser_frame_start(st20_tp_parser_handle handle, uint32_t prev_rtp_tmstamp) {
+  if (!handle) return -EINVAL;
+  handle->tp.pre_rtp_tmstamp[MTL_SESSION_PORT_P] = prev_rtp_tmstamp;
+  rv_tp_slot_init(&handle->slot);
+  return 0;
+}
+
+int st20_tp_parser_on_packet(st20_tp_parser_handle handle, uint32_t rtp_tmstamp,
+                             uint64_t pkt_time, uint32_t pkt_idx) {
+  if (!handle) return -EINVAL;
+  rv_tp_slot_on_packet(&handle->tp, MTL_SESSION_PORT_P, &handle->slot, rtp_tmstamp,
+                       pkt_time, pkt_idx);
+  return 0;
+}
+
+int st20_tp_parser_frame_result(st20_tp_parser_handle handle,
+                                struct st20_rx_tp_meta* meta) {
+  struct st_rv_tp_slot* slot;
+
+  if (!handle || !meta) return -EINVAL;
+  slot = &handle->slot;
+  if (!slot->meta.pkts_cnt) return -EIO;
+
+  rv_tp_slot_result(&handle->tp, slot);
+  memcpy(meta, &slot->meta, sizeof(*meta));
+  /* ready for next frame */
+  rv_tp_slot_init(slot);
+  return 0;
+}
+
 static void ra_tp_stat_init(struct st_rx_audio_tp* tp) {
   for (int s_port = 0; s_port < MTL_SESSION_PORT_MAX; s_port++) {
     struct st_ra_tp_stat* stat = &tp->stat[s_port];
@@ -218,10 +218,34 @@ static struct st_frame_trans* rv_get_frame(struct st_rx_video_session_impl* s) {
   return NULL;
 }
 
+/* free the held mbufs of the codestream segments */
+static void rv_st22_sg_release(struct st22_rx_video_info* st22_info,
+                               struct st22_rx_sg_frame* sg) {
+  for (uint32_t i = 0; i < sg->segs_nb; i++) {
+    struct rte_mbuf* mbuf = sg->mbufs[i];
+    if (mbuf) {
+      for (int port = 0; port < MTL_SESSION_PORT_MAX; port++) {
+        if (st22_info->sg_pool[port] == mbuf->pool) {
+          rte_atomic32_dec(st22_info->sg_pool_held[port]);
+          break;
+        }
+      }
+      rte_pktmbuf_free(mbuf);
+      sg->mbufs[i] = NULL;
+      rte_atomic32_dec(&st22_info->sg_held);
+    }
+    sg->segs[i].addr = NULL;
+    sg->segs[i].len = 0;
+  }
+  sg->segs_nb = 0;
+}
+
 static int rv_put_frame(struct st_rx_video_session_impl* s,
                         struct st_frame_trans* frame) {
   MTL_MAY_UNUSED(s);
   dbg("%s(%d), put frame at %d\n", __func__, s->idx, frame->idx);
+  if (s->st22_info && s->st22_info->sg_frames)
+    rv_st22_sg_release(s->st22_info, &s->st22_info->sg_frames[frame->idx]);
   rte_atomic32_dec(&frame->refcnt);
   if (s->st22_info)
     MT_USDT_ST22_RX_FRAME_PUT(s->parent->idx, s->idx, frame->idx, frame->addr);
@@ -1006,11 +1030,16 @@ static void rv_st22_frame_notify(struct st_rx_video_session_impl* s,
        s_port++) {
     meta->pkts_recv[s_port] = slot->pkts_recv_per_port[s_port];
   }
+  if (s->st22_info->sg_frames) {
+    struct st22_rx_sg_frame* sg = &s->st22_info->sg_frames[frame->idx];
+    meta->segs = sg->segs;
+    meta->segs_nb = sg->segs_nb;
+  }
 
   MT_USDT_ST22_RX_FRAME_AVAILABLE(s->parent->idx, s->idx, frame->idx, frame->addr,
                                   slot->tmstamp, meta->frame_total_size);
-  /* check if dump USDT enabled */
-  if (MT_USDT_ST22_RX_FRAME_DUMP_ENABLED()) {
+  /* check if dump USDT enabled, the framebuffer has no codestream for sg mode */
+  if (MT_USDT_ST22_RX_FRAME_DUMP_ENABLED() && !s->st22_info->sg_frames) {
     int period = st_frame_rate(ops->fps) * 5; /* dump every 5s now */
     if ((s->usdt_frame_cnt % period) == (period / 2)) {
       rv_st22_usdt_dump_frame(s->impl, s, frame, meta->frame_total_size);
@@ -2002,6 +2031,48 @@ static int rv_parse_st22_boxes(struct st_rx_video_session_impl* s, void* boxes,
   return 0;
 }
 
+/*
+ * keep the pkt as one codestream segment, copy if the hold budget of the rx pool is
+ * used up. The budget is shared by all the sessions on the pool.
+ */
+static void rv_st22_sg_add(struct st_rx_video_session_impl* s,
+                           enum mtl_session_port s_port, struct st_frame_trans* frame,
+                           struct rte_mbuf* mbuf, uint32_t pkt_counter, uint32_t offset,
+                           void* payload, uint16_t payload_length) {
+  struct st22_rx_video_info* st22_info = s->st22_info;
+  struct st22_rx_sg_frame* sg = &st22_info->sg_frames[frame->idx];
+  struct st22_rx_codestream_seg* seg = &sg->segs[pkt_counter];
+  bool hold = false;
+
+  if (!st22_info->sg_pool[s_port]) { /* the pool of the first pkt on this port */
+    st22_info->sg_pool[s_port] = mbuf->pool;
+    st22_info->sg_pool_held[s_port] = mt_if_rx_pool_held(
+        rv_get_impl(s), mt_port_logic2phy(s->port_maps, s_port), mbuf->pool);
+  }
+  /* a pkt from any other pool is not accounted, copy it */
+  if (st22_info->sg_pool[s_port] == mbuf->pool) {
+    rte_atomic32_t* pool_held = st22_info->sg_pool_held[s_port];
+    if (rte_atomic32_add_return(pool_held, 1) <= ST_VIDEO_RX_ST22_SG_HOLD_MAX)
+      hold = true;
+    else
+      rte_atomic32_dec(pool_held);
+  }
+
+  if (hold) {
+    rte_mbuf_refcnt_update(mbuf, 1); /* free when app put */
+    rte_atomic32_inc(&st22_info->sg_held);
+    sg->mbufs[pkt_counter] = mbuf;
+    seg->addr = payload;
+    st22_info->stat_sg_hold++;
+  } else {
+    seg->addr = frame->addr + offset;
+    rv_frame_memcpy(seg->addr, payload, payload_length);
+    st22_info->stat_sg_copy++;
+  }
+  seg->len = payload_length;
+  if (pkt_counter >= sg->segs_nb) sg->segs_nb = pkt_counter + 1;
+}
+
 static int rv_handle_st22_pkt(struct st_rx_video_session_impl* s, struct rte_mbuf* mbuf,
                               enum mtl_session_port s_port, bool ctrl_thread) {
   MTL_MAY_UNUSED(s_port);
@@ -2157,7 +2228,17 @@ static int rv_handle_st22_pkt(struct st_rx_video_session_impl* s, struct rte_mbu
     s->port_user_stats.stat_pkts_offset_dropped++;
     return -EIO;
   }
-  rv_frame_memcpy(slot->frame->addr + offset, payload, payload_length);
+  if (s->st22_info->sg_frames) {
+    if ((uint32_t)pkt_counter >= s->st22_info->sg_segs_max) {
+      dbg("%s(%d,%d): invalid pkt counter %d\n", __func__, s->idx, s_port, pkt_counter);
+      s->port_user_stats.stat_pkts_offset_dropped++;
+      return -EIO;
+    }
+    rv_st22_sg_add(s, s_port, slot->frame, mbuf, pkt_counter, offset, payload,
+                   payload_length);
+  } else {
+    rv_frame_memcpy(slot->frame->addr + offset, payload, payload_length);
+  }
   rv_slot_add_frame_size(slot, payload_length);
   s->port_user_stats.common.stat_pkts_received++;
   slot->pkts_received++;
@@ -2478,10 +2559,44 @@ static int rv_init_st22(struct st_rx_video_session_impl* s,
 
   s->st22_info = st22_info;
 
+  if (st22_frame_ops->flags & ST22_RX_FLAG_CODESTREAM_SG) {
+    uint16_t frames_cnt = s->st20_frames_cnt;
+    uint32_t segs_max = s->st20_frame_bitmap_size * 8;
+    struct st22_rx_sg_frame* sg_frames;
+
+    sg_frames = mt_rte_zmalloc_socket(sizeof(*sg_frames) * frames_cnt, s->socket_id);
+    if (!sg_frames) return -ENOMEM;
+    st22_info->sg_frames = sg_frames;
+    st22_info->sg_frames_cnt = frames_cnt;
+    st22_info->sg_segs_max = segs_max;
+    rte_atomic32_set(&st22_info->sg_held, 0);
+    for (uint16_t i = 0; i < frames_cnt; i++) {
+      sg_frames[i].segs =
+          mt_rte_zmalloc_socket(sizeof(*sg_frames[i].segs) * segs_max, s->socket_id);
+      sg_frames[i].mbufs =
+          mt_rte_zmalloc_socket(sizeof(*sg_frames[i].mbufs) * segs_max, s->socket_id);
+      if (!sg_frames[i].segs || !sg_frames[i].mbufs) return -ENOMEM;
+    }
+    info("%s(%d), codestream sg mode, max %u segs\n", __func__, s->idx, segs_max);
+  }
+
   return 0;
 }
 
 static int rv_uinit_st22(struct st_rx_video_session_impl* s) {
+  struct st22_rx_video_info* st22_info = s->st22_info;
+
+  if (st22_info && st22_info->sg_frames) {
+    for (uint16_t i = 0; i < st22_info->sg_frames_cnt; i++) {
+      struct st22_rx_sg_frame* sg = &st22_info->sg_frames[i];
+      /* the frames still in app */
+      if (sg->segs && sg->mbufs) rv_st22_sg_release(st22_info, sg);
+      if (sg->segs) mt_rte_free(sg->segs);
+      if (sg->mbufs) mt_rte_free(sg->mbufs);
+    }
+    mt_rte_free(st22_info->sg_frames);
+    st22_info->sg_frames = NULL;
+  }
   if (s->st22_info) {
     mt_rte_free(s->st22_info);
     s->st22_info = NULL;
@@ -2518,6 +2633,7 @@ static int rv_init_sw(struct mtl_main_impl* impl, struct st_rx_video_sessions_mg
     ret = rv_init_st22(s, st22_ops);
     if (ret < 0) {
       err("%s(%d), st22 frame init fail %d\n", __func__, idx, ret);
+      rv_uinit_st22(s);
       return ret;
     }
   }
@@ -3801,6 +3917,16 @@ static void rv_stat(struct st_rx_video_sessions_mgr* mgr,
     notice("RX_VIDEO_SESSION(%d,%d): st22 video support boxes received %" PRIu64 " \n",
            m_idx, idx, d);
   }
+  if (s->st22_info && s->st22_info->sg_frames) {
+    struct st22_rx_video_info* st22_info = s->st22_info;
+    rte_atomic32_t* pool_held = st22_info->sg_pool_held[MTL_SESSION_PORT_P];
+    notice("RX_VIDEO_SESSION(%d,%d): st22 sg pkts hold %u copy %u, held now %d pool %d\n",
+           m_idx, idx, st22_info->stat_sg_hold, st22_info->stat_sg_copy,
+           rte_atomic32_read(&st22_info->sg_held),
+           pool_held ? rte_atomic32_read(pool_held) : 0);
+    st22_info->stat_sg_hold = 0;
+    st22_info->stat_sg_copy = 0;
+  }
   uint64_t burst_succ = us->stat_burst_succ_cnt - snap->stat_burst_succ_cnt;
   if (burst_succ) {
     uint64_t burst_max = us->stat_burst_pkts_max - snap->stat_burst_pkts_max;
@@ -0,0 +1,535 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include "st_scale.h"
+
+#include <math.h>
+
+#include "../mt_log.h"
+#include "st_fmt.h"
+
+#ifdef MTL_HAS_AVX2
+#include "st_avx2.h"
+#endif
+
+#define ST_SCALE_COEFF_ONE (1 << ST_SCALE_COEFF_BITS)
+
+struct st_scale_fmt_desc {
+  enum st_frame_fmt fmt;
+  uint8_t sample_bytes;
+  uint32_t max;
+};
+
+static const struct st_scale_fmt_desc st_scale_fmt_descs[] = {
+    {ST_FRAME_FMT_YUV422PLANAR8, 1, 0xFF},
+    {ST_FRAME_FMT_YUV420PLANAR8, 1, 0xFF},
+    {ST_FRAME_FMT_YUV422PLANAR10LE, 2, 0x3FF},
+    {ST_FRAME_FMT_YUV422PLANAR12LE, 2, 0xFFF},
+    /* 10 bit in the msb, the 6 bit padding stays zero */
+    {ST_FRAME_FMT_YUV422PLANAR16LE, 2, 0xFFC0},
+    {ST_FRAME_FMT_YUV444PLANAR10LE, 2, 0x3FF},
+    {ST_FRAME_FMT_YUV444PLANAR12LE, 2, 0xFFF},
+    {ST_FRAME_FMT_GBRPLANAR10LE, 2, 0x3FF},
+    {ST_FRAME_FMT_GBRPLANAR12LE, 2, 0xFFF},
+};
+
+static const struct st_scale_fmt_desc* scale_fmt_desc(enum st_frame_fmt fmt) {
+  for (int i = 0; i < MTL_ARRAY_SIZE(st_scale_fmt_descs); i++) {
+    if (st_scale_fmt_descs[i].fmt == fmt) return &st_scale_fmt_descs[i];
+  }
+  return NULL;
+}
+
+bool st_frame_scale_fmt_supported(enum st_frame_fmt fmt) {
+  return scale_fmt_desc(fmt) ? true : false;
+}
+
+static const char* scale_method_name(enum st_frame_scale_method method) {
+  switch (method) {
+    case ST_FRAME_SCALE_BOX:
+      return "box";
+    case ST_FRAME_SCALE_BILINEAR:
+      return "bilinear";
+    case ST_FRAME_SCALE_POLYPHASE:
+      return "polyphase";
+    default:
+      return "unknown";
+  }
+}
+
+static void scale_plane_size(enum st_frame_fmt fmt, uint8_t plane, uint32_t w, uint32_t h,
+                             uint32_t* plane_w, uint32_t* plane_h) {
+  enum st_frame_sampling sampling = st_frame_fmt_get_sampling(fmt);
+
+  *plane_w = w;
+  *plane_h = h;
+  if (!plane || sampling == ST_FRAME_SAMPLING_444) return;
+  *plane_w = w / 2;
+  if (sampling == ST_FRAME_SAMPLING_420) *plane_h = h / 2;
+}
+
+static double scale_lanczos2(double x) {
+  if (x < 0) x = -x;
+  if (x < 1e-9) return 1.0;
+  if (x >= 2.0) return 0.0;
+  double px = M_PI * x;
+  return 2.0 * sin(px) * sin(px / 2.0) / (px * px);
+}
+
+static void scale_filter_free(struct st_scale_filter* f) {
+  if (f->offset) {
+    mt_free(f->offset);
+    f->offset = NULL;
+  }
+  if (f->coeff) {
+    mt_free(f->coeff);
+    f->coeff = NULL;
+  }
+}
+
+/* the raw weights of output i on the source samples [*first, *first + taps) */
+static void scale_filter_weights(enum st_frame_scale_method method, double ratio,
+                                 uint32_t i, uint16_t taps, int32_t* first,
+                                 double* weights) {
+  for (uint16_t t = 0; t < taps; t++) weights[t] = 0;
+
+  if (method == ST_FRAME_SCALE_BOX) {
+    /* the coverage of [start, end) on each source sample */
+    double start = i * ratio;
+    double end = start + ratio;
+    *first = (int32_t)floor(start);
+    for (uint16_t t = 0; t < taps; t++) {
+      double s = *first + t;
+      double lo = s > start ? s : start;
+      double hi = (s + 1) < end ? (s + 1) : end;
+      if (hi > lo) weights[t] = hi - lo;
+    }
+    return;
+  }
+
+  /* center aligned position of output i on the source */
+  double center = (i + 0.5) * ratio - 0.5;
+  int32_t base = (int32_t)floor(center);
+  double frac = center - base;
+
+  if (method == ST_FRAME_SCALE_BILINEAR) {
+    *first = base;
+    weights[0] = 1.0 - frac;
+    weights[1] = frac;
+    return;
+  }
+
+  /* polyphase, the fraction quantized to ST_SCALE_PHASES phases */
+  int phase = (int)lround(frac * ST_SCALE_PHASES);
+  if (phase >= ST_SCALE_PHASES) {
+    base++;
+    phase = 0;
+  }
+  frac = (double)phase / ST_SCALE_PHASES;
+  *first = base - taps / 2 + 1;
+  for (uint16_t t = 0; t < taps; t++) {
+    double x = (*first + t) - (base + frac);
+    weights[t] = scale_lanczos2(x / ratio);
+  }
+}
+
+static int scale_filter_init(struct st_scale_filter* f, uint32_t src_n, uint32_t dst_n,
+                             enum st_frame_scale_method method) {
+  double ratio = (double)src_n / dst_n;
+  double weights[ST_SCALE_TAPS_MAX];
+  double folded[ST_SCALE_TAPS_MAX];
+  uint16_t raw_taps; /* the taps before the edge fold */
+  uint16_t taps;
+
+  if (ratio > ST_SCALE_RATIO_MAX) {
+    err("%s, %s ratio %u:%u above %d\n", __func__, scale_method_name(method), src_n,
+        dst_n, ST_SCALE_RATIO_MAX);
+    return -EINVAL;
+  }
+  if (src_n == dst_n) {
+    raw_taps = 1; /* identity */
+  } else if (method == ST_FRAME_SCALE_BOX) {
+    raw_taps = (uint16_t)ceil(ratio);
+    if (raw_taps != ratio) raw_taps++; /* start not on the sample border */
+  } else if (method == ST_FRAME_SCALE_BILINEAR) {
+    raw_taps = 2;
+  } else {
+    /* the lanczos-2 support is two source samples per ratio on each side */
+    raw_taps = 2 * ((uint16_t)floor(2.0 * ratio) + 1);
+  }
+  taps = raw_taps > src_n ? src_n : raw_taps;
+
+  f->src_n = src_n;
+  f->dst_n = dst_n;
+  f->taps = taps;
+  f->offset = mt_zmalloc(sizeof(*f->offset) * dst_n);
+  f->coeff = mt_zmalloc(sizeof(*f->coeff) * dst_n * taps);
+  if (!f->offset || !f->coeff) {
+    scale_filter_free(f);
+    return -ENOMEM;
+  }
+
+  for (uint32_t i = 0; i < dst_n; i++) {
+    int32_t first = i;
+
+    if (raw_taps == 1) {
+      weights[0] = 1.0;
+    } else {
+      scale_filter_weights(method, ratio, i, raw_taps, &first, weights);
+    }
+
+    /* fold the taps out of the source edge into the border samples */
+    int32_t offset = first;
+    if (offset > (int32_t)(src_n - taps)) offset = src_n - taps;
+    if (offset < 0) offset = 0;
+    double sum = 0;
+    for (uint16_t t = 0; t < taps; t++) folded[t] = 0;
+    for (uint16_t t = 0; t < raw_taps; t++) {
+      int32_t pos = first + t;
+      if (pos < 0) pos = 0;
+      if (pos > (int32_t)src_n - 1) pos = src_n - 1;
+      folded[pos - offset] += weights[t];
+      sum += weights[t];
+    }
+
+    /* to fixed point, the rounding error goes to the biggest tap */
+    int32_t total = 0;
+    uint16_t max_t = 0;
+    for (uint16_t t = 0; t < taps; t++) {
+      int32_t c = (int32_t)lround(folded[t] / sum * ST_SCALE_COEFF_ONE);
+      f->coeff[t * dst_n + i] = c;
+      total += c;
+      if (c > f->coeff[max_t * dst_n + i]) max_t = t;
+    }
+    f->coeff[max_t * dst_n + i] += ST_SCALE_COEFF_ONE - total;
+    f->offset[i] = offset;
+  }
+
+  return 0;
+}
+
+static void scale_vfilter_u16_scalar(const uint16_t** lines, const int32_t* coeff,
+                                     uint16_t taps, uint32_t w, uint8_t frac_bits,
+                                     int32_t* out) {
+  uint8_t shift = ST_SCALE_COEFF_BITS - frac_bits;
+
+  for (uint32_t x = 0; x < w; x++) {
+    int32_t acc = 1 << (shift - 1);
+    for (uint16_t t = 0; t < taps; t++) acc += coeff[t] * lines[t][x];
+    out[x] = acc >> shift;
+  }
+}
+
+static void scale_vfilter_u8_scalar(const uint8_t** lines, const int32_t* coeff,
+                                    uint16_t taps, uint32_t w, uint8_t frac_bits,
+                                    int32_t* out) {
+  uint8_t shift = ST_SCALE_COEFF_BITS - frac_bits;
+
+  for (uint32_t x = 0; x < w; x++) {
+    int32_t acc = 1 << (shift - 1);
+    for (uint16_t t = 0; t < taps; t++) acc += coeff[t] * lines[t][x];
+    out[x] = acc >> shift;
+  }
+}
+
+static inline int32_t scale_hfilter_sample(const int32_t* in,
+                                           const struct st_scale_filter* f, uint32_t i,
+                                           uint8_t frac_bits, int32_t max) {
+  const int32_t* src = in + f->offset[i];
+  uint8_t shift = ST_SCALE_COEFF_BITS + frac_bits;
+  int32_t acc = 1 << (shift - 1);
+
+  for (uint16_t t = 0; t < f->taps; t++) acc += f->coeff[t * f->dst_n + i] * src[t];
+  acc >>= shift;
+  if (acc < 0) acc = 0;
+  if (acc > max) acc = max;
+  return acc & max;
+}
+
+static void scale_hfilter_u16_scalar(const int32_t* in, const struct st_scale_filter* f,
+                                     uint8_t frac_bits, uint32_t max, uint16_t* out) {
+  for (uint32_t i = 0; i < f->dst_n; i++)
+    out[i] = scale_hfilter_sample(in, f, i, frac_bits, max);
+}
+
+static void scale_hfilter_u8_scalar(const int32_t* in, const struct st_scale_filter* f,
+                                    uint8_t frac_bits, uint32_t max, uint8_t* out) {
+  for (uint32_t i = 0; i < f->dst_n; i++)
+    out[i] = scale_hfilter_sample(in, f, i, frac_bits, max);
+}
+
+static void scale_vfilter(struct st_frame_scaler* scaler, const void** lines,
+                          const int32_t* coeff, uint16_t taps, uint32_t w,
+                          int32_t* line) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  enum mtl_simd_level level = scaler->simd_level;
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(ret);
+  MTL_MAY_UNUSED(level);
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    if (scaler->sample_bytes == 2)
+      ret = st_scale_vfilter_u16_avx2((const uint16_t**)lines, coeff, taps, w,
+                                      scaler->frac_bits, line);
+    else
+      ret = st_scale_vfilter_u8_avx2((const uint8_t**)lines, coeff, taps, w,
+                                     scaler->frac_bits, line);
+    if (ret == 0) return;
+    err("%s, avx2 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  /* the last option */
+  if (scaler->sample_bytes == 2)
+    scale_vfilter_u16_scalar((const uint16_t**)lines, coeff, taps, w, scaler->frac_bits,
+                             line);
+  else
+    scale_vfilter_u8_scalar((const uint8_t**)lines, coeff, taps, w, scaler->frac_bits,
+                            line);
+}
+
+static void scale_hfilter(struct st_frame_scaler* scaler, const struct st_scale_filter* f,
+                          const int32_t* line, void* out) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  enum mtl_simd_level level = scaler->simd_level;
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(ret);
+  MTL_MAY_UNUSED(level);
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    if (scaler->sample_bytes == 2)
+      ret = st_scale_hfilter_u16_avx2(line, f->offset, f->coeff, f->taps,
+                                      f->dst_n, scaler->frac_bits, scaler->max, out);
+    else
+      ret = st_scale_hfilter_u8_avx2(line, f->offset, f->coeff, f->taps,
+                                     f->dst_n, scaler->frac_bits, scaler->max, out);
+    if (ret == 0) return;
+    err("%s, avx2 ways failed %d\n", __func__, ret);
+  }
+#endif
+
+  /* the last option */
+  if (scaler->sample_bytes == 2)
+    scale_hfilter_u16_scalar(line, f, scaler->frac_bits, scaler->max, out);
+  else
+    scale_hfilter_u8_scalar(line, f, scaler->frac_bits, scaler->max, out);
+}
+
+/* filter the output line from the source plane, the vertical pass then the horizontal */
+static void scale_line(struct st_frame_scaler* scaler, struct st_scale_plane* sp,
+                       struct st_frame* src, struct st_frame* dst, uint8_t plane,
+                       uint32_t line, int32_t* work) {
+  const struct st_scale_filter* v = &sp->v;
+  const void* lines[ST_SCALE_TAPS_MAX];
+  int32_t coeff[ST_SCALE_TAPS_MAX];
+  uint32_t offset = v->offset[line];
+
+  for (uint16_t t = 0; t < v->taps; t++) {
+    lines[t] =
+        (uint8_t*)src->addr[plane] + st_frame_plane_row_size(src, plane) * (offset + t);
+    coeff[t] = v->coeff[t * v->dst_n + line];
+  }
+  scale_vfilter(scaler, lines, coeff, v->taps, sp->src_w, work);
+  scale_hfilter(scaler, &sp->h, work,
+                (uint8_t*)dst->addr[plane] + st_frame_plane_row_size(dst, plane) * line);
+}
+
+void st_frame_scaler_free(struct st_frame_scaler* scaler) {
+  if (scaler->outputs) {
+    for (uint16_t i = 0; i < scaler->output_cnt; i++) {
+      for (uint8_t plane = 0; plane < ST_MAX_PLANES; plane++) {
+        scale_filter_free(&scaler->outputs[i].planes[plane].h);
+        scale_filter_free(&scaler->outputs[i].planes[plane].v);
+      }
+    }
+    mt_free(scaler->outputs);
+    scaler->outputs = NULL;
+  }
+  if (scaler->line) {
+    mt_free(scaler->line);
+    scaler->line = NULL;
+  }
+  mt_free(scaler);
+}
+
+static int scale_size_check(enum st_frame_fmt fmt, uint32_t src_w, uint32_t src_h,
+                            uint32_t w, uint32_t h) {
+  enum st_frame_sampling sampling = st_frame_fmt_get_sampling(fmt);
+
+  if (!w || !h || w > src_w || h > src_h) {
+    err("%s, %ux%u not a downscale of %ux%u\n", __func__, w, h, src_w, src_h);
+    return -EINVAL;
+  }
+  if (sampling != ST_FRAME_SAMPLING_444 && (w % 2)) {
+    err("%s, width %u not even for %s\n", __func__, w, st_frame_fmt_name(fmt));
+    return -EINVAL;
+  }
+  if (sampling == ST_FRAME_SAMPLING_420 && (h % 2)) {
+    err("%s, height %u not even for %s\n", __func__, h, st_frame_fmt_name(fmt));
+    return -EINVAL;
+  }
+  return 0;
+}
+
+struct st_frame_scaler* st_frame_scaler_create(enum st_frame_fmt fmt, uint32_t src_w,
+                                               uint32_t src_h, const uint32_t* widths,
+                                               const uint32_t* heights, uint16_t cnt,
+                                               enum st_frame_scale_method method) {
+  const struct st_scale_fmt_desc* desc = scale_fmt_desc(fmt);
+  struct st_frame_scaler* scaler;
+  int ret;
+
+  if (!desc) {
+    err("%s, fmt %s not supported\n", __func__, st_frame_fmt_name(fmt));
+    return NULL;
+  }
+  if (method >= ST_FRAME_SCALE_MAX) {
+    err("%s, invalid method %d\n", __func__, method);
+    return NULL;
+  }
+  if (!cnt || cnt > ST_FRAME_SCALE_OUTPUTS_MAX) {
+    err("%s, invalid outputs cnt %u\n", __func__, cnt);
+    return NULL;
+  }
+  if (scale_size_check(fmt, src_w, src_h, src_w, src_h) < 0) return NULL;
+  for (uint16_t i = 0; i < cnt; i++) {
+    if (scale_size_check(fmt, src_w, src_h, widths[i], heights[i]) < 0) return NULL;
+  }
+
+  scaler = mt_zmalloc(sizeof(*scaler));
+  if (!scaler) {
+    err("%s, scaler malloc fail\n", __func__);
+    return NULL;
+  }
+  scaler->fmt = fmt;
+  scaler->method = method;
+  scaler->src_w = src_w;
+  scaler->src_h = src_h;
+  scaler->planes = st_frame_fmt_planes(fmt);
+  scaler->sample_bytes = desc->sample_bytes;
+  scaler->max = desc->max;
+  /* the line of 16 bit samples has no headroom for the fraction in int32 */
+  scaler->frac_bits = (desc->max > 0xFFF) ? 0 : ST_SCALE_LINE_FRAC_BITS;
+  scaler->simd_level = MTL_SIMD_LEVEL_MAX;
+  scaler->line = mt_zmalloc(sizeof(*scaler->line) * src_w);
+  scaler->outputs = mt_zmalloc(sizeof(*scaler->outputs) * cnt);
+  if (!scaler->line || !scaler->outputs) {
+    err("%s, line or outputs malloc fail\n", __func__);
+    st_frame_scaler_free(scaler);
+    return NULL;
+  }
+  scaler->output_cnt = cnt;
+
+  for (uint16_t i = 0; i < cnt; i++) {
+    struct st_scale_output* out = &scaler->outputs[i];
+
+    out->width = widths[i];
+    out->height = heights[i];
+    for (uint8_t plane = 0; plane < scaler->planes; plane++) {
+      struct st_scale_plane* sp = &out->planes[plane];
+      uint32_t dst_w, dst_h;
+
+      scale_plane_size(fmt, plane, src_w, src_h, &sp->src_w, &sp->src_h);
+      scale_plane_size(fmt, plane, out->width, out->height, &dst_w, &dst_h);
+      ret = scale_filter_init(&sp->h, sp->src_w, dst_w, method);
+      if (ret >= 0) ret = scale_filter_init(&sp->v, sp->src_h, dst_h, method);
+      if (ret < 0) {
+        err("%s, output %u filter init fail %d\n", __func__, i, ret);
+        st_frame_scaler_free(scaler);
+        return NULL;
+      }
+    }
+  }
+
+  dbg("%s, %s %ux%u to %u outputs, %s\n", __func__, st_frame_fmt_name(fmt), src_w, src_h,
+      cnt, scale_method_name(method));
+  return scaler;
+}
+
+int st_frame_scaler_run_line(struct st_frame_scaler* scaler, struct st_frame* src,
+                             struct st_frame** dsts, int32_t* line) {
+  uint32_t next[ST_FRAME_SCALE_OUTPUTS_MAX];
+
+  if (src->fmt != scaler->fmt || src->width != scaler->src_w ||
+      st_frame_data_height(src) != scaler->src_h) {
+    err("%s, src %s %ux%u not match the scaler\n", __func__, st_frame_fmt_name(src->fmt),
+        src->width, st_frame_data_height(src));
+    return -EINVAL;
+  }
+  for (uint16_t i = 0; i < scaler->output_cnt; i++) {
+    struct st_frame* dst = dsts[i];
+    if (dst->fmt != scaler->fmt || dst->width != scaler->outputs[i].width ||
+        st_frame_data_height(dst) != scaler->outputs[i].height) {
+      err("%s, dst %u %s %ux%u not match the scaler\n", __func__, i,
+          st_frame_fmt_name(dst->fmt), dst->width, st_frame_data_height(dst));
+      return -EINVAL;
+    }
+  }
+
+  for (uint8_t plane = 0; plane < scaler->planes; plane++) {
+    uint32_t src_h = scaler->outputs[0].planes[plane].src_h;
+
+    for (uint16_t i = 0; i < scaler->output_cnt; i++) next[i] = 0;
+    /* all outputs consume a step of source lines while they are still in cache */
+    for (uint32_t end = 0; end < src_h;) {
+      end += ST_SCALE_SRC_LINES_STEP;
+      if (end > src_h) end = src_h;
+      for (uint16_t i = 0; i < scaler->output_cnt; i++) {
+        struct st_scale_plane* sp = &scaler->outputs[i].planes[plane];
+        const struct st_scale_filter* v = &sp->v;
+
+        while (next[i] < v->dst_n && v->offset[next[i]] + v->taps <= end) {
+          scale_line(scaler, sp, src, dsts[i], plane, next[i], line);
+          next[i]++;
+        }
+      }
+    }
+  }
+
+  return 0;
+}
+
+int st_frame_scaler_run(struct st_frame_scaler* scaler, struct st_frame* src,
+                        struct st_frame** dsts) {
+  return st_frame_scaler_run_line(scaler, src, dsts, scaler->line);
+}
+
+int st_frame_scale_multi(struct st_frame* src, struct st_frame** dsts, uint16_t dst_cnt,
+                         enum st_frame_scale_method method) {
+  uint32_t widths[ST_FRAME_SCALE_OUTPUTS_MAX];
+  uint32_t heights[ST_FRAME_SCALE_OUTPUTS_MAX];
+  struct st_frame_scaler* scaler;
+  int ret;
+
+  if (!dst_cnt || dst_cnt > ST_FRAME_SCALE_OUTPUTS_MAX) {
+    err("%s, invalid dst cnt %u\n", __func__, dst_cnt);
+    return -EINVAL;
+  }
+  for (uint16_t i = 0; i < dst_cnt; i++) {
+    if (dsts[i]->fmt != src->fmt || dsts[i]->interlaced != src->interlaced) {
+      err("%s, dst %u fmt or interlace not match the source\n", __func__, i);
+      return -EINVAL;
+    }
+    widths[i] = dsts[i]->width;
+    heights[i] = st_frame_data_height(dsts[i]);
+  }
+
+  scaler = st_frame_scaler_create(src->fmt, src->width, st_frame_data_height(src), widths,
+                                  heights, dst_cnt, method);
+  if (!scaler) return -EINVAL;
+  ret = st_frame_scaler_run(scaler, src, dsts);
+  st_frame_scaler_free(scaler);
+  return ret;
+}
+
+int st_frame_scale(struct st_frame* src, struct st_frame* dst,
+                   enum st_frame_scale_method method) {
+  return st_frame_scale_multi(src, &dst, 1, method);
+}
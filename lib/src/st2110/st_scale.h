@@ -0,0 +1,85 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#ifndef _ST_LIB_FRAME_SCALE_HEAD_H_
+#define _ST_LIB_FRAME_SCALE_HEAD_H_
+
+#include "st_main.h"
+
+/* the fixed point bits of the filter coefficients, the taps of one output sum to one */
+#define ST_SCALE_COEFF_BITS (14)
+/* the fraction bits kept in the vertical filtered line, not for the 16 bit samples */
+#define ST_SCALE_LINE_FRAC_BITS (2)
+/* the phases of the polyphase filter */
+#define ST_SCALE_PHASES (64)
+/* source lines scanned per step, all outputs consume them before the next step */
+#define ST_SCALE_SRC_LINES_STEP (16)
+/* the max downscale ratio on each axis */
+#define ST_SCALE_RATIO_MAX (16)
+/* the max taps of one filter, the polyphase taps at ST_SCALE_RATIO_MAX */
+#define ST_SCALE_TAPS_MAX (2 * (2 * ST_SCALE_RATIO_MAX + 1))
+
+/* the separable filter of one axis, src_n samples to dst_n samples */
+struct st_scale_filter {
+  uint32_t src_n;
+  uint32_t dst_n;
+  uint16_t taps;
+  /* the first source sample of each output sample */
+  uint32_t* offset;
+  /* tap major, coeff[t * dst_n + i] is the tap t of the output sample i */
+  int32_t* coeff;
+};
+
+struct st_scale_plane {
+  uint32_t src_w;
+  uint32_t src_h;
+  struct st_scale_filter h;
+  struct st_scale_filter v;
+};
+
+struct st_scale_output {
+  uint32_t width;
+  uint32_t height; /* the data height, the field height for interlaced */
+  struct st_scale_plane planes[ST_MAX_PLANES];
+};
+
+struct st_frame_scaler {
+  enum st_frame_fmt fmt;
+  enum st_frame_scale_method method;
+  uint32_t src_w;
+  uint32_t src_h; /* the data height, the field height for interlaced */
+  uint8_t planes;
+  uint8_t sample_bytes;
+  uint32_t max; /* the max sample value, also the valid bits mask */
+  uint8_t frac_bits; /* the fraction bits of line, avoid the double rounding */
+  enum mtl_simd_level simd_level;
+  uint16_t output_cnt;
+  struct st_scale_output* outputs;
+  /* the vertical filtered line of one plane, src_w samples, for st_frame_scaler_run */
+  int32_t* line;
+};
+
+bool st_frame_scale_fmt_supported(enum st_frame_fmt fmt);
+
+/*
+ * Build the filters from the source size to each size of the outputs once, the src_h and
+ * the output heights are data heights. Free with st_frame_scaler_free.
+ */
+struct st_frame_scaler* st_frame_scaler_create(enum st_frame_fmt fmt, uint32_t src_w,
+                                               uint32_t src_h, const uint32_t* widths,
+                                               const uint32_t* heights, uint16_t cnt,
+                                               enum st_frame_scale_method method);
+void st_frame_scaler_free(struct st_frame_scaler* scaler);
+
+/* scale src to all the outputs in one pass over the source lines */
+int st_frame_scaler_run(struct st_frame_scaler* scaler, struct st_frame* src,
+                        struct st_frame** dsts);
+/*
+ * Same as st_frame_scaler_run but with the caller's line of src_w int32 samples, the
+ * scaler is read only then and several threads can run it at the same time.
+ */
+int st_frame_scaler_run_line(struct st_frame_scaler* scaler, struct st_frame* src,
+                             struct st_frame** dsts, int32_t* line);
+
+#endif
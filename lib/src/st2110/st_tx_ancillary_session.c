@@ -13,6 +13,7 @@
 #include "st_ancillary_transmitter.h"
 #include "st_err.h"
 #include "st_tx_ancillary_test.h"
+#include "st_tx_deadline.h"
 
 /* call tx_ancillary_session_put always if get successfully */
 static inline struct st_tx_ancillary_session_impl* tx_ancillary_session_get(
@@ -123,6 +124,11 @@ static int tx_ancillary_session_free_frames(struct st_tx_ancillary_session_impl*
 
     for (int i = 0; i < s->st40_frames_cnt; i++) {
       frame = &s->st40_frames[i];
+      struct st40_frame* anc = frame->addr;
+      if (anc && anc->meta_array) {
+        mt_rte_free(anc->meta_array);
+        anc->meta_array = NULL;
+      }
       st_frame_trans_uinit(frame, NULL);
     }
 
@@ -169,6 +175,20 @@ static int tx_ancillary_session_alloc_frames(struct st_tx_ancillary_session_impl
     frame_info->iova = rte_mem_virt2iova(frame);
     frame_info->addr = frame;
     frame_info->flags = ST_FT_FLAG_RTE_MALLOC;
+
+    /* the meta beyond the fixed array of st40_frame */
+    uint16_t max_meta = s->ops.max_meta;
+    if (max_meta > ST40_MAX_META) {
+      struct st40_frame* anc = frame;
+      anc->meta_array =
+          mt_rte_zmalloc_socket(sizeof(*anc->meta_array) * max_meta, soc_id);
+      if (!anc->meta_array) {
+        err("%s(%d), meta_array malloc fail at %d\n", __func__, idx, i);
+        tx_ancillary_session_free_frames(s);
+        return -ENOMEM;
+      }
+      anc->meta_cap = max_meta;
+    }
   }
 
   dbg("%s(%d), succ with %u frames\n", __func__, idx, s->st40_frames_cnt);
@@ -483,6 +503,7 @@ static int tx_ancillary_sessions_tasklet_start(void* priv) {
     tx_ancillary_session_init_pacing_epoch(impl, s);
     tx_ancillary_session_put(mgr, sidx);
   }
+  st_tx_deadline_kick(&mgr->deadline);
 
   return 0;
 }
@@ -542,11 +563,12 @@ static int tx_ancillary_session_build_packet(struct st_tx_ancillary_session_impl
   struct st_frame_trans* frame_info = &s->st40_frames[s->st40_frame_idx];
   struct st40_frame* src = frame_info->addr;
   int anc_idx = s->st40_anc_idx;
+  struct st40_meta* src_meta = st40_frame_meta(src);
   int anc_count = src->meta_num;
   TX_ANC_TEST_CLAMP_ANC_IDX(s, anc_idx, anc_count);
   int idx = 0;
   for (idx = anc_idx; idx < anc_count; idx++) {
-    uint16_t udw_size = src->meta[idx].udw_size;
+    uint16_t udw_size = src_meta[idx].udw_size;
     uint32_t used = (uint32_t)(payload - (uint8_t*)&rtp[1]);
     if (!s->split_payload &&
         (used + st40_rfc8331_payload_bytes(udw_size)) > s->max_pkt_len)
@@ -560,8 +582,8 @@ static int tx_ancillary_session_build_packet(struct st_tx_ancillary_session_impl
     }
     uint32_t room = s->max_pkt_len - used;
     uint32_t written = 0;
-    int ret = st40_rfc8331_encode_packet(payload, room, &src->meta[idx],
-                                         &src->data[src->meta[idx].udw_offset], &written);
+    int ret = st40_rfc8331_encode_packet(payload, room, &src_meta[idx],
+                                         &src->data[src_meta[idx].udw_offset], &written);
     if (ret == -ENOSPC) {
       err("%s(%d), ANC packet too large for MTU (size=%u max=%u)\n", __func__, s->idx,
           st40_rfc8331_payload_bytes(udw_size), s->max_pkt_len);
@@ -628,11 +650,12 @@ static int tx_ancillary_session_build_rtp_packet(struct st_tx_ancillary_session_
   uint8_t* payload = (uint8_t*)&rtp[1];
   struct st_frame_trans* frame_info = &s->st40_frames[s->st40_frame_idx];
   struct st40_frame* src = frame_info->addr;
+  struct st40_meta* src_meta = st40_frame_meta(src);
   int anc_count = src->meta_num;
   TX_ANC_TEST_CLAMP_ANC_IDX(s, anc_idx, anc_count);
   int idx = 0;
   for (idx = anc_idx; idx < anc_count; idx++) {
-    uint16_t udw_size = src->meta[idx].udw_size;
+    uint16_t udw_size = src_meta[idx].udw_size;
     uint32_t used = (uint32_t)(payload - (uint8_t*)&rtp[1]);
     if (!s->split_payload &&
         (used + st40_rfc8331_payload_bytes(udw_size)) > s->max_pkt_len)
@@ -646,8 +669,8 @@ static int tx_ancillary_session_build_rtp_packet(struct st_tx_ancillary_session_
     }
     uint32_t room = s->max_pkt_len - used;
     uint32_t written = 0;
-    int ret = st40_rfc8331_encode_packet(payload, room, &src->meta[idx],
-                                         &src->data[src->meta[idx].udw_offset], &written);
+    int ret = st40_rfc8331_encode_packet(payload, room, &src_meta[idx],
+                                         &src->data[src_meta[idx].udw_offset], &written);
     if (ret == -ENOSPC) {
       err("%s(%d), ANC packet too large for MTU (size=%u max=%u)\n", __func__, s->idx,
           st40_rfc8331_payload_bytes(udw_size), s->max_pkt_len);
@@ -847,6 +870,42 @@ static inline int tx_ancillary_session_send_pkt(struct st_tx_ancillary_sessions_
   return ret;
 }
 
+/*
+ * The count of packets for a frame, the same greedy fill as the build of the packet:
+ * the anc packets go in order and a new rtp packet starts when the next one does not
+ * fit in max_pkt_len, the marker is on the last of them.
+ */
+static int tx_ancillary_session_frame_pkts(struct st_tx_ancillary_session_impl* s,
+                                           struct st40_frame* src) {
+  struct st40_meta* src_meta = st40_frame_meta(src);
+  uint32_t meta_num = src->meta_num;
+
+  if (meta_num > st40_frame_meta_cap(src)) {
+    err("%s(%d), meta_num %u over the cap %u\n", __func__, s->idx, meta_num,
+        st40_frame_meta_cap(src));
+    return -STI_FRAME_APP_ERR_TX_FRAME;
+  }
+  if (!meta_num) return 1;
+  if (s->split_payload) return meta_num;
+
+  int pkts = 1;
+  uint32_t used = 0;
+  for (uint32_t i = 0; i < meta_num; i++) {
+    uint32_t bytes = st40_rfc8331_payload_bytes(src_meta[i].udw_size);
+    if (bytes > s->max_pkt_len) {
+      err("%s(%d), ANC packet %u too large for MTU (size=%u max=%u)\n", __func__,
+          s->idx, i, bytes, s->max_pkt_len);
+      return -STI_FRAME_ANC_TOO_LARGE;
+    }
+    if (used + bytes > s->max_pkt_len) {
+      pkts++;
+      used = 0;
+    }
+    used += bytes;
+  }
+  return pkts;
+}
+
 static int tx_ancillary_session_tasklet_frame(struct mtl_main_impl* impl,
                                               struct st_tx_ancillary_sessions_mgr* mgr,
                                               struct st_tx_ancillary_session_impl* s) {
@@ -939,25 +998,21 @@ static int tx_ancillary_session_tasklet_frame(struct mtl_main_impl* impl,
     dbg("%s(%d), next_frame_idx %d start\n", __func__, idx, next_frame_idx);
     s->st40_frame_stat = ST40_TX_STAT_SENDING_PKTS;
     struct st40_frame* src = (struct st40_frame*)frame->addr;
-    for (int i = 0; i < src->meta_num; i++) total_udw += src->meta[i].udw_size;
-    int total_size = total_udw * 10 / 8;
+    struct st40_meta* src_meta = st40_frame_meta(src);
+    for (int i = 0; i < src->meta_num; i++) total_udw += src_meta[i].udw_size;
     s->st40_pkt_idx = 0;
     s->st40_anc_idx = 0;
-    if (s->split_payload) {
-      s->st40_total_pkts = src->meta_num ? src->meta_num : 1;
-    } else {
-      s->st40_total_pkts = total_size / s->max_pkt_len;
-      if (total_size % s->max_pkt_len) s->st40_total_pkts++;
-      if (!s->st40_total_pkts) s->st40_total_pkts = 1;
-      dbg("%s(%d), st40_total_pkts %d total_udw %d meta_num %u src %p\n", __func__, idx,
-          s->st40_total_pkts, total_udw, src->meta_num, src);
-      if (s->st40_total_pkts > 1) {
-        err("%s(%d), frame %u invalid st40_total_pkts %d\n", __func__, idx,
-            next_frame_idx, s->st40_total_pkts);
-        s->stat_build_ret_code = -STI_FRAME_APP_ERR_TX_FRAME;
-        return MTL_TASKLET_ALL_DONE;
-      }
+    ret = tx_ancillary_session_frame_pkts(s, src);
+    dbg("%s(%d), st40_total_pkts %d total_udw %d meta_num %u src %p\n", __func__, idx,
+        ret, total_udw, src->meta_num, src);
+    if (ret < 0) {
+      err("%s(%d), frame %u invalid, meta_num %u ret %d\n", __func__, idx,
+          next_frame_idx, src->meta_num, ret);
+      s->stat_build_ret_code = ret;
+      tx_ancillary_session_abort_frame(impl, s);
+      return MTL_TASKLET_ALL_DONE;
     }
+    s->st40_total_pkts = ret;
 
     TX_ANC_TEST_ACTIVATE_FRAME(s);
     TX_ANC_TEST_SEQ_GAP_PLAN(s);
@@ -1290,14 +1345,24 @@ static int tx_ancillary_session_tasklet_rtp(struct mtl_main_impl* impl,
 static int tx_ancillary_sessions_tasklet_handler(void* priv) {
   struct st_tx_ancillary_sessions_mgr* mgr = priv;
   struct mtl_main_impl* impl = mgr->parent;
+  struct st_tx_deadline* dl = &mgr->deadline;
   struct st_tx_ancillary_session_impl* s;
   int pending = MTL_TASKLET_ALL_DONE;
   uint64_t tsc_s = 0;
   bool time_measure = mt_sessions_time_measure(impl);
+  uint64_t cur_tsc = mt_get_tsc(impl);
 
-  for (int sidx = 0; sidx < mgr->max_idx; sidx++) {
+  /* only the sessions not parked or due now */
+  st_tx_deadline_expire(dl, mgr->max_idx, cur_tsc);
+  for (int sidx = st_tx_deadline_next_ready(dl, 0); sidx >= 0;
+       sidx = st_tx_deadline_next_ready(dl, sidx + 1)) {
     s = tx_ancillary_session_try_get(mgr, sidx);
-    if (!s) continue;
+    if (!s) {
+      /* busy with the control path, or no session till the next kick */
+      if (!mgr->sessions[sidx]) st_tx_deadline_drop(dl, sidx);
+      continue;
+    }
+    dl->stat_visited++;
     if (time_measure) tsc_s = mt_get_tsc(impl);
 
     s->stat_build_ret_code = 0;
@@ -1306,6 +1371,11 @@ static int tx_ancillary_sessions_tasklet_handler(void* priv) {
     else
       pending += tx_ancillary_session_tasklet_rtp(impl, mgr, s);
 
+    /* the pkts go to the transmitter at once, the build waits the pacing or the app */
+    if (s->stat_build_ret_code == -STI_TSCTRS_TARGET_TSC_NOT_REACH &&
+        s->pacing.tsc_time_cursor > cur_tsc)
+      st_tx_deadline_park(dl, sidx, s->pacing.tsc_time_cursor);
+
     if (time_measure) {
       uint64_t delta_ns = mt_get_tsc(impl) - tsc_s;
       mt_stat_u64_update(&s->stat_time, delta_ns);
@@ -1313,6 +1383,10 @@ static int tx_ancillary_sessions_tasklet_handler(void* priv) {
     tx_ancillary_session_put(mgr, sidx);
   }
 
+  /* the parked sessions are not in the pending of the loop */
+  if (st_tx_deadline_first(dl) < cur_tsc + mt_sch_schedule_ns(impl))
+    pending += MTL_TASKLET_HAS_PENDING;
+
   return pending;
 }
 
@@ -1894,6 +1968,7 @@ static int st_tx_ancillary_sessions_stat(void* priv) {
     tx_ancillary_session_stat(s);
     tx_ancillary_session_put(mgr, j);
   }
+  st_tx_deadline_stat(&mgr->deadline, "TX_ANC_MGR", mgr->idx);
   if (mgr->stat_pkts_burst > 0) {
     notice("TX_ANC_MGR, pkts burst %d\n", mgr->stat_pkts_burst);
     mgr->stat_pkts_burst = 0;
@@ -1914,7 +1989,7 @@ static int tx_ancillary_sessions_mgr_init(struct mtl_main_impl* impl,
                                           struct st_tx_ancillary_sessions_mgr* mgr) {
   int idx = sch->idx;
   struct mtl_tasklet_ops ops;
-  int i;
+  int i, ret;
 
   RTE_BUILD_BUG_ON(sizeof(struct st_rfc8331_anc_hdr) != 62);
 
@@ -1926,6 +2001,12 @@ static int tx_ancillary_sessions_mgr_init(struct mtl_main_impl* impl,
     rte_spinlock_init(&mgr->mutex[i]);
   }
 
+  ret = st_tx_deadline_init(&mgr->deadline, ST_MAX_TX_ANC_SESSIONS, mgr->socket_id);
+  if (ret < 0) {
+    err("%s(%d), deadline init fail %d\n", __func__, idx, ret);
+    return ret;
+  }
+
   memset(&ops, 0x0, sizeof(ops));
   ops.priv = mgr;
   ops.name = "tx_ancillary_sessions_mgr";
@@ -1935,6 +2016,7 @@ static int tx_ancillary_sessions_mgr_init(struct mtl_main_impl* impl,
   mgr->tasklet = mtl_sch_register_tasklet(sch, &ops);
   if (!mgr->tasklet) {
     err("%s(%d), mtl_sch_register_tasklet fail\n", __func__, idx);
+    st_tx_deadline_uinit(&mgr->deadline);
     return -EIO;
   }
 
@@ -1980,6 +2062,7 @@ static struct st_tx_ancillary_session_impl* tx_ancillary_sessions_mgr_attach(
     mgr->sessions[i] = s;
     mgr->max_idx = RTE_MAX(mgr->max_idx, i + 1);
     tx_ancillary_session_put(mgr, i);
+    st_tx_deadline_kick(&mgr->deadline);
     return s;
   }
 
@@ -2003,6 +2086,7 @@ static int tx_ancillary_sessions_mgr_detach(struct st_tx_ancillary_sessions_mgr*
   mt_rte_free(s);
 
   tx_ancillary_session_put(mgr, idx);
+  st_tx_deadline_kick(&mgr->deadline);
 
   return 0;
 }
@@ -2042,6 +2126,7 @@ static int tx_ancillary_sessions_mgr_uinit(struct st_tx_ancillary_sessions_mgr*
   for (int i = 0; i < mt_num_ports(impl); i++) {
     tx_ancillary_sessions_mgr_uinit_hw(mgr, i);
   }
+  st_tx_deadline_uinit(&mgr->deadline);
 
   info("%s(%d), succ\n", __func__, m_idx);
   return 0;
@@ -2131,6 +2216,11 @@ static int tx_ancillary_ops_check(struct st40_tx_ops* ops) {
       err("%s, pls set get_next_frame\n", __func__);
       return -EINVAL;
     }
+    if (ops->max_meta > ST40_MAX_META_DYNAMIC) {
+      err("%s, invalid max_meta %u, max %d\n", __func__, ops->max_meta,
+          ST40_MAX_META_DYNAMIC);
+      return -EINVAL;
+    }
   } else if (ops->type == ST40_TYPE_RTP_LEVEL) {
     if (ops->rtp_ring_size <= 0) {
       err("%s, invalid rtp_ring_size %d\n", __func__, ops->rtp_ring_size);
@@ -10,6 +10,8 @@
 #include "../mt_stat.h"
 #include "st_audio_transmitter.h"
 #include "st_err.h"
+#include "st_tx_audio_stream.h"
+#include "st_tx_deadline.h"
 
 /* call tx_audio_session_put always if get successfully */
 static inline struct st_tx_audio_session_impl* tx_audio_session_get(
@@ -55,6 +57,29 @@ static inline void tx_audio_session_put(struct st_tx_audio_sessions_mgr* mgr, in
   rte_spinlock_unlock(&mgr->mutex[idx]);
 }
 
+/* call tx_audio_group_put always if get successfully */
+static inline struct st_tx_audio_group* tx_audio_group_try_get(
+    struct st_tx_audio_sessions_mgr* mgr, int gidx) {
+  if (!rte_spinlock_trylock(&mgr->group_mutex[gidx])) return NULL;
+  struct st_tx_audio_group* g = mgr->groups[gidx];
+  if (!g) rte_spinlock_unlock(&mgr->group_mutex[gidx]);
+  return g;
+}
+
+/* call tx_audio_group_put always if get successfully */
+static inline struct st_tx_audio_group* tx_audio_group_get_timeout(
+    struct st_tx_audio_sessions_mgr* mgr, int gidx, int timeout_us) {
+  if (!mt_spinlock_lock_timeout(mgr->parent, &mgr->group_mutex[gidx], timeout_us))
+    return NULL;
+  struct st_tx_audio_group* g = mgr->groups[gidx];
+  if (!g) rte_spinlock_unlock(&mgr->group_mutex[gidx]);
+  return g;
+}
+
+static inline void tx_audio_group_put(struct st_tx_audio_sessions_mgr* mgr, int gidx) {
+  rte_spinlock_unlock(&mgr->group_mutex[gidx]);
+}
+
 static int tx_audio_session_free_frames(struct st_tx_audio_session_impl* s) {
   if (s->st30_frames) {
     struct st_frame_trans* frame;
@@ -99,6 +124,9 @@ static int tx_audio_session_alloc_frames(struct st_tx_audio_session_impl* s) {
     frame_info->idx = i;
   }
 
+  /* the frame of the stream is the pacing unit only, the payload is in the ring */
+  if (s->stream) return 0;
+
   for (int i = 0; i < s->st30_frames_cnt; i++) {
     frame_info = &s->st30_frames[i];
 
@@ -402,6 +430,14 @@ static int tx_audio_sessions_tasklet_start(void* priv) {
     tx_audio_session_put(mgr, sidx);
   }
 
+  for (int gidx = 0; gidx < ST_TX_AUDIO_GROUPS_MAX; gidx++) {
+    struct st_tx_audio_group* g = tx_audio_group_try_get(mgr, gidx);
+    if (!g) continue;
+    g->pacing.cur_epochs = mt_get_ptp_time(impl, MTL_PORT_P) / g->pacing.trs;
+    tx_audio_group_put(mgr, gidx);
+  }
+  st_tx_deadline_kick(&mgr->deadline);
+
   return 0;
 }
 
@@ -425,6 +461,20 @@ static int tx_audio_session_update_redundant(struct st_tx_audio_session_impl* s,
   return 0;
 }
 
+/* the payload of the current pkt from the frame, or sliced from the stream ring */
+static inline void tx_audio_session_copy_payload(struct st_tx_audio_session_impl* s,
+                                                 uint8_t* payload) {
+  struct st_frame_trans* frame_info;
+
+  if (s->stream) {
+    st_tx_audio_stream_read_pkt(s->stream, payload);
+    return;
+  }
+  frame_info = &s->st30_frames[s->st30_frame_idx];
+  rte_memcpy(payload, (uint8_t*)frame_info->addr + s->st30_pkt_idx * s->pkt_len,
+             s->pkt_len);
+}
+
 static int tx_audio_session_build_packet(struct st_tx_audio_session_impl* s,
                                          struct rte_mbuf* pkt) {
   struct mt_udp_hdr* hdr;
@@ -459,10 +509,7 @@ static int tx_audio_session_build_packet(struct st_tx_audio_session_impl* s,
 
   /* copy payload now */
   uint8_t* payload = (uint8_t*)&rtp[1];
-  uint32_t offset = s->st30_pkt_idx * s->pkt_len;
-  struct st_frame_trans* frame_info = &s->st30_frames[s->st30_frame_idx];
-  uint8_t* src = frame_info->addr;
-  rte_memcpy(payload, src + offset, s->pkt_len);
+  tx_audio_session_copy_payload(s, payload);
 
   pkt->data_len += len;
   pkt->pkt_len = pkt->data_len;
@@ -493,10 +540,7 @@ static int tx_audio_session_build_rtp_packet(struct st_tx_audio_session_impl* s,
 
   /* copy payload now */
   uint8_t* payload = (uint8_t*)&rtp[1];
-  uint32_t offset = s->st30_pkt_idx * s->pkt_len;
-  struct st_frame_trans* frame_info = &s->st30_frames[s->st30_frame_idx];
-  uint8_t* src = frame_info->addr;
-  rte_memcpy(payload, src + offset, s->pkt_len);
+  tx_audio_session_copy_payload(s, payload);
 
   pkt->data_len = len;
   pkt->pkt_len = len;
@@ -661,6 +705,87 @@ static int tx_audio_session_usdt_dump_frame(struct st_tx_audio_session_impl* s,
   return 0;
 }
 
+/* get the next frame from app, the meta is the epoch the frame start */
+static int tx_audio_session_next_frame(struct mtl_main_impl* impl,
+                                       struct st_tx_audio_session_impl* s,
+                                       struct st30_tx_frame_meta* meta) {
+  int idx = s->idx;
+  struct st30_tx_ops* ops = &s->ops;
+  uint16_t next_frame_idx;
+  uint64_t tsc_start = 0;
+  int ret;
+
+  if (s->stream) {
+    /* the one frame, the pkts are sliced from the ring once the app filled it */
+    next_frame_idx = 0;
+    ret = st_tx_audio_stream_ready(s->stream) ? 0 : -EBUSY;
+  } else {
+    /* Query next frame buffer idx */
+    bool time_measure = mt_sessions_time_measure(impl);
+    if (time_measure) tsc_start = mt_get_tsc(impl);
+    ret = ops->get_next_frame(ops->priv, &next_frame_idx, meta);
+    if (time_measure) {
+      uint32_t delta_us = (mt_get_tsc(impl) - tsc_start) / NS_PER_US;
+      s->stat_max_next_frame_us = RTE_MAX(s->stat_max_next_frame_us, delta_us);
+    }
+  }
+  if (ret < 0) { /* no frame ready from app */
+    dbg("%s(%d), get_next_frame fail %d\n", __func__, idx, ret);
+    s->stat_build_ret_code = -STI_FRAME_APP_GET_FRAME_BUSY;
+    return ret;
+  }
+  /* check frame refcnt */
+  struct st_frame_trans* frame = &s->st30_frames[next_frame_idx];
+  int refcnt = rte_atomic32_read(&frame->refcnt);
+  if (refcnt) {
+    err("%s(%d), frame %u refcnt not zero %d\n", __func__, idx, next_frame_idx, refcnt);
+    s->stat_build_ret_code = -STI_FRAME_APP_ERR_TX_FRAME;
+    return -EIO;
+  }
+  rte_atomic32_inc(&frame->refcnt);
+  frame->ta_meta = *meta;
+  s->st30_frame_idx = next_frame_idx;
+  dbg("%s(%d), next_frame_idx %d start\n", __func__, idx, next_frame_idx);
+  s->st30_frame_stat = ST30_TX_STAT_SENDING_PKTS;
+  MT_USDT_ST30_TX_FRAME_NEXT(s->mgr->idx, s->idx, next_frame_idx, frame->addr);
+  /* check if dump USDT enabled */
+  if (MT_USDT_ST30_TX_FRAME_DUMP_ENABLED() && frame->addr) {
+    tx_audio_session_usdt_dump_frame(s, frame);
+  } else {
+    tx_audio_session_usdt_dump_close(s);
+  }
+  return 0;
+}
+
+/* all pkts of current frame built, return the frame to app */
+static void tx_audio_session_frame_done(struct mtl_main_impl* impl,
+                                        struct st_tx_audio_session_impl* s) {
+  struct st30_tx_ops* ops = &s->ops;
+  struct st_frame_trans* frame = &s->st30_frames[s->st30_frame_idx];
+  struct st30_tx_frame_meta* ta_meta = &frame->ta_meta;
+  uint64_t tsc_start = 0;
+
+  dbg("%s(%d), frame %d done\n", __func__, s->idx, s->st30_frame_idx);
+  bool time_measure = mt_sessions_time_measure(impl);
+  if (time_measure) tsc_start = mt_get_tsc(impl);
+  /* end of current frame */
+  if (ops->notify_frame_done)
+    ops->notify_frame_done(ops->priv, s->st30_frame_idx, ta_meta);
+  if (time_measure) {
+    uint32_t delta_us = (mt_get_tsc(impl) - tsc_start) / NS_PER_US;
+    s->stat_max_notify_frame_us = RTE_MAX(s->stat_max_notify_frame_us, delta_us);
+  }
+
+  rte_atomic32_dec(&frame->refcnt);
+  s->st30_frame_stat = ST30_TX_STAT_WAIT_FRAME;
+  s->check_frame_done_time = true;
+  s->st30_pkt_idx = 0;
+  s->port_user_stats.common.port[MTL_SESSION_PORT_P].frames++;
+  if (ops->num_port > 1) s->port_user_stats.common.port[MTL_SESSION_PORT_R].frames++;
+  MT_USDT_ST30_TX_FRAME_DONE(s->mgr->idx, s->idx, s->st30_frame_idx,
+                             ta_meta->rtp_timestamp);
+}
+
 static int tx_audio_session_tasklet_frame(struct mtl_main_impl* impl,
                                           struct st_tx_audio_session_impl* s) {
   int idx = s->idx;
@@ -712,9 +837,7 @@ static int tx_audio_session_tasklet_frame(struct mtl_main_impl* impl,
 
   if (0 == s->st30_pkt_idx) {
     if (ST30_TX_STAT_WAIT_FRAME == s->st30_frame_stat) {
-      uint16_t next_frame_idx;
       struct st30_tx_frame_meta meta;
-      uint64_t tsc_start = 0;
 
       if (s->check_frame_done_time) {
         uint64_t frame_end_time = mt_get_tsc(impl);
@@ -728,40 +851,8 @@ static int tx_audio_session_tasklet_frame(struct mtl_main_impl* impl,
       }
 
       tx_audio_session_init_next_meta(s, &meta);
-      /* Query next frame buffer idx */
-      bool time_measure = mt_sessions_time_measure(impl);
-      if (time_measure) tsc_start = mt_get_tsc(impl);
-      ret = ops->get_next_frame(ops->priv, &next_frame_idx, &meta);
-      if (time_measure) {
-        uint32_t delta_us = (mt_get_tsc(impl) - tsc_start) / NS_PER_US;
-        s->stat_max_next_frame_us = RTE_MAX(s->stat_max_next_frame_us, delta_us);
-      }
-      if (ret < 0) { /* no frame ready from app */
-        dbg("%s(%d), get_next_frame fail %d\n", __func__, idx, ret);
-        s->stat_build_ret_code = -STI_FRAME_APP_GET_FRAME_BUSY;
-        return MTL_TASKLET_ALL_DONE;
-      }
-      /* check frame refcnt */
-      struct st_frame_trans* frame = &s->st30_frames[next_frame_idx];
-      int refcnt = rte_atomic32_read(&frame->refcnt);
-      if (refcnt) {
-        err("%s(%d), frame %u refcnt not zero %d\n", __func__, idx, next_frame_idx,
-            refcnt);
-        s->stat_build_ret_code = -STI_FRAME_APP_ERR_TX_FRAME;
-        return MTL_TASKLET_ALL_DONE;
-      }
-      rte_atomic32_inc(&frame->refcnt);
-      frame->ta_meta = meta;
-      s->st30_frame_idx = next_frame_idx;
-      dbg("%s(%d), next_frame_idx %d start\n", __func__, idx, next_frame_idx);
-      s->st30_frame_stat = ST30_TX_STAT_SENDING_PKTS;
-      MT_USDT_ST30_TX_FRAME_NEXT(s->mgr->idx, s->idx, next_frame_idx, frame->addr);
-      /* check if dump USDT enabled */
-      if (MT_USDT_ST30_TX_FRAME_DUMP_ENABLED()) {
-        tx_audio_session_usdt_dump_frame(s, frame);
-      } else {
-        tx_audio_session_usdt_dump_close(s);
-      }
+      ret = tx_audio_session_next_frame(impl, s, &meta);
+      if (ret < 0) return MTL_TASKLET_ALL_DONE;
     }
   }
 
@@ -874,30 +965,7 @@ static int tx_audio_session_tasklet_frame(struct mtl_main_impl* impl,
     s->stat_build_ret_code = -STI_FRAME_PKT_R_ENQUEUE_FAIL;
   }
 
-  if (s->st30_pkt_idx >= s->st30_total_pkts) {
-    dbg("%s(%d), frame %d done\n", __func__, idx, s->st30_frame_idx);
-    struct st_frame_trans* frame = &s->st30_frames[s->st30_frame_idx];
-    struct st30_tx_frame_meta* ta_meta = &frame->ta_meta;
-    uint64_t tsc_start = 0;
-    bool time_measure = mt_sessions_time_measure(impl);
-    if (time_measure) tsc_start = mt_get_tsc(impl);
-    /* end of current frame */
-    if (ops->notify_frame_done)
-      ops->notify_frame_done(ops->priv, s->st30_frame_idx, ta_meta);
-    if (time_measure) {
-      uint32_t delta_us = (mt_get_tsc(impl) - tsc_start) / NS_PER_US;
-      s->stat_max_notify_frame_us = RTE_MAX(s->stat_max_notify_frame_us, delta_us);
-    }
-
-    rte_atomic32_dec(&frame->refcnt);
-    s->st30_frame_stat = ST30_TX_STAT_WAIT_FRAME;
-    s->check_frame_done_time = true;
-    s->st30_pkt_idx = 0;
-    s->port_user_stats.common.port[MTL_SESSION_PORT_P].frames++;
-    if (send_r) s->port_user_stats.common.port[MTL_SESSION_PORT_R].frames++;
-    MT_USDT_ST30_TX_FRAME_DONE(s->mgr->idx, s->idx, s->st30_frame_idx,
-                               ta_meta->rtp_timestamp);
-  }
+  if (s->st30_pkt_idx >= s->st30_total_pkts) tx_audio_session_frame_done(impl, s);
 
   return done ? MTL_TASKLET_ALL_DONE : MTL_TASKLET_HAS_PENDING;
 }
@@ -1588,18 +1656,265 @@ static int tx_audio_session_tasklet_rl_transmit(struct mtl_main_impl* impl,
   return 0;
 }
 
+/* same as tx_audio_session_sync_pacing without the user pacing, for all the members */
+static void tx_audio_group_sync_pacing(struct mtl_main_impl* impl,
+                                       struct st_tx_audio_group* g, bool* late,
+                                       bool* mismatch) {
+  struct st_tx_audio_session_pacing* pacing = &g->pacing;
+  /* always use MTL_PORT_P for ptp now */
+  uint64_t ptp_time = mt_get_ptp_time(impl, MTL_PORT_P);
+  uint64_t next_epochs = pacing->cur_epochs + 1;
+  uint64_t epochs = ptp_time / pacing->trs;
+  int64_t to_epoch;
+
+  *late = false;
+  *mismatch = false;
+  if (epochs <= pacing->cur_epochs) {
+    /* point to next epoch since if it in the range of onward */
+    if (pacing->cur_epochs - epochs < pacing->max_onward_epochs) epochs = next_epochs;
+  } else if (epochs > next_epochs) {
+    if (epochs - next_epochs < pacing->max_late_epochs) {
+      /* point to next epoch since if it in the range of late */
+      epochs = next_epochs;
+      *late = true;
+    }
+  }
+
+  to_epoch = (int64_t)tx_audio_pacing_time(pacing, epochs) - (int64_t)ptp_time;
+  if (to_epoch < 0) {
+    /* time bigger than the assigned epoch time */
+    *mismatch = true;
+    to_epoch = 0; /* send asap */
+  }
+
+  pacing->cur_epochs = epochs;
+  pacing->ptp_time_cursor = tx_audio_pacing_time(pacing, epochs);
+  pacing->rtp_time_stamp = tx_audio_pacing_time_stamp(pacing, epochs);
+  pacing->tsc_time_cursor = (long double)mt_get_tsc(impl) + to_epoch;
+}
+
+/* build the pkt of current epoch for one member, the mbufs are from the bulk alloc */
+static void tx_audio_group_build_member(struct mtl_main_impl* impl,
+                                        struct st_tx_audio_group* g,
+                                        struct st_tx_audio_session_impl* s, uint16_t i) {
+  struct st_tx_audio_session_pacing* pacing = &s->pacing;
+  struct st_frame_trans* frame = &s->st30_frames[s->st30_frame_idx];
+  struct rte_mbuf* pkt = g->pkts[MTL_SESSION_PORT_P][i];
+
+  /* the member follow the epoch of the group */
+  pacing->cur_epochs = g->pacing.cur_epochs;
+  pacing->ptp_time_cursor = g->pacing.ptp_time_cursor;
+  pacing->tsc_time_cursor = g->pacing.tsc_time_cursor;
+  pacing->rtp_time_stamp = g->pacing.rtp_time_stamp + s->group_rtp_delta;
+  frame->ta_meta.tfmt = ST10_TIMESTAMP_FMT_TAI;
+  frame->ta_meta.timestamp = pacing->ptp_time_cursor;
+  frame->ta_meta.rtp_timestamp = pacing->rtp_time_stamp;
+
+  tx_audio_session_build_packet(s, pkt);
+  st_tx_mbuf_set_idx(pkt, s->st30_pkt_idx);
+  st_tx_mbuf_set_tsc(pkt, pacing->tsc_time_cursor);
+  s->port_user_stats.common.port[MTL_SESSION_PORT_P].packets++;
+  s->port_user_stats.common.port[MTL_SESSION_PORT_P].bytes += pkt->pkt_len;
+
+  if (g->num_port > 1) {
+    struct rte_mbuf* pkt_r = g->pkts[MTL_SESSION_PORT_R][i];
+
+    /* copy of the primary pkt, then update the hdr */
+    mt_mbuf_init_ipv4(pkt_r);
+    rte_memcpy(rte_pktmbuf_mtod(pkt_r, void*), rte_pktmbuf_mtod(pkt, void*),
+               pkt->data_len);
+    pkt_r->data_len = pkt->data_len;
+    pkt_r->pkt_len = pkt->pkt_len;
+    tx_audio_session_update_redundant(s, pkt_r);
+    st_tx_mbuf_set_idx(pkt_r, s->st30_pkt_idx);
+    st_tx_mbuf_set_tsc(pkt_r, pacing->tsc_time_cursor);
+    s->port_user_stats.common.port[MTL_SESSION_PORT_R].packets++;
+    s->port_user_stats.common.port[MTL_SESSION_PORT_R].bytes += pkt_r->pkt_len;
+  }
+
+  s->st30_pkt_idx++;
+  if (s->st30_pkt_idx >= s->st30_total_pkts) tx_audio_session_frame_done(impl, s);
+}
+
+/* build one pkt per port for all ready members at the next epoch */
+static int tx_audio_group_build(struct mtl_main_impl* impl,
+                                struct st_tx_audio_sessions_mgr* mgr,
+                                struct st_tx_audio_group* g) {
+  struct st_tx_audio_session_pacing* pacing = &g->pacing;
+  uint64_t prev_epochs = pacing->cur_epochs;
+  struct st_tx_audio_session_impl* s;
+  bool late, mismatch;
+  uint16_t n = 0;
+  int ret;
+
+  tx_audio_group_sync_pacing(impl, g, &late, &mismatch);
+
+  /* collect the members with a frame to send, hold the session lock until built */
+  for (int sidx = 0; sidx < mgr->max_idx; sidx++) {
+    s = tx_audio_session_try_get(mgr, sidx);
+    if (!s) continue;
+    if (s->group != g || !s->active) {
+      tx_audio_session_put(mgr, sidx);
+      continue;
+    }
+
+    s->stat_build_ret_code = 0;
+    if (ST30_TX_STAT_WAIT_FRAME == s->st30_frame_stat) {
+      struct st30_tx_frame_meta meta;
+
+      tx_audio_session_init_next_meta(s, &meta);
+      meta.epoch = pacing->cur_epochs;
+      meta.timestamp = pacing->ptp_time_cursor;
+      if (tx_audio_session_next_frame(impl, s, &meta) < 0) {
+        tx_audio_session_put(mgr, sidx);
+        continue;
+      }
+    }
+    g->batch[n++] = s;
+  }
+  if (!n) {
+    /* no frame from any member, not consume the epoch */
+    pacing->cur_epochs = prev_epochs;
+    return MTL_TASKLET_ALL_DONE;
+  }
+
+  for (int port = 0; port < g->num_port; port++) {
+    ret = rte_pktmbuf_alloc_bulk(g->mbuf_pool[port], g->pkts[port], n);
+    if (ret < 0) {
+      dbg("%s(%d), pkts alloc fail for %u members\n", __func__, g->idx, n);
+      for (int i = 0; i < port; i++) rte_pktmbuf_free_bulk(g->pkts[i], n);
+      g->stat_alloc_fail++;
+      pacing->cur_epochs = prev_epochs;
+      for (uint16_t i = 0; i < n; i++) {
+        g->batch[i]->stat_build_ret_code = -STI_FRAME_PKT_ALLOC_FAIL;
+        tx_audio_session_put(mgr, g->batch[i]->idx);
+      }
+      return MTL_TASKLET_ALL_DONE;
+    }
+  }
+
+  if (pacing->cur_epochs > prev_epochs + 1)
+    g->stat_epoch_drop += pacing->cur_epochs - prev_epochs - 1;
+  if (late) g->stat_epoch_late++;
+  if (mismatch) g->stat_epoch_mismatch++;
+  g->stat_epochs++;
+  g->stat_pkts += n;
+  g->stat_batch_max = RTE_MAX(g->stat_batch_max, n);
+
+  for (uint16_t i = 0; i < n; i++) {
+    s = g->batch[i];
+    tx_audio_group_build_member(impl, g, s, i);
+    tx_audio_session_put(mgr, s->idx);
+  }
+
+  g->pkts_cnt = n;
+  for (int port = 0; port < g->num_port; port++) g->pkts_sent[port] = 0;
+  return MTL_TASKLET_HAS_PENDING;
+}
+
+static int tx_audio_group_tasklet(struct mtl_main_impl* impl,
+                                  struct st_tx_audio_sessions_mgr* mgr,
+                                  struct st_tx_audio_group* g) {
+  uint64_t cur_tsc, target_tsc;
+  bool done = true;
+
+  if (!g->pkts_cnt) return tx_audio_group_build(impl, mgr, g);
+
+  cur_tsc = mt_get_tsc(impl);
+  target_tsc = g->pacing.tsc_time_cursor;
+  if (cur_tsc < target_tsc) {
+    uint64_t delta = target_tsc - cur_tsc;
+    if (likely(delta < NS_PER_S)) {
+      return delta < mt_sch_schedule_ns(impl) ? MTL_TASKLET_HAS_PENDING
+                                              : MTL_TASKLET_ALL_DONE;
+    } else {
+      err("%s(%d), invalid tsc cur %" PRIu64 " target %" PRIu64 "\n", __func__, g->idx,
+          cur_tsc, target_tsc);
+    }
+  }
+
+  /* one burst per port for the pkts of all members */
+  for (int port = 0; port < g->num_port; port++) {
+    uint16_t sent = g->pkts_sent[port];
+    if (sent >= g->pkts_cnt) continue;
+
+    sent += rte_ring_mp_enqueue_burst(mgr->ring[g->port[port]],
+                                      (void**)&g->pkts[port][sent], g->pkts_cnt - sent,
+                                      NULL);
+    g->pkts_sent[port] = sent;
+    if (sent < g->pkts_cnt) {
+      g->stat_burst_fail++;
+      done = false;
+    }
+  }
+  if (!done) return MTL_TASKLET_ALL_DONE;
+
+  g->pkts_cnt = 0;
+  return MTL_TASKLET_HAS_PENDING;
+}
+
+/*
+ * The tsc the session has work again after the visit, 0 if it may have work now. Only
+ * the waits of the tsc are known, the session waiting the app stays in the loop.
+ */
+static uint64_t tx_audio_session_due_tsc(struct st_tx_audio_session_impl* s) {
+  struct mt_u64_fifo* ring_p = s->trans_ring[MTL_SESSION_PORT_P];
+  uint64_t due = UINT64_MAX;
+
+  if (s->tx_pacing_way == ST30_TX_PACING_WAY_RL) return 0;
+
+  for (int port = 0; port < s->ops.num_port; port++) {
+    struct rte_mbuf* pkt = s->trans_ring_inflight[port];
+
+    if (s->inflight[port]) return 0;
+    if (pkt)
+      due = RTE_MIN(due, st_tx_mbuf_get_tsc(pkt));
+    else if (mt_u64_fifo_count(s->trans_ring[port]))
+      return 0;
+  }
+
+  /* the build runs below the thresh, it waits the pacing or the app */
+  if (mt_u64_fifo_count(ring_p) < s->trans_ring_thresh) {
+    if (s->stat_build_ret_code != -STI_TSCTRS_TARGET_TSC_NOT_REACH) return 0;
+    due = RTE_MIN(due, s->pacing.tsc_time_cursor);
+  }
+
+  return due == UINT64_MAX ? 0 : due;
+}
+
 static int tx_audio_sessions_tasklet(void* priv) {
   struct st_tx_audio_sessions_mgr* mgr = priv;
   struct mtl_main_impl* impl = mgr->parent;
+  struct st_tx_deadline* dl = &mgr->deadline;
   struct st_tx_audio_session_impl* s;
   int pending = MTL_TASKLET_ALL_DONE;
   uint64_t tsc_s = 0;
   bool time_measure = mt_sessions_time_measure(impl);
+  uint64_t cur_tsc = mt_get_tsc(impl), due;
 
-  for (int sidx = 0; sidx < mgr->max_idx; sidx++) {
+  for (int gidx = 0; gidx < ST_TX_AUDIO_GROUPS_MAX; gidx++) {
+    struct st_tx_audio_group* g = tx_audio_group_try_get(mgr, gidx);
+    if (!g) continue;
+    pending += tx_audio_group_tasklet(impl, mgr, g);
+    tx_audio_group_put(mgr, gidx);
+  }
+
+  /* only the sessions not parked or due now */
+  st_tx_deadline_expire(dl, mgr->max_idx, cur_tsc);
+  for (int sidx = st_tx_deadline_next_ready(dl, 0); sidx >= 0;
+       sidx = st_tx_deadline_next_ready(dl, sidx + 1)) {
     s = tx_audio_session_try_get(mgr, sidx);
-    if (!s) continue;
-    if (!s->active) goto exit;
+    if (!s) {
+      /* busy with the control path, or no session till the next kick */
+      if (!mgr->sessions[sidx]) st_tx_deadline_drop(dl, sidx);
+      continue;
+    }
+    /* the group members are built by the group */
+    if (!s->active || s->group) {
+      st_tx_deadline_drop(dl, sidx);
+      goto exit;
+    }
+    dl->stat_visited++;
     if (time_measure) tsc_s = mt_get_tsc(impl);
 
     s->stat_build_ret_code = 0;
@@ -1615,6 +1930,9 @@ static int tx_audio_sessions_tasklet(void* priv) {
         pending += tx_audio_session_tasklet_transmit(impl, mgr, s, port);
     }
 
+    due = tx_audio_session_due_tsc(s);
+    if (due > cur_tsc) st_tx_deadline_park(dl, sidx, due);
+
     if (time_measure) {
       uint64_t delta_ns = mt_get_tsc(impl) - tsc_s;
       mt_stat_u64_update(&s->stat_time, delta_ns);
@@ -1623,6 +1941,10 @@ static int tx_audio_sessions_tasklet(void* priv) {
     tx_audio_session_put(mgr, sidx);
   }
 
+  /* the parked sessions are not in the pending of the loop */
+  if (st_tx_deadline_first(dl) < cur_tsc + mt_sch_schedule_ns(impl))
+    pending += MTL_TASKLET_HAS_PENDING;
+
   return pending;
 }
 
@@ -1705,35 +2027,221 @@ static int tx_audio_session_sq_flush_port(struct st_tx_audio_sessions_mgr* mgr,
   return 0;
 }
 
+/* flush the pkts of the pool out of the audio transmitter tx queue */
+static int tx_audio_sq_flush_pool(struct st_tx_audio_sessions_mgr* mgr,
+                                  struct rte_mempool* pool, enum mtl_port port) {
+  int mgr_idx = mgr->idx;
+
+  if (!pool || !rte_mempool_in_use_count(pool)) return 0;
+  if (!rte_atomic32_read(&mgr->transmitter_started)) return 0;
+
+  info("%s(%d), start to flush port %d\n", __func__, mgr_idx, port);
+  tx_audio_session_sq_flush_port(mgr, port);
+  info("%s(%d), flush port %d end\n", __func__, mgr_idx, port);
+
+  int retry = 100; /* max 1000ms */
+  while (retry > 0) {
+    retry--;
+    if (!rte_mempool_in_use_count(pool)) break;
+    mt_sleep_ms(10);
+  }
+  info("%s(%d), check in_use retry %d\n", __func__, mgr_idx, retry);
+  return 0;
+}
+
 /* wa to flush the audio transmitter tx queue */
 static int tx_audio_session_sq_flush(struct st_tx_audio_sessions_mgr* mgr,
                                      struct st_tx_audio_session_impl* s) {
-  int mgr_idx = mgr->idx, s_idx = s->idx;
-
   if (!s->shared_queue) return 0; /* skip as not shared queue */
 
   for (int i = 0; i < MTL_SESSION_PORT_MAX; i++) {
-    struct rte_mempool* pool = s->mbuf_mempool_hdr[i];
-
-    if (pool && rte_mempool_in_use_count(pool) &&
-        rte_atomic32_read(&mgr->transmitter_started)) {
-      info("%s(%d,%d), start to flush port %d\n", __func__, mgr_idx, s_idx, i);
-      tx_audio_session_sq_flush_port(mgr, mt_port_logic2phy(s->port_maps, i));
-      info("%s(%d,%d), flush port %d end\n", __func__, mgr_idx, s_idx, i);
-
-      int retry = 100; /* max 1000ms */
-      while (retry > 0) {
-        retry--;
-        if (!rte_mempool_in_use_count(pool)) break;
-        mt_sleep_ms(10);
-      }
-      info("%s(%d,%d), check in_use retry %d\n", __func__, mgr_idx, s_idx, retry);
+    tx_audio_sq_flush_pool(mgr, s->mbuf_mempool_hdr[i],
+                           mt_port_logic2phy(s->port_maps, i));
+  }
+
+  return 0;
+}
+
+static void tx_audio_group_free(struct st_tx_audio_sessions_mgr* mgr,
+                                struct st_tx_audio_group* g) {
+  for (int port = 0; port < g->num_port; port++) {
+    uint16_t sent = g->pkts_sent[port];
+    /* the built pkts not burst yet */
+    if (g->pkts_cnt > sent)
+      rte_pktmbuf_free_bulk(&g->pkts[port][sent], g->pkts_cnt - sent);
+  }
+  g->pkts_cnt = 0;
+
+  for (int port = 0; port < g->num_port; port++) {
+    struct rte_mempool* pool = g->mbuf_pool[port];
+    if (!pool || g->mono_pool) continue;
+    tx_audio_sq_flush_pool(mgr, pool, g->port[port]);
+    mt_mempool_free(pool);
+    g->mbuf_pool[port] = NULL;
+  }
+
+  info("%s(%d), group %d freed\n", __func__, mgr->idx, g->idx);
+  mt_rte_free(g);
+}
+
+static struct st_tx_audio_group* tx_audio_group_create(
+    struct mtl_main_impl* impl, struct st_tx_audio_sessions_mgr* mgr,
+    struct st_tx_audio_session_impl* s, int gidx) {
+  struct st30_tx_ops* ops = &s->ops;
+  struct st_tx_audio_group* g;
+  /* no chain, the payload is copied to the hdr mbuf */
+  uint16_t room_size =
+      sizeof(struct mt_udp_hdr) + sizeof(struct st_rfc3550_rtp_hdr) + s->pkt_len;
+  unsigned int n;
+
+  g = mt_rte_zmalloc_socket(sizeof(*g), mgr->socket_id);
+  if (!g) {
+    err("%s(%d), group malloc fail\n", __func__, mgr->idx);
+    return NULL;
+  }
+  g->idx = gidx;
+  g->ptime = ops->ptime;
+  g->sampling = ops->sampling;
+  g->pkt_len = s->pkt_len;
+  g->num_port = ops->num_port;
+  for (int i = 0; i < g->num_port; i++) g->port[i] = mt_port_logic2phy(s->port_maps, i);
+  /* same pkt time for all members */
+  g->pacing = s->pacing;
+  g->pacing.cur_epochs = mt_get_ptp_time(impl, MTL_PORT_P) / g->pacing.trs;
+
+  g->mono_pool = s->tx_mono_pool;
+  for (int i = 0; i < g->num_port; i++) {
+    enum mtl_port port = g->port[i];
+    if (g->mono_pool) {
+      g->mbuf_pool[i] = mt_sys_tx_mempool(impl, port);
+      continue;
+    }
+    /* one epoch of all members on top of the session pool */
+    n = mt_if_nb_tx_desc(impl, port) + ST_TX_AUDIO_SESSIONS_RING_SIZE +
+        ST_SCH_MAX_TX_AUDIO_SESSIONS;
+    char pool_name[32];
+    snprintf(pool_name, 32, "%sM%dG%dP%d_%d", ST_TX_AUDIO_PREFIX, mgr->idx, gidx, i,
+             mgr->group_seq);
+    g->mbuf_pool[i] =
+        mt_mempool_create_by_socket(impl, pool_name, n, MT_MBUF_CACHE_SIZE,
+                                    sizeof(struct mt_muf_priv_data), room_size,
+                                    mgr->socket_id);
+    if (!g->mbuf_pool[i]) {
+      tx_audio_group_free(mgr, g);
+      return NULL;
     }
   }
+  mgr->group_seq++;
 
+  info("%s(%d), group %d, ptime %d sampling %d pkt_len %u num_port %d\n", __func__,
+       mgr->idx, gidx, g->ptime, g->sampling, g->pkt_len, g->num_port);
+  return g;
+}
+
+static bool tx_audio_group_match(struct st_tx_audio_group* g,
+                                 struct st_tx_audio_session_impl* s) {
+  struct st30_tx_ops* ops = &s->ops;
+
+  if (g->ptime != ops->ptime || g->sampling != ops->sampling) return false;
+  if (g->pkt_len != s->pkt_len || g->num_port != ops->num_port) return false;
+  for (int i = 0; i < g->num_port; i++) {
+    if (g->port[i] != mt_port_logic2phy(s->port_maps, i)) return false;
+  }
+  return true;
+}
+
+static bool tx_audio_group_capable(struct st_tx_audio_session_impl* s) {
+  struct st30_tx_ops* ops = &s->ops;
+  int idx = s->idx;
+  uint32_t user_flags =
+      ST30_TX_FLAG_USER_PACING | ST30_TX_FLAG_USER_TIMESTAMP | ST30_TX_FLAG_BUILD_PACING;
+
+  if (ops->type != ST30_TYPE_FRAME_LEVEL) {
+    warn("%s(%d), only frame level type\n", __func__, idx);
+    return false;
+  }
+  if (!s->shared_queue || s->tx_pacing_way != ST30_TX_PACING_WAY_TSC) {
+    warn("%s(%d), only tsc pacing on the shared queue\n", __func__, idx);
+    return false;
+  }
+  if (ops->flags & user_flags) {
+    warn("%s(%d), not support user pacing flags 0x%x\n", __func__, idx,
+         ops->flags & user_flags);
+    return false;
+  }
+  return true;
+}
+
+/* the sessions are attached with the tx_a_mgr_mutex, no race on the group slots */
+static int tx_audio_group_join(struct mtl_main_impl* impl,
+                               struct st_tx_audio_sessions_mgr* mgr,
+                               struct st_tx_audio_session_impl* s) {
+  struct st_tx_audio_group* g;
+  int idx = s->idx;
+  int free_gidx = -1;
+
+  if (!tx_audio_group_capable(s)) return -ENOTSUP;
+
+  if (s->ops.rtp_timestamp_delta_us) {
+    double rtp_timestamp_delta_us = s->ops.rtp_timestamp_delta_us;
+    s->group_rtp_delta = (rtp_timestamp_delta_us * NS_PER_US) *
+                         s->pacing.pkt_time_sampling / s->pacing.trs;
+  }
+
+  for (int gidx = 0; gidx < ST_TX_AUDIO_GROUPS_MAX; gidx++) {
+    g = mgr->groups[gidx];
+    if (!g) {
+      if (free_gidx < 0) free_gidx = gidx;
+      continue;
+    }
+    if (!tx_audio_group_match(g, s)) continue;
+
+    rte_spinlock_lock(&mgr->group_mutex[gidx]);
+    g->members++;
+    rte_spinlock_unlock(&mgr->group_mutex[gidx]);
+    s->group = g;
+    info("%s(%d), join group %d, members %d\n", __func__, idx, gidx, g->members);
+    return 0;
+  }
+
+  if (free_gidx < 0) {
+    warn("%s(%d), all %d groups used\n", __func__, idx, ST_TX_AUDIO_GROUPS_MAX);
+    return -ENOSPC;
+  }
+  g = tx_audio_group_create(impl, mgr, s, free_gidx);
+  if (!g) return -ENOMEM;
+  g->members = 1;
+  rte_spinlock_lock(&mgr->group_mutex[free_gidx]);
+  mgr->groups[free_gidx] = g;
+  rte_spinlock_unlock(&mgr->group_mutex[free_gidx]);
+  s->group = g;
+  info("%s(%d), create group %d\n", __func__, idx, free_gidx);
   return 0;
 }
 
+static void tx_audio_group_leave(struct st_tx_audio_sessions_mgr* mgr,
+                                 struct st_tx_audio_session_impl* s) {
+  struct st_tx_audio_group* g = s->group;
+  bool last = false;
+  int gidx;
+
+  if (!g) return;
+  gidx = g->idx;
+
+  /* wait the group tasklet done, it never build a session not in the group */
+  rte_spinlock_lock(&mgr->group_mutex[gidx]);
+  s->group = NULL;
+  g->members--;
+  if (g->members <= 0) {
+    mgr->groups[gidx] = NULL;
+    last = true;
+  }
+  rte_spinlock_unlock(&mgr->group_mutex[gidx]);
+
+  info("%s(%d), leave group %d, members %d\n", __func__, s->idx, gidx, g->members);
+  if (last) tx_audio_group_free(mgr, g);
+}
+
 int tx_audio_session_mempool_free(struct st_tx_audio_session_impl* s) {
   int ret;
 
@@ -1930,7 +2438,9 @@ static int tx_audio_session_init_queue(struct mtl_main_impl* impl,
     memset(&flow, 0, sizeof(flow));
     mtl_memcpy(&flow.dip_addr, &s->ops.dip_addr[i], MTL_IP_ADDR_LEN);
     flow.dst_port = s->ops.udp_port[i];
-    flow.gso_sz = s->st30_pkt_size - sizeof(struct mt_udp_hdr);
+    /* the gso skb is limited to 64k, too few jumbo packets to gain */
+    if (!(s->ops.flags & ST30_TX_FLAG_JUMBO_FRAME))
+      flow.gso_sz = s->st30_pkt_size - sizeof(struct mt_udp_hdr);
 
     s->queue[i] = mt_txq_get(impl, port, &flow);
     if (!s->queue[i]) {
@@ -1948,6 +2458,8 @@ static int tx_audio_session_uinit_sw(struct st_tx_audio_sessions_mgr* mgr,
                                      struct st_tx_audio_session_impl* s) {
   int idx = s->idx, num_port = s->ops.num_port;
 
+  tx_audio_group_leave(mgr, s);
+
   for (int port = 0; port < num_port; port++) {
     if (s->inflight[port]) {
       info("%s(%d), free inflight buf for port %d\n", __func__, idx, port);
@@ -1986,18 +2498,21 @@ static int tx_audio_session_init_sw(struct mtl_main_impl* impl,
 
   /* free the pool if any in previous session */
   tx_audio_session_mempool_free(s);
-  ret = tx_audio_session_mempool_init(impl, mgr, s);
-  if (ret < 0) {
-    err("%s(%d), mempool init fail %d\n", __func__, idx, ret);
-    tx_audio_session_uinit_sw(mgr, s);
-    return ret;
-  }
+  /* the group members build into the group pool and burst by the group */
+  if (!s->group) {
+    ret = tx_audio_session_mempool_init(impl, mgr, s);
+    if (ret < 0) {
+      err("%s(%d), mempool init fail %d\n", __func__, idx, ret);
+      tx_audio_session_uinit_sw(mgr, s);
+      return ret;
+    }
 
-  ret = tx_audio_session_init_trans_ring(mgr, s);
-  if (ret < 0) {
-    err("%s(%d), mbuf ring init fail %d\n", __func__, idx, ret);
-    tx_audio_session_uinit_sw(mgr, s);
-    return ret;
+    ret = tx_audio_session_init_trans_ring(mgr, s);
+    if (ret < 0) {
+      err("%s(%d), mbuf ring init fail %d\n", __func__, idx, ret);
+      tx_audio_session_uinit_sw(mgr, s);
+      return ret;
+    }
   }
 
   if (ops->type == ST30_TYPE_RTP_LEVEL) {
@@ -2103,11 +2618,13 @@ static int tx_audio_session_attach(struct mtl_main_impl* impl,
       }
     }
   }
+  /* the sys tx mempool is sized for the standard mtu */
   s->tx_mono_pool = mt_user_tx_mono_pool(impl);
+  if (ops->flags & ST30_TX_FLAG_JUMBO_FRAME) s->tx_mono_pool = false;
   /* manually disable chain or any port can't support chain */
   s->tx_no_chain = mt_user_tx_no_chain(impl) || !tx_audio_session_has_chain_buf(s);
 
-  s->st30_frames_cnt = ops->framebuff_cnt;
+  s->st30_frames_cnt = s->stream ? 1 : ops->framebuff_cnt;
 
   ret = st30_get_sample_size(ops->fmt);
   if (ret < 0) return ret;
@@ -2120,12 +2637,20 @@ static int tx_audio_session_attach(struct mtl_main_impl* impl,
   if (ret < 0) return ret;
   s->pkt_len = ret;
 
+  ret = st_audio_max_ether_bytes(impl, s->port_maps, num_port,
+                                 ops->flags & ST30_TX_FLAG_JUMBO_FRAME);
+  if (ret < 0) {
+    err("%s(%d), jumbo frame only for the kernel socket ports\n", __func__, idx);
+    return ret;
+  }
+
   /* calculate pkts in line*/
-  size_t bytes_in_pkt = ST_PKT_MAX_ETHER_BYTES - sizeof(struct st_rfc3550_audio_hdr);
+  size_t bytes_in_pkt = ret - sizeof(struct st_rfc3550_audio_hdr);
 
   s->st30_pkt_size = s->pkt_len + sizeof(struct st_rfc3550_audio_hdr);
   if (s->pkt_len > bytes_in_pkt) {
-    err("%s(%d), invalid pkt_len %d\n", __func__, idx, s->pkt_len);
+    err("%s(%d), invalid pkt_len %d, max %" PRIu64 "\n", __func__, idx, s->pkt_len,
+        (uint64_t)bytes_in_pkt);
     return -EIO;
   }
 
@@ -2170,6 +2695,11 @@ static int tx_audio_session_attach(struct mtl_main_impl* impl,
     }
   }
 
+  if (ops->flags & ST30_TX_FLAG_GROUP_BUILD) {
+    ret = tx_audio_group_join(impl, mgr, s);
+    if (ret < 0) warn("%s(%d), group build fail %d, build alone\n", __func__, idx, ret);
+  }
+
   ret = tx_audio_session_init_sw(impl, mgr, s);
   if (ret < 0) {
     err("%s(%d), init sw fail %d\n", __func__, idx, ret);
@@ -2365,6 +2895,34 @@ static void tx_audio_session_stat(struct st_tx_audio_sessions_mgr* mgr,
   memcpy(snap, us, sizeof(*snap));
 }
 
+static void tx_audio_group_stat(struct st_tx_audio_sessions_mgr* mgr,
+                                struct st_tx_audio_group* g) {
+  int m_idx = mgr->idx, g_idx = g->idx;
+
+  notice("TX_AUDIO_GROUP(%d,%d): members %d, epochs %" PRIu64 " pkts %" PRIu64
+         " batch max %u\n",
+         m_idx, g_idx, g->members, g->stat_epochs, g->stat_pkts, g->stat_batch_max);
+  g->stat_epochs = 0;
+  g->stat_pkts = 0;
+  g->stat_batch_max = 0;
+  if (g->stat_epoch_drop || g->stat_epoch_late || g->stat_epoch_mismatch) {
+    notice("TX_AUDIO_GROUP(%d,%d): epoch drop %u late %u mismatch %u\n", m_idx, g_idx,
+           g->stat_epoch_drop, g->stat_epoch_late, g->stat_epoch_mismatch);
+    g->stat_epoch_drop = 0;
+    g->stat_epoch_late = 0;
+    g->stat_epoch_mismatch = 0;
+  }
+  if (g->stat_alloc_fail) {
+    notice("TX_AUDIO_GROUP(%d,%d): pkts alloc fail %u\n", m_idx, g_idx,
+           g->stat_alloc_fail);
+    g->stat_alloc_fail = 0;
+  }
+  if (g->stat_burst_fail) {
+    notice("TX_AUDIO_GROUP(%d,%d): burst fail %u\n", m_idx, g_idx, g->stat_burst_fail);
+    g->stat_burst_fail = 0;
+  }
+}
+
 static int tx_audio_session_detach(struct st_tx_audio_sessions_mgr* mgr,
                                    struct st_tx_audio_session_impl* s) {
   tx_audio_session_stat(mgr, s);
@@ -2386,6 +2944,14 @@ static int st_tx_audio_sessions_stat(void* priv) {
     tx_audio_session_stat(mgr, s);
     tx_audio_session_put(mgr, j);
   }
+  for (int gidx = 0; gidx < ST_TX_AUDIO_GROUPS_MAX; gidx++) {
+    struct st_tx_audio_group* g =
+        tx_audio_group_get_timeout(mgr, gidx, ST_SESSION_STAT_TIMEOUT_US);
+    if (!g) continue;
+    tx_audio_group_stat(mgr, g);
+    tx_audio_group_put(mgr, gidx);
+  }
+  st_tx_deadline_stat(&mgr->deadline, "TX_AUDIO_MGR", m_idx);
   if (mgr->stat_pkts_burst > 0) {
     notice("TX_AUDIO_MGR(%d), pkts burst %d\n", m_idx, mgr->stat_pkts_burst);
     mgr->stat_pkts_burst = 0;
@@ -2416,7 +2982,7 @@ static int tx_audio_sessions_mgr_init(struct mtl_main_impl* impl,
                                       struct st_tx_audio_sessions_mgr* mgr) {
   int idx = sch->idx;
   struct mtl_tasklet_ops ops;
-  int i;
+  int i, ret;
 
   RTE_BUILD_BUG_ON(sizeof(struct st_rfc3550_audio_hdr) != 54);
 
@@ -2428,6 +2994,16 @@ static int tx_audio_sessions_mgr_init(struct mtl_main_impl* impl,
   for (i = 0; i < ST_SCH_MAX_TX_AUDIO_SESSIONS; i++) {
     rte_spinlock_init(&mgr->mutex[i]);
   }
+  for (i = 0; i < ST_TX_AUDIO_GROUPS_MAX; i++) {
+    rte_spinlock_init(&mgr->group_mutex[i]);
+  }
+
+  ret = st_tx_deadline_init(&mgr->deadline, ST_SCH_MAX_TX_AUDIO_SESSIONS,
+                            mgr->socket_id);
+  if (ret < 0) {
+    err("%s(%d), deadline init fail %d\n", __func__, idx, ret);
+    return ret;
+  }
 
   memset(&ops, 0x0, sizeof(ops));
   ops.priv = mgr;
@@ -2438,6 +3014,7 @@ static int tx_audio_sessions_mgr_init(struct mtl_main_impl* impl,
   mgr->tasklet = mtl_sch_register_tasklet(sch, &ops);
   if (!mgr->tasklet) {
     err("%s(%d), tasklet register fail\n", __func__, idx);
+    st_tx_deadline_uinit(&mgr->deadline);
     return -EIO;
   }
 
@@ -2447,7 +3024,8 @@ static int tx_audio_sessions_mgr_init(struct mtl_main_impl* impl,
 }
 
 static struct st_tx_audio_session_impl* tx_audio_sessions_mgr_attach(
-    struct mtl_sch_impl* sch, struct st30_tx_ops* ops) {
+    struct mtl_sch_impl* sch, struct st30_tx_ops* ops,
+    struct st_tx_audio_stream_impl* stream) {
   struct st_tx_audio_sessions_mgr* mgr = &sch->tx_a_mgr;
   int midx = mgr->idx;
   int ret;
@@ -2472,6 +3050,7 @@ static struct st_tx_audio_session_impl* tx_audio_sessions_mgr_attach(
       mt_rte_free(s);
       return NULL;
     }
+    s->stream = stream;
     ret = tx_audio_session_attach(mgr->parent, mgr, s, ops);
     if (ret < 0) {
       err("%s(%d), attach fail on %d\n", __func__, midx, i);
@@ -2483,6 +3062,7 @@ static struct st_tx_audio_session_impl* tx_audio_sessions_mgr_attach(
     mgr->sessions[i] = s;
     mgr->max_idx = RTE_MAX(mgr->max_idx, i + 1);
     tx_audio_session_put(mgr, i);
+    st_tx_deadline_kick(&mgr->deadline);
     return s;
   }
 
@@ -2506,6 +3086,7 @@ static int tx_audio_sessions_mgr_detach(struct st_tx_audio_sessions_mgr* mgr,
   mt_rte_free(s);
 
   tx_audio_session_put(mgr, idx);
+  st_tx_deadline_kick(&mgr->deadline);
 
   return 0;
 }
@@ -2545,6 +3126,7 @@ static int tx_audio_sessions_mgr_uinit(struct st_tx_audio_sessions_mgr* mgr) {
   for (int i = 0; i < mt_num_ports(impl); i++) {
     tx_audio_sessions_mgr_uinit_hw(mgr, i);
   }
+  st_tx_deadline_uinit(&mgr->deadline);
 
   info("%s(%d), succ\n", __func__, m_idx);
   return 0;
@@ -2598,7 +3180,8 @@ static int tx_audio_ops_prune_down_ports(struct mtl_main_impl* impl,
   return 0;
 }
 
-static int tx_audio_ops_check(struct st30_tx_ops* ops) {
+static int tx_audio_ops_check(struct st30_tx_ops* ops,
+                              struct st_tx_audio_stream_impl* stream) {
   int num_ports = ops->num_port, ret;
   uint8_t* ip = NULL;
 
@@ -2628,7 +3211,7 @@ static int tx_audio_ops_check(struct st30_tx_ops* ops) {
       err("%s, invalid framebuff_cnt %d\n", __func__, ops->framebuff_cnt);
       return -EINVAL;
     }
-    if (!ops->get_next_frame) {
+    if (!ops->get_next_frame && !stream) {
       err("%s, pls set get_next_frame\n", __func__);
       return -EINVAL;
     }
@@ -2637,6 +3220,10 @@ static int tx_audio_ops_check(struct st30_tx_ops* ops) {
       return -EINVAL;
     }
   } else if (ops->type == ST30_TYPE_RTP_LEVEL) {
+    if (stream) {
+      err("%s, the stream is only for ST30_TYPE_FRAME_LEVEL\n", __func__);
+      return -EINVAL;
+    }
     if (ops->rtp_ring_size <= 0) {
       err("%s, invalid rtp_ring_size %d\n", __func__, ops->rtp_ring_size);
       return -EINVAL;
@@ -2652,6 +3239,13 @@ static int tx_audio_ops_check(struct st30_tx_ops* ops) {
     return -EINVAL;
   }
 
+  if ((ops->flags & ST30_TX_FLAG_JUMBO_FRAME) &&
+      (ops->flags & ST30_TX_FLAG_ENABLE_RTCP)) {
+    /* the rtcp retransmit buffer is sized for the standard mtu */
+    err("%s, rtcp not support the jumbo frame\n", __func__);
+    return -EINVAL;
+  }
+
   return 0;
 }
 
@@ -2709,6 +3303,11 @@ int st_audio_queue_fatal_error(struct mtl_main_impl* impl,
     }
 
     s->recovery_idx++;
+    if (s->group) {
+      /* no pool in the group members, the group pkts are not in the queue yet */
+      tx_audio_session_put(mgr, sidx);
+      continue;
+    }
     tx_audio_session_mempool_free(s);
     ret = tx_audio_session_mempool_init(impl, mgr, s);
     if (ret < 0) {
@@ -2721,6 +3320,8 @@ int st_audio_queue_fatal_error(struct mtl_main_impl* impl,
     }
     tx_audio_session_put(mgr, sidx);
   }
+  /* the parked sessions may wait the pkts cleaned */
+  st_tx_deadline_kick(&mgr->deadline);
 
   /* now create new queue */
   struct mt_txq_flow flow;
@@ -2749,8 +3350,9 @@ int st_tx_audio_sessions_sch_uinit(struct mtl_sch_impl* sch) {
   return 0;
 }
 
-st30_tx_handle st30_tx_create(mtl_handle mt, struct st30_tx_ops* ops) {
-  struct mtl_main_impl* impl = mt;
+st30_tx_handle st30_tx_create_with_stream(struct mtl_main_impl* impl,
+                                          struct st30_tx_ops* ops,
+                                          struct st_tx_audio_stream_impl* stream) {
   struct st_tx_audio_session_handle_impl* s_impl;
   struct st_tx_audio_session_impl* s;
   struct mtl_sch_impl* sch;
@@ -2769,7 +3371,7 @@ st30_tx_handle st30_tx_create(mtl_handle mt, struct st30_tx_ops* ops) {
     return NULL;
   }
 
-  ret = tx_audio_ops_check(ops);
+  ret = tx_audio_ops_check(ops, stream);
   if (ret < 0) {
     err("%s, st_tx_audio_ops_check fail %d\n", __func__, ret);
     return NULL;
@@ -2810,7 +3412,7 @@ st30_tx_handle st30_tx_create(mtl_handle mt, struct st30_tx_ops* ops) {
   }
 
   mt_pthread_mutex_lock(&sch->tx_a_mgr_mutex);
-  s = tx_audio_sessions_mgr_attach(sch, ops);
+  s = tx_audio_sessions_mgr_attach(sch, ops, stream);
   mt_pthread_mutex_unlock(&sch->tx_a_mgr_mutex);
   if (!s) {
     err("%s, tx_audio_sessions_mgr_attach fail\n", __func__);
@@ -2830,6 +3432,10 @@ st30_tx_handle st30_tx_create(mtl_handle mt, struct st30_tx_ops* ops) {
   return s_impl;
 }
 
+st30_tx_handle st30_tx_create(mtl_handle mt, struct st30_tx_ops* ops) {
+  return st30_tx_create_with_stream(mt, ops, NULL);
+}
+
 int st30_tx_update_destination(st30_tx_handle handle, struct st_tx_dest_info* dst) {
   struct st_tx_audio_session_handle_impl* s_impl = handle;
   struct st_tx_audio_session_impl* s;
@@ -11,4 +11,9 @@
 
 int st_tx_audio_sessions_sch_uinit(struct mtl_sch_impl* sch);
 
+/* the tx session slices the packets from the sample ring of the pipeline, no frames */
+st30_tx_handle st30_tx_create_with_stream(struct mtl_main_impl* impl,
+                                          struct st30_tx_ops* ops,
+                                          struct st_tx_audio_stream_impl* stream);
+
 #endif
@@ -0,0 +1,137 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include "st_tx_audio_stream.h"
+
+#include "../mt_log.h"
+
+/*
+ * The app writes any number of samples, the tasklet takes pkt_len bytes for each packet
+ * at the pacing epoch of the packet, so the rtp timestamp follows the media clock
+ * whatever the write sizes are. The size is a multiple of pkt_len and the read cursor
+ * moves by whole packets, a packet is never split by the wrap and is copied once from
+ * the ring to the mbuf. A packet the app has not written in full yet is sent as
+ * silence, the samples already written stay for the next packet.
+ */
+
+struct st_tx_audio_stream_impl* st_tx_audio_stream_create(int idx, enum st30_fmt fmt,
+                                                          uint16_t channel,
+                                                          enum st30_sampling sampling,
+                                                          enum st30_ptime ptime,
+                                                          uint64_t size, uint64_t prefill,
+                                                          int socket_id) {
+  struct st_tx_audio_stream_impl* s;
+  int pkt_len = st30_get_packet_size(fmt, ptime, sampling, channel);
+  int sample_size = st30_get_sample_size(fmt);
+
+  if (pkt_len <= 0 || sample_size <= 0 || !channel) {
+    err("%s(%d), invalid fmt %d sampling %d ptime %d channel %u\n", __func__, idx, fmt,
+        sampling, ptime, channel);
+    return NULL;
+  }
+  if (!size || size % pkt_len || prefill > size) {
+    err("%s(%d), invalid size %" PRIu64 " prefill %" PRIu64 " for pkt_len %d\n",
+        __func__, idx, size, prefill, pkt_len);
+    return NULL;
+  }
+
+  s = mt_rte_zmalloc_socket(sizeof(*s), socket_id);
+  if (!s) {
+    err("%s(%d), malloc fail\n", __func__, idx);
+    return NULL;
+  }
+  s->idx = idx;
+  s->row_size = sample_size * channel;
+  s->pkt_len = pkt_len;
+  s->size = size;
+  s->prefill = prefill;
+  /* PCM8 is offset binary, zero bytes for the others */
+  s->silence = (fmt == ST30_FMT_PCM8) ? 0x80 : 0;
+
+  s->ring = mt_rte_zmalloc_socket(size, socket_id);
+  if (!s->ring) {
+    err("%s(%d), ring malloc fail, size %" PRIu64 "\n", __func__, idx, size);
+    st_tx_audio_stream_free(s);
+    return NULL;
+  }
+
+  info("%s(%d), %" PRIu64 " pkts of %u bytes, prefill %" PRIu64 " bytes\n", __func__,
+       idx, size / pkt_len, s->pkt_len, prefill);
+  return s;
+}
+
+void st_tx_audio_stream_free(struct st_tx_audio_stream_impl* s) {
+  if (s->ring) mt_rte_free(s->ring);
+  mt_rte_free(s);
+}
+
+uint32_t st_tx_audio_stream_write(struct st_tx_audio_stream_impl* s, const void* buf,
+                                  uint32_t samples) {
+  const uint8_t* src = buf;
+  uint32_t written = 0;
+
+  /* at most two runs, up to the end of the ring then from the start */
+  while (written < samples) {
+    uint8_t* dst;
+    uint32_t n = RTE_MIN(st_tx_audio_stream_reserve(s, &dst), samples - written);
+
+    if (!n) break; /* full */
+    rte_memcpy(dst, src, (size_t)n * s->row_size);
+    st_tx_audio_stream_commit(s, n);
+    src += (size_t)n * s->row_size;
+    written += n;
+  }
+
+  atomic_fetch_add_explicit(&s->stat_samples_written, written, memory_order_relaxed);
+  if (written < samples)
+    atomic_fetch_add_explicit(&s->stat_samples_full, samples - written,
+                              memory_order_relaxed);
+  return written;
+}
+
+bool st_tx_audio_stream_ready(struct st_tx_audio_stream_impl* s) {
+  if (s->started) return true;
+
+  uint64_t wr = atomic_load_explicit(&s->wr, memory_order_acquire);
+  uint64_t rd = atomic_load_explicit(&s->rd, memory_order_relaxed);
+  if (wr - rd < s->prefill) return false;
+
+  dbg("%s(%d), start with %" PRIu64 " bytes\n", __func__, s->idx, wr - rd);
+  s->started = true;
+  return true;
+}
+
+void st_tx_audio_stream_read_pkt(struct st_tx_audio_stream_impl* s, void* payload) {
+  uint64_t rd = atomic_load_explicit(&s->rd, memory_order_relaxed);
+  uint64_t wr = atomic_load_explicit(&s->wr, memory_order_acquire);
+
+  if (wr - rd < s->pkt_len) {
+    memset(payload, s->silence, s->pkt_len);
+    s->stat_pkts_underrun++;
+    return;
+  }
+
+  rte_memcpy(payload, s->ring + rd % s->size, s->pkt_len);
+  /* the slot is free for the app only after the copy */
+  atomic_store_explicit(&s->rd, rd + s->pkt_len, memory_order_release);
+  s->stat_pkts_sent++;
+}
+
+void st_tx_audio_stream_stat(struct st_tx_audio_stream_impl* s) {
+  uint64_t wr = atomic_load_explicit(&s->wr, memory_order_relaxed);
+  uint64_t rd = atomic_load_explicit(&s->rd, memory_order_relaxed);
+
+  /* the pkt counters are from the tasklet, total since create */
+  notice("TX_st30p(%d), stream pkts sent %" PRIu64 " underrun %" PRIu64
+         ", fill %" PRIu64 "/%" PRIu64 " bytes\n",
+         s->idx, s->stat_pkts_sent, s->stat_pkts_underrun, wr - rd, s->size);
+
+  uint64_t written =
+      atomic_exchange_explicit(&s->stat_samples_written, 0, memory_order_relaxed);
+  uint64_t full =
+      atomic_exchange_explicit(&s->stat_samples_full, 0, memory_order_relaxed);
+  notice("TX_st30p(%d), stream samples written %" PRIu64 " not written as full %" PRIu64
+         "\n",
+         s->idx, written, full);
+}
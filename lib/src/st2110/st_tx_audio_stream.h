@@ -0,0 +1,52 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#ifndef _ST_LIB_TX_AUDIO_STREAM_HEAD_H_
+#define _ST_LIB_TX_AUDIO_STREAM_HEAD_H_
+
+#include "st_main.h"
+
+/* the ring of size bytes, the first packet waits prefill bytes from the app */
+struct st_tx_audio_stream_impl* st_tx_audio_stream_create(int idx, enum st30_fmt fmt,
+                                                          uint16_t channel,
+                                                          enum st30_sampling sampling,
+                                                          enum st30_ptime ptime,
+                                                          uint64_t size, uint64_t prefill,
+                                                          int socket_id);
+void st_tx_audio_stream_free(struct st_tx_audio_stream_impl* s);
+
+/*
+ * The free space at the write cursor for the app, the samples which can be written at
+ * addr without a wrap. Publish them with st_tx_audio_stream_commit.
+ */
+static inline uint32_t st_tx_audio_stream_reserve(struct st_tx_audio_stream_impl* s,
+                                                  uint8_t** addr) {
+  uint64_t wr = atomic_load_explicit(&s->wr, memory_order_relaxed);
+  uint64_t rd = atomic_load_explicit(&s->rd, memory_order_acquire);
+  uint64_t off = wr % s->size;
+
+  *addr = s->ring + off;
+  return RTE_MIN(s->size - (wr - rd), s->size - off) / s->row_size;
+}
+
+static inline void st_tx_audio_stream_commit(struct st_tx_audio_stream_impl* s,
+                                             uint32_t samples) {
+  uint64_t wr = atomic_load_explicit(&s->wr, memory_order_relaxed);
+
+  atomic_store_explicit(&s->wr, wr + (uint64_t)samples * s->row_size,
+                        memory_order_release);
+}
+
+/* copy the wire samples to the ring from the app thread, the samples written */
+uint32_t st_tx_audio_stream_write(struct st_tx_audio_stream_impl* s, const void* buf,
+                                  uint32_t samples);
+
+/* if the tasklet can send, from the prefill on the session never waits the app again */
+bool st_tx_audio_stream_ready(struct st_tx_audio_stream_impl* s);
+/* the payload of the next packet from the tasklet, silence if the app is behind */
+void st_tx_audio_stream_read_pkt(struct st_tx_audio_stream_impl* s, void* payload);
+
+void st_tx_audio_stream_stat(struct st_tx_audio_stream_impl* s);
+
+#endif
@@ -0,0 +1,165 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include "st_tx_deadline.h"
+
+#include "../mt_log.h"
+
+static inline void tx_deadline_ready_set(struct st_tx_deadline* d, uint16_t idx) {
+  d->ready[idx / 64] |= UINT64_C(1) << (idx % 64);
+}
+
+static inline void tx_deadline_ready_clear(struct st_tx_deadline* d, uint16_t idx) {
+  d->ready[idx / 64] &= ~(UINT64_C(1) << (idx % 64));
+}
+
+static inline void tx_deadline_place(struct st_tx_deadline* d, int n,
+                                     struct st_tx_deadline_node node) {
+  d->nodes[n] = node;
+  d->pos[node.idx] = n;
+}
+
+static void tx_deadline_sift_up(struct st_tx_deadline* d, int n) {
+  struct st_tx_deadline_node node = d->nodes[n];
+
+  while (n > 0) {
+    int parent = (n - 1) / 2;
+    if (d->nodes[parent].due <= node.due) break;
+    tx_deadline_place(d, n, d->nodes[parent]);
+    n = parent;
+  }
+  tx_deadline_place(d, n, node);
+}
+
+static void tx_deadline_sift_down(struct st_tx_deadline* d, int n) {
+  struct st_tx_deadline_node node = d->nodes[n];
+  int num = d->num;
+
+  for (;;) {
+    int child = n * 2 + 1;
+    if (child >= num) break;
+    if (child + 1 < num && d->nodes[child + 1].due < d->nodes[child].due) child++;
+    if (node.due <= d->nodes[child].due) break;
+    tx_deadline_place(d, n, d->nodes[child]);
+    n = child;
+  }
+  tx_deadline_place(d, n, node);
+}
+
+/* take the node n out of the heap */
+static void tx_deadline_remove(struct st_tx_deadline* d, int n) {
+  struct st_tx_deadline_node last = d->nodes[--d->num];
+
+  d->pos[d->nodes[n].idx] = -1;
+  if (n == d->num) return;
+  tx_deadline_place(d, n, last);
+  if (n > 0 && d->nodes[(n - 1) / 2].due > last.due)
+    tx_deadline_sift_up(d, n);
+  else
+    tx_deadline_sift_down(d, n);
+}
+
+int st_tx_deadline_init(struct st_tx_deadline* d, uint16_t cap, int socket_id) {
+  int words = (cap + 63) / 64;
+
+  d->nodes = mt_rte_zmalloc_socket(sizeof(*d->nodes) * cap, socket_id);
+  d->pos = mt_rte_zmalloc_socket(sizeof(*d->pos) * cap, socket_id);
+  d->ready = mt_rte_zmalloc_socket(sizeof(*d->ready) * words, socket_id);
+  if (!d->nodes || !d->pos || !d->ready) {
+    err("%s, malloc fail for cap %u\n", __func__, cap);
+    st_tx_deadline_uinit(d);
+    return -ENOMEM;
+  }
+  d->cap = cap;
+  d->num = 0;
+  for (int i = 0; i < cap; i++) d->pos[i] = -1;
+  rte_atomic32_set(&d->kick, 1); /* all ready at the first loop */
+  d->kick_seen = 0;
+  return 0;
+}
+
+void st_tx_deadline_uinit(struct st_tx_deadline* d) {
+  if (d->nodes) {
+    mt_rte_free(d->nodes);
+    d->nodes = NULL;
+  }
+  if (d->pos) {
+    mt_rte_free(d->pos);
+    d->pos = NULL;
+  }
+  if (d->ready) {
+    mt_rte_free(d->ready);
+    d->ready = NULL;
+  }
+  d->cap = 0;
+  d->num = 0;
+}
+
+void st_tx_deadline_expire(struct st_tx_deadline* d, uint16_t max_idx, uint64_t tsc) {
+  int32_t kick = rte_atomic32_read(&d->kick);
+
+  if (kick != d->kick_seen) {
+    int words = (d->cap + 63) / 64;
+
+    d->kick_seen = kick;
+    for (int i = 0; i < d->num; i++) d->pos[d->nodes[i].idx] = -1;
+    d->num = 0;
+    max_idx = RTE_MIN(max_idx, d->cap);
+    for (int w = 0; w < words; w++) {
+      int base = w * 64;
+      if (max_idx >= base + 64)
+        d->ready[w] = UINT64_MAX;
+      else if (max_idx > base)
+        d->ready[w] = (UINT64_C(1) << (max_idx - base)) - 1;
+      else
+        d->ready[w] = 0;
+    }
+    return;
+  }
+
+  while (d->num && d->nodes[0].due <= tsc) {
+    uint16_t idx = d->nodes[0].idx;
+    tx_deadline_remove(d, 0);
+    tx_deadline_ready_set(d, idx);
+    d->stat_expired++;
+  }
+}
+
+void st_tx_deadline_park(struct st_tx_deadline* d, uint16_t idx, uint64_t due) {
+  int n = d->pos[idx];
+
+  tx_deadline_ready_clear(d, idx);
+  d->stat_parked++;
+  if (n < 0) {
+    n = d->num++;
+    d->nodes[n].idx = idx;
+    d->nodes[n].due = due;
+    d->pos[idx] = n;
+    tx_deadline_sift_up(d, n);
+    return;
+  }
+
+  /* parked already, move it */
+  uint64_t old = d->nodes[n].due;
+  d->nodes[n].due = due;
+  if (due < old)
+    tx_deadline_sift_up(d, n);
+  else
+    tx_deadline_sift_down(d, n);
+}
+
+void st_tx_deadline_drop(struct st_tx_deadline* d, uint16_t idx) {
+  tx_deadline_ready_clear(d, idx);
+  if (d->pos[idx] >= 0) tx_deadline_remove(d, d->pos[idx]);
+}
+
+void st_tx_deadline_stat(struct st_tx_deadline* d, const char* name, int idx) {
+  if (!d->stat_visited) return;
+  notice("%s(%d), deadline visited %" PRIu64 " parked %" PRIu64 " expired %" PRIu64
+         ", now parked %u\n",
+         name, idx, d->stat_visited, d->stat_parked, d->stat_expired, d->num);
+  d->stat_visited = 0;
+  d->stat_parked = 0;
+  d->stat_expired = 0;
+}
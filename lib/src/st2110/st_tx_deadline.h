@@ -0,0 +1,52 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#ifndef _ST_LIB_TX_DEADLINE_HEAD_H_
+#define _ST_LIB_TX_DEADLINE_HEAD_H_
+
+#include "st_main.h"
+
+int st_tx_deadline_init(struct st_tx_deadline* d, uint16_t cap, int socket_id);
+void st_tx_deadline_uinit(struct st_tx_deadline* d);
+
+/* from the control path after a session attach, detach or pacing reset */
+static inline void st_tx_deadline_kick(struct st_tx_deadline* d) {
+  rte_atomic32_inc(&d->kick);
+}
+
+/*
+ * From the tasklet before the loop: all sessions below max_idx are ready if kicked,
+ * then the parked sessions due at tsc join them.
+ */
+void st_tx_deadline_expire(struct st_tx_deadline* d, uint16_t max_idx, uint64_t tsc);
+
+/* out of the loop until due, the caller keeps it ready if due already */
+void st_tx_deadline_park(struct st_tx_deadline* d, uint16_t idx, uint64_t due);
+
+/* out of the loop until the next kick */
+void st_tx_deadline_drop(struct st_tx_deadline* d, uint16_t idx);
+
+/* the next ready session from idx, -1 if none */
+static inline int st_tx_deadline_next_ready(struct st_tx_deadline* d, int idx) {
+  int w = idx / 64;
+  int words = (d->cap + 63) / 64;
+  uint64_t bits;
+
+  if (idx >= d->cap) return -1;
+  bits = d->ready[w] & (UINT64_MAX << (idx % 64));
+  while (!bits) {
+    if (++w >= words) return -1;
+    bits = d->ready[w];
+  }
+  return w * 64 + __builtin_ctzll(bits);
+}
+
+/* the tsc of the first parked session, UINT64_MAX if none */
+static inline uint64_t st_tx_deadline_first(struct st_tx_deadline* d) {
+  return d->num ? d->nodes[0].due : UINT64_MAX;
+}
+
+void st_tx_deadline_stat(struct st_tx_deadline* d, const char* name, int idx);
+
+#endif
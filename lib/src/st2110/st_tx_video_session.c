@@ -244,6 +244,11 @@ static int tv_alloc_frames(struct mtl_main_impl* impl,
       frame_info->addr = NULL;
       frame_info->flags = ST_FT_FLAG_EXT;
       info("%s(%d), use external framebuffer, skip allocation\n", __func__, idx);
+    } else if (!st22_info && s->ops.uframe_pg_callback) {
+      /* payload filled by uframe_pg_callback, no transport framebuffer */
+      frame_info->iova = 0;
+      frame_info->addr = NULL;
+      frame_info->flags = 0;
     } else {
       void* frame = mt_rte_zmalloc_socket(s->st20_fb_size, soc_id);
       if (!frame) {
@@ -1056,6 +1061,25 @@ static int tv_build_st20_redundant(struct st_tx_video_session_impl* s,
   return 0;
 }
 
+static void tv_uframe_pg_fill(struct st_tx_video_session_impl* s, void* payload,
+                              uint16_t row_number, uint16_t row_offset,
+                              uint16_t row_length) {
+  struct st20_tx_ops* ops = &s->ops;
+  struct st20_tx_uframe_pg_meta* pg_meta = &s->pg_meta;
+  int ret;
+
+  pg_meta->payload = payload;
+  pg_meta->row_length = row_length;
+  pg_meta->row_number = row_number;
+  pg_meta->row_offset = row_offset;
+  pg_meta->pg_cnt = row_length / s->st20_pg.size;
+  ret = ops->uframe_pg_callback(ops->priv, s->st20_frame_idx, pg_meta);
+  if (ret < 0) {
+    dbg("%s(%d), uframe pg fail %d at line %u\n", __func__, s->idx, ret, row_number);
+    s->port_user_stats.stat_pkts_uframe_fail++;
+  }
+}
+
 static int tv_build_st20(struct st_tx_video_session_impl* s, struct rte_mbuf* pkt) {
   struct st_rfc4175_video_hdr* hdr;
   struct rte_ipv4_hdr* ipv4;
@@ -1139,7 +1163,15 @@ static int tv_build_st20(struct st_tx_video_session_impl* s, struct rte_mbuf* pk
     payload = &e_rtp[1];
   else
     payload = (void*)((uint8_t*)rtp + sizeof(*rtp));
-  if (e_rtp && s->st20_linesize > s->st20_bytes_in_line) {
+  if (ops->uframe_pg_callback) {
+    /* user frame mode, app fill the pixel groups to the payload directly */
+    if (e_rtp) {
+      tv_uframe_pg_fill(s, payload, line1_number, line1_offset, line1_length);
+      tv_uframe_pg_fill(s, payload + line1_length, line1_number + 1, 0, line2_length);
+    } else {
+      tv_uframe_pg_fill(s, payload, line1_number, line1_offset, left_len);
+    }
+  } else if (e_rtp && s->st20_linesize > s->st20_bytes_in_line) {
     /* cross lines with padding case */
     mtl_memcpy(payload, frame_info->addr + offset, line1_length);
     mtl_memcpy(payload + line1_length,
@@ -1804,6 +1836,8 @@ static int tv_usdt_dump_frame(struct mtl_main_impl* impl,
   struct st20_tx_ops* ops = &s->ops;
   uint64_t tsc_s = mt_get_tsc(impl);
 
+  if (!frame->addr) return -EINVAL; /* no transport framebuffer in uframe mode */
+
   snprintf(usdt_dump_path, sizeof(usdt_dump_path),
            "imtl_usdt_st20tx_m%ds%d_%d_%d_XXXXXX.yuv", mgr->idx, idx, ops->width,
            ops->height);
@@ -2424,6 +2458,8 @@ static int tv_tasklet_st22(struct mtl_main_impl* impl,
       /* all check fine */
       frame->tx_st22_meta = meta;
       rte_atomic32_inc(&frame->refcnt);
+      /* hold the extbuf until all pkts built, the nic may free the first pkts */
+      if (!s->tx_no_chain) rte_mbuf_ext_refcnt_update(&frame->sh_info, 1);
       size_t frame_size = codestream_size + s->st22_box_hdr_length;
       st22_info->st22_total_pkts = frame_size / s->st20_pkt_len;
       if (frame_size % s->st20_pkt_len) st22_info->st22_total_pkts++;
@@ -2595,9 +2631,12 @@ static int tv_tasklet_st22(struct mtl_main_impl* impl,
     s->port_user_stats.common.port[MTL_SESSION_PORT_P].frames++;
     if (send_r) s->port_user_stats.common.port[MTL_SESSION_PORT_R].frames++;
     st22_info->frame_idx++;
+    struct st_frame_trans* frame_info = &s->st20_frames[s->st20_frame_idx];
     if (s->tx_no_chain) {
       /* trigger extbuf free cb since mbuf attach not used */
-      struct st_frame_trans* frame_info = &s->st20_frames[s->st20_frame_idx];
+      tv_frame_free_cb(frame_info->addr, frame_info);
+    } else if (!rte_mbuf_ext_refcnt_update(&frame_info->sh_info, -1)) {
+      /* all attached pkts already sent, or all payloads copied for cross page */
       tv_frame_free_cb(frame_info->addr, frame_info);
     }
 
@@ -3300,7 +3339,16 @@ static int tv_attach(struct mtl_main_impl* impl, struct st_tx_video_sessions_mgr
   }
 
   if (st22_frame_ops) {
-    /* no chain support for st22 since the pkts for each frame may be very small */
+    /* attach the codestream as extbuf, st20_total_pkts is the max codestream here */
+    s->tx_no_chain = mt_user_tx_no_chain(impl) || !tv_has_chain_buf(s) ||
+                     !tv_pkts_capable_chain(impl, s);
+    /*
+     * the pkts for each frame may be very small, reclaim the sent mbufs at each
+     * frame start instead of waiting the nic ring wrap to release the frame.
+     */
+    s->tx_done_cleanup = !s->tx_no_chain;
+  } else if (ops->uframe_pg_callback) {
+    /* the payload is filled in place by the user frame callback */
     s->tx_no_chain = true;
   } else {
     /* manually disable chain or any port can't support chain */
@@ -3310,6 +3358,16 @@ static int tv_attach(struct mtl_main_impl* impl, struct st_tx_video_sessions_mgr
   if (s->tx_no_chain) {
     info("%s(%d), no chain mbuf support\n", __func__, idx);
   }
+  if (!st22_frame_ops && ops->uframe_pg_callback) {
+    struct st20_tx_uframe_pg_meta* pg_meta = &s->pg_meta;
+    pg_meta->width = ops->width;
+    pg_meta->height = ops->height;
+    pg_meta->fps = ops->fps;
+    pg_meta->fmt = ops->fmt;
+    pg_meta->frame_total_size = s->st20_frame_size;
+    info("%s(%d), user frame mode, payload filled by uframe_pg_callback\n", __func__,
+         idx);
+  }
 
   enum mtl_port port;
   for (int i = 0; i < num_port; i++) {
@@ -3513,6 +3571,11 @@ static void tv_stat(struct st_tx_video_sessions_mgr* mgr,
   if (d) {
     notice("TX_VIDEO_SESSION(%d,%d): vsync mismatch cnt %" PRIu64 "\n", m_idx, idx, d);
   }
+  d = us->stat_pkts_uframe_fail - snap->stat_pkts_uframe_fail;
+  if (d) {
+    notice("TX_VIDEO_SESSION(%d,%d): uframe pg callback fail cnt %" PRIu64 "\n", m_idx,
+           idx, d);
+  }
   d = us->stat_pkts_chain_realloc_fail - snap->stat_pkts_chain_realloc_fail;
   if (d) {
     notice("TX_VIDEO_SESSION(%d,%d): chain pkt realloc fail cnt %" PRIu64 "\n", m_idx,
@@ -3926,6 +3989,10 @@ static int tv_ops_check(struct st20_tx_ops* ops) {
         return -EINVAL;
       }
     }
+    if (ops->uframe_pg_callback && (ops->flags & ST20_TX_FLAG_EXT_FRAME)) {
+      err("%s, uframe_pg_callback not support ext frame\n", __func__);
+      return -EINVAL;
+    }
   } else if (ops->type == ST20_TYPE_RTP_LEVEL) {
     if (ops->rtp_ring_size <= 0) {
       err("%s, invalid rtp_ring_size %d\n", __func__, ops->rtp_ring_size);
@@ -77,6 +77,8 @@ static uint16_t video_trs_burst(struct mtl_main_impl* impl,
   if (0 == pkt_idx) {
     struct st_frame_trans* frame = st_tx_mbuf_get_priv(tx_pkts[0]);
     if (frame) st20_frame_tx_start(impl, s, s_port, frame);
+    /* release the extbuf of the previous frames */
+    if (s->tx_done_cleanup) mt_txq_done_cleanup(s->queue[s_port]);
   }
 
   for (uint16_t i = 0; i < tx; i++) {
@@ -10,8 +10,14 @@
 #include <xdp/parsing_helpers.h>
 #include <xdp/xdp_helpers.h>
 
+#include "mtl_xdp_meta.h"
+
 char LICENSE[] SEC("license") = "Dual BSD/GPL";
 
+/* xdp rx metadata kfunc, return -EOPNOTSUPP if the driver or the prog load not support */
+extern int bpf_xdp_metadata_rx_timestamp(const struct xdp_md* ctx,
+                                         __u64* timestamp) __ksym __weak;
+
 struct {
   __uint(type, BPF_MAP_TYPE_HASH);
   __uint(max_entries, 256); /* max 256 filters */
@@ -33,6 +39,25 @@ static int __always_inline lookup_udp4_dp(__u16 dp) {
   return 0;
 }
 
+static void __always_inline set_rx_meta(struct xdp_md* ctx) {
+  struct mtl_xdp_rx_meta* meta;
+  __u64 timestamp = 0;
+  __u32 flags = 0;
+
+  if (bpf_ksym_exists(bpf_xdp_metadata_rx_timestamp) &&
+      !bpf_xdp_metadata_rx_timestamp(ctx, &timestamp) && timestamp)
+    flags |= MTL_XDP_RX_META_F_HW_TIMESTAMP;
+  else
+    timestamp = bpf_ktime_get_tai_ns();
+
+  if (bpf_xdp_adjust_meta(ctx, -(int)sizeof(*meta))) return; /* no meta support */
+  meta = (void*)(long)ctx->data_meta;
+  if ((void*)(meta + 1) > (void*)(long)ctx->data) return;
+  meta->rx_timestamp = timestamp;
+  meta->flags = flags;
+  meta->magic = MTL_XDP_RX_META_MAGIC;
+}
+
 SEC("xdp")
 int mtl_dp_filter(struct xdp_md* ctx) {
   void* data_end = (void*)(long)ctx->data_end;
@@ -59,6 +84,9 @@ int mtl_dp_filter(struct xdp_md* ctx) {
   __u16 dst_port = bpf_ntohs(udphdr->dest);
   if (lookup_udp4_dp(dst_port) == 0) return XDP_PASS;
 
+  /* the arrival time for the af_xdp rx, read by the lib from the headroom */
+  set_rx_meta(ctx);
+
   /* go to next program: xsk_def_prog */
   return XDP_DROP;
 }
@@ -0,0 +1,22 @@
+/* SPDX-License-Identifier: GPL-2.0 OR BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#ifndef _MTL_XDP_META_HEAD_H_
+#define _MTL_XDP_META_HEAD_H_
+
+#include <linux/types.h>
+
+#define MTL_XDP_RX_META_MAGIC (0x4D54524D) /* ASCII representation of "MTRM" */
+
+/* the timestamp is from the NIC, otherwise it's CLOCK_TAI read at the xdp hook */
+#define MTL_XDP_RX_META_F_HW_TIMESTAMP (1 << 0)
+
+/* the rx metadata written by mtl.xdp.c just before the pkt data for the af_xdp socket */
+struct mtl_xdp_rx_meta {
+  __u64 rx_timestamp; /* TAI time, ns */
+  __u32 flags;        /* MTL_XDP_RX_META_F_* */
+  __u32 magic;        /* MTL_XDP_RX_META_MAGIC, cleared by the consumer */
+};
+
+#endif
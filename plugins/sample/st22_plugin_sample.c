@@ -131,7 +131,20 @@ static int decode_frame(struct st22_decoder_session* s,
   }
 
   /* call the real decode here, sample just copy and sleep */
-  memcpy(frame->dst->addr[0], frame->src->addr[0], codestream_size);
+  if (frame->src_segs) {
+    /* codestream sg mode, gather the segments */
+    uint8_t* dst = frame->dst->addr[0];
+    size_t copied = 0;
+    for (uint32_t i = 0; i < frame->src_segs_nb; i++) {
+      const struct st22_rx_codestream_seg* seg = &frame->src_segs[i];
+      if (!seg->len) continue; /* lost pkt */
+      if (copied + seg->len > frame->dst->buffer_size) break;
+      memcpy(dst + copied, seg->addr, seg->len);
+      copied += seg->len;
+    }
+  } else {
+    memcpy(frame->dst->addr[0], frame->src->addr[0], codestream_size);
+  }
   st_usleep(10 * 1000);
 
   s->frame_cnt++;
@@ -173,8 +186,9 @@ static st22_decode_priv decoder_create_session(void* priv, st22p_decode_session
     memset(session, 0, sizeof(*session));
     session->idx = i;
 
-    /* enable block get mode */
+    /* enable block get mode, consume the codestream segments if the app allows */
     req->resp_flag = ST22_DECODER_RESP_FLAG_BLOCK_GET;
+    if (req->codestream_sg) req->resp_flag |= ST22_DECODER_RESP_FLAG_CODESTREAM_SG;
 
     session->req = *req;
     session->session_p = session_p;
@@ -15,18 +15,18 @@
 #include "../log.h"
 #include "../plugin_platform.h"
 
-static int avcodec_encode_frame(struct st22_avcodec_encoder_session* s,
+static int avcodec_encode_frame(struct st22_avcodec_encode_worker* w,
                                 struct st22_encode_frame_meta* frame) {
-  int idx = s->idx;
-  AVFrame* f = s->codec_frame;
-  AVPacket* p = s->codec_pkt;
-  AVCodecContext* ctx = s->codec_ctx;
+  int idx = w->session->idx;
+  AVFrame* f = w->codec_frame;
+  AVPacket* p = w->codec_pkt;
+  AVCodecContext* ctx = w->codec_ctx;
   size_t data_size = 0;
   int ret;
   bool measure_time = false;
   uint64_t start_time = 0, end_time = 0;
   struct st_frame* src = frame->src;
-  int f_idx = s->frame_cnt;
+  int f_idx = w->frame_cnt;
 
   if (measure_time) {
     start_time = st_get_monotonic_time();
@@ -46,19 +46,20 @@ static int avcodec_encode_frame(struct st22_avcodec_encoder_session* s,
 
   ret = avcodec_send_frame(ctx, f);
   if (ret < 0) {
-    err("%s(%d), send frame(%d) fail %s\n", __func__, idx, f_idx, av_err2str(ret));
+    err("%s(%d,%d), send frame(%d) fail %s\n", __func__, idx, w->idx, f_idx,
+        av_err2str(ret));
     return ret;
   }
-  s->frame_cnt++;
+  w->frame_cnt++;
 
   ret = avcodec_receive_packet(ctx, p);
   if (ret < 0) {
-    dbg("%s(%d), receive packet fail %s on frame %d\n", __func__, idx, av_err2str(ret),
-        f_idx);
+    dbg("%s(%d,%d), receive packet fail %s on frame %d\n", __func__, idx, w->idx,
+        av_err2str(ret), f_idx);
     /* log error if not EAGAIN or EOF*/
     if (ret != AVERROR(EAGAIN) && ret != AVERROR_EOF) {
-      err("%s(%d), receive packet fail %s on frame %d\n", __func__, idx, av_err2str(ret),
-          f_idx);
+      err("%s(%d,%d), receive packet fail %s on frame %d\n", __func__, idx, w->idx,
+          av_err2str(ret), f_idx);
     }
   } else {
     dbg("%s, receive packet %" PRId64 " size %d on frame %d\n", __func__, p->pts, p->size,
@@ -71,96 +72,88 @@ static int avcodec_encode_frame(struct st22_avcodec_encoder_session* s,
 
   if (measure_time) {
     end_time = st_get_monotonic_time();
-    info("%s(%d), consume time %" PRIu64 "us for frame %d\n", __func__, idx,
+    info("%s(%d,%d), consume time %" PRIu64 "us for frame %d\n", __func__, idx, w->idx,
          (end_time - start_time) / 1000, f_idx);
   }
 
   frame->dst->data_size = data_size;
-  dbg("%s(%d), codestream size %" PRIu64 " on frame %d\n", __func__, idx, data_size,
-      f_idx);
+  dbg("%s(%d,%d), codestream size %" PRIu64 " on frame %d\n", __func__, idx, w->idx,
+      data_size, f_idx);
   return data_size > 0 ? 0 : -EIO;
 }
 
 static void* avcodec_encode_thread(void* arg) {
-  struct st22_avcodec_encoder_session* s = arg;
+  struct st22_avcodec_encode_worker* w = arg;
+  struct st22_avcodec_encoder_session* s = w->session;
   st22p_encode_session session_p = s->session_p;
   struct st22_encode_frame_meta* frame;
   int result;
 
-  info("%s(%d), start\n", __func__, s->idx);
+  info("%s(%d,%d), start\n", __func__, s->idx, w->idx);
   while (!s->stop) {
     frame = st22_encoder_get_frame(session_p);
     if (!frame) { /* no frame */
-      info("%s(%d), get frame timeout\n", __func__, s->idx);
+      info("%s(%d,%d), get frame timeout\n", __func__, s->idx, w->idx);
       continue;
     }
-    result = avcodec_encode_frame(s, frame);
+    /* the lib keeps the transmit order if other workers put back earlier */
+    result = avcodec_encode_frame(w, frame);
     st22_encoder_put_frame(session_p, frame, result);
   }
-  info("%s(%d), stop\n", __func__, s->idx);
+  info("%s(%d,%d), stop\n", __func__, s->idx, w->idx);
 
   return NULL;
 }
 
-static int avcodec_encoder_uinit_session(struct st22_avcodec_encoder_session* session) {
-  int idx = session->idx;
-
-  if (session->encode_thread) {
-    info("%s(%d), stop thread\n", __func__, idx);
-    session->stop = true;
-    st22_encoder_wake_block(session->session_p);
-    pthread_join(session->encode_thread, NULL);
-    session->encode_thread = 0;
+static void avcodec_encoder_uinit_worker(struct st22_avcodec_encode_worker* w) {
+  if (w->codec_ctx) {
+    avcodec_free_context(&w->codec_ctx);
+    w->codec_ctx = NULL;
   }
 
-  if (session->codec_ctx) {
-    avcodec_free_context(&session->codec_ctx);
-    session->codec_ctx = NULL;
+  if (w->codec_frame) {
+    av_frame_free(&w->codec_frame);
+    w->codec_frame = NULL;
   }
 
-  if (session->codec_frame) {
-    av_frame_free(&session->codec_frame);
-    session->codec_frame = NULL;
+  if (w->codec_pkt) {
+    av_packet_free(&w->codec_pkt);
+    w->codec_pkt = NULL;
   }
+}
 
-  if (session->codec_pkt) {
-    av_packet_free(&session->codec_pkt);
-    session->codec_pkt = NULL;
+static int avcodec_encoder_uinit_session(struct st22_avcodec_encoder_session* session) {
+  int idx = session->idx;
+
+  session->stop = true;
+  for (int i = 0; i < session->workers_cnt; i++) {
+    struct st22_avcodec_encode_worker* w = &session->workers[i];
+    if (!w->encode_thread) continue;
+    info("%s(%d), stop thread %d\n", __func__, idx, i);
+    st22_encoder_wake_block(session->session_p);
+    pthread_join(w->encode_thread, NULL);
+    w->encode_thread = 0;
   }
 
+  for (int i = 0; i < session->workers_cnt; i++)
+    avcodec_encoder_uinit_worker(&session->workers[i]);
+
   return 0;
 }
 
-static int avcodec_encoder_init_session(struct st22_avcodec_encoder_session* session,
-                                        struct st22_encoder_create_req* req) {
+static int avcodec_encoder_init_worker(struct st22_avcodec_encoder_session* session,
+                                       struct st22_avcodec_encode_worker* w,
+                                       const AVCodec* codec,
+                                       struct st22_encoder_create_req* req) {
   int idx = session->idx;
   int ret;
 
-  req->max_codestream_size = req->codestream_size;
-  session->req = *req;
-
-  enum AVCodecID codec_id;
-  if (req->output_fmt == ST_FRAME_FMT_H265_CODESTREAM) {
-    codec_id = AV_CODEC_ID_H265;
-  } else if (req->output_fmt == ST_FRAME_FMT_H264_CODESTREAM) {
-    codec_id = AV_CODEC_ID_H264;
-  } else {
-    err("%s(%d), invalid codec stream fmt %d\n", __func__, idx, req->output_fmt);
-    return -EIO;
-  }
-  const AVCodec* codec = avcodec_find_encoder(codec_id);
-  if (!codec) {
-    err("%s(%d), codec %d create fail\n", __func__, idx, codec_id);
-    avcodec_encoder_uinit_session(session);
-    return -EIO;
-  }
   AVCodecContext* c = avcodec_alloc_context3(codec);
   if (!c) {
-    err("%s(%d), codec ctx create fail\n", __func__, idx);
-    avcodec_encoder_uinit_session(session);
+    err("%s(%d,%d), codec ctx create fail\n", __func__, idx, w->idx);
     return -EIO;
   }
-  session->codec_ctx = c;
+  w->codec_ctx = c;
   /* init config */
   double fps = st_frame_rate(req->fps);
   /* bit per second */
@@ -173,58 +166,112 @@ static int avcodec_encoder_init_session(struct st22_avcodec_encoder_session* ses
   c->width = req->width;
   c->height = req->height;
   c->time_base = (AVRational){1, fps};
-  if (req->input_fmt == ST_FRAME_FMT_YUV422PLANAR8) {
-    c->pix_fmt = AV_PIX_FMT_YUV422P;
-  } else if (req->input_fmt == ST_FRAME_FMT_YUV420PLANAR8) {
-    c->pix_fmt = AV_PIX_FMT_YUV420P;
-  } else {
-    err("%s(%d), invalid input fmt %d\n", __func__, idx, req->input_fmt);
-    avcodec_encoder_uinit_session(session);
-    return -EIO;
+  c->pix_fmt = session->pix_fmt;
+  if (req->slice_cnt) { /* slice parallel inside one frame */
+    c->slices = req->slice_cnt;
+    c->thread_type = FF_THREAD_SLICE;
+  }
+  if (req->codec_thread_cnt) c->thread_count = req->codec_thread_cnt;
+  if (session->workers_cnt > 1) {
+    /*
+     * Each worker only sees every Nth frame of the session, so no frame can
+     * reference another one: intra only, no B frames and no encoder delay.
+     */
+    c->gop_size = 0;
+    c->max_b_frames = 0;
   }
-  session->pix_fmt = c->pix_fmt;
 
   av_opt_set(c->priv_data, "fast", "preset", 0);
+  if (session->workers_cnt > 1) av_opt_set(c->priv_data, "forced-idr", "1", 0);
   av_opt_set(c->priv_data, "tune", "zerolatency", 0);
   av_opt_set(c->priv_data, "nal-hrd", "cbr", 0);
 
   ret = avcodec_open2(c, codec, NULL);
   if (ret < 0) {
-    err("%s(%d), avcodec_open2 fail %d\n", __func__, idx, ret);
-    avcodec_encoder_uinit_session(session);
+    err("%s(%d,%d), avcodec_open2 fail %d\n", __func__, idx, w->idx, ret);
     return ret;
   }
 
   AVFrame* f = av_frame_alloc();
   if (!f) {
-    err("%s(%d), frame alloc fail\n", __func__, idx);
-    avcodec_encoder_uinit_session(session);
+    err("%s(%d,%d), frame alloc fail\n", __func__, idx, w->idx);
     return -EIO;
   }
-  session->codec_frame = f;
+  w->codec_frame = f;
   f->format = c->pix_fmt;
   f->width = c->width;
   f->height = c->height;
   ret = av_frame_get_buffer(f, 0);
   if (ret < 0) {
-    err("%s(%d), frame get fail\n", __func__, idx);
-    avcodec_encoder_uinit_session(session);
+    err("%s(%d,%d), frame get fail\n", __func__, idx, w->idx);
     return -EIO;
   }
 
   AVPacket* p = av_packet_alloc();
   if (!p) {
-    err("%s(%d), pkt alloc fail\n", __func__, idx);
-    avcodec_encoder_uinit_session(session);
+    err("%s(%d,%d), pkt alloc fail\n", __func__, idx, w->idx);
     return -EIO;
   }
-  session->codec_pkt = p;
+  w->codec_pkt = p;
 
-  ret = pthread_create(&session->encode_thread, NULL, avcodec_encode_thread, session);
-  if (ret < 0) {
-    err("%s(%d), thread create fail %d\n", __func__, idx, ret);
-    avcodec_encoder_uinit_session(session);
-    return ret;
+  return 0;
+}
+
+static int avcodec_encoder_init_session(struct st22_avcodec_encoder_session* session,
+                                        struct st22_encoder_create_req* req) {
+  int idx = session->idx;
+  int ret;
+
+  req->max_codestream_size = req->codestream_size;
+  /* one worker for each frame in flight, one frame at a time by default */
+  session->workers_cnt = req->max_frames_in_flight ? req->max_frames_in_flight : 1;
+  if (session->workers_cnt > MAX_ST22_AVCODEC_ENCODE_WORKERS)
+    session->workers_cnt = MAX_ST22_AVCODEC_ENCODE_WORKERS;
+  req->max_frames_in_flight = session->workers_cnt;
+  session->req = *req;
+
+  enum AVCodecID codec_id;
+  if (req->output_fmt == ST_FRAME_FMT_H265_CODESTREAM) {
+    codec_id = AV_CODEC_ID_H265;
+  } else if (req->output_fmt == ST_FRAME_FMT_H264_CODESTREAM) {
+    codec_id = AV_CODEC_ID_H264;
+  } else {
+    err("%s(%d), invalid codec stream fmt %d\n", __func__, idx, req->output_fmt);
+    return -EIO;
+  }
+  const AVCodec* codec = avcodec_find_encoder(codec_id);
+  if (!codec) {
+    err("%s(%d), codec %d create fail\n", __func__, idx, codec_id);
+    return -EIO;
+  }
+  if (req->input_fmt == ST_FRAME_FMT_YUV422PLANAR8) {
+    session->pix_fmt = AV_PIX_FMT_YUV422P;
+  } else if (req->input_fmt == ST_FRAME_FMT_YUV420PLANAR8) {
+    session->pix_fmt = AV_PIX_FMT_YUV420P;
+  } else {
+    err("%s(%d), invalid input fmt %d\n", __func__, idx, req->input_fmt);
+    return -EIO;
+  }
+
+  for (int i = 0; i < session->workers_cnt; i++) {
+    struct st22_avcodec_encode_worker* w = &session->workers[i];
+    w->idx = i;
+    w->session = session;
+    ret = avcodec_encoder_init_worker(session, w, codec, req);
+    if (ret < 0) {
+      avcodec_encoder_uinit_session(session);
+      return ret;
+    }
+  }
+
+  for (int i = 0; i < session->workers_cnt; i++) {
+    struct st22_avcodec_encode_worker* w = &session->workers[i];
+    ret = pthread_create(&w->encode_thread, NULL, avcodec_encode_thread, w);
+    if (ret < 0) {
+      err("%s(%d), thread %d create fail %d\n", __func__, idx, i, ret);
+      avcodec_encoder_uinit_session(session);
+      return ret;
+    }
   }
 
   return 0;
@@ -247,6 +294,7 @@ static st22_encode_priv avcodec_encoder_create_session(
     ret = avcodec_encoder_init_session(session, req);
     if (ret < 0) {
       err("%s(%d), init session fail %d\n", __func__, i, ret);
+      free(session);
       return NULL;
     }
 
@@ -254,8 +302,9 @@ static st22_encode_priv avcodec_encoder_create_session(
     ctx->encoder_sessions[i] = session;
     info("%s(%d), input fmt: %s, output fmt: %s\n", __func__, i,
          st_frame_fmt_name(req->input_fmt), st_frame_fmt_name(req->output_fmt));
-    info("%s(%d), max_codestream_size %" PRIu64 "\n", __func__, i,
-         session->req.max_codestream_size);
+    info("%s(%d), max_codestream_size %" PRIu64 ", frames in flight %u slices %u\n",
+         __func__, i, session->req.max_codestream_size, req->max_frames_in_flight,
+         req->slice_cnt);
     return session;
   }
 
@@ -267,8 +316,11 @@ static int avcodec_encoder_free_session(void* priv, st22_encode_priv session) {
   struct st22_avcodec_plugin_ctx* ctx = priv;
   struct st22_avcodec_encoder_session* encoder_session = session;
   int idx = encoder_session->idx;
+  int frame_cnt = 0;
 
-  info("%s(%d), total %d encode frames\n", __func__, idx, encoder_session->frame_cnt);
+  for (int i = 0; i < encoder_session->workers_cnt; i++)
+    frame_cnt += encoder_session->workers[i].frame_cnt;
+  info("%s(%d), total %d encode frames\n", __func__, idx, frame_cnt);
   avcodec_encoder_uinit_session(encoder_session);
 
   free(encoder_session);
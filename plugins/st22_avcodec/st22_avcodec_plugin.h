@@ -11,14 +11,15 @@
 
 #define MAX_ST22_AVCODEC_ENCODER_SESSIONS (8)
 #define MAX_ST22_AVCODEC_DECODER_SESSIONS (8)
+/* max frames in flight of one encoder session, one codec context for each */
+#define MAX_ST22_AVCODEC_ENCODE_WORKERS (4)
 
-struct st22_avcodec_encoder_session {
-  int idx;
-  enum AVPixelFormat pix_fmt;
+struct st22_avcodec_encoder_session;
 
-  struct st22_encoder_create_req req;
-  st22p_encode_session session_p;
-  bool stop;
+/* all frames are intra, the workers encode different frames in parallel */
+struct st22_avcodec_encode_worker {
+  int idx;
+  struct st22_avcodec_encoder_session* session;
   pthread_t encode_thread;
 
   int frame_cnt;
@@ -29,6 +30,18 @@ struct st22_avcodec_encoder_session {
   AVPacket* codec_pkt;
 };
 
+struct st22_avcodec_encoder_session {
+  int idx;
+  enum AVPixelFormat pix_fmt;
+
+  struct st22_encoder_create_req req;
+  st22p_encode_session session_p;
+  bool stop;
+
+  int workers_cnt;
+  struct st22_avcodec_encode_worker workers[MAX_ST22_AVCODEC_ENCODE_WORKERS];
+};
+
 struct st22_avcodec_decoder_session {
   int idx;
   enum AVPixelFormat pix_fmt;
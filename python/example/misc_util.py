@@ -178,6 +178,18 @@ def parse_args(is_tx):
         default=mtl.ST22_CODEC_JPEGXS,
         help="st22_codec",
     )
+    parser.add_argument(
+        "--st22_frames_in_flight",
+        type=int,
+        default=0,
+        help="max frames in the st22 encoder at the same time, 0 for plugin default",
+    )
+    parser.add_argument(
+        "--st22_slices",
+        type=int,
+        default=0,
+        help="slices of one frame to encode in parallel, 0 for plugin default",
+    )
     # pacing_way
     parser.add_argument(
         "--pacing_way",
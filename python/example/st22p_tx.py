@@ -51,13 +51,16 @@ def main():
     tx_para.height = args.height
     tx_para.fps = args.fps
     tx_para.interlaced = args.interlaced
-    tx_para.framebuff_cnt = 3
+    # the frames in the encoder plus one for app and one for transport
+    tx_para.framebuff_cnt = max(3, args.st22_frames_in_flight + 2)
     tx_para.input_fmt = args.pipeline_fmt
     tx_para.pack_type = mtl.ST22_PACK_CODESTREAM
     tx_para.codec = args.st22_codec
     tx_para.device = mtl.ST_PLUGIN_DEVICE_AUTO
     tx_para.quality = mtl.ST22_QUALITY_MODE_QUALITY
     tx_para.codec_thread_cnt = 2
+    tx_para.encode_frames_in_flight = args.st22_frames_in_flight
+    tx_para.encode_slice_cnt = args.st22_slices
     tx_para.codestream_size = tx_para.width * tx_para.height * bpp / 8
     if tx_para.interlaced:
         tx_para.codestream_size /= 2
@@ -0,0 +1,98 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "st2110/st_ancillary.h"
+#include "st40_api.h"
+
+/*
+ * The bulk udw pack/unpack of each simd level must give the same bytes, sum and parity
+ * errors as the scalar st40_set_udw/st40_get_udw of one word at a time.
+ */
+
+#define ST40_UDW_FUZZ_MAX_UDW 300
+#define ST40_UDW_FUZZ_BUF_SIZE 512
+
+static const enum mtl_simd_level st40_udw_fuzz_levels[] = {
+    MTL_SIMD_LEVEL_NONE,
+    MTL_SIMD_LEVEL_AVX2,
+    MTL_SIMD_LEVEL_AVX512,
+};
+
+#define ST40_UDW_FUZZ_LEVELS \
+  (sizeof(st40_udw_fuzz_levels) / sizeof(st40_udw_fuzz_levels[0]))
+
+static void st40_udw_fuzz_pack(uint32_t idx, const uint8_t* udw, uint32_t n,
+                               const uint8_t* init) {
+  uint8_t ref[ST40_UDW_FUZZ_BUF_SIZE], buf[ST40_UDW_FUZZ_BUF_SIZE];
+  uint16_t ref_sum = 0;
+
+  memcpy(ref, init, sizeof(ref));
+  for (uint32_t i = 0; i < n; i++) {
+    uint16_t word = st40_add_parity_bits(udw[i]);
+    st40_set_udw(idx + i, word, ref);
+    ref_sum += word;
+  }
+
+  for (size_t l = 0; l < ST40_UDW_FUZZ_LEVELS; l++) {
+    memcpy(buf, init, sizeof(buf));
+    uint16_t sum = st_anc_udw_pack_simd(idx, udw, n, buf, st40_udw_fuzz_levels[l]);
+    /* also the bits of the words around must stay */
+    if (sum != ref_sum || memcmp(buf, ref, sizeof(buf))) abort();
+  }
+}
+
+static void st40_udw_fuzz_unpack(uint32_t idx, const uint8_t* data, uint32_t n) {
+  uint8_t ref[ST40_UDW_FUZZ_MAX_UDW], out[ST40_UDW_FUZZ_MAX_UDW];
+  uint32_t ref_bad = 0;
+  uint16_t ref_sum = 0;
+
+  for (uint32_t i = 0; i < n; i++) {
+    uint16_t word = st40_get_udw(idx + i, data);
+    if (!st40_check_parity_bits(word)) ref_bad++;
+    ref[i] = (uint8_t)(word & 0xFF);
+    ref_sum += word;
+  }
+  /* the checksum from the sum, with the words before idx */
+  uint16_t head_sum = 0;
+  for (uint32_t i = 0; i < idx; i++) head_sum += st40_get_udw(i, data);
+  if (st40_checksum_from_sum(head_sum + ref_sum) != st40_calc_checksum(idx + n, data))
+    abort();
+
+  for (size_t l = 0; l < ST40_UDW_FUZZ_LEVELS; l++) {
+    enum mtl_simd_level level = st40_udw_fuzz_levels[l];
+    uint16_t sum = 0;
+    uint32_t bad = st_anc_udw_unpack_simd(idx, data, n, out, &sum, level);
+    if (bad != ref_bad || sum != ref_sum || memcmp(out, ref, n)) abort();
+    /* the check only way */
+    bad = st_anc_udw_unpack_simd(idx, data, n, NULL, &sum, level);
+    if (bad != ref_bad || sum != ref_sum) abort();
+  }
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  uint8_t buf[ST40_UDW_FUZZ_BUF_SIZE] = {0};
+  uint8_t udw[ST40_UDW_FUZZ_MAX_UDW] = {0};
+
+  if (!data || size < 4) return 0;
+
+  /* the first bytes pick the start word and the count, the rest is the data */
+  uint32_t idx = data[0] % 16;
+  uint32_t n = ((uint32_t)data[1] << 8 | data[2]) % (ST40_UDW_FUZZ_MAX_UDW + 1);
+  data += 3;
+  size -= 3;
+
+  size_t copy = size < sizeof(buf) ? size : sizeof(buf);
+  memcpy(buf, data, copy);
+  copy = size < sizeof(udw) ? size : sizeof(udw);
+  memcpy(udw, data, copy);
+
+  /* the unpack reads the bytes the words take only, 10 bits each */
+  if ((idx + n) * 10 / 8 + 2 > sizeof(buf)) n = (sizeof(buf) - 2) * 8 / 10 - idx;
+
+  st40_udw_fuzz_pack(idx, udw, n, buf);
+  st40_udw_fuzz_unpack(idx, buf, n);
+  return 0;
+}
@@ -0,0 +1,37 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include "core/test_fixture.hpp"
+
+/* Create and tear down a memif server/client pair in one instance, no NIC needed. */
+TEST_F(NoCtxTest, memif_pair_create_teardown) {
+  static const char* memif_ports[MTL_PORT_MAX] = {
+      "dpdk_memif:role=server,id=0,socket=/tmp/mtl_noctx_memif.sock",
+      "dpdk_memif:role=client,id=0,socket=/tmp/mtl_noctx_memif.sock",
+  };
+
+  ctx->para.num_ports = 2;
+  for (int i = 0; i < 2; i++) {
+    snprintf(ctx->para.port[i], sizeof(ctx->para.port[i]), "%s", memif_ports[i]);
+    ctx->para.pmd[i] = mtl_pmd_by_port_name(ctx->para.port[i]);
+    ASSERT_EQ(ctx->para.pmd[i], MTL_PMD_DPDK_MEMIF) << "port " << i;
+  }
+
+  ctx->para.ptp_get_time_fn = NoCtxTest::FakePtpClockNow;
+  ctx->handle = mtl_init(&ctx->para);
+  ASSERT_TRUE(ctx->handle != nullptr) << "mtl_init failed with the memif pair";
+
+  uint8_t ip[MTL_IP_ADDR_LEN], netmask[MTL_IP_ADDR_LEN], gateway[MTL_IP_ADDR_LEN];
+  for (int i = 0; i < 2; i++) {
+    EXPECT_EQ(mtl_port_ip_info(ctx->handle, (enum mtl_port)i, ip, netmask, gateway), 0);
+    EXPECT_EQ(memcmp(ip, ctx->para.sip_addr[i], MTL_IP_ADDR_LEN), 0) << "port " << i;
+  }
+
+  for (int i = 0; i < 2; i++) {
+    int ret = mtl_start(ctx->handle);
+    ASSERT_EQ(ret, 0) << "mtl_start failed with the memif pair";
+    ret = mtl_stop(ctx->handle);
+    ASSERT_EQ(ret, 0) << "mtl_stop failed with the memif pair";
+  }
+}
@@ -2,6 +2,7 @@
  * Copyright(c) 2022 Intel Corporation
  */
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <thread>
@@ -1701,3 +1702,185 @@ TEST(St22p, tx_drop_when_late) {
   ret = st22p_tx_free(tx_handle);
   EXPECT_GE(ret, 0);
 }
+
+#define ST22P_TEST_AVCODEC_PLUGIN \
+  "/usr/local/lib/x86_64-linux-gnu/libst_plugin_st22_avcodec.so"
+#define ST22P_TEST_ORDER_PATTERNS (8)
+
+/* flat luma per frame index, spaced wide enough to survive the lossy codec */
+static uint8_t st22p_order_luma(int idx) {
+  return 32 + (idx % ST22P_TEST_ORDER_PATTERNS) * 24;
+}
+
+static int st22p_order_index(struct st_frame* frame) {
+  const uint8_t* y = (const uint8_t*)frame->addr[0];
+  size_t y_size = (size_t)frame->linesize[0] * frame->height;
+  uint64_t sum = 0, cnt = 0;
+
+  for (size_t i = 0; i < y_size; i += 61) {
+    sum += y[i];
+    cnt++;
+  }
+  int idx = ((int)(sum / cnt) - 32 + 12) / 24;
+  return std::max(0, std::min(idx, ST22P_TEST_ORDER_PATTERNS - 1));
+}
+
+/*
+ * The avcodec plugin spreads the frames of one session over several encoder
+ * workers, each with its own codec context. The decoded output has to keep the
+ * frame order of the input, which only holds when every worker emits
+ * standalone intra frames.
+ */
+TEST(St22p, avcodec_frames_in_flight_order) {
+  auto ctx = (struct st_tests_context*)st_test_ctx();
+  auto st = ctx->handle;
+  int ret;
+  struct st22p_tx_ops ops_tx;
+  struct st22p_rx_ops ops_rx;
+  int width = 1280, height = 720;
+  enum st_fps fps = ST_FPS_P25;
+  enum st_frame_fmt fmt = ST_FRAME_FMT_YUV420PLANAR8;
+
+  if (ctx->para.num_ports < 2) {
+    info("%s, dual port should be enabled\n", __func__);
+    return;
+  }
+  ret = st_plugin_register(st, ST22P_TEST_AVCODEC_PLUGIN);
+  if (ret < 0) GTEST_SKIP() << "avcodec plugin not installed";
+
+  auto test_ctx_tx = new tests_context();
+  ASSERT_TRUE(test_ctx_tx != NULL);
+  test_ctx_tx->ctx = ctx;
+  test_ctx_tx->fb_cnt = 8;
+
+  memset(&ops_tx, 0, sizeof(ops_tx));
+  ops_tx.name = "st22p_order_tx";
+  ops_tx.priv = test_ctx_tx;
+  ops_tx.port.num_port = 1;
+  memcpy(ops_tx.port.dip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_R],
+         MTL_IP_ADDR_LEN);
+  snprintf(ops_tx.port.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_P]);
+  ops_tx.port.udp_port[MTL_SESSION_PORT_P] = ST22P_TEST_UDP_PORT;
+  ops_tx.port.payload_type = ST22P_TEST_PAYLOAD_TYPE;
+  ops_tx.width = width;
+  ops_tx.height = height;
+  ops_tx.fps = fps;
+  ops_tx.input_fmt = fmt;
+  ops_tx.pack_type = ST22_PACK_CODESTREAM;
+  ops_tx.codec = ST22_CODEC_H264;
+  ops_tx.device = ST_PLUGIN_DEVICE_CPU;
+  ops_tx.quality = ST22_QUALITY_MODE_SPEED;
+  ops_tx.framebuff_cnt = test_ctx_tx->fb_cnt;
+  ops_tx.codestream_size = st_frame_size(fmt, width, height, false) / 8;
+  ops_tx.encode_frames_in_flight = 4;
+  ops_tx.flags |= ST22P_TX_FLAG_BLOCK_GET;
+
+  auto tx_handle = st22p_tx_create(st, &ops_tx);
+  ASSERT_TRUE(tx_handle != NULL);
+  ret = st22p_tx_set_block_timeout(tx_handle, NS_PER_S);
+  EXPECT_EQ(ret, 0);
+  test_ctx_tx->handle = tx_handle;
+  test_ctx_tx->stop = false;
+
+  auto test_ctx_rx = new tests_context();
+  ASSERT_TRUE(test_ctx_rx != NULL);
+  test_ctx_rx->ctx = ctx;
+  test_ctx_rx->fb_cnt = 8;
+
+  memset(&ops_rx, 0, sizeof(ops_rx));
+  ops_rx.name = "st22p_order_rx";
+  ops_rx.priv = test_ctx_rx;
+  ops_rx.port.num_port = 1;
+  memcpy(ops_rx.port.ip_addr[MTL_SESSION_PORT_P], ctx->para.sip_addr[MTL_PORT_P],
+         MTL_IP_ADDR_LEN);
+  snprintf(ops_rx.port.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->para.port[MTL_PORT_R]);
+  ops_rx.port.udp_port[MTL_SESSION_PORT_P] = ST22P_TEST_UDP_PORT;
+  ops_rx.port.payload_type = ST22P_TEST_PAYLOAD_TYPE;
+  ops_rx.width = width;
+  ops_rx.height = height;
+  ops_rx.fps = fps;
+  ops_rx.output_fmt = fmt;
+  ops_rx.pack_type = ST22_PACK_CODESTREAM;
+  ops_rx.codec = ST22_CODEC_H264;
+  ops_rx.device = ST_PLUGIN_DEVICE_CPU;
+  ops_rx.framebuff_cnt = test_ctx_rx->fb_cnt;
+  ops_rx.flags |= ST22P_RX_FLAG_BLOCK_GET;
+
+  auto rx_handle = st22p_rx_create(st, &ops_rx);
+  ASSERT_TRUE(rx_handle != NULL);
+  ret = st22p_rx_set_block_timeout(rx_handle, NS_PER_S);
+  EXPECT_EQ(ret, 0);
+  test_ctx_rx->handle = rx_handle;
+  test_ctx_rx->stop = false;
+
+  auto tx_thread = std::thread(
+      [](tests_context* s) {
+        auto handle = (st22p_tx_handle)s->handle;
+        while (!s->stop) {
+          auto frame = st22p_tx_get_frame(handle);
+          if (!frame) continue;
+          size_t y_size = (size_t)frame->linesize[0] * frame->height;
+          size_t uv_size = (size_t)frame->linesize[1] * frame->height / 2;
+          memset(frame->addr[0], st22p_order_luma(s->fb_send), y_size);
+          memset(frame->addr[1], 128, uv_size);
+          memset(frame->addr[2], 128, uv_size);
+          st22p_tx_put_frame(handle, frame);
+          s->fb_send++;
+        }
+      },
+      test_ctx_tx);
+
+  std::atomic<int> out_of_order{0};
+  auto rx_thread = std::thread(
+      [&out_of_order](tests_context* s) {
+        auto handle = (st22p_rx_handle)s->handle;
+        int prev = -1;
+        while (!s->stop) {
+          auto frame = st22p_rx_get_frame(handle);
+          if (!frame) continue;
+          int idx = st22p_order_index(frame);
+          if (prev >= 0) {
+            /* frames may drop on the wire, but never step backwards */
+            int step = (idx - prev + ST22P_TEST_ORDER_PATTERNS);
+            step %= ST22P_TEST_ORDER_PATTERNS;
+            if (!step || step > ST22P_TEST_ORDER_PATTERNS / 2) {
+              dbg("%s, frame %d after %d\n", __func__, idx, prev);
+              out_of_order++;
+            }
+          }
+          prev = idx;
+          st22p_rx_put_frame(handle, frame);
+          s->fb_rec++;
+        }
+      },
+      test_ctx_rx);
+
+  ret = mtl_start(st);
+  EXPECT_GE(ret, 0);
+  sleep(5);
+
+  test_ctx_tx->stop = true;
+  st22p_tx_wake_block(tx_handle);
+  tx_thread.join();
+  test_ctx_rx->stop = true;
+  st22p_rx_wake_block(rx_handle);
+  rx_thread.join();
+
+  ret = mtl_stop(st);
+  EXPECT_GE(ret, 0);
+  info("%s, send %d rec %d out of order %d\n", __func__, test_ctx_tx->fb_send,
+       test_ctx_rx->fb_rec, out_of_order.load());
+  EXPECT_GT(test_ctx_rx->fb_rec, 0);
+  EXPECT_EQ(out_of_order.load(), 0);
+
+  ret = st22p_tx_free(tx_handle);
+  EXPECT_GE(ret, 0);
+  ret = st22p_rx_free(rx_handle);
+  EXPECT_GE(ret, 0);
+  st_plugin_unregister(st, ST22P_TEST_AVCODEC_PLUGIN);
+
+  delete test_ctx_tx;
+  delete test_ctx_rx;
+}
@@ -413,7 +413,8 @@ static void st30_tx_fps_test(enum st30_type type[], enum st30_sampling sample[],
 static void st30_rx_fps_test(enum st30_type type[], enum st30_sampling sample[],
                              enum st30_ptime ptime[], uint16_t channel[],
                              enum st30_fmt fmt[], enum st_test_level level,
-                             int sessions = 1, bool check_sha = false) {
+                             int sessions = 1, bool check_sha = false,
+                             bool jumbo = false) {
   auto ctx = (struct st_tests_context*)st_test_ctx();
   auto m_handle = ctx->handle;
   int ret;
@@ -488,6 +489,7 @@ static void st30_rx_fps_test(enum st30_type type[], enum st30_sampling sample[],
     ops_tx.get_next_frame = tx_audio_next_frame;
     ops_tx.notify_rtp_done = tx_rtp_done;
     ops_tx.rtp_ring_size = 1024;
+    if (jumbo) ops_tx.flags |= ST30_TX_FLAG_JUMBO_FRAME;
     test_ctx_tx[i]->pkt_data_len = ops_tx.framebuff_size;
     tx_handle[i] = st30_tx_create(m_handle, &ops_tx);
     ASSERT_TRUE(tx_handle[i] != NULL);
@@ -553,6 +555,7 @@ static void st30_rx_fps_test(enum st30_type type[], enum st30_sampling sample[],
     ops_rx.notify_frame_ready = st30_rx_frame_ready;
     ops_rx.notify_rtp_ready = rx_rtp_ready;
     ops_rx.rtp_ring_size = 1024;
+    if (jumbo) ops_rx.flags |= ST30_RX_FLAG_JUMBO_FRAME;
 
     double pkt_time_ns = st30_get_packet_time(ops_rx.ptime);
     if (pkt_time_ns > 0)
@@ -816,6 +819,70 @@ TEST(St30_rx, frame_digest_max_channel_96k_24bit_ptime_mix_s5) {
   st30_rx_fps_test(type, s, pt, c, f, ST_TEST_LEVEL_MANDATORY, 5, true);
 }
 
+static bool st30_test_kernel_socket(struct st_tests_context* ctx) {
+  for (int i = 0; i < ctx->para.num_ports; i++) {
+    if (ctx->para.pmd[i] != MTL_PMD_KERNEL_SOCKET) return false;
+  }
+  return true;
+}
+
+TEST(St30_tx, create_expect_fail_jumbo) {
+  auto ctx = (struct st_tests_context*)st_test_ctx();
+  auto m_handle = ctx->handle;
+  struct st30_tx_ops ops;
+
+  auto test_ctx = new tests_context();
+  ASSERT_TRUE(test_ctx != NULL);
+  test_ctx->idx = 0;
+  test_ctx->ctx = ctx;
+  test_ctx->fb_cnt = 3;
+  st30_tx_ops_init(test_ctx, &ops);
+  /* 6912 bytes, above the standard mtu */
+  ops.channel = 48;
+  ops.fmt = ST30_FMT_PCM24;
+  ops.framebuff_size =
+      st30_get_packet_size(ops.fmt, ops.ptime, ops.sampling, ops.channel);
+  st30_tx_handle handle = st30_tx_create(m_handle, &ops);
+  EXPECT_TRUE(handle == NULL);
+
+  ops.flags |= ST30_TX_FLAG_JUMBO_FRAME;
+  handle = st30_tx_create(m_handle, &ops);
+  if (st30_test_kernel_socket(ctx)) {
+    ASSERT_TRUE(handle != NULL);
+    EXPECT_GE(st30_tx_free(handle), 0);
+  } else {
+    /* the dpdk ports run with the standard mtu */
+    EXPECT_TRUE(handle == NULL);
+  }
+
+  /* 9216 bytes, above the jumbo mtu also */
+  ops.channel = 64;
+  ops.framebuff_size =
+      st30_get_packet_size(ops.fmt, ops.ptime, ops.sampling, ops.channel);
+  handle = st30_tx_create(m_handle, &ops);
+  EXPECT_TRUE(handle == NULL);
+  st30_tx_assert_cnt(0);
+  delete test_ctx;
+}
+
+TEST(St30_rx, frame_digest_jumbo_ptime_mix_s3) {
+  auto ctx = (struct st_tests_context*)st_test_ctx();
+  if (!st30_test_kernel_socket(ctx)) {
+    info("%s, skip as the jumbo frame is for kernel socket only, ex: kernel:lo\n",
+         __func__);
+    return;
+  }
+
+  enum st30_type type[3] = {ST30_TYPE_FRAME_LEVEL, ST30_TYPE_RTP_LEVEL,
+                            ST30_TYPE_FRAME_LEVEL};
+  enum st30_sampling s[3] = {ST30_SAMPLING_48K, ST30_SAMPLING_96K, ST30_SAMPLING_96K};
+  enum st30_ptime pt[3] = {ST30_PTIME_1MS, ST30_PTIME_1MS, ST30_PTIME_125US};
+  /* 8640, 6144 and 2304 bytes */
+  uint16_t c[3] = {60, 16, 64};
+  enum st30_fmt f[3] = {ST30_FMT_PCM24, ST31_FMT_AM824, ST30_FMT_PCM24};
+  st30_rx_fps_test(type, s, pt, c, f, ST_TEST_LEVEL_MANDATORY, 3, true, true);
+}
+
 static void st30_rx_update_src_test(enum st30_type type, int tx_sessions,
                                     enum st_test_level level) {
   auto ctx = (struct st_tests_context*)st_test_ctx();
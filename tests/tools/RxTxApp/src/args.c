@@ -157,6 +157,7 @@ enum st_args_cmd {
   ST_ARG_TX_USER_CLOCK_OFFSET,
   ST_ARG_AUTO_STOP,
   ST_ARG_RX_MAX_FILE_SIZE,
+  ST_ARG_TX_TXTIME_EMULATE,
   ST_ARG_MAX,
 };
 
@@ -311,6 +312,7 @@ static struct option st_app_args_options[] = {
     {"timestamp_epoch", no_argument, 0, ST_ARG_TIMESTAMP_EPOCH},
     {"auto_stop", no_argument, 0, ST_ARG_AUTO_STOP},
     {"rx_max_file_size", required_argument, 0, ST_ARG_RX_MAX_FILE_SIZE},
+    {"tx_txtime_emulate", no_argument, 0, ST_ARG_TX_TXTIME_EMULATE},
 
     {0, 0, 0, 0}};
 
@@ -870,6 +872,9 @@ int st_app_parse_args(struct st_app_context* ctx, struct mtl_init_params* p, int
       case ST_ARG_TX_NO_BURST_CHECK:
         p->flags |= MTL_FLAG_TX_NO_BURST_CHK;
         break;
+      case ST_ARG_TX_TXTIME_EMULATE:
+        p->flags |= MTL_FLAG_TX_TXTIME_EMULATE;
+        break;
       case ST_ARG_MULTI_SRC_PORT:
         p->flags |= MTL_FLAG_MULTI_SRC_PORT;
         break;
@@ -0,0 +1,309 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness for the kernel socket datapath unit tests, sendmmsg is mocked to
+ * capture the SO_TXTIME control messages and ioctl to emulate the hw timestamp
+ * config of the interface.
+ */
+
+/* mt_main.h defines _GNU_SOURCE, but the system headers come first here;
+ * define it so struct mmsghdr / sendmmsg are exposed to mt_dp_socket.c. */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <time.h>
+
+#undef MTL_HAS_USDT
+#include "common/ut_common.h"
+#include "datapath/mt_dp_socket_harness.h"
+
+static int ut_sendmmsg(int fd, struct mmsghdr* msgvec, unsigned int vlen, int flags);
+static int ut_ioctl(int fd, unsigned long request, void* arg);
+
+#define sendmmsg ut_sendmmsg
+#define ioctl ut_ioctl
+#include "datapath/mt_dp_socket.c"
+#undef ioctl
+#undef sendmmsg
+
+#define UT_DPS_MAX_PKTS (128)
+#define UT_DPS_MAX_CALLS (16)
+#define UT_DPS_PAYLOAD (256)
+#define UT_DPS_RX_ENTRIES (4)
+
+struct ut_dps_ctx {
+  struct mtl_main_impl impl;
+  struct mt_tx_socket_entry entry;
+  struct mt_tx_socket_thread thread;
+  uint64_t ptp_ns;
+  int send_limit;
+
+  int calls;
+  int call_vlen[UT_DPS_MAX_CALLS];
+  int sent;
+  bool sent_has_txtime[UT_DPS_MAX_PKTS];
+  uint64_t sent_txtime[UT_DPS_MAX_PKTS];
+
+  /* the hw timestamp config of the emulated interface */
+  struct mt_rx_socket_entry rx_entries[UT_DPS_RX_ENTRIES];
+  struct hwtstamp_config nic_cfg;
+  int set_hwtstamp_calls;
+  int set_hwtstamp_error;
+};
+
+static struct ut_dps_ctx* ut_active_ctx;
+static int ut_dps_dynfield_offset = -1;
+static uint64_t ut_dps_dynflag;
+
+static uint64_t ut_dps_ptp_time(struct mtl_main_impl* impl, enum mtl_port port) {
+  (void)impl;
+  (void)port;
+  return ut_active_ctx->ptp_ns;
+}
+
+static int ut_sendmmsg(int fd, struct mmsghdr* msgvec, unsigned int vlen, int flags) {
+  struct ut_dps_ctx* ctx = ut_active_ctx;
+  (void)fd;
+  (void)flags;
+
+  if (ctx->calls < UT_DPS_MAX_CALLS) ctx->call_vlen[ctx->calls] = vlen;
+  ctx->calls++;
+
+  int accept = vlen;
+  if (ctx->send_limit >= 0 && accept > ctx->send_limit) accept = ctx->send_limit;
+  if (!accept) {
+    errno = EAGAIN;
+    return -1;
+  }
+
+  for (int i = 0; i < accept && ctx->sent < UT_DPS_MAX_PKTS; i++) {
+    struct msghdr* msg = &msgvec[i].msg_hdr;
+    struct cmsghdr* cmsg = msg->msg_control ? CMSG_FIRSTHDR(msg) : NULL;
+    int idx = ctx->sent++;
+
+    msgvec[i].msg_len = msg->msg_iov[0].iov_len;
+    if (cmsg && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TXTIME) {
+      ctx->sent_has_txtime[idx] = true;
+      memcpy(&ctx->sent_txtime[idx], CMSG_DATA(cmsg), sizeof(uint64_t));
+    }
+  }
+  return accept;
+}
+
+static int ut_ioctl(int fd, unsigned long request, void* arg) {
+  struct ut_dps_ctx* ctx = ut_active_ctx;
+  struct ifreq* ifr = arg;
+  struct hwtstamp_config* cfg = (struct hwtstamp_config*)ifr->ifr_data;
+  (void)fd;
+
+  if (request == SIOCGHWTSTAMP) {
+    *cfg = ctx->nic_cfg;
+    return 0;
+  }
+  if (request == SIOCSHWTSTAMP) {
+    ctx->set_hwtstamp_calls++;
+    if (ctx->set_hwtstamp_error) {
+      errno = ctx->set_hwtstamp_error;
+      return -1;
+    }
+    ctx->nic_cfg = *cfg;
+    return 0;
+  }
+  errno = EINVAL;
+  return -1;
+}
+
+int ut_dps_init(void) {
+  static const struct rte_mbuf_dynfield field = {
+      .name = "ut_dps_launch_time",
+      .size = sizeof(uint64_t),
+      .align = __alignof__(uint64_t),
+  };
+  static const struct rte_mbuf_dynflag flag = {
+      .name = "ut_dps_launch_time_flag",
+  };
+
+  if (ut_eal_init() < 0) return -1;
+  if (ut_dps_dynfield_offset < 0) {
+    ut_dps_dynfield_offset = rte_mbuf_dynfield_register(&field);
+    if (ut_dps_dynfield_offset < 0) return -1;
+    int bit = rte_mbuf_dynflag_register(&flag);
+    if (bit < 0) return -1;
+    ut_dps_dynflag = RTE_BIT64(bit);
+  }
+  return 0;
+}
+
+ut_dps_ctx* ut_dps_create_ctx(bool emulate) {
+  struct ut_dps_ctx* ctx = calloc(1, sizeof(*ctx));
+  if (!ctx) return NULL;
+
+  struct mt_interface* inf = mt_if(&ctx->impl, MTL_PORT_P);
+  inf->ptp_get_time_fn = ut_dps_ptp_time;
+  inf->tx_dynfield_offset = ut_dps_dynfield_offset;
+  inf->tx_launch_time_flag = ut_dps_dynflag;
+
+  ctx->entry.parent = &ctx->impl;
+  ctx->entry.port = MTL_PORT_P;
+  ctx->entry.txtime = true;
+  ctx->entry.txtime_emulate = emulate;
+  ctx->thread.parent = &ctx->entry;
+  ctx->thread.fd = -1;
+  ctx->send_limit = -1;
+  ctx->ptp_ns = 1000ull * NS_PER_S;
+
+  snprintf(ctx->impl.kport_info.kernel_if[MTL_PORT_P],
+           sizeof(ctx->impl.kport_info.kernel_if[MTL_PORT_P]), "ut_eth0");
+  pthread_mutex_init(&inf->hwtstamp_mutex, NULL);
+  for (int i = 0; i < UT_DPS_RX_ENTRIES; i++) {
+    ctx->rx_entries[i].parent = &ctx->impl;
+    ctx->rx_entries[i].port = MTL_PORT_P;
+    ctx->rx_entries[i].fd = -1;
+  }
+
+  ut_active_ctx = ctx;
+  return ctx;
+}
+
+void ut_dps_destroy_ctx(ut_dps_ctx* ctx) {
+  if (!ctx) return;
+  if (ut_active_ctx == ctx) ut_active_ctx = NULL;
+  pthread_mutex_destroy(&mt_if(&ctx->impl, MTL_PORT_P)->hwtstamp_mutex);
+  free(ctx);
+}
+
+void ut_dps_set_ptp_time(ut_dps_ctx* ctx, uint64_t ptp_ns) {
+  ctx->ptp_ns = ptp_ns;
+}
+
+void ut_dps_set_send_limit(ut_dps_ctx* ctx, int limit) {
+  ctx->send_limit = limit;
+}
+
+static struct rte_mbuf* ut_dps_build_pkt(uint64_t launch_ns) {
+  struct rte_mbuf* m = rte_pktmbuf_alloc(ut_pool());
+  if (!m) return NULL;
+
+  struct mt_udp_hdr* hdr =
+      (struct mt_udp_hdr*)rte_pktmbuf_append(m, sizeof(*hdr) + UT_DPS_PAYLOAD);
+  if (!hdr) {
+    rte_pktmbuf_free(m);
+    return NULL;
+  }
+  memset(hdr, 0, sizeof(*hdr) + UT_DPS_PAYLOAD);
+  hdr->eth.ether_type = htons(RTE_ETHER_TYPE_IPV4);
+  hdr->ipv4.dst_addr = htonl(RTE_IPV4(239, 0, 0, 1));
+  hdr->udp.dst_port = htons(20000);
+
+  if (launch_ns) {
+    m->ol_flags |= ut_dps_dynflag;
+    *RTE_MBUF_DYNFIELD(m, ut_dps_dynfield_offset, uint64_t*) = launch_ns;
+  }
+  return m;
+}
+
+int ut_dps_send_burst(ut_dps_ctx* ctx, const uint64_t* launch_ns, int nb) {
+  struct rte_mbuf* pkts[UT_DPS_MAX_PKTS];
+  int tx;
+
+  if (nb > UT_DPS_MAX_PKTS) return -EINVAL;
+  for (int i = 0; i < nb; i++) {
+    pkts[i] = ut_dps_build_pkt(launch_ns ? launch_ns[i] : 0);
+    if (!pkts[i]) {
+      rte_pktmbuf_free_bulk(pkts, i);
+      return -ENOMEM;
+    }
+  }
+
+  ut_active_ctx = ctx;
+  tx = tx_socket_send_mbuf_txtime(&ctx->thread, pkts, nb);
+  rte_pktmbuf_free_bulk(pkts, nb);
+  return tx;
+}
+
+int ut_dps_sendmmsg_calls(const ut_dps_ctx* ctx) {
+  return ctx->calls;
+}
+
+int ut_dps_sendmmsg_vlen(const ut_dps_ctx* ctx, int call) {
+  if (call < 0 || call >= ctx->calls || call >= UT_DPS_MAX_CALLS) return -1;
+  return ctx->call_vlen[call];
+}
+
+int ut_dps_sent_count(const ut_dps_ctx* ctx) {
+  return ctx->sent;
+}
+
+bool ut_dps_sent_txtime(const ut_dps_ctx* ctx, int idx, uint64_t* txtime) {
+  if (idx < 0 || idx >= ctx->sent || !ctx->sent_has_txtime[idx]) return false;
+  *txtime = ctx->sent_txtime[idx];
+  return true;
+}
+
+uint64_t ut_dps_stat_txtime(const ut_dps_ctx* ctx) {
+  return ctx->thread.stat_tx_txtime;
+}
+
+uint64_t ut_dps_stat_txtime_wait(const ut_dps_ctx* ctx) {
+  return ctx->thread.stat_tx_txtime_wait;
+}
+
+static uint64_t ut_dps_mono_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * NS_PER_S + ts.tv_nsec;
+}
+
+uint64_t ut_dps_emulate_wait(ut_dps_ctx* ctx, uint64_t launch_ns) {
+  struct rte_mbuf* m = ut_dps_build_pkt(launch_ns);
+  if (!m) return 0;
+
+  ut_active_ctx = ctx;
+  uint64_t start = ut_dps_mono_ns();
+  tx_socket_txtime_emulate_wait(&ctx->thread, m);
+  uint64_t elapsed = ut_dps_mono_ns() - start;
+  rte_pktmbuf_free(m);
+  return elapsed;
+}
+
+void ut_dps_set_nic_hwtstamp(ut_dps_ctx* ctx, int rx_filter, int tx_type) {
+  ctx->nic_cfg.rx_filter = rx_filter;
+  ctx->nic_cfg.tx_type = tx_type;
+}
+
+void ut_dps_fail_set_hwtstamp(ut_dps_ctx* ctx, int error) {
+  ctx->set_hwtstamp_error = error;
+}
+
+int ut_dps_nic_rx_filter(const ut_dps_ctx* ctx) {
+  return ctx->nic_cfg.rx_filter;
+}
+
+int ut_dps_nic_tx_type(const ut_dps_ctx* ctx) {
+  return ctx->nic_cfg.tx_type;
+}
+
+int ut_dps_set_hwtstamp_calls(const ut_dps_ctx* ctx) {
+  return ctx->set_hwtstamp_calls;
+}
+
+int ut_dps_hwtstamp_users(const ut_dps_ctx* ctx) {
+  return ctx->impl.inf[MTL_PORT_P].hwtstamp_users;
+}
+
+int ut_dps_rx_hwtstamp_get(ut_dps_ctx* ctx, int entry) {
+  if (entry < 0 || entry >= UT_DPS_RX_ENTRIES) return -EINVAL;
+  ut_active_ctx = ctx;
+  return rx_socket_init_hw_timestamp(&ctx->rx_entries[entry], 100 + entry);
+}
+
+void ut_dps_rx_hwtstamp_put(ut_dps_ctx* ctx, int entry) {
+  if (entry < 0 || entry >= UT_DPS_RX_ENTRIES) return;
+  ut_active_ctx = ctx;
+  rx_socket_uinit_hw_timestamp(&ctx->rx_entries[entry], 100 + entry);
+}
@@ -0,0 +1,49 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef TESTS_UNIT_DATAPATH_MT_DP_SOCKET_HARNESS_H
+#define TESTS_UNIT_DATAPATH_MT_DP_SOCKET_HARNESS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ut_dps_ctx ut_dps_ctx;
+
+int ut_dps_init(void);
+ut_dps_ctx* ut_dps_create_ctx(bool emulate);
+void ut_dps_destroy_ctx(ut_dps_ctx* ctx);
+void ut_dps_set_ptp_time(ut_dps_ctx* ctx, uint64_t ptp_ns);
+/* max msgs accepted by one sendmmsg call, -1 for no limit */
+void ut_dps_set_send_limit(ut_dps_ctx* ctx, int limit);
+/* build nb pkts with the launch time (0 for none) and send them in one burst */
+int ut_dps_send_burst(ut_dps_ctx* ctx, const uint64_t* launch_ns, int nb);
+int ut_dps_sendmmsg_calls(const ut_dps_ctx* ctx);
+int ut_dps_sendmmsg_vlen(const ut_dps_ctx* ctx, int call);
+int ut_dps_sent_count(const ut_dps_ctx* ctx);
+bool ut_dps_sent_txtime(const ut_dps_ctx* ctx, int idx, uint64_t* txtime);
+uint64_t ut_dps_stat_txtime(const ut_dps_ctx* ctx);
+uint64_t ut_dps_stat_txtime_wait(const ut_dps_ctx* ctx);
+/* run the emulate wait for one pkt with the launch time, return the elapsed ns */
+uint64_t ut_dps_emulate_wait(ut_dps_ctx* ctx, uint64_t launch_ns);
+
+/* the SIOCGHWTSTAMP/SIOCSHWTSTAMP config of the emulated interface */
+void ut_dps_set_nic_hwtstamp(ut_dps_ctx* ctx, int rx_filter, int tx_type);
+void ut_dps_fail_set_hwtstamp(ut_dps_ctx* ctx, int error);
+int ut_dps_nic_rx_filter(const ut_dps_ctx* ctx);
+int ut_dps_nic_tx_type(const ut_dps_ctx* ctx);
+int ut_dps_set_hwtstamp_calls(const ut_dps_ctx* ctx);
+int ut_dps_hwtstamp_users(const ut_dps_ctx* ctx);
+/* the hw timestamp init/uinit of one rx socket entry of the interface */
+int ut_dps_rx_hwtstamp_get(ut_dps_ctx* ctx, int entry);
+void ut_dps_rx_hwtstamp_put(ut_dps_ctx* ctx, int entry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_UNIT_DATAPATH_MT_DP_SOCKET_HARNESS_H */
@@ -0,0 +1,96 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * Kernel socket rx hw timestamp: the rx filter of the interface is shared by all
+ * the rx sockets, the first one enables it and the last one restores it.
+ *
+ * Build: meson setup build_unit -Denable_unit_tests=true && ninja -C build_unit
+ * Run:   ./build_unit/tests/unit/UnitTest --gtest_filter='MtDpSocketHwtstampTest.*'
+ */
+
+#include <gtest/gtest.h>
+#include <linux/net_tstamp.h>
+
+#include <cerrno>
+
+#include "datapath/mt_dp_socket_harness.h"
+
+class MtDpSocketHwtstampTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_EQ(ut_dps_init(), 0) << "EAL init failed";
+    ctx_ = ut_dps_create_ctx(false);
+    ASSERT_NE(ctx_, nullptr);
+  }
+
+  void TearDown() override {
+    ut_dps_destroy_ctx(ctx_);
+    ctx_ = nullptr;
+  }
+
+  ut_dps_ctx* ctx_ = nullptr;
+};
+
+TEST_F(MtDpSocketHwtstampTest, RestoredByLastUser) {
+  ut_dps_set_nic_hwtstamp(ctx_, HWTSTAMP_FILTER_NONE, HWTSTAMP_TX_OFF);
+
+  ASSERT_GE(ut_dps_rx_hwtstamp_get(ctx_, 0), 0);
+  EXPECT_EQ(ut_dps_nic_rx_filter(ctx_), HWTSTAMP_FILTER_ALL);
+  ASSERT_GE(ut_dps_rx_hwtstamp_get(ctx_, 1), 0);
+  EXPECT_EQ(ut_dps_set_hwtstamp_calls(ctx_), 1);
+  EXPECT_EQ(ut_dps_hwtstamp_users(ctx_), 2);
+
+  /* ptp4l turns on the tx timestamp while the sessions are running */
+  ut_dps_set_nic_hwtstamp(ctx_, HWTSTAMP_FILTER_ALL, HWTSTAMP_TX_ON);
+
+  ut_dps_rx_hwtstamp_put(ctx_, 0);
+  EXPECT_EQ(ut_dps_nic_rx_filter(ctx_), HWTSTAMP_FILTER_ALL);
+  EXPECT_EQ(ut_dps_set_hwtstamp_calls(ctx_), 1);
+
+  ut_dps_rx_hwtstamp_put(ctx_, 1);
+  EXPECT_EQ(ut_dps_hwtstamp_users(ctx_), 0);
+  EXPECT_EQ(ut_dps_set_hwtstamp_calls(ctx_), 2);
+  EXPECT_EQ(ut_dps_nic_rx_filter(ctx_), HWTSTAMP_FILTER_NONE);
+  EXPECT_EQ(ut_dps_nic_tx_type(ctx_), HWTSTAMP_TX_ON);
+
+  /* a double put is a no-op */
+  ut_dps_rx_hwtstamp_put(ctx_, 1);
+  EXPECT_EQ(ut_dps_hwtstamp_users(ctx_), 0);
+  EXPECT_EQ(ut_dps_set_hwtstamp_calls(ctx_), 2);
+}
+
+TEST_F(MtDpSocketHwtstampTest, AlreadyEnabledNotTouched) {
+  ut_dps_set_nic_hwtstamp(ctx_, HWTSTAMP_FILTER_ALL, HWTSTAMP_TX_ON);
+
+  ASSERT_GE(ut_dps_rx_hwtstamp_get(ctx_, 0), 0);
+  ut_dps_rx_hwtstamp_put(ctx_, 0);
+  EXPECT_EQ(ut_dps_set_hwtstamp_calls(ctx_), 0);
+  EXPECT_EQ(ut_dps_nic_rx_filter(ctx_), HWTSTAMP_FILTER_ALL);
+}
+
+TEST_F(MtDpSocketHwtstampTest, ReenableAfterRestore) {
+  ut_dps_set_nic_hwtstamp(ctx_, HWTSTAMP_FILTER_PTP_V2_EVENT, HWTSTAMP_TX_ON);
+
+  ASSERT_GE(ut_dps_rx_hwtstamp_get(ctx_, 0), 0);
+  ut_dps_rx_hwtstamp_put(ctx_, 0);
+  EXPECT_EQ(ut_dps_nic_rx_filter(ctx_), HWTSTAMP_FILTER_PTP_V2_EVENT);
+
+  ASSERT_GE(ut_dps_rx_hwtstamp_get(ctx_, 1), 0);
+  EXPECT_EQ(ut_dps_nic_rx_filter(ctx_), HWTSTAMP_FILTER_ALL);
+  ut_dps_rx_hwtstamp_put(ctx_, 1);
+  EXPECT_EQ(ut_dps_nic_rx_filter(ctx_), HWTSTAMP_FILTER_PTP_V2_EVENT);
+  EXPECT_EQ(ut_dps_set_hwtstamp_calls(ctx_), 4);
+}
+
+TEST_F(MtDpSocketHwtstampTest, SetFailNoUser) {
+  ut_dps_set_nic_hwtstamp(ctx_, HWTSTAMP_FILTER_NONE, HWTSTAMP_TX_OFF);
+  ut_dps_fail_set_hwtstamp(ctx_, EPERM);
+
+  EXPECT_LT(ut_dps_rx_hwtstamp_get(ctx_, 0), 0);
+  EXPECT_EQ(ut_dps_hwtstamp_users(ctx_), 0);
+  EXPECT_EQ(ut_dps_nic_rx_filter(ctx_), HWTSTAMP_FILTER_NONE);
+
+  ut_dps_rx_hwtstamp_put(ctx_, 0);
+  EXPECT_EQ(ut_dps_hwtstamp_users(ctx_), 0);
+  EXPECT_EQ(ut_dps_set_hwtstamp_calls(ctx_), 1);
+}
@@ -0,0 +1,164 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * Kernel socket tx with SO_TXTIME: the launch time is carried to the kernel in a
+ * SCM_TXTIME cmsg per pkt, or held by the tx thread in the emulate mode.
+ *
+ * Build: meson setup build_unit -Denable_unit_tests=true && ninja -C build_unit
+ * Run:   ./build_unit/tests/unit/UnitTest --gtest_filter='MtDpSocketTxtimeTest.*'
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "datapath/mt_dp_socket_harness.h"
+
+class MtDpSocketTxtimeTest : public ::testing::Test {
+ protected:
+  static constexpr uint64_t kPtp = 1000ull * 1000 * 1000 * 1000;
+  static constexpr uint64_t kSpacing = 20 * 1000; /* 20us */
+
+  void SetUp() override {
+    ASSERT_EQ(ut_dps_init(), 0) << "EAL init failed";
+  }
+
+  void TearDown() override {
+    ut_dps_destroy_ctx(ctx_);
+    ctx_ = nullptr;
+  }
+
+  void create(bool emulate) {
+    ctx_ = ut_dps_create_ctx(emulate);
+    ASSERT_NE(ctx_, nullptr);
+    ut_dps_set_ptp_time(ctx_, kPtp);
+  }
+
+  std::vector<uint64_t> paced(int nb, uint64_t first) {
+    std::vector<uint64_t> launch(nb);
+    for (int i = 0; i < nb; i++) launch[i] = first + i * kSpacing;
+    return launch;
+  }
+
+  ut_dps_ctx* ctx_ = nullptr;
+};
+
+/* Each pkt carries its own txtime, the spacing of the launch times is kept. */
+TEST_F(MtDpSocketTxtimeTest, CmsgCarriesLaunchTimeSpacing) {
+  create(false);
+  auto launch = paced(8, kPtp + 100 * 1000);
+
+  EXPECT_EQ(ut_dps_send_burst(ctx_, launch.data(), 8), 8);
+  ASSERT_EQ(ut_dps_sendmmsg_calls(ctx_), 1);
+  EXPECT_EQ(ut_dps_sendmmsg_vlen(ctx_, 0), 8);
+  EXPECT_EQ(ut_dps_stat_txtime(ctx_), 8u);
+
+  uint64_t first = 0, txtime = 0;
+  ASSERT_TRUE(ut_dps_sent_txtime(ctx_, 0, &first));
+  for (int i = 1; i < 8; i++) {
+    ASSERT_TRUE(ut_dps_sent_txtime(ctx_, i, &txtime)) << "pkt " << i;
+    EXPECT_EQ(txtime - first, launch[i] - launch[0]) << "pkt " << i;
+  }
+}
+
+/* A pkt without the launch time goes out without the cmsg. */
+TEST_F(MtDpSocketTxtimeTest, NoLaunchTimeNoCmsg) {
+  create(false);
+  uint64_t launch[2] = {0, kPtp + kSpacing};
+  uint64_t txtime = 0;
+
+  EXPECT_EQ(ut_dps_send_burst(ctx_, launch, 2), 2);
+  EXPECT_FALSE(ut_dps_sent_txtime(ctx_, 0, &txtime));
+  EXPECT_TRUE(ut_dps_sent_txtime(ctx_, 1, &txtime));
+  EXPECT_EQ(ut_dps_stat_txtime(ctx_), 1u);
+}
+
+/* A partial sendmmsg stops the burst, the busy socket is not retried. */
+TEST_F(MtDpSocketTxtimeTest, PartialSendStopsBurst) {
+  create(false);
+  auto launch = paced(16, kPtp + kSpacing);
+
+  ut_dps_set_send_limit(ctx_, 5);
+  EXPECT_EQ(ut_dps_send_burst(ctx_, launch.data(), 16), 5);
+  EXPECT_EQ(ut_dps_sendmmsg_calls(ctx_), 1);
+  EXPECT_EQ(ut_dps_sent_count(ctx_), 5);
+}
+
+/* A busy socket sends nothing. */
+TEST_F(MtDpSocketTxtimeTest, BusySocketSendsNothing) {
+  create(false);
+  auto launch = paced(4, kPtp + kSpacing);
+
+  ut_dps_set_send_limit(ctx_, 0);
+  EXPECT_EQ(ut_dps_send_burst(ctx_, launch.data(), 4), 0);
+  EXPECT_EQ(ut_dps_sendmmsg_calls(ctx_), 1);
+}
+
+/* A burst larger than the msg array is split in full batches. */
+TEST_F(MtDpSocketTxtimeTest, LargeBurstSpansBatches) {
+  create(false);
+  auto launch = paced(70, kPtp + kSpacing);
+
+  EXPECT_EQ(ut_dps_send_burst(ctx_, launch.data(), 70), 70);
+  ASSERT_EQ(ut_dps_sendmmsg_calls(ctx_), 3);
+  EXPECT_EQ(ut_dps_sendmmsg_vlen(ctx_, 0), 32);
+  EXPECT_EQ(ut_dps_sendmmsg_vlen(ctx_, 1), 32);
+  EXPECT_EQ(ut_dps_sendmmsg_vlen(ctx_, 2), 6);
+
+  uint64_t first = 0, last = 0;
+  ASSERT_TRUE(ut_dps_sent_txtime(ctx_, 0, &first));
+  ASSERT_TRUE(ut_dps_sent_txtime(ctx_, 69, &last));
+  EXPECT_EQ(last - first, 69 * kSpacing);
+}
+
+/* Emulate: the due pkts go out without the cmsg, the first future pkt stops the burst. */
+TEST_F(MtDpSocketTxtimeTest, EmulateHoldsFuturePkt) {
+  create(true);
+  uint64_t launch[4] = {kPtp - kSpacing, kPtp, kPtp + kSpacing, kPtp + 2 * kSpacing};
+  uint64_t txtime = 0;
+
+  EXPECT_EQ(ut_dps_send_burst(ctx_, launch, 4), 2);
+  EXPECT_EQ(ut_dps_sendmmsg_calls(ctx_), 1);
+  EXPECT_EQ(ut_dps_sendmmsg_vlen(ctx_, 0), 2);
+  EXPECT_FALSE(ut_dps_sent_txtime(ctx_, 0, &txtime));
+  EXPECT_EQ(ut_dps_stat_txtime(ctx_), 0u);
+  EXPECT_EQ(ut_dps_stat_txtime_wait(ctx_), 1u);
+}
+
+/* Emulate: the first pkt in the future sends nothing and no sendmmsg is issued. */
+TEST_F(MtDpSocketTxtimeTest, EmulateNothingDue) {
+  create(true);
+  uint64_t launch[1] = {kPtp + kSpacing};
+
+  EXPECT_EQ(ut_dps_send_burst(ctx_, launch, 1), 0);
+  EXPECT_EQ(ut_dps_sendmmsg_calls(ctx_), 0);
+  EXPECT_EQ(ut_dps_stat_txtime_wait(ctx_), 1u);
+}
+
+/* Emulate wait: no sleep once the launch time is reached. */
+TEST_F(MtDpSocketTxtimeTest, EmulateWaitReturnsWhenDue) {
+  create(true);
+  EXPECT_LT(ut_dps_emulate_wait(ctx_, kPtp), 500u * 1000);
+  EXPECT_LT(ut_dps_emulate_wait(ctx_, kPtp - kSpacing), 500u * 1000);
+}
+
+/* Emulate wait: the thread sleeps till the launch time instead of the busy retry. */
+TEST_F(MtDpSocketTxtimeTest, EmulateWaitSleepsTillLaunch) {
+  create(true);
+  uint64_t wait = 300 * 1000; /* 300us */
+  EXPECT_GE(ut_dps_emulate_wait(ctx_, kPtp + wait), wait);
+}
+
+/* Emulate wait: a far launch time is cut so the thread still sees the stop. */
+TEST_F(MtDpSocketTxtimeTest, EmulateWaitIsBounded) {
+  create(true);
+  uint64_t far = 2ull * 1000 * 1000 * 1000; /* 2s */
+  EXPECT_LT(ut_dps_emulate_wait(ctx_, kPtp + far), far / 4);
+}
+
+/* Not emulate: the kernel holds the pkt, the thread never sleeps. */
+TEST_F(MtDpSocketTxtimeTest, NoWaitWithoutEmulate) {
+  create(false);
+  uint64_t far = 2ull * 1000 * 1000 * 1000;
+  EXPECT_LT(ut_dps_emulate_wait(ctx_, kPtp + far), far / 4);
+}
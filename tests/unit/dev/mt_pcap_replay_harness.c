@@ -0,0 +1,70 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness for the pcap replay parser unit tests, the crafted capture is
+ * used as the file map so no file or mbuf pool is needed.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#undef MTL_HAS_USDT
+#include "common/ut_common.h"
+#include "dev/mt_pcap_replay.c"
+#include "dev/mt_pcap_replay_harness.h"
+
+struct ut_pcap_ctx {
+  struct mt_pcap_replay_impl replay;
+};
+
+ut_pcap_ctx* ut_pcap_create_ctx(const uint8_t* data, size_t len) {
+  struct ut_pcap_ctx* ctx = calloc(1, sizeof(*ctx));
+  if (!ctx) return NULL;
+
+  ctx->replay.port = MTL_PORT_P;
+  ctx->replay.fd = -1;
+  ctx->replay.file = "ut_capture";
+  ctx->replay.map = (uint8_t*)data;
+  ctx->replay.map_size = len;
+  return ctx;
+}
+
+void ut_pcap_destroy_ctx(ut_pcap_ctx* ctx) {
+  free(ctx);
+}
+
+int ut_pcap_parse_hdr(ut_pcap_ctx* ctx) {
+  struct mt_pcap_replay_impl* replay = &ctx->replay;
+  int ret;
+
+  ret = replay_parse_pcap_hdr(replay);
+  if (ret == -EINVAL) ret = replay_parse_pcapng_hdr(replay);
+  if (ret < 0) return ret;
+  replay->offset = replay->first_rec;
+  return 0;
+}
+
+int ut_pcap_next(ut_pcap_ctx* ctx, const uint8_t** pkt, uint32_t* len, uint64_t* ts_ns) {
+  struct mt_pcap_replay_impl* replay = &ctx->replay;
+  struct mt_pcap_replay_rec rec;
+
+  int ret = replay_peek(replay, &rec);
+  if (ret < 0) return ret;
+  replay->offset = rec.next;
+  *pkt = rec.pkt;
+  *len = rec.len;
+  *ts_ns = rec.ts_ns;
+  return 0;
+}
+
+bool ut_pcap_is_pcapng(const ut_pcap_ctx* ctx) {
+  return ctx->replay.pcapng;
+}
+
+bool ut_pcap_swapped(const ut_pcap_ctx* ctx) {
+  return ctx->replay.swap;
+}
+
+uint32_t ut_pcap_unsupported(const ut_pcap_ctx* ctx) {
+  return ctx->replay.stat_unsupported;
+}
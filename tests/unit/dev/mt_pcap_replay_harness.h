@@ -0,0 +1,33 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef TESTS_UNIT_DEV_MT_PCAP_REPLAY_HARNESS_H
+#define TESTS_UNIT_DEV_MT_PCAP_REPLAY_HARNESS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ut_pcap_ctx ut_pcap_ctx;
+
+/* the capture is used in place, it must outlive the ctx */
+ut_pcap_ctx* ut_pcap_create_ctx(const uint8_t* data, size_t len);
+void ut_pcap_destroy_ctx(ut_pcap_ctx* ctx);
+/* parse the file header as replay_open does, pcap first then pcapng */
+int ut_pcap_parse_hdr(ut_pcap_ctx* ctx);
+/* peek and consume the next packet record */
+int ut_pcap_next(ut_pcap_ctx* ctx, const uint8_t** pkt, uint32_t* len, uint64_t* ts_ns);
+bool ut_pcap_is_pcapng(const ut_pcap_ctx* ctx);
+bool ut_pcap_swapped(const ut_pcap_ctx* ctx);
+uint32_t ut_pcap_unsupported(const ut_pcap_ctx* ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_UNIT_DEV_MT_PCAP_REPLAY_HARNESS_H */
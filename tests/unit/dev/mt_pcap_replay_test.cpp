@@ -0,0 +1,345 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * pcap replay parser: classic pcap and pcapng records from small crafted
+ * captures, in both byte orders, with the malformed cases stopping the replay.
+ *
+ * Build: meson setup build_unit -Denable_unit_tests=true && ninja -C build_unit
+ * Run:   ./build_unit/tests/unit/UnitTest --gtest_filter='MtPcapReplayTest.*'
+ */
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <vector>
+
+#include "dev/mt_pcap_replay_harness.h"
+
+namespace {
+
+/* builds a capture in the host or the swapped byte order */
+class CaptureWriter {
+ public:
+  explicit CaptureWriter(bool swap) : swap_(swap) {}
+
+  void u8(uint8_t v) {
+    buf_.push_back(v);
+  }
+
+  void u16(uint16_t v) {
+    if (swap_) v = __builtin_bswap16(v);
+    Raw(&v, sizeof(v));
+  }
+
+  void u32(uint32_t v) {
+    if (swap_) v = __builtin_bswap32(v);
+    Raw(&v, sizeof(v));
+  }
+
+  void Raw(const void* p, size_t len) {
+    const uint8_t* b = static_cast<const uint8_t*>(p);
+    buf_.insert(buf_.end(), b, b + len);
+  }
+
+  void Pad4() {
+    while (buf_.size() % 4) buf_.push_back(0);
+  }
+
+  size_t Size() const {
+    return buf_.size();
+  }
+
+  void Patch32(size_t off, uint32_t v) {
+    if (swap_) v = __builtin_bswap32(v);
+    memcpy(&buf_[off], &v, sizeof(v));
+  }
+
+  void Truncate(size_t len) {
+    buf_.resize(len);
+  }
+
+  std::vector<uint8_t>& Buf() {
+    return buf_;
+  }
+
+  /* classic pcap */
+  void PcapHdr(uint32_t magic) {
+    u32(magic);
+    u16(2);
+    u16(4);
+    u32(0);
+    u32(0);
+    u32(65535);
+    u32(1); /* ethernet */
+  }
+
+  void PcapRec(uint32_t sec, uint32_t frac, const std::vector<uint8_t>& pkt) {
+    u32(sec);
+    u32(frac);
+    u32(pkt.size());
+    u32(pkt.size());
+    Raw(pkt.data(), pkt.size());
+  }
+
+  /* pcapng */
+  void Shb() {
+    u32(0x0a0d0d0a);
+    u32(28);
+    u32(0x1a2b3c4d);
+    u16(1);
+    u16(0);
+    u32(0xffffffff); /* section length unknown */
+    u32(0xffffffff);
+    u32(28);
+  }
+
+  /* tsresol < 0 for no if_tsresol option */
+  void Idb(uint16_t linktype, int tsresol) {
+    size_t start = Size();
+    u32(0x00000001);
+    u32(0); /* patched */
+    u16(linktype);
+    u16(0);
+    u32(0); /* snaplen */
+    if (tsresol >= 0) {
+      u16(9);
+      u16(1);
+      u8(tsresol);
+      Pad4();
+      u16(0); /* opt_endofopt */
+      u16(0);
+    }
+    uint32_t len = Size() - start + 4;
+    u32(len);
+    Patch32(start + 4, len);
+  }
+
+  void Epb(uint32_t if_id, uint64_t ts, const std::vector<uint8_t>& pkt) {
+    size_t start = Size();
+    u32(0x00000006);
+    u32(0); /* patched */
+    u32(if_id);
+    u32(ts >> 32);
+    u32(ts & 0xffffffff);
+    u32(pkt.size());
+    u32(pkt.size());
+    Raw(pkt.data(), pkt.size());
+    Pad4();
+    uint32_t len = Size() - start + 4;
+    u32(len);
+    Patch32(start + 4, len);
+  }
+
+ private:
+  bool swap_;
+  std::vector<uint8_t> buf_;
+};
+
+std::vector<uint8_t> Pkt(size_t len, uint8_t seed) {
+  std::vector<uint8_t> pkt(len);
+  for (size_t i = 0; i < len; i++) pkt[i] = seed + i;
+  return pkt;
+}
+
+constexpr uint64_t kNsPerS = 1000ull * 1000 * 1000;
+
+}  // namespace
+
+class MtPcapReplayTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    ut_pcap_destroy_ctx(ctx_);
+  }
+
+  void Open(std::vector<uint8_t>& cap) {
+    ctx_ = ut_pcap_create_ctx(cap.data(), cap.size());
+    ASSERT_NE(ctx_, nullptr);
+  }
+
+  void ExpectPkt(const std::vector<uint8_t>& pkt, uint64_t ts_ns) {
+    const uint8_t* data = nullptr;
+    uint32_t len = 0;
+    uint64_t ts = 0;
+    ASSERT_EQ(ut_pcap_next(ctx_, &data, &len, &ts), 0);
+    ASSERT_EQ(len, pkt.size());
+    EXPECT_EQ(memcmp(data, pkt.data(), len), 0);
+    EXPECT_EQ(ts, ts_ns);
+  }
+
+  int NextRet() {
+    const uint8_t* data = nullptr;
+    uint32_t len = 0;
+    uint64_t ts = 0;
+    return ut_pcap_next(ctx_, &data, &len, &ts);
+  }
+
+  ut_pcap_ctx* ctx_ = nullptr;
+};
+
+TEST_F(MtPcapReplayTest, PcapMicrosecondRecords) {
+  CaptureWriter w(false);
+  auto p0 = Pkt(64, 1), p1 = Pkt(1200, 2);
+  w.PcapHdr(0xa1b2c3d4);
+  w.PcapRec(10, 500, p0);
+  w.PcapRec(11, 250000, p1);
+
+  Open(w.Buf());
+  ASSERT_EQ(ut_pcap_parse_hdr(ctx_), 0);
+  EXPECT_FALSE(ut_pcap_is_pcapng(ctx_));
+  EXPECT_FALSE(ut_pcap_swapped(ctx_));
+  ExpectPkt(p0, 10 * kNsPerS + 500 * 1000);
+  ExpectPkt(p1, 11 * kNsPerS + 250000ull * 1000);
+  EXPECT_EQ(NextRet(), -ENODATA);
+}
+
+TEST_F(MtPcapReplayTest, PcapSwappedByteOrder) {
+  CaptureWriter w(true);
+  auto p0 = Pkt(100, 3);
+  w.PcapHdr(0xa1b23c4d); /* nanosecond */
+  w.PcapRec(5, 123456789, p0);
+
+  Open(w.Buf());
+  ASSERT_EQ(ut_pcap_parse_hdr(ctx_), 0);
+  EXPECT_TRUE(ut_pcap_swapped(ctx_));
+  ExpectPkt(p0, 5 * kNsPerS + 123456789);
+}
+
+TEST_F(MtPcapReplayTest, PcapTruncatedRecordStops) {
+  CaptureWriter w(false);
+  auto p0 = Pkt(64, 1), p1 = Pkt(512, 2);
+  w.PcapHdr(0xa1b2c3d4);
+  w.PcapRec(1, 0, p0);
+  w.PcapRec(2, 0, p1);
+  w.Truncate(w.Size() - 100); /* cut in the payload of the second record */
+
+  Open(w.Buf());
+  ASSERT_EQ(ut_pcap_parse_hdr(ctx_), 0);
+  ExpectPkt(p0, 1 * kNsPerS);
+  EXPECT_EQ(NextRet(), -ENODATA);
+}
+
+TEST_F(MtPcapReplayTest, PcapTruncatedRecordHeaderStops) {
+  CaptureWriter w(false);
+  w.PcapHdr(0xa1b2c3d4);
+  w.u32(1);
+  w.u32(0); /* half of a record header */
+
+  Open(w.Buf());
+  ASSERT_EQ(ut_pcap_parse_hdr(ctx_), 0);
+  EXPECT_EQ(NextRet(), -ENODATA);
+}
+
+TEST_F(MtPcapReplayTest, NotACapture) {
+  std::vector<uint8_t> junk(64, 0x5a);
+  Open(junk);
+  EXPECT_LT(ut_pcap_parse_hdr(ctx_), 0);
+}
+
+TEST_F(MtPcapReplayTest, PcapngDefaultMicrosecondResolution) {
+  CaptureWriter w(false);
+  auto p0 = Pkt(80, 4);
+  w.Shb();
+  w.Idb(1, -1);
+  w.Epb(0, 7000001ull, p0); /* 7.000001s in us */
+
+  Open(w.Buf());
+  ASSERT_EQ(ut_pcap_parse_hdr(ctx_), 0);
+  EXPECT_TRUE(ut_pcap_is_pcapng(ctx_));
+  ExpectPkt(p0, 7 * kNsPerS + 1000);
+  EXPECT_EQ(NextRet(), -ENODATA);
+}
+
+TEST_F(MtPcapReplayTest, PcapngSwappedByteOrder) {
+  CaptureWriter w(true);
+  auto p0 = Pkt(81, 5), p1 = Pkt(82, 6); /* not 4 aligned, padded */
+  w.Shb();
+  w.Idb(1, 9); /* ns */
+  w.Epb(0, 3 * kNsPerS + 5, p0);
+  w.Epb(0, 3 * kNsPerS + 10, p1);
+
+  Open(w.Buf());
+  ASSERT_EQ(ut_pcap_parse_hdr(ctx_), 0);
+  EXPECT_TRUE(ut_pcap_swapped(ctx_));
+  ExpectPkt(p0, 3 * kNsPerS + 5);
+  ExpectPkt(p1, 3 * kNsPerS + 10);
+}
+
+TEST_F(MtPcapReplayTest, PcapngTsresolPowerOf2) {
+  CaptureWriter w(false);
+  auto p0 = Pkt(64, 7);
+  w.Shb();
+  w.Idb(1, 0x80 | 20); /* 2^-20 s */
+  w.Epb(0, (3ull << 20) + (1ull << 19), p0); /* 3.5s */
+
+  Open(w.Buf());
+  ASSERT_EQ(ut_pcap_parse_hdr(ctx_), 0);
+  ExpectPkt(p0, 3 * kNsPerS + kNsPerS / 2);
+}
+
+TEST_F(MtPcapReplayTest, PcapngTsresolOutOfRange) {
+  CaptureWriter w(false);
+  w.Shb();
+  w.Idb(1, 0x80 | 64); /* 2^-64 s does not fit */
+  w.Epb(0, 1, Pkt(64, 8));
+
+  Open(w.Buf());
+  ASSERT_EQ(ut_pcap_parse_hdr(ctx_), 0);
+  EXPECT_EQ(NextRet(), -ENOTSUP);
+}
+
+TEST_F(MtPcapReplayTest, PcapngUnknownInterfaceId) {
+  CaptureWriter w(false);
+  auto p0 = Pkt(64, 9);
+  w.Shb();
+  w.Idb(1, -1);
+  w.Epb(0, 1, p0);
+  w.Epb(1, 2, p0); /* only interface 0 is described */
+
+  Open(w.Buf());
+  ASSERT_EQ(ut_pcap_parse_hdr(ctx_), 0);
+  ExpectPkt(p0, 1000);
+  EXPECT_EQ(NextRet(), -EIO);
+}
+
+TEST_F(MtPcapReplayTest, PcapngBadBlockLength) {
+  CaptureWriter w(false);
+  auto p0 = Pkt(64, 10);
+  w.Shb();
+  w.Idb(1, -1);
+  size_t epb = w.Size();
+  w.Epb(0, 1, p0);
+  w.Patch32(epb + 4, 30); /* not a multiple of 4 */
+
+  Open(w.Buf());
+  ASSERT_EQ(ut_pcap_parse_hdr(ctx_), 0);
+  EXPECT_EQ(NextRet(), -ENODATA);
+}
+
+TEST_F(MtPcapReplayTest, PcapngBlockLengthBeyondFile) {
+  CaptureWriter w(false);
+  auto p0 = Pkt(64, 11);
+  w.Shb();
+  w.Idb(1, -1);
+  size_t epb = w.Size();
+  w.Epb(0, 1, p0);
+  w.Patch32(epb + 4, w.Size() - epb + 64);
+
+  Open(w.Buf());
+  ASSERT_EQ(ut_pcap_parse_hdr(ctx_), 0);
+  EXPECT_EQ(NextRet(), -ENODATA);
+}
+
+TEST_F(MtPcapReplayTest, PcapngNonEthernetSkipped) {
+  CaptureWriter w(false);
+  auto p0 = Pkt(64, 12), p1 = Pkt(70, 13);
+  w.Shb();
+  w.Idb(101, -1); /* raw ip */
+  w.Idb(1, -1);
+  w.Epb(0, 1, p0);
+  w.Epb(1, 2, p1);
+
+  Open(w.Buf());
+  ASSERT_EQ(ut_pcap_parse_hdr(ctx_), 0);
+  ExpectPkt(p1, 2000);
+  EXPECT_EQ(ut_pcap_unsupported(ctx_), 1u);
+}
@@ -56,9 +56,12 @@
  * and wired in via the #define redirection above.
  */
 
+static int ut20p_stub_put_cnt;
+
 int ut20p_stub_put_framebuff(st20_rx_handle handle, void* frame) {
   (void)handle;
   (void)frame; /* transport-side framebuf release is a no-op for the harness */
+  ut20p_stub_put_cnt++;
   return 0;
 }
 
@@ -83,6 +86,11 @@ struct ut20p_ctx {
   struct st20p_rx_ctx pipeline;
   struct st20p_rx_frame* framebuffs;
   int framebuff_cnt;
+  /* slice mode */
+  struct st_frame_converter converter;
+  void** dst_bufs;
+  int slice_notify_cnt;
+  uint32_t slice_notify_lines;
 };
 
 #include "pipeline/st20p_harness.h"
@@ -142,6 +150,10 @@ ut20p_ctx* ut20p_ctx_create(int framebuff_cnt) {
 
 void ut20p_ctx_destroy(ut20p_ctx* ctx) {
   if (!ctx) return;
+  if (ctx->dst_bufs) {
+    for (int i = 0; i < ctx->framebuff_cnt; i++) free(ctx->dst_bufs[i]);
+    free(ctx->dst_bufs);
+  }
   free(ctx->framebuffs);
   free(ctx);
 }
@@ -235,3 +247,223 @@ int ut20p_get_session_stats(ut20p_ctx* ctx, struct st20_rx_user_stats* stats) {
 int ut20p_reset_session_stats(ut20p_ctx* ctx) {
   return st20p_rx_reset_session_stats(&ctx->pipeline);
 }
+
+/* ── slice mode ───────────────────────────────────────────────────── */
+
+static int ut20p_slice_notify(void* priv, struct st_frame* frame, uint32_t lines_ready) {
+  ut20p_ctx* ctx = priv;
+  (void)frame;
+  ctx->slice_notify_cnt++;
+  ctx->slice_notify_lines = lines_ready;
+  return 0;
+}
+
+int ut20p_slice_enable(ut20p_ctx* ctx, uint32_t width, uint32_t height, bool convert,
+                       bool incomplete) {
+  struct st20p_rx_ctx* p = &ctx->pipeline;
+  enum st_frame_fmt dst_fmt = ST_FRAME_FMT_YUV422PLANAR10LE;
+
+  p->ops.width = width;
+  p->ops.height = height;
+  p->ops.transport_fmt = ST20_FMT_YUV_422_10BIT;
+  p->ops.output_fmt = convert ? dst_fmt : ST_FRAME_FMT_YUV422RFC4175PG2BE10;
+  p->ops.flags |= ST20P_RX_FLAG_SLICE_LEVEL;
+  if (incomplete) p->ops.flags |= ST20P_RX_FLAG_RECEIVE_INCOMPLETE_FRAME;
+  p->ops.priv = ctx;
+  p->ops.notify_slice_ready = ut20p_slice_notify;
+
+  if (convert) {
+    if (st_frame_get_converter(ST_FRAME_FMT_YUV422RFC4175PG2BE10, dst_fmt,
+                               &ctx->converter) < 0)
+      return -EIO;
+    p->internal_converter = &ctx->converter;
+    p->derive = false;
+    ctx->dst_bufs = calloc(ctx->framebuff_cnt, sizeof(*ctx->dst_bufs));
+    if (!ctx->dst_bufs) return -ENOMEM;
+  }
+
+  for (int i = 0; i < ctx->framebuff_cnt; i++) {
+    struct st_frame* src = &ctx->framebuffs[i].src;
+    src->fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10;
+    src->width = width;
+    src->height = height;
+    src->linesize[0] = st_frame_least_linesize(src->fmt, width, 0);
+    if (!convert) continue;
+
+    struct st_frame* dst = &ctx->framebuffs[i].dst;
+    size_t sz = st_frame_size(dst_fmt, width, height, false);
+    ctx->dst_bufs[i] = calloc(1, sz);
+    if (!ctx->dst_bufs[i]) return -ENOMEM;
+    dst->fmt = dst_fmt;
+    dst->width = width;
+    dst->height = height;
+    dst->buffer_size = dst->data_size = sz;
+    st_frame_init_plane_single_src(dst, ctx->dst_bufs[i], 0);
+  }
+
+  return rx_st20p_slice_init(p);
+}
+
+size_t ut20p_slice_src_size(uint32_t width, uint32_t height) {
+  return st_frame_size(ST_FRAME_FMT_YUV422RFC4175PG2BE10, width, height, false);
+}
+
+int ut20p_slice_inject(ut20p_ctx* ctx, void* frame, uint32_t recv_lines) {
+  struct st20_rx_slice_meta meta;
+  memset(&meta, 0, sizeof(meta));
+  meta.width = ctx->pipeline.ops.width;
+  meta.height = ctx->pipeline.ops.height;
+  meta.frame_recv_lines = recv_lines;
+  return rx_st20p_slice_ready(&ctx->pipeline, frame, &meta);
+}
+
+int ut20p_slice_frame_done(ut20p_ctx* ctx, void* frame, enum st_frame_status status,
+                           uint32_t timestamp) {
+  struct st20_rx_frame_meta meta;
+  memset(&meta, 0, sizeof(meta));
+  meta.status = status;
+  meta.timestamp = timestamp;
+  meta.rtp_timestamp = timestamp;
+  meta.frame_total_size = ut20p_slice_src_size(ctx->pipeline.ops.width,
+                                               ctx->pipeline.ops.height);
+  meta.frame_recv_size = meta.frame_total_size;
+  meta.pkts_total = 1;
+  return rx_st20p_frame_ready(&ctx->pipeline, frame, &meta);
+}
+
+struct st_frame* ut20p_get_slice(ut20p_ctx* ctx, uint32_t* lines_ready) {
+  return st20p_rx_get_slice(&ctx->pipeline, lines_ready);
+}
+
+int ut20p_slice_notify_cnt(const ut20p_ctx* ctx) {
+  return ctx->slice_notify_cnt;
+}
+
+uint32_t ut20p_slice_notify_lines(const ut20p_ctx* ctx) {
+  return ctx->slice_notify_lines;
+}
+
+int ut20p_transport_put_cnt(void) {
+  return ut20p_stub_put_cnt;
+}
+
+int ut20p_slice_lines_match(const struct st_frame* frame, void* src, uint32_t line,
+                            uint32_t lines) {
+  uint32_t w = frame->width, h = frame->height;
+  size_t sz = st_frame_size(frame->fmt, w, h, false);
+  struct st_frame ref;
+  int match = 1;
+
+  memset(&ref, 0, sizeof(ref));
+  ref.fmt = frame->fmt;
+  ref.width = w;
+  ref.height = h;
+  void* buf = calloc(1, sz);
+  if (!buf) return -ENOMEM;
+  st_frame_init_plane_single_src(&ref, buf, 0);
+  st20_rfc4175_422be10_to_yuv422p10le(src, ref.addr[0], ref.addr[1], ref.addr[2], w, h);
+
+  for (uint8_t plane = 0; plane < st_frame_fmt_planes(frame->fmt); plane++) {
+    size_t row = st_frame_least_linesize(frame->fmt, w, plane);
+    for (uint32_t l = line; l < line + lines; l++) {
+      if (memcmp((uint8_t*)frame->addr[plane] + frame->linesize[plane] * l,
+                 (uint8_t*)ref.addr[plane] + ref.linesize[plane] * l, row)) {
+        match = 0;
+        break;
+      }
+    }
+  }
+  free(buf);
+  return match;
+}
+
+/* ── packet convert to 420 ────────────────────────────────────────── */
+
+int ut20p_pkt_cvt_420_enable(ut20p_ctx* ctx, uint32_t width, uint32_t height,
+                             bool incomplete) {
+  struct st20p_rx_ctx* p = &ctx->pipeline;
+  enum st_frame_fmt dst_fmt = ST_FRAME_FMT_NV12;
+
+  p->ops.width = width;
+  p->ops.height = height;
+  p->ops.transport_fmt = ST20_FMT_YUV_422_10BIT;
+  p->ops.output_fmt = dst_fmt;
+  p->ops.flags |= ST20P_RX_FLAG_PKT_CONVERT;
+  if (incomplete) p->ops.flags |= ST20P_RX_FLAG_RECEIVE_INCOMPLETE_FRAME;
+  p->derive = false;
+  ctx->dst_bufs = calloc(ctx->framebuff_cnt, sizeof(*ctx->dst_bufs));
+  if (!ctx->dst_bufs) return -ENOMEM;
+
+  for (int i = 0; i < ctx->framebuff_cnt; i++) {
+    struct st_frame* dst = &ctx->framebuffs[i].dst;
+    size_t sz = st_frame_size(dst_fmt, width, height, false);
+    ctx->dst_bufs[i] = calloc(1, sz);
+    if (!ctx->dst_bufs[i]) return -ENOMEM;
+    dst->fmt = dst_fmt;
+    dst->width = width;
+    dst->height = height;
+    dst->buffer_size = dst->data_size = sz;
+    st_frame_init_plane_single_src(dst, ctx->dst_bufs[i], 0);
+  }
+  return 0;
+}
+
+int ut20p_pkt_cvt_inject(ut20p_ctx* ctx, void* park, void* src, uint32_t row,
+                         uint32_t offset, uint32_t pg_cnt, uint32_t timestamp) {
+  size_t pg_size = sizeof(struct st20_rfc4175_422_10_pg2_be);
+  size_t linesize = (size_t)ctx->pipeline.ops.width / 2 * pg_size;
+  struct st20_rx_uframe_pg_meta meta;
+
+  memset(&meta, 0, sizeof(meta));
+  meta.width = ctx->pipeline.ops.width;
+  meta.height = ctx->pipeline.ops.height;
+  meta.payload = (uint8_t*)src + linesize * row + offset / 2 * pg_size;
+  meta.row_number = row;
+  meta.row_offset = offset;
+  meta.pg_cnt = pg_cnt;
+  meta.timestamp = timestamp;
+  return rx_st20p_packet_convert(&ctx->pipeline, park, &meta);
+}
+
+int ut20p_pkt_cvt_frame_done(ut20p_ctx* ctx, void* park, uint32_t timestamp) {
+  struct st20_rx_frame_meta meta;
+  memset(&meta, 0, sizeof(meta));
+  meta.status = ST_FRAME_STATUS_COMPLETE;
+  meta.timestamp = timestamp;
+  meta.rtp_timestamp = timestamp;
+  meta.frame_total_size = ut20p_slice_src_size(ctx->pipeline.ops.width,
+                                               ctx->pipeline.ops.height);
+  meta.frame_recv_size = meta.frame_total_size;
+  meta.pkts_total = 1;
+  return rx_st20p_frame_ready(&ctx->pipeline, park, &meta);
+}
+
+int ut20p_pkt_cvt_match(const struct st_frame* frame, void* src) {
+  uint32_t w = frame->width, h = frame->height;
+  size_t sz = st_frame_size(frame->fmt, w, h, false);
+  struct st_frame ref;
+  int match = 1;
+
+  memset(&ref, 0, sizeof(ref));
+  ref.fmt = frame->fmt;
+  ref.width = w;
+  ref.height = h;
+  void* buf = calloc(1, sz);
+  if (!buf) return -ENOMEM;
+  st_frame_init_plane_single_src(&ref, buf, 0);
+  st20_rfc4175_422be10_to_nv12(src, ref.addr[0], ref.addr[1], w, h);
+
+  for (uint8_t plane = 0; plane < st_frame_fmt_planes(frame->fmt); plane++) {
+    size_t row = st_frame_least_linesize(frame->fmt, w, plane);
+    uint32_t lines = plane ? h / 2 : h;
+    for (uint32_t l = 0; l < lines; l++) {
+      if (memcmp((uint8_t*)frame->addr[plane] + frame->linesize[plane] * l,
+                 (uint8_t*)ref.addr[plane] + ref.linesize[plane] * l, row)) {
+        match = 0;
+        break;
+      }
+    }
+  }
+  free(buf);
+  return match;
+}
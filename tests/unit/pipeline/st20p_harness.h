@@ -21,6 +21,7 @@
 #define _ST20P_PIPELINE_HARNESS_H_
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "mtl_api.h"
@@ -94,6 +95,57 @@ int ut20p_get_session_stats(ut20p_ctx* ctx, struct st20_rx_user_stats* stats);
 /** Wraps st20p_rx_reset_session_stats(). */
 int ut20p_reset_session_stats(ut20p_ctx* ctx);
 
+/* ── slice mode (ST20P_RX_FLAG_SLICE_LEVEL) ─────────────────────── */
+
+/**
+ * Switch the ctx to slice mode for width x height rfc4175 422be10 frames.
+ * convert false keeps derive (the watermark only), true converts each slice to
+ * yuv422p10le with the built-in converter into harness owned buffers.
+ * incomplete sets ST20P_RX_FLAG_RECEIVE_INCOMPLETE_FRAME.
+ */
+int ut20p_slice_enable(ut20p_ctx* ctx, uint32_t width, uint32_t height, bool convert,
+                       bool incomplete);
+/** Bytes of one transport frame for the slice tests. */
+size_t ut20p_slice_src_size(uint32_t width, uint32_t height);
+/** Wraps rx_st20p_slice_ready() with recv_lines full lines of the transport frame. */
+int ut20p_slice_inject(ut20p_ctx* ctx, void* frame, uint32_t recv_lines);
+/** Wraps rx_st20p_frame_ready() for the transport frame. */
+int ut20p_slice_frame_done(ut20p_ctx* ctx, void* frame, enum st_frame_status status,
+                           uint32_t timestamp);
+/** Wraps st20p_rx_get_slice(). */
+struct st_frame* ut20p_get_slice(ut20p_ctx* ctx, uint32_t* lines_ready);
+/** Calls and the last lines_ready of the notify_slice_ready callback. */
+int ut20p_slice_notify_cnt(const ut20p_ctx* ctx);
+uint32_t ut20p_slice_notify_lines(const ut20p_ctx* ctx);
+/** Transport frames put back by the pipeline, global to the process. */
+int ut20p_transport_put_cnt(void);
+/**
+ * 1 if the lines [line, line + lines) of the converted frame equal the full frame
+ * conversion of src, 0 if not.
+ */
+int ut20p_slice_lines_match(const struct st_frame* frame, void* src, uint32_t line,
+                            uint32_t lines);
+
+/* ── packet convert to 420 (ST20P_RX_FLAG_PKT_CONVERT) ──────────── */
+
+/**
+ * Switch the ctx to the packet convert of width x height rfc4175 422be10 frames
+ * into nv12 harness owned buffers. incomplete sets
+ * ST20P_RX_FLAG_RECEIVE_INCOMPLETE_FRAME.
+ */
+int ut20p_pkt_cvt_420_enable(ut20p_ctx* ctx, uint32_t width, uint32_t height,
+                             bool incomplete);
+/**
+ * Wraps rx_st20p_packet_convert() for pg_cnt pixel groups of src at row and pixel
+ * offset. park is the idle transport frame the even lines are parked in.
+ */
+int ut20p_pkt_cvt_inject(ut20p_ctx* ctx, void* park, void* src, uint32_t row,
+                         uint32_t offset, uint32_t pg_cnt, uint32_t timestamp);
+/** Wraps rx_st20p_frame_ready() for a complete transport frame. */
+int ut20p_pkt_cvt_frame_done(ut20p_ctx* ctx, void* park, uint32_t timestamp);
+/** 1 if the nv12 frame equals the full frame conversion of src, 0 if not. */
+int ut20p_pkt_cvt_match(const struct st_frame* frame, void* src);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,149 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * ST20p RX packet convert to 420 (ST20P_RX_FLAG_PKT_CONVERT to nv12) tests.
+ *
+ *   - the even line is parked and converted with the odd line, in line order
+ *     the frame equals the full frame conversion;
+ *   - an odd packet without its parked even pixels is not converted and the
+ *     frame is incomplete: dropped and put back to the transport, or delivered
+ *     as corrupted with ST20P_RX_FLAG_RECEIVE_INCOMPLETE_FRAME;
+ *   - the pairing restarts with every frame.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "pipeline/st20p_harness.h"
+
+namespace {
+
+constexpr uint32_t kWidth = 64;
+constexpr uint32_t kHeight = 8;
+/* two packets per line */
+constexpr uint32_t kPgPerPkt = kWidth / 2 / 2;
+constexpr uint32_t kPixPerPkt = kPgPerPkt * 2;
+
+class St20pRxPktConvert420Test : public ::testing::Test {
+ protected:
+  ut20p_ctx* ctx_ = nullptr;
+  std::vector<uint8_t> src_;
+  std::vector<uint8_t> park_;
+
+  void SetUp() override {
+    ASSERT_EQ(ut20p_init(), 0) << "EAL init failed";
+    ctx_ = ut20p_ctx_create(/*framebuff_cnt=*/3);
+    ASSERT_NE(ctx_, nullptr);
+    src_.resize(ut20p_slice_src_size(kWidth, kHeight));
+    for (size_t i = 0; i < src_.size(); i++) src_[i] = (uint8_t)(i * 7 + 3);
+    park_.resize(src_.size());
+  }
+
+  void TearDown() override {
+    ut20p_ctx_destroy(ctx_);
+    ctx_ = nullptr;
+  }
+
+  void feed_row(uint32_t row, uint32_t ts) {
+    for (uint32_t offset = 0; offset < kWidth; offset += kPixPerPkt)
+      ASSERT_EQ(ut20p_pkt_cvt_inject(ctx_, park_.data(), src_.data(), row, offset,
+                                     kPgPerPkt, ts),
+                0);
+  }
+
+  void feed_rows(const std::vector<uint32_t>& rows, uint32_t ts) {
+    for (uint32_t row : rows) feed_row(row, ts);
+  }
+};
+
+TEST_F(St20pRxPktConvert420Test, InOrderMatchesFullFrame) {
+  ASSERT_EQ(ut20p_pkt_cvt_420_enable(ctx_, kWidth, kHeight, false), 0);
+
+  for (uint32_t row = 0; row < kHeight; row++) feed_row(row, 1000);
+  ASSERT_EQ(ut20p_pkt_cvt_frame_done(ctx_, park_.data(), 1000), 0);
+
+  struct st_frame* frame = ut20p_get_frame(ctx_);
+  ASSERT_NE(frame, nullptr);
+  EXPECT_EQ(frame->status, ST_FRAME_STATUS_COMPLETE);
+  EXPECT_EQ(ut20p_pkt_cvt_match(frame, src_.data()), 1);
+  EXPECT_EQ(ut20p_put_frame(ctx_, frame), 0);
+  EXPECT_EQ(ut20p_stat_frames_corrupted(ctx_), 0u);
+}
+
+TEST_F(St20pRxPktConvert420Test, OddBeforeEvenDropped) {
+  ASSERT_EQ(ut20p_pkt_cvt_420_enable(ctx_, kWidth, kHeight, false), 0);
+  int put_base = ut20p_transport_put_cnt();
+
+  feed_rows({0, 1, 3, 2, 4, 5, 6, 7}, 2000);
+  ASSERT_EQ(ut20p_pkt_cvt_frame_done(ctx_, park_.data(), 2000), 0);
+
+  EXPECT_EQ(ut20p_get_frame(ctx_), nullptr) << "the incomplete frame is dropped";
+  EXPECT_EQ(ut20p_stat_frames_dropped(ctx_), 1u);
+  EXPECT_EQ(ut20p_transport_put_cnt(), put_base + 1) << "put back to the transport";
+}
+
+TEST_F(St20pRxPktConvert420Test, OddBeforeEvenDeliveredCorrupted) {
+  ASSERT_EQ(ut20p_pkt_cvt_420_enable(ctx_, kWidth, kHeight, true), 0);
+
+  feed_rows({0, 1, 3, 2, 4, 5, 6, 7}, 3000);
+  ASSERT_EQ(ut20p_pkt_cvt_frame_done(ctx_, park_.data(), 3000), 0);
+
+  struct st_frame* frame = ut20p_get_frame(ctx_);
+  ASSERT_NE(frame, nullptr);
+  EXPECT_EQ(frame->status, ST_FRAME_STATUS_CORRUPTED);
+  EXPECT_EQ(ut20p_put_frame(ctx_, frame), 0);
+  EXPECT_EQ(ut20p_stat_frames_corrupted(ctx_), 1u);
+}
+
+TEST_F(St20pRxPktConvert420Test, EvenPacketMissed) {
+  ASSERT_EQ(ut20p_pkt_cvt_420_enable(ctx_, kWidth, kHeight, true), 0);
+
+  feed_rows({0, 1}, 4000);
+  /* only the second half of row 2 */
+  ASSERT_EQ(ut20p_pkt_cvt_inject(ctx_, park_.data(), src_.data(), 2, kPixPerPkt,
+                                 kPgPerPkt, 4000),
+            0);
+  feed_rows({3, 4, 5, 6, 7}, 4000);
+  ASSERT_EQ(ut20p_pkt_cvt_frame_done(ctx_, park_.data(), 4000), 0);
+
+  struct st_frame* frame = ut20p_get_frame(ctx_);
+  ASSERT_NE(frame, nullptr);
+  EXPECT_EQ(frame->status, ST_FRAME_STATUS_CORRUPTED);
+  EXPECT_EQ(ut20p_put_frame(ctx_, frame), 0);
+}
+
+TEST_F(St20pRxPktConvert420Test, OddRowMissed) {
+  ASSERT_EQ(ut20p_pkt_cvt_420_enable(ctx_, kWidth, kHeight, true), 0);
+
+  /* the even luma of row 6 is never written without row 7 */
+  feed_rows({0, 1, 2, 3, 4, 5, 6}, 5000);
+  ASSERT_EQ(ut20p_pkt_cvt_frame_done(ctx_, park_.data(), 5000), 0);
+
+  struct st_frame* frame = ut20p_get_frame(ctx_);
+  ASSERT_NE(frame, nullptr);
+  EXPECT_EQ(frame->status, ST_FRAME_STATUS_CORRUPTED);
+  EXPECT_EQ(ut20p_put_frame(ctx_, frame), 0);
+}
+
+TEST_F(St20pRxPktConvert420Test, NextFrameStartsClean) {
+  ASSERT_EQ(ut20p_pkt_cvt_420_enable(ctx_, kWidth, kHeight, true), 0);
+
+  feed_rows({0, 1, 3, 2, 4, 5, 6, 7}, 6000);
+  ASSERT_EQ(ut20p_pkt_cvt_frame_done(ctx_, park_.data(), 6000), 0);
+  struct st_frame* frame = ut20p_get_frame(ctx_);
+  ASSERT_NE(frame, nullptr);
+  EXPECT_EQ(frame->status, ST_FRAME_STATUS_CORRUPTED);
+  EXPECT_EQ(ut20p_put_frame(ctx_, frame), 0);
+
+  for (uint32_t row = 0; row < kHeight; row++) feed_row(row, 7000);
+  ASSERT_EQ(ut20p_pkt_cvt_frame_done(ctx_, park_.data(), 7000), 0);
+  frame = ut20p_get_frame(ctx_);
+  ASSERT_NE(frame, nullptr);
+  EXPECT_EQ(frame->status, ST_FRAME_STATUS_COMPLETE);
+  EXPECT_EQ(ut20p_pkt_cvt_match(frame, src_.data()), 1);
+  EXPECT_EQ(ut20p_put_frame(ctx_, frame), 0);
+}
+
+}  // namespace
@@ -0,0 +1,168 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * ST20p RX slice delivery (ST20P_RX_FLAG_SLICE_LEVEL) tests.
+ *
+ *   - the first slice of a transport frame claims a framebuffer, the later
+ *     slices of the same frame move its lines_ready watermark only;
+ *   - st20p_rx_get_slice exposes the receiving frame and the watermark, the
+ *     notify_slice_ready callback reports the same watermark;
+ *   - the internal converter converts every slice once, the result equals the
+ *     full frame conversion and the frame is CONVERTED at frame_ready;
+ *   - incomplete frames are dropped and put back to the transport unless
+ *     ST20P_RX_FLAG_RECEIVE_INCOMPLETE_FRAME is set.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "pipeline/st20p_harness.h"
+
+namespace {
+
+constexpr uint32_t kWidth = 64;
+constexpr uint32_t kHeight = 32;
+
+class St20pRxSliceTest : public ::testing::Test {
+ protected:
+  ut20p_ctx* ctx_ = nullptr;
+
+  void SetUp() override {
+    ASSERT_EQ(ut20p_init(), 0) << "EAL init failed";
+    ctx_ = ut20p_ctx_create(/*framebuff_cnt=*/3);
+    ASSERT_NE(ctx_, nullptr);
+  }
+
+  void TearDown() override {
+    ut20p_ctx_destroy(ctx_);
+    ctx_ = nullptr;
+  }
+
+  static std::vector<uint8_t> make_src() {
+    std::vector<uint8_t> src(ut20p_slice_src_size(kWidth, kHeight));
+    for (size_t i = 0; i < src.size(); i++) src[i] = (uint8_t)(i * 7 + 3);
+    return src;
+  }
+};
+
+TEST_F(St20pRxSliceTest, WatermarkAdvancesPerSlice) {
+  ASSERT_EQ(ut20p_slice_enable(ctx_, kWidth, kHeight, false, false), 0);
+  std::vector<uint8_t> src = make_src();
+  uint32_t lines = 0;
+
+  EXPECT_EQ(ut20p_get_slice(ctx_, &lines), nullptr) << "no frame receiving yet";
+
+  ASSERT_EQ(ut20p_slice_inject(ctx_, src.data(), 8), 0);
+  struct st_frame* slice = ut20p_get_slice(ctx_, &lines);
+  ASSERT_NE(slice, nullptr);
+  EXPECT_EQ(lines, 8u);
+  EXPECT_EQ(ut20p_slice_notify_cnt(ctx_), 1);
+  EXPECT_EQ(ut20p_slice_notify_lines(ctx_), 8u);
+
+  ASSERT_EQ(ut20p_slice_inject(ctx_, src.data(), 16), 0);
+  EXPECT_EQ(ut20p_get_slice(ctx_, &lines), slice) << "same frame, same framebuffer";
+  EXPECT_EQ(lines, 16u);
+  EXPECT_EQ(ut20p_slice_notify_lines(ctx_), 16u);
+  EXPECT_EQ(ut20p_get_frame(ctx_), nullptr) << "frame not complete yet";
+
+  ASSERT_EQ(ut20p_slice_frame_done(ctx_, src.data(), ST_FRAME_STATUS_COMPLETE, 1000), 0);
+  EXPECT_EQ(ut20p_get_slice(ctx_, &lines), nullptr) << "no frame receiving anymore";
+  struct st_frame* frame = ut20p_get_frame(ctx_);
+  ASSERT_NE(frame, nullptr);
+  EXPECT_EQ(frame->addr[0], src.data()) << "derive delivers the transport frame";
+  EXPECT_EQ(ut20p_put_frame(ctx_, frame), 0);
+}
+
+TEST_F(St20pRxSliceTest, ConvertPerSliceMatchesFullFrame) {
+  ASSERT_EQ(ut20p_slice_enable(ctx_, kWidth, kHeight, true, false), 0);
+  std::vector<uint8_t> src = make_src();
+  uint32_t lines = 0;
+
+  /* the last 5 lines are not a full slice, frame_ready converts them */
+  for (uint32_t recv : {9u, 18u, 27u}) {
+    ASSERT_EQ(ut20p_slice_inject(ctx_, src.data(), recv), 0);
+    struct st_frame* slice = ut20p_get_slice(ctx_, &lines);
+    ASSERT_NE(slice, nullptr);
+    ASSERT_EQ(lines, recv);
+    EXPECT_EQ(ut20p_slice_lines_match(slice, src.data(), 0, lines), 1)
+        << "lines ready must be converted, recv " << recv;
+  }
+
+  ASSERT_EQ(ut20p_slice_frame_done(ctx_, src.data(), ST_FRAME_STATUS_COMPLETE, 1000), 0);
+  struct st_frame* frame = ut20p_get_frame(ctx_);
+  ASSERT_NE(frame, nullptr);
+  EXPECT_EQ(ut20p_slice_lines_match(frame, src.data(), 0, kHeight), 1);
+  EXPECT_EQ(ut20p_put_frame(ctx_, frame), 0);
+}
+
+/* A frame without a free framebuffer at its first slice still gets one at
+ * frame_ready and is converted in full there. */
+TEST_F(St20pRxSliceTest, LateClaimConvertsWholeFrame) {
+  ASSERT_EQ(ut20p_slice_enable(ctx_, kWidth, kHeight, true, false), 0);
+  std::vector<uint8_t> src = make_src();
+
+  ASSERT_EQ(ut20p_slice_frame_done(ctx_, src.data(), ST_FRAME_STATUS_COMPLETE, 1000), 0);
+  struct st_frame* frame = ut20p_get_frame(ctx_);
+  ASSERT_NE(frame, nullptr);
+  EXPECT_EQ(ut20p_slice_lines_match(frame, src.data(), 0, kHeight), 1);
+  EXPECT_EQ(ut20p_put_frame(ctx_, frame), 0);
+}
+
+TEST_F(St20pRxSliceTest, IncompleteDroppedUnlessRequested) {
+  ASSERT_EQ(ut20p_slice_enable(ctx_, kWidth, kHeight, false, false), 0);
+  std::vector<uint8_t> src = make_src();
+  uint32_t lines = 0;
+
+  ASSERT_EQ(ut20p_slice_inject(ctx_, src.data(), 8), 0);
+  int put_before = ut20p_transport_put_cnt();
+  ASSERT_EQ(ut20p_slice_frame_done(ctx_, src.data(), ST_FRAME_STATUS_CORRUPTED, 1000),
+            0);
+  EXPECT_EQ(ut20p_transport_put_cnt(), put_before + 1)
+      << "the dropped transport frame must be put back";
+  EXPECT_EQ(ut20p_get_slice(ctx_, &lines), nullptr);
+  EXPECT_EQ(ut20p_get_frame(ctx_), nullptr);
+  for (int i = 0; i < ut20p_framebuff_cnt(ctx_); i++)
+    EXPECT_EQ(ut20p_frame_stat(ctx_, i), 0) << "framebuffer " << i << " not free";
+}
+
+TEST_F(St20pRxSliceTest, IncompleteDeliveredWhenRequested) {
+  ASSERT_EQ(ut20p_slice_enable(ctx_, kWidth, kHeight, false, true), 0);
+  std::vector<uint8_t> src = make_src();
+
+  ASSERT_EQ(ut20p_slice_inject(ctx_, src.data(), 8), 0);
+  ASSERT_EQ(ut20p_slice_frame_done(ctx_, src.data(), ST_FRAME_STATUS_CORRUPTED, 1000),
+            0);
+  struct st_frame* frame = ut20p_get_frame(ctx_);
+  ASSERT_NE(frame, nullptr);
+  EXPECT_EQ(frame->status, ST_FRAME_STATUS_CORRUPTED);
+  EXPECT_EQ(ut20p_put_frame(ctx_, frame), 0);
+}
+
+/* Each transport frame in flight has its own framebuffer. */
+TEST_F(St20pRxSliceTest, TwoFramesInFlight) {
+  ASSERT_EQ(ut20p_slice_enable(ctx_, kWidth, kHeight, false, false), 0);
+  std::vector<uint8_t> first = make_src();
+  std::vector<uint8_t> second = make_src();
+  uint32_t lines = 0;
+
+  ASSERT_EQ(ut20p_slice_inject(ctx_, first.data(), 24), 0);
+  ASSERT_EQ(ut20p_slice_inject(ctx_, second.data(), 8), 0);
+  struct st_frame* slice = ut20p_get_slice(ctx_, &lines);
+  ASSERT_NE(slice, nullptr);
+  EXPECT_EQ(lines, 24u) << "the oldest receiving frame first";
+
+  ASSERT_EQ(ut20p_slice_frame_done(ctx_, first.data(), ST_FRAME_STATUS_COMPLETE, 1000),
+            0);
+  slice = ut20p_get_slice(ctx_, &lines);
+  ASSERT_NE(slice, nullptr);
+  EXPECT_EQ(lines, 8u);
+
+  struct st_frame* frame = ut20p_get_frame(ctx_);
+  ASSERT_NE(frame, nullptr);
+  EXPECT_EQ(frame->addr[0], first.data());
+  EXPECT_EQ(ut20p_put_frame(ctx_, frame), 0);
+}
+
+}  // namespace
@@ -45,6 +45,20 @@ ut20p_tx_ctx* ut20p_tx_ctx_create(int framebuff_cnt) {
     free(ctx);
     return NULL;
   }
+  struct st20p_tx_ctx* p = &ctx->pipeline;
+  /* mirrors production init: every framebuf starts FREE and queued */
+  p->free_queue = st_frame_queue_create("ut_free", framebuff_cnt, rte_socket_id());
+  p->ready_queue = st_frame_queue_create("ut_ready", framebuff_cnt, rte_socket_id());
+  p->converted_queue =
+      st_frame_queue_create("ut_converted", framebuff_cnt, rte_socket_id());
+  if (!p->free_queue || !p->ready_queue || !p->converted_queue) {
+    st_frame_queue_free(p->free_queue);
+    st_frame_queue_free(p->ready_queue);
+    st_frame_queue_free(p->converted_queue);
+    free(ctx->framebuffs);
+    free(ctx);
+    return NULL;
+  }
   for (int i = 0; i < framebuff_cnt; i++) {
     ctx->framebuffs[i].stat = ST20P_TX_FRAME_FREE;
     ctx->framebuffs[i].idx = i;
@@ -56,9 +70,9 @@ ut20p_tx_ctx* ut20p_tx_ctx_create(int framebuff_cnt) {
     ctx->framebuffs[i].convert_frame.src = &ctx->framebuffs[i].src;
     ctx->framebuffs[i].convert_frame.dst = &ctx->framebuffs[i].dst;
     ctx->framebuffs[i].convert_frame.priv = &ctx->framebuffs[i];
+    st_frame_queue_put(p->free_queue, &ctx->framebuffs[i]);
   }
 
-  struct st20p_tx_ctx* p = &ctx->pipeline;
   p->impl = &ctx->impl;
   p->idx = 0;
   p->socket_id = rte_socket_id();
@@ -83,6 +97,9 @@ void ut20p_tx_ctx_destroy(ut20p_tx_ctx* ctx) {
     mt_pthread_mutex_destroy(&ctx->pipeline.block_wake_mutex);
     mt_pthread_cond_destroy(&ctx->pipeline.block_wake_cond);
   }
+  st_frame_queue_free(ctx->pipeline.free_queue);
+  st_frame_queue_free(ctx->pipeline.ready_queue);
+  st_frame_queue_free(ctx->pipeline.converted_queue);
   free(ctx->framebuffs);
   free(ctx);
 }
@@ -180,7 +197,18 @@ void ut20p_tx_set_notify_frame_done(ut20p_tx_ctx* ctx,
 }
 
 void ut20p_tx_set_frame_ready(ut20p_tx_ctx* ctx, int idx) {
-  __atomic_store_n(&ctx->framebuffs[idx].stat, ST20P_TX_FRAME_READY, __ATOMIC_RELEASE);
+  struct st20p_tx_ctx* p = &ctx->pipeline;
+  struct st20p_tx_frame* framebuff = &ctx->framebuffs[idx];
+
+  /* take it out of the free queue as get_frame() would, keep the others queued */
+  unsigned int cnt = st_frame_queue_count(p->free_queue);
+  for (unsigned int i = 0; i < cnt; i++) {
+    struct st20p_tx_frame* queued = st_frame_queue_get(p->free_queue);
+    if (!queued) break;
+    if (queued != framebuff) st_frame_queue_put(p->free_queue, queued);
+  }
+  __atomic_store_n(&framebuff->stat, ST20P_TX_FRAME_READY, __ATOMIC_RELEASE);
+  st_frame_queue_put(p->ready_queue, framebuff);
 }
 
 struct st20_convert_frame_meta* ut20p_tx_convert_get_frame(ut20p_tx_ctx* ctx) {
@@ -216,3 +244,24 @@ int ut20p_tx_frame_stat(const ut20p_tx_ctx* ctx, int i) {
 uint64_t ut20p_tx_stat_frames_sent(const ut20p_tx_ctx* ctx) {
   return ctx->pipeline.stat_frames_sent;
 }
+
+int ut20p_tx_pkt_convert(ut20p_tx_ctx* ctx, enum st_frame_fmt input_fmt,
+                         const struct st_frame* src, uint16_t row_number,
+                         uint16_t row_offset, uint32_t pg_cnt, void* payload) {
+  struct st20_tx_uframe_pg_meta meta;
+
+  ctx->pipeline.ops.input_fmt = input_fmt;
+  ctx->pipeline.pkt_convert = true;
+  ctx->framebuffs[0].src = *src;
+
+  memset(&meta, 0, sizeof(meta));
+  meta.width = src->width;
+  meta.height = src->height;
+  meta.fmt = ST20_FMT_YUV_422_10BIT;
+  meta.payload = payload;
+  meta.row_number = row_number;
+  meta.row_offset = row_offset;
+  meta.pg_cnt = pg_cnt;
+  meta.row_length = pg_cnt * 5; /* 5 bytes per 422 10bit pg */
+  return tx_st20p_packet_convert(&ctx->pipeline, 0, &meta);
+}
@@ -115,6 +115,16 @@ int ut20p_tx_frame_stat(const ut20p_tx_ctx* ctx, int i);
 
 uint64_t ut20p_tx_stat_frames_sent(const ut20p_tx_ctx* ctx);
 
+/**
+ * Run the ST20P_TX_FLAG_PKT_CONVERT payload callback (tx_st20p_packet_convert)
+ * for one packet: pg_cnt pixel groups of src line row_number starting at pixel
+ * row_offset, written as RFC4175 422 BE10 to payload. src is used as the input
+ * frame of framebuffer 0.
+ */
+int ut20p_tx_pkt_convert(ut20p_tx_ctx* ctx, enum st_frame_fmt input_fmt,
+                         const struct st_frame* src, uint16_t row_number,
+                         uint16_t row_offset, uint32_t pg_cnt, void* payload);
+
 #ifdef __cplusplus
 }
 #endif
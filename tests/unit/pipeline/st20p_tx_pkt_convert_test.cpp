@@ -0,0 +1,138 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * ST20p TX packet convert (ST20P_TX_FLAG_PKT_CONVERT): each packet payload is
+ * converted from one line segment of the input frame. The payloads of all the
+ * packets must be byte identical with the full frame convert of the same input.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "pipeline/st20p_tx_harness.h"
+#include "st_convert_api.h"
+
+namespace {
+
+constexpr uint32_t kWidth = 1920;
+constexpr uint32_t kHeight = 4;
+constexpr size_t kPgSize = 5; /* 2 pixels per 422 10bit pg */
+
+}  // namespace
+
+class St20pTxPktConvertTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_EQ(ut20p_tx_init(), 0) << "EAL init failed";
+    ctx_ = ut20p_tx_ctx_create(1);
+    ASSERT_NE(ctx_, nullptr);
+  }
+
+  void TearDown() override {
+    ut20p_tx_ctx_destroy(ctx_);
+  }
+
+  /* fill the input frame with random samples, mask keeps the valid bits */
+  void FillPlanar(uint16_t mask) {
+    std::mt19937 rng(0x2110);
+    y_.resize(kWidth * kHeight);
+    b_.resize(kWidth / 2 * kHeight);
+    r_.resize(kWidth / 2 * kHeight);
+    for (auto& v : y_) v = rng() & mask;
+    for (auto& v : b_) v = rng() & mask;
+    for (auto& v : r_) v = rng() & mask;
+
+    memset(&src_, 0, sizeof(src_));
+    src_.addr[0] = y_.data();
+    src_.addr[1] = b_.data();
+    src_.addr[2] = r_.data();
+    src_.linesize[0] = kWidth * 2;
+    src_.linesize[1] = kWidth;
+    src_.linesize[2] = kWidth;
+    src_.width = kWidth;
+    src_.height = kHeight;
+  }
+
+  void FillY210() {
+    std::mt19937 rng(0x210);
+    y_.resize(kWidth * 2 * kHeight);
+    for (auto& v : y_) v = rng() & 0xFFC0; /* 10 bits in the msb */
+
+    memset(&src_, 0, sizeof(src_));
+    src_.addr[0] = y_.data();
+    src_.linesize[0] = kWidth * 4;
+    src_.width = kWidth;
+    src_.height = kHeight;
+  }
+
+  /* packetize every line in segments of pg_cnt pgs, the last one takes the rest */
+  std::vector<uint8_t> Packetize(enum st_frame_fmt fmt, uint32_t pg_cnt) {
+    uint32_t line_pgs = kWidth / 2;
+    std::vector<uint8_t> out(line_pgs * kPgSize * kHeight);
+
+    for (uint32_t line = 0; line < kHeight; line++) {
+      for (uint32_t pg = 0; pg < line_pgs; pg += pg_cnt) {
+        uint32_t cnt = std::min(pg_cnt, line_pgs - pg);
+        uint8_t* payload = out.data() + (line * line_pgs + pg) * kPgSize;
+        EXPECT_EQ(ut20p_tx_pkt_convert(ctx_, fmt, &src_, line, pg * 2, cnt, payload), 0)
+            << "line " << line << " pg " << pg;
+      }
+    }
+    return out;
+  }
+
+  std::vector<uint8_t> FrameConvert(enum st_frame_fmt fmt) {
+    std::vector<uint8_t> out(kWidth / 2 * kPgSize * kHeight);
+    auto* pg = reinterpret_cast<st20_rfc4175_422_10_pg2_be*>(out.data());
+    int ret = -EIO;
+
+    if (fmt == ST_FRAME_FMT_YUV422PLANAR10LE)
+      ret = st20_yuv422p10le_to_rfc4175_422be10(y_.data(), b_.data(), r_.data(), pg,
+                                                kWidth, kHeight);
+    else if (fmt == ST_FRAME_FMT_YUV422PLANAR16LE)
+      ret = st20_yuv422p16le_to_rfc4175_422be10(y_.data(), b_.data(), r_.data(), pg,
+                                                kWidth, kHeight);
+    else if (fmt == ST_FRAME_FMT_Y210)
+      ret = st20_y210_to_rfc4175_422be10(y_.data(), pg, kWidth, kHeight);
+    EXPECT_EQ(ret, 0);
+    return out;
+  }
+
+  ut20p_tx_ctx* ctx_ = nullptr;
+  struct st_frame src_;
+  std::vector<uint16_t> y_, b_, r_;
+};
+
+TEST_F(St20pTxPktConvertTest, Yuv422p10leMatchesFrameConvert) {
+  FillPlanar(0x3FF);
+  auto ref = FrameConvert(ST_FRAME_FMT_YUV422PLANAR10LE);
+  EXPECT_EQ(Packetize(ST_FRAME_FMT_YUV422PLANAR10LE, 240), ref);
+  /* a segment size not dividing the line, the last packet of each line is short */
+  EXPECT_EQ(Packetize(ST_FRAME_FMT_YUV422PLANAR10LE, 257), ref);
+}
+
+TEST_F(St20pTxPktConvertTest, Yuv422p16leMatchesFrameConvert) {
+  FillPlanar(0xFFFF);
+  auto ref = FrameConvert(ST_FRAME_FMT_YUV422PLANAR16LE);
+  EXPECT_EQ(Packetize(ST_FRAME_FMT_YUV422PLANAR16LE, 240), ref);
+  EXPECT_EQ(Packetize(ST_FRAME_FMT_YUV422PLANAR16LE, 257), ref);
+}
+
+TEST_F(St20pTxPktConvertTest, Y210MatchesFrameConvert) {
+  FillY210();
+  auto ref = FrameConvert(ST_FRAME_FMT_Y210);
+  EXPECT_EQ(Packetize(ST_FRAME_FMT_Y210, 240), ref);
+  EXPECT_EQ(Packetize(ST_FRAME_FMT_Y210, 257), ref);
+}
+
+TEST_F(St20pTxPktConvertTest, UnsupportedInputFails) {
+  FillPlanar(0x3FF);
+  std::vector<uint8_t> payload(240 * kPgSize);
+  EXPECT_LT(ut20p_tx_pkt_convert(ctx_, ST_FRAME_FMT_UYVY, &src_, 0, 0, 240,
+                                 payload.data()),
+            0);
+}
@@ -0,0 +1,165 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * ST22p (compressed video) TX pipelined encode tests.
+ *
+ * An encoder which reports max_frames_in_flight > 1 may hold several frames
+ * between st22_encoder_get_frame and st22_encoder_put_frame and put them back
+ * in any order. The pipeline has to:
+ *   - never hand out more frames than the encode depth;
+ *   - hand out the READY frames oldest first;
+ *   - transmit the ENCODED frames in the app order, holding a frame back while
+ *     an older one is still waiting for or in the encoder.
+ */
+
+#include <gtest/gtest.h>
+
+#include <errno.h>
+
+#include "pipeline/st22p_tx_harness.h"
+
+namespace {
+
+class St22pTxEncodePipelineTest : public ::testing::Test {
+ protected:
+  ut22p_tx_ctx* ctx_ = nullptr;
+
+  void SetUp() override {
+    ASSERT_EQ(ut22p_tx_init(), 0) << "EAL init failed";
+  }
+
+  void TearDown() override {
+    ut22p_tx_ctx_destroy(ctx_);
+    ctx_ = nullptr;
+  }
+
+  void create(int framebuff_cnt, uint16_t depth) {
+    ctx_ = ut22p_tx_ctx_create(framebuff_cnt);
+    ASSERT_NE(ctx_, nullptr);
+    ASSERT_EQ(ut22p_tx_encoder_enable(ctx_, depth), 0);
+  }
+
+  /* app get + put, returns the framebuffer index */
+  int app_frame() {
+    struct st_frame* frame = ut22p_tx_get_frame(ctx_);
+    if (!frame) return -1;
+    int idx = ut22p_tx_frame_idx(frame);
+    if (ut22p_tx_put_frame(ctx_, frame) < 0) return -1;
+    return idx;
+  }
+
+  /* transport next_frame + frame_done, returns the framebuffer index */
+  int transmit() {
+    uint16_t idx;
+    if (ut22p_tx_next_frame(ctx_, &idx) < 0) return -1;
+    if (ut22p_tx_frame_done(ctx_, idx) < 0) return -1;
+    return idx;
+  }
+};
+
+TEST_F(St22pTxEncodePipelineTest, DepthLimitsFramesInFlight) {
+  create(4, 2);
+  for (int i = 0; i < 3; i++) ASSERT_GE(app_frame(), 0);
+
+  struct st22_encode_frame_meta* a = ut22p_tx_encode_get(ctx_);
+  struct st22_encode_frame_meta* b = ut22p_tx_encode_get(ctx_);
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  EXPECT_EQ(ut22p_tx_encode_get(ctx_), nullptr) << "depth 2 reached";
+  EXPECT_EQ(ut22p_tx_stat_encode_depth_max(ctx_), 2u);
+
+  ASSERT_EQ(ut22p_tx_encode_put(ctx_, a, 0), 0);
+  struct st22_encode_frame_meta* c = ut22p_tx_encode_get(ctx_);
+  ASSERT_NE(c, nullptr) << "put frees one slot of the depth";
+  ASSERT_EQ(ut22p_tx_encode_put(ctx_, b, 0), 0);
+  ASSERT_EQ(ut22p_tx_encode_put(ctx_, c, 0), 0);
+  for (int i = 0; i < 3; i++) EXPECT_GE(transmit(), 0);
+  EXPECT_EQ(ut22p_tx_all_free(ctx_), 1);
+}
+
+TEST_F(St22pTxEncodePipelineTest, OutOfOrderEncodeTransmitsInOrder) {
+  create(4, 3);
+  int first = app_frame();
+  int second = app_frame();
+  int third = app_frame();
+  ASSERT_GE(first, 0);
+  ASSERT_GE(second, 0);
+  ASSERT_GE(third, 0);
+
+  struct st22_encode_frame_meta* a = ut22p_tx_encode_get(ctx_);
+  struct st22_encode_frame_meta* b = ut22p_tx_encode_get(ctx_);
+  struct st22_encode_frame_meta* c = ut22p_tx_encode_get(ctx_);
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  ASSERT_NE(c, nullptr);
+  EXPECT_EQ(ut22p_tx_encode_frame_idx(a), first);
+  EXPECT_EQ(ut22p_tx_encode_frame_idx(b), second);
+  EXPECT_EQ(ut22p_tx_encode_frame_idx(c), third);
+
+  /* the last frame finishes first */
+  ASSERT_EQ(ut22p_tx_encode_put(ctx_, c, 0), 0);
+  EXPECT_EQ(transmit(), -1) << "older frames still in the encoder";
+  ASSERT_EQ(ut22p_tx_encode_put(ctx_, b, 0), 0);
+  EXPECT_EQ(transmit(), -1) << "the oldest frame still in the encoder";
+  EXPECT_GE(ut22p_tx_stat_encode_out_of_order(ctx_), 2u);
+  EXPECT_GE(ut22p_tx_stat_encode_wait_order(ctx_), 2u);
+
+  ASSERT_EQ(ut22p_tx_encode_put(ctx_, a, 0), 0);
+  EXPECT_EQ(transmit(), first);
+  EXPECT_EQ(transmit(), second);
+  EXPECT_EQ(transmit(), third);
+  EXPECT_EQ(ut22p_tx_all_free(ctx_), 1);
+}
+
+/* The encoder gets the oldest READY frame, not the lowest framebuffer index. */
+TEST_F(St22pTxEncodePipelineTest, EncoderGetsOldestFirst) {
+  create(2, 1);
+  int first = app_frame();
+  int second = app_frame();
+  ASSERT_GE(first, 0);
+  ASSERT_GE(second, 0);
+
+  struct st22_encode_frame_meta* a = ut22p_tx_encode_get(ctx_);
+  ASSERT_NE(a, nullptr);
+  EXPECT_EQ(ut22p_tx_encode_frame_idx(a), first);
+  ASSERT_EQ(ut22p_tx_encode_put(ctx_, a, 0), 0);
+  EXPECT_EQ(transmit(), first);
+
+  /* reuses the freed framebuffer, a lower index but newer than second */
+  int third = app_frame();
+  ASSERT_EQ(third, first);
+
+  struct st22_encode_frame_meta* b = ut22p_tx_encode_get(ctx_);
+  ASSERT_NE(b, nullptr);
+  EXPECT_EQ(ut22p_tx_encode_frame_idx(b), second);
+  ASSERT_EQ(ut22p_tx_encode_put(ctx_, b, 0), 0);
+  EXPECT_EQ(transmit(), second);
+
+  struct st22_encode_frame_meta* c = ut22p_tx_encode_get(ctx_);
+  ASSERT_NE(c, nullptr);
+  ASSERT_EQ(ut22p_tx_encode_put(ctx_, c, 0), 0);
+  EXPECT_EQ(transmit(), third);
+}
+
+/* A failed encode frees its frame, the younger frames are not held forever. */
+TEST_F(St22pTxEncodePipelineTest, FailedEncodeReleasesOrder) {
+  create(3, 2);
+  int first = app_frame();
+  int second = app_frame();
+  ASSERT_GE(first, 0);
+  ASSERT_GE(second, 0);
+
+  struct st22_encode_frame_meta* a = ut22p_tx_encode_get(ctx_);
+  struct st22_encode_frame_meta* b = ut22p_tx_encode_get(ctx_);
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+
+  ASSERT_EQ(ut22p_tx_encode_put(ctx_, b, 0), 0);
+  EXPECT_EQ(transmit(), -1);
+  ASSERT_EQ(ut22p_tx_encode_put(ctx_, a, -EIO), 0);
+  EXPECT_EQ(ut22p_tx_frame_stat(ctx_, first), 0 /* FREE */);
+  EXPECT_EQ(transmit(), second);
+  EXPECT_EQ(ut22p_tx_all_free(ctx_), 1);
+}
+
+}  // namespace
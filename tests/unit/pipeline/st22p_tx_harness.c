@@ -26,6 +26,8 @@ struct ut22p_tx_ctx {
   struct st22p_tx_frame* framebuffs;
   int framebuff_cnt;
   uint64_t mock_ptp_ns;
+  /* encoder mode */
+  struct st22_encode_dev_impl encode_dev;
 };
 
 #include "pipeline/st22p_tx_harness.h"
@@ -53,15 +55,28 @@ ut22p_tx_ctx* ut22p_tx_ctx_create(int framebuff_cnt) {
     free(ctx);
     return NULL;
   }
+  struct st22p_tx_ctx* p = &ctx->pipeline;
+  /* mirrors production init: every framebuf starts FREE and queued */
+  p->free_queue = st_frame_queue_create("ut_free", framebuff_cnt, rte_socket_id());
+  p->ready_queue = st_frame_queue_create("ut_ready", framebuff_cnt, rte_socket_id());
+  p->encoded_queue = st_frame_queue_create("ut_encoded", framebuff_cnt, rte_socket_id());
+  if (!p->free_queue || !p->ready_queue || !p->encoded_queue) {
+    st_frame_queue_free(p->free_queue);
+    st_frame_queue_free(p->ready_queue);
+    st_frame_queue_free(p->encoded_queue);
+    free(ctx->framebuffs);
+    free(ctx);
+    return NULL;
+  }
   for (int i = 0; i < framebuff_cnt; i++) {
     ctx->framebuffs[i].stat = ST22P_TX_FRAME_FREE;
     ctx->framebuffs[i].idx = i;
     /* derive path: tx_st22p_user_frame() returns &dst, so put_frame() recovers
      * the framebuf via dst.priv. */
     ctx->framebuffs[i].dst.priv = &ctx->framebuffs[i];
+    st_frame_queue_put(p->free_queue, &ctx->framebuffs[i]);
   }
 
-  struct st22p_tx_ctx* p = &ctx->pipeline;
   p->impl = &ctx->impl;
   p->idx = 0;
   p->socket_id = rte_socket_id();
@@ -83,6 +98,9 @@ ut22p_tx_ctx* ut22p_tx_ctx_create(int framebuff_cnt) {
 
 void ut22p_tx_ctx_destroy(ut22p_tx_ctx* ctx) {
   if (!ctx) return;
+  st_frame_queue_free(ctx->pipeline.free_queue);
+  st_frame_queue_free(ctx->pipeline.ready_queue);
+  st_frame_queue_free(ctx->pipeline.encoded_queue);
   free(ctx->framebuffs);
   free(ctx);
 }
@@ -152,3 +170,52 @@ int ut22p_tx_all_free(const ut22p_tx_ctx* ctx) {
 int ut22p_tx_frame_stat(const ut22p_tx_ctx* ctx, int i) {
   return (int)ctx->framebuffs[i].stat;
 }
+
+/* ── pipelined encode ─────────────────────────────────────────────── */
+
+int ut22p_tx_encoder_enable(ut22p_tx_ctx* ctx, uint16_t depth) {
+  struct st22p_tx_ctx* p = &ctx->pipeline;
+  struct st22_encode_session_impl* session = &ctx->encode_dev.sessions[0];
+
+  session->parent = &ctx->encode_dev;
+  session->codestream_max_size = ST22_ENCODE_MIN_FRAME_SZ * 2;
+  p->encode_impl = session;
+  p->encode_depth = depth;
+  p->derive = false;
+  /* not derive: tx_st22p_user_frame() returns &src */
+  for (int i = 0; i < ctx->framebuff_cnt; i++) {
+    struct st22p_tx_frame* framebuff = &ctx->framebuffs[i];
+    framebuff->src.priv = framebuff;
+    framebuff->encode_frame.src = &framebuff->src;
+    framebuff->encode_frame.dst = &framebuff->dst;
+    framebuff->encode_frame.priv = framebuff;
+  }
+  return 0;
+}
+
+struct st22_encode_frame_meta* ut22p_tx_encode_get(ut22p_tx_ctx* ctx) {
+  return tx_st22p_encode_get_frame(&ctx->pipeline);
+}
+
+int ut22p_tx_encode_put(ut22p_tx_ctx* ctx, struct st22_encode_frame_meta* frame,
+                        int result) {
+  frame->dst->data_size = ST22_ENCODE_MIN_FRAME_SZ + 1;
+  return tx_st22p_encode_put_frame(&ctx->pipeline, frame, result);
+}
+
+int ut22p_tx_encode_frame_idx(const struct st22_encode_frame_meta* frame) {
+  const struct st22p_tx_frame* framebuff = frame->priv;
+  return framebuff->idx;
+}
+
+uint32_t ut22p_tx_stat_encode_depth_max(ut22p_tx_ctx* ctx) {
+  return atomic_load(&ctx->pipeline.stat_encode_depth_max);
+}
+
+uint32_t ut22p_tx_stat_encode_out_of_order(ut22p_tx_ctx* ctx) {
+  return atomic_load(&ctx->pipeline.stat_encode_out_of_order);
+}
+
+uint32_t ut22p_tx_stat_encode_wait_order(const ut22p_tx_ctx* ctx) {
+  return ctx->pipeline.stat_encode_wait_order;
+}
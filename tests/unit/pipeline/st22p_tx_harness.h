@@ -75,6 +75,18 @@ int ut22p_tx_all_free(const ut22p_tx_ctx* ctx);
 /* Raw stat value of framebuffer i (for diagnostics). */
 int ut22p_tx_frame_stat(const ut22p_tx_ctx* ctx, int i);
 
+/* pipelined encode: switch the ctx to the encoder path with a stub encoder
+ * which holds at most depth frames, put_frame then moves a frame to READY. */
+int ut22p_tx_encoder_enable(ut22p_tx_ctx* ctx, uint16_t depth);
+/* encoder (plugin) side, put sets a valid codestream size */
+struct st22_encode_frame_meta* ut22p_tx_encode_get(ut22p_tx_ctx* ctx);
+int ut22p_tx_encode_put(ut22p_tx_ctx* ctx, struct st22_encode_frame_meta* frame,
+                        int result);
+int ut22p_tx_encode_frame_idx(const struct st22_encode_frame_meta* frame);
+uint32_t ut22p_tx_stat_encode_depth_max(ut22p_tx_ctx* ctx);
+uint32_t ut22p_tx_stat_encode_out_of_order(ut22p_tx_ctx* ctx);
+uint32_t ut22p_tx_stat_encode_wait_order(const ut22p_tx_ctx* ctx);
+
 #ifdef __cplusplus
 }
 #endif
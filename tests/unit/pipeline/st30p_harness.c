@@ -84,14 +84,25 @@ ut30p_ctx* ut30p_ctx_create(int framebuff_cnt) {
     free(ctx);
     return NULL;
   }
+  struct st30p_rx_ctx* p = &ctx->pipeline;
+  /* mirrors production init: every framebuf starts FREE and queued */
+  p->free_queue = st_frame_queue_create("ut_free", framebuff_cnt, rte_socket_id());
+  p->ready_queue = st_frame_queue_create("ut_ready", framebuff_cnt, rte_socket_id());
+  if (!p->free_queue || !p->ready_queue) {
+    st_frame_queue_free(p->free_queue);
+    st_frame_queue_free(p->ready_queue);
+    free(ctx->framebuffs);
+    free(ctx);
+    return NULL;
+  }
   for (int i = 0; i < framebuff_cnt; i++) {
     ctx->framebuffs[i].stat = ST30P_RX_FRAME_FREE;
     ctx->framebuffs[i].idx = i;
     /* mirrors production init: put_frame() recovers framebuf via frame->priv */
     ctx->framebuffs[i].frame.priv = &ctx->framebuffs[i];
+    st_frame_queue_put(p->free_queue, &ctx->framebuffs[i]);
   }
 
-  struct st30p_rx_ctx* p = &ctx->pipeline;
   p->impl = &ctx->impl;
   p->idx = 0;
   p->socket_id = rte_socket_id();
@@ -106,6 +117,8 @@ ut30p_ctx* ut30p_ctx_create(int framebuff_cnt) {
 
 void ut30p_ctx_destroy(ut30p_ctx* ctx) {
   if (!ctx) return;
+  st_frame_queue_free(ctx->pipeline.free_queue);
+  st_frame_queue_free(ctx->pipeline.ready_queue);
   free(ctx->framebuffs);
   free(ctx);
 }
@@ -0,0 +1,255 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * st30p PCM sample format conversion (st_pcm_convert) tests.
+ *
+ *   - the wire samples to S32 and F32 are the exact msb aligned values;
+ *   - wire to S32 to wire is lossless for every format and layout;
+ *   - F32 to the wire is clamped to the full scale, a NaN is the negative full scale;
+ *   - the channel map picks and repeats channels on rx, unmapped channels are silent
+ *     on tx;
+ *   - the AVX2 and AVX512 kernels equal the scalar kernels, also on the tails;
+ *   - AM824, the wire app format and the bad frame sizes or maps are rejected.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "pipeline/st30p_pcm_harness.h"
+
+namespace {
+
+const enum st30_fmt kFmts[] = {ST30_FMT_PCM8, ST30_FMT_PCM16, ST30_FMT_PCM24};
+const enum st30p_sample_fmt kAppFmts[] = {ST30P_SAMPLE_FMT_S32, ST30P_SAMPLE_FMT_F32};
+
+uint32_t sample_size(enum st30_fmt fmt) {
+  return (fmt == ST30_FMT_PCM8) ? 1 : ((fmt == ST30_FMT_PCM16) ? 2 : 3);
+}
+
+/* the reference: the two's complement value of the wire sample in the msb bits */
+int32_t ref_s32(const uint8_t* p, enum st30_fmt fmt) {
+  if (fmt == ST30_FMT_PCM8) return (int32_t)(int8_t)(p[0] ^ 0x80) * (1 << 24);
+  if (fmt == ST30_FMT_PCM16) return (int32_t)(int16_t)(p[0] << 8 | p[1]) * (1 << 16);
+  int32_t v = p[0] << 16 | p[1] << 8 | p[2];
+  if (v & 0x800000) v -= 0x1000000;
+  return v * 256;
+}
+
+std::vector<uint8_t> pattern(size_t size, uint32_t seed) {
+  std::vector<uint8_t> buf(size);
+  uint32_t v = seed;
+  for (auto& b : buf) {
+    v = v * 1103515245u + 12345u;
+    b = v >> 16;
+  }
+  return buf;
+}
+
+bool simd_supported(enum mtl_simd_level level) {
+  return mtl_get_simd_level() >= level;
+}
+
+TEST(St30pPcmConvertTest, ToAppIsExact) {
+  const uint16_t channel = 6;
+  const uint32_t samples = 48;
+
+  for (auto fmt : kFmts) {
+    size_t wire_size = (size_t)sample_size(fmt) * channel * samples;
+    std::vector<uint8_t> wire = pattern(wire_size, 1);
+    for (auto app_fmt : kAppFmts) {
+      for (bool planar : {false, true}) {
+        std::vector<int32_t> app(channel * samples);
+        ASSERT_EQ(utpcm_to_app_level(fmt, channel, wire_size, app_fmt, planar, 0,
+                                     nullptr, MTL_SIMD_LEVEL_MAX, wire.data(),
+                                     app.data()),
+                  0);
+        for (uint32_t s = 0; s < samples; s++) {
+          for (uint16_t c = 0; c < channel; c++) {
+            int32_t ref = ref_s32(&wire[(s * channel + c) * sample_size(fmt)], fmt);
+            size_t i = planar ? (size_t)c * samples + s : (size_t)s * channel + c;
+            if (app_fmt == ST30P_SAMPLE_FMT_S32) {
+              ASSERT_EQ(app[i], ref) << "fmt " << fmt << " s " << s << " c " << c;
+            } else {
+              float f;
+              memcpy(&f, &app[i], sizeof(f));
+              ASSERT_EQ(f, std::ldexp((float)ref, -31))
+                  << "fmt " << fmt << " s " << s << " c " << c;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(St30pPcmConvertTest, RoundTripIsLossless) {
+  const uint16_t channel = 5;
+  const uint32_t samples = 37;
+
+  for (auto fmt : kFmts) {
+    size_t wire_size = (size_t)sample_size(fmt) * channel * samples;
+    std::vector<uint8_t> wire = pattern(wire_size, 2);
+    for (auto app_fmt : kAppFmts) {
+      for (bool planar : {false, true}) {
+        std::vector<int32_t> app(channel * samples);
+        std::vector<uint8_t> back(wire_size);
+        ASSERT_EQ(utpcm_to_app_level(fmt, channel, wire_size, app_fmt, planar, 0,
+                                     nullptr, MTL_SIMD_LEVEL_MAX, wire.data(),
+                                     app.data()),
+                  0);
+        ASSERT_EQ(utpcm_to_wire_level(fmt, channel, wire_size, app_fmt, planar, 0,
+                                      nullptr, MTL_SIMD_LEVEL_MAX, app.data(),
+                                      back.data()),
+                  0);
+        EXPECT_EQ(back, wire) << "fmt " << fmt << " app fmt " << app_fmt << " planar "
+                              << planar;
+      }
+    }
+  }
+}
+
+TEST(St30pPcmConvertTest, F32IsClamped) {
+  const float in[] = {1.5f, -2.0f, NAN, INFINITY, -INFINITY, 0.5f, -0.5f, 0.0f};
+  const uint16_t expect[] = {0x7fff, 0x8000, 0x8000, 0x7fff,
+                             0x8000, 0x4000, 0xc000, 0x0000};
+  const uint32_t samples = sizeof(in) / sizeof(in[0]);
+  std::vector<uint8_t> wire(samples * 2);
+
+  ASSERT_EQ(utpcm_to_wire_level(ST30_FMT_PCM16, 1, wire.size(), ST30P_SAMPLE_FMT_F32,
+                                false, 0, nullptr, MTL_SIMD_LEVEL_MAX, in, wire.data()),
+            0);
+  for (uint32_t i = 0; i < samples; i++)
+    EXPECT_EQ((uint16_t)(wire[i * 2] << 8 | wire[i * 2 + 1]), expect[i]) << "i " << i;
+}
+
+TEST(St30pPcmConvertTest, ChannelMap) {
+  const uint16_t channel = 8;
+  const uint32_t samples = 12;
+  const uint16_t rx_map[] = {5, 0, 5};
+  const uint16_t tx_map[] = {2, 7};
+  size_t wire_size = 3 * channel * samples;
+  std::vector<uint8_t> wire = pattern(wire_size, 3);
+
+  /* rx, a subset with the channel 5 twice */
+  std::vector<int32_t> app(3 * samples);
+  ASSERT_EQ(utpcm_to_app_level(ST30_FMT_PCM24, channel, wire_size, ST30P_SAMPLE_FMT_S32,
+                               true, 3, rx_map, MTL_SIMD_LEVEL_MAX, wire.data(),
+                               app.data()),
+            0);
+  for (uint32_t s = 0; s < samples; s++) {
+    for (uint16_t c = 0; c < 3; c++) {
+      int32_t ref = ref_s32(&wire[(s * channel + rx_map[c]) * 3], ST30_FMT_PCM24);
+      ASSERT_EQ(app[c * samples + s], ref) << "s " << s << " c " << c;
+    }
+  }
+
+  /* tx, two app channels to the channel 2 and 7, the others silent */
+  for (auto fmt : kFmts) {
+    size_t size = (size_t)sample_size(fmt) * channel * samples;
+    std::vector<int32_t> src(2 * samples);
+    std::vector<uint8_t> out(size, 0x55);
+    for (uint32_t i = 0; i < src.size(); i++) src[i] = (int32_t)(0x12345678u * (i + 1));
+    ASSERT_EQ(utpcm_to_wire_level(fmt, channel, size, ST30P_SAMPLE_FMT_S32, false, 2,
+                                  tx_map, MTL_SIMD_LEVEL_MAX, src.data(), out.data()),
+              0);
+    uint8_t silence = (fmt == ST30_FMT_PCM8) ? 0x80 : 0x00;
+    for (uint32_t s = 0; s < samples; s++) {
+      for (uint16_t w = 0; w < channel; w++) {
+        const uint8_t* p = &out[(s * channel + w) * sample_size(fmt)];
+        if (w == 2 || w == 7) {
+          int32_t v = src[s * 2 + (w == 2 ? 0 : 1)];
+          int32_t mask = (int32_t)(0xffffffffu << (32 - 8 * sample_size(fmt)));
+          ASSERT_EQ(ref_s32(p, fmt), v & mask) << "fmt " << fmt << " s " << s;
+        } else {
+          for (uint32_t b = 0; b < sample_size(fmt); b++)
+            ASSERT_EQ(p[b], b ? 0x00 : silence) << "fmt " << fmt << " w " << w;
+        }
+      }
+    }
+  }
+}
+
+TEST(St30pPcmConvertTest, SimdEqualsScalar) {
+  const enum mtl_simd_level levels[] = {MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX512};
+  const uint16_t map[] = {9, 3, 3, 0, 15, 7, 1};
+  const uint16_t channel = 16;
+  const uint32_t samples = 45;
+
+  for (auto level : levels) {
+    if (!simd_supported(level)) continue;
+    for (auto fmt : kFmts) {
+      size_t wire_size = (size_t)sample_size(fmt) * channel * samples;
+      std::vector<uint8_t> wire = pattern(wire_size, 4);
+      for (auto app_fmt : kAppFmts) {
+        for (bool planar : {false, true}) {
+          for (const uint16_t* m : {(const uint16_t*)nullptr, map}) {
+            uint16_t app_channel = m ? 7 : channel;
+            std::vector<int32_t> simd(app_channel * samples);
+            std::vector<int32_t> scalar(app_channel * samples);
+            ASSERT_EQ(utpcm_to_app_level(fmt, channel, wire_size, app_fmt, planar,
+                                         app_channel, m, level, wire.data(),
+                                         simd.data()),
+                      0);
+            ASSERT_EQ(utpcm_to_app_level(fmt, channel, wire_size, app_fmt, planar,
+                                         app_channel, m, MTL_SIMD_LEVEL_NONE,
+                                         wire.data(), scalar.data()),
+                      0);
+            EXPECT_EQ(memcmp(simd.data(), scalar.data(), simd.size() * 4), 0)
+                << "to app level " << level << " fmt " << fmt << " app fmt " << app_fmt
+                << " planar " << planar;
+
+            /* to wire from any bit pattern, also the NaN and the out of range floats */
+            std::vector<uint8_t> app = pattern(app_channel * samples * 4, 5);
+            std::vector<uint8_t> out_simd(wire_size), out_scalar(wire_size);
+            ASSERT_EQ(utpcm_to_wire_level(fmt, channel, wire_size, app_fmt, planar,
+                                          app_channel, m, level, app.data(),
+                                          out_simd.data()),
+                      0);
+            ASSERT_EQ(utpcm_to_wire_level(fmt, channel, wire_size, app_fmt, planar,
+                                          app_channel, m, MTL_SIMD_LEVEL_NONE,
+                                          app.data(), out_scalar.data()),
+                      0);
+            EXPECT_EQ(out_simd, out_scalar)
+                << "to wire level " << level << " fmt " << fmt << " app fmt "
+                << app_fmt << " planar " << planar;
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(St30pPcmConvertTest, RejectInvalid) {
+  const uint16_t bad_map[] = {0, 8};
+
+  EXPECT_EQ(utpcm_app_frame_size(ST31_FMT_AM824, 2, 2 * 4 * 48, ST30P_SAMPLE_FMT_S32,
+                                 false, 0, nullptr),
+            0u)
+      << "am824";
+  EXPECT_EQ(utpcm_app_frame_size(ST30_FMT_PCM24, 2, 2 * 3 * 48, ST30P_SAMPLE_FMT_WIRE,
+                                 false, 0, nullptr),
+            0u)
+      << "wire app fmt";
+  EXPECT_EQ(utpcm_app_frame_size(ST30_FMT_PCM24, 2, 2 * 3 * 48 + 1, ST30P_SAMPLE_FMT_S32,
+                                 false, 0, nullptr),
+            0u)
+      << "partial sample row";
+  EXPECT_EQ(utpcm_app_frame_size(ST30_FMT_PCM24, 8, 8 * 3 * 48, ST30P_SAMPLE_FMT_S32,
+                                 false, 2, bad_map),
+            0u)
+      << "map over the channel";
+  EXPECT_EQ(utpcm_app_frame_size(ST30_FMT_PCM24, 2, 2 * 3 * 48, ST30P_SAMPLE_FMT_S32,
+                                 false, 4, nullptr),
+            0u)
+      << "app channel over the channel";
+  /* a subset of the first channels needs no map */
+  EXPECT_EQ(utpcm_app_frame_size(ST30_FMT_PCM16, 8, 8 * 2 * 48, ST30P_SAMPLE_FMT_F32,
+                                 true, 2, nullptr),
+            2u * 48 * 4);
+}
+
+}  // namespace
@@ -0,0 +1,52 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness for the st30p PCM sample format conversion unit tests.
+ */
+
+#include "st2110/st_pcm_convert.h"
+
+#include "pipeline/st30p_pcm_harness.h"
+
+size_t utpcm_app_frame_size(enum st30_fmt wire_fmt, uint16_t wire_channel,
+                            size_t wire_frame_size, enum st30p_sample_fmt app_fmt,
+                            bool planar, uint16_t app_channel, const uint16_t* map) {
+  struct st_pcm_converter* cvt = st_pcm_converter_create(
+      wire_fmt, wire_channel, wire_frame_size, app_fmt, planar, app_channel, map);
+  size_t size;
+
+  if (!cvt) return 0;
+  size = cvt->app_frame_size;
+  st_pcm_converter_free(cvt);
+  return size;
+}
+
+int utpcm_to_app_level(enum st30_fmt wire_fmt, uint16_t wire_channel,
+                       size_t wire_frame_size, enum st30p_sample_fmt app_fmt, bool planar,
+                       uint16_t app_channel, const uint16_t* map,
+                       enum mtl_simd_level level, const void* wire, void* app) {
+  struct st_pcm_converter* cvt = st_pcm_converter_create(
+      wire_fmt, wire_channel, wire_frame_size, app_fmt, planar, app_channel, map);
+  int ret;
+
+  if (!cvt) return -EINVAL;
+  cvt->simd_level = level;
+  ret = st_pcm_converter_to_app(cvt, wire, app);
+  st_pcm_converter_free(cvt);
+  return ret;
+}
+
+int utpcm_to_wire_level(enum st30_fmt wire_fmt, uint16_t wire_channel,
+                        size_t wire_frame_size, enum st30p_sample_fmt app_fmt,
+                        bool planar, uint16_t app_channel, const uint16_t* map,
+                        enum mtl_simd_level level, const void* app, void* wire) {
+  struct st_pcm_converter* cvt = st_pcm_converter_create(
+      wire_fmt, wire_channel, wire_frame_size, app_fmt, planar, app_channel, map);
+  int ret;
+
+  if (!cvt) return -EINVAL;
+  cvt->simd_level = level;
+  ret = st_pcm_converter_to_wire(cvt, app, wire);
+  st_pcm_converter_free(cvt);
+  return ret;
+}
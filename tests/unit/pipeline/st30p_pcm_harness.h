@@ -0,0 +1,45 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C header for the st30p PCM sample format conversion (st_pcm_convert) unit tests.
+ *
+ * The converter is the production one; the simd level can be forced to compare the
+ * AVX2 and AVX512 kernels against the scalar reference.
+ */
+
+#ifndef _ST30P_PCM_HARNESS_H_
+#define _ST30P_PCM_HARNESS_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mtl_api.h"
+#include "st30_pipeline_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The app frame size of the conversion, 0 if it is rejected. */
+size_t utpcm_app_frame_size(enum st30_fmt wire_fmt, uint16_t wire_channel,
+                            size_t wire_frame_size, enum st30p_sample_fmt app_fmt,
+                            bool planar, uint16_t app_channel, const uint16_t* map);
+
+/** One wire frame to the app frame with the converter forced to the simd level. */
+int utpcm_to_app_level(enum st30_fmt wire_fmt, uint16_t wire_channel,
+                       size_t wire_frame_size, enum st30p_sample_fmt app_fmt, bool planar,
+                       uint16_t app_channel, const uint16_t* map,
+                       enum mtl_simd_level level, const void* wire, void* app);
+
+/** One app frame to the wire frame with the converter forced to the simd level. */
+int utpcm_to_wire_level(enum st30_fmt wire_fmt, uint16_t wire_channel,
+                        size_t wire_frame_size, enum st30p_sample_fmt app_fmt,
+                        bool planar, uint16_t app_channel, const uint16_t* map,
+                        enum mtl_simd_level level, const void* app, void* wire);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -58,14 +58,25 @@ ut30p_tx_ctx* ut30p_tx_ctx_create(int framebuff_cnt) {
     free(ctx);
     return NULL;
   }
+  struct st30p_tx_ctx* p = &ctx->pipeline;
+  /* mirrors production init: every framebuf starts FREE and queued */
+  p->free_queue = st_frame_queue_create("ut_free", framebuff_cnt, rte_socket_id());
+  p->ready_queue = st_frame_queue_create("ut_ready", framebuff_cnt, rte_socket_id());
+  if (!p->free_queue || !p->ready_queue) {
+    st_frame_queue_free(p->free_queue);
+    st_frame_queue_free(p->ready_queue);
+    free(ctx->framebuffs);
+    free(ctx);
+    return NULL;
+  }
   for (int i = 0; i < framebuff_cnt; i++) {
     ctx->framebuffs[i].stat = ST30P_TX_FRAME_FREE;
     ctx->framebuffs[i].idx = i;
     /* mirrors production init: put_frame() recovers framebuf via frame->priv */
     ctx->framebuffs[i].frame.priv = &ctx->framebuffs[i];
+    st_frame_queue_put(p->free_queue, &ctx->framebuffs[i]);
   }
 
-  struct st30p_tx_ctx* p = &ctx->pipeline;
   p->impl = &ctx->impl;
   p->idx = 0;
   p->socket_id = rte_socket_id();
@@ -85,6 +96,8 @@ ut30p_tx_ctx* ut30p_tx_ctx_create(int framebuff_cnt) {
 
 void ut30p_tx_ctx_destroy(ut30p_tx_ctx* ctx) {
   if (!ctx) return;
+  st_frame_queue_free(ctx->pipeline.free_queue);
+  st_frame_queue_free(ctx->pipeline.ready_queue);
   free(ctx->framebuffs);
   free(ctx);
 }
@@ -114,7 +127,18 @@ int ut30p_tx_frame_done(ut30p_tx_ctx* ctx, uint16_t idx) {
 }
 
 void ut30p_tx_set_frame_ready(ut30p_tx_ctx* ctx, int idx) {
-  __atomic_store_n(&ctx->framebuffs[idx].stat, ST30P_TX_FRAME_READY, __ATOMIC_RELEASE);
+  struct st30p_tx_ctx* p = &ctx->pipeline;
+  struct st30p_tx_frame* framebuff = &ctx->framebuffs[idx];
+
+  /* take it out of the free queue as get_frame() would, keep the others queued */
+  unsigned int cnt = st_frame_queue_count(p->free_queue);
+  for (unsigned int i = 0; i < cnt; i++) {
+    struct st30p_tx_frame* queued = st_frame_queue_get(p->free_queue);
+    if (!queued) break;
+    if (queued != framebuff) st_frame_queue_put(p->free_queue, queued);
+  }
+  __atomic_store_n(&framebuff->stat, ST30P_TX_FRAME_READY, __ATOMIC_RELEASE);
+  st_frame_queue_put(p->ready_queue, framebuff);
 }
 
 int ut30p_tx_frame_idx(const struct st30_frame* frame) {
@@ -84,14 +84,26 @@ ut40p_ctx* ut40p_ctx_create(int framebuff_cnt) {
     free(ctx);
     return NULL;
   }
+  struct st40p_rx_ctx* p = &ctx->pipeline;
+  /* mirrors production init: every framebuf starts FREE and queued */
+  p->free_queue = st_frame_queue_create("ut_free", framebuff_cnt, rte_socket_id());
+  p->ready_queue = st_frame_queue_create("ut_ready", framebuff_cnt, rte_socket_id());
+  if (!p->free_queue || !p->ready_queue) {
+    st_frame_queue_free(p->free_queue);
+    st_frame_queue_free(p->ready_queue);
+    free(ctx->framebuffs);
+    free(ctx);
+    return NULL;
+  }
   for (int i = 0; i < framebuff_cnt; i++) {
     ctx->framebuffs[i].stat = ST40P_RX_FRAME_FREE;
     ctx->framebuffs[i].idx = i;
     ctx->framebuffs[i].frame_info.priv = &ctx->framebuffs[i];
     ctx->framebuffs[i].frame_info.meta = ctx->framebuffs[i].meta;
+    ctx->framebuffs[i].frame_info.meta_cap = ST40_MAX_META;
+    st_frame_queue_put(p->free_queue, &ctx->framebuffs[i]);
   }
 
-  struct st40p_rx_ctx* p = &ctx->pipeline;
   p->impl = &ctx->impl;
   p->idx = 0;
   p->socket_id = rte_socket_id();
@@ -108,6 +120,8 @@ ut40p_ctx* ut40p_ctx_create(int framebuff_cnt) {
 
 void ut40p_ctx_destroy(ut40p_ctx* ctx) {
   if (!ctx) return;
+  st_frame_queue_free(ctx->pipeline.free_queue);
+  st_frame_queue_free(ctx->pipeline.ready_queue);
   free(ctx->framebuffs);
   free(ctx);
 }
@@ -48,6 +48,18 @@ ut40p_tx_ctx* ut40p_tx_ctx_create(int framebuff_cnt) {
     free(ctx);
     return NULL;
   }
+  struct st40p_tx_ctx* p = &ctx->pipeline;
+  /* mirrors production init: every framebuf starts FREE and queued */
+  p->free_queue = st_frame_queue_create("ut_free", framebuff_cnt, rte_socket_id());
+  p->ready_queue = st_frame_queue_create("ut_ready", framebuff_cnt, rte_socket_id());
+  if (!p->free_queue || !p->ready_queue) {
+    st_frame_queue_free(p->free_queue);
+    st_frame_queue_free(p->ready_queue);
+    free(ctx->anc_frames);
+    free(ctx->framebuffs);
+    free(ctx);
+    return NULL;
+  }
   for (int i = 0; i < framebuff_cnt; i++) {
     ctx->framebuffs[i].stat = ST40P_TX_FRAME_FREE;
     ctx->framebuffs[i].idx = i;
@@ -55,9 +67,9 @@ ut40p_tx_ctx* ut40p_tx_ctx_create(int framebuff_cnt) {
     ctx->framebuffs[i].frame_info.priv = &ctx->framebuffs[i];
     /* put_frame() writes meta_num/data_size into the assigned anc frame */
     ctx->framebuffs[i].anc_frame = &ctx->anc_frames[i];
+    st_frame_queue_put(p->free_queue, &ctx->framebuffs[i]);
   }
 
-  struct st40p_tx_ctx* p = &ctx->pipeline;
   p->impl = &ctx->impl;
   p->idx = 0;
   p->socket_id = rte_socket_id();
@@ -76,6 +88,8 @@ ut40p_tx_ctx* ut40p_tx_ctx_create(int framebuff_cnt) {
 
 void ut40p_tx_ctx_destroy(ut40p_tx_ctx* ctx) {
   if (!ctx) return;
+  st_frame_queue_free(ctx->pipeline.free_queue);
+  st_frame_queue_free(ctx->pipeline.ready_queue);
   free(ctx->anc_frames);
   free(ctx->framebuffs);
   free(ctx);
@@ -106,7 +120,18 @@ int ut40p_tx_frame_done(ut40p_tx_ctx* ctx, uint16_t idx) {
 }
 
 void ut40p_tx_set_frame_ready(ut40p_tx_ctx* ctx, int idx) {
-  __atomic_store_n(&ctx->framebuffs[idx].stat, ST40P_TX_FRAME_READY, __ATOMIC_RELEASE);
+  struct st40p_tx_ctx* p = &ctx->pipeline;
+  struct st40p_tx_frame* framebuff = &ctx->framebuffs[idx];
+
+  /* take it out of the free queue as get_frame() would, keep the others queued */
+  unsigned int cnt = st_frame_queue_count(p->free_queue);
+  for (unsigned int i = 0; i < cnt; i++) {
+    struct st40p_tx_frame* queued = st_frame_queue_get(p->free_queue);
+    if (!queued) break;
+    if (queued != framebuff) st_frame_queue_put(p->free_queue, queued);
+  }
+  __atomic_store_n(&framebuff->stat, ST40P_TX_FRAME_READY, __ATOMIC_RELEASE);
+  st_frame_queue_put(p->ready_queue, framebuff);
 }
 
 int ut40p_tx_frame_idx(const struct st40_frame_info* frame) {
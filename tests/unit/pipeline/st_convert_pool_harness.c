@@ -0,0 +1,213 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness for the converter pool unit tests. Includes the production
+ * translation unit, the stat register of the pool is mocked as there is no
+ * stat manager in the bare impl.
+ */
+
+/* mt_main.h defines _GNU_SOURCE, but the system headers are included first here;
+ * define it so the cpu set macros are exposed to st_convert_pool.c. */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mt_stat.h"
+
+static int ut_stat_register(struct mtl_main_impl* impl, mt_stat_cb_t cb, void* priv,
+                            char* name) {
+  MTL_MAY_UNUSED(impl);
+  MTL_MAY_UNUSED(cb);
+  MTL_MAY_UNUSED(priv);
+  MTL_MAY_UNUSED(name);
+  return 0;
+}
+
+static int ut_stat_unregister(struct mtl_main_impl* impl, mt_stat_cb_t cb, void* priv) {
+  MTL_MAY_UNUSED(impl);
+  MTL_MAY_UNUSED(cb);
+  MTL_MAY_UNUSED(priv);
+  return 0;
+}
+
+#undef MTL_HAS_USDT
+#define mt_stat_register ut_stat_register
+#define mt_stat_unregister ut_stat_unregister
+#include "st2110/pipeline/st_convert_pool.c"
+#undef mt_stat_unregister
+#undef mt_stat_register
+
+#include "common/ut_common.h"
+#include "st2110/st_convert.h"
+#include "st2110/st_fmt.h"
+
+struct utcp_ctx {
+  struct mtl_main_impl impl;
+  struct st_convert_pool* pool;
+};
+
+#include "pipeline/st_convert_pool_harness.h"
+
+/* the calls of the fake converter in one utcp_run_fake */
+static struct {
+  pthread_mutex_t lock;
+  pthread_t caller;
+  struct st_frame* frame;
+  uint32_t fail_line;
+  struct utcp_band bands[UTCP_MAX_CALLS];
+  int bands_nb;
+} utcp_fake = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+static int utcp_fake_convert(struct st_frame* src, struct st_frame* dst) {
+  uint32_t line =
+      ((uint8_t*)dst->addr[0] - (uint8_t*)utcp_fake.frame->addr[0]) / dst->linesize[0];
+  int ret = 0;
+  MTL_MAY_UNUSED(src);
+
+  pthread_mutex_lock(&utcp_fake.lock);
+  if (utcp_fake.bands_nb < UTCP_MAX_CALLS) {
+    struct utcp_band* band = &utcp_fake.bands[utcp_fake.bands_nb++];
+    band->line = line;
+    band->lines = dst->height;
+    band->caller = pthread_equal(pthread_self(), utcp_fake.caller);
+  }
+  if (utcp_fake.fail_line >= line && utcp_fake.fail_line < line + dst->height)
+    ret = -EIO;
+  pthread_mutex_unlock(&utcp_fake.lock);
+
+  return ret;
+}
+
+int utcp_init(void) {
+  return ut_eal_init();
+}
+
+utcp_ctx* utcp_create_ctx(uint16_t workers) {
+  utcp_ctx* ctx = calloc(1, sizeof(*ctx));
+  if (!ctx) return NULL;
+
+  mt_get_user_params(&ctx->impl)->convert_threads_per_numa = workers;
+  st_convert_pools_init(&ctx->impl);
+  ctx->pool = st_convert_pool_get(&ctx->impl, 0);
+  if (!ctx->pool) {
+    utcp_destroy_ctx(ctx);
+    return NULL;
+  }
+  return ctx;
+}
+
+void utcp_destroy_ctx(utcp_ctx* ctx) {
+  if (!ctx) return;
+  st_convert_pools_uinit(&ctx->impl);
+  free(ctx);
+}
+
+int utcp_workers(utcp_ctx* ctx) {
+  return ctx->pool->workers_nb;
+}
+
+static int utcp_band_cmp(const void* a, const void* b) {
+  const struct utcp_band* ba = a;
+  const struct utcp_band* bb = b;
+  return (ba->line > bb->line) - (ba->line < bb->line);
+}
+
+int utcp_run_fake(utcp_ctx* ctx, enum st_frame_fmt fmt, uint32_t height,
+                  uint16_t parallel, uint32_t fail_line, struct utcp_band* bands,
+                  int* bands_nb) {
+  struct st_frame_converter converter = {
+      .src_fmt = fmt,
+      .dst_fmt = fmt,
+      .convert_func = utcp_fake_convert,
+  };
+  struct st_frame* src = utcp_frame_alloc(fmt, 64, height);
+  struct st_frame* dst = utcp_frame_alloc(fmt, 64, height);
+  int ret;
+
+  if (!src || !dst) {
+    if (src) utcp_frame_free(src);
+    if (dst) utcp_frame_free(dst);
+    return -ENOMEM;
+  }
+
+  pthread_mutex_lock(&utcp_fake.lock);
+  utcp_fake.caller = pthread_self();
+  utcp_fake.frame = dst;
+  utcp_fake.fail_line = fail_line;
+  utcp_fake.bands_nb = 0;
+  pthread_mutex_unlock(&utcp_fake.lock);
+
+  ret = st_convert_pool_run(ctx->pool, &converter, src, dst, parallel);
+
+  pthread_mutex_lock(&utcp_fake.lock);
+  qsort(utcp_fake.bands, utcp_fake.bands_nb, sizeof(utcp_fake.bands[0]),
+        utcp_band_cmp);
+  memcpy(bands, utcp_fake.bands, sizeof(utcp_fake.bands[0]) * utcp_fake.bands_nb);
+  *bands_nb = utcp_fake.bands_nb;
+  utcp_fake.frame = NULL;
+  pthread_mutex_unlock(&utcp_fake.lock);
+
+  utcp_frame_free(src);
+  utcp_frame_free(dst);
+  return ret;
+}
+
+int utcp_run(utcp_ctx* ctx, struct st_frame* src, struct st_frame* dst,
+             uint16_t parallel) {
+  struct st_frame_converter converter;
+  int ret;
+
+  ret = st_frame_get_converter(src->fmt, dst->fmt, &converter);
+  if (ret < 0) return ret;
+  return st_convert_pool_run(ctx->pool, &converter, src, dst, parallel);
+}
+
+void utcp_stat(utcp_ctx* ctx, uint32_t* frames, uint32_t* bands,
+               uint32_t* bands_inline) {
+  struct st_convert_pool* pool = ctx->pool;
+
+  pthread_mutex_lock(&pool->lock);
+  *frames = pool->stat_frames;
+  *bands = pool->stat_bands;
+  *bands_inline = pool->stat_bands_inline;
+  pthread_mutex_unlock(&pool->lock);
+}
+
+struct st_frame* utcp_frame_alloc(enum st_frame_fmt fmt, uint32_t width,
+                                  uint32_t height) {
+  struct st_frame* frame = calloc(1, sizeof(*frame));
+  if (!frame) return NULL;
+
+  frame->fmt = fmt;
+  frame->width = width;
+  frame->height = height;
+  frame->buffer_size = frame->data_size = st_frame_size(fmt, width, height, false);
+  void* addr = calloc(1, frame->buffer_size);
+  if (!addr) {
+    free(frame);
+    return NULL;
+  }
+  st_frame_init_plane_single_src(frame, addr, 0);
+  return frame;
+}
+
+void utcp_frame_free(struct st_frame* frame) {
+  free(frame->addr[0]);
+  free(frame);
+}
+
+void utcp_frame_fill(struct st_frame* frame, uint32_t seed) {
+  uint8_t* data = frame->addr[0];
+
+  for (size_t i = 0; i < frame->buffer_size; i++)
+    data[i] = (uint8_t)((i * 2654435761u + seed) >> 7);
+}
+
+void utcp_band_view(struct st_frame* frame, struct st_frame* band, uint32_t line,
+                    uint32_t lines) {
+  st_frame_init_band(frame, band, line, lines);
+}
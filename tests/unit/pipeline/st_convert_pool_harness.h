@@ -0,0 +1,73 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C header for the converter pool unit tests.
+ *
+ * The pool is the production one with real worker threads, the stat register is
+ * mocked. A fake converter records the band each call gets, the built-in
+ * converters can be run through the pool also to compare with a whole frame
+ * convert.
+ */
+
+#ifndef _ST_CONVERT_POOL_HARNESS_H_
+#define _ST_CONVERT_POOL_HARNESS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mtl_api.h"
+#include "st_pipeline_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UTCP_MAX_CALLS (64)
+
+typedef struct utcp_ctx utcp_ctx;
+
+/** One call of the fake converter. */
+struct utcp_band {
+  uint32_t line;  /* first line of the band in the frame */
+  uint32_t lines; /* lines of the band */
+  bool caller;    /* run by the thread of st_convert_pool_run */
+};
+
+int utcp_init(void);
+/** Create the pool of numa 0 with workers threads, NULL on fail. */
+utcp_ctx* utcp_create_ctx(uint16_t workers);
+void utcp_destroy_ctx(utcp_ctx* ctx);
+int utcp_workers(utcp_ctx* ctx);
+
+/**
+ * Run a frame of fmt and height through the pool with the fake converter, the band
+ * including fail_line returns -EIO (pass UINT32_MAX for no fail). The bands are
+ * sorted by line into bands, return the result of the pool run.
+ */
+int utcp_run_fake(utcp_ctx* ctx, enum st_frame_fmt fmt, uint32_t height,
+                  uint16_t parallel, uint32_t fail_line, struct utcp_band* bands,
+                  int* bands_nb);
+
+/** Run the built-in converter of src to dst fmt through the pool. */
+int utcp_run(utcp_ctx* ctx, struct st_frame* src, struct st_frame* dst,
+             uint16_t parallel);
+
+/** The frames, bands and bands run inline of the pool since create. */
+void utcp_stat(utcp_ctx* ctx, uint32_t* frames, uint32_t* bands,
+               uint32_t* bands_inline);
+
+/** Alloc a frame with the planes in one buffer as the pipeline does, NULL on fail. */
+struct st_frame* utcp_frame_alloc(enum st_frame_fmt fmt, uint32_t width,
+                                  uint32_t height);
+void utcp_frame_free(struct st_frame* frame);
+/** Fill the frame buffer with a deterministic pattern. */
+void utcp_frame_fill(struct st_frame* frame, uint32_t seed);
+/** The st_frame_init_band view of the frame. */
+void utcp_band_view(struct st_frame* frame, struct st_frame* band, uint32_t line,
+                    uint32_t lines);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,266 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * Converter pool: the frame is split into line bands, the caller converts the
+ * first band and the workers the others, the run returns after all bands.
+ *
+ * Build: meson setup build_unit -Denable_unit_tests=true && ninja -C build_unit
+ * Run:   ./build_unit/tests/unit/UnitTest --gtest_filter='StConvertPool*'
+ */
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "pipeline/st_convert_pool_harness.h"
+
+namespace {
+
+constexpr uint32_t kNoFail = UINT32_MAX;
+
+/* the bands are contiguous and cover all the lines */
+void expect_cover(const std::vector<utcp_band>& bands, uint32_t height) {
+  uint32_t line = 0;
+  for (const auto& band : bands) {
+    EXPECT_EQ(band.line, line);
+    EXPECT_GT(band.lines, 0u);
+    line += band.lines;
+  }
+  EXPECT_EQ(line, height);
+}
+
+bool frame_equal(const st_frame* a, const st_frame* b) {
+  return a->buffer_size == b->buffer_size &&
+         !memcmp(a->addr[0], b->addr[0], a->buffer_size);
+}
+
+}  // namespace
+
+class StConvertPoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_EQ(utcp_init(), 0) << "EAL init failed";
+  }
+
+  void TearDown() override {
+    utcp_destroy_ctx(ctx_);
+    ctx_ = nullptr;
+  }
+
+  void create(uint16_t workers) {
+    ctx_ = utcp_create_ctx(workers);
+    ASSERT_NE(ctx_, nullptr);
+  }
+
+  std::vector<utcp_band> run_fake(st_frame_fmt fmt, uint32_t height, uint16_t parallel,
+                                  uint32_t fail_line = kNoFail, int* ret = nullptr) {
+    utcp_band bands[UTCP_MAX_CALLS];
+    int bands_nb = 0;
+    int r = utcp_run_fake(ctx_, fmt, height, parallel, fail_line, bands, &bands_nb);
+    if (ret)
+      *ret = r;
+    else
+      EXPECT_EQ(r, 0);
+    return std::vector<utcp_band>(bands, bands + bands_nb);
+  }
+
+  utcp_ctx* ctx_ = nullptr;
+};
+
+TEST_F(StConvertPoolTest, BandsSplitToWorkers) {
+  create(4);
+  auto bands = run_fake(ST_FRAME_FMT_YUV422PLANAR10LE, 1080, 4);
+
+  ASSERT_EQ(bands.size(), 4u);
+  expect_cover(bands, 1080);
+  for (const auto& band : bands) EXPECT_EQ(band.lines, 270u);
+  /* the caller converts the first band, the workers the others */
+  EXPECT_TRUE(bands[0].caller);
+  for (size_t i = 1; i < bands.size(); i++) EXPECT_FALSE(bands[i].caller) << i;
+}
+
+TEST_F(StConvertPoolTest, Bands420EvenLines) {
+  create(8);
+  auto bands = run_fake(ST_FRAME_FMT_YUV420PLANAR8, 1080, 7);
+
+  ASSERT_EQ(bands.size(), 7u);
+  expect_cover(bands, 1080);
+  for (const auto& band : bands) {
+    EXPECT_EQ(band.line % 2, 0u);
+    EXPECT_EQ(band.lines % 2, 0u);
+  }
+}
+
+TEST_F(StConvertPoolTest, ParallelCappedByWorkers) {
+  create(2);
+  auto bands = run_fake(ST_FRAME_FMT_YUV422PLANAR10LE, 1080, 8);
+
+  ASSERT_EQ(bands.size(), 3u);
+  expect_cover(bands, 1080);
+}
+
+TEST_F(StConvertPoolTest, ParallelCappedByMaxBands) {
+  /* the workers are capped to the max of the pool, one more band for the caller */
+  create(UINT16_MAX);
+  int workers = utcp_workers(ctx_);
+  auto bands = run_fake(ST_FRAME_FMT_YUV422PLANAR10LE, 2160, UINT16_MAX);
+
+  ASSERT_EQ(bands.size(), static_cast<size_t>(workers + 1));
+  expect_cover(bands, 2160);
+}
+
+TEST_F(StConvertPoolTest, SingleBandOnCaller) {
+  create(4);
+
+  auto bands = run_fake(ST_FRAME_FMT_YUV422PLANAR10LE, 1080, 1);
+  ASSERT_EQ(bands.size(), 1u);
+  EXPECT_TRUE(bands[0].caller);
+  EXPECT_EQ(bands[0].lines, 1080u);
+
+  /* too few lines to split a 420 frame */
+  bands = run_fake(ST_FRAME_FMT_YUV420PLANAR8, 2, 4);
+  ASSERT_EQ(bands.size(), 1u);
+  EXPECT_TRUE(bands[0].caller);
+  EXPECT_EQ(bands[0].lines, 2u);
+
+  uint32_t frames, total, inline_bands;
+  utcp_stat(ctx_, &frames, &total, &inline_bands);
+  EXPECT_EQ(frames, 0u);
+}
+
+TEST_F(StConvertPoolTest, ErrorOfWorkerBand) {
+  create(4);
+  int ret = 0;
+  auto bands = run_fake(ST_FRAME_FMT_YUV422PLANAR10LE, 1080, 4, 700, &ret);
+
+  EXPECT_EQ(ret, -EIO);
+  /* all the bands are still finished before the run returns */
+  ASSERT_EQ(bands.size(), 4u);
+  expect_cover(bands, 1080);
+
+  bands = run_fake(ST_FRAME_FMT_YUV422PLANAR10LE, 1080, 4, 0, &ret);
+  EXPECT_EQ(ret, -EIO);
+  EXPECT_EQ(bands.size(), 4u);
+}
+
+TEST_F(StConvertPoolTest, Stat) {
+  create(3);
+  run_fake(ST_FRAME_FMT_YUV422PLANAR10LE, 1080, 4);
+  run_fake(ST_FRAME_FMT_YUV422PLANAR10LE, 1080, 2);
+
+  uint32_t frames, bands, inline_bands;
+  utcp_stat(ctx_, &frames, &bands, &inline_bands);
+  EXPECT_EQ(frames, 2u);
+  EXPECT_EQ(bands, 6u);
+  EXPECT_EQ(inline_bands, 0u);
+}
+
+TEST_F(StConvertPoolTest, MatchesWholeFrameConvert) {
+  create(4);
+  const struct {
+    st_frame_fmt src;
+    st_frame_fmt dst;
+  } cases[] = {
+      {ST_FRAME_FMT_YUV422RFC4175PG2BE10, ST_FRAME_FMT_YUV420PLANAR8},
+      {ST_FRAME_FMT_YUV422PLANAR10LE, ST_FRAME_FMT_YUV422RFC4175PG2BE10},
+  };
+
+  for (const auto& c : cases) {
+    st_frame* src = utcp_frame_alloc(c.src, 1920, 1080);
+    st_frame* ref = utcp_frame_alloc(c.dst, 1920, 1080);
+    st_frame* dst = utcp_frame_alloc(c.dst, 1920, 1080);
+    ASSERT_TRUE(src && ref && dst);
+    utcp_frame_fill(src, 7);
+
+    ASSERT_EQ(st_frame_convert(src, ref), 0);
+    for (uint16_t parallel : {2, 3, 5}) {
+      memset(dst->addr[0], 0, dst->buffer_size);
+      ASSERT_EQ(utcp_run(ctx_, src, dst, parallel), 0);
+      EXPECT_TRUE(frame_equal(ref, dst))
+          << st_frame_fmt_name(c.src) << " to " << st_frame_fmt_name(c.dst)
+          << " parallel " << parallel;
+    }
+
+    utcp_frame_free(src);
+    utcp_frame_free(ref);
+    utcp_frame_free(dst);
+  }
+}
+
+TEST_F(StConvertPoolTest, ConcurrentCallers) {
+  create(4);
+  constexpr int kCallers = 4;
+  constexpr int kFrames = 20;
+  st_frame* src = utcp_frame_alloc(ST_FRAME_FMT_YUV422RFC4175PG2BE10, 640, 360);
+  st_frame* ref = utcp_frame_alloc(ST_FRAME_FMT_YUV420PLANAR8, 640, 360);
+  ASSERT_TRUE(src && ref);
+  utcp_frame_fill(src, 3);
+  ASSERT_EQ(st_frame_convert(src, ref), 0);
+
+  std::vector<int> mismatch(kCallers, 0);
+  std::vector<std::thread> callers;
+  for (int i = 0; i < kCallers; i++) {
+    callers.emplace_back([&, i]() {
+      st_frame* dst = utcp_frame_alloc(ST_FRAME_FMT_YUV420PLANAR8, 640, 360);
+      if (!dst) {
+        mismatch[i] = kFrames;
+        return;
+      }
+      for (int f = 0; f < kFrames; f++) {
+        memset(dst->addr[0], 0, dst->buffer_size);
+        if (utcp_run(ctx_, src, dst, 4) < 0 || !frame_equal(ref, dst)) mismatch[i]++;
+      }
+      utcp_frame_free(dst);
+    });
+  }
+  for (auto& t : callers) t.join();
+
+  for (int i = 0; i < kCallers; i++) EXPECT_EQ(mismatch[i], 0) << "caller " << i;
+  uint32_t frames, bands, inline_bands;
+  utcp_stat(ctx_, &frames, &bands, &inline_bands);
+  EXPECT_EQ(frames, static_cast<uint32_t>(kCallers * kFrames));
+
+  utcp_frame_free(src);
+  utcp_frame_free(ref);
+}
+
+TEST(StConvertPoolBandTest, Yuv420p8ChromaRows) {
+  st_frame* frame = utcp_frame_alloc(ST_FRAME_FMT_YUV420PLANAR8, 1920, 1080);
+  ASSERT_NE(frame, nullptr);
+  st_frame band;
+
+  utcp_band_view(frame, &band, 540, 270);
+  EXPECT_EQ(band.height, 270u);
+  EXPECT_FALSE(band.interlaced);
+  EXPECT_EQ(static_cast<uint8_t*>(band.addr[0]) - static_cast<uint8_t*>(frame->addr[0]),
+            static_cast<ptrdiff_t>(frame->linesize[0] * 540));
+  /* a chroma row of 960 samples spans two linesize of 480 */
+  for (int plane = 1; plane < 3; plane++) {
+    EXPECT_EQ(frame->linesize[plane], 480u);
+    EXPECT_EQ(static_cast<uint8_t*>(band.addr[plane]) -
+                  static_cast<uint8_t*>(frame->addr[plane]),
+              static_cast<ptrdiff_t>(960 * 270))
+        << plane;
+  }
+  utcp_frame_free(frame);
+}
+
+TEST(StConvertPoolBandTest, Yuv422p10leRows) {
+  st_frame* frame = utcp_frame_alloc(ST_FRAME_FMT_YUV422PLANAR10LE, 1920, 1080);
+  ASSERT_NE(frame, nullptr);
+  st_frame band;
+
+  utcp_band_view(frame, &band, 100, 20);
+  EXPECT_EQ(band.height, 20u);
+  for (int plane = 0; plane < 3; plane++) {
+    EXPECT_EQ(band.linesize[plane], frame->linesize[plane]);
+    EXPECT_EQ(static_cast<uint8_t*>(band.addr[plane]) -
+                  static_cast<uint8_t*>(frame->addr[plane]),
+              static_cast<ptrdiff_t>(frame->linesize[plane] * 100))
+        << plane;
+  }
+  utcp_frame_free(frame);
+}
@@ -0,0 +1,178 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness for the converter simd level select unit tests. Includes the
+ * production translation unit with the cpu simd level and the monotonic time
+ * mocked, the time only advances by the fake converter.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#undef MTL_HAS_USDT
+#include "st2110/st_main.h"
+
+static enum mtl_simd_level ut_get_simd_level(void);
+static uint64_t ut_get_monotonic_time(void);
+
+#define mtl_get_simd_level ut_get_simd_level
+#define mt_get_monotonic_time ut_get_monotonic_time
+#include "st2110/pipeline/st_convert_select.c"
+#undef mt_get_monotonic_time
+#undef mtl_get_simd_level
+
+#include "common/ut_common.h"
+
+struct utcs_ctx {
+  struct mtl_main_impl impl;
+};
+
+#include "pipeline/st_convert_select_harness.h"
+
+static struct {
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  enum mtl_simd_level cpu_level;
+  uint64_t level_ns[MTL_SIMD_LEVEL_MAX];
+  bool fail;
+  uint32_t hold_width;
+  int held;
+  int converts;
+} utcs = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .cond = PTHREAD_COND_INITIALIZER,
+    .cpu_level = MTL_SIMD_LEVEL_AVX512,
+};
+
+/* per thread as the benchmarks of two sessions can run at the same time */
+static __thread uint64_t utcs_clock;
+
+static enum mtl_simd_level ut_get_simd_level(void) {
+  return utcs.cpu_level;
+}
+
+static uint64_t ut_get_monotonic_time(void) {
+  return utcs_clock;
+}
+
+static int utcs_fake_convert(struct st_frame* src, struct st_frame* dst,
+                             enum mtl_simd_level level) {
+  int ret = 0;
+  MTL_MAY_UNUSED(src);
+
+  if (level >= MTL_SIMD_LEVEL_MAX) level = utcs.cpu_level;
+  pthread_mutex_lock(&utcs.lock);
+  utcs.converts++;
+  while (utcs.hold_width && utcs.hold_width == dst->width) {
+    utcs.held++;
+    pthread_cond_wait(&utcs.cond, &utcs.lock);
+    utcs.held--;
+  }
+  utcs_clock += utcs.level_ns[level];
+  if (utcs.fail) ret = -EIO;
+  pthread_mutex_unlock(&utcs.lock);
+
+  return ret;
+}
+
+int utcs_init(void) {
+  return ut_eal_init();
+}
+
+utcs_ctx* utcs_create_ctx(const char* cache_path) {
+  utcs_ctx* ctx = calloc(1, sizeof(*ctx));
+  if (!ctx) return NULL;
+
+  mt_get_user_params(&ctx->impl)->convert_select_cache = cache_path;
+  if (st_convert_select_init(&ctx->impl) < 0) {
+    free(ctx);
+    return NULL;
+  }
+  return ctx;
+}
+
+void utcs_destroy_ctx(utcs_ctx* ctx) {
+  if (!ctx) return;
+  st_convert_select_uinit(&ctx->impl);
+  free(ctx);
+}
+
+const char* utcs_cpu_model(utcs_ctx* ctx) {
+  return ctx->impl.convert_select_mgr.cpu_model;
+}
+
+int utcs_entries(utcs_ctx* ctx) {
+  struct st_convert_select_mgr* mgr = &ctx->impl.convert_select_mgr;
+  int entries;
+
+  pthread_mutex_lock(&mgr->lock);
+  entries = mgr->entries_nb;
+  pthread_mutex_unlock(&mgr->lock);
+  return entries;
+}
+
+void utcs_set_cpu_level(enum mtl_simd_level level) {
+  utcs.cpu_level = level;
+}
+
+void utcs_set_level_ns(enum mtl_simd_level level, uint64_t ns) {
+  if (level < MTL_SIMD_LEVEL_MAX) utcs.level_ns[level] = ns;
+}
+
+void utcs_set_fail(bool fail) {
+  utcs.fail = fail;
+}
+
+void utcs_hold_width(uint32_t width) {
+  pthread_mutex_lock(&utcs.lock);
+  utcs.hold_width = width;
+  pthread_cond_broadcast(&utcs.cond);
+  pthread_mutex_unlock(&utcs.lock);
+}
+
+int utcs_held(void) {
+  int held;
+
+  pthread_mutex_lock(&utcs.lock);
+  held = utcs.held;
+  pthread_mutex_unlock(&utcs.lock);
+  return held;
+}
+
+int utcs_converts(void) {
+  int converts;
+
+  pthread_mutex_lock(&utcs.lock);
+  converts = utcs.converts;
+  pthread_mutex_unlock(&utcs.lock);
+  return converts;
+}
+
+int utcs_bench_converts(void) {
+  /* the max level run first, then all the levels from the cpu level down to none */
+  return (CVT_SELECT_WARMUP + CVT_SELECT_LOOPS) * (utcs.cpu_level + 2);
+}
+
+int utcs_select(utcs_ctx* ctx, uint32_t width, uint32_t height,
+                enum mtl_simd_level* level, uint64_t* ns, uint64_t* max_ns,
+                bool* cached) {
+  struct st_frame_converter converter = {
+      .src_fmt = ST_FRAME_FMT_YUV422PLANAR10LE,
+      .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+      .convert_simd_func = utcs_fake_convert,
+      .simd_level = MTL_SIMD_LEVEL_MAX,
+  };
+  struct st_convert_select_entry result;
+  int ret;
+
+  memset(&result, 0, sizeof(result));
+  ret = st_convert_select(&ctx->impl, &converter, width, height, false, 0, &result,
+                          cached);
+  if (ret < 0) return ret;
+  if (converter.simd_level != result.level) return -EFAULT;
+  *level = result.level;
+  *ns = result.ns;
+  *max_ns = result.max_ns;
+  return 0;
+}
@@ -0,0 +1,55 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C header for the converter simd level select unit tests.
+ *
+ * The select runs a fake built-in converter, the cpu simd level and the monotonic
+ * time are mocked so each level costs the ns set by the test. The fake converter of
+ * one width can be held to check the benchmark runs out of the manager lock.
+ */
+
+#ifndef _ST_CONVERT_SELECT_HARNESS_H_
+#define _ST_CONVERT_SELECT_HARNESS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mtl_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct utcs_ctx utcs_ctx;
+
+int utcs_init(void);
+/** Create the select manager with the cache file path, NULL for no file. */
+utcs_ctx* utcs_create_ctx(const char* cache_path);
+void utcs_destroy_ctx(utcs_ctx* ctx);
+/** The cpu model the cache lines are keyed by. */
+const char* utcs_cpu_model(utcs_ctx* ctx);
+/** The entries in the memory table. */
+int utcs_entries(utcs_ctx* ctx);
+
+/** The mocked cpu level, the ns one frame costs at level and the fail of converts. */
+void utcs_set_cpu_level(enum mtl_simd_level level);
+void utcs_set_level_ns(enum mtl_simd_level level, uint64_t ns);
+void utcs_set_fail(bool fail);
+/** Hold the converts of frames with width until released by 0. */
+void utcs_hold_width(uint32_t width);
+/** The converts blocked by the hold now, and all the converts since init. */
+int utcs_held(void);
+int utcs_converts(void);
+/** The converts of one benchmark at the cpu level. */
+int utcs_bench_converts(void);
+
+/** Select the level of the fake YUV422PLANAR10LE to YUV422RFC4175PG2BE10 converter. */
+int utcs_select(utcs_ctx* ctx, uint32_t width, uint32_t height,
+                enum mtl_simd_level* level, uint64_t* ns, uint64_t* max_ns,
+                bool* cached);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,280 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * Converter simd level select: the cheapest level by benchmark, the results kept in
+ * memory and in the cache file keyed by the cpu model if the user set one.
+ *
+ * Build: meson setup build_unit -Denable_unit_tests=true && ninja -C build_unit
+ * Run:   ./build_unit/tests/unit/UnitTest --gtest_filter='StConvertSelectTest.*'
+ */
+
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "pipeline/st_convert_select_harness.h"
+
+class StConvertSelectTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_EQ(utcs_init(), 0) << "EAL init failed";
+    char tmpl[] = "/tmp/mtl_ut_cvt_select_XXXXXX";
+    ASSERT_NE(mkdtemp(tmpl), nullptr);
+    dir_ = tmpl;
+    path_ = dir_ + "/cache";
+
+    utcs_set_cpu_level(MTL_SIMD_LEVEL_AVX512);
+    utcs_set_level_ns(MTL_SIMD_LEVEL_NONE, 900);
+    utcs_set_level_ns(MTL_SIMD_LEVEL_AVX2, 200);
+    utcs_set_level_ns(MTL_SIMD_LEVEL_AVX512, 300);
+    utcs_set_level_ns(MTL_SIMD_LEVEL_AVX512_VBMI2, 100);
+    utcs_set_fail(false);
+    utcs_hold_width(0);
+  }
+
+  void TearDown() override {
+    utcs_destroy_ctx(ctx_);
+    ctx_ = nullptr;
+    utcs_hold_width(0);
+    unlink((dir_ + "/link").c_str());
+    unlink(path_.c_str());
+    rmdir(dir_.c_str());
+  }
+
+  void create(const char* path) {
+    utcs_destroy_ctx(ctx_);
+    ctx_ = utcs_create_ctx(path);
+    ASSERT_NE(ctx_, nullptr);
+  }
+
+  /* one cache line of this cpu model */
+  std::string line(const char* model, uint32_t w, uint32_t h, int interlaced,
+                   const char* level, uint64_t ns, uint64_t max_ns) {
+    std::ostringstream os;
+    os << model << ";YUV422PLANAR10LE;YUV422RFC4175PG2BE10;" << w << ";" << h << ";"
+       << interlaced << ";" << level << ";" << ns << ";" << max_ns << "\n";
+    return os.str();
+  }
+
+  void write_cache(const std::string& content, mode_t mode = 0600) {
+    std::ofstream f(path_, std::ios::trunc);
+    f << content;
+    f.close();
+    ASSERT_EQ(chmod(path_.c_str(), mode), 0);
+  }
+
+  std::string read_cache() {
+    std::ifstream f(path_);
+    std::stringstream ss;
+    ss << f.rdbuf();
+    return ss.str();
+  }
+
+  int select(uint32_t w, uint32_t h, bool* cached) {
+    return utcs_select(ctx_, w, h, &level_, &ns_, &max_ns_, cached);
+  }
+
+  utcs_ctx* ctx_ = nullptr;
+  std::string dir_;
+  std::string path_;
+  enum mtl_simd_level level_ = MTL_SIMD_LEVEL_MAX;
+  uint64_t ns_ = 0;
+  uint64_t max_ns_ = 0;
+};
+
+TEST_F(StConvertSelectTest, BenchPicksCheapestLevel) {
+  create(nullptr);
+  bool cached = true;
+  int converts = utcs_converts();
+
+  ASSERT_EQ(select(1920, 1080, &cached), 0);
+  EXPECT_FALSE(cached);
+  /* the levels above the cpu level are never run */
+  EXPECT_EQ(level_, MTL_SIMD_LEVEL_AVX2);
+  EXPECT_EQ(ns_, 200u);
+  EXPECT_EQ(max_ns_, 300u);
+  EXPECT_EQ(utcs_converts() - converts, utcs_bench_converts());
+
+  /* the second session of the key uses the memory table */
+  converts = utcs_converts();
+  ASSERT_EQ(select(1920, 1080, &cached), 0);
+  EXPECT_TRUE(cached);
+  EXPECT_EQ(level_, MTL_SIMD_LEVEL_AVX2);
+  EXPECT_EQ(utcs_converts(), converts);
+  EXPECT_EQ(utcs_entries(ctx_), 1);
+}
+
+TEST_F(StConvertSelectTest, LowerLevelHasToBeFaster) {
+  create(nullptr);
+  utcs_set_level_ns(MTL_SIMD_LEVEL_AVX2, 300);
+  bool cached;
+
+  ASSERT_EQ(select(1920, 1080, &cached), 0);
+  EXPECT_EQ(level_, MTL_SIMD_LEVEL_AVX512);
+  EXPECT_EQ(ns_, 300u);
+}
+
+TEST_F(StConvertSelectTest, NoCacheFileByDefault) {
+  create(nullptr);
+  bool cached;
+
+  ASSERT_EQ(select(1280, 720, &cached), 0);
+  EXPECT_FALSE(cached);
+  struct stat st;
+  EXPECT_NE(stat(path_.c_str(), &st), 0);
+
+  /* a new instance benchmarks again */
+  create(nullptr);
+  ASSERT_EQ(select(1280, 720, &cached), 0);
+  EXPECT_FALSE(cached);
+}
+
+TEST_F(StConvertSelectTest, SaveThenLoad) {
+  create(path_.c_str());
+  bool cached;
+
+  ASSERT_EQ(select(3840, 2160, &cached), 0);
+  EXPECT_FALSE(cached);
+  struct stat st;
+  ASSERT_EQ(stat(path_.c_str(), &st), 0);
+  EXPECT_EQ(st.st_mode & 0777, 0600u);
+  EXPECT_EQ(read_cache(), line(utcs_cpu_model(ctx_), 3840, 2160, 0, "avx2", 200, 300));
+
+  /* the next process reads it */
+  create(path_.c_str());
+  int converts = utcs_converts();
+  ASSERT_EQ(select(3840, 2160, &cached), 0);
+  EXPECT_TRUE(cached);
+  EXPECT_EQ(level_, MTL_SIMD_LEVEL_AVX2);
+  EXPECT_EQ(ns_, 200u);
+  EXPECT_EQ(max_ns_, 300u);
+  EXPECT_EQ(utcs_converts(), converts);
+}
+
+TEST_F(StConvertSelectTest, LoadSkipsInvalidLines) {
+  create(path_.c_str());
+  const char* model = utcs_cpu_model(ctx_);
+  std::string content;
+  content += line(model, 1920, 1080, 0, "none", 50, 80);
+  content += line("other cpu", 1280, 720, 0, "none", 50, 80);
+  /* above the cpu level of avx512 */
+  content += line(model, 3840, 2160, 0, "avx512_vbmi", 50, 80);
+  content += line(model, 0, 1080, 0, "none", 50, 80);
+  content += line(model, 100000, 1080, 0, "none", 50, 80);
+  content += line(model, 640, 480, 2, "none", 50, 80);
+  content += line(model, 720, 576, 0, "none", 0, 80);
+  content += line(model, 720, 480, 0, "sse9", 50, 80);
+  content += "garbage\n";
+  write_cache(content);
+
+  bool cached;
+  ASSERT_EQ(select(1920, 1080, &cached), 0);
+  EXPECT_TRUE(cached);
+  EXPECT_EQ(level_, MTL_SIMD_LEVEL_NONE);
+  EXPECT_EQ(ns_, 50u);
+  EXPECT_EQ(utcs_entries(ctx_), 1);
+
+  /* the keys of the skipped lines are benchmarked */
+  for (auto res : {std::make_pair(1280u, 720u), std::make_pair(3840u, 2160u)}) {
+    ASSERT_EQ(select(res.first, res.second, &cached), 0);
+    EXPECT_FALSE(cached) << res.first;
+    EXPECT_EQ(level_, MTL_SIMD_LEVEL_AVX2) << res.first;
+  }
+}
+
+TEST_F(StConvertSelectTest, RefuseFileWritableByOthers) {
+  create(path_.c_str());
+  std::string content = line(utcs_cpu_model(ctx_), 1920, 1080, 0, "none", 50, 80);
+  write_cache(content, 0666);
+
+  bool cached;
+  ASSERT_EQ(select(1920, 1080, &cached), 0);
+  EXPECT_FALSE(cached);
+  EXPECT_EQ(level_, MTL_SIMD_LEVEL_AVX2);
+  /* nor appended to */
+  EXPECT_EQ(read_cache(), content);
+}
+
+TEST_F(StConvertSelectTest, RefuseSymlink) {
+  std::string link = dir_ + "/link";
+  create(link.c_str());
+  write_cache(line(utcs_cpu_model(ctx_), 1920, 1080, 0, "none", 50, 80));
+  ASSERT_EQ(symlink(path_.c_str(), link.c_str()), 0);
+
+  bool cached;
+  ASSERT_EQ(select(1920, 1080, &cached), 0);
+  EXPECT_FALSE(cached);
+  EXPECT_EQ(level_, MTL_SIMD_LEVEL_AVX2);
+}
+
+TEST_F(StConvertSelectTest, BenchFailNotCached) {
+  create(path_.c_str());
+  bool cached;
+
+  utcs_set_fail(true);
+  EXPECT_EQ(select(1920, 1080, &cached), -EIO);
+  EXPECT_EQ(utcs_entries(ctx_), 0);
+  EXPECT_EQ(read_cache(), "");
+
+  utcs_set_fail(false);
+  ASSERT_EQ(select(1920, 1080, &cached), 0);
+  EXPECT_FALSE(cached);
+  EXPECT_EQ(utcs_entries(ctx_), 1);
+}
+
+TEST_F(StConvertSelectTest, BenchOutOfLock) {
+  create(nullptr);
+  utcs_hold_width(1920);
+  int converts = utcs_converts();
+
+  int ret_a = -1;
+  bool cached_a = true;
+  enum mtl_simd_level level_a = MTL_SIMD_LEVEL_MAX;
+  uint64_t ns_a, max_ns_a;
+  std::thread a([&]() {
+    ret_a = utcs_select(ctx_, 1920, 1080, &level_a, &ns_a, &max_ns_a, &cached_a);
+  });
+  for (int i = 0; i < 1000 && !utcs_held(); i++)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  ASSERT_EQ(utcs_held(), 1);
+
+  /* another key is not blocked by the running benchmark */
+  bool cached;
+  ASSERT_EQ(select(1280, 720, &cached), 0);
+  EXPECT_FALSE(cached);
+
+  /* the same key waits for the running one instead of a second benchmark */
+  std::atomic<bool> done_b{false};
+  int ret_b = -1;
+  bool cached_b = false;
+  enum mtl_simd_level level_b = MTL_SIMD_LEVEL_MAX;
+  uint64_t ns_b, max_ns_b;
+  std::thread b([&]() {
+    ret_b = utcs_select(ctx_, 1920, 1080, &level_b, &ns_b, &max_ns_b, &cached_b);
+    done_b = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(done_b);
+  EXPECT_EQ(utcs_held(), 1);
+
+  utcs_hold_width(0);
+  a.join();
+  b.join();
+  EXPECT_EQ(ret_a, 0);
+  EXPECT_EQ(ret_b, 0);
+  EXPECT_FALSE(cached_a);
+  EXPECT_TRUE(cached_b);
+  EXPECT_EQ(level_a, MTL_SIMD_LEVEL_AVX2);
+  EXPECT_EQ(level_b, level_a);
+  EXPECT_EQ(ns_b, ns_a);
+  EXPECT_EQ(utcs_converts() - converts, 2 * utcs_bench_converts());
+  EXPECT_EQ(utcs_entries(ctx_), 2);
+}
@@ -0,0 +1,184 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * 422be10 to NV12 / P010 convert tests.
+ *
+ *   - the chroma of each line pair is the vertical average, not the even line, NV12
+ *     rounds it to nearest and clamps the full scale 10 bits to 255;
+ *   - the SIMD kernels equal the scalar kernels, packed and with padded lines;
+ *   - the packet sized segments of the packet convert equal the frame convert;
+ *   - the 420 semi-planar sizes and an odd height are handled.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "pipeline/st_frame_convert_harness.h"
+#include "st_convert_api.h"
+
+namespace {
+
+uint32_t nv12_chroma(uint16_t c0, uint16_t c1) {
+  uint32_t c = (c0 + c1 + 4u) >> 3;
+  return c > 255u ? 255u : c;
+}
+
+class StFrameConvert420Test : public ::testing::Test {
+ protected:
+  std::vector<struct st_frame*> frames_;
+
+  struct st_frame* alloc(enum st_frame_fmt fmt, uint32_t w, uint32_t h,
+                         uint32_t pad = 0) {
+    struct st_frame* frame = utfc_frame_alloc(fmt, w, h, pad);
+    if (frame) frames_.push_back(frame);
+    return frame;
+  }
+
+  struct st_frame* source(uint32_t w, uint32_t h) {
+    struct st_frame* src = alloc(ST_FRAME_FMT_YUV422RFC4175PG2BE10, w, h);
+    if (src) utfc_be10_fill(src, w + h);
+    return src;
+  }
+
+  void TearDown() override {
+    for (auto* frame : frames_) utfc_frame_free(frame);
+    frames_.clear();
+  }
+};
+
+TEST_F(StFrameConvert420Test, Nv12ChromaIsLinePairAverage) {
+  struct st_frame* src = source(64, 8);
+  struct st_frame* dst = alloc(ST_FRAME_FMT_NV12, 64, 8);
+  ASSERT_NE(src, nullptr);
+  ASSERT_NE(dst, nullptr);
+
+  ASSERT_EQ(utfc_convert_level(src, dst, MTL_SIMD_LEVEL_NONE), 0);
+  for (uint32_t y = 0; y < 8; y += 2) {
+    for (uint32_t x = 0; x < 64; x++) {
+      uint16_t l0, cb0, cr0, l1, cb1, cr1;
+      utfc_be10_pixel(src, x, y, &l0, &cb0, &cr0);
+      utfc_be10_pixel(src, x, y + 1, &l1, &cb1, &cr1);
+      ASSERT_EQ(utfc_sample(dst, 0, x, y), l0 >> 2u) << "x " << x << " y " << y;
+      ASSERT_EQ(utfc_sample(dst, 0, x, y + 1), l1 >> 2u) << "x " << x << " y " << y;
+      if (x % 2) continue;
+      ASSERT_EQ(utfc_sample(dst, 1, x, y / 2), nv12_chroma(cb0, cb1)) << "x " << x;
+      ASSERT_EQ(utfc_sample(dst, 1, x + 1, y / 2), nv12_chroma(cr0, cr1)) << "x " << x;
+    }
+  }
+}
+
+TEST_F(StFrameConvert420Test, Nv12ChromaRoundsAndClamps) {
+  /* 1920 runs the SIMD blocks, 1366 leaves a scalar tail */
+  const uint32_t widths[] = {1920, 1366};
+  const uint16_t chromas[] = {1023, 1020, 514, 3};
+  const enum mtl_simd_level levels[] = {MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_MAX};
+
+  for (auto w : widths) {
+    struct st_frame* src = alloc(ST_FRAME_FMT_YUV422RFC4175PG2BE10, w, 2);
+    struct st_frame* dst = alloc(ST_FRAME_FMT_NV12, w, 2);
+    ASSERT_NE(src, nullptr);
+    ASSERT_NE(dst, nullptr);
+    for (auto chroma : chromas) {
+      utfc_be10_fill_const(src, 512, chroma);
+      for (auto level : levels) {
+        ASSERT_EQ(utfc_convert_level(src, dst, level), 0);
+        for (uint32_t x = 0; x < w; x++)
+          ASSERT_EQ(utfc_sample(dst, 1, x, 0), nv12_chroma(chroma, chroma))
+              << "w " << w << " chroma " << chroma << " level " << level << " x " << x;
+      }
+    }
+  }
+}
+
+TEST_F(StFrameConvert420Test, P010ChromaIsLinePairAverage) {
+  struct st_frame* src = source(64, 8);
+  struct st_frame* dst = alloc(ST_FRAME_FMT_P010, 64, 8);
+  ASSERT_NE(src, nullptr);
+  ASSERT_NE(dst, nullptr);
+
+  ASSERT_EQ(utfc_convert_level(src, dst, MTL_SIMD_LEVEL_NONE), 0);
+  for (uint32_t y = 0; y < 8; y += 2) {
+    for (uint32_t x = 0; x < 64; x++) {
+      uint16_t l0, cb0, cr0, l1, cb1, cr1;
+      utfc_be10_pixel(src, x, y, &l0, &cb0, &cr0);
+      utfc_be10_pixel(src, x, y + 1, &l1, &cb1, &cr1);
+      ASSERT_EQ(utfc_sample(dst, 0, x, y), (uint32_t)l0 << 6) << "x " << x;
+      ASSERT_EQ(utfc_sample(dst, 0, x, y + 1), (uint32_t)l1 << 6) << "x " << x;
+      if (x % 2) continue;
+      ASSERT_EQ(utfc_sample(dst, 1, x, y / 2), ((cb0 + cb1 + 1u) >> 1) << 6) << "x " << x;
+      ASSERT_EQ(utfc_sample(dst, 1, x + 1, y / 2), ((cr0 + cr1 + 1u) >> 1) << 6)
+          << "x " << x;
+    }
+  }
+}
+
+TEST_F(StFrameConvert420Test, SimdEqualsScalar) {
+  /* 1920 is a multiple of the SIMD block, 1366 leaves a scalar tail */
+  const uint32_t widths[] = {1920, 1366};
+  const enum st_frame_fmt fmts[] = {ST_FRAME_FMT_NV12, ST_FRAME_FMT_P010};
+
+  for (auto w : widths) {
+    struct st_frame* src = source(w, 16);
+    ASSERT_NE(src, nullptr);
+    for (auto fmt : fmts) {
+      struct st_frame* ref = alloc(fmt, w, 16);
+      struct st_frame* packed = alloc(fmt, w, 16);
+      struct st_frame* padded = alloc(fmt, w, 16, 64);
+      ASSERT_NE(ref, nullptr);
+      ASSERT_NE(packed, nullptr);
+      ASSERT_NE(padded, nullptr);
+
+      ASSERT_EQ(utfc_convert_level(src, ref, MTL_SIMD_LEVEL_NONE), 0);
+      ASSERT_EQ(utfc_convert_level(src, packed, MTL_SIMD_LEVEL_MAX), 0);
+      ASSERT_EQ(utfc_convert_level(src, padded, MTL_SIMD_LEVEL_MAX), 0);
+      EXPECT_TRUE(utfc_frame_equal(ref, packed)) << "fmt " << fmt << " w " << w;
+      EXPECT_TRUE(utfc_frame_equal(ref, padded)) << "fmt " << fmt << " w " << w;
+    }
+  }
+}
+
+TEST_F(StFrameConvert420Test, PacketSegmentsEqualFrame) {
+  const enum st_frame_fmt fmts[] = {ST_FRAME_FMT_NV12, ST_FRAME_FMT_P010};
+  struct st_frame* src = source(1920, 8);
+  ASSERT_NE(src, nullptr);
+
+  for (auto fmt : fmts) {
+    struct st_frame* ref = alloc(fmt, 1920, 8);
+    struct st_frame* pkt = alloc(fmt, 1920, 8);
+    ASSERT_NE(ref, nullptr);
+    ASSERT_NE(pkt, nullptr);
+
+    ASSERT_EQ(utfc_convert_level(src, ref, MTL_SIMD_LEVEL_MAX), 0);
+    /* 240 pgs is the 1200 bytes payload, 7 pgs cuts the SIMD blocks */
+    ASSERT_EQ(utfc_convert_segments(src, pkt, 240), 0);
+    EXPECT_TRUE(utfc_frame_equal(ref, pkt)) << "fmt " << fmt;
+    ASSERT_EQ(utfc_convert_segments(src, pkt, 7), 0);
+    EXPECT_TRUE(utfc_frame_equal(ref, pkt)) << "fmt " << fmt;
+  }
+}
+
+TEST_F(StFrameConvert420Test, SemiPlanarSizes) {
+  EXPECT_EQ(st_frame_fmt_planes(ST_FRAME_FMT_NV12), 2);
+  EXPECT_EQ(st_frame_fmt_planes(ST_FRAME_FMT_P010), 2);
+  EXPECT_EQ(st_frame_size(ST_FRAME_FMT_NV12, 1920, 1080, false), 1920u * 1080 * 3 / 2);
+  EXPECT_EQ(st_frame_size(ST_FRAME_FMT_P010, 1920, 1080, false), 1920u * 1080 * 3);
+  EXPECT_EQ(st_frame_least_linesize(ST_FRAME_FMT_NV12, 1920, 0), 1920u);
+  EXPECT_EQ(st_frame_least_linesize(ST_FRAME_FMT_NV12, 1920, 1), 1920u);
+  EXPECT_EQ(st_frame_least_linesize(ST_FRAME_FMT_P010, 1920, 0), 3840u);
+  EXPECT_EQ(st_frame_least_linesize(ST_FRAME_FMT_P010, 1920, 1), 3840u);
+}
+
+TEST_F(StFrameConvert420Test, OddHeightRejected) {
+  struct st_frame* src = source(64, 8);
+  ASSERT_NE(src, nullptr);
+  std::vector<uint8_t> y(64 * 7), uv(64 * 4);
+
+  EXPECT_LT(st20_rfc4175_422be10_to_nv12_simd(
+                (struct st20_rfc4175_422_10_pg2_be*)src->addr[0], y.data(), uv.data(),
+                64, 7, MTL_SIMD_LEVEL_MAX),
+            0);
+}
+
+}  // namespace
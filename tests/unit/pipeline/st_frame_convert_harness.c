@@ -0,0 +1,155 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness for the 422be10 to 420 semi-planar convert unit tests.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "st2110/st_convert.h"
+#include "st2110/st_fmt.h"
+
+#include "pipeline/st_frame_convert_harness.h"
+
+static uint32_t utfc_plane_height(struct st_frame* frame, uint8_t plane) {
+  if (plane && st_frame_fmt_get_sampling(frame->fmt) == ST_FRAME_SAMPLING_420)
+    return frame->height / 2;
+  return frame->height;
+}
+
+static uint8_t utfc_sample_bytes(struct st_frame* frame) {
+  return (frame->fmt == ST_FRAME_FMT_P010) ? 2 : 1;
+}
+
+struct st_frame* utfc_frame_alloc(enum st_frame_fmt fmt, uint32_t width, uint32_t height,
+                                  uint32_t pad) {
+  struct st_frame* frame = calloc(1, sizeof(*frame));
+  if (!frame) return NULL;
+
+  frame->fmt = fmt;
+  frame->width = width;
+  frame->height = height;
+  for (uint8_t plane = 0; plane < st_frame_fmt_planes(fmt); plane++) {
+    frame->linesize[plane] = st_frame_least_linesize(fmt, width, plane) + pad;
+    frame->addr[plane] = calloc(utfc_plane_height(frame, plane), frame->linesize[plane]);
+    if (!frame->addr[plane]) {
+      utfc_frame_free(frame);
+      return NULL;
+    }
+  }
+  frame->buffer_size = frame->data_size = st_frame_size(fmt, width, height, false);
+  return frame;
+}
+
+void utfc_frame_free(struct st_frame* frame) {
+  for (uint8_t plane = 0; plane < ST_MAX_PLANES; plane++) free(frame->addr[plane]);
+  free(frame);
+}
+
+static struct st20_rfc4175_422_10_pg2_be* utfc_be10_pg(struct st_frame* frame, uint32_t x,
+                                                       uint32_t y) {
+  uint8_t* line = (uint8_t*)frame->addr[0] + frame->linesize[0] * y;
+  return (struct st20_rfc4175_422_10_pg2_be*)line + x / 2;
+}
+
+void utfc_be10_fill(struct st_frame* frame, uint32_t seed) {
+  for (uint32_t y = 0; y < frame->height; y++) {
+    for (uint32_t x = 0; x < frame->width; x += 2) {
+      struct st20_rfc4175_422_10_pg2_be* pg = utfc_be10_pg(frame, x, y);
+      uint32_t v = (x * 7 + y * 13 + (x * y + seed) % 97) * 2654435761u;
+      uint16_t cb = (v >> 4) & 0x3FF, y0 = (v >> 8) & 0x3FF;
+      uint16_t cr = (v >> 14) & 0x3FF, y1 = (v >> 22) & 0x3FF;
+
+      pg->Cb00 = cb >> 2;
+      pg->Cb00_ = cb;
+      pg->Y00 = y0 >> 4;
+      pg->Y00_ = y0;
+      pg->Cr00 = cr >> 6;
+      pg->Cr00_ = cr;
+      pg->Y01 = y1 >> 8;
+      pg->Y01_ = y1;
+    }
+  }
+}
+
+void utfc_be10_fill_const(struct st_frame* frame, uint16_t luma, uint16_t chroma) {
+  for (uint32_t y = 0; y < frame->height; y++) {
+    for (uint32_t x = 0; x < frame->width; x += 2) {
+      struct st20_rfc4175_422_10_pg2_be* pg = utfc_be10_pg(frame, x, y);
+
+      pg->Cb00 = chroma >> 2;
+      pg->Cb00_ = chroma;
+      pg->Y00 = luma >> 4;
+      pg->Y00_ = luma;
+      pg->Cr00 = chroma >> 6;
+      pg->Cr00_ = chroma;
+      pg->Y01 = luma >> 8;
+      pg->Y01_ = luma;
+    }
+  }
+}
+
+void utfc_be10_pixel(struct st_frame* frame, uint32_t x, uint32_t y, uint16_t* luma,
+                     uint16_t* cb, uint16_t* cr) {
+  uint16_t y0, y1;
+
+  st20_unpack_pg2be_422le10(utfc_be10_pg(frame, x, y), cb, &y0, cr, &y1);
+  *luma = (x % 2) ? y1 : y0;
+}
+
+uint32_t utfc_sample(struct st_frame* frame, uint8_t plane, uint32_t x, uint32_t y) {
+  uint8_t* line = (uint8_t*)frame->addr[plane] + frame->linesize[plane] * y;
+  if (utfc_sample_bytes(frame) == 1) return line[x];
+  return ((uint16_t*)line)[x];
+}
+
+int utfc_convert_level(struct st_frame* src, struct st_frame* dst,
+                       enum mtl_simd_level level) {
+  struct st_frame_converter converter;
+  int ret;
+
+  ret = st_frame_get_converter(src->fmt, dst->fmt, &converter);
+  if (ret < 0) return ret;
+  converter.simd_level = level;
+  return st_frame_converter_convert(&converter, src, dst);
+}
+
+int utfc_convert_segments(struct st_frame* src, struct st_frame* dst, uint32_t seg_pgs) {
+  uint8_t bytes = utfc_sample_bytes(dst);
+  uint32_t line_pgs = src->width / 2;
+  int ret;
+
+  for (uint32_t line = 0; line + 1 < src->height; line += 2) {
+    for (uint32_t pg = 0; pg < line_pgs; pg += seg_pgs) {
+      uint32_t pgs = (line_pgs - pg < seg_pgs) ? (line_pgs - pg) : seg_pgs;
+      uint32_t x = pg * 2;
+      uint8_t* y0 = (uint8_t*)dst->addr[0] + dst->linesize[0] * line + x * bytes;
+      uint8_t* y1 = y0 + dst->linesize[0];
+      uint8_t* uv = (uint8_t*)dst->addr[1] + dst->linesize[1] * (line / 2) + x * bytes;
+
+      if (dst->fmt == ST_FRAME_FMT_P010)
+        ret = st20_rfc4175_422be10_to_p010_pair_simd(
+            utfc_be10_pg(src, x, line), utfc_be10_pg(src, x, line + 1), (uint16_t*)y0,
+            (uint16_t*)y1, (uint16_t*)uv, pgs * 2, MTL_SIMD_LEVEL_MAX);
+      else
+        ret = st20_rfc4175_422be10_to_nv12_pair_simd(utfc_be10_pg(src, x, line),
+                                                     utfc_be10_pg(src, x, line + 1), y0,
+                                                     y1, uv, pgs * 2, MTL_SIMD_LEVEL_MAX);
+      if (ret < 0) return ret;
+    }
+  }
+  return 0;
+}
+
+bool utfc_frame_equal(struct st_frame* a, struct st_frame* b) {
+  for (uint8_t plane = 0; plane < st_frame_fmt_planes(a->fmt); plane++) {
+    size_t size = st_frame_least_linesize(a->fmt, a->width, plane);
+    for (uint32_t y = 0; y < utfc_plane_height(a, plane); y++) {
+      if (memcmp((uint8_t*)a->addr[plane] + a->linesize[plane] * y,
+                 (uint8_t*)b->addr[plane] + b->linesize[plane] * y, size))
+        return false;
+    }
+  }
+  return true;
+}
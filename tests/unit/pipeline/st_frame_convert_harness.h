@@ -0,0 +1,55 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C header for the 422be10 to 420 semi-planar (NV12 / P010) convert unit tests.
+ *
+ * Frames are plain malloc planes, the destination lines can be padded to take
+ * the line pair path of the converter. The converters are the production
+ * ones; the simd level can be forced to compare the SIMD kernels against the
+ * scalar reference.
+ */
+
+#ifndef _ST_FRAME_CONVERT_HARNESS_H_
+#define _ST_FRAME_CONVERT_HARNESS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mtl_api.h"
+#include "st_pipeline_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Alloc a frame with pad bytes at the end of each line, NULL on fail. */
+struct st_frame* utfc_frame_alloc(enum st_frame_fmt fmt, uint32_t width, uint32_t height,
+                                  uint32_t pad);
+void utfc_frame_free(struct st_frame* frame);
+
+/** Fill a 422be10 frame with a deterministic pattern of 10 bit samples. */
+void utfc_be10_fill(struct st_frame* frame, uint32_t seed);
+/** Fill a 422be10 frame with the same 10 bit luma and chroma on every pixel. */
+void utfc_be10_fill_const(struct st_frame* frame, uint16_t luma, uint16_t chroma);
+/** The 10 bit samples of pixel x, cb and cr are the ones of the pixel pair. */
+void utfc_be10_pixel(struct st_frame* frame, uint32_t x, uint32_t y, uint16_t* luma,
+                     uint16_t* cb, uint16_t* cr);
+
+/** The sample of the 420 semi-planar frame, plane 1 x indexes the interleaved CbCr. */
+uint32_t utfc_sample(struct st_frame* frame, uint8_t plane, uint32_t x, uint32_t y);
+
+/** Convert with the built-in converter forced to the simd level. */
+int utfc_convert_level(struct st_frame* src, struct st_frame* dst,
+                       enum mtl_simd_level level);
+
+/** Convert the line pairs in segments of seg_pgs pgs, as the packet convert does. */
+int utfc_convert_segments(struct st_frame* src, struct st_frame* dst, uint32_t seg_pgs);
+
+/** Compare the valid samples of two frames of the same format and size. */
+bool utfc_frame_equal(struct st_frame* a, struct st_frame* b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,185 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness for the pipeline framebuffer queue unit tests and microbenchmark.
+ * The queue is the production st_frame_queue; the scan variant of the benchmark
+ * is a copy of the claim logic the st30p pipeline used before the queues
+ * (*_next_available / *_newest_available + CAS), kept here as the reference.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "st2110/pipeline/st_frame_queue.h"
+
+#include "common/ut_common.h"
+#include "pipeline/st_frame_queue_harness.h"
+
+struct utfq_ctx {
+  struct rte_ring* queue;
+};
+
+enum utfq_frame_status {
+  UTFQ_FRAME_FREE = 0,
+  UTFQ_FRAME_IN_USER,
+  UTFQ_FRAME_READY,
+  UTFQ_FRAME_IN_TRANSMITTING,
+};
+
+struct utfq_frame {
+  _Atomic uint32_t stat;
+  uint32_t seq_number;
+};
+
+struct utfq_bench {
+  struct utfq_frame* frames;
+  int cnt;
+  uint32_t seq_number;
+  struct rte_ring* free_queue;
+  struct rte_ring* ready_queue;
+};
+
+int utfq_init(void) {
+  return ut_eal_init();
+}
+
+utfq_ctx* utfq_create(int cnt) {
+  utfq_ctx* ctx = calloc(1, sizeof(*ctx));
+  if (!ctx) return NULL;
+  ctx->queue = st_frame_queue_create("ut_fq", cnt, rte_socket_id());
+  if (!ctx->queue) {
+    free(ctx);
+    return NULL;
+  }
+  return ctx;
+}
+
+void utfq_destroy(utfq_ctx* ctx) {
+  if (!ctx) return;
+  st_frame_queue_free(ctx->queue);
+  free(ctx);
+}
+
+int utfq_put(utfq_ctx* ctx, uintptr_t token) {
+  return st_frame_queue_put(ctx->queue, (void*)token);
+}
+
+uintptr_t utfq_get(utfq_ctx* ctx) {
+  return (uintptr_t)st_frame_queue_get(ctx->queue);
+}
+
+unsigned int utfq_count(utfq_ctx* ctx) {
+  return st_frame_queue_count(ctx->queue);
+}
+
+static bool utfq_cas(struct utfq_frame* frame, uint32_t desired, uint32_t claimed) {
+  uint32_t expected = desired;
+  return atomic_compare_exchange_strong_explicit(&frame->stat, &expected, claimed,
+                                                 memory_order_acq_rel,
+                                                 memory_order_relaxed);
+}
+
+/* the first slot in desired, as tx_st30p_claim_available did */
+static struct utfq_frame* utfq_scan_claim(struct utfq_bench* b, uint32_t desired,
+                                          uint32_t claimed) {
+  while (1) {
+    struct utfq_frame* frame = NULL;
+    for (int i = 0; i < b->cnt; i++) {
+      if (desired == atomic_load_explicit(&b->frames[i].stat, memory_order_acquire)) {
+        frame = &b->frames[i];
+        break;
+      }
+    }
+    if (!frame) return NULL;
+    if (utfq_cas(frame, desired, claimed)) return frame;
+  }
+}
+
+/* the oldest slot in desired by seq number, as tx_st30p_newest_available did */
+static struct utfq_frame* utfq_scan_claim_oldest(struct utfq_bench* b, uint32_t desired,
+                                                 uint32_t claimed) {
+  struct utfq_frame* oldest = NULL;
+
+  for (int i = 0; i < b->cnt; i++) {
+    struct utfq_frame* frame = &b->frames[i];
+    if ((desired == atomic_load_explicit(&frame->stat, memory_order_acquire)) &&
+        (!oldest || !mt_seq32_greater(frame->seq_number, oldest->seq_number)))
+      oldest = frame;
+  }
+  if (oldest && utfq_cas(oldest, desired, claimed)) return oldest;
+  return NULL;
+}
+
+static struct utfq_frame* utfq_queue_claim(struct rte_ring* queue, uint32_t desired,
+                                           uint32_t claimed) {
+  struct utfq_frame* frame;
+
+  while ((frame = st_frame_queue_get(queue))) {
+    if (utfq_cas(frame, desired, claimed)) return frame;
+  }
+  return NULL;
+}
+
+static int utfq_bench_one(struct utfq_bench* b, bool queue) {
+  struct utfq_frame* frame;
+
+  /* app get_frame + put_frame */
+  if (queue)
+    frame = utfq_queue_claim(b->free_queue, UTFQ_FRAME_FREE, UTFQ_FRAME_IN_USER);
+  else
+    frame = utfq_scan_claim(b, UTFQ_FRAME_FREE, UTFQ_FRAME_IN_USER);
+  if (!frame) return -EBUSY;
+  frame->seq_number = b->seq_number++;
+  atomic_store_explicit(&frame->stat, UTFQ_FRAME_READY, memory_order_release);
+  if (queue) st_frame_queue_put(b->ready_queue, frame);
+
+  /* transport next_frame + frame_done */
+  if (queue)
+    frame =
+        utfq_queue_claim(b->ready_queue, UTFQ_FRAME_READY, UTFQ_FRAME_IN_TRANSMITTING);
+  else
+    frame = utfq_scan_claim_oldest(b, UTFQ_FRAME_READY, UTFQ_FRAME_IN_TRANSMITTING);
+  if (!frame) return -EBUSY;
+  atomic_store_explicit(&frame->stat, UTFQ_FRAME_FREE, memory_order_release);
+  if (queue) st_frame_queue_put(b->free_queue, frame);
+
+  return 0;
+}
+
+double utfq_bench_lifecycle(int cnt, int busy, int iters, bool queue) {
+  struct utfq_bench b;
+  struct timespec start, end;
+  double ns = -1;
+
+  memset(&b, 0, sizeof(b));
+  b.cnt = cnt;
+  b.frames = calloc(cnt, sizeof(*b.frames));
+  b.free_queue = st_frame_queue_create("ut_fq_free", cnt, rte_socket_id());
+  b.ready_queue = st_frame_queue_create("ut_fq_ready", cnt, rte_socket_id());
+  if (!b.frames || !b.free_queue || !b.ready_queue) goto out;
+
+  /* the busy frames stay in user at the head, the scan has to skip them */
+  for (int i = 0; i < cnt; i++) {
+    if (i < busy) {
+      b.frames[i].stat = UTFQ_FRAME_IN_USER;
+    } else {
+      b.frames[i].stat = UTFQ_FRAME_FREE;
+      st_frame_queue_put(b.free_queue, &b.frames[i]);
+    }
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int i = 0; i < iters; i++) {
+    if (utfq_bench_one(&b, queue) < 0) goto out;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  ns = ((double)(end.tv_sec - start.tv_sec) * NS_PER_S + (end.tv_nsec - start.tv_nsec)) /
+       iters;
+
+out:
+  st_frame_queue_free(b.free_queue);
+  st_frame_queue_free(b.ready_queue);
+  free(b.frames);
+  return ns;
+}
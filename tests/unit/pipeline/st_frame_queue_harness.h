@@ -0,0 +1,47 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C header for the pipeline framebuffer queue (st_frame_queue) unit tests.
+ *
+ * Exposes the rte_ring backed queue to gtest, plus a microbenchmark of one full
+ * framebuffer lifecycle (FREE->IN_USER->READY->IN_TRANSMITTING->FREE) claimed
+ * either by the per-status queues or by the linear status scan the pipelines
+ * used before (first FREE slot, oldest READY slot by sequence number).
+ */
+
+#ifndef _ST_FRAME_QUEUE_HARNESS_H_
+#define _ST_FRAME_QUEUE_HARNESS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct utfq_ctx utfq_ctx;
+
+int utfq_init(void);
+
+/** Create a queue sized for cnt framebuffers. */
+utfq_ctx* utfq_create(int cnt);
+void utfq_destroy(utfq_ctx* ctx);
+
+/** Queue the token, returns 0 on success, <0 when full. */
+int utfq_put(utfq_ctx* ctx, uintptr_t token);
+/** Get the oldest token, returns 0 when empty. Tokens must be non zero. */
+uintptr_t utfq_get(utfq_ctx* ctx);
+unsigned int utfq_count(utfq_ctx* ctx);
+
+/**
+ * Run iters lifecycles over cnt framebuffers with `busy` of them kept in user
+ * (so the claim has to skip them), return the average ns of one lifecycle.
+ * queue: true for the per-status queues, false for the status scan.
+ */
+double utfq_bench_lifecycle(int cnt, int busy, int iters, bool queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,138 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * Pipeline framebuffer queue tests. The queue replaces the linear status scan
+ * of the st30p pipelines, so it has to keep the fifo order, hold every
+ * framebuffer of the session, and never lose or duplicate an entry when app
+ * and transport threads put and get concurrently. The microbenchmark prints
+ * the lifecycle cost of the queue against the old scan; it asserts nothing on
+ * the timing so it stays deterministic on loaded CI hosts.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "pipeline/st_frame_queue_harness.h"
+
+namespace {
+
+class StFrameQueueTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_EQ(utfq_init(), 0) << "EAL init failed";
+  }
+};
+
+TEST_F(StFrameQueueTest, FifoOrder) {
+  utfq_ctx* q = utfq_create(8);
+  ASSERT_NE(q, nullptr);
+
+  for (uintptr_t t = 1; t <= 8; t++) ASSERT_EQ(utfq_put(q, t), 0);
+  EXPECT_EQ(utfq_count(q), 8u);
+  for (uintptr_t t = 1; t <= 8; t++) EXPECT_EQ(utfq_get(q), t);
+  EXPECT_EQ(utfq_get(q), 0u) << "empty queue must return nothing";
+
+  utfq_destroy(q);
+}
+
+/* A session queues at most framebuff_cnt entries, including a non power of two
+ * count, so the queue must never report full before that. */
+TEST_F(StFrameQueueTest, HoldsEveryFramebuff) {
+  for (int cnt : {1, 3, 7, 8, 30, 64}) {
+    utfq_ctx* q = utfq_create(cnt);
+    ASSERT_NE(q, nullptr) << "cnt " << cnt;
+    for (int i = 1; i <= cnt; i++)
+      ASSERT_EQ(utfq_put(q, (uintptr_t)i), 0) << "cnt " << cnt << " put " << i;
+    EXPECT_EQ(utfq_count(q), (unsigned int)cnt);
+    utfq_destroy(q);
+  }
+}
+
+TEST_F(StFrameQueueTest, WrapAround) {
+  utfq_ctx* q = utfq_create(3);
+  ASSERT_NE(q, nullptr);
+
+  uintptr_t next_put = 1, next_get = 1;
+  for (int round = 0; round < 1000; round++) {
+    ASSERT_EQ(utfq_put(q, next_put++), 0);
+    ASSERT_EQ(utfq_put(q, next_put++), 0);
+    ASSERT_EQ(utfq_get(q), next_get++);
+    ASSERT_EQ(utfq_get(q), next_get++);
+  }
+  EXPECT_EQ(utfq_count(q), 0u);
+
+  utfq_destroy(q);
+}
+
+/* Tokens circulate between N producers and N consumers through the queue, as
+ * framebuffers do between app threads and the transport: every token must be
+ * got exactly as many times as it was put. */
+TEST_F(StFrameQueueTest, MpmcNoLossNoDup) {
+  constexpr int kTokens = 16;
+  constexpr int kThreads = 4;
+  constexpr int kOpsPerThread = 50000;
+
+  utfq_ctx* q = utfq_create(kTokens);
+  ASSERT_NE(q, nullptr);
+  for (uintptr_t t = 1; t <= kTokens; t++) ASSERT_EQ(utfq_put(q, t), 0);
+
+  std::vector<std::atomic<int>> owned(kTokens + 1);
+  for (auto& o : owned) o.store(0);
+  std::atomic<bool> violation{false};
+  std::atomic<bool> put_fail{false};
+
+  auto worker = [&]() {
+    for (int i = 0; i < kOpsPerThread;) {
+      uintptr_t t = utfq_get(q);
+      if (!t) continue;
+      if (owned[t].fetch_add(1) != 0) violation.store(true);
+      owned[t].fetch_sub(1);
+      if (utfq_put(q, t) < 0) put_fail.store(true);
+      i++;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; i++) threads.emplace_back(worker);
+  for (auto& t : threads) t.join();
+
+  EXPECT_FALSE(violation.load()) << "one token got by two threads";
+  EXPECT_FALSE(put_fail.load()) << "queue full with only kTokens entries";
+  EXPECT_EQ(utfq_count(q), (unsigned int)kTokens) << "tokens lost or duplicated";
+
+  std::vector<bool> seen(kTokens + 1, false);
+  for (int i = 0; i < kTokens; i++) {
+    uintptr_t t = utfq_get(q);
+    ASSERT_GE(t, 1u);
+    ASSERT_LE(t, (uintptr_t)kTokens);
+    EXPECT_FALSE(seen[t]) << "token " << t << " duplicated";
+    seen[t] = true;
+  }
+
+  utfq_destroy(q);
+}
+
+/* One framebuffer lifecycle claimed by the queues vs the old scan, for an
+ * audio session with many framebuffers and some of them held by the app. */
+TEST_F(StFrameQueueTest, BenchLifecycleVsScan) {
+  constexpr int kIters = 200000;
+  struct {
+    int cnt;
+    int busy;
+  } cases[] = {{4, 0}, {16, 8}, {64, 32}, {256, 128}};
+
+  for (const auto& c : cases) {
+    double scan = utfq_bench_lifecycle(c.cnt, c.busy, kIters, false);
+    double queue = utfq_bench_lifecycle(c.cnt, c.busy, kIters, true);
+    ASSERT_GT(scan, 0) << "scan lifecycle failed, cnt " << c.cnt;
+    ASSERT_GT(queue, 0) << "queue lifecycle failed, cnt " << c.cnt;
+    printf("[ BENCH    ] framebuffs %3d busy %3d: scan %7.1f ns, queue %7.1f ns\n", c.cnt,
+           c.busy, scan, queue);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,206 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness for the frame scaler unit tests.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "st2110/st_fmt.h"
+#include "st2110/st_scale.h"
+
+#include "pipeline/st_frame_scale_harness.h"
+
+#define UTFS_LINE_PAD (64)
+
+static uint32_t utfs_plane_height(struct st_frame* frame, uint8_t plane) {
+  if (plane && st_frame_fmt_get_sampling(frame->fmt) == ST_FRAME_SAMPLING_420)
+    return frame->height / 2;
+  return frame->height;
+}
+
+static uint8_t utfs_sample_bytes(struct st_frame* frame) {
+  if (frame->fmt == ST_FRAME_FMT_YUV422PLANAR8 ||
+      frame->fmt == ST_FRAME_FMT_YUV420PLANAR8)
+    return 1;
+  return 2;
+}
+
+static uint32_t utfs_plane_width(struct st_frame* frame, uint8_t plane) {
+  if (plane && st_frame_fmt_get_sampling(frame->fmt) != ST_FRAME_SAMPLING_444)
+    return frame->width / 2;
+  return frame->width;
+}
+
+static uint32_t utfs_max(struct st_frame* frame) {
+  switch (frame->fmt) {
+    case ST_FRAME_FMT_YUV422PLANAR8:
+    case ST_FRAME_FMT_YUV420PLANAR8:
+      return 0xFF;
+    case ST_FRAME_FMT_YUV422PLANAR12LE:
+    case ST_FRAME_FMT_YUV444PLANAR12LE:
+    case ST_FRAME_FMT_GBRPLANAR12LE:
+      return 0xFFF;
+    case ST_FRAME_FMT_YUV422PLANAR16LE:
+      return 0xFFC0;
+    default:
+      return 0x3FF;
+  }
+}
+
+struct st_frame* utfs_frame_alloc(enum st_frame_fmt fmt, uint32_t width,
+                                  uint32_t height) {
+  struct st_frame* frame = calloc(1, sizeof(*frame));
+  if (!frame) return NULL;
+
+  frame->fmt = fmt;
+  frame->width = width;
+  frame->height = height;
+  for (uint8_t plane = 0; plane < st_frame_fmt_planes(fmt); plane++) {
+    frame->linesize[plane] = st_frame_least_linesize(fmt, width, plane) + UTFS_LINE_PAD;
+    frame->addr[plane] =
+        calloc(utfs_plane_height(frame, plane), st_frame_plane_row_size(frame, plane));
+    if (!frame->addr[plane]) {
+      utfs_frame_free(frame);
+      return NULL;
+    }
+  }
+  return frame;
+}
+
+void utfs_frame_free(struct st_frame* frame) {
+  for (uint8_t plane = 0; plane < ST_MAX_PLANES; plane++) free(frame->addr[plane]);
+  free(frame);
+}
+
+static void utfs_set_sample(struct st_frame* frame, uint8_t plane, uint32_t x, uint32_t y,
+                            uint32_t value) {
+  size_t row_size = st_frame_plane_row_size(frame, plane);
+  uint8_t* line = (uint8_t*)frame->addr[plane] + row_size * y;
+  if (utfs_sample_bytes(frame) == 1)
+    line[x] = value;
+  else
+    ((uint16_t*)line)[x] = value;
+}
+
+uint32_t utfs_sample(struct st_frame* frame, uint8_t plane, uint32_t x, uint32_t y) {
+  size_t row_size = st_frame_plane_row_size(frame, plane);
+  uint8_t* line = (uint8_t*)frame->addr[plane] + row_size * y;
+  if (utfs_sample_bytes(frame) == 1) return line[x];
+  return ((uint16_t*)line)[x];
+}
+
+void utfs_frame_fill(struct st_frame* frame, uint32_t seed) {
+  uint32_t max = utfs_max(frame);
+
+  for (uint8_t plane = 0; plane < st_frame_fmt_planes(frame->fmt); plane++) {
+    for (uint32_t y = 0; y < utfs_plane_height(frame, plane); y++) {
+      for (uint32_t x = 0; x < utfs_plane_width(frame, plane); x++) {
+        uint32_t v = (x * 7 + y * 13 + plane * 101 + (x * y + seed) % 97) * 2654435761u;
+        utfs_set_sample(frame, plane, x, y, (v >> 8) & max);
+      }
+    }
+  }
+}
+
+void utfs_frame_fill_const(struct st_frame* frame, uint32_t value) {
+  for (uint8_t plane = 0; plane < st_frame_fmt_planes(frame->fmt); plane++) {
+    for (uint32_t y = 0; y < utfs_plane_height(frame, plane); y++) {
+      for (uint32_t x = 0; x < utfs_plane_width(frame, plane); x++)
+        utfs_set_sample(frame, plane, x, y, value);
+    }
+  }
+}
+
+bool utfs_frame_equal(struct st_frame* a, struct st_frame* b) {
+  for (uint8_t plane = 0; plane < st_frame_fmt_planes(a->fmt); plane++) {
+    size_t size = (size_t)utfs_plane_width(a, plane) * utfs_sample_bytes(a);
+    for (uint32_t y = 0; y < utfs_plane_height(a, plane); y++) {
+      if (memcmp((uint8_t*)a->addr[plane] + st_frame_plane_row_size(a, plane) * y,
+                 (uint8_t*)b->addr[plane] + st_frame_plane_row_size(b, plane) * y, size))
+        return false;
+    }
+  }
+  return true;
+}
+
+int utfs_scale_multi_level(struct st_frame* src, struct st_frame** dsts, uint16_t cnt,
+                           enum st_frame_scale_method method, enum mtl_simd_level level) {
+  uint32_t widths[ST_FRAME_SCALE_OUTPUTS_MAX];
+  uint32_t heights[ST_FRAME_SCALE_OUTPUTS_MAX];
+  struct st_frame_scaler* scaler;
+  int ret;
+
+  if (cnt > ST_FRAME_SCALE_OUTPUTS_MAX) return -EINVAL;
+  for (uint16_t i = 0; i < cnt; i++) {
+    widths[i] = dsts[i]->width;
+    heights[i] = dsts[i]->height;
+  }
+  scaler = st_frame_scaler_create(src->fmt, src->width, src->height, widths, heights, cnt,
+                                  method);
+  if (!scaler) return -EINVAL;
+  scaler->simd_level = level;
+  ret = st_frame_scaler_run(scaler, src, dsts);
+  st_frame_scaler_free(scaler);
+  return ret;
+}
+
+struct utfs_shared_job {
+  struct st_frame_scaler* scaler;
+  struct st_frame* src;
+  struct st_frame** dsts;
+  int ret;
+};
+
+static void* utfs_shared_thread(void* arg) {
+  struct utfs_shared_job* job = arg;
+  int32_t* line = calloc(job->src->width, sizeof(*line));
+
+  if (!line) {
+    job->ret = -ENOMEM;
+    return NULL;
+  }
+  job->ret = st_frame_scaler_run_line(job->scaler, job->src, job->dsts, line);
+  free(line);
+  return NULL;
+}
+
+int utfs_scale_shared(struct st_frame* src, struct st_frame** dsts, uint16_t cnt,
+                      uint16_t threads, enum st_frame_scale_method method) {
+  struct utfs_shared_job jobs[UTFS_SHARED_THREADS_MAX];
+  pthread_t tids[UTFS_SHARED_THREADS_MAX];
+  uint32_t widths[ST_FRAME_SCALE_OUTPUTS_MAX];
+  uint32_t heights[ST_FRAME_SCALE_OUTPUTS_MAX];
+  struct st_frame_scaler* scaler;
+  uint16_t started = 0;
+  int ret = 0;
+
+  if (cnt > ST_FRAME_SCALE_OUTPUTS_MAX || threads > UTFS_SHARED_THREADS_MAX)
+    return -EINVAL;
+  for (uint16_t i = 0; i < cnt; i++) {
+    widths[i] = dsts[i]->width;
+    heights[i] = dsts[i]->height;
+  }
+  scaler = st_frame_scaler_create(src->fmt, src->width, src->height, widths, heights, cnt,
+                                  method);
+  if (!scaler) return -EINVAL;
+  for (uint16_t t = 0; t < threads; t++) {
+    jobs[t].scaler = scaler;
+    jobs[t].src = src;
+    jobs[t].dsts = &dsts[t * cnt];
+    jobs[t].ret = 0;
+    if (pthread_create(&tids[t], NULL, utfs_shared_thread, &jobs[t])) {
+      ret = -EIO;
+      break;
+    }
+    started++;
+  }
+  for (uint16_t t = 0; t < started; t++) {
+    pthread_join(tids[t], NULL);
+    if (jobs[t].ret < 0) ret = jobs[t].ret;
+  }
+  st_frame_scaler_free(scaler);
+  return ret;
+}
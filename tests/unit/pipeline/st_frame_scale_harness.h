@@ -0,0 +1,56 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C header for the frame scaler (st_frame_scale) unit tests.
+ *
+ * Frames are plain malloc planes with a padded linesize, so the scaler is
+ * tested on the line stride and not only on packed planes. The scaler itself
+ * is the production one; the simd level can be forced to compare the AVX2
+ * kernels against the scalar reference.
+ */
+
+#ifndef _ST_FRAME_SCALE_HARNESS_H_
+#define _ST_FRAME_SCALE_HARNESS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mtl_api.h"
+#include "st_pipeline_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Alloc a frame with padded lines, NULL on fail. */
+struct st_frame* utfs_frame_alloc(enum st_frame_fmt fmt, uint32_t width, uint32_t height);
+void utfs_frame_free(struct st_frame* frame);
+
+/** Fill every plane with a deterministic pattern within the sample depth. */
+void utfs_frame_fill(struct st_frame* frame, uint32_t seed);
+/** Fill every sample with value. */
+void utfs_frame_fill_const(struct st_frame* frame, uint32_t value);
+
+uint32_t utfs_sample(struct st_frame* frame, uint8_t plane, uint32_t x, uint32_t y);
+
+/** Compare the valid samples of two frames of the same format and size. */
+bool utfs_frame_equal(struct st_frame* a, struct st_frame* b);
+
+/** st_frame_scale_multi with the scaler forced to the simd level. */
+int utfs_scale_multi_level(struct st_frame* src, struct st_frame** dsts, uint16_t cnt,
+                           enum st_frame_scale_method method, enum mtl_simd_level level);
+
+#define UTFS_SHARED_THREADS_MAX (8)
+
+/**
+ * One scaler run by several threads at the same time, each with its own line.
+ * dsts holds threads sets of cnt outputs, thread t writes dsts[t * cnt + i].
+ */
+int utfs_scale_shared(struct st_frame* src, struct st_frame** dsts, uint16_t cnt,
+                      uint16_t threads, enum st_frame_scale_method method);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,222 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * Frame scaler (st_frame_scale / st_frame_scale_multi) tests.
+ *
+ *   - the box filter at an integer ratio is the exact rounded block average, also on
+ *     the 4:2:0 chroma rows which span two linesizes;
+ *   - a flat frame stays flat with every filter, including the edge taps;
+ *   - one multi output pass equals the single output calls;
+ *   - the AVX2 kernels equal the scalar kernels, also on the line tails;
+ *   - one scaler run by several threads, each with its own line, equals one pass;
+ *   - upscale, odd chroma sizes and packed formats are rejected.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "pipeline/st_frame_scale_harness.h"
+
+namespace {
+
+const enum st_frame_scale_method kMethods[] = {
+    ST_FRAME_SCALE_BOX,
+    ST_FRAME_SCALE_BILINEAR,
+    ST_FRAME_SCALE_POLYPHASE,
+};
+
+class StFrameScaleTest : public ::testing::Test {
+ protected:
+  std::vector<struct st_frame*> frames_;
+
+  struct st_frame* alloc(enum st_frame_fmt fmt, uint32_t w, uint32_t h) {
+    struct st_frame* frame = utfs_frame_alloc(fmt, w, h);
+    if (frame) frames_.push_back(frame);
+    return frame;
+  }
+
+  void TearDown() override {
+    for (auto* frame : frames_) utfs_frame_free(frame);
+    frames_.clear();
+  }
+};
+
+TEST_F(StFrameScaleTest, BoxHalfIsBlockAverage) {
+  struct st_frame* src = alloc(ST_FRAME_FMT_YUV422PLANAR10LE, 128, 64);
+  struct st_frame* dst = alloc(ST_FRAME_FMT_YUV422PLANAR10LE, 64, 32);
+  ASSERT_NE(src, nullptr);
+  ASSERT_NE(dst, nullptr);
+  utfs_frame_fill(src, 1);
+
+  ASSERT_EQ(st_frame_scale(src, dst, ST_FRAME_SCALE_BOX), 0);
+  for (uint8_t plane = 0; plane < 3; plane++) {
+    uint32_t w = plane ? 32 : 64;
+    for (uint32_t y = 0; y < 32; y++) {
+      for (uint32_t x = 0; x < w; x++) {
+        uint32_t sum = utfs_sample(src, plane, 2 * x, 2 * y) +
+                       utfs_sample(src, plane, 2 * x + 1, 2 * y) +
+                       utfs_sample(src, plane, 2 * x, 2 * y + 1) +
+                       utfs_sample(src, plane, 2 * x + 1, 2 * y + 1);
+        ASSERT_EQ(utfs_sample(dst, plane, x, y), (sum + 2) / 4)
+            << "plane " << (int)plane << " x " << x << " y " << y;
+      }
+    }
+  }
+}
+
+TEST_F(StFrameScaleTest, BoxHalfIsBlockAverage420) {
+  struct st_frame* src = alloc(ST_FRAME_FMT_YUV420PLANAR8, 128, 64);
+  struct st_frame* dst = alloc(ST_FRAME_FMT_YUV420PLANAR8, 64, 32);
+  ASSERT_NE(src, nullptr);
+  ASSERT_NE(dst, nullptr);
+  utfs_frame_fill(src, 2);
+
+  ASSERT_EQ(st_frame_scale(src, dst, ST_FRAME_SCALE_BOX), 0);
+  for (uint8_t plane = 0; plane < 3; plane++) {
+    uint32_t w = plane ? 32 : 64;
+    uint32_t h = plane ? 16 : 32;
+    for (uint32_t y = 0; y < h; y++) {
+      for (uint32_t x = 0; x < w; x++) {
+        uint32_t sum = utfs_sample(src, plane, 2 * x, 2 * y) +
+                       utfs_sample(src, plane, 2 * x + 1, 2 * y) +
+                       utfs_sample(src, plane, 2 * x, 2 * y + 1) +
+                       utfs_sample(src, plane, 2 * x + 1, 2 * y + 1);
+        ASSERT_EQ(utfs_sample(dst, plane, x, y), (sum + 2) / 4)
+            << "plane " << (int)plane << " x " << x << " y " << y;
+      }
+    }
+  }
+}
+
+TEST_F(StFrameScaleTest, FlatStaysFlat) {
+  struct st_frame* src = alloc(ST_FRAME_FMT_YUV422PLANAR10LE, 1280, 720);
+  struct st_frame* dst = alloc(ST_FRAME_FMT_YUV422PLANAR10LE, 426, 240);
+  ASSERT_NE(src, nullptr);
+  ASSERT_NE(dst, nullptr);
+  utfs_frame_fill_const(src, 1023);
+
+  for (auto method : kMethods) {
+    utfs_frame_fill_const(dst, 0);
+    ASSERT_EQ(st_frame_scale(src, dst, method), 0) << "method " << method;
+    for (uint8_t plane = 0; plane < 3; plane++) {
+      uint32_t w = plane ? 213 : 426;
+      for (uint32_t y = 0; y < 240; y++)
+        for (uint32_t x = 0; x < w; x++)
+          ASSERT_EQ(utfs_sample(dst, plane, x, y), 1023u)
+              << "method " << method << " plane " << (int)plane << " x " << x;
+    }
+  }
+}
+
+TEST_F(StFrameScaleTest, MultiEqualsSingle) {
+  const uint32_t widths[] = {960, 640, 480};
+  const uint32_t heights[] = {540, 360, 270};
+  struct st_frame* src = alloc(ST_FRAME_FMT_YUV422PLANAR8, 1920, 1080);
+  ASSERT_NE(src, nullptr);
+  utfs_frame_fill(src, 2);
+
+  for (auto method : kMethods) {
+    struct st_frame* multi[3];
+    for (int i = 0; i < 3; i++) {
+      multi[i] = alloc(ST_FRAME_FMT_YUV422PLANAR8, widths[i], heights[i]);
+      ASSERT_NE(multi[i], nullptr);
+    }
+    ASSERT_EQ(st_frame_scale_multi(src, multi, 3, method), 0);
+    for (int i = 0; i < 3; i++) {
+      struct st_frame* single = alloc(ST_FRAME_FMT_YUV422PLANAR8, widths[i], heights[i]);
+      ASSERT_NE(single, nullptr);
+      ASSERT_EQ(st_frame_scale(src, single, method), 0);
+      EXPECT_TRUE(utfs_frame_equal(multi[i], single))
+          << "method " << method << " output " << i;
+    }
+  }
+}
+
+TEST_F(StFrameScaleTest, SimdEqualsScalar) {
+  if (mtl_get_simd_level() < MTL_SIMD_LEVEL_AVX2) GTEST_SKIP() << "no avx2";
+  const enum st_frame_fmt fmts[] = {
+      ST_FRAME_FMT_YUV422PLANAR10LE,
+      ST_FRAME_FMT_YUV422PLANAR16LE,
+      ST_FRAME_FMT_YUV420PLANAR8,
+      ST_FRAME_FMT_YUV444PLANAR12LE,
+  };
+  /* 1/3, 1/4 and a 0.7 ratio, widths not a multiple of the simd width */
+  const uint32_t widths[] = {240, 180, 502};
+  const uint32_t heights[] = {136, 102, 288};
+
+  for (auto fmt : fmts) {
+    struct st_frame* src = alloc(fmt, 720, 408);
+    ASSERT_NE(src, nullptr);
+    utfs_frame_fill(src, 3);
+    for (auto method : kMethods) {
+      struct st_frame* simd[3];
+      struct st_frame* scalar[3];
+      for (int i = 0; i < 3; i++) {
+        simd[i] = alloc(fmt, widths[i], heights[i]);
+        scalar[i] = alloc(fmt, widths[i], heights[i]);
+        ASSERT_NE(simd[i], nullptr);
+        ASSERT_NE(scalar[i], nullptr);
+      }
+      ASSERT_EQ(utfs_scale_multi_level(src, simd, 3, method, MTL_SIMD_LEVEL_AVX2), 0);
+      ASSERT_EQ(utfs_scale_multi_level(src, scalar, 3, method, MTL_SIMD_LEVEL_NONE), 0);
+      for (int i = 0; i < 3; i++)
+        EXPECT_TRUE(utfs_frame_equal(simd[i], scalar[i]))
+            << "fmt " << fmt << " method " << method << " output " << i;
+    }
+  }
+}
+
+TEST_F(StFrameScaleTest, SharedScalerEqualsSingle) {
+  const uint32_t widths[] = {960, 480};
+  const uint32_t heights[] = {540, 270};
+  const uint16_t threads = 4;
+  struct st_frame* src = alloc(ST_FRAME_FMT_YUV422PLANAR10LE, 1920, 1080);
+  ASSERT_NE(src, nullptr);
+  utfs_frame_fill(src, 4);
+
+  for (auto method : kMethods) {
+    struct st_frame* ref[2];
+    struct st_frame* shared[threads * 2];
+    for (int i = 0; i < 2; i++) {
+      ref[i] = alloc(ST_FRAME_FMT_YUV422PLANAR10LE, widths[i], heights[i]);
+      ASSERT_NE(ref[i], nullptr);
+    }
+    for (int t = 0; t < threads; t++) {
+      for (int i = 0; i < 2; i++) {
+        shared[t * 2 + i] = alloc(ST_FRAME_FMT_YUV422PLANAR10LE, widths[i], heights[i]);
+        ASSERT_NE(shared[t * 2 + i], nullptr);
+      }
+    }
+    ASSERT_EQ(st_frame_scale_multi(src, ref, 2, method), 0);
+    ASSERT_EQ(utfs_scale_shared(src, shared, 2, threads, method), 0);
+    for (int t = 0; t < threads; t++)
+      for (int i = 0; i < 2; i++)
+        EXPECT_TRUE(utfs_frame_equal(shared[t * 2 + i], ref[i]))
+            << "method " << method << " thread " << t << " output " << i;
+  }
+}
+
+TEST_F(StFrameScaleTest, RejectInvalid) {
+  struct st_frame* src = alloc(ST_FRAME_FMT_YUV422PLANAR10LE, 64, 32);
+  struct st_frame* up = alloc(ST_FRAME_FMT_YUV422PLANAR10LE, 128, 64);
+  struct st_frame* odd = alloc(ST_FRAME_FMT_YUV444PLANAR10LE, 31, 16);
+  struct st_frame* tiny = alloc(ST_FRAME_FMT_YUV422PLANAR10LE, 2, 2);
+  ASSERT_NE(src, nullptr);
+  ASSERT_NE(up, nullptr);
+  ASSERT_NE(odd, nullptr);
+  ASSERT_NE(tiny, nullptr);
+
+  EXPECT_LT(st_frame_scale(src, up, ST_FRAME_SCALE_BILINEAR), 0) << "upscale";
+  EXPECT_LT(st_frame_scale(src, odd, ST_FRAME_SCALE_BOX), 0) << "fmt mismatch";
+  EXPECT_LT(st_frame_scale(src, tiny, ST_FRAME_SCALE_BOX), 0) << "ratio above 1/16";
+  EXPECT_LT(st_frame_scale(src, src, ST_FRAME_SCALE_MAX), 0) << "invalid method";
+  /* odd width is fine for 4:4:4, no chroma subsampling */
+  struct st_frame* src444 = alloc(ST_FRAME_FMT_YUV444PLANAR10LE, 62, 32);
+  ASSERT_NE(src444, nullptr);
+  utfs_frame_fill(src444, 4);
+  EXPECT_EQ(st_frame_scale(src444, odd, ST_FRAME_SCALE_POLYPHASE), 0);
+}
+
+}  // namespace
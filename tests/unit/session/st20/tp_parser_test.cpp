@@ -0,0 +1,122 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * Offline ST2110-21 timing parser (st20_tp_parser_*): a synthetic 1080p59.94
+ * frame paced exactly at TRS from TRoffset must be NARROW with the ideal Cinst
+ * and VRX, a bursting sender must fall to WIDE.
+ *
+ * Build: meson setup build_unit -Denable_unit_tests=true && ninja -C build_unit
+ * Run:   ./build_unit/tests/unit/UnitTest --gtest_filter='St20TpParserTest.*'
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "st20_api.h"
+
+class St20TpParserTest : public ::testing::Test {
+ protected:
+  static constexpr uint32_t kPkts = 4320; /* 1080p 422 10bit, 1200 bytes pkts */
+  static constexpr uint64_t kEpoch = 100000; /* even for an integer rtp timestamp */
+  /* 59.94: 1001/60000 s per frame, 90k sampling */
+  static constexpr double kFrameTime = 1000.0 * 1000 * 1000 * 1001 / 60000;
+  static constexpr double kFrameTicks = 90000.0 * 1001 / 60000;
+
+  void SetUp() override {
+    struct st20_tp_parser_ops ops = {};
+    ops.fps = ST_FPS_P59_94;
+    ops.height = 1080;
+    ops.interlaced = false;
+    ops.pkts_per_frame = kPkts;
+    tp_ = st20_tp_parser_create(&ops);
+    ASSERT_NE(tp_, nullptr);
+    ASSERT_EQ(st20_tp_parser_pass(tp_, &pass_), 0);
+
+    trs_ = kFrameTime * (1080.0 / 1125.0) / kPkts;
+    epoch_ns_ = (uint64_t)((double)kEpoch * kFrameTime);
+    rtp_ = (uint32_t)(uint64_t)((double)kEpoch * kFrameTicks);
+    prev_rtp_ = (uint32_t)(uint64_t)((double)(kEpoch - 1) * kFrameTicks);
+  }
+
+  void TearDown() override {
+    if (tp_) st20_tp_parser_free(tp_);
+  }
+
+  /* send packets in bursts of burst pkts, the bursts are paced at TRS on average */
+  void FeedFrame(uint32_t burst, struct st20_rx_tp_meta* meta) {
+    /* the first packet leaves 1us ahead of TRoffset */
+    double first = (double)epoch_ns_ + pass_.tr_offset - 1000;
+
+    ASSERT_EQ(st20_tp_parser_frame_start(tp_, prev_rtp_), 0);
+    for (uint32_t i = 0; i < kPkts; i++) {
+      uint32_t burst_start = i / burst * burst;
+      uint64_t pkt_time = first + trs_ * burst_start;
+      ASSERT_EQ(st20_tp_parser_on_packet(tp_, rtp_, pkt_time, i), 0);
+    }
+    ASSERT_EQ(st20_tp_parser_frame_result(tp_, meta), 0);
+  }
+
+  st20_tp_parser_handle tp_ = nullptr;
+  struct st20_rx_tp_pass pass_;
+  double trs_ = 0;
+  uint64_t epoch_ns_ = 0;
+  uint32_t rtp_ = 0;
+  uint32_t prev_rtp_ = 0;
+};
+
+TEST_F(St20TpParserTest, PassCriteria1080p5994) {
+  EXPECT_EQ(pass_.tr_offset, (int32_t)(kFrameTime * 43.0 / 1125.0));
+  EXPECT_EQ(pass_.cinst_max_narrow, 6);
+  EXPECT_EQ(pass_.cinst_max_wide, 16);
+  EXPECT_EQ(pass_.vrx_max_narrow, 9);
+  EXPECT_EQ(pass_.vrx_max_wide, 863);
+  EXPECT_EQ(pass_.rtp_ts_delta_min, 1501);
+  EXPECT_EQ(pass_.rtp_ts_delta_max, 1502);
+}
+
+TEST_F(St20TpParserTest, PerfectlyPacedFrameIsNarrow) {
+  struct st20_rx_tp_meta meta;
+  FeedFrame(1, &meta);
+
+  EXPECT_EQ(meta.compliant, ST_RX_TP_COMPLIANT_NARROW) << meta.failed_cause;
+  EXPECT_EQ(meta.pkts_cnt, kPkts);
+  /* never more than the drained packets in the buffer */
+  EXPECT_EQ(meta.cinst_min, 0);
+  EXPECT_EQ(meta.cinst_max, 0);
+  EXPECT_FLOAT_EQ(meta.cinst_avg, 0.0f);
+  /* each packet one TRS plus 1us ahead of its drain time */
+  EXPECT_EQ(meta.vrx_min, 1);
+  EXPECT_EQ(meta.vrx_max, 1);
+  EXPECT_FLOAT_EQ(meta.vrx_avg, 1.0f);
+  EXPECT_NEAR(meta.ipt_avg, trs_, 2.0);
+  EXPECT_NEAR(meta.fpt, pass_.tr_offset - 1000, 2);
+  EXPECT_NEAR(meta.latency, pass_.tr_offset - 1000, 2);
+  EXPECT_EQ(meta.rtp_offset, 0);
+  EXPECT_EQ(meta.rtp_ts_delta, (int32_t)(rtp_ - prev_rtp_));
+}
+
+TEST_F(St20TpParserTest, BurstSenderIsWide) {
+  struct st20_rx_tp_meta meta;
+  FeedFrame(12, &meta);
+
+  EXPECT_EQ(meta.compliant, ST_RX_TP_COMPLIANT_WIDE) << meta.failed_cause;
+  /* the whole first burst sits in the buffer */
+  EXPECT_EQ(meta.cinst_max, 11);
+  EXPECT_GT(meta.cinst_max, pass_.cinst_max_narrow);
+  EXPECT_LE(meta.cinst_max, pass_.cinst_max_wide);
+  EXPECT_EQ(meta.vrx_min, 1);
+  EXPECT_EQ(meta.vrx_max, 12);
+}
+
+TEST_F(St20TpParserTest, FrameStartResetsTheSlot) {
+  struct st20_rx_tp_meta meta;
+  FeedFrame(1, &meta);
+  FeedFrame(1, &meta);
+  EXPECT_EQ(meta.pkts_cnt, kPkts);
+  EXPECT_EQ(meta.compliant, ST_RX_TP_COMPLIANT_NARROW) << meta.failed_cause;
+
+  /* no packet in the new frame */
+  ASSERT_EQ(st20_tp_parser_frame_start(tp_, rtp_), 0);
+  EXPECT_LT(st20_tp_parser_frame_result(tp_, &meta), 0);
+}
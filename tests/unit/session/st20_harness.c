@@ -54,6 +54,11 @@ struct ut20_test_ctx {
   bool hold_frames;
   struct mt_ptp_impl ptp_storage;
   uint64_t last_timestamp_first_pkt;
+
+  /* st22 codestream sg mode */
+  void* st22_last_frame;
+  struct st22_rx_frame_meta st22_last_meta;
+  int st22_frames_ready;
 };
 
 #include "session/st20_harness.h"
@@ -192,6 +197,8 @@ ut20_test_ctx* ut20_ctx_create_geom(int num_port, int pkts_per_frame) {
 
 void ut20_ctx_destroy(ut20_test_ctx* ctx) {
   if (!ctx) return;
+  /* release the mbufs held by the st22 sg frames */
+  rv_uinit_st22(&ctx->session);
   /* Drain any held refcnts so destroy-while-holding is safe. */
   for (int i = 0; i < UT20_FRAME_COUNT; i++) {
     rte_atomic32_set(&ctx->frames[i].refcnt, 0);
@@ -530,3 +537,118 @@ uint64_t ut20_stat_frames_partial(const ut20_test_ctx* ctx, enum mtl_session_por
 uint64_t ut20_stat_pkts_unrecovered(const ut20_test_ctx* ctx) {
   return ctx->session.port_user_stats.common.stat_pkts_unrecovered;
 }
+
+/* ── st22 codestream sg mode ──────────────────────────────────────────── */
+
+static int ut20_st22_notify_frame_ready(void* priv, void* frame,
+                                        struct st22_rx_frame_meta* meta) {
+  ut20_test_ctx* ctx = priv;
+  /* hold the frame, the test puts it back by ut20_st22_put_frame */
+  ctx->st22_last_frame = frame;
+  ctx->st22_last_meta = *meta;
+  ctx->st22_frames_ready++;
+  return 0;
+}
+
+int ut20_ctx_enable_st22_sg(ut20_test_ctx* ctx) {
+  struct st_rx_video_session_impl* s = &ctx->session;
+  struct st22_rx_ops st22_ops;
+
+  memset(&st22_ops, 0, sizeof(st22_ops));
+  st22_ops.flags = ST22_RX_FLAG_DISABLE_BOXES | ST22_RX_FLAG_CODESTREAM_SG;
+  st22_ops.notify_frame_ready = ut20_st22_notify_frame_ready;
+  s->st22_ops_flags = st22_ops.flags;
+  int ret = rv_init_st22(s, &st22_ops);
+  if (ret < 0) {
+    rv_uinit_st22(s);
+    return ret;
+  }
+  s->pkt_handler = rv_handle_st22_pkt;
+  return 0;
+}
+
+int ut20_feed_st22_pkt(ut20_test_ctx* ctx, int pkt_counter, uint32_t ts, bool marker,
+                       uint16_t len, uint8_t fill) {
+  struct rte_mbuf* m = rte_pktmbuf_alloc(ut_pool());
+  if (!m) return -1;
+  size_t total = sizeof(struct st22_rfc9134_video_hdr) + len;
+  if (rte_pktmbuf_tailroom(m) < total) {
+    rte_pktmbuf_free(m);
+    return -1;
+  }
+
+  uint8_t* buf = rte_pktmbuf_mtod(m, uint8_t*);
+  memset(buf, 0, sizeof(struct st22_rfc9134_video_hdr));
+  memset(buf + sizeof(struct st22_rfc9134_video_hdr), fill, len);
+  size_t hdr_offset =
+      sizeof(struct st22_rfc9134_video_hdr) - sizeof(struct st22_rfc9134_rtp_hdr);
+  struct st22_rfc9134_rtp_hdr* rtp = (struct st22_rfc9134_rtp_hdr*)(buf + hdr_offset);
+  uint32_t seq = ts * (uint32_t)ctx->session.ops.height + (uint32_t)pkt_counter;
+
+  rtp->base.version = 2;
+  rtp->base.marker = marker ? 1 : 0;
+  rtp->base.seq_number = htons((uint16_t)seq);
+  rtp->base.tmstamp = htonl(ts);
+  rtp->p_counter_lo = (uint8_t)pkt_counter;
+  rtp->p_counter_hi = (uint8_t)(pkt_counter >> 8);
+  rtp->last_packet = marker ? 1 : 0;
+
+  m->data_len = total;
+  m->pkt_len = total;
+  int rc = rv_handle_st22_pkt(&ctx->session, m, MTL_SESSION_PORT_P, true);
+  rte_pktmbuf_free(m); /* the session holds its own reference */
+  return rc;
+}
+
+int ut20_st22_frames_ready(const ut20_test_ctx* ctx) {
+  return ctx->st22_frames_ready;
+}
+
+uint32_t ut20_st22_segs_nb(const ut20_test_ctx* ctx) {
+  return ctx->st22_last_meta.segs_nb;
+}
+
+int ut20_st22_seg(const ut20_test_ctx* ctx, uint32_t i, uint8_t* first_byte) {
+  const struct st22_rx_codestream_seg* seg = &ctx->st22_last_meta.segs[i];
+  if (seg->len && first_byte) *first_byte = *(const uint8_t*)seg->addr;
+  return (int)seg->len;
+}
+
+int ut20_st22_seg_in_frame(const ut20_test_ctx* ctx, uint32_t i) {
+  const uint8_t* addr = ctx->st22_last_meta.segs[i].addr;
+  const uint8_t* frame = ctx->st22_last_frame;
+  return (addr >= frame && addr < frame + ctx->session.st20_frame_size) ? 1 : 0;
+}
+
+size_t ut20_st22_frame_size(const ut20_test_ctx* ctx) {
+  return ctx->st22_last_meta.frame_total_size;
+}
+
+int ut20_st22_put_frame(ut20_test_ctx* ctx) {
+  struct st_rx_video_session_impl* s = &ctx->session;
+  for (int i = 0; i < s->st20_frames_cnt; i++) {
+    if (s->st20_frames[i].addr == ctx->st22_last_frame)
+      return rv_put_frame(s, &s->st20_frames[i]);
+  }
+  return -EIO;
+}
+
+int ut20_st22_sg_held(const ut20_test_ctx* ctx) {
+  return rte_atomic32_read(&ctx->session.st22_info->sg_held);
+}
+
+int ut20_st22_pool_held(const ut20_test_ctx* ctx) {
+  return rte_atomic32_read(&ctx->impl.inf[MTL_PORT_P].rx_mbuf_held);
+}
+
+void ut20_st22_set_pool_held(ut20_test_ctx* ctx, int held) {
+  rte_atomic32_set(&ctx->impl.inf[MTL_PORT_P].rx_mbuf_held, held);
+}
+
+int ut20_st22_sg_hold_max(void) {
+  return ST_VIDEO_RX_ST22_SG_HOLD_MAX;
+}
+
+uint32_t ut20_st22_stat_sg_copy(const ut20_test_ctx* ctx) {
+  return ctx->session.st22_info->stat_sg_copy;
+}
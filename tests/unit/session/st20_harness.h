@@ -215,6 +215,36 @@ int ut20_pkts_per_frame(const ut20_test_ctx* ctx);
  * production `rv_detach` runs before its final stat dump. */
 void ut20_session_detach(ut20_test_ctx* ctx);
 
+/* ST22 codestream scatter-gather mode (ST22_RX_FLAG_CODESTREAM_SG).
+ *
+ * Switch the session to the st22 packet handler with boxes disabled. The
+ * frame-ready callback holds every frame; put it back with
+ * ut20_st22_put_frame(), which releases the held mbufs like
+ * st22_rx_put_framebuff. */
+int ut20_ctx_enable_st22_sg(ut20_test_ctx* ctx);
+
+/* Feed one st22 packet with `len` payload bytes set to `fill`. */
+int ut20_feed_st22_pkt(ut20_test_ctx* ctx, int pkt_counter, uint32_t ts, bool marker,
+                       uint16_t len, uint8_t fill);
+
+/* The last notified frame: segment count, segment `i` length (and its first
+ * byte), whether segment `i` points into the framebuffer (copy fallback). */
+int ut20_st22_frames_ready(const ut20_test_ctx* ctx);
+uint32_t ut20_st22_segs_nb(const ut20_test_ctx* ctx);
+int ut20_st22_seg(const ut20_test_ctx* ctx, uint32_t i, uint8_t* first_byte);
+int ut20_st22_seg_in_frame(const ut20_test_ctx* ctx, uint32_t i);
+size_t ut20_st22_frame_size(const ut20_test_ctx* ctx);
+int ut20_st22_put_frame(ut20_test_ctx* ctx);
+
+/* Mbufs held by all the frames of the session, and by all the users of the rx
+ * pool (no rx queues in the harness, so the interface counter) with a setter to
+ * drive the hold budget. */
+int ut20_st22_sg_held(const ut20_test_ctx* ctx);
+int ut20_st22_pool_held(const ut20_test_ctx* ctx);
+void ut20_st22_set_pool_held(ut20_test_ctx* ctx, int held);
+int ut20_st22_sg_hold_max(void);
+uint32_t ut20_st22_stat_sg_copy(const ut20_test_ctx* ctx);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,129 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * ST22 RX codestream scatter-gather (ST22_RX_FLAG_CODESTREAM_SG) tests.
+ *
+ *   - the packets are not copied into the framebuffer, the frame meta lists
+ *     one segment per packet pointing into the held mbuf;
+ *   - the segments are in packet counter order whatever the arrival order;
+ *   - the mbufs are released when the frame is put back;
+ *   - once the hold budget of the rx pool is used up the packets are copied
+ *     into the framebuffer and the segments point there, the budget is shared
+ *     by all the sessions on the pool.
+ */
+
+#include <gtest/gtest.h>
+
+#include "session/st20_harness.h"
+
+namespace {
+
+constexpr int kPkts = 4;
+constexpr uint16_t kLen = 32;
+
+class St22RxCodestreamSgTest : public ::testing::Test {
+ protected:
+  ut20_test_ctx* ctx_ = nullptr;
+
+  void SetUp() override {
+    ASSERT_EQ(ut20_init(), 0);
+    ctx_ = ut20_ctx_create_geom(/*num_port=*/1, /*pkts_per_frame=*/8);
+    ASSERT_NE(ctx_, nullptr);
+    ASSERT_EQ(ut20_ctx_enable_st22_sg(ctx_), 0);
+  }
+
+  void TearDown() override {
+    if (ctx_) ut20_ctx_destroy(ctx_);
+  }
+
+  void feed(int pkt, uint32_t ts, uint16_t len = kLen) {
+    ASSERT_EQ(ut20_feed_st22_pkt(ctx_, pkt, ts, pkt == kPkts - 1, len, pkt + 1), 0);
+  }
+};
+
+TEST_F(St22RxCodestreamSgTest, SegmentsPointIntoHeldMbufs) {
+  for (int i = 0; i < kPkts; i++) feed(i, 1000);
+
+  ASSERT_EQ(ut20_st22_frames_ready(ctx_), 1);
+  ASSERT_EQ(ut20_st22_segs_nb(ctx_), (uint32_t)kPkts);
+  EXPECT_EQ(ut20_st22_frame_size(ctx_), (size_t)kPkts * kLen);
+  for (int i = 0; i < kPkts; i++) {
+    uint8_t first = 0;
+    EXPECT_EQ(ut20_st22_seg(ctx_, i, &first), kLen);
+    EXPECT_EQ(first, i + 1);
+    EXPECT_EQ(ut20_st22_seg_in_frame(ctx_, i), 0) << "seg " << i << " copied";
+  }
+  EXPECT_EQ(ut20_st22_sg_held(ctx_), kPkts);
+  EXPECT_EQ(ut20_st22_pool_held(ctx_), kPkts);
+  EXPECT_EQ(ut20_st22_stat_sg_copy(ctx_), 0u);
+
+  ASSERT_EQ(ut20_st22_put_frame(ctx_), 0);
+  EXPECT_EQ(ut20_st22_sg_held(ctx_), 0) << "put releases the mbufs";
+  EXPECT_EQ(ut20_st22_pool_held(ctx_), 0);
+}
+
+TEST_F(St22RxCodestreamSgTest, OutOfOrderKeepsPacketOrder) {
+  for (int i : {2, 0, 1, 3}) feed(i, 2000);
+
+  ASSERT_EQ(ut20_st22_frames_ready(ctx_), 1);
+  ASSERT_EQ(ut20_st22_segs_nb(ctx_), (uint32_t)kPkts);
+  for (int i = 0; i < kPkts; i++) {
+    uint8_t first = 0;
+    EXPECT_EQ(ut20_st22_seg(ctx_, i, &first), kLen);
+    EXPECT_EQ(first, i + 1) << "seg " << i;
+  }
+  ASSERT_EQ(ut20_st22_put_frame(ctx_), 0);
+}
+
+TEST_F(St22RxCodestreamSgTest, ShortLastPacket) {
+  for (int i = 0; i < kPkts - 1; i++) feed(i, 3000);
+  feed(kPkts - 1, 3000, 5);
+
+  ASSERT_EQ(ut20_st22_frames_ready(ctx_), 1);
+  EXPECT_EQ(ut20_st22_seg(ctx_, kPkts - 1, nullptr), 5);
+  EXPECT_EQ(ut20_st22_frame_size(ctx_), (size_t)(kPkts - 1) * kLen + 5);
+  ASSERT_EQ(ut20_st22_put_frame(ctx_), 0);
+}
+
+TEST_F(St22RxCodestreamSgTest, HoldBudgetFallsBackToCopy) {
+  /* the other sessions on the pool hold all but one mbuf of the budget */
+  int base = ut20_st22_sg_hold_max() - 1;
+  ut20_st22_set_pool_held(ctx_, base);
+
+  for (int i = 0; i < kPkts; i++) feed(i, 4000);
+
+  ASSERT_EQ(ut20_st22_frames_ready(ctx_), 1);
+  EXPECT_EQ(ut20_st22_seg_in_frame(ctx_, 0), 0) << "the last budget slot is held";
+  for (int i = 1; i < kPkts; i++) {
+    uint8_t first = 0;
+    EXPECT_EQ(ut20_st22_seg(ctx_, i, &first), kLen);
+    EXPECT_EQ(first, i + 1);
+    EXPECT_EQ(ut20_st22_seg_in_frame(ctx_, i), 1) << "seg " << i << " not copied";
+  }
+  EXPECT_EQ(ut20_st22_stat_sg_copy(ctx_), (uint32_t)kPkts - 1);
+
+  EXPECT_EQ(ut20_st22_sg_held(ctx_), 1);
+  EXPECT_EQ(ut20_st22_pool_held(ctx_), base + 1);
+
+  ASSERT_EQ(ut20_st22_put_frame(ctx_), 0);
+  EXPECT_EQ(ut20_st22_sg_held(ctx_), 0);
+  EXPECT_EQ(ut20_st22_pool_held(ctx_), base) << "only the held mbuf is released";
+  ut20_st22_set_pool_held(ctx_, 0);
+}
+
+TEST_F(St22RxCodestreamSgTest, FullPoolCopiesAll) {
+  ut20_st22_set_pool_held(ctx_, ut20_st22_sg_hold_max());
+
+  for (int i = 0; i < kPkts; i++) feed(i, 5000);
+
+  ASSERT_EQ(ut20_st22_frames_ready(ctx_), 1);
+  for (int i = 0; i < kPkts; i++)
+    EXPECT_EQ(ut20_st22_seg_in_frame(ctx_, i), 1) << "seg " << i << " not copied";
+  EXPECT_EQ(ut20_st22_sg_held(ctx_), 0) << "the session itself holds nothing";
+  EXPECT_EQ(ut20_st22_pool_held(ctx_), ut20_st22_sg_hold_max());
+
+  ASSERT_EQ(ut20_st22_put_frame(ctx_), 0);
+  ut20_st22_set_pool_held(ctx_, 0);
+}
+
+}  // namespace
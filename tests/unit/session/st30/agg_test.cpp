@@ -0,0 +1,197 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * RX aggregation group: two 2-channel flows written into one interleaved
+ * frame of the group, aligned by the rtp timestamp.
+ *
+ * Build: meson setup build_unit -Denable_unit_tests=true && ninja -C build_unit
+ * Run:   ./build_unit/tests/unit/UnitTest --gtest_filter='St30RxAggTest.*'
+ */
+
+#include <gtest/gtest.h>
+
+#include "session/st30_agg_harness.h"
+#include "st_api.h"
+
+class St30RxAggTest : public ::testing::Test {
+ protected:
+  ut30a_test_ctx* ctx_ = nullptr;
+  static constexpr uint32_t kBase = 0x1000;
+
+  void SetUp() override {
+    ASSERT_EQ(ut30a_init(), 0) << "EAL init failed";
+  }
+
+  void TearDown() override {
+    ut30a_ctx_destroy(ctx_);
+    ctx_ = nullptr;
+  }
+
+  void create(uint16_t group_channel) {
+    ctx_ = ut30a_ctx_create(group_channel);
+    ASSERT_NE(ctx_, nullptr);
+  }
+
+  uint32_t ticks() {
+    return ut30a_samples_per_pkt(ctx_) * ut30a_pkts_per_frame(ctx_);
+  }
+};
+
+/* Both flows of one frame give one complete frame with the channels interleaved. */
+TEST_F(St30RxAggTest, InterleavesFlowsIntoOneFrame) {
+  create(4);
+  ut30a_feed_frame(ctx_, 0, 0, kBase);
+  EXPECT_EQ(ut30a_frame_count(ctx_), 0) << "flow 1 still missing";
+  ut30a_feed_frame(ctx_, 1, 0, kBase);
+
+  ASSERT_EQ(ut30a_frame_count(ctx_), 1);
+  EXPECT_EQ(ut30a_frame_status(ctx_, 0), ST_FRAME_STATUS_COMPLETE);
+  EXPECT_EQ(ut30a_frame_ts(ctx_, 0), kBase);
+  EXPECT_EQ(ut30a_frame_flows_complete(ctx_, 0), 0x3u);
+  for (uint32_t row = 0; row < ticks(); row++) {
+    for (uint16_t ch = 0; ch < 4; ch++) {
+      int flow = ch / UT30A_FLOW_CHANNELS;
+      uint16_t expect = ut30a_wire_sample(flow, ch % UT30A_FLOW_CHANNELS, kBase + row);
+      ASSERT_EQ(ut30a_last_frame_sample(ctx_, row, ch), expect)
+          << "row " << row << " ch " << ch;
+    }
+  }
+}
+
+/* A flow behind the other by one frame still lands in the right frames. */
+TEST_F(St30RxAggTest, SkewedFlowsWithinOpenWindow) {
+  create(4);
+  ut30a_feed_frame(ctx_, 0, 0, kBase);
+  ut30a_feed_frame(ctx_, 0, 4, kBase + ticks());
+  EXPECT_EQ(ut30a_frame_count(ctx_), 0);
+
+  ut30a_feed_frame(ctx_, 1, 0, kBase);
+  ASSERT_EQ(ut30a_frame_count(ctx_), 1);
+  EXPECT_EQ(ut30a_frame_ts(ctx_, 0), kBase);
+  ut30a_feed_frame(ctx_, 1, 4, kBase + ticks());
+  ASSERT_EQ(ut30a_frame_count(ctx_), 2);
+  EXPECT_EQ(ut30a_frame_ts(ctx_, 1), kBase + ticks());
+  EXPECT_EQ(ut30a_frame_status(ctx_, 1), ST_FRAME_STATUS_COMPLETE);
+  EXPECT_EQ(ut30a_last_frame_sample(ctx_, 5, 3),
+            ut30a_wire_sample(1, 1, kBase + ticks() + 5));
+}
+
+/* A missed flow is closed by the later frames as corrupted with silence. */
+TEST_F(St30RxAggTest, MissingFlowIsSilenceAndCorrupted) {
+  create(4);
+  ut30a_feed_frame(ctx_, 0, 0, kBase);
+  ut30a_feed_frame(ctx_, 0, 4, kBase + ticks());
+  ut30a_feed_pkt(ctx_, 0, 8, kBase + 2 * ticks()); /* out of the window, close frame 0 */
+
+  ASSERT_EQ(ut30a_frame_count(ctx_), 1);
+  EXPECT_EQ(ut30a_frame_status(ctx_, 0), ST_FRAME_STATUS_CORRUPTED);
+  EXPECT_EQ(ut30a_frame_flows_complete(ctx_, 0), 0x1u);
+  EXPECT_EQ(ut30a_last_frame_sample(ctx_, 7, 1), ut30a_wire_sample(0, 1, kBase + 7));
+  EXPECT_EQ(ut30a_last_frame_sample(ctx_, 7, 2), 0);
+  EXPECT_EQ(ut30a_last_frame_sample(ctx_, 7, 3), 0);
+}
+
+/* The group channels not covered by any flow are silence in complete frames. */
+TEST_F(St30RxAggTest, UncoveredChannelsAreSilence) {
+  create(6);
+  ut30a_feed_frame(ctx_, 0, 0, kBase);
+  ut30a_feed_frame(ctx_, 1, 0, kBase);
+
+  ASSERT_EQ(ut30a_frame_count(ctx_), 1);
+  EXPECT_EQ(ut30a_frame_status(ctx_, 0), ST_FRAME_STATUS_COMPLETE);
+  EXPECT_EQ(ut30a_last_frame_sample(ctx_, 3, 3), ut30a_wire_sample(1, 1, kBase + 3));
+  EXPECT_EQ(ut30a_last_frame_sample(ctx_, 3, 4), 0);
+  EXPECT_EQ(ut30a_last_frame_sample(ctx_, 3, 5), 0);
+}
+
+/* Packets before the open window or off the packet grid are dropped. */
+TEST_F(St30RxAggTest, LateAndMisalignedDropped) {
+  create(4);
+  ut30a_feed_frame(ctx_, 0, 0, kBase);
+  ut30a_feed_frame(ctx_, 0, 4, kBase + ticks());
+  ut30a_feed_pkt(ctx_, 0, 8, kBase + 2 * ticks());
+  ASSERT_EQ(ut30a_frame_count(ctx_), 1);
+
+  /* flow 1 is too far behind, its first frame is closed already */
+  EXPECT_LT(ut30a_feed_pkt(ctx_, 1, 0, kBase), 0);
+  EXPECT_EQ(ut30a_stat_late(ctx_), 1u);
+
+  EXPECT_LT(ut30a_feed_pkt(ctx_, 0, 9, kBase + 2 * ticks() + 7), 0);
+  EXPECT_EQ(ut30a_stat_misaligned(ctx_), 1u);
+  EXPECT_EQ(ut30a_frame_count(ctx_), 1);
+}
+
+/* A frame of packets far behind the window is a clock step back, the group resyncs. */
+TEST_F(St30RxAggTest, ClockBackResync) {
+  create(4);
+  ut30a_feed_frame(ctx_, 0, 0, kBase + 10 * ticks());
+  ut30a_feed_frame(ctx_, 1, 0, kBase + 10 * ticks());
+  ASSERT_EQ(ut30a_frame_count(ctx_), 1);
+
+  /* the first three are late, the fourth in a row resyncs to the first */
+  ut30a_feed_frame(ctx_, 0, 4, kBase);
+  EXPECT_EQ(ut30a_stat_late(ctx_), 3u);
+  ut30a_feed_frame(ctx_, 1, 4, kBase);
+  ut30a_feed_frame(ctx_, 0, 8, kBase + ticks());
+  ut30a_feed_frame(ctx_, 1, 8, kBase + ticks());
+
+  ASSERT_EQ(ut30a_frame_count(ctx_), 3);
+  EXPECT_EQ(ut30a_frame_ts(ctx_, 1), kBase);
+  EXPECT_EQ(ut30a_frame_status(ctx_, 1), ST_FRAME_STATUS_CORRUPTED);
+  EXPECT_EQ(ut30a_frame_flows_complete(ctx_, 1), 0x2u);
+  EXPECT_EQ(ut30a_frame_ts(ctx_, 2), kBase + ticks());
+  EXPECT_EQ(ut30a_frame_status(ctx_, 2), ST_FRAME_STATUS_COMPLETE);
+}
+
+/* A single flow far behind is dropped as late, the others keep the window. */
+TEST_F(St30RxAggTest, OneBehindPacketNoResync) {
+  create(4);
+  ut30a_feed_frame(ctx_, 0, 0, kBase + 10 * ticks());
+  EXPECT_LT(ut30a_feed_pkt(ctx_, 1, 0, kBase), 0);
+  ut30a_feed_frame(ctx_, 1, 1, kBase + 10 * ticks());
+
+  ASSERT_EQ(ut30a_frame_count(ctx_), 1);
+  EXPECT_EQ(ut30a_frame_ts(ctx_, 0), kBase + 10 * ticks());
+  EXPECT_EQ(ut30a_frame_status(ctx_, 0), ST_FRAME_STATUS_COMPLETE);
+  EXPECT_EQ(ut30a_stat_late(ctx_), 1u);
+}
+
+/* The app callback is never called with the group lock held. */
+TEST_F(St30RxAggTest, NotifyOutOfLock) {
+  create(4);
+  ut30a_feed_frame(ctx_, 0, 0, kBase);
+  ut30a_feed_frame(ctx_, 1, 0, kBase);
+  ut30a_feed_frame(ctx_, 0, 4, kBase + ticks());
+  ut30a_feed_pkt(ctx_, 0, 8, kBase + 3 * ticks()); /* close a corrupted one also */
+
+  ASSERT_EQ(ut30a_frame_count(ctx_), 2);
+  EXPECT_EQ(ut30a_frame_ts(ctx_, 0), kBase);
+  EXPECT_EQ(ut30a_frame_ts(ctx_, 1), kBase + ticks());
+  EXPECT_EQ(ut30a_notify_locked_count(ctx_), 0);
+}
+
+/* The packets of a detached flow leave the open frame, the rest completes it. */
+TEST_F(St30RxAggTest, DetachDropsFlowPackets) {
+  create(4);
+  ut30a_feed_pkt(ctx_, 1, 0, kBase);
+  ut30a_feed_pkt(ctx_, 1, 1, kBase + ut30a_samples_per_pkt(ctx_));
+  ut30a_detach(ctx_, 1);
+
+  for (uint32_t i = 0; i < 3; i++)
+    ut30a_feed_pkt(ctx_, 0, i, kBase + i * ut30a_samples_per_pkt(ctx_));
+  EXPECT_EQ(ut30a_frame_count(ctx_), 0) << "flow 0 still misses a packet";
+  ut30a_feed_pkt(ctx_, 0, 3, kBase + 3 * ut30a_samples_per_pkt(ctx_));
+
+  ASSERT_EQ(ut30a_frame_count(ctx_), 1);
+  EXPECT_EQ(ut30a_frame_status(ctx_, 0), ST_FRAME_STATUS_COMPLETE);
+  EXPECT_EQ(ut30a_frame_flows_complete(ctx_, 0), 0x1u);
+  EXPECT_EQ(ut30a_last_frame_sample(ctx_, 0, 2), 0);
+  EXPECT_EQ(ut30a_last_frame_sample(ctx_, 50, 3), 0);
+  EXPECT_EQ(ut30a_last_frame_sample(ctx_, 50, 1), ut30a_wire_sample(0, 1, kBase + 50));
+}
+
+/* The group stays while a flow is attached. */
+TEST_F(St30RxAggTest, FreeBusyWithFlows) {
+  create(4);
+  EXPECT_EQ(ut30a_agg_free_busy(ctx_), -EBUSY);
+}
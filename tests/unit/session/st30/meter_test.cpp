@@ -0,0 +1,144 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * RX level meter (ST30_RX_FLAG_ENABLE_METER) tests.
+ *
+ *   - the full scale 997Hz sine is 0 dBFS peak, -3.01 dBFS rms and -3.01 LUFS;
+ *   - the true peak finds the peak between the samples;
+ *   - the levels are the same for PCM16, PCM24, AM824 and the sample rates;
+ *   - the silence and the meter before the first 100ms block are the minimum level;
+ *   - the AVX2 and AVX512 kernels equal the scalar kernel, also on the channel tails.
+ *
+ * Build: meson setup build_unit -Denable_unit_tests=true && ninja -C build_unit
+ * Run:   ./build_unit/tests/unit/UnitTest --gtest_filter='St30MeterTest.*'
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "session/st30_meter_harness.h"
+
+namespace {
+constexpr double kFreq = 997.0;
+}  // namespace
+
+class St30MeterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_EQ(ut30m_init(), 0) << "EAL init failed";
+  }
+
+  /* one second of the signal, the levels of the last block */
+  std::vector<struct st30_meter_level> run(enum st30_fmt fmt, enum st30_sampling sampling,
+                                           const std::vector<double>& amp,
+                                           double freq = kFreq, double phase = 0.0,
+                                           bool noise = false,
+                                           enum mtl_simd_level level =
+                                               MTL_SIMD_LEVEL_NONE) {
+    std::vector<struct st30_meter_level> levels(amp.size());
+    struct ut30m_signal sig = {freq, phase, amp.data(), noise};
+    int ret = ut30m_run(fmt, sampling, amp.size(), 1000, &sig, level, levels.data());
+    EXPECT_EQ(ret, (int)amp.size());
+    return levels;
+  }
+};
+
+TEST_F(St30MeterTest, FullScaleSine) {
+  auto l = run(ST30_FMT_PCM24, ST30_SAMPLING_48K, {1.0, 0.1});
+
+  EXPECT_NEAR(l[0].peak, 0.0, 0.01);
+  EXPECT_NEAR(l[0].true_peak, 0.0, 0.05);
+  EXPECT_NEAR(l[0].rms, -3.01, 0.01);
+  EXPECT_NEAR(l[0].loudness, -3.01, 0.02);
+  /* 20 dB down */
+  EXPECT_NEAR(l[1].peak, -20.0, 0.01);
+  EXPECT_NEAR(l[1].rms, -23.01, 0.01);
+  EXPECT_NEAR(l[1].loudness, -23.01, 0.02);
+}
+
+TEST_F(St30MeterTest, TruePeakBetweenSamples) {
+  /* fs/4 at 45 degrees, every sample is at 0.707 of the peak */
+  auto l = run(ST30_FMT_PCM24, ST30_SAMPLING_48K, {0.5}, 12000.0, M_PI / 4);
+
+  EXPECT_NEAR(l[0].peak, -6.02 - 3.01, 0.02);
+  EXPECT_GT(l[0].true_peak, l[0].peak + 2.5);
+  EXPECT_NEAR(l[0].true_peak, -6.02, 0.6);
+}
+
+TEST_F(St30MeterTest, FormatsAndRatesAgree) {
+  auto ref = run(ST30_FMT_PCM24, ST30_SAMPLING_48K, {0.5});
+  const enum st30_fmt fmts[] = {ST30_FMT_PCM16, ST31_FMT_AM824};
+  const enum st30_sampling samplings[] = {ST30_SAMPLING_96K, ST31_SAMPLING_44K};
+
+  for (auto fmt : fmts) {
+    auto l = run(fmt, ST30_SAMPLING_48K, {0.5});
+    EXPECT_NEAR(l[0].peak, ref[0].peak, 0.01) << "fmt " << fmt;
+    EXPECT_NEAR(l[0].true_peak, ref[0].true_peak, 0.01) << "fmt " << fmt;
+    EXPECT_NEAR(l[0].rms, ref[0].rms, 0.01) << "fmt " << fmt;
+    EXPECT_NEAR(l[0].loudness, ref[0].loudness, 0.01) << "fmt " << fmt;
+  }
+  /* the K-weighting is designed for each rate, a 44.1k block ends inside a packet */
+  for (auto sampling : samplings) {
+    auto l = run(ST30_FMT_PCM24, sampling, {0.5});
+    EXPECT_NEAR(l[0].rms, ref[0].rms, 0.02) << "sampling " << sampling;
+    EXPECT_NEAR(l[0].loudness, ref[0].loudness, 0.05) << "sampling " << sampling;
+  }
+}
+
+TEST_F(St30MeterTest, SilenceIsMin) {
+  auto l = run(ST30_FMT_PCM16, ST30_SAMPLING_48K, {0.0, 0.0, 0.0});
+
+  for (auto& level : l) {
+    EXPECT_EQ(level.peak, ST30_METER_LEVEL_MIN);
+    EXPECT_EQ(level.true_peak, ST30_METER_LEVEL_MIN);
+    EXPECT_EQ(level.rms, ST30_METER_LEVEL_MIN);
+    EXPECT_EQ(level.loudness, ST30_METER_LEVEL_MIN);
+  }
+}
+
+TEST_F(St30MeterTest, MinBeforeFirstBlock) {
+  const double amp = 1.0;
+  struct ut30m_signal sig = {kFreq, 0.0, &amp, false};
+  struct st30_meter_level l;
+
+  /* 99 packets of 1ms */
+  ASSERT_EQ(ut30m_run(ST30_FMT_PCM24, ST30_SAMPLING_48K, 1, 99, &sig,
+                      MTL_SIMD_LEVEL_NONE, &l),
+            1);
+  EXPECT_EQ(l.peak, ST30_METER_LEVEL_MIN);
+  EXPECT_EQ(l.loudness, ST30_METER_LEVEL_MIN);
+  ASSERT_EQ(ut30m_run(ST30_FMT_PCM24, ST30_SAMPLING_48K, 1, 100, &sig,
+                      MTL_SIMD_LEVEL_NONE, &l),
+            1);
+  EXPECT_NEAR(l.peak, 0.0, 0.01);
+}
+
+TEST_F(St30MeterTest, SimdMatchesScalar) {
+  const enum mtl_simd_level levels[] = {MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX512};
+  const uint16_t channels[] = {1, 8, 13, 37};
+
+  for (auto ch : channels) {
+    std::vector<double> amp(ch);
+    for (uint16_t c = 0; c < ch; c++) amp[c] = 0.9 / (c + 1);
+    auto ref = run(ST30_FMT_PCM24, ST30_SAMPLING_48K, amp, kFreq, 0.0, true);
+
+    for (auto level : levels) {
+      if (mtl_get_simd_level() < level) continue;
+      auto l = run(ST30_FMT_PCM24, ST30_SAMPLING_48K, amp, kFreq, 0.0, true, level);
+      for (uint16_t c = 0; c < ch; c++) {
+        EXPECT_NEAR(l[c].peak, ref[c].peak, 1e-3) << "ch " << c << " level " << level;
+        EXPECT_NEAR(l[c].true_peak, ref[c].true_peak, 1e-3) << "ch " << c;
+        EXPECT_NEAR(l[c].rms, ref[c].rms, 1e-3) << "ch " << c;
+        EXPECT_NEAR(l[c].loudness, ref[c].loudness, 1e-3) << "ch " << c;
+      }
+    }
+  }
+}
+
+TEST_F(St30MeterTest, CreateChecks) {
+  EXPECT_EQ(ut30m_create(ST30_FMT_PCM8, 2), 0);
+  EXPECT_EQ(ut30m_create(ST30_FMT_PCM16, 2), 0);
+  EXPECT_EQ(ut30m_create(ST31_FMT_AM824, 2), 0);
+  EXPECT_NE(ut30m_create(ST30_FMT_PCM24, 0), 0);
+}
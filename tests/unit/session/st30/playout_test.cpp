@@ -0,0 +1,125 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * RX playout ring: the packets of both ports into the media clock slots, read back
+ * for a PTP time with the latency, the missing packets concealed with silence.
+ *
+ * Build: meson setup build_unit -Denable_unit_tests=true && ninja -C build_unit
+ * Run:   ./build_unit/tests/unit/UnitTest --gtest_filter='St30RxPlayoutTest.*'
+ */
+
+#include <gtest/gtest.h>
+
+#include "session/st30_playout_harness.h"
+
+class St30RxPlayoutTest : public ::testing::Test {
+ protected:
+  ut30p_test_ctx* ctx_ = nullptr;
+  uint32_t concealed_ = 0;
+  uint32_t ahead_ = 0;
+
+  void SetUp() override {
+    ASSERT_EQ(ut30p_init(), 0) << "EAL init failed";
+    ctx_ = ut30p_ctx_create();
+    ASSERT_NE(ctx_, nullptr);
+  }
+
+  void TearDown() override {
+    ut30p_ctx_destroy(ctx_);
+    ctx_ = nullptr;
+  }
+
+  /* the samples of packet k are played at its ptp time plus the latency */
+  int read_pkts(uint32_t k, uint32_t pkts) {
+    return ut30p_read(ctx_, ut30p_pkt_ptp_time(k) + UT30P_LATENCY_US * 1000ULL,
+                      pkts * UT30P_SAMPLES_PER_PKT, &concealed_, &ahead_);
+  }
+
+  void expect_pkt(uint32_t row, uint32_t k) {
+    for (uint32_t t = 0; t < UT30P_SAMPLES_PER_PKT; t++) {
+      for (uint16_t c = 0; c < UT30P_CHANNELS; c++) {
+        ASSERT_EQ(ut30p_sample(ctx_, row + t, c),
+                  ut30p_wire_sample(c, ut30p_pkt_rtp_ts(k) + t))
+            << "pkt " << k << " sample " << t << " ch " << c;
+      }
+    }
+  }
+};
+
+/* The samples read for a PTP time are the ones sampled at the time minus latency. */
+TEST_F(St30RxPlayoutTest, ReadsSamplesOfPtpTime) {
+  for (uint32_t k = 0; k < 4; k++)
+    EXPECT_EQ(ut30p_feed_pkt(ctx_, k, MTL_SESSION_PORT_P, 100 * 1000), 0);
+
+  ASSERT_EQ(read_pkts(1, 3), 0);
+  EXPECT_EQ(concealed_, 0u);
+  EXPECT_EQ(ahead_, 0u);
+  expect_pkt(0, 1);
+  expect_pkt(UT30P_SAMPLES_PER_PKT, 2);
+  expect_pkt(UT30P_SAMPLES_PER_PKT * 2, 3);
+}
+
+/* A read inside a packet starts at the sample of the PTP time. */
+TEST_F(St30RxPlayoutTest, ReadsFromInsidePacket) {
+  for (uint32_t k = 0; k < 2; k++) ut30p_feed_pkt(ctx_, k, MTL_SESSION_PORT_P, 0);
+
+  /* 10 samples into packet 0, 208.334us at 48k */
+  uint64_t t = ut30p_pkt_ptp_time(0) + UT30P_LATENCY_US * 1000ULL + 208334;
+  ASSERT_EQ(ut30p_read(ctx_, t, UT30P_SAMPLES_PER_PKT, &concealed_, &ahead_), 0);
+  EXPECT_EQ(concealed_, 0u);
+  EXPECT_EQ(ut30p_sample(ctx_, 0, 1), ut30p_wire_sample(1, ut30p_pkt_rtp_ts(0) + 10));
+  EXPECT_EQ(ut30p_sample(ctx_, 47, 0), ut30p_wire_sample(0, ut30p_pkt_rtp_ts(1) + 9));
+}
+
+/* Both ports fill the same slots whatever the link offset, the copy is merged once. */
+TEST_F(St30RxPlayoutTest, RedundantPortsMerged) {
+  ut30p_feed_pkt(ctx_, 0, MTL_SESSION_PORT_P, 50 * 1000);
+  ut30p_feed_pkt(ctx_, 2, MTL_SESSION_PORT_P, 50 * 1000);
+  /* the R link is 700us longer and carries packet 1 lost on P */
+  for (uint32_t k = 0; k < 3; k++)
+    ut30p_feed_pkt(ctx_, k, MTL_SESSION_PORT_R, 750 * 1000);
+
+  ASSERT_EQ(read_pkts(0, 3), 0);
+  EXPECT_EQ(concealed_, 0u);
+  expect_pkt(UT30P_SAMPLES_PER_PKT, 1);
+  EXPECT_EQ(ut30p_stat_redundant(ctx_), 2u);
+  EXPECT_EQ(ut30p_session_redundant(ctx_), 2u);
+  EXPECT_EQ(ut30p_session_received(ctx_), 3u);
+}
+
+/* A lost packet is silence and counted, the samples not received yet are ahead. */
+TEST_F(St30RxPlayoutTest, LostAndAheadConcealed) {
+  ut30p_feed_pkt(ctx_, 0, MTL_SESSION_PORT_P, 0);
+  ut30p_feed_pkt(ctx_, 2, MTL_SESSION_PORT_P, 0);
+
+  ASSERT_EQ(read_pkts(0, 5), 0);
+  EXPECT_EQ(concealed_, (uint32_t)UT30P_SAMPLES_PER_PKT);
+  EXPECT_EQ(ahead_, (uint32_t)UT30P_SAMPLES_PER_PKT * 2);
+  expect_pkt(0, 0);
+  EXPECT_EQ(ut30p_sample(ctx_, UT30P_SAMPLES_PER_PKT + 5, 1), 0);
+  expect_pkt(UT30P_SAMPLES_PER_PKT * 2, 2);
+  EXPECT_EQ(ut30p_sample(ctx_, UT30P_SAMPLES_PER_PKT * 4 + 5, 0), 0);
+}
+
+/* The slot reused by a newer packet is not read as the old one. */
+TEST_F(St30RxPlayoutTest, OverwrittenSlotConcealed) {
+  for (uint32_t k = 0; k <= UT30P_SLOTS; k++)
+    ut30p_feed_pkt(ctx_, k, MTL_SESSION_PORT_P, 0);
+
+  /* packet 0 and packet UT30P_SLOTS share the slot */
+  ASSERT_EQ(read_pkts(0, 2), 0);
+  EXPECT_EQ(concealed_, (uint32_t)UT30P_SAMPLES_PER_PKT);
+  EXPECT_EQ(ut30p_sample(ctx_, 3, 0), 0);
+  expect_pkt(UT30P_SAMPLES_PER_PKT, 1);
+}
+
+/* A packet older than the ring is dropped, the newer samples stay. */
+TEST_F(St30RxPlayoutTest, TooLatePacketDropped) {
+  for (uint32_t k = 4; k < 4 + UT30P_SLOTS; k++)
+    ut30p_feed_pkt(ctx_, k, MTL_SESSION_PORT_P, 0);
+
+  EXPECT_LT(ut30p_feed_pkt(ctx_, 3, MTL_SESSION_PORT_R, 0), 0);
+  ASSERT_EQ(read_pkts(4, 1), 0);
+  EXPECT_EQ(concealed_, 0u);
+  expect_pkt(0, 4);
+}
@@ -0,0 +1,264 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness for the ST30 (audio) RX aggregation group unit tests.
+ */
+
+#include <rte_atomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#undef MTL_HAS_USDT
+#include "common/ut_common.h"
+#include "st2110/st_rx_audio_session.c"
+
+#define UT30A_PKT_PAYLOAD (48 * UT30A_FLOW_CHANNELS * 2) /* 48 samples of PCM16 */
+#define UT30A_PKTS_PER_FRAME 4
+#define UT30A_FRAME_COUNT 3
+#define UT30A_LOG_MAX 64
+
+struct ut30a_test_ctx {
+  struct mtl_main_impl impl;
+  struct st_rx_audio_sessions_mgr mgr;
+  struct st_rx_audio_session_impl sessions[UT30A_FLOWS];
+  st30_rx_agg_handle agg;
+
+  size_t frame_size;
+  uint16_t group_channel;
+  uint8_t* last_frame;
+
+  int rec_n;
+  int rec_status[UT30A_LOG_MAX];
+  uint32_t rec_ts[UT30A_LOG_MAX];
+  uint64_t rec_flows[UT30A_LOG_MAX];
+  int rec_locked;
+};
+
+#include "session/st30_agg_harness.h"
+
+static uint64_t ut30a_ptp_time(struct mtl_main_impl* impl, enum mtl_port port) {
+  (void)port;
+  impl->ptp_usync += 1000;
+  return impl->ptp_usync;
+}
+
+static int ut30a_notify_frame_ready(void* priv, void* frame,
+                                    struct st30_rx_agg_frame_meta* meta) {
+  ut30a_test_ctx* ctx = priv;
+
+  if (rte_spinlock_is_locked(&ctx->agg->lock)) ctx->rec_locked++;
+  if (ctx->rec_n < UT30A_LOG_MAX) {
+    ctx->rec_status[ctx->rec_n] = meta->status;
+    ctx->rec_ts[ctx->rec_n] = meta->rtp_timestamp;
+    ctx->rec_flows[ctx->rec_n] = meta->flows_complete;
+    ctx->rec_n++;
+  }
+  memcpy(ctx->last_frame, frame, ctx->frame_size);
+  return st30_rx_agg_put_framebuff(ctx->agg, frame);
+}
+
+int ut30a_init(void) {
+  return ut_eal_init();
+}
+
+static int ut30a_session_init(ut30a_test_ctx* ctx, int flow) {
+  struct st_rx_audio_session_impl* s = &ctx->sessions[flow];
+  int ret;
+
+  s->idx = flow;
+  s->socket_id = rte_socket_id();
+  s->mgr = &ctx->mgr;
+  s->attached = true;
+  s->usdt_dump_fd = -1;
+
+  s->ops.type = ST30_TYPE_FRAME_LEVEL;
+  s->ops.num_port = 1;
+  s->ops.channel = UT30A_FLOW_CHANNELS;
+  s->ops.sampling = ST30_SAMPLING_48K;
+  s->ops.fmt = ST30_FMT_PCM16;
+  s->ops.ptime = ST30_PTIME_1MS;
+  s->ops.name = "ut30a_flow";
+  s->ops.agg = ctx->agg;
+  s->ops.agg_channel_offset = flow * UT30A_FLOW_CHANNELS;
+
+  /* same as rx_audio_session_attach for a group member */
+  s->pkt_len = UT30A_PKT_PAYLOAD;
+  s->st30_pkt_size = UT30A_PKT_PAYLOAD + sizeof(struct st_rfc3550_audio_hdr);
+  s->st30_total_pkts = 1;
+  s->st30_frame_size = UT30A_PKT_PAYLOAD;
+  s->rtp_ticks_per_frame = 48;
+  s->samples_per_pkt = 48;
+  s->port_maps[MTL_SESSION_PORT_P] = MTL_PORT_P;
+  s->priv[MTL_SESSION_PORT_P].session = s;
+  s->priv[MTL_SESSION_PORT_P].impl = &ctx->impl;
+  s->priv[MTL_SESSION_PORT_P].s_port = MTL_SESSION_PORT_P;
+  rx_audio_session_reset(s, false);
+
+  ret = st_rx_audio_agg_attach(ctx->agg, &s->ops);
+  if (ret < 0) return ret;
+  s->agg = ctx->agg;
+  s->agg_flow = ret;
+  return 0;
+}
+
+ut30a_test_ctx* ut30a_ctx_create(uint16_t group_channel) {
+  ut30a_test_ctx* ctx = calloc(1, sizeof(*ctx));
+  struct st30_rx_agg_ops ops;
+
+  if (!ctx) return NULL;
+
+  ctx->impl.type = MT_HANDLE_MAIN;
+  ctx->impl.tsc_hz = rte_get_tsc_hz();
+  for (int i = 0; i < MTL_PORT_MAX; i++) {
+    ctx->impl.inf[i].parent = &ctx->impl;
+    ctx->impl.inf[i].port = i;
+    ctx->impl.inf[i].socket_id = rte_socket_id();
+    ctx->impl.inf[i].ptp_get_time_fn = ut30a_ptp_time;
+  }
+  rte_spinlock_init(&ctx->impl.stat_mgr.lock);
+  MT_TAILQ_INIT(&ctx->impl.stat_mgr.head);
+  ctx->mgr.parent = &ctx->impl;
+
+  ctx->group_channel = group_channel;
+  ctx->frame_size = (size_t)group_channel * 2 * 48 * UT30A_PKTS_PER_FRAME;
+  ctx->last_frame = calloc(1, ctx->frame_size);
+  if (!ctx->last_frame) {
+    free(ctx);
+    return NULL;
+  }
+
+  memset(&ops, 0, sizeof(ops));
+  ops.name = "ut30a_group";
+  ops.priv = ctx;
+  ops.fmt = ST30_FMT_PCM16;
+  ops.channel = group_channel;
+  ops.sampling = ST30_SAMPLING_48K;
+  ops.ptime = ST30_PTIME_1MS;
+  ops.framebuff_cnt = UT30A_FRAME_COUNT;
+  ops.framebuff_size = ctx->frame_size;
+  ops.notify_frame_ready = ut30a_notify_frame_ready;
+  ctx->agg = st30_rx_agg_create(&ctx->impl, &ops);
+  if (!ctx->agg) goto fail;
+
+  for (int flow = 0; flow < UT30A_FLOWS; flow++) {
+    if (ut30a_session_init(ctx, flow) < 0) goto fail;
+  }
+  return ctx;
+
+fail:
+  ut30a_ctx_destroy(ctx);
+  return NULL;
+}
+
+void ut30a_ctx_destroy(ut30a_test_ctx* ctx) {
+  if (!ctx) return;
+  for (int flow = 0; flow < UT30A_FLOWS; flow++) {
+    struct st_rx_audio_session_impl* s = &ctx->sessions[flow];
+    if (s->agg) st_rx_audio_agg_detach(s->agg, s->agg_flow);
+  }
+  if (ctx->agg) st30_rx_agg_free(ctx->agg);
+  free(ctx->last_frame);
+  free(ctx);
+}
+
+uint16_t ut30a_wire_sample(int flow, uint16_t channel, uint32_t tick) {
+  return (uint16_t)(((flow + 1) << 12) | (channel << 8) | (tick & 0xff));
+}
+
+int ut30a_feed_pkt(ut30a_test_ctx* ctx, int flow, uint16_t seq, uint32_t ts) {
+  size_t total = sizeof(struct st_rfc3550_audio_hdr) + UT30A_PKT_PAYLOAD;
+  size_t hdr_offset =
+      sizeof(struct st_rfc3550_audio_hdr) - sizeof(struct st_rfc3550_rtp_hdr);
+  struct rte_mbuf* m = rte_pktmbuf_alloc(ut_pool());
+  struct st_rfc3550_rtp_hdr* rtp;
+  uint8_t* payload;
+  int rc;
+
+  if (!m) return -ENOMEM;
+  memset(rte_pktmbuf_mtod(m, uint8_t*), 0, total);
+  rtp = rte_pktmbuf_mtod_offset(m, struct st_rfc3550_rtp_hdr*, hdr_offset);
+  rtp->version = 2;
+  rtp->seq_number = htons(seq);
+  rtp->tmstamp = htonl(ts);
+  payload = (uint8_t*)&rtp[1];
+  for (uint32_t t = 0; t < 48; t++) {
+    for (uint16_t c = 0; c < UT30A_FLOW_CHANNELS; c++) {
+      uint16_t v = ut30a_wire_sample(flow, c, ts + t);
+      payload[(t * UT30A_FLOW_CHANNELS + c) * 2] = v >> 8;
+      payload[(t * UT30A_FLOW_CHANNELS + c) * 2 + 1] = v & 0xff;
+    }
+  }
+  m->data_len = total;
+  m->pkt_len = total;
+
+  rc = rx_audio_session_handle_frame_pkt(&ctx->impl, &ctx->sessions[flow], m,
+                                         MTL_SESSION_PORT_P);
+  rte_pktmbuf_free(m);
+  return rc;
+}
+
+void ut30a_feed_frame(ut30a_test_ctx* ctx, int flow, uint16_t seq_start, uint32_t ts) {
+  for (uint32_t i = 0; i < UT30A_PKTS_PER_FRAME; i++)
+    ut30a_feed_pkt(ctx, flow, seq_start + i, ts + i * 48);
+}
+
+uint32_t ut30a_samples_per_pkt(const ut30a_test_ctx* ctx) {
+  return ctx->agg->samples_per_pkt;
+}
+
+uint32_t ut30a_pkts_per_frame(const ut30a_test_ctx* ctx) {
+  return ctx->agg->pkts_per_frame;
+}
+
+int ut30a_frame_count(const ut30a_test_ctx* ctx) {
+  return ctx->rec_n;
+}
+
+int ut30a_frame_status(const ut30a_test_ctx* ctx, int i) {
+  if (i < 0 || i >= ctx->rec_n) return -1;
+  return ctx->rec_status[i];
+}
+
+uint32_t ut30a_frame_ts(const ut30a_test_ctx* ctx, int i) {
+  if (i < 0 || i >= ctx->rec_n) return 0;
+  return ctx->rec_ts[i];
+}
+
+uint64_t ut30a_frame_flows_complete(const ut30a_test_ctx* ctx, int i) {
+  if (i < 0 || i >= ctx->rec_n) return 0;
+  return ctx->rec_flows[i];
+}
+
+int ut30a_notify_locked_count(const ut30a_test_ctx* ctx) {
+  return ctx->rec_locked;
+}
+
+uint16_t ut30a_last_frame_sample(const ut30a_test_ctx* ctx, uint32_t row,
+                                 uint16_t channel) {
+  const uint8_t* p = ctx->last_frame + ((size_t)row * ctx->group_channel + channel) * 2;
+  return (uint16_t)(p[0] << 8 | p[1]);
+}
+
+uint64_t ut30a_stat_late(const ut30a_test_ctx* ctx) {
+  return ctx->agg->stat_pkts_late;
+}
+
+uint64_t ut30a_stat_misaligned(const ut30a_test_ctx* ctx) {
+  return ctx->agg->stat_pkts_misaligned;
+}
+
+uint64_t ut30a_stat_redundant(const ut30a_test_ctx* ctx) {
+  return ctx->agg->stat_pkts_redundant;
+}
+
+void ut30a_detach(ut30a_test_ctx* ctx, int flow) {
+  struct st_rx_audio_session_impl* s = &ctx->sessions[flow];
+
+  if (!s->agg) return;
+  st_rx_audio_agg_detach(s->agg, s->agg_flow);
+  s->agg = NULL;
+}
+
+int ut30a_agg_free_busy(ut30a_test_ctx* ctx) {
+  return st30_rx_agg_free(ctx->agg);
+}
@@ -0,0 +1,73 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness API for the ST 2110-30 (audio) RX aggregation group unit tests.
+ *
+ * The harness creates one group of PCM16 48 kHz 1 ms frames of four packets and
+ * two 2-channel rx sessions joined to it, flow 0 at channel 0 and flow 1 at
+ * channel 2. The group channel is given at create, a wider group leaves the
+ * channels after the flows as silence.
+ *
+ * The 16 bit sample of flow f, channel c at the rtp tick t is
+ * ((f + 1) << 12) | (c << 8) | (t & 0xff), see ut30a_wire_sample().
+ */
+
+#ifndef _ST30_AGG_HARNESS_H_
+#define _ST30_AGG_HARNESS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mtl_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UT30A_FLOWS 2
+#define UT30A_FLOW_CHANNELS 2
+
+typedef struct ut30a_test_ctx ut30a_test_ctx;
+
+int ut30a_init(void);
+
+/* NULL on fail, free with ut30a_ctx_destroy() */
+ut30a_test_ctx* ut30a_ctx_create(uint16_t group_channel);
+void ut30a_ctx_destroy(ut30a_test_ctx* ctx);
+
+/* one packet of the flow at the rtp ts, the handler return code */
+int ut30a_feed_pkt(ut30a_test_ctx* ctx, int flow, uint16_t seq, uint32_t ts);
+/* all the packets of one frame of the flow from the rtp ts, seq from seq_start */
+void ut30a_feed_frame(ut30a_test_ctx* ctx, int flow, uint16_t seq_start, uint32_t ts);
+
+uint16_t ut30a_wire_sample(int flow, uint16_t channel, uint32_t tick);
+
+uint32_t ut30a_samples_per_pkt(const ut30a_test_ctx* ctx);
+uint32_t ut30a_pkts_per_frame(const ut30a_test_ctx* ctx);
+
+/* the frames notified by the group, in order */
+int ut30a_frame_count(const ut30a_test_ctx* ctx);
+int ut30a_frame_status(const ut30a_test_ctx* ctx, int i);
+uint32_t ut30a_frame_ts(const ut30a_test_ctx* ctx, int i);
+uint64_t ut30a_frame_flows_complete(const ut30a_test_ctx* ctx, int i);
+/* the notify_frame_ready calls made with the group lock held */
+int ut30a_notify_locked_count(const ut30a_test_ctx* ctx);
+/* the 16 bit sample at the sample row and the group channel of the last frame */
+uint16_t ut30a_last_frame_sample(const ut30a_test_ctx* ctx, uint32_t row,
+                                 uint16_t channel);
+
+uint64_t ut30a_stat_late(const ut30a_test_ctx* ctx);
+uint64_t ut30a_stat_misaligned(const ut30a_test_ctx* ctx);
+uint64_t ut30a_stat_redundant(const ut30a_test_ctx* ctx);
+
+/* detach the flow from the group, as its session is freed */
+void ut30a_detach(ut30a_test_ctx* ctx, int flow);
+
+/* st30_rx_agg_free with the flows still attached */
+int ut30a_agg_free_busy(ut30a_test_ctx* ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ST30_AGG_HARNESS_H_ */
@@ -0,0 +1,88 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness for the ST30 (audio) RX level meter unit tests.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "common/ut_common.h"
+#include "st2110/st_rx_audio_meter.h"
+
+#include "session/st30_meter_harness.h"
+
+int ut30m_init(void) {
+  return ut_eal_init();
+}
+
+int ut30m_create(enum st30_fmt fmt, uint16_t channel) {
+  struct st_rx_audio_meter_impl* m = st_rx_audio_meter_create(
+      0, fmt, channel, ST30_SAMPLING_48K, ST30_PTIME_1MS, rte_socket_id());
+
+  if (!m) return -EINVAL;
+  st_rx_audio_meter_free(m);
+  return 0;
+}
+
+/* the full scale value to the big endian wire sample */
+static void ut30m_store(uint8_t* p, double v, enum st30_fmt fmt) {
+  if (fmt == ST30_FMT_PCM16) {
+    int32_t s = (int32_t)lrint(v * 32767.0);
+    p[0] = s >> 8;
+    p[1] = s;
+  } else if (fmt == ST30_FMT_PCM24) {
+    int32_t s = (int32_t)lrint(v * 8388607.0);
+    p[0] = s >> 16;
+    p[1] = s >> 8;
+    p[2] = s;
+  } else {
+    /* AM824, the label then the 24 bit sample */
+    p[0] = 0x20;
+    ut30m_store(p + 1, v, ST30_FMT_PCM24);
+  }
+}
+
+int ut30m_run(enum st30_fmt fmt, enum st30_sampling sampling, uint16_t channel,
+              uint32_t pkts, const struct ut30m_signal* sig, enum mtl_simd_level level,
+              struct st30_meter_level* levels) {
+  struct st_rx_audio_meter_impl* m = st_rx_audio_meter_create(
+      0, fmt, channel, sampling, ST30_PTIME_1MS, rte_socket_id());
+  int sample_size = st30_get_sample_size(fmt);
+  uint32_t seed = 1;
+  uint64_t n = 0;
+  uint8_t* payload;
+  int ret = 0;
+
+  if (!m) return -EINVAL;
+  m->simd_level = level;
+  payload = malloc(m->pkt_len);
+  if (!payload) {
+    st_rx_audio_meter_free(m);
+    return -ENOMEM;
+  }
+
+  for (uint32_t k = 0; k < pkts; k++) {
+    for (uint32_t r = 0; r < m->samples_per_pkt; r++, n++) {
+      double w = 2.0 * M_PI * sig->freq * n / m->sample_rate + sig->phase;
+
+      for (uint16_t c = 0; c < channel; c++) {
+        double v = sig->amp[c] * sin(w);
+
+        if (sig->noise) {
+          seed = seed * 1103515245u + 12345u;
+          v += sig->amp[c] * ((double)(seed >> 8) / (1u << 24) - 0.5);
+        }
+        v = fmax(fmin(v, 1.0), -1.0);
+        ut30m_store(payload + (size_t)(r * channel + c) * sample_size, v, fmt);
+      }
+    }
+    ret = st_rx_audio_meter_put_pkt(m, payload);
+    if (ret < 0) break;
+  }
+
+  if (ret >= 0) ret = st_rx_audio_meter_read(m, levels, channel);
+  free(payload);
+  st_rx_audio_meter_free(m);
+  return ret;
+}
@@ -0,0 +1,46 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness API for the ST 2110-30 (audio) RX level meter unit tests.
+ *
+ * The harness meters the packets of a generated signal with the production meter, the
+ * simd level can be forced to compare the AVX2 and AVX512 kernels against the scalar
+ * reference. Channel c is amp[c] * sin(2 * pi * freq * n / rate + phase), plus the
+ * noise of amp[c] if noise is set.
+ */
+
+#ifndef _ST30_METER_HARNESS_H_
+#define _ST30_METER_HARNESS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mtl_api.h"
+#include "st30_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct ut30m_signal {
+  double freq;
+  double phase;
+  const double* amp; /* one for each channel */
+  bool noise;
+};
+
+int ut30m_init(void);
+
+/* 0 if the meter is created for the format */
+int ut30m_create(enum st30_fmt fmt, uint16_t channel);
+
+/* meter 1ms packets of the signal at the simd level, the channels read after them */
+int ut30m_run(enum st30_fmt fmt, enum st30_sampling sampling, uint16_t channel,
+              uint32_t pkts, const struct ut30m_signal* sig, enum mtl_simd_level level,
+              struct st30_meter_level* levels);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ST30_METER_HARNESS_H_ */
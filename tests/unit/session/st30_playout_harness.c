@@ -0,0 +1,181 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness for the ST30 (audio) RX playout ring unit tests.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#undef MTL_HAS_USDT
+#include "common/ut_common.h"
+#include "st2110/st_rx_audio_session.c"
+
+#define UT30P_PKT_PAYLOAD (UT30P_SAMPLES_PER_PKT * UT30P_CHANNELS * 2)
+#define UT30P_T0_NS (1000ULL * NS_PER_S) /* media clock 48000000 at 48k */
+#define UT30P_BUF_SAMPLES (UT30P_SAMPLES_PER_PKT * 8)
+
+struct ut30p_test_ctx {
+  struct mtl_main_impl impl; /* first, the ptp stub gets the ctx from it */
+  struct st_rx_audio_sessions_mgr mgr;
+  struct st_rx_audio_session_impl session;
+  struct st_rx_audio_playout_impl* playout;
+
+  uint64_t now; /* the PTP time of the next packet arrival */
+  uint8_t buf[UT30P_BUF_SAMPLES * UT30P_CHANNELS * 2];
+};
+
+#include "session/st30_playout_harness.h"
+
+static uint64_t ut30p_ptp_time(struct mtl_main_impl* impl, enum mtl_port port) {
+  (void)port;
+  return ((ut30p_test_ctx*)impl)->now;
+}
+
+int ut30p_init(void) {
+  return ut_eal_init();
+}
+
+ut30p_test_ctx* ut30p_ctx_create(void) {
+  ut30p_test_ctx* ctx = calloc(1, sizeof(*ctx));
+  struct st_rx_audio_session_impl* s;
+
+  if (!ctx) return NULL;
+
+  ctx->impl.type = MT_HANDLE_MAIN;
+  ctx->impl.tsc_hz = rte_get_tsc_hz();
+  for (int i = 0; i < MTL_PORT_MAX; i++) {
+    ctx->impl.inf[i].parent = &ctx->impl;
+    ctx->impl.inf[i].port = i;
+    ctx->impl.inf[i].socket_id = rte_socket_id();
+    ctx->impl.inf[i].ptp_get_time_fn = ut30p_ptp_time;
+  }
+  ctx->mgr.parent = &ctx->impl;
+
+  /* 16 packets of 1ms */
+  ctx->playout = st_rx_audio_playout_create(&ctx->impl, 0, ST30_FMT_PCM16,
+                                            UT30P_CHANNELS, ST30_SAMPLING_48K,
+                                            ST30_PTIME_1MS, UT30P_LATENCY_US,
+                                            UT30P_SLOTS, rte_socket_id());
+  if (!ctx->playout) {
+    free(ctx);
+    return NULL;
+  }
+
+  s = &ctx->session;
+  s->idx = 0;
+  s->socket_id = rte_socket_id();
+  s->mgr = &ctx->mgr;
+  s->attached = true;
+  s->usdt_dump_fd = -1;
+  s->playout = ctx->playout;
+
+  s->ops.type = ST30_TYPE_FRAME_LEVEL;
+  s->ops.num_port = 2;
+  s->ops.channel = UT30P_CHANNELS;
+  s->ops.sampling = ST30_SAMPLING_48K;
+  s->ops.fmt = ST30_FMT_PCM16;
+  s->ops.ptime = ST30_PTIME_1MS;
+  s->ops.name = "ut30p";
+
+  /* same as rx_audio_session_attach with a playout ring */
+  s->pkt_len = UT30P_PKT_PAYLOAD;
+  s->st30_pkt_size = UT30P_PKT_PAYLOAD + sizeof(struct st_rfc3550_audio_hdr);
+  s->st30_total_pkts = 1;
+  s->st30_frame_size = UT30P_PKT_PAYLOAD;
+  s->rtp_ticks_per_frame = UT30P_SAMPLES_PER_PKT;
+  s->samples_per_pkt = UT30P_SAMPLES_PER_PKT;
+  s->port_maps[MTL_SESSION_PORT_P] = MTL_PORT_P;
+  s->port_maps[MTL_SESSION_PORT_R] = MTL_PORT_R;
+  for (int i = 0; i < MTL_SESSION_PORT_MAX; i++) {
+    s->priv[i].session = s;
+    s->priv[i].impl = &ctx->impl;
+    s->priv[i].s_port = (enum mtl_session_port)i;
+  }
+  rx_audio_session_reset(s, false);
+  return ctx;
+}
+
+void ut30p_ctx_destroy(ut30p_test_ctx* ctx) {
+  if (!ctx) return;
+  if (ctx->playout) st_rx_audio_playout_free(ctx->playout);
+  free(ctx);
+}
+
+uint64_t ut30p_pkt_ptp_time(uint32_t k) {
+  return UT30P_T0_NS + (uint64_t)k * NS_PER_MS;
+}
+
+uint32_t ut30p_pkt_rtp_ts(uint32_t k) {
+  return (uint32_t)(UT30P_T0_NS / NS_PER_S * 48000) + k * UT30P_SAMPLES_PER_PKT;
+}
+
+uint16_t ut30p_wire_sample(uint16_t channel, uint32_t tick) {
+  return (uint16_t)((channel << 12) | (tick & 0xfff));
+}
+
+int ut30p_feed_pkt(ut30p_test_ctx* ctx, uint32_t k, enum mtl_session_port port,
+                   uint64_t link_offset_ns) {
+  size_t total = sizeof(struct st_rfc3550_audio_hdr) + UT30P_PKT_PAYLOAD;
+  size_t hdr_offset =
+      sizeof(struct st_rfc3550_audio_hdr) - sizeof(struct st_rfc3550_rtp_hdr);
+  struct rte_mbuf* m = rte_pktmbuf_alloc(ut_pool());
+  uint32_t ts = ut30p_pkt_rtp_ts(k);
+  struct st_rfc3550_rtp_hdr* rtp;
+  uint8_t* payload;
+  int rc;
+
+  if (!m) return -ENOMEM;
+  memset(rte_pktmbuf_mtod(m, uint8_t*), 0, total);
+  rtp = rte_pktmbuf_mtod_offset(m, struct st_rfc3550_rtp_hdr*, hdr_offset);
+  rtp->version = 2;
+  rtp->seq_number = htons((uint16_t)k);
+  rtp->tmstamp = htonl(ts);
+  payload = (uint8_t*)&rtp[1];
+  for (uint32_t t = 0; t < UT30P_SAMPLES_PER_PKT; t++) {
+    for (uint16_t c = 0; c < UT30P_CHANNELS; c++) {
+      uint16_t v = ut30p_wire_sample(c, ts + t);
+      payload[(t * UT30P_CHANNELS + c) * 2] = v >> 8;
+      payload[(t * UT30P_CHANNELS + c) * 2 + 1] = v & 0xff;
+    }
+  }
+  m->data_len = total;
+  m->pkt_len = total;
+
+  ctx->now = ut30p_pkt_ptp_time(k) + link_offset_ns;
+  rc = rx_audio_session_handle_frame_pkt(&ctx->impl, &ctx->session, m, port);
+  rte_pktmbuf_free(m);
+  return rc;
+}
+
+int ut30p_read(ut30p_test_ctx* ctx, uint64_t ptp_time, uint32_t samples,
+               uint32_t* concealed, uint32_t* ahead) {
+  struct st_rx_audio_playout_impl* p = ctx->playout;
+  uint64_t pos;
+
+  if (samples > UT30P_BUF_SAMPLES) return -EINVAL;
+  /* same as st30p_rx_playout_read */
+  pos = st_rx_audio_playout_ptp2pos(p, ptp_time) - p->latency_samples;
+  return st_rx_audio_playout_read(p, pos, samples, ctx->buf, concealed, ahead);
+}
+
+uint16_t ut30p_sample(const ut30p_test_ctx* ctx, uint32_t row, uint16_t channel) {
+  const uint8_t* p = ctx->buf + ((size_t)row * UT30P_CHANNELS + channel) * 2;
+  return (uint16_t)(p[0] << 8 | p[1]);
+}
+
+uint64_t ut30p_stat_redundant(const ut30p_test_ctx* ctx) {
+  return ctx->playout->stat_pkts_redundant;
+}
+
+uint64_t ut30p_stat_late(const ut30p_test_ctx* ctx) {
+  return ctx->playout->stat_pkts_late;
+}
+
+uint64_t ut30p_session_redundant(const ut30p_test_ctx* ctx) {
+  return ctx->session.port_user_stats.common.stat_pkts_redundant;
+}
+
+uint64_t ut30p_session_received(const ut30p_test_ctx* ctx) {
+  return ctx->session.port_user_stats.common.stat_pkts_received;
+}
@@ -0,0 +1,64 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness API for the ST 2110-30 (audio) RX playout ring unit tests.
+ *
+ * The harness creates one 2-port rx session of PCM16 2-channel 48 kHz 1 ms packets
+ * writing into a playout ring of 16 packets with UT30P_LATENCY_US of latency.
+ * Packet k has the rtp timestamp of the media clock at ut30p_pkt_ptp_time(k),
+ * it arrives at that time plus the link offset given to ut30p_feed_pkt().
+ *
+ * The 16 bit sample of channel c at the rtp tick t is (c << 12) | (t & 0xfff),
+ * see ut30p_wire_sample().
+ */
+
+#ifndef _ST30_PLAYOUT_HARNESS_H_
+#define _ST30_PLAYOUT_HARNESS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mtl_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UT30P_CHANNELS 2
+#define UT30P_SAMPLES_PER_PKT 48
+#define UT30P_SLOTS 16
+#define UT30P_LATENCY_US 2000
+
+typedef struct ut30p_test_ctx ut30p_test_ctx;
+
+int ut30p_init(void);
+
+/* NULL on fail, free with ut30p_ctx_destroy() */
+ut30p_test_ctx* ut30p_ctx_create(void);
+void ut30p_ctx_destroy(ut30p_test_ctx* ctx);
+
+/* the PTP time(ns) the first sample of packet k is sampled at the sender */
+uint64_t ut30p_pkt_ptp_time(uint32_t k);
+uint32_t ut30p_pkt_rtp_ts(uint32_t k);
+uint16_t ut30p_wire_sample(uint16_t channel, uint32_t tick);
+
+/* packet k on the port arriving link_offset_ns after its ptp time, the handler rc */
+int ut30p_feed_pkt(ut30p_test_ctx* ctx, uint32_t k, enum mtl_session_port port,
+                   uint64_t link_offset_ns);
+
+/* read the samples played at the ptp time into the harness buffer */
+int ut30p_read(ut30p_test_ctx* ctx, uint64_t ptp_time, uint32_t samples,
+               uint32_t* concealed, uint32_t* ahead);
+/* the 16 bit sample at the row and the channel of the last read */
+uint16_t ut30p_sample(const ut30p_test_ctx* ctx, uint32_t row, uint16_t channel);
+
+uint64_t ut30p_stat_redundant(const ut30p_test_ctx* ctx);
+uint64_t ut30p_stat_late(const ut30p_test_ctx* ctx);
+uint64_t ut30p_session_redundant(const ut30p_test_ctx* ctx);
+uint64_t ut30p_session_received(const ut30p_test_ctx* ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ST30_PLAYOUT_HARNESS_H_ */
@@ -0,0 +1,126 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * TX sessions deadline: the sessions waiting the tsc are parked out of the tasklet
+ * loop and come back in the order they are due, a kick makes all sessions ready.
+ *
+ * Build: meson setup build_unit -Denable_unit_tests=true && ninja -C build_unit
+ * Run:   ./build_unit/tests/unit/UnitTest --gtest_filter='St30TxDeadlineTest.*'
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "session/st30_tx_deadline_harness.h"
+
+class St30TxDeadlineTest : public ::testing::Test {
+ protected:
+  ut30d_ctx* ctx_ = nullptr;
+
+  void SetUp() override {
+    ASSERT_EQ(ut30d_init(), 0) << "EAL init failed";
+    ctx_ = ut30d_create();
+    ASSERT_NE(ctx_, nullptr);
+  }
+
+  void TearDown() override {
+    ut30d_destroy(ctx_);
+    ctx_ = nullptr;
+  }
+
+  std::vector<uint16_t> ready() {
+    std::vector<uint16_t> idx(UT30D_CAP);
+    idx.resize(ut30d_ready(ctx_, idx.data(), UT30D_CAP));
+    return idx;
+  }
+};
+
+TEST_F(St30TxDeadlineTest, AllReadyAtFirstLoop) {
+  ut30d_expire(ctx_, 5, 0);
+  EXPECT_EQ(ready(), (std::vector<uint16_t>{0, 1, 2, 3, 4}));
+  EXPECT_EQ(ut30d_first(ctx_), UINT64_MAX);
+}
+
+TEST_F(St30TxDeadlineTest, ParkedUntilDue) {
+  ut30d_expire(ctx_, 5, 0);
+  ut30d_park(ctx_, 1, 100);
+  ut30d_park(ctx_, 3, 50);
+  EXPECT_EQ(ut30d_first(ctx_), 50u);
+
+  ut30d_expire(ctx_, 5, 49);
+  EXPECT_EQ(ready(), (std::vector<uint16_t>{0, 2, 4}));
+  ut30d_expire(ctx_, 5, 50);
+  EXPECT_EQ(ready(), (std::vector<uint16_t>{0, 2, 3, 4}));
+  EXPECT_EQ(ut30d_first(ctx_), 100u);
+  ut30d_expire(ctx_, 5, 1000);
+  EXPECT_EQ(ready(), (std::vector<uint16_t>{0, 1, 2, 3, 4}));
+  EXPECT_EQ(ut30d_parked(ctx_), 0);
+}
+
+TEST_F(St30TxDeadlineTest, ParkAgainMoves) {
+  ut30d_expire(ctx_, 4, 0);
+  ut30d_park(ctx_, 2, 100);
+  ut30d_park(ctx_, 2, 10);
+  EXPECT_EQ(ut30d_parked(ctx_), 1);
+  EXPECT_EQ(ut30d_first(ctx_), 10u);
+  ut30d_park(ctx_, 2, 200);
+  EXPECT_EQ(ut30d_first(ctx_), 200u);
+  ut30d_expire(ctx_, 4, 199);
+  EXPECT_EQ(ready(), (std::vector<uint16_t>{0, 1, 3}));
+  ut30d_expire(ctx_, 4, 200);
+  EXPECT_EQ(ready(), (std::vector<uint16_t>{0, 1, 2, 3}));
+}
+
+TEST_F(St30TxDeadlineTest, DroppedUntilKick) {
+  ut30d_expire(ctx_, 3, 0);
+  ut30d_park(ctx_, 0, 10);
+  ut30d_drop(ctx_, 0);
+  ut30d_drop(ctx_, 1);
+  EXPECT_EQ(ut30d_parked(ctx_), 0);
+  ut30d_expire(ctx_, 3, 1000);
+  EXPECT_EQ(ready(), (std::vector<uint16_t>{2}));
+
+  ut30d_kick(ctx_);
+  ut30d_expire(ctx_, 3, 1000);
+  EXPECT_EQ(ready(), (std::vector<uint16_t>{0, 1, 2}));
+}
+
+TEST_F(St30TxDeadlineTest, KickMakesParkedReady) {
+  ut30d_expire(ctx_, 2, 0);
+  ut30d_park(ctx_, 0, 1000);
+  ut30d_park(ctx_, 1, 2000);
+  ut30d_kick(ctx_);
+  ut30d_expire(ctx_, 2, 0);
+  EXPECT_EQ(ready(), (std::vector<uint16_t>{0, 1}));
+  EXPECT_EQ(ut30d_parked(ctx_), 0);
+  EXPECT_EQ(ut30d_first(ctx_), UINT64_MAX);
+}
+
+TEST_F(St30TxDeadlineTest, ManySessionsInDueOrder) {
+  std::mt19937 rng(30);
+  std::vector<uint64_t> due(UT30D_CAP);
+
+  ut30d_expire(ctx_, UT30D_CAP, 0);
+  for (int i = 0; i < UT30D_CAP; i++) {
+    due[i] = 1 + rng() % 10000;
+    ut30d_park(ctx_, i, due[i]);
+  }
+  EXPECT_TRUE(ready().empty());
+  EXPECT_EQ(ut30d_first(ctx_), *std::min_element(due.begin(), due.end()));
+
+  /* each loop brings back the sessions due till then only */
+  for (uint64_t tsc = 0; tsc <= 10000; tsc += 97) {
+    ut30d_expire(ctx_, UT30D_CAP, tsc);
+    std::vector<uint16_t> expect;
+    for (int i = 0; i < UT30D_CAP; i++)
+      if (due[i] <= tsc) expect.push_back(i);
+    ASSERT_EQ(ready(), expect) << "tsc " << tsc;
+  }
+  ut30d_expire(ctx_, UT30D_CAP, 10000);
+  EXPECT_EQ(ready().size(), (size_t)UT30D_CAP);
+  EXPECT_EQ(ut30d_parked(ctx_), 0);
+}
@@ -0,0 +1,102 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * TX batch build group: the sessions of the same profile share one group, each
+ * member keeps its own rtp timestamp delta and seq in the pkts of the group epoch.
+ *
+ * Build: meson setup build_unit -Denable_unit_tests=true && ninja -C build_unit
+ * Run:   ./build_unit/tests/unit/UnitTest --gtest_filter='St30TxGroupTest.*'
+ */
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+
+#include "session/st30_tx_group_harness.h"
+
+class St30TxGroupTest : public ::testing::Test {
+ protected:
+  ut30g_test_ctx* ctx_ = nullptr;
+
+  void SetUp() override {
+    ASSERT_EQ(ut30g_init(), 0) << "EAL init failed";
+    ctx_ = ut30g_ctx_create();
+    ASSERT_NE(ctx_, nullptr);
+  }
+
+  void TearDown() override {
+    ut30g_ctx_destroy(ctx_);
+    ctx_ = nullptr;
+  }
+};
+
+/* A session of the same profile joins the existing group, another one gets its own. */
+TEST_F(St30TxGroupTest, JoinMatchingGroup) {
+  int s0, s1, s2;
+
+  ASSERT_EQ(ut30g_add(ctx_, UT30G_PKT_LEN, 0, 0, &s0), 0);
+  ASSERT_EQ(ut30g_add(ctx_, UT30G_PKT_LEN, 0, 0, &s1), 0);
+  ASSERT_EQ(ut30g_add(ctx_, UT30G_PKT_LEN * 2, 0, 0, &s2), 0);
+
+  int g0 = ut30g_session_group(ctx_, s0);
+  ASSERT_GE(g0, 0);
+  EXPECT_EQ(ut30g_session_group(ctx_, s1), g0);
+  EXPECT_EQ(ut30g_group_members(ctx_, g0), 2);
+  int g2 = ut30g_session_group(ctx_, s2);
+  ASSERT_GE(g2, 0);
+  EXPECT_NE(g2, g0);
+  EXPECT_EQ(ut30g_group_members(ctx_, g2), 1);
+}
+
+/* All the group slots taken by other profiles, the next profile builds alone. */
+TEST_F(St30TxGroupTest, FullTable) {
+  int sidx;
+
+  for (int i = 0; i < ut30g_groups_max(); i++)
+    ASSERT_EQ(ut30g_add(ctx_, UT30G_PKT_LEN + 4 * i, 0, 0, &sidx), 0) << "group " << i;
+
+  EXPECT_EQ(ut30g_add(ctx_, UT30G_PKT_LEN + 4 * ut30g_groups_max(), 0, 0, &sidx),
+            -ENOSPC);
+  EXPECT_EQ(ut30g_session_group(ctx_, sidx), -1);
+  /* a known profile still joins */
+  EXPECT_EQ(ut30g_add(ctx_, UT30G_PKT_LEN, 0, 0, &sidx), 0);
+  EXPECT_EQ(ut30g_group_members(ctx_, ut30g_session_group(ctx_, sidx)), 2);
+}
+
+/* The last member leaving frees the group and its slot is reused. */
+TEST_F(St30TxGroupTest, LeaveLastMember) {
+  int s0, s1, s2;
+
+  ASSERT_EQ(ut30g_add(ctx_, UT30G_PKT_LEN, 0, 0, &s0), 0);
+  ASSERT_EQ(ut30g_add(ctx_, UT30G_PKT_LEN, 0, 0, &s1), 0);
+  int gidx = ut30g_session_group(ctx_, s0);
+  ASSERT_GE(gidx, 0);
+
+  ut30g_leave(ctx_, s0);
+  EXPECT_EQ(ut30g_session_group(ctx_, s0), -1);
+  EXPECT_EQ(ut30g_group_members(ctx_, gidx), 1);
+  ut30g_leave(ctx_, s1);
+  EXPECT_EQ(ut30g_group_members(ctx_, gidx), -1) << "the slot is free";
+
+  ASSERT_EQ(ut30g_add(ctx_, UT30G_PKT_LEN * 2, 0, 0, &s2), 0);
+  EXPECT_EQ(ut30g_session_group(ctx_, s2), gidx);
+  EXPECT_EQ(ut30g_group_members(ctx_, gidx), 1);
+}
+
+/* One epoch of the group, each member pkt has its own rtp timestamp and seq. */
+TEST_F(St30TxGroupTest, MemberRtpInBurst) {
+  int s0, s1;
+
+  ASSERT_EQ(ut30g_add(ctx_, UT30G_PKT_LEN, 0, 100, &s0), 0);
+  ASSERT_EQ(ut30g_add(ctx_, UT30G_PKT_LEN, 1000, 0xffff, &s1), 0);
+  int gidx = ut30g_session_group(ctx_, s0);
+  ASSERT_GE(gidx, 0);
+
+  ASSERT_EQ(ut30g_build(ctx_, gidx), 2);
+  uint32_t ts = ut30g_group_rtp_ts(ctx_, gidx);
+  EXPECT_EQ(ut30g_pkt_rtp_ts(ctx_, gidx, 0), ts);
+  EXPECT_EQ(ut30g_pkt_seq(ctx_, gidx, 0), 100u);
+  /* 1 ms at 48 kHz */
+  EXPECT_EQ(ut30g_pkt_rtp_ts(ctx_, gidx, 1), ts + 48);
+  EXPECT_EQ(ut30g_pkt_seq(ctx_, gidx, 1), 0xffffu);
+}
@@ -0,0 +1,111 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * TX stream ring: the samples written in any count are sliced into the packets of the
+ * session epochs, the packet the app is behind on is silence.
+ *
+ * Build: meson setup build_unit -Denable_unit_tests=true && ninja -C build_unit
+ * Run:   ./build_unit/tests/unit/UnitTest --gtest_filter='St30TxStreamTest.*'
+ */
+
+#include <gtest/gtest.h>
+
+#include "session/st30_tx_stream_harness.h"
+
+namespace {
+constexpr uint32_t kFrameSamples = UT30S_FRAME_PKTS * UT30S_SAMPLES_PER_PKT;
+constexpr uint32_t kRingSamples = UT30S_RING_PKTS * UT30S_SAMPLES_PER_PKT;
+}  // namespace
+
+class St30TxStreamTest : public ::testing::Test {
+ protected:
+  ut30s_test_ctx* ctx_ = nullptr;
+
+  void SetUp() override {
+    ASSERT_EQ(ut30s_init(), 0) << "EAL init failed";
+    ctx_ = ut30s_ctx_create();
+    ASSERT_NE(ctx_, nullptr);
+  }
+
+  void TearDown() override {
+    ut30s_ctx_destroy(ctx_);
+    ctx_ = nullptr;
+  }
+
+  /* the last packet carries the written samples from n on */
+  void expect_pkt(uint32_t n) {
+    for (uint32_t t = 0; t < UT30S_SAMPLES_PER_PKT; t++) {
+      for (uint16_t c = 0; c < UT30S_CHANNELS; c++) {
+        ASSERT_EQ(ut30s_pkt_sample(ctx_, t, c), ut30s_wire_sample(c, n + t))
+            << "sample " << n + t << " ch " << c;
+      }
+    }
+  }
+
+  void expect_silence() {
+    for (uint32_t t = 0; t < UT30S_SAMPLES_PER_PKT; t++) {
+      for (uint16_t c = 0; c < UT30S_CHANNELS; c++)
+        ASSERT_EQ(ut30s_pkt_sample(ctx_, t, c), 0) << "row " << t << " ch " << c;
+    }
+  }
+};
+
+/* Nothing is sent before one frame of samples is in the ring. */
+TEST_F(St30TxStreamTest, WaitsForPrefill) {
+  EXPECT_EQ(ut30s_send_pkt(ctx_), -EBUSY);
+  EXPECT_EQ(ut30s_write(ctx_, kFrameSamples - 1), kFrameSamples - 1);
+  EXPECT_EQ(ut30s_send_pkt(ctx_), -EBUSY);
+  EXPECT_EQ(ut30s_write(ctx_, 1), 1u);
+  ASSERT_EQ(ut30s_send_pkt(ctx_), 0);
+  expect_pkt(0);
+  EXPECT_EQ(ut30s_stat_pkts_underrun(ctx_), 0u);
+}
+
+/* The periods of any size come out as the packets in order, over the ring wrap. */
+TEST_F(St30TxStreamTest, ArbitraryWritesSliceIntoPackets) {
+  const uint32_t periods[] = {64, 256, 480};
+  uint32_t p = 0, pending = 0, sent = 0;
+  uint32_t rtp_ts = 0;
+
+  /* the app keeps the ring ahead of the packets as a sound card would */
+  while (sent < UT30S_RING_PKTS * 4) {
+    if (!pending) pending = periods[p++ % 3];
+    pending -= ut30s_write(ctx_, pending);
+    if (ut30s_send_pkt(ctx_) < 0) continue;
+
+    expect_pkt(sent * UT30S_SAMPLES_PER_PKT);
+    if (sent) EXPECT_EQ(ut30s_pkt_rtp_ts(ctx_), rtp_ts + UT30S_SAMPLES_PER_PKT);
+    rtp_ts = ut30s_pkt_rtp_ts(ctx_);
+    sent++;
+  }
+  EXPECT_EQ(ut30s_stat_pkts_sent(ctx_), sent);
+  EXPECT_EQ(ut30s_stat_pkts_underrun(ctx_), 0u);
+  EXPECT_EQ(ut30s_session_frames(ctx_), sent / UT30S_FRAME_PKTS);
+}
+
+/* A packet not written in full is silence, its samples come in the next packet. */
+TEST_F(St30TxStreamTest, UnderrunSendsSilence) {
+  ut30s_write(ctx_, kFrameSamples);
+  for (uint32_t k = 0; k < UT30S_FRAME_PKTS; k++) ASSERT_EQ(ut30s_send_pkt(ctx_), 0);
+
+  ut30s_write(ctx_, 20);
+  ASSERT_EQ(ut30s_send_pkt(ctx_), 0);
+  expect_silence();
+  EXPECT_EQ(ut30s_stat_pkts_underrun(ctx_), 1u);
+
+  ut30s_write(ctx_, UT30S_SAMPLES_PER_PKT - 20);
+  ASSERT_EQ(ut30s_send_pkt(ctx_), 0);
+  expect_pkt(kFrameSamples);
+  EXPECT_EQ(ut30s_stat_pkts_sent(ctx_), (uint64_t)UT30S_FRAME_PKTS + 1);
+}
+
+/* The write stops at the full ring, the space of each sent packet is free again. */
+TEST_F(St30TxStreamTest, FullRingShortWrite) {
+  EXPECT_EQ(ut30s_write(ctx_, kRingSamples + 100), kRingSamples);
+  EXPECT_EQ(ut30s_stat_samples_full(ctx_), 100u);
+  EXPECT_EQ(ut30s_write(ctx_, 1), 0u);
+
+  ASSERT_EQ(ut30s_send_pkt(ctx_), 0);
+  expect_pkt(0);
+  EXPECT_EQ(ut30s_write(ctx_, 100), (uint32_t)UT30S_SAMPLES_PER_PKT);
+}
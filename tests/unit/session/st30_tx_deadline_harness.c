@@ -0,0 +1,70 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness for the deadline of the tx sessions tasklet unit tests.
+ */
+
+#include <stdlib.h>
+
+#include "common/ut_common.h"
+#include "st2110/st_tx_deadline.h"
+
+#include "session/st30_tx_deadline_harness.h"
+
+struct ut30d_ctx {
+  struct st_tx_deadline d;
+};
+
+int ut30d_init(void) {
+  return ut_eal_init();
+}
+
+ut30d_ctx* ut30d_create(void) {
+  ut30d_ctx* ctx = calloc(1, sizeof(*ctx));
+
+  if (!ctx) return NULL;
+  if (st_tx_deadline_init(&ctx->d, UT30D_CAP, rte_socket_id()) < 0) {
+    free(ctx);
+    return NULL;
+  }
+  return ctx;
+}
+
+void ut30d_destroy(ut30d_ctx* ctx) {
+  if (!ctx) return;
+  st_tx_deadline_uinit(&ctx->d);
+  free(ctx);
+}
+
+void ut30d_kick(ut30d_ctx* ctx) {
+  st_tx_deadline_kick(&ctx->d);
+}
+
+void ut30d_expire(ut30d_ctx* ctx, uint16_t max_idx, uint64_t tsc) {
+  st_tx_deadline_expire(&ctx->d, max_idx, tsc);
+}
+
+void ut30d_park(ut30d_ctx* ctx, uint16_t idx, uint64_t due) {
+  st_tx_deadline_park(&ctx->d, idx, due);
+}
+
+void ut30d_drop(ut30d_ctx* ctx, uint16_t idx) {
+  st_tx_deadline_drop(&ctx->d, idx);
+}
+
+int ut30d_ready(ut30d_ctx* ctx, uint16_t* idx, int max) {
+  int cnt = 0;
+
+  for (int i = st_tx_deadline_next_ready(&ctx->d, 0); i >= 0 && cnt < max;
+       i = st_tx_deadline_next_ready(&ctx->d, i + 1))
+    idx[cnt++] = i;
+  return cnt;
+}
+
+uint64_t ut30d_first(ut30d_ctx* ctx) {
+  return st_tx_deadline_first(&ctx->d);
+}
+
+int ut30d_parked(ut30d_ctx* ctx) {
+  return ctx->d.num;
+}
@@ -0,0 +1,44 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness API for the deadline of the tx audio and anc sessions tasklet.
+ *
+ * The harness drives the production st_tx_deadline of UT30D_CAP sessions the way the
+ * tasklet does: expire at the loop start, then park or drop the visited sessions.
+ */
+
+#ifndef _ST30_TX_DEADLINE_HARNESS_H_
+#define _ST30_TX_DEADLINE_HARNESS_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UT30D_CAP 512
+
+typedef struct ut30d_ctx ut30d_ctx;
+
+int ut30d_init(void);
+
+/* NULL on fail, free with ut30d_destroy() */
+ut30d_ctx* ut30d_create(void);
+void ut30d_destroy(ut30d_ctx* ctx);
+
+void ut30d_kick(ut30d_ctx* ctx);
+void ut30d_expire(ut30d_ctx* ctx, uint16_t max_idx, uint64_t tsc);
+void ut30d_park(ut30d_ctx* ctx, uint16_t idx, uint64_t due);
+void ut30d_drop(ut30d_ctx* ctx, uint16_t idx);
+
+/* the ready sessions in the loop order, up to max of them, the count */
+int ut30d_ready(ut30d_ctx* ctx, uint16_t* idx, int max);
+/* the tsc of the first parked session, UINT64_MAX if none */
+uint64_t ut30d_first(ut30d_ctx* ctx);
+int ut30d_parked(ut30d_ctx* ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ST30_TX_DEADLINE_HARNESS_H_ */
@@ -0,0 +1,168 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness for the ST30 (audio) TX batch build group unit tests.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#undef MTL_HAS_USDT
+#include "common/ut_common.h"
+#include "st2110/st_tx_audio_session.c"
+
+#define UT30G_FRAME_PKTS 4
+
+struct ut30g_test_ctx {
+  struct mtl_main_impl impl;
+  struct st_tx_audio_sessions_mgr mgr;
+  struct st_tx_audio_session_impl sessions[UT30G_SESSIONS];
+  int sessions_cnt;
+};
+
+#include "session/st30_tx_group_harness.h"
+
+static uint64_t ut30g_ptp_time(struct mtl_main_impl* impl, enum mtl_port port) {
+  (void)port;
+  impl->ptp_usync += 1000;
+  return impl->ptp_usync;
+}
+
+static int ut30g_get_next_frame(void* priv, uint16_t* next_frame_idx,
+                                struct st30_tx_frame_meta* meta) {
+  (void)priv;
+  (void)meta;
+  *next_frame_idx = 0;
+  return 0;
+}
+
+int ut30g_init(void) {
+  return ut_eal_init();
+}
+
+ut30g_test_ctx* ut30g_ctx_create(void) {
+  ut30g_test_ctx* ctx = calloc(1, sizeof(*ctx));
+
+  if (!ctx) return NULL;
+
+  ctx->impl.type = MT_HANDLE_MAIN;
+  ctx->impl.tsc_hz = rte_get_tsc_hz();
+  for (int i = 0; i < MTL_PORT_MAX; i++) {
+    ctx->impl.inf[i].parent = &ctx->impl;
+    ctx->impl.inf[i].port = i;
+    ctx->impl.inf[i].socket_id = rte_socket_id();
+    ctx->impl.inf[i].ptp_get_time_fn = ut30g_ptp_time;
+    ctx->impl.inf[i].tx_mbuf_pool = ut_pool();
+  }
+  ctx->mgr.parent = &ctx->impl;
+  ctx->mgr.socket_id = rte_socket_id();
+  for (int i = 0; i < ST_SCH_MAX_TX_AUDIO_SESSIONS; i++)
+    rte_spinlock_init(&ctx->mgr.mutex[i]);
+  for (int i = 0; i < ST_TX_AUDIO_GROUPS_MAX; i++)
+    rte_spinlock_init(&ctx->mgr.group_mutex[i]);
+  return ctx;
+}
+
+void ut30g_ctx_destroy(ut30g_test_ctx* ctx) {
+  if (!ctx) return;
+  for (int i = 0; i < ctx->sessions_cnt; i++) {
+    struct st_tx_audio_session_impl* s = &ctx->sessions[i];
+    tx_audio_group_leave(&ctx->mgr, s);
+    tx_audio_session_free_frames(s);
+  }
+  free(ctx);
+}
+
+int ut30g_groups_max(void) {
+  return ST_TX_AUDIO_GROUPS_MAX;
+}
+
+int ut30g_add(ut30g_test_ctx* ctx, uint32_t pkt_len, int32_t rtp_delta_us,
+              uint16_t seq, int* sidx) {
+  struct st_tx_audio_session_impl* s;
+  int idx = ctx->sessions_cnt;
+  int ret;
+
+  if (idx >= UT30G_SESSIONS) return -ENOSPC;
+  s = &ctx->sessions[idx];
+  s->idx = idx;
+  s->socket_id = rte_socket_id();
+  s->mgr = &ctx->mgr;
+  s->usdt_dump_fd = -1;
+  s->ops.type = ST30_TYPE_FRAME_LEVEL;
+  s->ops.num_port = 1;
+  s->ops.channel = 2;
+  s->ops.sampling = ST30_SAMPLING_48K;
+  s->ops.fmt = ST30_FMT_PCM16;
+  s->ops.ptime = ST30_PTIME_1MS;
+  s->ops.flags = ST30_TX_FLAG_GROUP_BUILD;
+  s->ops.rtp_timestamp_delta_us = rtp_delta_us;
+  s->ops.get_next_frame = ut30g_get_next_frame;
+  s->ops.priv = ctx;
+
+  /* same as tx_audio_session_attach on the shared queue */
+  s->pkt_len = pkt_len;
+  s->st30_pkt_size = pkt_len + sizeof(struct st_rfc3550_audio_hdr);
+  s->st30_total_pkts = UT30G_FRAME_PKTS;
+  s->st30_frame_size = UT30G_FRAME_PKTS * pkt_len;
+  s->st30_frames_cnt = 1;
+  s->st30_frame_stat = ST30_TX_STAT_WAIT_FRAME;
+  s->st30_seq_id = seq;
+  s->shared_queue = true;
+  s->tx_mono_pool = true;
+  s->tx_pacing_way = ST30_TX_PACING_WAY_TSC;
+  s->pacing.trs = NS_PER_MS;
+  s->pacing.pkt_time_sampling = 48;
+  s->pacing.max_onward_epochs = 2;
+  s->pacing.max_late_epochs = 2;
+  ret = tx_audio_session_alloc_frames(s);
+  if (ret < 0) return ret;
+  s->active = true;
+  ctx->sessions_cnt++;
+  ctx->mgr.sessions[idx] = s;
+  ctx->mgr.max_idx = ctx->sessions_cnt;
+  if (sidx) *sidx = idx;
+
+  return tx_audio_group_join(&ctx->impl, &ctx->mgr, s);
+}
+
+void ut30g_leave(ut30g_test_ctx* ctx, int sidx) {
+  tx_audio_group_leave(&ctx->mgr, &ctx->sessions[sidx]);
+}
+
+int ut30g_session_group(const ut30g_test_ctx* ctx, int sidx) {
+  const struct st_tx_audio_group* g = ctx->sessions[sidx].group;
+  return g ? g->idx : -1;
+}
+
+int ut30g_group_members(const ut30g_test_ctx* ctx, int gidx) {
+  const struct st_tx_audio_group* g = ctx->mgr.groups[gidx];
+  return g ? g->members : -1;
+}
+
+int ut30g_build(ut30g_test_ctx* ctx, int gidx) {
+  struct st_tx_audio_group* g = ctx->mgr.groups[gidx];
+
+  if (!g) return -EINVAL;
+  tx_audio_group_build(&ctx->impl, &ctx->mgr, g);
+  return g->pkts_cnt;
+}
+
+uint32_t ut30g_group_rtp_ts(const ut30g_test_ctx* ctx, int gidx) {
+  return ctx->mgr.groups[gidx]->pacing.rtp_time_stamp;
+}
+
+static struct st_rfc3550_rtp_hdr* ut30g_pkt_rtp(const ut30g_test_ctx* ctx, int gidx,
+                                                int i) {
+  struct rte_mbuf* pkt = ctx->mgr.groups[gidx]->pkts[MTL_SESSION_PORT_P][i];
+  return rte_pktmbuf_mtod_offset(pkt, struct st_rfc3550_rtp_hdr*,
+                                 sizeof(struct mt_udp_hdr));
+}
+
+uint32_t ut30g_pkt_rtp_ts(const ut30g_test_ctx* ctx, int gidx, int i) {
+  return ntohl(ut30g_pkt_rtp(ctx, gidx, i)->tmstamp);
+}
+
+uint16_t ut30g_pkt_seq(const ut30g_test_ctx* ctx, int gidx, int i) {
+  return ntohs(ut30g_pkt_rtp(ctx, gidx, i)->seq_number);
+}
@@ -0,0 +1,59 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness API for the ST 2110-30 (audio) TX batch build group unit tests.
+ *
+ * The harness holds up to UT30G_SESSIONS frame level tx sessions of 2-channel 48 kHz
+ * 1 ms packets on one sessions mgr, tsc pacing on the shared queue. Each session joins
+ * the groups as tx_audio_session_attach does with ST30_TX_FLAG_GROUP_BUILD, the pkt
+ * len picks the profile. The group pkts are from the mono pool of the harness.
+ */
+
+#ifndef _ST30_TX_GROUP_HARNESS_H_
+#define _ST30_TX_GROUP_HARNESS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mtl_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UT30G_SESSIONS 16
+#define UT30G_PKT_LEN 192 /* 48 samples of 2-channel PCM16 */
+
+typedef struct ut30g_test_ctx ut30g_test_ctx;
+
+int ut30g_init(void);
+
+/* NULL on fail, free with ut30g_ctx_destroy() */
+ut30g_test_ctx* ut30g_ctx_create(void);
+void ut30g_ctx_destroy(ut30g_test_ctx* ctx);
+
+int ut30g_groups_max(void);
+
+/* add the next session and join a group, the join return code, the session index out */
+int ut30g_add(ut30g_test_ctx* ctx, uint32_t pkt_len, int32_t rtp_delta_us,
+              uint16_t seq, int* sidx);
+/* the session leaves its group, as tx_audio_session_detach */
+void ut30g_leave(ut30g_test_ctx* ctx, int sidx);
+
+/* the group index of the session, -1 if not in a group */
+int ut30g_session_group(const ut30g_test_ctx* ctx, int sidx);
+/* the members of the group at gidx of the mgr, -1 if the slot is free */
+int ut30g_group_members(const ut30g_test_ctx* ctx, int gidx);
+
+/* build the next epoch of the group at gidx, the pkts built for the members */
+int ut30g_build(ut30g_test_ctx* ctx, int gidx);
+uint32_t ut30g_group_rtp_ts(const ut30g_test_ctx* ctx, int gidx);
+/* the rtp hdr of the built pkt i of the group, in the session order */
+uint32_t ut30g_pkt_rtp_ts(const ut30g_test_ctx* ctx, int gidx, int i);
+uint16_t ut30g_pkt_seq(const ut30g_test_ctx* ctx, int gidx, int i);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ST30_TX_GROUP_HARNESS_H_ */
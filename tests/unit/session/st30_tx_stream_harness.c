@@ -0,0 +1,162 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness for the ST30 (audio) TX stream ring unit tests.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#undef MTL_HAS_USDT
+#include "common/ut_common.h"
+#include "st2110/st_tx_audio_session.c"
+
+#define UT30S_PKT_PAYLOAD (UT30S_SAMPLES_PER_PKT * UT30S_CHANNELS * 2)
+#define UT30S_RTP_TS0 (0xfffffc00u) /* wraps in the test */
+
+struct ut30s_test_ctx {
+  struct mtl_main_impl impl;
+  struct st_tx_audio_sessions_mgr mgr;
+  struct st_tx_audio_session_impl session;
+  struct st_tx_audio_stream_impl* stream;
+
+  uint32_t written; /* the samples written since create */
+  uint8_t app_buf[UT30S_RING_PKTS * UT30S_PKT_PAYLOAD * 2];
+  uint8_t payload[UT30S_PKT_PAYLOAD];
+  uint32_t rtp_ts;
+};
+
+#include "session/st30_tx_stream_harness.h"
+
+int ut30s_init(void) {
+  return ut_eal_init();
+}
+
+ut30s_test_ctx* ut30s_ctx_create(void) {
+  ut30s_test_ctx* ctx = calloc(1, sizeof(*ctx));
+  struct st_tx_audio_session_impl* s;
+
+  if (!ctx) return NULL;
+
+  ctx->impl.type = MT_HANDLE_MAIN;
+  ctx->impl.tsc_hz = rte_get_tsc_hz();
+  ctx->mgr.parent = &ctx->impl;
+
+  ctx->stream = st_tx_audio_stream_create(
+      0, ST30_FMT_PCM16, UT30S_CHANNELS, ST30_SAMPLING_48K, ST30_PTIME_1MS,
+      UT30S_RING_PKTS * UT30S_PKT_PAYLOAD, UT30S_FRAME_PKTS * UT30S_PKT_PAYLOAD,
+      rte_socket_id());
+  if (!ctx->stream) {
+    free(ctx);
+    return NULL;
+  }
+
+  s = &ctx->session;
+  s->idx = 0;
+  s->socket_id = rte_socket_id();
+  s->mgr = &ctx->mgr;
+  s->stream = ctx->stream;
+  s->usdt_dump_fd = -1;
+  s->ops.type = ST30_TYPE_FRAME_LEVEL;
+  s->ops.num_port = 1;
+  s->ops.channel = UT30S_CHANNELS;
+  s->ops.sampling = ST30_SAMPLING_48K;
+  s->ops.fmt = ST30_FMT_PCM16;
+  s->ops.ptime = ST30_PTIME_1MS;
+
+  /* same as tx_audio_session_attach with a stream */
+  s->pkt_len = UT30S_PKT_PAYLOAD;
+  s->st30_pkt_size = UT30S_PKT_PAYLOAD + sizeof(struct st_rfc3550_audio_hdr);
+  s->st30_total_pkts = UT30S_FRAME_PKTS;
+  s->st30_frame_size = UT30S_FRAME_PKTS * UT30S_PKT_PAYLOAD;
+  s->st30_frames_cnt = 1;
+  s->st30_frame_stat = ST30_TX_STAT_WAIT_FRAME;
+  s->pacing.rtp_time_stamp = UT30S_RTP_TS0;
+  if (tx_audio_session_alloc_frames(s) < 0) {
+    ut30s_ctx_destroy(ctx);
+    return NULL;
+  }
+  return ctx;
+}
+
+void ut30s_ctx_destroy(ut30s_test_ctx* ctx) {
+  if (!ctx) return;
+  tx_audio_session_free_frames(&ctx->session);
+  if (ctx->stream) st_tx_audio_stream_free(ctx->stream);
+  free(ctx);
+}
+
+uint16_t ut30s_wire_sample(uint16_t channel, uint32_t n) {
+  return (uint16_t)((channel << 12) | (n & 0xfff));
+}
+
+uint32_t ut30s_write(ut30s_test_ctx* ctx, uint32_t samples) {
+  uint32_t written;
+
+  if ((size_t)samples * UT30S_CHANNELS * 2 > sizeof(ctx->app_buf)) return 0;
+  for (uint32_t t = 0; t < samples; t++) {
+    for (uint16_t c = 0; c < UT30S_CHANNELS; c++) {
+      uint16_t v = ut30s_wire_sample(c, ctx->written + t);
+      ctx->app_buf[(t * UT30S_CHANNELS + c) * 2] = v >> 8;
+      ctx->app_buf[(t * UT30S_CHANNELS + c) * 2 + 1] = v & 0xff;
+    }
+  }
+  written = st_tx_audio_stream_write(ctx->stream, ctx->app_buf, samples);
+  ctx->written += written;
+  return written;
+}
+
+int ut30s_send_pkt(ut30s_test_ctx* ctx) {
+  struct st_tx_audio_session_impl* s = &ctx->session;
+  struct rte_mbuf* pkt;
+  struct st_rfc3550_rtp_hdr* rtp;
+  int ret;
+
+  /* same as tx_audio_session_tasklet_frame, one epoch for each pkt */
+  if (0 == s->st30_pkt_idx && ST30_TX_STAT_WAIT_FRAME == s->st30_frame_stat) {
+    struct st30_tx_frame_meta meta;
+
+    tx_audio_session_init_next_meta(s, &meta);
+    ret = tx_audio_session_next_frame(&ctx->impl, s, &meta);
+    if (ret < 0) return ret;
+  }
+
+  pkt = rte_pktmbuf_alloc(ut_pool());
+  if (!pkt) return -ENOMEM;
+  tx_audio_session_build_packet(s, pkt);
+  rtp = rte_pktmbuf_mtod_offset(pkt, struct st_rfc3550_rtp_hdr*,
+                                sizeof(struct mt_udp_hdr));
+  ctx->rtp_ts = ntohl(rtp->tmstamp);
+  memcpy(ctx->payload, &rtp[1], UT30S_PKT_PAYLOAD);
+  rte_pktmbuf_free(pkt);
+
+  s->st30_pkt_idx++;
+  s->pacing.rtp_time_stamp += UT30S_SAMPLES_PER_PKT;
+  if (s->st30_pkt_idx >= s->st30_total_pkts) tx_audio_session_frame_done(&ctx->impl, s);
+  return 0;
+}
+
+uint16_t ut30s_pkt_sample(const ut30s_test_ctx* ctx, uint32_t row, uint16_t channel) {
+  const uint8_t* p = ctx->payload + ((size_t)row * UT30S_CHANNELS + channel) * 2;
+  return (uint16_t)(p[0] << 8 | p[1]);
+}
+
+uint32_t ut30s_pkt_rtp_ts(const ut30s_test_ctx* ctx) {
+  return ctx->rtp_ts;
+}
+
+uint64_t ut30s_stat_pkts_sent(const ut30s_test_ctx* ctx) {
+  return ctx->stream->stat_pkts_sent;
+}
+
+uint64_t ut30s_stat_pkts_underrun(const ut30s_test_ctx* ctx) {
+  return ctx->stream->stat_pkts_underrun;
+}
+
+uint64_t ut30s_stat_samples_full(const ut30s_test_ctx* ctx) {
+  return ctx->stream->stat_samples_full;
+}
+
+uint64_t ut30s_session_frames(const ut30s_test_ctx* ctx) {
+  return ctx->session.port_user_stats.common.port[MTL_SESSION_PORT_P].frames;
+}
@@ -0,0 +1,59 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ *
+ * C harness API for the ST 2110-30 (audio) TX stream ring unit tests.
+ *
+ * The harness creates one tx session of PCM16 2-channel 48 kHz 1 ms packets, frames of
+ * UT30S_FRAME_PKTS packets, slicing its packets from a sample ring of UT30S_RING_PKTS
+ * packets. The first packet waits one frame of samples in the ring.
+ *
+ * The 16 bit sample n of channel c written by ut30s_write() is (c << 12) | (n & 0xfff),
+ * n counts from 0 over all the writes, see ut30s_wire_sample().
+ */
+
+#ifndef _ST30_TX_STREAM_HARNESS_H_
+#define _ST30_TX_STREAM_HARNESS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mtl_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UT30S_CHANNELS 2
+#define UT30S_SAMPLES_PER_PKT 48
+#define UT30S_FRAME_PKTS 4
+#define UT30S_RING_PKTS 12
+
+typedef struct ut30s_test_ctx ut30s_test_ctx;
+
+int ut30s_init(void);
+
+/* NULL on fail, free with ut30s_ctx_destroy() */
+ut30s_test_ctx* ut30s_ctx_create(void);
+void ut30s_ctx_destroy(ut30s_test_ctx* ctx);
+
+uint16_t ut30s_wire_sample(uint16_t channel, uint32_t n);
+
+/* write the next samples to the ring as the app, the samples written */
+uint32_t ut30s_write(ut30s_test_ctx* ctx, uint32_t samples);
+
+/* build the packet of the next epoch as the tasklet, -EBUSY if the session waits */
+int ut30s_send_pkt(ut30s_test_ctx* ctx);
+/* the 16 bit sample at the row and the channel of the last packet */
+uint16_t ut30s_pkt_sample(const ut30s_test_ctx* ctx, uint32_t row, uint16_t channel);
+uint32_t ut30s_pkt_rtp_ts(const ut30s_test_ctx* ctx);
+
+uint64_t ut30s_stat_pkts_sent(const ut30s_test_ctx* ctx);
+uint64_t ut30s_stat_pkts_underrun(const ut30s_test_ctx* ctx);
+uint64_t ut30s_stat_samples_full(const ut30s_test_ctx* ctx);
+uint64_t ut30s_session_frames(const ut30s_test_ctx* ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ST30_TX_STREAM_HARNESS_H_ */
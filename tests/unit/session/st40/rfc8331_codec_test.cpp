@@ -144,6 +144,50 @@ TEST_F(St40Rfc8331CodecTest, DecodeParityFail) {
       ST40_RFC8331_DECODE_PARITY_FAIL);
 }
 
+/* A parity bit flipped deep in the UDW, on the bulk path of the words. */
+TEST_F(St40Rfc8331CodecTest, DecodeParityFailBulkUdw) {
+  auto in = make_meta(0x61, 0x02, 0x1AB, 1, 1, 7, 255);
+  auto udw = make_udw(255, 6);
+  std::vector<uint8_t> buf(kBufRoom, 0);
+  uint32_t written = 0;
+  ASSERT_EQ(st40_rfc8331_encode_packet(buf.data(), kBufRoom, &in, udw.data(), &written),
+            0);
+  /* UDW 200 is word 203 of the body, flip its b8 */
+  uint8_t* body = buf.data() + 4;
+  st40_set_udw(203, st40_get_udw(203, body) ^ 0x100, body);
+  struct st40_meta out {};
+  std::vector<uint8_t> udw_out(255, 0);
+  uint32_t consumed = 0;
+  EXPECT_EQ(st40_rfc8331_decode_packet(buf.data(), written, &out, udw_out.data(), 255,
+                                       &consumed),
+            ST40_RFC8331_DECODE_PARITY_FAIL);
+}
+
+/* The bulk udw set/get match the one word helpers at each start index. */
+TEST_F(St40Rfc8331CodecTest, BulkUdwMatchesPerWord) {
+  auto udw = make_udw(255, 7);
+  for (uint32_t idx = 0; idx < 8; idx++) {
+    std::vector<uint8_t> ref(kBufRoom, 0x5A), buf(kBufRoom, 0x5A);
+    uint16_t ref_sum = 0;
+    for (uint32_t i = 0; i < udw.size(); i++) {
+      uint16_t word = st40_add_parity_bits(udw[i]);
+      st40_set_udw(idx + i, word, ref.data());
+      ref_sum += word;
+    }
+    EXPECT_EQ(st40_set_udws(idx, udw.data(), udw.size(), buf.data()), ref_sum)
+        << "idx " << idx;
+    EXPECT_EQ(buf, ref) << "idx " << idx;
+
+    std::vector<uint8_t> out(udw.size(), 0);
+    uint16_t sum = 0;
+    EXPECT_EQ(st40_get_udws(idx, buf.data(), udw.size(), out.data(), &sum), 0u);
+    EXPECT_EQ(sum, ref_sum);
+    EXPECT_EQ(out, udw);
+    if (!idx)
+      EXPECT_EQ(st40_checksum_from_sum(sum), st40_calc_checksum(udw.size(), buf.data()));
+  }
+}
+
 TEST_F(St40Rfc8331CodecTest, DecodeChecksumFail) {
   auto in = make_meta(0x61, 0x02, 0x1AB, 1, 1, 7, 4);
   auto udw = make_udw(4, 5);
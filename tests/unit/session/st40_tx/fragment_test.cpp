@@ -0,0 +1,103 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "session/st40_tx_harness.h"
+#include "st40_api.h"
+
+namespace {
+constexpr uint64_t kFramePeriodNs = 1000 * 1000;
+constexpr uint64_t kCurrentTai = 10 * kFramePeriodNs;
+constexpr uint64_t kCurrentTsc = kFramePeriodNs / 2;
+constexpr uint32_t kMaxPktLen = 1200;
+constexpr int kMaxSteps = 64;
+}  // namespace
+
+class St40TxFragmentTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_EQ(ut_txa_init(), 0);
+    ctx_ = ut_txa_create();
+    ASSERT_NE(ctx_, nullptr);
+    ut_txa_set_mock_ptp_time(ctx_, kCurrentTai);
+    ut_txa_set_mock_tsc_time(ctx_, kCurrentTsc);
+  }
+
+  void TearDown() override {
+    ut_txa_destroy(ctx_);
+  }
+
+  /* step the tasklet at the time of each packet until the frame is done */
+  void RunFrame() {
+    for (int i = 0; i < kMaxSteps; i++) {
+      ut_txa_step_frame_tasklet(ctx_);
+      if (ut_txa_notify_frame_done_calls(ctx_)) return;
+      uint64_t cursor = ut_txa_tsc_time_cursor(ctx_);
+      if (cursor) ut_txa_set_mock_tsc_time(ctx_, cursor);
+    }
+  }
+
+  /* the greedy fill of the tx: a new packet when the next anc does not fit */
+  static unsigned int ExpectedPkts(uint32_t meta_num, uint16_t udw_size) {
+    uint32_t bytes = st40_rfc8331_payload_bytes(udw_size);
+    uint32_t per_pkt = kMaxPktLen / bytes;
+    return (meta_num + per_pkt - 1) / per_pkt;
+  }
+
+  void ExpectPackets(uint32_t meta_num, uint16_t udw_size) {
+    unsigned int pkts = ExpectedPkts(meta_num, udw_size);
+    ASSERT_EQ(ut_txa_queued_packets(ctx_), pkts);
+
+    uint32_t anc_total = 0;
+    for (unsigned int i = 0; i < pkts; i++) {
+      uint16_t anc_count = 0;
+      bool marker = false;
+      ASSERT_EQ(ut_txa_pop_packet_anc(ctx_, &anc_count, &marker), 0);
+      EXPECT_GT(anc_count, 0u);
+      EXPECT_EQ(marker, i == pkts - 1) << "pkt " << i;
+      anc_total += anc_count;
+    }
+    EXPECT_EQ(anc_total, meta_num);
+  }
+
+  ut_txa_ctx* ctx_ = nullptr;
+};
+
+TEST_F(St40TxFragmentTest, FrameOverOnePacketIsFragmented) {
+  ASSERT_EQ(ut_txa_prepare_anc_frame_tasklet(ctx_, kCurrentTai, 16, 255), 0);
+  ASSERT_GT(ExpectedPkts(16, 255), 1u);
+
+  RunFrame();
+  EXPECT_EQ(ut_txa_notify_frame_done_calls(ctx_), 1);
+  ExpectPackets(16, 255);
+}
+
+TEST_F(St40TxFragmentTest, MetaOverFixedArray) {
+  uint32_t meta_num = ST40_MAX_META * 4;
+  ASSERT_EQ(ut_txa_prepare_anc_frame_tasklet(ctx_, kCurrentTai, meta_num, 32), 0);
+
+  RunFrame();
+  EXPECT_EQ(ut_txa_notify_frame_done_calls(ctx_), 1);
+  ExpectPackets(meta_num, 32);
+}
+
+TEST_F(St40TxFragmentTest, SmallFrameStaysOnePacket) {
+  ASSERT_EQ(ut_txa_prepare_anc_frame_tasklet(ctx_, kCurrentTai, 4, 16), 0);
+
+  RunFrame();
+  ExpectPackets(4, 16);
+}
+
+TEST_F(St40TxFragmentTest, AncOverPacketAbortsFrame) {
+  ASSERT_EQ(ut_txa_prepare_anc_frame_tasklet(ctx_, kCurrentTai, 2, 255), 0);
+  ut_txa_set_max_pkt_len(ctx_, st40_rfc8331_payload_bytes(255) - 4);
+
+  ut_txa_step_frame_tasklet(ctx_);
+  EXPECT_EQ(ut_txa_queued_packets(ctx_), 0u);
+  /* the buffer goes back to the app */
+  EXPECT_EQ(ut_txa_notify_frame_done_calls(ctx_), 1);
+}
@@ -15,6 +15,7 @@ struct ut_txa_ctx {
   struct st_tx_ancillary_session_impl session;
   struct st_frame_trans frame;
   struct st40_frame frame_data;
+  uint8_t* anc_data;
   uint64_t mock_ptp_ns;
   uint64_t mock_tsc_ns;
   enum st10_timestamp_fmt app_tfmt;
@@ -97,11 +98,17 @@ ut_txa_ctx* ut_txa_create(void) {
   ctx->session.ops.notify_frame_late = ut_txa_notify_frame_late;
   ctx->session.ops.priv = ctx;
   ctx->mgr.sessions[0] = &ctx->session;
+  if (st_tx_deadline_init(&ctx->mgr.deadline, ST_MAX_TX_ANC_SESSIONS, rte_socket_id()) <
+      0) {
+    free(ctx);
+    return NULL;
+  }
   return ctx;
 }
 
 void ut_txa_destroy(ut_txa_ctx* ctx) {
   ut_txa_cleanup_frame_tasklet(ctx);
+  st_tx_deadline_uinit(&ctx->mgr.deadline);
   free(ctx);
 }
 
@@ -183,9 +190,44 @@ int ut_txa_prepare_frame_tasklet(ut_txa_ctx* ctx, enum st10_timestamp_fmt tfmt,
   ctx->get_next_frame_calls = 0;
   ctx->notify_frame_done_calls = 0;
   memset(&ctx->notify_frame_done_meta, 0, sizeof(ctx->notify_frame_done_meta));
+  /* the session may be parked by the last frame */
+  st_tx_deadline_kick(&ctx->mgr.deadline);
+  return 0;
+}
+
+int ut_txa_prepare_anc_frame_tasklet(ut_txa_ctx* ctx, uint64_t timestamp,
+                                     uint32_t meta_num, uint16_t udw_size) {
+  struct st40_frame* frame = &ctx->frame_data;
+  int ret = ut_txa_prepare_frame_tasklet(ctx, ST10_TIMESTAMP_FMT_TAI, timestamp, 1);
+  if (ret < 0) return ret;
+
+  /* the meta over ST40_MAX_META the way the lib alloc it for max_meta */
+  if (meta_num > ST40_MAX_META) {
+    frame->meta_array = calloc(meta_num, sizeof(*frame->meta_array));
+    if (!frame->meta_array) return -ENOMEM;
+    frame->meta_cap = meta_num;
+  }
+  ctx->anc_data = calloc((size_t)meta_num * udw_size + 1, 1);
+  if (!ctx->anc_data) return -ENOMEM;
+
+  struct st40_meta* meta = st40_frame_meta(frame);
+  for (uint32_t i = 0; i < meta_num; i++) {
+    meta[i].did = 0x41;
+    meta[i].sdid = 0x07;
+    meta[i].udw_size = udw_size;
+    meta[i].udw_offset = i * udw_size;
+  }
+  frame->data = ctx->anc_data;
+  frame->data_size = meta_num * udw_size;
+  frame->meta_num = meta_num;
+  ctx->session.split_payload = false;
   return 0;
 }
 
+void ut_txa_set_max_pkt_len(ut_txa_ctx* ctx, uint32_t max_pkt_len) {
+  ctx->session.max_pkt_len = max_pkt_len;
+}
+
 int ut_txa_step_frame_tasklet(ut_txa_ctx* ctx) {
   return tx_ancillary_sessions_tasklet_handler(&ctx->mgr);
 }
@@ -206,6 +248,21 @@ int ut_txa_pop_packet_tsc(ut_txa_ctx* ctx, uint64_t* packet_tsc) {
   return 0;
 }
 
+int ut_txa_pop_packet_anc(ut_txa_ctx* ctx, uint16_t* anc_count, bool* marker) {
+  struct rte_mbuf* packet = NULL;
+
+  if (!ctx->mgr.ring[MTL_PORT_P] ||
+      rte_ring_sc_dequeue(ctx->mgr.ring[MTL_PORT_P], (void**)&packet) < 0)
+    return -ENOENT;
+  struct st40_rfc8331_rtp_hdr rtp = *rte_pktmbuf_mtod_offset(
+      packet, struct st40_rfc8331_rtp_hdr*, sizeof(struct mt_udp_hdr));
+  st40_rfc8331_rtp_hdr_bswap(&rtp);
+  *anc_count = rtp.first_hdr_chunk.anc_count;
+  *marker = rtp.base.marker;
+  rte_pktmbuf_free(packet);
+  return 0;
+}
+
 void ut_txa_cleanup_frame_tasklet(ut_txa_ctx* ctx) {
   struct st_tx_ancillary_session_impl* s;
 
@@ -221,6 +278,10 @@ void ut_txa_cleanup_frame_tasklet(ut_txa_ctx* ctx) {
     s->mbuf_mempool_hdr[MTL_SESSION_PORT_P] = NULL;
   }
   s->st40_frames = NULL;
+  free(ctx->frame_data.meta_array);
+  ctx->frame_data.meta_array = NULL;
+  free(ctx->anc_data);
+  ctx->anc_data = NULL;
 }
 
 int ut_txa_run_frame_tasklet(ut_txa_ctx* ctx, enum st10_timestamp_fmt tfmt,
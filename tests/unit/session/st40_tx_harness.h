@@ -30,9 +30,13 @@ uint64_t ut_txa_pacing_required_tai(ut_txa_ctx* ctx, enum st10_timestamp_fmt tfm
 int ut_txa_sync_pacing(ut_txa_ctx* ctx, uint64_t required_tai);
 int ut_txa_prepare_frame_tasklet(ut_txa_ctx* ctx, enum st10_timestamp_fmt tfmt,
                                  uint64_t timestamp, unsigned int packets);
+int ut_txa_prepare_anc_frame_tasklet(ut_txa_ctx* ctx, uint64_t timestamp,
+                                     uint32_t meta_num, uint16_t udw_size);
+void ut_txa_set_max_pkt_len(ut_txa_ctx* ctx, uint32_t max_pkt_len);
 int ut_txa_step_frame_tasklet(ut_txa_ctx* ctx);
 unsigned int ut_txa_queued_packets(const ut_txa_ctx* ctx);
 int ut_txa_pop_packet_tsc(ut_txa_ctx* ctx, uint64_t* packet_tsc);
+int ut_txa_pop_packet_anc(ut_txa_ctx* ctx, uint16_t* anc_count, bool* marker);
 void ut_txa_cleanup_frame_tasklet(ut_txa_ctx* ctx);
 int ut_txa_run_frame_tasklet(ut_txa_ctx* ctx, enum st10_timestamp_fmt tfmt,
                              uint64_t timestamp, uint64_t* packet_tsc);